@@ -199,6 +199,7 @@ OMR::CodeGenerator::CodeGenerator() :
      _blocksWithCalls(NULL),
      _codeCache(0),
      _committedToCodeCache(false),
+     _hasProjectSpecializedRelocations(false),
      _codeCacheSwitched(false),
      _dummyTempStorageRefNode(NULL),
      _blockRegisterPressureCache(NULL),
@@ -1103,6 +1103,13 @@ class OMR_EXTENSIBLE CodeGenerator
    TR::list<TR::Relocation*>& getExternalRelocationList() {return _externalRelocationList;}
    TR::list<TR::StaticRelocation>& getStaticRelocations() { return _staticRelocationList; }
 
+   /**
+    * @brief Whether the generated code refers to a target outside the method,
+    * such as a helper, that only a project specific relocation could describe.
+    * Such code cannot be moved to another address or process as it is.
+    */
+   bool hasProjectSpecializedRelocations() { return _hasProjectSpecializedRelocations; }
+
    void addRelocation(TR::Relocation *r);
    void addExternalRelocation(TR::Relocation *r, const char *generatingFileName, uintptr_t generatingLineNumber, TR::Node *node, TR::ExternalRelocationPositionRequest where = TR::ExternalRelocationAtBack);
    void addExternalRelocation(TR::Relocation *r, TR::RelocationDebugInfo *info, TR::ExternalRelocationPositionRequest where = TR::ExternalRelocationAtBack);
@@ -1114,21 +1121,21 @@ class OMR_EXTENSIBLE CodeGenerator
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _hasProjectSpecializedRelocations = true; }
    void addProjectSpecializedPairRelocation(uint8_t *location1,
                                           uint8_t *location2,
                                           uint8_t *target,
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _hasProjectSpecializedRelocations = true; }
    void addProjectSpecializedRelocation(TR::Instruction *instr,
                                           uint8_t *target,
                                           uint8_t *target2,
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _hasProjectSpecializedRelocations = true; }
 
    void apply8BitLabelRelativeRelocation(int32_t * cursor, TR::LabelSymbol * label);
    void apply12BitLabelRelativeRelocation(int32_t * cursor, TR::LabelSymbol * label, bool isCheckDisp = true);
@@ -1974,6 +1981,7 @@ class OMR_EXTENSIBLE CodeGenerator
 
    TR::CodeCache * _codeCache;
    bool _committedToCodeCache;
+   bool _hasProjectSpecializedRelocations;
 
    bool _codeCacheSwitched; ///< Has the CodeCache switched from the initially assigned CodeCache?
 
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "compile/CompilationBudget.hpp"
+
+#include "env/CompilerEnv.hpp"
+#include "env/SegmentAllocator.hpp"
+
+OMR::CompilationBudget::CompilationBudget(uint64_t startTime, uint64_t timeBudget, const TR::SegmentAllocator &scratchSegmentProvider) :
+   _startTime(startTime),
+   _timeBudget(timeBudget),
+   _scratchSegmentProvider(scratchSegmentProvider),
+   _state(Available)
+   {
+   }
+
+OMR::CompilationBudget::State
+OMR::CompilationBudget::update()
+   {
+   if (_state == Exhausted)
+      return _state;
+
+   State state = Available;
+
+   if (_timeBudget != 0)
+      {
+      uint64_t elapsed = TR::Compiler->vm.getUSecClock() - _startTime;
+      if (elapsed >= _timeBudget)
+         state = Exhausted;
+      else if (elapsed >= _timeBudget - _timeBudget / 4)
+         state = Low;
+      }
+
+   size_t memoryBudget = _scratchSegmentProvider.allocationLimit();
+   if (state != Exhausted && memoryBudget != static_cast<size_t>(-1))
+      {
+      size_t used = _scratchSegmentProvider.bytesAllocated();
+      if (used >= memoryBudget)
+         state = Exhausted;
+      else if (used >= memoryBudget - memoryBudget / 4)
+         state = Low;
+      }
+
+   if (state > _state)
+      _state = state;
+   return _state;
+   }
+
+const char *
+OMR::CompilationBudget::getStateName(State state)
+   {
+   static const char * const names[] = { "available", "low", "exhausted" };
+   return names[state];
+   }
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_COMPILATION_BUDGET
+#define OMR_COMPILATION_BUDGET
+
+#pragma once
+
+#ifndef TR_COMPILATION_BUDGET
+#define TR_COMPILATION_BUDGET
+namespace OMR { class CompilationBudget; }
+namespace TR { using OMR::CompilationBudget; }
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace TR { class SegmentAllocator; }
+
+namespace OMR {
+
+/**
+ * @brief The CompilationBudget class tracks how much of its time and scratch
+ * memory a compilation has used, so that the optimizer can drop optional work
+ * before either runs out.
+ *
+ * The time budget comes from the compilationTimeBudget= option; the memory
+ * budget is the allocation limit of the scratch segment provider, beyond which
+ * requests throw std::bad_alloc and the compilation fails.  The budget is Low
+ * once three quarters of either has been used and Exhausted once all of either
+ * has.  It never recovers: scratch memory released by one optimization is
+ * likely to be needed again by the next.
+ */
+class CompilationBudget
+   {
+public:
+   enum State
+      {
+      Available,
+      Low,
+      Exhausted
+      };
+
+   /**
+    * @param startTime the TR::Compiler->vm.getUSecClock() value when the
+    * compilation started
+    * @param timeBudget microseconds the compilation may take, or 0 for no
+    * time budget
+    * @param scratchSegmentProvider the provider of the compilation's scratch
+    * memory
+    */
+   CompilationBudget(uint64_t startTime, uint64_t timeBudget, const TR::SegmentAllocator &scratchSegmentProvider);
+
+   /**
+    * @brief Check the clock and the scratch memory in use and return the
+    * resulting state.
+    */
+   State update();
+   State state() const { return _state; }
+
+   static const char *getStateName(State state);
+
+private:
+   uint64_t const _startTime;
+   uint64_t const _timeBudget;
+   const TR::SegmentAllocator &_scratchSegmentProvider;
+   State _state;
+   };
+
+} // namespace OMR
+
+#endif // OMR_COMPILATION_BUDGET
@@ -101,6 +101,7 @@
 #include "ras/IlVerifier.hpp"
 #include "control/Recompilation.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
+#include "runtime/PersistentCodeCache.hpp"
 #include "ilgen/IlGen.hpp"
 #include "env/RegionProfiler.hpp"
 // this ratio defines how full the alias memory region is allowed to become before
@@ -288,6 +289,7 @@ OMR::Compilation::Compilation(
    _prevSymRefTabSize(0),
    _scratchSpaceLimit(TR::Options::_scratchSpaceLimit),
    _cpuTimeAtStartOfCompilation(-1),
+   _budget(NULL),
    _ilVerifier(NULL),
    _gpuPtxList(m),
    _gpuKernelLineNumberList(m),
@@ -487,6 +489,12 @@ OMR::Compilation::maxInternalPointers()
    return 0;
    }
 
+bool
+OMR::Compilation::needsStaticRelocations()
+   {
+   return self()->getOption(TR_EmitRelocatableELFFile) || TR::PersistentCodeCache::instance() != NULL;
+   }
+
 bool
 OMR::Compilation::isOutermostMethod()
    {
@@ -1010,6 +1018,9 @@ int32_t OMR::Compilation::compile()
    // Create the compile time profiler
    TR::CompileTimeProfiler perf(self(), "compileTimePerf");
 
+   TR::PersistentCodeCache *persistentCodeCache = TR::PersistentCodeCache::instance();
+   uint64_t persistentCodeCacheKey = 0;
+
    {
      TR::RegionProfiler rpIlgen(self()->trMemory()->heapMemoryRegion(), *self(), "comp/ilgen");
      if (printCodegenTime) genILTime.startTiming(self());
@@ -1053,6 +1064,17 @@ int32_t OMR::Compilation::compile()
          }
 #endif
 
+      // A method found in the persistent code cache is installed from there
+      // instead of being optimized and compiled again
+      //
+      if (persistentCodeCache && !persistentCodeCache->computeKey(self(), persistentCodeCacheKey))
+         persistentCodeCache = NULL;
+      if (persistentCodeCache && persistentCodeCache->install(self(), persistentCodeCacheKey))
+         {
+         if (printCodegenTime) compTime.stopTiming(self());
+         return COMPILATION_SUCCEEDED;
+         }
+
       if (_recompilationInfo)
          {
          _recompilationInfo->beforeOptimization();
@@ -1223,6 +1245,9 @@ int32_t OMR::Compilation::compile()
    if (!_ilGenSuccess)
       self()->failCompilation<TR::ILGenFailure>("IL Gen Failure");
 
+   if (persistentCodeCache)
+      persistentCodeCache->store(self(), persistentCodeCacheKey);
+
 #ifdef J9_PROJECT_SPECIFIC
    if (self()->getOption(TR_TraceCG))
       {
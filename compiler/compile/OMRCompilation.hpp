@@ -91,6 +91,7 @@ namespace TR { class Block; }
 namespace TR { class CFG; }
 namespace TR { class CodeCache; }
 namespace TR { class CodeGenerator; }
+namespace OMR { class CompilationBudget; }
 namespace TR { class Compilation; }
 namespace TR { class IlGenRequest; }
 namespace TR { class IlVerifier; }
@@ -340,6 +341,12 @@ public:
    //
    bool compileRelocatableCode() { return false; }
 
+   // Should the code generator record static relocations for external
+   // symbols?  They are needed to write a relocatable object file and to
+   // keep the method in the persistent code cache.
+   //
+   bool needsStaticRelocations();
+
    // Maximum number of internal pointers that can be managed.
    //
    int32_t maxInternalPointers();
@@ -936,6 +943,13 @@ public:
    void setScratchSpaceLimit(size_t val) { _scratchSpaceLimit = val; }
    size_t getScratchSpaceLimit() { return _scratchSpaceLimit; }
 
+   /**
+    * @brief The time and scratch memory budget of this compilation, or NULL
+    * if it has none.
+    */
+   OMR::CompilationBudget *getBudget() { return _budget; }
+   void setBudget(OMR::CompilationBudget *budget) { _budget = budget; }
+
    void setHasMethodHandleInvoke() { _flags.set(HasMethodHandleInvoke); }
    bool getHasMethodHandleInvoke() { return _flags.testAny(HasMethodHandleInvoke); }
 
@@ -1248,6 +1262,7 @@ private:
 
    size_t                            _scratchSpaceLimit;
    int64_t                           _cpuTimeAtStartOfCompilation;
+   OMR::CompilationBudget            *_budget;
 
    TR::IlVerifier                    *_ilVerifier;
 
@@ -29,11 +29,13 @@
 #include <exception>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "codegen/CodeGenerator.hpp"
 #include "codegen/FrontEnd.hpp"
 #include "codegen/LinkageConventionsEnum.hpp"
 #include "compile/Compilation.hpp"
+#include "compile/CompilationBudget.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/ResolvedMethod.hpp"
 #include "control/OptimizationPlan.hpp"
@@ -54,81 +56,23 @@
 #include "ilgen/IlGeneratorMethodDetails.hpp"
 #include "infra/Assert.hpp"
 #include "ras/Debug.hpp"
+#include "env/SystemSegmentCache.hpp"
+#include "env/PassProfile.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/DebugSegmentProvider.hpp"
 #include "omrformatconsts.h"
 #include "runtime/CodeCacheManager.hpp"
+#include "runtime/PerfToolWriter.hpp"
+#include "runtime/PersistentCodeCache.hpp"
 
 #if defined (_MSC_VER) && _MSC_VER < 1900
 #define snprintf _snprintf
 #endif
 
-static void
-writePerfToolEntry(void *start, uint32_t size, const char *name)
-   {
-   // race condition
-   static bool firstAttempt = true;
-   static FILE *perfFile = 0;
-
-   if (firstAttempt)
-      {
-      firstAttempt = false;
-#if defined(OMR_OS_WINDOWS)
-      int jvmPid = _getpid();
-#else
-      pid_t jvmPid = getpid();
-#endif
-      static const int maxPerfFilenameSize = 15 + sizeof(jvmPid)* 3; // "/tmp/perf-%ld.map"
-      char perfFilename[maxPerfFilenameSize] = { 0 };
-
-      int numCharsWritten = snprintf(perfFilename, maxPerfFilenameSize, "/tmp/perf-%" OMR_PRId64 ".map", static_cast<int64_t>(jvmPid));
-      if (numCharsWritten > 0 && numCharsWritten < maxPerfFilenameSize)
-         {
-         perfFile = fopen(perfFilename, "a");
-         }
-      if (!perfFile) // couldn't open the file
-         {
-         }
-      }
-   if (perfFile)
-      {
-      // perf does not want 0x leading the hex start address and length of the compiled code region
-      // the rest of the line is considered to be the name of the region
-
-      // j9jit_fprintf(getPerfFile(), "%lX %lX %s_%s\n", (intptr_t) getMetadata()->startPC, getMetadata()->endWarmPC - getMetadata()->startPC,
-      //               getCompilation()->signature(), getCompilation()->getHotnessName(getCompilation()->getMethodHotness()));
-      fprintf(perfFile, "%lX %lX %s\n", (intptr_t) start, (intptr_t) size, name);
-
-      // If there is a cold section, add another line
-      // if (getMetadata()->startColdPC)
-      //    {
-      //    j9jit_fprintf(getPerfFile(), "%lX %lX %s_%s\n", (intptr_t) getMetadata()->startColdPC, getMetadata()->endPC - getMetadata()->startColdPC,
-      //                  TR::comp()()->signature(), getCompilation()->getHotnessName(getCompilation()->getMethodHotness())); // should we change the name of the method?
-      //    }
-      // Flushing degrades performance, but ensures that we have the data
-      // written even if the JVM is abruptly terminated
-      //j9jit_fflush(getPerfFile());
-      fflush(perfFile);
-      }
-   }
-
-
-
-static void
-generatePerfToolEntry(uint8_t *startPC, uint8_t *endPC, const char *sig, const char *hotness)
-   {
-   char buffer[1024];
-   char *name;
-   if (strlen(sig) + 1 + strlen(hotness) + 1 < 1024)
-      {
-      sprintf(buffer, "%s_%s (compiled code)", sig, hotness);
-      name = buffer;
-      }
-   else
-      name = "(compiled code)";
-
-   writePerfToolEntry(startPC, endPC - startPC, name);
-   }
+// Scratch memory for each compilation comes in segments of this size
+#define SCRATCH_SEGMENT_SIZE (1 << 16)
+// Default bound on the scratch segments kept between compilations
+#define SCRATCH_SEGMENT_CACHE_DEFAULT_SIZE (16 * 1024 * 1024)
 
 #if defined(TR_TARGET_POWER)
 #include "p/codegen/PPCTableOfConstants.hpp"
@@ -176,9 +120,30 @@ int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
 #endif
    jitConfig->setPseudoTOC(pseudoTOC);
 
+   // Scratch segments are kept between compilations; TR_ScratchSegmentCacheKB=0 disables this
+   static const char *segmentCacheKB = feGetEnv("TR_ScratchSegmentCacheKB");
+   size_t segmentCacheSize = segmentCacheKB ? static_cast<size_t>(atol(segmentCacheKB)) * 1024 : SCRATCH_SEGMENT_CACHE_DEFAULT_SIZE;
+   TR::SystemSegmentCache::initialize(SCRATCH_SEGMENT_SIZE, segmentCacheSize);
+
+   TR::PersistentCodeCache::initialize(TR::Options::getCmdLineOptions()->getPersistentCodeCacheFileName(), cmdLineOptions);
+
+   TR::Options *options = TR::Options::getCmdLineOptions();
+   TR::PerfToolWriter::initialize(options->getOption(TR_PerfTool), options->getOption(TR_PerfToolJitDump), options->getOption(TR_PerfToolLineInfo));
+   TR::PassProfile::initialize(options->getPassProfileFileName());
+
    return 0;
    }
 
+void commonJitShutdown(OMR::FrontEnd &fe)
+   {
+   TR::SystemSegmentCache::shutdown();
+   TR::PersistentCodeCache::shutdown();
+   TR::PerfToolWriter::shutdown();
+   TR::PassProfile::shutdown();
+   if (TR::Options::getVerboseOption(TR_VerboseJitMemory) && ::trPersistentMemory)
+      ::trPersistentMemory->printMemStatsToVlog();
+   }
+
 int32_t init_options(TR::JitConfig *jitConfig, char *cmdLineOptions)
    {
    OMR::FrontEnd *fe = OMR::FrontEnd::instance();
@@ -224,14 +189,6 @@ static bool methodCanBeCompiled(OMR::FrontEnd *fe, TR_ResolvedMethod &method, TR
    return TR::Options::getDebug()->methodCanBeCompiled(trMemory, &method, filter);
    }
 
-
-void
-registerTrampoline(uint8_t *start, uint32_t size, const char *name)
-   {
-   if (TR::Options::getCmdLineOptions()->getOption(TR_PerfTool))
-      writePerfToolEntry(start, size, name);
-   }
-
 static void
 printCompFailureInfo(TR::JitConfig *jitConfig, TR::Compilation * comp, const char * reason)
    {
@@ -278,8 +235,8 @@ compileMethodFromDetails(
    OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
    auto jitConfig = fe.jitConfig();
    TR::RawAllocator rawAllocator;
-   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator);
-   TR::DebugSegmentProvider debugSegmentProvider(1 << 16, rawAllocator);
+   TR::SystemSegmentProvider defaultSegmentProvider(SCRATCH_SEGMENT_SIZE, rawAllocator, TR::SystemSegmentCache::instance());
+   TR::DebugSegmentProvider debugSegmentProvider(SCRATCH_SEGMENT_SIZE, rawAllocator);
    TR::SegmentAllocator &scratchSegmentProvider =
       TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ?
          static_cast<TR::SegmentAllocator &>(debugSegmentProvider) :
@@ -339,6 +296,15 @@ compileMethodFromDetails(
    TR::Compilation compiler(0, omrVMThread, &fe, &compilee, request, options, dispatchRegion, &trMemory, plan);
    TR_ASSERT(TR::comp() == &compiler, "the TLS TR::Compilation object %p for this thread does not match the one %p just created.", TR::comp(), &compiler);
 
+   // Scratch memory beyond the limit is refused, failing the compilation; the
+   // optimizer scales back as the compilation approaches either budget.
+   //
+   if (compiler.getScratchSpaceLimit() > 0)
+      scratchSegmentProvider.setAllocationLimit(compiler.getScratchSpaceLimit());
+   TR::CompilationBudget budget(translationStartTime, static_cast<uint64_t>(options.getCompilationTimeBudget()) * 1000, scratchSegmentProvider);
+   if (options.getCompilationTimeBudget() > 0 || compiler.getScratchSpaceLimit() > 0)
+      compiler.setBudget(&budget);
+
    try
       {
       //fprintf(stderr,"loading JIT debug\n");
@@ -399,6 +365,16 @@ compileMethodFromDetails(
                   translationTime,
                   static_cast<unsigned long long>(scratchSegmentProvider.bytesAllocated()) / 1024
                   );
+               if (budget.state() != TR::CompilationBudget::Available)
+                  TR_VerboseLog::write(" budget=%s", TR::CompilationBudget::getStateName(budget.state()));
+               if (defaultSegmentProvider.cachedSegmentRequests() > 0)
+                  {
+                  TR_VerboseLog::write(
+                     " segmentsReused=%llu/%llu",
+                     static_cast<unsigned long long>(defaultSegmentProvider.cachedSegmentHits()),
+                     static_cast<unsigned long long>(defaultSegmentProvider.cachedSegmentRequests())
+                     );
+                  }
                }
 
             TR_VerboseLog::vlogRelease();
@@ -407,13 +383,14 @@ compileMethodFromDetails(
 
          if (
                compiler.getOption(TR_PerfTool)
+            || compiler.getOption(TR_PerfToolJitDump)
             || compiler.getOption(TR_EmitExecutableELFFile)
             || compiler.getOption(TR_EmitRelocatableELFFile)
             )
             {
             TR::CodeCacheManager &codeCacheManager(fe.codeCacheManager());
             TR::CodeGenerator &codeGenerator(*compiler.cg());
-            codeCacheManager.registerCompiledMethod(compiler.externalName(), startPC, codeGenerator.getCodeLength());
+            codeCacheManager.registerCompiledMethod(compiler.externalName(), startPC, codeGenerator.getCodeLength(), &compiler);
             if (compiler.getOption(TR_EmitRelocatableELFFile))
                {
                auto &relocations = codeGenerator.getStaticRelocations();
@@ -422,10 +399,6 @@ compileMethodFromDetails(
                   codeCacheManager.registerStaticRelocation(*it);
                   }
                }
-            if (compiler.getOption(TR_PerfTool))
-               {
-               generatePerfToolEntry(startPC, codeGenerator.getCodeEnd(), compiler.signature(), compiler.getHotnessName(compiler.getMethodHotness()));
-               }
             }
 
          if (compiler.getOutFile() != NULL && compiler.getOption(TR_TraceAll))
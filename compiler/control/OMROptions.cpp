@@ -178,6 +178,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
                                TR::Options::setStaticString,  (intptrj_t)(&OMR::Options::_compilationStrategyName), 0, "F%s", NOT_IN_SUBSET},
    {"compilationThreads=",   "R<nnn>\tnumber of compilation threads to use",
                                TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_numUsableCompilationThreads, 0, "F%d", NOT_IN_SUBSET},
+   {"compilationTimeBudget=", "O<nnn>\tmilliseconds a compilation may spend before optional optimizations are scaled back; 0 means no budget",
+                               TR::Options::set32BitNumeric, offsetof(OMR::Options, _compilationTimeBudget), 0, "F%d"},
    {"compile",                "D\tCompile these methods immediately. Primarily for use with Compiler.command",  SET_OPTION_BIT(TR_CompileBit),  "F" },
    {"compThreadCPUEntitlement=", "M<nnn>\tThreshold for CPU utilization of compilation threads",
                                TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_compThreadCPUEntitlement, 0, "F%d", NOT_IN_SUBSET },
@@ -676,6 +678,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableHardwareProfilerDuringStartup", "O\tenable hardware profiler during startup", RESET_OPTION_BIT(TR_DisableHardwareProfilerDuringStartup), "F", NOT_IN_SUBSET},
    {"enableHardwareProfileRecompilation", "O\tenable hardware profile recompilation", SET_OPTION_BIT(TR_EnableHardwareProfileRecompilation), "F", NOT_IN_SUBSET},
    {"enableHCR",                          "O\tenable hot code replacement", SET_OPTION_BIT(TR_EnableHCR), "F", NOT_IN_SUBSET},
+   {"enableHybridBitVectorLiveness",      "O\tsolve liveness over compressed bit vectors, for methods with very many locals", SET_OPTION_BIT(TR_EnableHybridBitVectorLiveness), "F"},
 #ifdef J9_PROJECT_SPECIFIC
    {"enableIdiomRecognition",             "O\tenable Idiom Recognition", TR::Options::enableOptimization, idiomRecognition, 0, "P"},
 #endif
@@ -758,6 +761,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableVirtualPersistentMemory",      "M\tenable persistent memory to be allocated using virtual memory allocators",
                                           SET_OPTION_BIT(TR_EnableVirtualPersistentMemory), "F", NOT_IN_SUBSET},
    {"enableVpicForResolvedVirtualCalls",  "O\tenable PIC for resolved virtual calls",         SET_OPTION_BIT(TR_EnableVPICForResolvedVirtualCalls), "F"},
+   {"enableWorklistDataFlow",             "O\tsolve bit vector analyses from a block worklist instead of by structure", SET_OPTION_BIT(TR_EnableWorklistDataFlow), "F"},
    {"enableYieldVMAccess",                "O\tenable yielding of VM access when GC is waiting", SET_OPTION_BIT(TR_EnableYieldVMAccess), "F"},
    {"enableZEpilogue",                  "O\tenable 64-bit 390 load-multiple breakdown.", SET_OPTION_BIT(TR_Enable39064Epilogue), "F"},
    {"enumerateAddresses=", "D\tselect kinds of addresses to be replaced by unique identifiers in trace file", TR::Options::setAddressEnumerationBits, offsetof(OMR::Options, _addressToEnumerate), 0, "F"},
@@ -1008,8 +1012,12 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"paintAllocatedFrameSlotsFauxObject",   "C\tpaint all slots allocated in method prologue with faux object pointer",    SET_OPTION_BIT(TR_PaintAllocatedFrameSlotsFauxObject), "F"},
    {"paintDataCacheOnFree",     "I\tpaint data cache allocations that are being returned to the pool", SET_OPTION_BIT(TR_PaintDataCacheOnFree), "F"},
    {"paranoidOptCheck",   "O\tcheck the trees and cfgs after every optimization phase", SET_OPTION_BIT(TR_EnableParanoidOptCheck), "F"},
+   {"passProfile=", "M<filename>\twrite the time, scratch memory and IL node counts of each optimization and codegen phase, summed over all compilations, to filename as JSON", TR::Options::setString, offsetof(OMR::Options,_passProfileFileName), 0, "P%s", NOT_IN_SUBSET},
    {"performLookaheadAtWarmCold", "O\tallow lookahead to be performed at cold and warm", SET_OPTION_BIT(TR_PerformLookaheadAtWarmCold), "F"},
    {"perfTool", "M\tenable PerfTool", SET_OPTION_BIT(TR_PerfTool), "F", NOT_IN_SUBSET },
+   {"perfToolJitDump", "M\twrite a perf jitdump file /tmp/jit-<pid>.dump as methods are compiled", SET_OPTION_BIT(TR_PerfToolJitDump), "F", NOT_IN_SUBSET },
+   {"perfToolLineInfo", "M\tadd bytecode index line information to the perf jitdump file", SET_OPTION_BIT(TR_PerfToolLineInfo), "F", NOT_IN_SUBSET },
+   {"persistentCodeCache=", "M<filename>\treuse compiled method bodies stored in filename across runs", TR::Options::setString, offsetof(OMR::Options,_persistentCodeCacheFileName), 0, "P%s", NOT_IN_SUBSET},
    {"poisonDeadSlots",    "O\tpaints all dead slots with deadf00d", SET_OPTION_BIT(TR_PoisonDeadSlots), "F"},
    {"prepareForOSREvenIfThatDoesNothing",   "O\temit the call to prepareForOSR even if there is no slot sharing", SET_OPTION_BIT(TR_EnablePrepareForOSREvenIfThatDoesNothing), "F"},
    {"printAbsoluteTimestampInVerboseLog", "O\tPrint Absolute Timestamp in vlog", SET_OPTION_BIT(TR_PrintAbsoluteTimestampInVerboseLog), "F", NOT_IN_SUBSET},
@@ -1096,6 +1104,10 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390LitPoolBuffer), 0, "F%d"},
    {"test390StackBufferSize=", "L\tInsert buffer in stack to force testing of large stack sizes",
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390StackBuffer), 0, "F%d"},
+   {"tieredHotCount=",   "O<nnn>\tnumber of invocations of a warm tiered method before it is recompiled at hot",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _tieredHotCount), 0, "F%d"},
+   {"tieredWarmCount=",  "O<nnn>\tnumber of invocations of a cold tiered method before it is recompiled at warm",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _tieredWarmCount), 0, "F%d"},
    {"timing", "M\ttime individual phases and optimizations", SET_OPTION_BIT(TR_Timing), "F" },
    {"timingCumulative", "M\ttime cumulative phases (ILgen,Optimizer,codegen)", SET_OPTION_BIT(TR_CummTiming), "F" },
 #if defined(TR_HOST_X86) || defined(TR_HOST_POWER)
@@ -2507,6 +2519,9 @@ OMR::Options::jitPreProcess()
    _initialColdRunCount = -1;
    _initialColdRunBCount = -1;
    _initialSCount = TR_INITIAL_SCOUNT;
+   _tieredWarmCount = TR_DEFAULT_TIERED_WARM_COUNT;
+   _tieredHotCount = TR_DEFAULT_TIERED_HOT_COUNT;
+   _compilationTimeBudget = 0;
    _lastOptIndex = INT_MAX;
    _lastOptSubIndex = INT_MAX;
    _lastSearchCount = INT_MAX;
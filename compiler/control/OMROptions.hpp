@@ -391,8 +391,8 @@ enum TR_CompilationOptions
 
    // Option word 10
    //
-   // Available                           = 0x00000020 + 10,
-   // Available                           = 0x00000040 + 10,
+   TR_EnableWorklistDataFlow              = 0x00000020 + 10,
+   TR_EnableHybridBitVectorLiveness       = 0x00000040 + 10,
    // Available                           = 0x00000080 + 10,
    TR_FirstLevelProfiling                 = 0x00000100 + 10,
    // Available                           = 0x00000200 + 10,
@@ -824,9 +824,9 @@ enum TR_CompilationOptions
    // Available                                       = 0x00000800 + 25,
    // Available                                       = 0x00001000 + 25,
    TR_TracePREForOptimalSubNodeReplacement            = 0x00002000 + 25,
-   // Available                                       = 0x00008000 + 25,
+   TR_PerfToolLineInfo                                = 0x00008000 + 25,
    TR_PerfTool                                        = 0x00010000 + 25,
-   // Available                                       = 0x00020000 + 25,
+   TR_PerfToolJitDump                                 = 0x00020000 + 25,
    TR_DisableBranchOnCount                            = 0x00040000 + 25,
    TR_LinkagePreserveStrategy2                        = 0x00080000 + 25,
    TR_DisableLoopEntryAlignment                       = 0x00100000 + 25,
@@ -1111,7 +1111,7 @@ enum TR_VerboseFlags
                            // Must leave this as a separate option because sometimes the error do not
                            // show when full blown verbose options are specified
    TR_VerboseJitState,
-   TR_VerboseJitMemory,    // Print JIT memory usage every 5 minutes; I should add this to end of run too
+   TR_VerboseJitMemory,    // Print JIT memory usage every 5 minutes and persistent memory by object type at shutdown
    TR_VerboseCompilationThreads,
    TR_VerboseCompilationThreadsDetails,
    TR_VerboseCodeCacheReclamation,
@@ -1193,6 +1193,9 @@ enum TR_ProcessOptionsFlags
 #define TR_DEFAULT_INITIAL_BCOUNT        3000
 #define TR_DEFAULT_INITIAL_MILCOUNT       250
 
+#define TR_DEFAULT_TIERED_WARM_COUNT     1000
+#define TR_DEFAULT_TIERED_HOT_COUNT     10000
+
 #define TR_QUICKSTART_INITIAL_COUNT      1000
 #define TR_QUICKSTART_INITIAL_BCOUNT      250
 #define TR_QUICKSTART_INITIAL_MILCOUNT      1
@@ -1584,6 +1587,10 @@ public:
    int32_t   getDisableDLTBytecodeIndex()      {return _disableDLTBytecodeIndex;}
    int32_t   getDLTOptLevel()                  {return _dltOptLevel;}
    int32_t   getProfilingCount()               {return _profilingCount;}
+   int32_t   getTieredWarmCount()              {return _tieredWarmCount;}
+   int32_t   getTieredHotCount()               {return _tieredHotCount;}
+   int32_t   getCompilationTimeBudget()        {return _compilationTimeBudget;}
+   void      setCompilationTimeBudget(int32_t n) {_compilationTimeBudget = n;}
    int32_t   getProfilingFrequency()           {return _profilingFrequency;}
    int32_t   insertDebuggingCounters()         {return _insertDebuggingCounters;}
    int32_t   getLastSearchCount()              {return _lastSearchCount;}
@@ -1932,6 +1939,8 @@ public:
    void disableCHOpts(); // disable CHOpts, but also IPA and prex which depend on the chtable
 
    const char *getObjectFileName() { return _objectFileName; }
+   const char *getPersistentCodeCacheFileName() { return _persistentCodeCacheFileName; }
+   const char *getPassProfileFileName() { return _passProfileFileName; }
 
 protected:
    void  jitPreProcess();
@@ -2348,6 +2357,9 @@ protected:
    int32_t                     _enableDLTBytecodeIndex;
    int32_t                     _dltOptLevel;
    int32_t                     _profilingCount;
+   int32_t                     _tieredWarmCount;
+   int32_t                     _tieredHotCount;
+   int32_t                     _compilationTimeBudget;
    int32_t                     _profilingFrequency;
    int32_t                     _counterBucketGranularity;
    int32_t                     _minCounterFidelity;
@@ -2420,6 +2432,8 @@ protected:
    int32_t                     _loopyAsyncCheckInsertionMaxEntryFreq;
 
    char *                      _objectFileName; //Name of the relocatable ELF file *.o if one is to be generated
+   char *                      _persistentCodeCacheFileName; //Name of the file compiled method bodies are kept in across runs
+   char *                      _passProfileFileName; //Name of the JSON file the per-pass compile cost profile is written to
 
    }; // TR::Options
 
@@ -37,6 +37,8 @@
 TR::DebugSegmentProvider::DebugSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator) :
    TR::SegmentAllocator(segmentSize),
    _rawAllocator(rawAllocator),
+   _bytesAllocated(0),
+   _allocationLimit(static_cast<size_t>(-1)),
    _segments(std::less< TR::MemorySegment >(), SegmentSetAllocator(rawAllocator))
    {
    }
@@ -60,6 +62,8 @@ TR::MemorySegment &
 TR::DebugSegmentProvider::request(size_t requiredSize)
    {
    size_t adjustedSize = ( ( requiredSize + (defaultSegmentSize() - 1) ) / defaultSegmentSize() ) * defaultSegmentSize();
+   if (_bytesAllocated > _allocationLimit || adjustedSize > _allocationLimit - _bytesAllocated)
+      throw std::bad_alloc();
 #if (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX)
    void *newSegmentArea = mmap(NULL, adjustedSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
    if (newSegmentArea == MAP_FAILED) throw std::bad_alloc();
@@ -125,11 +129,11 @@ TR::DebugSegmentProvider::systemBytesAllocated() const throw()
 size_t
 TR::DebugSegmentProvider::allocationLimit() const throw()
    {
-   return static_cast<size_t>(-1);
+   return _allocationLimit;
    }
 
 void
 TR::DebugSegmentProvider::setAllocationLimit(size_t allocationLimit)
    {
-   return;
+   _allocationLimit = allocationLimit;
    }
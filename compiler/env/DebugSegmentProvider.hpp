@@ -63,6 +63,7 @@ public:
 private:
    TR::RawAllocator _rawAllocator;
    size_t _bytesAllocated;
+   size_t _allocationLimit;
    typedef TR::typed_allocator<
       TR::MemorySegment,
       TR::RawAllocator
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/PassProfile.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/VerboseLog.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+TR::PassProfile *OMR::PassProfile::_instance = NULL;
+
+OMR::PassProfile::PassProfile(const char *fileName, TR::RawAllocator rawAllocator) :
+   _rawAllocator(rawAllocator),
+   _fileName(static_cast<char *>(rawAllocator.allocate(strlen(fileName) + 1))),
+   _monitor(TR::Monitor::create("JIT-PassProfileMonitor")),
+   _passes(NameLess(), PassAllocator(rawAllocator))
+   {
+   strcpy(_fileName, fileName);
+   }
+
+OMR::PassProfile::~PassProfile() throw()
+   {
+   for (PassMap::iterator it = _passes.begin(); it != _passes.end(); ++it)
+      _rawAllocator.deallocate(const_cast<char *>(it->first));
+   _rawAllocator.deallocate(_fileName);
+   TR::Monitor::destroy(_monitor);
+   }
+
+void
+OMR::PassProfile::initialize(const char *fileName)
+   {
+   if (NULL != _instance || NULL == fileName)
+      return;
+
+   TR::RawAllocator rawAllocator;
+   _instance = new (rawAllocator) TR::PassProfile(fileName, rawAllocator);
+   }
+
+void
+OMR::PassProfile::shutdown()
+   {
+   TR::PassProfile *profile = _instance;
+   if (NULL == profile)
+      return;
+
+   _instance = NULL;
+   profile->write();
+
+   TR::RawAllocator rawAllocator(profile->_rawAllocator);
+   profile->~PassProfile();
+   rawAllocator.deallocate(profile);
+   }
+
+void
+OMR::PassProfile::record(const char *name, uint64_t timeUSec, size_t regionBytes, size_t segmentBytes,
+                         uint32_t nodesBefore, uint32_t nodesAfter, bool countsNodes)
+   {
+   OMR::CriticalSection recording(_monitor);
+
+   PassMap::iterator it = _passes.find(name);
+   if (it == _passes.end())
+      {
+      char *copy = static_cast<char *>(_rawAllocator.allocate(strlen(name) + 1));
+      strcpy(copy, name);
+      Pass empty = { 0, 0, 0, 0, 0, 0, 0, false };
+      it = _passes.insert(std::make_pair(static_cast<const char *>(copy), empty)).first;
+      }
+
+   Pass &pass = it->second;
+   pass._invocations++;
+   pass._timeUSec += timeUSec;
+   pass._maxTimeUSec = std::max(pass._maxTimeUSec, timeUSec);
+   pass._regionBytes += regionBytes;
+   pass._segmentBytes += segmentBytes;
+   if (countsNodes)
+      {
+      pass._nodesBefore += nodesBefore;
+      pass._nodesAfter += nodesAfter;
+      pass._countsNodes = true;
+      }
+   }
+
+bool
+OMR::PassProfile::takesLonger(const PassEntry *left, const PassEntry *right)
+   {
+   if (left->second._timeUSec != right->second._timeUSec)
+      return left->second._timeUSec > right->second._timeUSec;
+   return strcmp(left->first, right->first) < 0;
+   }
+
+static void
+writeString(FILE *file, const char *string)
+   {
+   fputc('"', file);
+   for (const char *c = string; *c; ++c)
+      {
+      if ('"' == *c || '\\' == *c)
+         fputc('\\', file);
+      fputc(*c, file);
+      }
+   fputc('"', file);
+   }
+
+void
+OMR::PassProfile::write()
+   {
+   FILE *file = fopen(_fileName, "w");
+   if (NULL == file)
+      {
+      if (TR::Options::getCmdLineOptions() && TR::Options::getVerboseOption(TR_VerbosePerformance))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Cannot write pass profile %s", _fileName);
+      return;
+      }
+
+   OMR::CriticalSection writing(_monitor);
+
+   size_t numPasses = _passes.size();
+   const PassEntry **sorted = static_cast<const PassEntry **>(_rawAllocator.allocate((numPasses + 1) * sizeof(PassEntry *)));
+   size_t i = 0;
+   for (PassMap::const_iterator it = _passes.begin(); it != _passes.end(); ++it)
+      sorted[i++] = &*it;
+   std::sort(sorted, sorted + numPasses, takesLonger);
+
+   fprintf(file, "{\n  \"passes\": [");
+   for (i = 0; i < numPasses; ++i)
+      {
+      const char *name = sorted[i]->first;
+      const Pass &pass = sorted[i]->second;
+      fprintf(file, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+      writeString(file, name);
+      fprintf(file,
+         ", \"invocations\": %llu, \"timeUSec\": %llu, \"maxTimeUSec\": %llu, \"regionBytes\": %llu, \"segmentBytes\": %llu",
+         static_cast<unsigned long long>(pass._invocations),
+         static_cast<unsigned long long>(pass._timeUSec),
+         static_cast<unsigned long long>(pass._maxTimeUSec),
+         static_cast<unsigned long long>(pass._regionBytes),
+         static_cast<unsigned long long>(pass._segmentBytes)
+         );
+      if (pass._countsNodes)
+         {
+         fprintf(file, ", \"nodesBefore\": %llu, \"nodesAfter\": %llu",
+            static_cast<unsigned long long>(pass._nodesBefore),
+            static_cast<unsigned long long>(pass._nodesAfter)
+            );
+         }
+      fprintf(file, "}");
+      }
+   fprintf(file, "\n  ]\n}\n");
+   fclose(file);
+
+   _rawAllocator.deallocate(sorted);
+   }
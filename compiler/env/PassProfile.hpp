@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_PASS_PROFILE
+#define OMR_PASS_PROFILE
+
+#pragma once
+
+#ifndef TR_PASS_PROFILE
+#define TR_PASS_PROFILE
+namespace OMR { class PassProfile; }
+namespace TR { using OMR::PassProfile; }
+#endif
+
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "env/RawAllocator.hpp"
+#include "env/TypedAllocator.hpp"
+
+namespace TR { class Monitor; }
+
+namespace OMR {
+
+/**
+ * @brief The PassProfile class accumulates, over every compilation in the
+ * process, the cost of each optimization and code generation phase as
+ * measured by TR::RegionProfiler: wall time, scratch memory allocated and the
+ * number of IL nodes before and after.
+ *
+ * The profile is written to a JSON file when the JIT shuts down, passes
+ * sorted by total time.  All members may be called from any compilation
+ * thread.
+ */
+class PassProfile
+   {
+public:
+   /**
+    * @brief Start profiling if a file name is given.
+    * @param fileName the file the profile is written to at shutdown
+    */
+   static void initialize(const char *fileName);
+   /**
+    * @brief Write out the profile and stop profiling.
+    */
+   static void shutdown();
+   static TR::PassProfile *instance() throw() { return _instance; }
+
+   /**
+    * @brief Add one run of a pass to the profile.
+    * @param name the identifier of the pass
+    * @param timeUSec wall time taken, in microseconds
+    * @param regionBytes bytes allocated in the profiled region
+    * @param segmentBytes growth of the scratch segments backing the region
+    * @param nodesBefore live IL nodes before the pass, if counted
+    * @param nodesAfter live IL nodes after the pass, if counted
+    * @param countsNodes whether the node counts are meaningful
+    */
+   void record(const char *name, uint64_t timeUSec, size_t regionBytes, size_t segmentBytes,
+               uint32_t nodesBefore, uint32_t nodesAfter, bool countsNodes);
+
+private:
+   struct Pass
+      {
+      uint64_t _invocations;
+      uint64_t _timeUSec;
+      uint64_t _maxTimeUSec;
+      uint64_t _regionBytes;
+      uint64_t _segmentBytes;
+      uint64_t _nodesBefore;
+      uint64_t _nodesAfter;
+      bool _countsNodes;
+      };
+
+   struct NameLess
+      {
+      bool operator()(const char *left, const char *right) const { return strcmp(left, right) < 0; }
+      };
+
+   typedef TR::typed_allocator<std::pair<const char * const, Pass>, TR::RawAllocator> PassAllocator;
+   typedef std::map<const char *, Pass, NameLess, PassAllocator> PassMap;
+   typedef PassMap::value_type PassEntry;
+
+   PassProfile(const char *fileName, TR::RawAllocator rawAllocator);
+   ~PassProfile() throw();
+
+   void write();
+   static bool takesLonger(const PassEntry *left, const PassEntry *right);
+
+   static TR::PassProfile *_instance;
+
+   TR::RawAllocator _rawAllocator;
+   char *_fileName;
+   TR::Monitor *_monitor;
+   PassMap _passes;
+   };
+
+} // namespace OMR
+
+#endif // OMR_PASS_PROFILE
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2016 IBM Corp. and others
+ * Copyright (c) 2000, 2026 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -21,25 +21,677 @@
 
 #include "env/PersistentAllocator.hpp"
 
+#include <string.h>
+#include "AtomicSupport.hpp"
+#include "infra/ThreadLocal.h"
+
+/**
+ * Per-thread front end for the slab size classes.  A thread keeps up to
+ * limitFor(sizeClass) free blocks per class and returns half of them to
+ * the central list when it overflows.  Live byte counts are kept per thread
+ * as wrapping counters; only the sum over all caches and the central
+ * counters is meaningful.  When the thread exits, its free blocks go back
+ * to the central lists and its counters are folded into the central ones.
+ */
+struct OMR::PersistentAllocator::ThreadCache
+   {
+   ThreadCache *_next;
+   PersistentAllocator *_owner;
+   FreeBlock *_freeLists[NumSizeClasses];
+   uint32_t _counts[NumSizeClasses];
+   volatile uintptr_t _bytesInUse[NumCategories];
+   };
+
+namespace
+{
+#if defined(SUPPORTS_THREAD_LOCAL)
+tlsDefine(OMR::PersistentAllocator::ThreadCache *, persistentAllocatorThreadCache);
+tlsDefine(void *, persistentAllocatorThreadCacheGeneration);
+
+// The cache slot is shared by every slab allocator; it is allocated by the
+// first one to be constructed and freed by the last one to be destroyed.
+volatile uintptr_t liveSlabAllocators = 0;
+
+// A thread's cache may have been freed with an allocator that has since been
+// destroyed, and another allocator may be built at the same address, so the
+// slot also records the unique generation of the allocator owning the cache.
+// The cache itself is only touched once its generation matches.  The low bits
+// of a generation index the table of live generations, which tells whether
+// the owner of a slot still exists.  An allocator that finds the table full
+// runs without thread caches.
+const uintptr_t MaxLiveSlabAllocators = 64;
+volatile uintptr_t slabAllocatorGenerations = 0;
+volatile uintptr_t liveSlabAllocatorGenerations[MaxLiveSlabAllocators];
+#endif
+
+const size_t ThreadCacheBytesPerClass = 16 * 1024;
+
+uint32_t
+threadCacheLimit(uint32_t blockSize)
+   {
+   uint32_t limit = static_cast<uint32_t>(ThreadCacheBytesPerClass / blockSize);
+   return limit < 8 ? 8 : limit;
+   }
+
+class LockHolder
+   {
+public:
+   LockHolder(MUTEX &lock) : _lock(lock) { MUTEX_ENTER(_lock); }
+   ~LockHolder() { MUTEX_EXIT(_lock); }
+private:
+   MUTEX &_lock;
+   };
+
+}
+
+const uint16_t OMR::PersistentAllocator::_sizeClassSizes[OMR::PersistentAllocator::NumSizeClasses] =
+   {
+   16, 32, 48, 64, 80, 96, 112, 128,
+   160, 192, 224, 256,
+   320, 384, 448, 512,
+   640, 768, 896, 1024,
+   1280, 1536, 1792, 2048
+   };
+
+// Maps a size in 16-byte granules to the smallest class that fits it
+const uint8_t OMR::PersistentAllocator::_sizeClassIndex[(OMR::PersistentAllocator::MaxSlabBlockSize >> 4) + 1] =
+   {
+    0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9, 10, 10, 11,
+   11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15,
+   15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17,
+   17, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19,
+   19, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+   20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+   21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+   22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+   23
+   };
+
 OMR::PersistentAllocator::PersistentAllocator(const TR::PersistentAllocatorKit &allocatorKit) :
-   _rawAllocator(allocatorKit.rawAllocator)
+   _rawAllocator(allocatorKit.rawAllocator),
+   _slabsEnabled(allocatorKit.useSlabs),
+   _lock(),
+   _arenaNext(NULL),
+   _arenaEnd(NULL),
+   _arenas(NULL),
+   _arenaBytes(0),
+   _slabCount(0),
+   _registry(NULL),
+   _registryCount(0),
+   _threadCaches(NULL),
+   _generation(0),
+   _threadExitKeyValid(false)
    {
+   memset(_freeLists, 0, sizeof(_freeLists));
+   memset(_currentSlabs, 0, sizeof(_currentSlabs));
+   memset(const_cast<uintptr_t *>(_centralBytesInUse), 0, sizeof(_centralBytesInUse));
+   if (_slabsEnabled)
+      {
+#if defined(OMR_OS_WINDOWS)
+      MUTEX_INIT(_lock);
+#else
+      if (!MUTEX_INIT(_lock))
+         _slabsEnabled = false;
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+#if defined(SUPPORTS_THREAD_LOCAL)
+   if (_slabsEnabled)
+      {
+      if (VM_AtomicSupport::add(&liveSlabAllocators, 1) == 1)
+         {
+         tlsAlloc(persistentAllocatorThreadCache);
+         tlsAlloc(persistentAllocatorThreadCacheGeneration);
+         }
+      uintptr_t generation = VM_AtomicSupport::add(&slabAllocatorGenerations, 1) * MaxLiveSlabAllocators;
+      for (uintptr_t i = 0; i < MaxLiveSlabAllocators; ++i)
+         {
+         if (liveSlabAllocatorGenerations[i] == 0 &&
+             VM_AtomicSupport::lockCompareExchange(&liveSlabAllocatorGenerations[i], 0, generation | i) == 0)
+            {
+            _generation = generation | i;
+            break;
+            }
+         }
+#if defined(OMR_OS_WINDOWS)
+      _threadExitKey = FlsAlloc(threadExited);
+      _threadExitKeyValid = (FLS_OUT_OF_INDEXES != _threadExitKey);
+#else
+      _threadExitKeyValid = (0 == pthread_key_create(&_threadExitKey, threadExited));
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+#endif
+   }
+
+OMR::PersistentAllocator::~PersistentAllocator() throw()
+   {
+   if (!_slabsEnabled)
+      return;
+
+   // Threads still alive keep their caches until now; they are released
+   // with the arenas, so the exit hook must not run for them afterwards.
+   // Their thread-local slots are left pointing at the freed caches, which
+   // the generation check keeps any later allocator from using.
+#if defined(SUPPORTS_THREAD_LOCAL)
+   if (_threadExitKeyValid)
+      {
+#if defined(OMR_OS_WINDOWS)
+      FlsFree(_threadExitKey);
+#else
+      pthread_key_delete(_threadExitKey);
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+   if (_generation)
+      liveSlabAllocatorGenerations[_generation % MaxLiveSlabAllocators] = 0;
+   if (ownsThreadCacheSlot())
+      tlsSet(persistentAllocatorThreadCache, static_cast<ThreadCache *>(NULL));
+   if (VM_AtomicSupport::subtract(&liveSlabAllocators, 1) == 0)
+      {
+      tlsFree(persistentAllocatorThreadCache);
+      tlsFree(persistentAllocatorThreadCacheGeneration);
+#if defined(OMR_OS_WINDOWS)
+      persistentAllocatorThreadCache = TLS_OUT_OF_INDEXES;
+      persistentAllocatorThreadCacheGeneration = TLS_OUT_OF_INDEXES;
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+#endif
+   while (_threadCaches)
+      {
+      ThreadCache *cache = _threadCaches;
+      _threadCaches = cache->_next;
+      _rawAllocator.deallocate(cache);
+      }
+   while (_arenas)
+      {
+      Arena *arena = _arenas;
+      _arenas = arena->_next;
+      _rawAllocator.deallocate(arena->_rawBase);
+      _rawAllocator.deallocate(arena);
+      }
+   if (_registry)
+      _rawAllocator.deallocate(const_cast<uintptr_t *>(_registry));
+   MUTEX_DESTROY(_lock);
    }
 
 void *
 OMR::PersistentAllocator::allocate(size_t size, const std::nothrow_t tag, void * hint) throw()
    {
-   return _rawAllocator.allocate(size, tag, hint);
+   return allocate(size, UncategorizedCategory, tag);
    }
 
 void *
 OMR::PersistentAllocator::allocate(size_t size, void * hint)
    {
-   return _rawAllocator.allocate(size, hint);
+   if (!_slabsEnabled)
+      return _rawAllocator.allocate(size, hint);
+   if (size != 0 && size <= MaxSlabBlockSize)
+      {
+      void *p = allocateSmall(sizeClassFor(size), UncategorizedCategory);
+      if (p)
+         return p;
+      }
+   return allocateLarge(size, UncategorizedCategory, true);
+   }
+
+void *
+OMR::PersistentAllocator::allocate(size_t size, uint32_t category, const std::nothrow_t tag) throw()
+   {
+   if (!_slabsEnabled)
+      return _rawAllocator.allocate(size, tag);
+   if (category >= NumCategories)
+      category = UncategorizedCategory;
+   if (size != 0 && size <= MaxSlabBlockSize)
+      {
+      void *p = allocateSmall(sizeClassFor(size), category);
+      if (p)
+         return p;
+      }
+   return allocateLarge(size, category, false);
    }
 
 void
 OMR::PersistentAllocator::deallocate(void * p, const size_t sizeHint) throw()
    {
-   _rawAllocator.deallocate(p, sizeHint);
+   if (!_slabsEnabled)
+      {
+      _rawAllocator.deallocate(p, sizeHint);
+      return;
+      }
+   if (!p)
+      return;
+
+   Slab *slab = slabFor(p);
+   if (slab)
+      {
+      deallocateSmall(slab, p);
+      return;
+      }
+
+   uintptr_t *header = reinterpret_cast<uintptr_t *>(static_cast<uint8_t *>(p) - LargeBlockHeaderSize);
+   VM_AtomicSupport::subtract(&_centralBytesInUse[header[1]], header[0]);
+   _rawAllocator.deallocate(header);
+   }
+
+size_t
+OMR::PersistentAllocator::bytesInUse(uint32_t category)
+   {
+   if (category >= NumCategories)
+      return 0;
+   if (!_slabsEnabled)
+      return _centralBytesInUse[category];
+
+   // Read the central counter under the lock as well, so that a cache being
+   // folded into it by an exiting thread is not counted twice.
+   LockHolder holder(_lock);
+   uintptr_t total = _centralBytesInUse[category];
+   for (ThreadCache *cache = _threadCaches; cache; cache = cache->_next)
+      total += cache->_bytesInUse[category];
+   return total;
+   }
+
+size_t
+OMR::PersistentAllocator::threadCacheCount()
+   {
+   if (!_slabsEnabled)
+      return 0;
+   size_t count = 0;
+   LockHolder holder(_lock);
+   for (ThreadCache *cache = _threadCaches; cache; cache = cache->_next)
+      count++;
+   return count;
+   }
+
+void *
+OMR::PersistentAllocator::allocateLarge(size_t size, uint32_t category, bool throwOnFailure)
+   {
+   size_t rawSize = size + LargeBlockHeaderSize;
+   if (rawSize < size)
+      {
+      if (throwOnFailure)
+         throw std::bad_alloc();
+      return NULL;
+      }
+   uintptr_t *header = throwOnFailure ?
+      static_cast<uintptr_t *>(_rawAllocator.allocate(rawSize)) :
+      static_cast<uintptr_t *>(_rawAllocator.allocate(rawSize, std::nothrow));
+   if (!header)
+      return NULL;
+   header[0] = size;
+   header[1] = category;
+   VM_AtomicSupport::add(&_centralBytesInUse[category], size);
+   return reinterpret_cast<uint8_t *>(header) + LargeBlockHeaderSize;
+   }
+
+void *
+OMR::PersistentAllocator::allocateSmall(uint32_t sizeClass, uint32_t category)
+   {
+   uint32_t blockSize = _sizeClassSizes[sizeClass];
+   FreeBlock *block = NULL;
+   ThreadCache *cache = threadCache();
+   if (cache)
+      {
+      if (!cache->_freeLists[sizeClass])
+         refill(cache, sizeClass);
+      block = cache->_freeLists[sizeClass];
+      if (!block)
+         return NULL;
+      cache->_freeLists[sizeClass] = block->_next;
+      cache->_counts[sizeClass]--;
+      cache->_bytesInUse[category] += blockSize;
+      }
+   else
+      {
+         {
+         LockHolder holder(_lock);
+         block = static_cast<FreeBlock *>(allocateCentral(sizeClass));
+         }
+      if (!block)
+         return NULL;
+      VM_AtomicSupport::add(&_centralBytesInUse[category], blockSize);
+      }
+
+   Slab *slab = reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(block) & ~(uintptr_t)(SlabSize - 1));
+   slab->_categories[(reinterpret_cast<uint8_t *>(block) - slab->_firstBlock) / blockSize] = static_cast<uint8_t>(category);
+   return block;
+   }
+
+void
+OMR::PersistentAllocator::deallocateSmall(Slab *slab, void *p)
+   {
+   uint32_t sizeClass = slab->_sizeClass;
+   uint32_t blockSize = slab->_blockSize;
+   uint32_t category = slab->_categories[(static_cast<uint8_t *>(p) - slab->_firstBlock) / blockSize];
+   FreeBlock *block = static_cast<FreeBlock *>(p);
+
+   ThreadCache *cache = threadCache();
+   if (cache)
+      {
+      block->_next = cache->_freeLists[sizeClass];
+      cache->_freeLists[sizeClass] = block;
+      cache->_bytesInUse[category] -= blockSize;
+      if (++cache->_counts[sizeClass] > threadCacheLimit(blockSize))
+         flush(cache, sizeClass, threadCacheLimit(blockSize) / 2);
+      }
+   else
+      {
+      VM_AtomicSupport::subtract(&_centralBytesInUse[category], blockSize);
+      block->_next = NULL;
+      LockHolder holder(_lock);
+      freeCentral(sizeClass, block, block);
+      }
+   }
+
+/**
+ * Pops a block of the given class from the central free list, carving a
+ * fresh one from the current slab of that class when the list is empty.
+ * Must be called with _lock held.
+ */
+void *
+OMR::PersistentAllocator::allocateCentral(uint32_t sizeClass)
+   {
+   FreeBlock *block = _freeLists[sizeClass];
+   if (block)
+      {
+      _freeLists[sizeClass] = block->_next;
+      return block;
+      }
+
+   Slab *slab = _currentSlabs[sizeClass];
+   if (!slab || slab->_bumpPointer + slab->_blockSize > slab->_end)
+      {
+      slab = newSlab(sizeClass);
+      if (!slab)
+         return NULL;
+      _currentSlabs[sizeClass] = slab;
+      }
+   void *p = slab->_bumpPointer;
+   slab->_bumpPointer += slab->_blockSize;
+   return p;
+   }
+
+/// Must be called with _lock held.
+void
+OMR::PersistentAllocator::freeCentral(uint32_t sizeClass, FreeBlock *first, FreeBlock *last)
+   {
+   last->_next = _freeLists[sizeClass];
+   _freeLists[sizeClass] = first;
+   }
+
+/// Must be called with _lock held.
+OMR::PersistentAllocator::Slab *
+OMR::PersistentAllocator::newSlab(uint32_t sizeClass)
+   {
+   // Keep the registry at most half full so that probes stay short
+   if (_registryCount >= RegistryCapacity / 2)
+      return NULL;
+
+   if (!_registry)
+      {
+      void *registry = _rawAllocator.allocate(RegistryCapacity * sizeof(uintptr_t), std::nothrow);
+      if (!registry)
+         return NULL;
+      memset(registry, 0, RegistryCapacity * sizeof(uintptr_t));
+      _registry = static_cast<volatile uintptr_t *>(registry);
+      }
+
+   if (_arenaNext == _arenaEnd)
+      {
+      Arena *arena = static_cast<Arena *>(_rawAllocator.allocate(sizeof(Arena), std::nothrow));
+      if (!arena)
+         return NULL;
+      // One extra slab's worth so the arena can be aligned to the slab size;
+      // the unused head and tail are never touched.
+      size_t rawSize = (SlabsPerArena + 1) * SlabSize;
+      void *rawBase = _rawAllocator.allocate(rawSize, std::nothrow);
+      if (!rawBase)
+         {
+         _rawAllocator.deallocate(arena);
+         return NULL;
+         }
+      arena->_rawBase = rawBase;
+      arena->_next = _arenas;
+      _arenas = arena;
+      _arenaBytes += rawSize;
+      uintptr_t aligned = (reinterpret_cast<uintptr_t>(rawBase) + SlabSize - 1) & ~(uintptr_t)(SlabSize - 1);
+      _arenaNext = reinterpret_cast<uint8_t *>(aligned);
+      _arenaEnd = _arenaNext + SlabsPerArena * SlabSize;
+      }
+
+   Slab *slab = reinterpret_cast<Slab *>(_arenaNext);
+   _arenaNext += SlabSize;
+
+   uint32_t blockSize = _sizeClassSizes[sizeClass];
+   uint8_t *base = reinterpret_cast<uint8_t *>(slab);
+   uint8_t *end = base + SlabSize;
+   size_t headerSize = offsetof(Slab, _categories);
+   size_t blocks = (SlabSize - headerSize) / (blockSize + 1);
+   uint8_t *firstBlock = NULL;
+   do
+      {
+      firstBlock = reinterpret_cast<uint8_t *>((reinterpret_cast<uintptr_t>(base) + headerSize + blocks + 15) & ~(uintptr_t)15);
+      }
+   while (firstBlock + blocks * blockSize > end && --blocks > 0);
+
+   slab->_sizeClass = sizeClass;
+   slab->_blockSize = blockSize;
+   slab->_firstBlock = firstBlock;
+   slab->_bumpPointer = firstBlock;
+   slab->_end = firstBlock + blocks * blockSize;
+
+   if (!registerSlab(slab))
+      return NULL;
+   _slabCount++;
+   return slab;
+   }
+
+uintptr_t
+OMR::PersistentAllocator::registryHash(uintptr_t slabBase)
+   {
+   uint64_t key = static_cast<uint64_t>(slabBase / SlabSize);
+   return static_cast<uintptr_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (RegistryCapacity - 1);
+   }
+
+/**
+ * Records a slab base in the open-addressed registry.  Entries are never
+ * removed, and each is published with a write barrier so that lookups can
+ * proceed without the lock.  Must be called with _lock held.
+ */
+bool
+OMR::PersistentAllocator::registerSlab(Slab *slab)
+   {
+   uintptr_t base = reinterpret_cast<uintptr_t>(slab);
+   for (uintptr_t i = registryHash(base); ; i = (i + 1) & (RegistryCapacity - 1))
+      {
+      if (_registry[i] == 0)
+         {
+         VM_AtomicSupport::writeBarrier();
+         _registry[i] = base;
+         _registryCount++;
+         return true;
+         }
+      }
+   }
+
+OMR::PersistentAllocator::Slab *
+OMR::PersistentAllocator::slabFor(void *p) const
+   {
+   volatile uintptr_t *registry = _registry;
+   if (!registry)
+      return NULL;
+   uintptr_t base = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(SlabSize - 1);
+   for (uintptr_t i = registryHash(base); ; i = (i + 1) & (RegistryCapacity - 1))
+      {
+      uintptr_t entry = registry[i];
+      if (entry == base)
+         {
+         VM_AtomicSupport::readBarrier();
+         return reinterpret_cast<Slab *>(base);
+         }
+      if (entry == 0)
+         return NULL;
+      }
+   }
+
+/**
+ * Whether the calling thread's cache slot holds a cache of this allocator,
+ * decided without touching the cache.
+ */
+bool
+OMR::PersistentAllocator::ownsThreadCacheSlot()
+   {
+#if defined(SUPPORTS_THREAD_LOCAL)
+   return _generation && reinterpret_cast<uintptr_t>(tlsGet(persistentAllocatorThreadCacheGeneration, void *)) == _generation;
+#else
+   return false;
+#endif
+   }
+
+OMR::PersistentAllocator::ThreadCache *
+OMR::PersistentAllocator::threadCache()
+   {
+#if defined(SUPPORTS_THREAD_LOCAL)
+   if (!_generation)
+      return NULL;
+   ThreadCache *cache = tlsGet(persistentAllocatorThreadCache, ThreadCache *);
+   if (cache)
+      {
+      if (ownsThreadCacheSlot())
+         return cache;
+      // The slot belongs to another allocator.  If that one has been
+      // destroyed, so has the cache, and the slot can be taken over;
+      // otherwise this thread goes uncached here.
+      uintptr_t generation = reinterpret_cast<uintptr_t>(tlsGet(persistentAllocatorThreadCacheGeneration, void *));
+      if (liveSlabAllocatorGenerations[generation % MaxLiveSlabAllocators] == generation)
+         return NULL;
+      }
+
+   cache = static_cast<ThreadCache *>(_rawAllocator.allocate(sizeof(ThreadCache), std::nothrow));
+   if (!cache)
+      return NULL;
+   memset(cache, 0, sizeof(ThreadCache));
+   cache->_owner = this;
+      {
+      LockHolder holder(_lock);
+      cache->_next = _threadCaches;
+      _threadCaches = cache;
+      }
+   tlsSet(persistentAllocatorThreadCache, cache);
+   tlsSet(persistentAllocatorThreadCacheGeneration, reinterpret_cast<void *>(_generation));
+   if (_threadExitKeyValid)
+      {
+#if defined(OMR_OS_WINDOWS)
+      FlsSetValue(_threadExitKey, cache);
+#else
+      pthread_setspecific(_threadExitKey, cache);
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+   return cache;
+#else
+   return NULL;
+#endif
+   }
+
+void
+OMR::PersistentAllocator::refill(ThreadCache *cache, uint32_t sizeClass)
+   {
+   uint32_t batch = threadCacheLimit(_sizeClassSizes[sizeClass]) / 2;
+   LockHolder holder(_lock);
+   for (uint32_t i = 0; i < batch; ++i)
+      {
+      FreeBlock *block = static_cast<FreeBlock *>(allocateCentral(sizeClass));
+      if (!block)
+         break;
+      block->_next = cache->_freeLists[sizeClass];
+      cache->_freeLists[sizeClass] = block;
+      cache->_counts[sizeClass]++;
+      }
+   }
+
+void
+OMR::PersistentAllocator::flush(ThreadCache *cache, uint32_t sizeClass, uint32_t keep)
+   {
+   FreeBlock *last = cache->_freeLists[sizeClass];
+   for (uint32_t i = 1; i < keep; ++i)
+      last = last->_next;
+   FreeBlock *first = last->_next;
+   last->_next = NULL;
+   cache->_counts[sizeClass] = keep;
+   if (!first)
+      return;
+
+   FreeBlock *tail = first;
+   while (tail->_next)
+      tail = tail->_next;
+   LockHolder holder(_lock);
+   freeCentral(sizeClass, first, tail);
+   }
+
+void
+OMR::PersistentAllocator::releaseThreadCache()
+   {
+#if defined(SUPPORTS_THREAD_LOCAL)
+   if (!_slabsEnabled)
+      return;
+   ThreadCache *cache = tlsGet(persistentAllocatorThreadCache, ThreadCache *);
+   if (!cache || !ownsThreadCacheSlot())
+      return;
+   tlsSet(persistentAllocatorThreadCache, static_cast<ThreadCache *>(NULL));
+   if (_threadExitKeyValid)
+      {
+#if defined(OMR_OS_WINDOWS)
+      FlsSetValue(_threadExitKey, NULL);
+#else
+      pthread_setspecific(_threadExitKey, NULL);
+#endif /* defined(OMR_OS_WINDOWS) */
+      }
+   releaseCache(cache);
+#endif
+   }
+
+/**
+ * Unlinks a cache, hands its free blocks back to the central lists and
+ * folds its live byte counts into the central counters.
+ */
+void
+OMR::PersistentAllocator::releaseCache(ThreadCache *cache)
+   {
+      {
+      LockHolder holder(_lock);
+      ThreadCache **link = &_threadCaches;
+      while (*link != cache)
+         link = &(*link)->_next;
+      *link = cache->_next;
+
+      for (uint32_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+         {
+         FreeBlock *first = cache->_freeLists[sizeClass];
+         if (!first)
+            continue;
+         FreeBlock *tail = first;
+         while (tail->_next)
+            tail = tail->_next;
+         freeCentral(sizeClass, first, tail);
+         }
+      for (uint32_t category = 0; category < NumCategories; ++category)
+         {
+         if (cache->_bytesInUse[category])
+            VM_AtomicSupport::add(&_centralBytesInUse[category], cache->_bytesInUse[category]);
+         }
+      }
+   _rawAllocator.deallocate(cache);
+   }
+
+#if defined(OMR_OS_WINDOWS)
+VOID WINAPI
+OMR::PersistentAllocator::threadExited(PVOID cache)
+#else
+void
+OMR::PersistentAllocator::threadExited(void *cache)
+#endif /* defined(OMR_OS_WINDOWS) */
+   {
+   ThreadCache *exiting = static_cast<ThreadCache *>(cache);
+#if defined(SUPPORTS_THREAD_LOCAL)
+   if (tlsGet(persistentAllocatorThreadCache, ThreadCache *) == exiting)
+      tlsSet(persistentAllocatorThreadCache, static_cast<ThreadCache *>(NULL));
+#endif
+   exiting->_owner->releaseCache(exiting);
    }
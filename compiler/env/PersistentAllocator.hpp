@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2019 IBM Corp. and others
+ * Copyright (c) 2000, 2026 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -37,21 +37,68 @@ namespace TR { using OMR::PersistentAllocator; }
 
 #include "env/RawAllocator.hpp"
 #include "env/PersistentAllocatorKit.hpp"
+#include "omrmutex.h"
 
 namespace OMR {
 
+/**
+ * Allocator for memory that outlives a compilation.
+ *
+ * Requests of up to MaxSlabBlockSize bytes are served from size-class
+ * segregated slabs carved out of large raw arenas.  Freed blocks go to a
+ * bounded per-thread cache first and spill over to a central free list per
+ * size class, so the common allocate/free pair does not take a lock and
+ * does not call into the raw allocator.  Larger requests, and all requests
+ * when the kit disables slabs, go straight to the raw allocator.
+ *
+ * Every allocation carries an 8-bit category (normally a
+ * TR_MemoryBase::ObjectType) so that live persistent memory can be broken
+ * down by the kind of object that owns it.
+ */
 class PersistentAllocator
    {
 public:
    PersistentAllocator(const TR::PersistentAllocatorKit &allocatorKit);
+   ~PersistentAllocator() throw();
+
+   static const uint32_t NumCategories = 256;
+   static const uint32_t UncategorizedCategory = NumCategories - 1;
+   static const size_t MaxSlabBlockSize = 2048;
 
    void *allocate(size_t size, const std::nothrow_t tag, void * hint = 0) throw();
    void * allocate(size_t size, void * hint = 0);
+   void *allocate(size_t size, uint32_t category, const std::nothrow_t tag) throw();
    void deallocate(void * p, const size_t sizeHint = 0) throw();
 
+   /**
+    * @brief Bytes currently allocated under the given category, including
+    *        size-class rounding.  The value is a snapshot and may be slightly
+    *        stale with respect to allocations in flight on other threads.
+    */
+   size_t bytesInUse(uint32_t category);
+
+   /** @brief Bytes obtained from the raw allocator for slab arenas */
+   size_t slabBytesReserved() const { return _arenaBytes; }
+
+   /** @brief Bytes of slab storage that have been handed out at least once */
+   size_t slabBytesCommitted() const { return _slabCount * SlabSize; }
+
+   bool slabsEnabled() const { return _slabsEnabled; }
+
+   /**
+    * @brief Return the calling thread's cache to the central free lists.
+    *        This happens automatically when the thread exits; a thread that
+    *        is done with the allocator long before it exits may call it
+    *        earlier.  A later allocation on the thread creates a new cache.
+    */
+   void releaseThreadCache();
+
+   /** @brief Number of threads currently holding a cache for this allocator */
+   size_t threadCacheCount();
+
    friend bool operator ==(const PersistentAllocator &left, const PersistentAllocator &right)
       {
-      return left._rawAllocator == right._rawAllocator;
+      return &left == &right;
       }
 
    friend bool operator !=(const PersistentAllocator &left, const PersistentAllocator &right)
@@ -59,11 +106,90 @@ public:
       return !operator ==(left, right);
       }
 
+   struct ThreadCache;
+
 private:
    PersistentAllocator(const PersistentAllocator &);
 
-   TR::RawAllocator _rawAllocator;
+   static const size_t SlabSize = 64 * 1024;
+   static const size_t SlabsPerArena = 16;
+   static const size_t RegistryCapacity = 16 * 1024;
+   static const uint32_t NumSizeClasses = 24;
+   static const size_t LargeBlockHeaderSize = 16;
+
+   struct FreeBlock
+      {
+      FreeBlock *_next;
+      };
 
+   struct Slab
+      {
+      uint32_t _sizeClass;
+      uint32_t _blockSize;
+      uint8_t *_firstBlock;
+      uint8_t *_bumpPointer;
+      uint8_t *_end;
+      uint8_t _categories[1];
+      };
+
+   struct Arena
+      {
+      Arena *_next;
+      void *_rawBase;
+      };
+
+   void *allocateLarge(size_t size, uint32_t category, bool throwOnFailure);
+   void *allocateSmall(uint32_t sizeClass, uint32_t category);
+   void deallocateSmall(Slab *slab, void *p);
+
+   void *allocateCentral(uint32_t sizeClass);
+   void freeCentral(uint32_t sizeClass, FreeBlock *first, FreeBlock *last);
+   Slab *newSlab(uint32_t sizeClass);
+   bool registerSlab(Slab *slab);
+   Slab *slabFor(void *p) const;
+
+   ThreadCache *threadCache();
+   bool ownsThreadCacheSlot();
+   void refill(ThreadCache *cache, uint32_t sizeClass);
+   void flush(ThreadCache *cache, uint32_t sizeClass, uint32_t keep);
+   void releaseCache(ThreadCache *cache);
+
+#if defined(OMR_OS_WINDOWS)
+   static VOID WINAPI threadExited(PVOID cache);
+#else
+   static void threadExited(void *cache);
+#endif /* defined(OMR_OS_WINDOWS) */
+
+   static uint32_t sizeClassFor(size_t size) { return _sizeClassIndex[(size + 15) >> 4]; }
+   static uintptr_t registryHash(uintptr_t slabBase);
+
+   static const uint16_t _sizeClassSizes[NumSizeClasses];
+   static const uint8_t _sizeClassIndex[(MaxSlabBlockSize >> 4) + 1];
+
+   TR::RawAllocator _rawAllocator;
+   bool _slabsEnabled;
+   MUTEX _lock;
+
+   FreeBlock *_freeLists[NumSizeClasses];
+   Slab *_currentSlabs[NumSizeClasses];
+   uint8_t *_arenaNext;
+   uint8_t *_arenaEnd;
+   Arena *_arenas;
+   size_t _arenaBytes;
+   size_t _slabCount;
+
+   volatile uintptr_t *_registry;
+   uintptr_t _registryCount;
+
+   ThreadCache *_threadCaches;
+   uintptr_t _generation; // identifies this allocator's caches in the thread-local slot
+#if defined(OMR_OS_WINDOWS)
+   DWORD _threadExitKey;
+#else
+   pthread_key_t _threadExitKey;
+#endif /* defined(OMR_OS_WINDOWS) */
+   bool _threadExitKeyValid;
+   volatile uintptr_t _centralBytesInUse[NumCategories];
    };
 
 }
@@ -38,12 +38,16 @@ namespace OMR
 
 struct PersistentAllocatorKit
    {
-   PersistentAllocatorKit(TR::RawAllocator rawAllocator) :
-      rawAllocator(rawAllocator)
+   PersistentAllocatorKit(TR::RawAllocator rawAllocator, bool useSlabs = true) :
+      rawAllocator(rawAllocator),
+      useSlabs(useSlabs)
       {
       }
 
    TR::RawAllocator rawAllocator;
+
+   /// Serve small requests from size-class slabs rather than one raw allocation each
+   bool useSlabs;
    };
 
 }
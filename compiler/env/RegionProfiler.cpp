@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/RegionProfiler.hpp"
+
+#include <exception>
+#include <stdio.h>
+#include "env/CompilerEnv.hpp"
+#include "env/PassProfile.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "infra/Assert.hpp"
+#include "ras/DebugCounter.hpp"
+
+TR::RegionProfiler::RegionProfiler(TR::Region &region, TR::Compilation &compilation, const char *format, ...) :
+   _region(region),
+   _initialRegionSize(_region.bytesAllocated()),
+   _initialSegmentProviderSize(_region._segmentProvider.bytesAllocated()),
+   _compilation(compilation),
+   _passProfile(TR::PassProfile::instance()),
+   _methodSymbol(NULL)
+   {
+   va_list args;
+   va_start(args, format);
+   start(format, args);
+   va_end(args);
+   }
+
+TR::RegionProfiler::RegionProfiler(TR::Region &region, TR::Compilation &compilation, TR::ResolvedMethodSymbol *methodSymbol, const char *format, ...) :
+   _region(region),
+   _initialRegionSize(_region.bytesAllocated()),
+   _initialSegmentProviderSize(_region._segmentProvider.bytesAllocated()),
+   _compilation(compilation),
+   _passProfile(TR::PassProfile::instance()),
+   _methodSymbol(methodSymbol)
+   {
+   va_list args;
+   va_start(args, format);
+   start(format, args);
+   va_end(args);
+   }
+
+TR::RegionProfiler::~RegionProfiler()
+   {
+   if (_compilation.getOption(TR_ProfileMemoryRegions))
+      {
+      TR::DebugCounter::incStaticDebugCounter(
+         &_compilation,
+         TR::DebugCounter::debugCounterName(
+            &_compilation,
+            "kbytesAllocated.details/%s",
+            _identifier
+            ),
+         (_region.bytesAllocated() - _initialRegionSize) / 1024
+         );
+      TR::DebugCounter::incStaticDebugCounter(
+         &_compilation,
+         TR::DebugCounter::debugCounterName(
+            &_compilation,
+            "segmentAllocation.details/%s",
+             _identifier
+             ),
+         (_region._segmentProvider.bytesAllocated() - _initialSegmentProviderSize) / 1024
+         );
+      }
+   // A pass abandoned by an exception may have left the IL mid-transformation
+   if (_passProfile && !std::uncaught_exception())
+      {
+      uint64_t time = TR::Compiler->vm.getUSecClock() - _startTime;
+      _passProfile->record(
+         _identifier,
+         time,
+         _region.bytesAllocated() - _initialRegionSize,
+         _region._segmentProvider.bytesAllocated() - _initialSegmentProviderSize,
+         _initialNodeCount,
+         _methodSymbol ? _methodSymbol->generateAccurateNodeCount() : 0,
+         _methodSymbol != NULL
+         );
+      }
+   }
+
+void
+TR::RegionProfiler::start(const char *format, va_list args)
+   {
+   if (_compilation.getOption(TR_ProfileMemoryRegions) || _passProfile)
+      {
+      int len = vsnprintf(_identifier, sizeof(_identifier), format, args);
+      TR_ASSERT(len < sizeof(_identifier), "Region profiler identifier truncated as it exceeded max length %d", sizeof(_identifier));
+      _identifier[sizeof(_identifier) - 1] = '\0';
+      }
+   if (_passProfile)
+      {
+      _initialNodeCount = _methodSymbol ? _methodSymbol->generateAccurateNodeCount() : 0;
+      _startTime = TR::Compiler->vm.getUSecClock();
+      }
+   }
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2017, 2017 IBM Corp. and others
+ * Copyright (c) 2017, 2026 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -24,10 +24,19 @@
 
 #pragma once
 
+#include <stdarg.h>
 #include "env/Region.hpp"
 #include "env/SegmentProvider.hpp"
 #include "compile/Compilation.hpp"
 
+#ifndef TR_PASS_PROFILE
+#define TR_PASS_PROFILE
+namespace OMR { class PassProfile; }
+namespace TR { using OMR::PassProfile; }
+#endif
+
+namespace TR { class ResolvedMethodSymbol; }
+
 namespace TR {
 
 /**
@@ -43,58 +52,36 @@ namespace TR {
  * profiler object must comprehend the lifetime of the profiler itself. The
  * implementation requires a compilation object in order to determine whether
  * or not the facility is active.
+ *
+ * When the pass profile is active (TR::PassProfile), the wall time, memory
+ * usage and, optionally, IL node counts between the two points are also added
+ * to it under the profiler's identifier.
  */
 
 class RegionProfiler
    {
 public:
-   RegionProfiler(TR::Region &region, TR::Compilation &compilation, const char *format, ...) :
-      _region(region),
-      _initialRegionSize(_region.bytesAllocated()),
-      _initialSegmentProviderSize(_region._segmentProvider.bytesAllocated()),
-      _compilation(compilation)
-      {
-      if (_compilation.getOption(TR_ProfileMemoryRegions))
-         {
-         va_list args;
-         va_start(args, format);
-         int len = vsnprintf(_identifier, sizeof(_identifier), format, args);
-         TR_ASSERT(len < sizeof(_identifier), "Region profiler identifier truncated as it exceeded max length %d", sizeof(_identifier));
-         _identifier[sizeof(_identifier) - 1] = '\0';
-         va_end(args);
-         }
-      }
+   RegionProfiler(TR::Region &region, TR::Compilation &compilation, const char *format, ...);
+
+   /**
+    * @brief Profile a pass over the IL of methodSymbol; when the pass profile
+    * is active its IL nodes are counted before and after.
+    */
+   RegionProfiler(TR::Region &region, TR::Compilation &compilation, TR::ResolvedMethodSymbol *methodSymbol, const char *format, ...);
 
-   ~RegionProfiler()
-      {
-      if (_compilation.getOption(TR_ProfileMemoryRegions))
-         {
-         TR::DebugCounter::incStaticDebugCounter(
-            &_compilation,
-            TR::DebugCounter::debugCounterName(
-               &_compilation,
-               "kbytesAllocated.details/%s",
-               _identifier
-               ),
-            (_region.bytesAllocated() - _initialRegionSize) / 1024
-            );
-         TR::DebugCounter::incStaticDebugCounter(
-            &_compilation,
-            TR::DebugCounter::debugCounterName(
-               &_compilation,
-               "segmentAllocation.details/%s",
-                _identifier
-                ),
-            (_region._segmentProvider.bytesAllocated() - _initialSegmentProviderSize) / 1024
-            );
-         }
-      }
+   ~RegionProfiler();
 
 private:
+   void start(const char *format, va_list args);
+
    TR::Region &_region;
    size_t const _initialRegionSize;
    size_t const _initialSegmentProviderSize;
    TR::Compilation &_compilation;
+   TR::PassProfile * const _passProfile;
+   TR::ResolvedMethodSymbol * const _methodSymbol;
+   uint64_t _startTime;
+   ncount_t _initialNodeCount;
    char _identifier[256];
    };
 
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/SystemSegmentCache.hpp"
+
+#include <algorithm>
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/VerboseLog.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+TR::SystemSegmentCache *OMR::SystemSegmentCache::_instance = NULL;
+
+OMR::SystemSegmentCache::SystemSegmentCache(size_t segmentSize, size_t capacity, TR::RawAllocator rawAllocator) :
+   _segmentSize(segmentSize),
+   _capacitySegments(capacity / segmentSize),
+   _rawAllocator(rawAllocator),
+   _monitor(TR::Monitor::create("JIT-SystemSegmentCacheMonitor")),
+   _freeSegments(NULL),
+   _cachedSegments(0),
+   _peakCachedSegments(0),
+   _segmentsInUse(0),
+   _highWaterMark(0),
+   _retainTarget(0),
+   _activeProviders(0),
+   _requests(0),
+   _hits(0),
+   _trimmedSegments(0)
+   {
+   TR_ASSERT(segmentSize >= sizeof(FreeSegment), "Segments must be able to hold the free list link");
+   }
+
+OMR::SystemSegmentCache::~SystemSegmentCache() throw()
+   {
+   TR_ASSERT(0 == _activeProviders, "Destroying the segment cache while %u providers still use it", _activeProviders);
+   trim(0);
+   TR::Monitor::destroy(_monitor);
+   }
+
+void
+OMR::SystemSegmentCache::initialize(size_t segmentSize, size_t capacity)
+   {
+   if (NULL != _instance || capacity < segmentSize)
+      return;
+
+   TR::RawAllocator rawAllocator;
+   _instance = new (rawAllocator) TR::SystemSegmentCache(segmentSize, capacity, rawAllocator);
+   }
+
+void
+OMR::SystemSegmentCache::shutdown()
+   {
+   TR::SystemSegmentCache *cache = _instance;
+   if (NULL == cache)
+      return;
+
+   if (TR::Options::getCmdLineOptions() && TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      uint64_t requests = cache->requests();
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_MEMORY,
+         "Scratch segment cache: %llu of %llu segment requests reused (%llu%%), peak cached %lluKB, trimmed %lluKB",
+         static_cast<unsigned long long>(cache->hits()),
+         static_cast<unsigned long long>(requests),
+         static_cast<unsigned long long>(requests > 0 ? (cache->hits() * 100) / requests : 0),
+         static_cast<unsigned long long>(cache->peakCachedBytes() / 1024),
+         static_cast<unsigned long long>(cache->trimmedBytes() / 1024)
+         );
+      }
+
+   _instance = NULL;
+   TR::RawAllocator rawAllocator(cache->_rawAllocator);
+   cache->~SystemSegmentCache();
+   rawAllocator.deallocate(cache);
+   }
+
+void *
+OMR::SystemSegmentCache::allocate(bool &reused)
+   {
+      {
+      OMR::CriticalSection allocating(_monitor);
+      ++_requests;
+      ++_segmentsInUse;
+      _highWaterMark = std::max(_highWaterMark, _segmentsInUse);
+      if (NULL != _freeSegments)
+         {
+         FreeSegment *segment = _freeSegments;
+         _freeSegments = segment->_next;
+         --_cachedSegments;
+         ++_hits;
+         reused = true;
+         return segment;
+         }
+      }
+
+   reused = false;
+   void *segment = _rawAllocator.allocate(_segmentSize, std::nothrow);
+   if (NULL == segment)
+      {
+      OMR::CriticalSection failing(_monitor);
+      --_segmentsInUse;
+      throw std::bad_alloc();
+      }
+   return segment;
+   }
+
+void
+OMR::SystemSegmentCache::deallocate(void *segment) throw()
+   {
+      {
+      OMR::CriticalSection deallocating(_monitor);
+      TR_ASSERT(_segmentsInUse > 0, "Segment returned to the cache more than once");
+      --_segmentsInUse;
+      if (_cachedSegments < _capacitySegments)
+         {
+         FreeSegment *freeSegment = static_cast<FreeSegment *>(segment);
+         freeSegment->_next = _freeSegments;
+         _freeSegments = freeSegment;
+         ++_cachedSegments;
+         _peakCachedSegments = std::max(_peakCachedSegments, _cachedSegments);
+         return;
+         }
+      }
+   _rawAllocator.deallocate(segment);
+   }
+
+void
+OMR::SystemSegmentCache::attach() throw()
+   {
+   OMR::CriticalSection attaching(_monitor);
+   ++_activeProviders;
+   }
+
+void
+OMR::SystemSegmentCache::detach() throw()
+   {
+   size_t retainedSegments = 0;
+      {
+      OMR::CriticalSection detaching(_monitor);
+      TR_ASSERT(_activeProviders > 0, "Unbalanced segment cache detach");
+      if (0 != --_activeProviders)
+         return;
+      _retainTarget = std::max(_highWaterMark, _retainTarget - _retainTarget / 4);
+      _highWaterMark = _segmentsInUse;
+      retainedSegments = _retainTarget;
+      }
+   // Idle: nothing compiles until the next attach, so give back what recent
+   // compilations did not need. The monitor is not re-entrant.
+   trim(retainedSegments);
+   }
+
+void
+OMR::SystemSegmentCache::trim(size_t retainedSegments) throw()
+   {
+   FreeSegment *excess = NULL;
+      {
+      OMR::CriticalSection trimming(_monitor);
+      while (_cachedSegments > retainedSegments)
+         {
+         FreeSegment *segment = _freeSegments;
+         _freeSegments = segment->_next;
+         segment->_next = excess;
+         excess = segment;
+         --_cachedSegments;
+         ++_trimmedSegments;
+         }
+      }
+   while (NULL != excess)
+      {
+      FreeSegment *next = excess->_next;
+      _rawAllocator.deallocate(excess);
+      excess = next;
+      }
+   }
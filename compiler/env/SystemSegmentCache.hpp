@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_SYSTEM_SEGMENT_CACHE
+#define OMR_SYSTEM_SEGMENT_CACHE
+
+#pragma once
+
+#ifndef TR_SYSTEM_SEGMENT_CACHE
+#define TR_SYSTEM_SEGMENT_CACHE
+namespace OMR { class SystemSegmentCache; }
+namespace TR { using OMR::SystemSegmentCache; }
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/RawAllocator.hpp"
+
+namespace TR { class Monitor; }
+
+namespace OMR {
+
+/**
+ * @brief The SystemSegmentCache class keeps scratch segments released by one
+ * compilation for the SystemSegmentProviders of later compilations.
+ *
+ * Only segments of the cache's segment size are kept, up to a byte capacity.
+ * When the last provider using the cache goes away the cache is trimmed to the
+ * high-water mark of segments in use at once since the previous trim, or to
+ * three quarters of the previous target if that is larger, so the memory held
+ * follows recent demand rather than the largest compilation ever seen.
+ *
+ * All members may be called from any compilation thread.
+ */
+class SystemSegmentCache
+   {
+public:
+   SystemSegmentCache(size_t segmentSize, size_t capacity, TR::RawAllocator rawAllocator);
+   ~SystemSegmentCache() throw();
+
+   /**
+    * @brief Create the process-wide cache used by compileMethodFromDetails.
+    * A capacity of 0 leaves the cache disabled.
+    */
+   static void initialize(size_t segmentSize, size_t capacity);
+   /**
+    * @brief Report the cache statistics to the verbose log if requested and
+    * free the process-wide cache.
+    */
+   static void shutdown();
+   static TR::SystemSegmentCache *instance() throw() { return _instance; }
+
+   size_t segmentSize() const throw() { return _segmentSize; }
+
+   /**
+    * @brief Return a segment, reusing a cached one if possible.
+    * @param[out] reused set to true if the segment came from the cache
+    * @throws std::bad_alloc if a new segment cannot be allocated
+    */
+   void *allocate(bool &reused);
+   /**
+    * @brief Keep a segment for reuse, or free it if the cache is full.
+    */
+   void deallocate(void *segment) throw();
+
+   /** @brief Called by each provider using the cache when it is created. */
+   void attach() throw();
+   /** @brief Called by each provider using the cache when it is destroyed; trims when idle. */
+   void detach() throw();
+
+   uint64_t requests() const throw() { return _requests; }
+   uint64_t hits() const throw() { return _hits; }
+   size_t cachedBytes() const throw() { return _cachedSegments * _segmentSize; }
+   size_t peakCachedBytes() const throw() { return _peakCachedSegments * _segmentSize; }
+   uint64_t trimmedBytes() const throw() { return _trimmedSegments * _segmentSize; }
+
+private:
+   struct FreeSegment
+      {
+      FreeSegment *_next;
+      };
+
+   void trim(size_t retainedSegments) throw();
+
+   static TR::SystemSegmentCache *_instance;
+
+   size_t const _segmentSize;
+   size_t const _capacitySegments;
+   TR::RawAllocator _rawAllocator;
+   TR::Monitor *_monitor;
+   FreeSegment *_freeSegments;
+   size_t _cachedSegments;
+   size_t _peakCachedSegments;
+   size_t _segmentsInUse;
+   size_t _highWaterMark;
+   size_t _retainTarget;
+   uint32_t _activeProviders;
+   uint64_t _requests;
+   uint64_t _hits;
+   uint64_t _trimmedSegments;
+   };
+
+} // namespace OMR
+
+#endif // OMR_SYSTEM_SEGMENT_CACHE
@@ -19,27 +19,52 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <new>
 #include "env/SystemSegmentProvider.hpp"
 #include "env/MemorySegment.hpp"
+#include "env/SystemSegmentCache.hpp"
 
-OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator) :
+OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SystemSegmentCache *cache) :
    TR::SegmentAllocator(segmentSize),
    _rawAllocator(rawAllocator),
+   _cache(cache != NULL && cache->segmentSize() == segmentSize ? cache : NULL),
+   _cachedSegmentRequests(0),
+   _cachedSegmentHits(0),
    _currentBytesAllocated(0),
    _highWaterMark(0),
+   _allocationLimit(static_cast<size_t>(-1)),
    _segments(std::less< TR::MemorySegment >(), SegmentSetAllocator(rawAllocator))
    {
+   if (_cache)
+      _cache->attach();
    }
 
 OMR::SystemSegmentProvider::~SystemSegmentProvider() throw()
    {
+   if (_cache)
+      _cache->detach();
    }
 
 TR::MemorySegment &
 OMR::SystemSegmentProvider::request(size_t requiredSize)
    {
    size_t adjustedSize = ( ( requiredSize + (defaultSegmentSize() - 1) ) / defaultSegmentSize() ) * defaultSegmentSize();
-   void *newSegmentArea = _rawAllocator.allocate(adjustedSize);
+   if (_currentBytesAllocated > _allocationLimit || adjustedSize > _allocationLimit - _currentBytesAllocated)
+      throw std::bad_alloc();
+   bool cached = _cache && adjustedSize == defaultSegmentSize();
+   void *newSegmentArea = NULL;
+   if (cached)
+      {
+      bool reused = false;
+      newSegmentArea = _cache->allocate(reused);
+      ++_cachedSegmentRequests;
+      if (reused)
+         ++_cachedSegmentHits;
+      }
+   else
+      {
+      newSegmentArea = _rawAllocator.allocate(adjustedSize);
+      }
    try
       {
       auto result = _segments.insert( TR::MemorySegment(newSegmentArea, adjustedSize) );
@@ -51,7 +76,10 @@ OMR::SystemSegmentProvider::request(size_t requiredSize)
       }
    catch (...)
       {
-      _rawAllocator.deallocate(newSegmentArea);
+      if (cached)
+         _cache->deallocate(newSegmentArea);
+      else
+         _rawAllocator.deallocate(newSegmentArea);
       throw;
       }
    }
@@ -60,7 +88,10 @@ void
 OMR::SystemSegmentProvider::release(TR::MemorySegment &segment) throw()
    {
    auto it = _segments.find(segment);
-   _rawAllocator.deallocate(segment.base());
+   if (_cache && segment.size() == defaultSegmentSize())
+      _cache->deallocate(segment.base());
+   else
+      _rawAllocator.deallocate(segment.base());
    _currentBytesAllocated -= segment.size();
    TR_ASSERT(it != _segments.end(), "Segment lookup should never fail");
    _segments.erase(it);
@@ -87,11 +118,11 @@ OMR::SystemSegmentProvider::systemBytesAllocated() const throw()
 size_t
 OMR::SystemSegmentProvider::allocationLimit() const throw()
    {
-   return static_cast<size_t>(-1);
+   return _allocationLimit;
    }
 
 void
-OMR::SystemSegmentProvider::setAllocationLimit(size_t)
+OMR::SystemSegmentProvider::setAllocationLimit(size_t allocationLimit)
    {
-   return;
+   _allocationLimit = allocationLimit;
    }
@@ -37,12 +37,23 @@ namespace TR { using OMR::SystemSegmentProvider; }
 #include "env/SegmentAllocator.hpp"
 #include "env/RawAllocator.hpp"
 
+#ifndef TR_SYSTEM_SEGMENT_CACHE
+#define TR_SYSTEM_SEGMENT_CACHE
+namespace OMR { class SystemSegmentCache; }
+namespace TR { using OMR::SystemSegmentCache; }
+#endif
+
 namespace OMR {
 
 class SystemSegmentProvider : public TR::SegmentAllocator
    {
 public:
-   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator);
+   /**
+    * @param cache If not NULL, and its segment size matches, default sized
+    * segments are drawn from and returned to this process-wide cache instead
+    * of rawAllocator.
+    */
+   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SystemSegmentCache *cache = NULL);
    ~SystemSegmentProvider() throw();
    virtual TR::MemorySegment &request(size_t requiredSize);
    virtual void release(TR::MemorySegment &segment) throw();
@@ -50,12 +61,22 @@ public:
    size_t regionBytesAllocated() const throw();
    size_t systemBytesAllocated() const throw();
    size_t allocationLimit() const throw();
-   void setAllocationLimit(size_t);
+   /**
+    * @brief Cap the bytes held at any one time; a request that would exceed
+    * the cap throws std::bad_alloc.
+    */
+   void setAllocationLimit(size_t allocationLimit);
+   size_t cachedSegmentRequests() const throw() { return _cachedSegmentRequests; }
+   size_t cachedSegmentHits() const throw() { return _cachedSegmentHits; }
 
 private:
    TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentCache *_cache;
+   size_t _cachedSegmentRequests;
+   size_t _cachedSegmentHits;
    size_t _currentBytesAllocated;
    size_t _highWaterMark;
+   size_t _allocationLimit;
    typedef TR::typed_allocator<
       TR::MemorySegment,
       TR::RawAllocator
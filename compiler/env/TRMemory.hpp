@@ -478,7 +478,8 @@ public:
    void * allocatePersistentMemory(size_t const size, ObjectType const ot = UnknownType) throw()
       {
       _totalPersistentAllocations[ot] += size;
-      void * persistentMemory = _persistentAllocator.get().allocate(size, std::nothrow);
+      uint32_t category = ot < TR::PersistentAllocator::UncategorizedCategory ? ot : TR::PersistentAllocator::UncategorizedCategory;
+      void * persistentMemory = _persistentAllocator.get().allocate(size, category, std::nothrow);
       return persistentMemory;
       }
 
@@ -492,6 +493,8 @@ public:
    void printMemStats();
    void printMemStatsToVlog();
 
+   size_t inUseBytes(uint32_t ot);
+
    uintptr_t _signature;        // eyecatcher
 
    friend class TR_Memory;
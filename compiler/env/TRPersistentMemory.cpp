@@ -86,14 +86,31 @@ TR_PersistentMemory::TR_PersistentMemory(
    {
    }
 
+/**
+ * Live bytes attributed to an object type.  Types that do not fit in the
+ * allocator's 8-bit category are folded into the uncategorized bucket and
+ * report zero here.
+ */
+size_t
+TR_PersistentMemory::inUseBytes(uint32_t ot)
+   {
+   if (ot >= TR::PersistentAllocator::UncategorizedCategory)
+      return 0;
+   return _persistentAllocator.get().bytesInUse(ot);
+   }
+
 void
 TR_PersistentMemory::printMemStats()
    {
+   TR::PersistentAllocator &allocator = _persistentAllocator.get();
    fprintf(stderr, "TR_PersistentMemory Stats:\n");
    for (uint32_t i = 0; i < TR_MemoryBase::NumObjectTypes; i++)
       {
-      fprintf(stderr, "\t_totalPersistentAllocations[%s]=%lu\n", objectName[i], (unsigned long)_totalPersistentAllocations[i]);
+      fprintf(stderr, "\t_totalPersistentAllocations[%s]=%lu inUse=%lu\n", objectName[i], (unsigned long)_totalPersistentAllocations[i], (unsigned long)inUseBytes(i));
       }
+   fprintf(stderr, "\tuncategorized inUse=%lu\n", (unsigned long)allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory));
+   if (allocator.slabsEnabled())
+      fprintf(stderr, "\tslabs committed=%lu reserved=%lu\n", (unsigned long)allocator.slabBytesCommitted(), (unsigned long)allocator.slabBytesReserved());
    fprintf(stderr, "\n");
    }
 
@@ -101,10 +118,16 @@ void
 TR_PersistentMemory::printMemStatsToVlog()
    {
    TR_VerboseLog::vlogAcquire();
+   TR::PersistentAllocator &allocator = _persistentAllocator.get();
    TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "TR_PersistentMemory Stats:");
    for (uint32_t i = 0; i < TR_MemoryBase::NumObjectTypes; i++)
       {
-      TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\t_totalPersistentAllocations[%s]=%lu", objectName[i], (unsigned long)_totalPersistentAllocations[i]);
+      if (_totalPersistentAllocations[i] == 0)
+         continue;
+      TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\t_totalPersistentAllocations[%s]=%lu inUse=%lu", objectName[i], (unsigned long)_totalPersistentAllocations[i], (unsigned long)inUseBytes(i));
       }
+   TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\tuncategorized inUse=%lu", (unsigned long)allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory));
+   if (allocator.slabsEnabled())
+      TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\tslabs committed=%lu reserved=%lu", (unsigned long)allocator.slabBytesCommitted(), (unsigned long)allocator.slabBytesReserved());
    TR_VerboseLog::vlogRelease();
    }
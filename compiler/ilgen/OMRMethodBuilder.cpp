@@ -56,6 +56,9 @@
 // Size of MethodBuilder memory segments
 #define MEM_SEGMENT_SIZE 1 << 16   // i.e. 65536 bytes (~64KB)
 
+// Name under which the invocation counter handler is defined as a function
+#define INVOCATION_COUNTER_HANDLER "_invocationCounterExpired"
+
 #define TraceEnabled    (comp()->getOption(TR_TraceILGen))
 #define TraceIL(m, ...) {if (TraceEnabled) {traceMsg(comp(), m, ##__VA_ARGS__);}}
 
@@ -123,7 +126,9 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
    _inlineSiteIndex(-1),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _invocationCounter(NULL),
+   _invocationCounterHandlerArg(NULL)
    {
    _definingLine[0] = '\0';
    }
@@ -155,7 +160,9 @@ OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachin
    _inlineSiteIndex(callerMB->getNextInlineSiteIndex()),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _invocationCounter(NULL),
+   _invocationCounterHandlerArg(NULL)
    {
    _definingLine[0] = '\0';
    initialize(callerMB->_details, callerMB->_methodSymbol, callerMB->_fe, callerMB->_symRefTab);
@@ -229,6 +236,9 @@ OMR::MethodBuilder::setupForBuildIL()
 
    // set up initial CFG
    cfg()->addEdge(_entryBlock, _currentBlock);
+
+   if (_invocationCounter)
+      injectInvocationCounter();
    }
 
 uint32_t
@@ -700,15 +710,79 @@ OMR::MethodBuilder::GetNextBytecodeFromWorklist()
 int32_t
 OMR::MethodBuilder::Compile(void **entry)
    {
+   return Compile(entry, warm);
+   }
+
+int32_t
+OMR::MethodBuilder::Compile(void **entry, TR_Hotness hotness)
+   {
+   // Symbols defined while building IL are named out of compilation memory,
+   // which is gone once the compilation ends: restore the definitions made
+   // outside of any compilation before building IL for the next one.
+   SymbolTypeMap symbolTypes(_symbolTypes);
+   SlotToSymNameMap symbolNameFromSlot(_symbolNameFromSlot);
+   ArrayIdentifierSet symbolIsArray(_symbolIsArray);
+   resetForCompilation();
+
    TR::ResolvedMethod resolvedMethod(static_cast<TR::MethodBuilder *>(this));
    TR::IlGeneratorMethodDetails details(&resolvedMethod);
 
    int32_t rc=0;
-   *entry = (void *) compileMethodFromDetails(NULL, details, warm, rc);
+   *entry = (void *) compileMethodFromDetails(NULL, details, hotness, rc);
    typeDictionary()->NotifyCompilationDone();
+
+   _symbols.clear();
+   _symbolTypes = symbolTypes;
+   _symbolNameFromSlot = symbolNameFromSlot;
+   _symbolIsArray = symbolIsArray;
    return rc;
    }
 
+void
+OMR::MethodBuilder::resetForCompilation()
+   {
+   _symbols.clear();
+   _nextValueID = 0;
+   _nextInlineSiteIndex = 0;
+   _useBytecodeBuilders = false;
+   _countBlocksWorklist = NULL;
+   _connectTreesWorklist = NULL;
+   _allBytecodeBuilders = NULL;
+   _bytecodeWorklist = NULL;
+   _bytecodeHasBeenInWorklist = NULL;
+   _count = -1;
+   _partOfSequence = false;
+   _connectedTrees = false;
+   _comesBack = true;
+   _currentBlock = NULL;
+   _currentBlockNumber = -1;
+   _numBlocks = 0;
+   _blocks = NULL;
+   _blocksAllocatedUpFront = false;
+   }
+
+void
+OMR::MethodBuilder::setInvocationCounter(int32_t *counter, void *handler, void *handlerArg)
+   {
+   if (counter && _functions.find(INVOCATION_COUNTER_HANDLER) == _functions.end())
+      DefineFunction(INVOCATION_COUNTER_HANDLER, __FILE__, LINETOSTR(__LINE__), handler, NoType, 1, Address);
+   _invocationCounter = counter;
+   _invocationCounterHandlerArg = handlerArg;
+   }
+
+void
+OMR::MethodBuilder::injectInvocationCounter()
+   {
+   TR::IlType *pInt32 = typeDictionary()->PointerTo(Int32);
+   TR::IlValue *counter = ConstAddress(_invocationCounter);
+   TR::IlValue *count = Sub(LoadAt(pInt32, counter), ConstInt32(1));
+   StoreAt(counter, count);
+
+   TR::IlBuilder *expired = NULL;
+   IfThen(&expired, EqualTo(count, ConstInt32(0)));
+   expired->Call(INVOCATION_COUNTER_HANDLER, 1, expired->ConstAddress(_invocationCounterHandlerArg));
+   }
+
 void *
 OMR::MethodBuilder::client()
    {
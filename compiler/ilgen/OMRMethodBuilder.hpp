@@ -25,6 +25,7 @@
 #include <map>
 #include <set>
 #include <fstream>
+#include "compile/CompilationTypes.hpp"
 #include "env/TRMemory.hpp"
 #include "ilgen/IlBuilder.hpp"
 #include "env/TypedAllocator.hpp"
@@ -138,6 +139,21 @@ class MethodBuilder : public TR::IlBuilder
 
    int32_t Compile(void **entry);
 
+   /**
+    * @brief compiles this MethodBuilder at the given hotness
+    * A MethodBuilder may be compiled more than once: each compilation runs
+    * buildIL() again from the state the builder had before its first one.
+    */
+   int32_t Compile(void **entry, TR_Hotness hotness);
+
+   /**
+    * @brief makes compiled code for this MethodBuilder count its invocations
+    * On entry, the code decrements *counter and calls handler(handlerArg)
+    * when the count reaches zero.  Passing a NULL counter stops counting in
+    * subsequent compilations.
+    */
+   void setInvocationCounter(int32_t *counter, void *handler, void *handlerArg);
+
    /**
     * @brief will be called if a Call is issued to a function that has not yet been defined, provides a
     *        mechanism for MethodBuilder subclasses to provide method lookup on demand rather than all up
@@ -371,7 +387,13 @@ class MethodBuilder : public TR::IlBuilder
    TR::IlBuilder             * _returnBuilder;
    const char                * _returnSymbolName;
 
+   int32_t                   * _invocationCounter;
+   void                      * _invocationCounterHandlerArg;
+
 private:
+   void resetForCompilation();
+   void injectInvocationCounter();
+
    static ClientAllocator      _clientAllocator;
    static ImplGetter _getImpl;
    };
@@ -0,0 +1,1024 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/HybridBitVector.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "env/Region.hpp"
+#include "env/defines.h"
+#include "infra/Bit.hpp"
+#include "infra/BitVector.hpp"
+#include "ras/Debug.hpp"
+
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#include <emmintrin.h>
+#define HYBRID_BITVECTOR_SSE2
+#endif
+
+// Array chunks are galloped through rather than merged when one is this many
+// times larger than the other
+//
+static const int32_t GallopRatio = 32;
+
+struct OrKernel
+   {
+   static uint64_t combine(uint64_t a, uint64_t b) { return a | b; }
+#if defined(HYBRID_BITVECTOR_SSE2)
+   static __m128i combine(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+   };
+
+struct AndKernel
+   {
+   static uint64_t combine(uint64_t a, uint64_t b) { return a & b; }
+#if defined(HYBRID_BITVECTOR_SSE2)
+   static __m128i combine(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+   };
+
+struct AndNotKernel
+   {
+   static uint64_t combine(uint64_t a, uint64_t b) { return a & ~b; }
+#if defined(HYBRID_BITVECTOR_SSE2)
+   static __m128i combine(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+   };
+
+// Combine the bitmap "from" into "to" and return the number of bits left set
+//
+template <class Kernel> static int32_t
+combineBitmaps(uint64_t *to, const uint64_t *from)
+   {
+   int32_t count = 0;
+#if defined(HYBRID_BITVECTOR_SSE2)
+   for (int32_t i = 0; i < TR_HybridBitVector::BitmapWords; i += 2)
+      {
+      __m128i result = Kernel::combine(_mm_loadu_si128((const __m128i *)(to + i)), _mm_loadu_si128((const __m128i *)(from + i)));
+      _mm_storeu_si128((__m128i *)(to + i), result);
+      count += populationCount((uint64_t)_mm_cvtsi128_si64(result));
+      count += populationCount((uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(result, result)));
+      }
+#else
+   for (int32_t i = 0; i < TR_HybridBitVector::BitmapWords; i++)
+      {
+      to[i] = Kernel::combine(to[i], from[i]);
+      count += populationCount(to[i]);
+      }
+#endif
+   return count;
+   }
+
+static bool
+bitmapsIntersect(const uint64_t *a, const uint64_t *b)
+   {
+#if defined(HYBRID_BITVECTOR_SSE2)
+   const __m128i zero = _mm_setzero_si128();
+   for (int32_t i = 0; i < TR_HybridBitVector::BitmapWords; i += 2)
+      {
+      __m128i both = _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, zero)) != 0xFFFF)
+         return true;
+      }
+#else
+   for (int32_t i = 0; i < TR_HybridBitVector::BitmapWords; i++)
+      {
+      if (a[i] & b[i])
+         return true;
+      }
+#endif
+   return false;
+   }
+
+static int32_t
+countBitmap(const uint64_t *bitmap)
+   {
+   int32_t count = 0;
+   for (int32_t i = 0; i < TR_HybridBitVector::BitmapWords; i++)
+      count += populationCount(bitmap[i]);
+   return count;
+   }
+
+static inline bool
+testBit(const uint64_t *bitmap, int32_t bit)
+   {
+   return (bitmap[bit >> 6] >> (bit & 63)) & 1;
+   }
+
+// Set bits low to high inclusive
+//
+static void
+setBitRange(uint64_t *bitmap, int32_t low, int32_t high)
+   {
+   int32_t firstWord = low >> 6;
+   int32_t lastWord = high >> 6;
+   uint64_t firstMask = ~(uint64_t)0 << (low & 63);
+   uint64_t lastMask = ~(uint64_t)0 >> (63 - (high & 63));
+   if (firstWord == lastWord)
+      {
+      bitmap[firstWord] |= firstMask & lastMask;
+      return;
+      }
+   bitmap[firstWord] |= firstMask;
+   for (int32_t i = firstWord + 1; i < lastWord; i++)
+      bitmap[i] = ~(uint64_t)0;
+   bitmap[lastWord] |= lastMask;
+   }
+
+// Reset bits low to high inclusive
+//
+static void
+clearBitRange(uint64_t *bitmap, int32_t low, int32_t high)
+   {
+   int32_t firstWord = low >> 6;
+   int32_t lastWord = high >> 6;
+   uint64_t firstMask = ~(uint64_t)0 << (low & 63);
+   uint64_t lastMask = ~(uint64_t)0 >> (63 - (high & 63));
+   if (firstWord == lastWord)
+      {
+      bitmap[firstWord] &= ~(firstMask & lastMask);
+      return;
+      }
+   bitmap[firstWord] &= ~firstMask;
+   for (int32_t i = firstWord + 1; i < lastWord; i++)
+      bitmap[i] = 0;
+   bitmap[lastWord] &= ~lastMask;
+   }
+
+// Return the first index at or after start whose value is not less than
+// target, or length if there is none
+//
+static int32_t
+gallop(const uint16_t *array, int32_t start, int32_t length, int32_t target)
+   {
+   if (start >= length || array[start] >= target)
+      return start;
+
+   // array[low] < target, and array[high] >= target unless high == length
+   int32_t low = start;
+   int32_t high = start + 1;
+   int32_t step = 1;
+   while (high < length && array[high] < target)
+      {
+      low = high;
+      step <<= 1;
+      high = low + step;
+      }
+   if (high > length)
+      high = length;
+
+   while (low + 1 < high)
+      {
+      int32_t middle = low + (high - low) / 2;
+      if (array[middle] < target)
+         low = middle;
+      else
+         high = middle;
+      }
+   return high;
+   }
+
+// Merge the sorted array b into the sorted array a, which must have room for
+// na + nb values, and return the size of the union
+//
+static int32_t
+unionArrays(uint16_t *a, int32_t na, const uint16_t *b, int32_t nb)
+   {
+   int32_t end = na + nb;
+   int32_t to = end;
+   int32_t i = na - 1;
+   int32_t j = nb - 1;
+   while (j >= 0)
+      {
+      if (i >= 0 && a[i] > b[j])
+         {
+         a[--to] = a[i--];
+         }
+      else
+         {
+         if (i >= 0 && a[i] == b[j])
+            i--;
+         a[--to] = b[j--];
+         }
+      }
+
+   // a[0..i] is already in place; close the gap left by duplicates
+   int32_t head = i + 1;
+   if (to > head)
+      memmove(a + head, a + to, (end - to) * sizeof(uint16_t));
+   return head + (end - to);
+   }
+
+// Write the values of a that are also in b to out, which may be a, and
+// return how many there are
+//
+static int32_t
+intersectArrays(const uint16_t *a, int32_t na, const uint16_t *b, int32_t nb, uint16_t *out)
+   {
+   int32_t count = 0;
+   if (na * GallopRatio < nb)
+      {
+      int32_t j = 0;
+      for (int32_t i = 0; i < na; i++)
+         {
+         j = gallop(b, j, nb, a[i]);
+         if (j == nb)
+            break;
+         if (b[j] == a[i])
+            out[count++] = a[i];
+         }
+      }
+   else if (nb * GallopRatio < na)
+      {
+      int32_t i = 0;
+      for (int32_t j = 0; j < nb; j++)
+         {
+         i = gallop(a, i, na, b[j]);
+         if (i == na)
+            break;
+         if (a[i] == b[j])
+            out[count++] = b[j];
+         }
+      }
+   else
+      {
+      int32_t i = 0;
+      int32_t j = 0;
+      while (i < na && j < nb)
+         {
+         if (a[i] < b[j])
+            i++;
+         else if (b[j] < a[i])
+            j++;
+         else
+            {
+            out[count++] = a[i];
+            i++;
+            j++;
+            }
+         }
+      }
+   return count;
+   }
+
+// Write the values of a that are not in b to out, which may be a, and
+// return how many there are
+//
+static int32_t
+subtractArrays(const uint16_t *a, int32_t na, const uint16_t *b, int32_t nb, uint16_t *out)
+   {
+   int32_t count = 0;
+   if (na * GallopRatio < nb)
+      {
+      int32_t j = 0;
+      for (int32_t i = 0; i < na; i++)
+         {
+         j = gallop(b, j, nb, a[i]);
+         if (j == nb || b[j] != a[i])
+            out[count++] = a[i];
+         }
+      }
+   else
+      {
+      int32_t i = 0;
+      int32_t j = 0;
+      while (i < na)
+         {
+         if (j == nb || a[i] < b[j])
+            out[count++] = a[i++];
+         else if (b[j] < a[i])
+            j++;
+         else
+            {
+            i++;
+            j++;
+            }
+         }
+      }
+   return count;
+   }
+
+static bool
+arraysIntersect(const uint16_t *a, int32_t na, const uint16_t *b, int32_t nb)
+   {
+   if (nb < na)
+      {
+      const uint16_t *t = a; a = b; b = t;
+      int32_t n = na; na = nb; nb = n;
+      }
+   if (na * GallopRatio < nb)
+      {
+      int32_t j = 0;
+      for (int32_t i = 0; i < na; i++)
+         {
+         j = gallop(b, j, nb, a[i]);
+         if (j == nb)
+            return false;
+         if (b[j] == a[i])
+            return true;
+         }
+      return false;
+      }
+
+   int32_t i = 0;
+   int32_t j = 0;
+   while (i < na && j < nb)
+      {
+      if (a[i] < b[j])
+         i++;
+      else if (b[j] < a[i])
+         j++;
+      else
+         return true;
+      }
+   return false;
+   }
+
+TR_HybridBitVector::TR_HybridBitVector(TR::Region &region)
+   : _region(&region), _chunks(NULL), _numChunks(0), _chunkCapacity(0)
+   {
+   }
+
+TR_HybridBitVector::TR_HybridBitVector(int64_t initBits, TR::Region &region)
+   : _region(&region), _chunks(NULL), _numChunks(0), _chunkCapacity(0)
+   {
+   }
+
+TR_HybridBitVector::TR_HybridBitVector(int64_t initBits, TR_Memory *m, TR_AllocationKind allocKind)
+   : _region(NULL), _chunks(NULL), _numChunks(0), _chunkCapacity(0)
+   {
+   switch (allocKind)
+      {
+      case heapAlloc:
+         _region = &(m->heapMemoryRegion());
+         break;
+      case stackAlloc:
+         _region = &(m->currentStackRegion());
+         break;
+      default:
+         TR_ASSERT_FATAL(false, "TR_HybridBitVector only allocates from regions");
+      }
+   }
+
+int32_t
+TR_HybridBitVector::findChunk(int32_t key) const
+   {
+   int32_t low = 0;
+   int32_t high = _numChunks;
+   while (low < high)
+      {
+      int32_t middle = low + (high - low) / 2;
+      if (_chunks[middle]._key < key)
+         low = middle + 1;
+      else
+         high = middle;
+      }
+   return low;
+   }
+
+void
+TR_HybridBitVector::ensureChunkCapacity(int32_t numChunks)
+   {
+   if (numChunks <= _chunkCapacity)
+      return;
+
+   int32_t capacity = 2 * _chunkCapacity;
+   if (capacity < numChunks)
+      capacity = numChunks < 4 ? 4 : numChunks;
+   Chunk *chunks = (Chunk *)_region->allocate(capacity * sizeof(Chunk));
+   if (_chunkCapacity)
+      memcpy(chunks, _chunks, _chunkCapacity * sizeof(Chunk));
+   memset(chunks + _chunkCapacity, 0, (capacity - _chunkCapacity) * sizeof(Chunk));
+   _region->deallocate(_chunks);
+   _chunks = chunks;
+   _chunkCapacity = capacity;
+   }
+
+TR_HybridBitVector::Chunk &
+TR_HybridBitVector::insertChunk(int32_t index, int32_t key)
+   {
+   ensureChunkCapacity(_numChunks + 1);
+
+   // Reuse the buffers of the first spare descriptor
+   Chunk spare = _chunks[_numChunks];
+   memmove(_chunks + index + 1, _chunks + index, (_numChunks - index) * sizeof(Chunk));
+   _numChunks++;
+
+   Chunk &chunk = _chunks[index];
+   chunk = spare;
+   chunk._key = (uint16_t)key;
+   chunk._cardinality = 0;
+   chunk._isBitmap = false;
+   return chunk;
+   }
+
+TR_HybridBitVector::Chunk &
+TR_HybridBitVector::findOrInsertChunk(int32_t key)
+   {
+   int32_t index = findChunk(key);
+   if (index < _numChunks && _chunks[index]._key == key)
+      return _chunks[index];
+   return insertChunk(index, key);
+   }
+
+void
+TR_HybridBitVector::removeChunk(int32_t index)
+   {
+   // Keep the buffers of the removed chunk as a spare
+   Chunk removed = _chunks[index];
+   memmove(_chunks + index, _chunks + index + 1, (_numChunks - index - 1) * sizeof(Chunk));
+   _numChunks--;
+   _chunks[_numChunks] = removed;
+   }
+
+// Make room for capacity members in the array, keeping the current members
+// if the chunk is an array
+//
+void
+TR_HybridBitVector::ensureArrayCapacity(Chunk &chunk, int32_t capacity)
+   {
+   if (capacity <= chunk._arrayCapacity)
+      return;
+
+   int32_t newCapacity = 2 * chunk._arrayCapacity;
+   if (newCapacity > ArrayLimit)
+      newCapacity = ArrayLimit;
+   if (newCapacity < capacity)
+      newCapacity = capacity < 4 ? 4 : capacity;
+
+   uint16_t *array = (uint16_t *)_region->allocate(newCapacity * sizeof(uint16_t));
+   if (!chunk._isBitmap && chunk._cardinality > 0)
+      memcpy(array, chunk._array, chunk._cardinality * sizeof(uint16_t));
+   _region->deallocate(chunk._array);
+   chunk._array = array;
+   chunk._arrayCapacity = newCapacity;
+   }
+
+void
+TR_HybridBitVector::ensureBitmap(Chunk &chunk)
+   {
+   if (!chunk._bitmap)
+      chunk._bitmap = (uint64_t *)_region->allocate(BitmapWords * sizeof(uint64_t));
+   }
+
+void
+TR_HybridBitVector::convertToBitmap(Chunk &chunk)
+   {
+   ensureBitmap(chunk);
+   memset(chunk._bitmap, 0, BitmapWords * sizeof(uint64_t));
+   for (int32_t i = 0; i < chunk._cardinality; i++)
+      chunk._bitmap[chunk._array[i] >> 6] |= (uint64_t)1 << (chunk._array[i] & 63);
+   chunk._isBitmap = true;
+   }
+
+void
+TR_HybridBitVector::convertToArray(Chunk &chunk)
+   {
+   ensureArrayCapacity(chunk, chunk._cardinality);
+   int32_t count = 0;
+   for (int32_t i = 0; i < BitmapWords && count < chunk._cardinality; i++)
+      {
+      for (uint64_t word = chunk._bitmap[i]; word; word &= word - 1)
+         chunk._array[count++] = (uint16_t)((i << 6) + trailingZeroes(word));
+      }
+   chunk._isBitmap = false;
+   }
+
+// Restore the array form of a bitmap that has become sparse.  Empty chunks
+// are left for the caller to remove.
+//
+void
+TR_HybridBitVector::normalize(Chunk &chunk)
+   {
+   if (chunk._isBitmap && chunk._cardinality <= ArrayLimit)
+      convertToArray(chunk);
+   }
+
+void
+TR_HybridBitVector::copyChunk(Chunk &to, const Chunk &from)
+   {
+   to._key = from._key;
+   if (from._isBitmap)
+      {
+      ensureBitmap(to);
+      memcpy(to._bitmap, from._bitmap, BitmapWords * sizeof(uint64_t));
+      to._isBitmap = true;
+      }
+   else
+      {
+      to._cardinality = 0;
+      to._isBitmap = false;
+      ensureArrayCapacity(to, from._cardinality);
+      memcpy(to._array, from._array, from._cardinality * sizeof(uint16_t));
+      }
+   to._cardinality = from._cardinality;
+   }
+
+void
+TR_HybridBitVector::orChunk(Chunk &to, const Chunk &from)
+   {
+   if (from._isBitmap)
+      {
+      if (!to._isBitmap)
+         convertToBitmap(to);
+      to._cardinality = combineBitmaps<OrKernel>(to._bitmap, from._bitmap);
+      return;
+      }
+
+   if (!to._isBitmap)
+      {
+      int32_t total = to._cardinality + from._cardinality;
+      if (total <= ArrayLimit)
+         {
+         ensureArrayCapacity(to, total);
+         to._cardinality = unionArrays(to._array, to._cardinality, from._array, from._cardinality);
+         return;
+         }
+      convertToBitmap(to);
+      }
+
+   for (int32_t i = 0; i < from._cardinality; i++)
+      {
+      uint64_t &word = to._bitmap[from._array[i] >> 6];
+      uint64_t mask = (uint64_t)1 << (from._array[i] & 63);
+      if (!(word & mask))
+         {
+         word |= mask;
+         to._cardinality++;
+         }
+      }
+   normalize(to);
+   }
+
+void
+TR_HybridBitVector::andChunk(Chunk &to, const Chunk &from)
+   {
+   if (to._isBitmap && from._isBitmap)
+      {
+      to._cardinality = combineBitmaps<AndKernel>(to._bitmap, from._bitmap);
+      normalize(to);
+      }
+   else if (to._isBitmap)
+      {
+      ensureArrayCapacity(to, from._cardinality);
+      int32_t count = 0;
+      for (int32_t i = 0; i < from._cardinality; i++)
+         {
+         if (testBit(to._bitmap, from._array[i]))
+            to._array[count++] = from._array[i];
+         }
+      to._cardinality = count;
+      to._isBitmap = false;
+      }
+   else if (from._isBitmap)
+      {
+      int32_t count = 0;
+      for (int32_t i = 0; i < to._cardinality; i++)
+         {
+         if (testBit(from._bitmap, to._array[i]))
+            to._array[count++] = to._array[i];
+         }
+      to._cardinality = count;
+      }
+   else
+      {
+      to._cardinality = intersectArrays(to._array, to._cardinality, from._array, from._cardinality, to._array);
+      }
+   }
+
+void
+TR_HybridBitVector::andNotChunk(Chunk &to, const Chunk &from)
+   {
+   if (to._isBitmap && from._isBitmap)
+      {
+      to._cardinality = combineBitmaps<AndNotKernel>(to._bitmap, from._bitmap);
+      normalize(to);
+      }
+   else if (to._isBitmap)
+      {
+      for (int32_t i = 0; i < from._cardinality; i++)
+         {
+         uint64_t &word = to._bitmap[from._array[i] >> 6];
+         uint64_t mask = (uint64_t)1 << (from._array[i] & 63);
+         if (word & mask)
+            {
+            word &= ~mask;
+            to._cardinality--;
+            }
+         }
+      normalize(to);
+      }
+   else if (from._isBitmap)
+      {
+      int32_t count = 0;
+      for (int32_t i = 0; i < to._cardinality; i++)
+         {
+         if (!testBit(from._bitmap, to._array[i]))
+            to._array[count++] = to._array[i];
+         }
+      to._cardinality = count;
+      }
+   else
+      {
+      to._cardinality = subtractArrays(to._array, to._cardinality, from._array, from._cardinality, to._array);
+      }
+   }
+
+bool
+TR_HybridBitVector::chunksIntersect(const Chunk &a, const Chunk &b)
+   {
+   if (a._isBitmap && b._isBitmap)
+      return bitmapsIntersect(a._bitmap, b._bitmap);
+
+   if (a._isBitmap || b._isBitmap)
+      {
+      const Chunk &bitmap = a._isBitmap ? a : b;
+      const Chunk &array = a._isBitmap ? b : a;
+      for (int32_t i = 0; i < array._cardinality; i++)
+         {
+         if (testBit(bitmap._bitmap, array._array[i]))
+            return true;
+         }
+      return false;
+      }
+
+   return arraysIntersect(a._array, a._cardinality, b._array, b._cardinality);
+   }
+
+int32_t
+TR_HybridBitVector::get(int32_t n) const
+   {
+   int32_t key = n >> ChunkShift;
+   int32_t index = findChunk(key);
+   if (index == _numChunks || _chunks[index]._key != key)
+      return 0;
+
+   const Chunk &chunk = _chunks[index];
+   int32_t offset = n & (ChunkBits - 1);
+   if (chunk._isBitmap)
+      return testBit(chunk._bitmap, offset);
+   int32_t position = gallop(chunk._array, 0, chunk._cardinality, offset);
+   return position < chunk._cardinality && chunk._array[position] == offset;
+   }
+
+void
+TR_HybridBitVector::set(int32_t n)
+   {
+   TR_ASSERT(n >= 0, "Negative index %d in TR_HybridBitVector\n", n);
+   Chunk &chunk = findOrInsertChunk(n >> ChunkShift);
+   int32_t offset = n & (ChunkBits - 1);
+   if (!chunk._isBitmap)
+      {
+      int32_t position = gallop(chunk._array, 0, chunk._cardinality, offset);
+      if (position < chunk._cardinality && chunk._array[position] == offset)
+         return;
+      if (chunk._cardinality < ArrayLimit)
+         {
+         ensureArrayCapacity(chunk, chunk._cardinality + 1);
+         memmove(chunk._array + position + 1, chunk._array + position, (chunk._cardinality - position) * sizeof(uint16_t));
+         chunk._array[position] = (uint16_t)offset;
+         chunk._cardinality++;
+         return;
+         }
+      convertToBitmap(chunk);
+      }
+
+   if (!testBit(chunk._bitmap, offset))
+      {
+      chunk._bitmap[offset >> 6] |= (uint64_t)1 << (offset & 63);
+      chunk._cardinality++;
+      }
+   }
+
+void
+TR_HybridBitVector::reset(int32_t n)
+   {
+   int32_t key = n >> ChunkShift;
+   int32_t index = findChunk(key);
+   if (index == _numChunks || _chunks[index]._key != key)
+      return;
+
+   Chunk &chunk = _chunks[index];
+   int32_t offset = n & (ChunkBits - 1);
+   if (chunk._isBitmap)
+      {
+      if (!testBit(chunk._bitmap, offset))
+         return;
+      chunk._bitmap[offset >> 6] &= ~((uint64_t)1 << (offset & 63));
+      chunk._cardinality--;
+      normalize(chunk);
+      }
+   else
+      {
+      int32_t position = gallop(chunk._array, 0, chunk._cardinality, offset);
+      if (position == chunk._cardinality || chunk._array[position] != offset)
+         return;
+      memmove(chunk._array + position, chunk._array + position + 1, (chunk._cardinality - position - 1) * sizeof(uint16_t));
+      chunk._cardinality--;
+      }
+
+   if (chunk._cardinality == 0)
+      removeChunk(index);
+   }
+
+void
+TR_HybridBitVector::setAll(int64_t m, int64_t n)
+   {
+   if (m < 0)
+      m = 0;
+   if (n < m)
+      return;
+
+   int32_t firstKey = (int32_t)(m >> ChunkShift);
+   int32_t lastKey = (int32_t)(n >> ChunkShift);
+   for (int32_t key = firstKey; key <= lastKey; key++)
+      {
+      int32_t low = key == firstKey ? (int32_t)(m & (ChunkBits - 1)) : 0;
+      int32_t high = key == lastKey ? (int32_t)(n & (ChunkBits - 1)) : ChunkBits - 1;
+      Chunk &chunk = findOrInsertChunk(key);
+      if (!chunk._isBitmap)
+         {
+         // Splice a short range into the array rather than go through a bitmap
+         int32_t first = gallop(chunk._array, 0, chunk._cardinality, low);
+         int32_t last = gallop(chunk._array, first, chunk._cardinality, high + 1);
+         int32_t span = high - low + 1;
+         int32_t cardinality = chunk._cardinality - (last - first) + span;
+         if (cardinality <= ArrayLimit)
+            {
+            ensureArrayCapacity(chunk, cardinality);
+            memmove(chunk._array + first + span, chunk._array + last, (chunk._cardinality - last) * sizeof(uint16_t));
+            for (int32_t i = 0; i < span; i++)
+               chunk._array[first + i] = (uint16_t)(low + i);
+            chunk._cardinality = cardinality;
+            continue;
+            }
+         convertToBitmap(chunk);
+         }
+      setBitRange(chunk._bitmap, low, high);
+      chunk._cardinality = countBitmap(chunk._bitmap);
+      normalize(chunk);
+      }
+   }
+
+void
+TR_HybridBitVector::resetAll(int64_t m, int64_t n)
+   {
+   if (m < 0)
+      m = 0;
+   if (n < m)
+      return;
+
+   int32_t firstKey = (int32_t)(m >> ChunkShift);
+   int32_t lastKey = (int32_t)(n >> ChunkShift);
+   int32_t index = findChunk(firstKey);
+   while (index < _numChunks && _chunks[index]._key <= lastKey)
+      {
+      Chunk &chunk = _chunks[index];
+      int32_t low = chunk._key == firstKey ? (int32_t)(m & (ChunkBits - 1)) : 0;
+      int32_t high = chunk._key == lastKey ? (int32_t)(n & (ChunkBits - 1)) : ChunkBits - 1;
+      if (chunk._isBitmap)
+         {
+         clearBitRange(chunk._bitmap, low, high);
+         chunk._cardinality = countBitmap(chunk._bitmap);
+         normalize(chunk);
+         }
+      else
+         {
+         int32_t first = gallop(chunk._array, 0, chunk._cardinality, low);
+         int32_t last = gallop(chunk._array, first, chunk._cardinality, high + 1);
+         memmove(chunk._array + first, chunk._array + last, (chunk._cardinality - last) * sizeof(uint16_t));
+         chunk._cardinality -= last - first;
+         }
+
+      if (chunk._cardinality == 0)
+         removeChunk(index);
+      else
+         index++;
+      }
+   }
+
+int32_t
+TR_HybridBitVector::elementCount() const
+   {
+   int32_t count = 0;
+   for (int32_t i = 0; i < _numChunks; i++)
+      count += _chunks[i]._cardinality;
+   return count;
+   }
+
+bool
+TR_HybridBitVector::intersects(const TR_HybridBitVector &other) const
+   {
+   int32_t i = 0;
+   int32_t j = 0;
+   while (i < _numChunks && j < other._numChunks)
+      {
+      if (_chunks[i]._key < other._chunks[j]._key)
+         i++;
+      else if (other._chunks[j]._key < _chunks[i]._key)
+         j++;
+      else if (chunksIntersect(_chunks[i++], other._chunks[j++]))
+         return true;
+      }
+   return false;
+   }
+
+bool
+TR_HybridBitVector::operator==(const TR_HybridBitVector &other) const
+   {
+   if (_numChunks != other._numChunks)
+      return false;
+
+   // Chunk form follows from cardinality, so equal sets are laid out the same
+   for (int32_t i = 0; i < _numChunks; i++)
+      {
+      const Chunk &a = _chunks[i];
+      const Chunk &b = other._chunks[i];
+      if (a._key != b._key || a._cardinality != b._cardinality)
+         return false;
+      if (a._isBitmap)
+         {
+         if (memcmp(a._bitmap, b._bitmap, BitmapWords * sizeof(uint64_t)))
+            return false;
+         }
+      else if (memcmp(a._array, b._array, a._cardinality * sizeof(uint16_t)))
+         {
+         return false;
+         }
+      }
+   return true;
+   }
+
+void
+TR_HybridBitVector::operator|=(const TR_HybridBitVector &other)
+   {
+   if (this == &other)
+      return;
+
+   int32_t i = 0;
+   for (int32_t j = 0; j < other._numChunks; j++, i++)
+      {
+      const Chunk &from = other._chunks[j];
+      while (i < _numChunks && _chunks[i]._key < from._key)
+         i++;
+      if (i < _numChunks && _chunks[i]._key == from._key)
+         orChunk(_chunks[i], from);
+      else
+         copyChunk(insertChunk(i, from._key), from);
+      }
+   }
+
+void
+TR_HybridBitVector::operator&=(const TR_HybridBitVector &other)
+   {
+   if (this == &other)
+      return;
+
+   int32_t i = 0;
+   int32_t j = 0;
+   while (i < _numChunks)
+      {
+      Chunk &to = _chunks[i];
+      while (j < other._numChunks && other._chunks[j]._key < to._key)
+         j++;
+      if (j < other._numChunks && other._chunks[j]._key == to._key)
+         andChunk(to, other._chunks[j]);
+      else
+         to._cardinality = 0;
+
+      if (to._cardinality == 0)
+         removeChunk(i);
+      else
+         i++;
+      }
+   }
+
+void
+TR_HybridBitVector::operator-=(const TR_HybridBitVector &other)
+   {
+   if (this == &other)
+      {
+      empty();
+      return;
+      }
+
+   int32_t i = 0;
+   int32_t j = 0;
+   while (i < _numChunks && j < other._numChunks)
+      {
+      Chunk &to = _chunks[i];
+      while (j < other._numChunks && other._chunks[j]._key < to._key)
+         j++;
+      if (j < other._numChunks && other._chunks[j]._key == to._key)
+         andNotChunk(to, other._chunks[j]);
+
+      if (to._cardinality == 0)
+         removeChunk(i);
+      else
+         i++;
+      }
+   }
+
+TR_HybridBitVector &
+TR_HybridBitVector::operator=(const TR_HybridBitVector &other)
+   {
+   if (this == &other)
+      return *this;
+
+   ensureChunkCapacity(other._numChunks);
+   for (int32_t i = 0; i < other._numChunks; i++)
+      copyChunk(_chunks[i], other._chunks[i]);
+   _numChunks = other._numChunks;
+   return *this;
+   }
+
+TR_HybridBitVector &
+TR_HybridBitVector::operator=(TR_BitVector &other)
+   {
+   empty();
+   TR_BitVectorIterator bvi(other);
+   while (bvi.hasMoreElements())
+      set(bvi.getNextElement());
+   return *this;
+   }
+
+void
+TR_HybridBitVector::print(TR::Compilation *comp, TR::FILE *file)
+   {
+   if (comp->getDebug())
+      {
+      if (file == NULL)
+         file = comp->getOutFile();
+      comp->getDebug()->print(file, this);
+      }
+   }
+
+bool
+TR_HybridBitVector::Cursor::SetToFirstOne()
+   {
+   _chunkIndex = 0;
+   _position = -1;
+   return advance();
+   }
+
+bool
+TR_HybridBitVector::Cursor::SetToNextOne()
+   {
+   if (!_valid)
+      return false;
+   return advance();
+   }
+
+bool
+TR_HybridBitVector::Cursor::advance()
+   {
+   while (_chunkIndex < _vector._numChunks)
+      {
+      const Chunk &chunk = _vector._chunks[_chunkIndex];
+      uint32_t base = (uint32_t)chunk._key << ChunkShift;
+      if (!chunk._isBitmap)
+         {
+         if (++_position < chunk._cardinality)
+            {
+            _value = base | chunk._array[_position];
+            return _valid = true;
+            }
+         }
+      else if (_position + 1 < ChunkBits)
+         {
+         int32_t start = _position + 1;
+         int32_t word = start >> 6;
+         uint64_t bits = chunk._bitmap[word] & (~(uint64_t)0 << (start & 63));
+         while (bits == 0 && ++word < BitmapWords)
+            bits = chunk._bitmap[word];
+         if (bits != 0)
+            {
+            _position = (word << 6) + trailingZeroes(bits);
+            _value = base | _position;
+            return _valid = true;
+            }
+         }
+      _chunkIndex++;
+      _position = -1;
+      }
+   return _valid = false;
+   }
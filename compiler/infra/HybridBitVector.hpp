@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef HYBRIDBITVECTOR_INCL
+#define HYBRIDBITVECTOR_INCL
+
+#include <stdint.h>
+#include "env/FilePointerDecl.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/Assert.hpp"
+
+class TR_BitVector;
+namespace TR { class Compilation; }
+
+/**
+ * A compressed bit vector for dataflow over very large universes.
+ *
+ * The universe is split into chunks of 2^16 bits and only chunks holding at
+ * least one member are materialized, sorted by their high 16 bits.  A chunk
+ * with at most ArrayLimit members keeps them as a sorted array of 16-bit
+ * offsets; a fuller chunk is a plain 2^16 bit bitmap.  The form of a chunk
+ * depends only on its member count, so equal sets have equal representations.
+ *
+ * A set holding a few percent of the universe costs two bytes per member
+ * rather than one bit per potential member, which keeps per-block dataflow
+ * sets affordable in methods with tens of thousands of symbols.  Unions,
+ * intersections and differences of two bitmap chunks use SSE2 on x86-64
+ * hosts; array chunks are merged, or galloped through when one side is much
+ * smaller than the other.
+ *
+ * Storage comes from a TR::Region, which does not reclaim single
+ * allocations, so a chunk keeps whatever buffers it has grown and reuses them
+ * when it changes form or when the vector is emptied and refilled.
+ *
+ * The class provides the container interface the dataflow engine expects
+ * (see TR_UnionHybridBitVectorAnalysis and friends) and a CS2-like Cursor, so
+ * a TR_BitVector can be assigned from it directly.
+ */
+class TR_HybridBitVector
+   {
+   public:
+   TR_ALLOC(TR_Memory::BitVector)
+   typedef int32_t containerCharacteristic; // used by data flow
+   static const containerCharacteristic nullContainerCharacteristic = -1;
+
+   static const int32_t ChunkShift = 16;
+   static const int32_t ChunkBits = 1 << ChunkShift;
+   static const int32_t BitmapWords = ChunkBits / 64;
+   // The largest number of members a chunk holds as an array
+   static const int32_t ArrayLimit = 4096;
+
+   TR_HybridBitVector(TR::Region &region);
+   TR_HybridBitVector(int64_t initBits, TR::Region &region);
+   TR_HybridBitVector(int64_t initBits, TR_Memory *m, TR_AllocationKind allocKind = heapAlloc);
+
+   int32_t get(int32_t n) const;
+   bool isSet(int32_t n) const { return get(n) != 0; }
+   void set(int32_t n);
+   void reset(int32_t n);
+
+   // Set bits 0 to n-1
+   void setAll(int64_t n) { if (n > 0) setAll(0, n - 1); }
+   // Set bits m to n inclusive
+   void setAll(int64_t m, int64_t n);
+   // Reset bits m to n inclusive
+   void resetAll(int64_t m, int64_t n);
+
+   void empty() { _numChunks = 0; }
+   bool isEmpty() const { return _numChunks == 0; }
+   bool hasMoreThanOneElement() const { return _numChunks > 1 || (_numChunks == 1 && _chunks[0]._cardinality > 1); }
+   int32_t elementCount() const;
+   bool intersects(const TR_HybridBitVector &other) const;
+
+   bool operator==(const TR_HybridBitVector &other) const;
+   bool operator!=(const TR_HybridBitVector &other) const { return !operator==(other); }
+   void operator|=(const TR_HybridBitVector &other);
+   void operator&=(const TR_HybridBitVector &other);
+   void operator-=(const TR_HybridBitVector &other);
+   TR_HybridBitVector & operator=(const TR_HybridBitVector &other);
+   TR_HybridBitVector & operator=(TR_BitVector &other);
+
+   void print(TR::Compilation *comp, TR::FILE *file = NULL);
+
+   class Cursor
+      {
+      // CS2-like iterator
+      public:
+      Cursor(const TR_HybridBitVector &vector) : _vector(vector) { SetToFirstOne(); }
+
+      bool Valid() const { return _valid; }
+      operator uint32_t() const { return _value; }
+      bool SetToFirstOne();
+      bool SetToNextOne();
+
+      private:
+      bool advance();
+
+      const TR_HybridBitVector &_vector;
+      int32_t _chunkIndex;
+      int32_t _position; // array index or bitmap offset of the current member
+      uint32_t _value;
+      bool _valid;
+      };
+
+   private:
+   struct Chunk
+      {
+      uint16_t *_array;   // sorted members while the chunk is an array
+      uint64_t *_bitmap;  // BitmapWords words while the chunk is a bitmap
+      int32_t _arrayCapacity;
+      int32_t _cardinality;
+      uint16_t _key;
+      bool _isBitmap;
+      };
+
+   TR_HybridBitVector(const TR_HybridBitVector &); // not implemented
+
+   int32_t findChunk(int32_t key) const;
+   Chunk &insertChunk(int32_t index, int32_t key);
+   Chunk &findOrInsertChunk(int32_t key);
+   void removeChunk(int32_t index);
+   void ensureChunkCapacity(int32_t numChunks);
+   void ensureArrayCapacity(Chunk &chunk, int32_t capacity);
+   void ensureBitmap(Chunk &chunk);
+   void convertToBitmap(Chunk &chunk);
+   void convertToArray(Chunk &chunk);
+   void normalize(Chunk &chunk);
+   void copyChunk(Chunk &to, const Chunk &from);
+   void orChunk(Chunk &to, const Chunk &from);
+   void andChunk(Chunk &to, const Chunk &from);
+   void andNotChunk(Chunk &to, const Chunk &from);
+   static bool chunksIntersect(const Chunk &a, const Chunk &b);
+
+   TR::Region *_region;
+   Chunk *_chunks;
+   int32_t _numChunks;
+   int32_t _chunkCapacity; // descriptors past _numChunks hold spare buffers
+   };
+
+#endif
@@ -1432,6 +1432,7 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeNode
 
 template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBlockStructure(TR_BlockStructure *blockStructure, bool checkForChange)
    {
+   this->_numBlockVisits++;
    initializeInfo(this->_regularInfo);
    initializeInfo(this->_exceptionInfo);
 
@@ -1582,6 +1583,139 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
 
 
 
+// Solve the equations block by block instead of region by region.  Blocks
+// are taken from the worklist in postorder, so that a block is normally
+// analyzed after all of its successors outside loops, and a block goes back on
+// the worklist only when the in set of one of its successors has changed.  As
+// in analyzeBlockStructure, the entry block is not analyzed.  As in the
+// forward solver, intersection analyses reach the maximal fixpoint, which can
+// be larger than the structural solution.
+//
+template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBlocksWithWorklist()
+   {
+   int32_t numberOfNodes = this->_numberOfNodes;
+   TR::Block **order = (TR::Block **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(TR::Block *));
+   int32_t *position = (int32_t *)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(int32_t));
+
+   int32_t numBlocks = this->computeReversePostOrder(order);
+   for (int32_t i = 0, j = numBlocks - 1; i < j; i++, j--)
+      {
+      TR::Block *block = order[i];
+      order[i] = order[j];
+      order[j] = block;
+      }
+
+   TR_BitVector analyzed(numberOfNodes, this->trMemory()->currentStackRegion());
+   TR_BitVector pending(numBlocks, this->trMemory()->currentStackRegion());
+   for (int32_t i = 0; i < numBlocks; i++)
+      {
+      position[order[i]->getNumber()] = i;
+      if (order[i]->getNumber() != 0)
+         pending.set(i);
+      }
+
+   // The next block to analyze is always the pending one that comes first in
+   // postorder
+   //
+   int32_t current = 0;
+   while (current < numBlocks)
+      {
+      if (!pending.isSet(current))
+         {
+         current++;
+         continue;
+         }
+      pending.reset(current);
+      this->_numBlockVisits++;
+
+      TR::Block *block = order[current];
+      TR_BlockStructure *blockStructure = block->getStructureOf();
+      int32_t blockNum = block->getNumber();
+
+      // Successors that have not been analyzed yet contribute nothing
+      //
+      initializeInfo(this->_regularInfo);
+      initializeInfo(this->_exceptionInfo);
+      if (block == this->_cfg->getEnd())
+         {
+         this->copyFromInto(_originalOutSetInfo[blockNum], this->_regularInfo);
+         this->copyFromInto(_originalOutSetInfo[blockNum], this->_exceptionInfo);
+         }
+      else
+         {
+         for (auto succ = block->getSuccessors().begin(); succ != block->getSuccessors().end(); ++succ)
+            {
+            int32_t succNum = (*succ)->getTo()->getNumber();
+            if (analyzed.isSet(succNum))
+               compose(this->_regularInfo, this->_blockAnalysisInfo[succNum]);
+            }
+         for (auto succ = block->getExceptionSuccessors().begin(); succ != block->getExceptionSuccessors().end(); ++succ)
+            {
+            int32_t succNum = (*succ)->getTo()->getNumber();
+            if (analyzed.isSet(succNum))
+               compose(this->_exceptionInfo, this->_blockAnalysisInfo[succNum]);
+            }
+         }
+
+      if (this->_regularGenSetInfo)
+         {
+         if (this->_regularKillSetInfo[blockNum])
+            *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
+         if (this->_regularGenSetInfo[blockNum])
+            *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
+         if (this->_exceptionKillSetInfo[blockNum])
+            *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
+         if (this->_exceptionGenSetInfo[blockNum])
+            *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+         compose(this->_regularInfo, this->_exceptionInfo);
+         }
+      else
+         {
+         typename TR_BasicDFSetAnalysis<Container *>::ExtraAnalysisInfo *analysisInfo = this->getAnalysisInfo(blockStructure);
+         analyzeTreeTopsInBlockStructure(blockStructure);
+         analysisInfo->_containsExceptionTreeTop = this->_containsExceptionTreeTop;
+         *analysisInfo->_inSetInfo = *this->_regularInfo;
+         blockStructure->setAnalyzedStatus(true);
+         }
+
+      if (traceBBVA())
+         {
+         traceMsg(this->comp(), "\nWorklist: In Set Info for Block numbered %d is : \n", blockNum);
+         this->_regularInfo->print(this->comp());
+         traceMsg(this->comp(), "\n");
+         }
+
+      // Put the predecessors back on the worklist if the in set has changed,
+      // or if this is the first time it has been computed
+      //
+      bool changed = !analyzed.isSet(blockNum);
+      if (!this->_blockAnalysisInfo[blockNum])
+         this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum], this->_regularInfo);
+      else if (!changed)
+         changed = !(*this->_blockAnalysisInfo[blockNum] == *this->_regularInfo);
+
+      if (changed)
+         {
+         this->copyFromInto(this->_regularInfo, this->_blockAnalysisInfo[blockNum]);
+         analyzed.set(blockNum);
+         TR_PredecessorIterator predecessors(block);
+         for (TR::CFGEdge *edge = predecessors.getFirst(); edge; edge = predecessors.getNext())
+            {
+            if (edge->getFrom()->getNumber() == 0)
+               continue;
+            int32_t predPosition = position[edge->getFrom()->getNumber()];
+            pending.set(predPosition);
+            if (predPosition < current)
+               current = predPosition;
+            }
+         }
+      }
+
+   return true;
+   }
+
+
+
 template<class Container>void TR_BackwardDFSetAnalysis<Container *>::analyzeNode(TR::Node *node, vcount_t visitCount, TR_BlockStructure *blockStructure, Container *_analysisInfo)
    {
    }
@@ -1620,3 +1754,4 @@ template<class Container>TR_DataFlowAnalysis::Kind TR_BackwardDFSetAnalysis<Cont
 
 template class TR_BackwardDFSetAnalysis<TR_BitVector *>;
 template class TR_BackwardDFSetAnalysis<TR_SingleBitContainer *>;
+template class TR_BackwardDFSetAnalysis<TR_HybridBitVector *>;
@@ -84,3 +84,4 @@ template<class Container>TR_DataFlowAnalysis::Kind TR_BackwardUnionDFSetAnalysis
 
 template class TR_BackwardUnionDFSetAnalysis<TR_BitVector *>;
 template class TR_BackwardUnionDFSetAnalysis<TR_SingleBitContainer *>;
+template class TR_BackwardUnionDFSetAnalysis<TR_HybridBitVector *>;
@@ -34,6 +34,7 @@
 #include "infra/Cfg.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
+#include "infra/Stack.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
 #include "optimizer/Structure.hpp"
@@ -87,6 +88,8 @@ performAnalysis(TR_Structure *rootStructure,
    if (!postInitializationProcessing())
       return false;
    doAnalysis(rootStructure, checkForChanges);
+   if (traceBVA())
+      traceMsg(comp(), "\n%s analysis visited %d blocks of %d\n", _useWorklistSolver ? "Worklist" : "Structural", _numBlockVisits, _cfg->getNumberOfNodes());
    //rootStructure->resetAnalysisInfo();
    //rootStructure->resetAnalyzedStatus();
    return true;
@@ -176,6 +179,9 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
    this->allocateContainer(&_temp2);
    _nodesInCycle = new (trMemory()->currentStackRegion()) TR_BitVector(trMemory()->currentStackRegion());
 
+   _useWorklistSolver = comp()->getOption(TR_EnableWorklistDataFlow) && supportsWorklistSolver();
+   _numBlockVisits = 0;
+
    if (supportsGenAndKillSets())
       {
       int32_t arraySize = _numberOfNodes*sizeof(Container*);
@@ -190,7 +196,9 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
 
       initializeGenAndKillSetInfo();
 
-      if (!_hasImproperRegion)
+      // The worklist solver only needs the gen and kill sets of the blocks
+      //
+      if (!_hasImproperRegion && !_useWorklistSolver)
          {
          initializeGenAndKillSetInfoForStructures();
          if (traceBVA())
@@ -216,6 +224,63 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
 
 
 
+// Fill in the blocks of the CFG in reverse postorder of a depth first walk
+// from the entry that follows both normal and exception edges.  Blocks that
+// cannot be reached from the entry are placed after all the others.  Returns
+// the number of blocks placed.
+//
+template<class Container>int32_t TR_BasicDFSetAnalysis<Container *>::computeReversePostOrder(TR::Block **order)
+   {
+   TR_BitVector visited(_numberOfNodes, trMemory()->currentStackRegion());
+   TR_BitVector finished(_numberOfNodes, trMemory()->currentStackRegion());
+   TR_Stack<TR::CFGNode *> stack(trMemory(), 64, false, stackAlloc);
+   int32_t numBlocks = _cfg->getNumberOfNodes();
+   int32_t next = numBlocks;
+
+   // A node stays on the stack while its successors are walked and is
+   // finished, i.e. placed, when it comes back to the top
+   //
+   stack.push(_cfg->getStart());
+   while (!stack.isEmpty())
+      {
+      TR::CFGNode *node = stack.top();
+      if (!visited.isSet(node->getNumber()))
+         {
+         visited.set(node->getNumber());
+         TR_SuccessorIterator successors(node);
+         for (TR::CFGEdge *edge = successors.getFirst(); edge; edge = successors.getNext())
+            {
+            if (!visited.isSet(edge->getTo()->getNumber()))
+               stack.push(edge->getTo());
+            }
+         }
+      else
+         {
+         stack.pop();
+         if (!finished.isSet(node->getNumber()))
+            {
+            finished.set(node->getNumber());
+            order[--next] = toBlock(node);
+            }
+         }
+      }
+
+   // Reachable blocks now occupy the end of the array; move them down and
+   // add the rest
+   //
+   int32_t numReachable = numBlocks - next;
+   memmove(order, order + next, numReachable*sizeof(TR::Block *));
+   int32_t count = numReachable;
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      if (!visited.isSet(node->getNumber()))
+         order[count++] = toBlock(node);
+      }
+
+   TR_ASSERT(count == numBlocks, "BVA, reverse postorder covers %d of %d blocks", count, numBlocks);
+   return count;
+   }
+
 template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeGenAndKillSetInfoForStructures()
    {
    initializeGenAndKillSetInfoPropertyForStructure(_cfg->getStructure(), false);
@@ -1388,6 +1453,7 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeNodeI
 
 template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlockStructure(TR_BlockStructure *blockStructure, bool checkForChange)
    {
+   this->_numBlockVisits++;
    if (this->supportsGenAndKillSets() &&
        canGenAndKillForStructure(blockStructure))
       {
@@ -1525,6 +1591,153 @@ template<class Container>void TR_ForwardDFSetAnalysis<Container *>::analyzeBlock
    }
 
 
+
+// Solve the equations block by block instead of region by region.  Blocks
+// are taken from the worklist in reverse postorder, so that a block is
+// normally analyzed after all of its predecessors outside loops, and a block
+// goes back on the worklist only when an out set of one of its predecessors
+// has changed.  The in set of each block is left in _blockAnalysisInfo.
+//
+// Union analyses reach the same least fixpoint as the structural solution.
+// Intersection analyses do not: a predecessor that has not been analyzed yet
+// counts as the full set, so they reach the maximal fixpoint, which in nested
+// loops can be larger than the structural solution.  Callers must accept
+// either.
+//
+template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlocksWithWorklist()
+   {
+   int32_t numberOfNodes = this->_numberOfNodes;
+   TR::Block **order = (TR::Block **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(TR::Block *));
+   int32_t *position = (int32_t *)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(int32_t));
+   Container **regularOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(Container *));
+   Container **exceptionOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(Container *));
+   memset(regularOutSetInfo, 0, numberOfNodes*sizeof(Container *));
+   memset(exceptionOutSetInfo, 0, numberOfNodes*sizeof(Container *));
+
+   int32_t numBlocks = this->computeReversePostOrder(order);
+   TR_BitVector pending(numBlocks, this->trMemory()->currentStackRegion());
+   for (int32_t i = 0; i < numBlocks; i++)
+      {
+      position[order[i]->getNumber()] = i;
+      pending.set(i);
+      }
+
+   // The next block to analyze is always the pending one that comes first in
+   // reverse postorder
+   //
+   int32_t current = 0;
+   while (current < numBlocks)
+      {
+      if (!pending.isSet(current))
+         {
+         current++;
+         continue;
+         }
+      pending.reset(current);
+      this->_numBlockVisits++;
+
+      TR::Block *block = order[current];
+      TR_BlockStructure *blockStructure = block->getStructureOf();
+      int32_t blockNum = block->getNumber();
+
+      // Predecessors that have not been analyzed yet contribute nothing
+      //
+      initializeInSetInfo();
+      for (auto pred = block->getPredecessors().begin(); pred != block->getPredecessors().end(); ++pred)
+         {
+         Container *predOutSetInfo = regularOutSetInfo[(*pred)->getFrom()->getNumber()];
+         if (predOutSetInfo)
+            compose(_currentInSetInfo, predOutSetInfo);
+         }
+      for (auto pred = block->getExceptionPredecessors().begin(); pred != block->getExceptionPredecessors().end(); ++pred)
+         {
+         Container *predOutSetInfo = exceptionOutSetInfo[(*pred)->getFrom()->getNumber()];
+         if (predOutSetInfo)
+            compose(_currentInSetInfo, predOutSetInfo);
+         }
+      if (block == this->_cfg->getStart())
+         compose(_currentInSetInfo, _originalInSetInfo);
+
+      initializeInfo(this->_regularInfo);
+      initializeInfo(this->_exceptionInfo);
+      if (blockNum == 0)
+         {
+         if (!this->_blockAnalysisInfo[blockNum])
+            this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum], _currentInSetInfo);
+         this->copyFromInto(_currentInSetInfo, this->_blockAnalysisInfo[blockNum]);
+         analyzeBlockZeroStructure(blockStructure);
+         }
+      else if (this->_regularGenSetInfo)
+         {
+         this->copyFromInto(_currentInSetInfo, this->_regularInfo);
+         this->copyFromInto(_currentInSetInfo, this->_exceptionInfo);
+         if (this->_regularKillSetInfo[blockNum])
+            *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
+         if (this->_regularGenSetInfo[blockNum])
+            *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
+         if (this->_exceptionKillSetInfo[blockNum])
+            *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
+         if (this->_exceptionGenSetInfo[blockNum])
+            *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+         if (!this->_blockAnalysisInfo[blockNum])
+            this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum], _currentInSetInfo);
+         this->copyFromInto(_currentInSetInfo, this->_blockAnalysisInfo[blockNum]);
+         }
+      else
+         {
+         typename TR_BasicDFSetAnalysis<Container *>::ExtraAnalysisInfo *analysisInfo = this->getAnalysisInfo(blockStructure);
+         this->copyFromInto(_currentInSetInfo, analysisInfo->_inSetInfo);
+         analyzeTreeTopsInBlockStructure(blockStructure);
+         blockStructure->setAnalyzedStatus(true);
+         }
+
+      if (this->traceBVA())
+         {
+         traceMsg(this->comp(), "\nWorklist: In Set Info for Block numbered %d is : \n", blockNum);
+         _currentInSetInfo->print(this->comp());
+         traceMsg(this->comp(), "\n");
+         }
+
+      // Put the successors back on the worklist if an out set has changed,
+      // or if this is the first time the out set has been computed
+      //
+      Container **outSetInfo = &regularOutSetInfo[blockNum];
+      if (!block->getSuccessors().empty() &&
+          (!*outSetInfo || !(**outSetInfo == *this->_regularInfo)))
+         {
+         if (!*outSetInfo)
+            this->allocateContainer(outSetInfo);
+         **outSetInfo = *this->_regularInfo;
+         for (auto succ = block->getSuccessors().begin(); succ != block->getSuccessors().end(); ++succ)
+            {
+            int32_t succPosition = position[(*succ)->getTo()->getNumber()];
+            pending.set(succPosition);
+            if (succPosition < current)
+               current = succPosition;
+            }
+         }
+
+      outSetInfo = &exceptionOutSetInfo[blockNum];
+      if (!block->getExceptionSuccessors().empty() &&
+          (!*outSetInfo || !(**outSetInfo == *this->_exceptionInfo)))
+         {
+         if (!*outSetInfo)
+            this->allocateContainer(outSetInfo);
+         **outSetInfo = *this->_exceptionInfo;
+         for (auto succ = block->getExceptionSuccessors().begin(); succ != block->getExceptionSuccessors().end(); ++succ)
+            {
+            int32_t succPosition = position[(*succ)->getTo()->getNumber()];
+            pending.set(succPosition);
+            if (succPosition < current)
+               current = succPosition;
+            }
+         }
+      }
+
+   return true;
+   }
+
+
 template<class Container>void TR_ForwardDFSetAnalysis<Container *>::analyzeNode(TR::Node *node, vcount_t visitCount, TR_BlockStructure *blockStructure, Container *analysisInfo)
    {
    }
@@ -1597,3 +1810,5 @@ template class TR_BasicDFSetAnalysis<TR_BitVector *>;
 template class TR_ForwardDFSetAnalysis<TR_BitVector *>;
 template class TR_BasicDFSetAnalysis<TR_SingleBitContainer *>;
 template class TR_ForwardDFSetAnalysis<TR_SingleBitContainer *>;
+template class TR_BasicDFSetAnalysis<TR_HybridBitVector *>;
+template class TR_ForwardDFSetAnalysis<TR_HybridBitVector *>;
@@ -34,6 +34,7 @@
 #include "infra/BitVector.hpp"
 #include "infra/Flags.hpp"
 #include "infra/HashTab.hpp"
+#include "infra/HybridBitVector.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
 #include "optimizer/Structure.hpp"
@@ -249,6 +250,8 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
       _blockAnalysisInfo    = 0;
       _hasImproperRegion    = false;
       _nodesInCycle         = NULL;
+      _useWorklistSolver    = false;
+      _numBlockVisits       = 0;
       }
 
    bool traceBVA() { return _traceBVA;}
@@ -278,9 +281,19 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
 
    bool doAnalysis(TR_Structure *rootStructure, bool checkForChanges)
       {
+      if (_useWorklistSolver)
+         return analyzeBlocksWithWorklist();
       return rootStructure->doDataFlowAnalysis(this, checkForChanges);
       }
 
+   // Analyses whose block transfer function depends only on the sets of the
+   // neighbouring blocks can be solved one block at a time from a worklist
+   // instead of region by region; see enableWorklistDataFlow
+   //
+   virtual bool supportsWorklistSolver() { return supportsGenAndKillSets(); }
+   virtual bool analyzeBlocksWithWorklist() = 0;
+   int32_t computeReversePostOrder(TR::Block **order);
+
    virtual void initializeDFSetAnalysis() = 0;
 
    class TR_ContainerNodeNumberPair : public TR_Link<TR_ContainerNodeNumberPair>
@@ -356,6 +369,8 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    int32_t _maxReferenceNumber;
    TR::Node **_supportedNodesAsArray;
    bool _hasImproperRegion;
+   bool _useWorklistSolver;
+   int32_t _numBlockVisits;
    };
 
 
@@ -385,6 +400,7 @@ template<class Container>class TR_ForwardDFSetAnalysis<Container *> :
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual void analyzeBlockZeroStructure(TR_BlockStructure *);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool analyzeBlocksWithWorklist();
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
@@ -442,6 +458,17 @@ class TR_IntersectionBitVectorAnalysis : public TR_IntersectionDFSetAnalysis<TR_
       }
    };
 
+// Forward intersection analysis over compressed sets, for analyses whose sets
+// are sparse in a very large universe
+//
+class TR_IntersectionHybridBitVectorAnalysis : public TR_IntersectionDFSetAnalysis<TR_HybridBitVector *>
+   {
+   public:
+   typedef TR_HybridBitVector ContainerType;
+   TR_IntersectionHybridBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_IntersectionDFSetAnalysis<TR_HybridBitVector *>(comp, cfg, optimizer, trace) {}
+   };
+
 // Forward union bit vector analysis
 //
 template<class Container>class TR_UnionDFSetAnalysis<Container *> : public TR_ForwardDFSetAnalysis<Container *>
@@ -477,6 +504,17 @@ class TR_UnionSingleBitContainerAnalysis : public TR_UnionDFSetAnalysis<TR_Singl
       TR_UnionDFSetAnalysis<TR_SingleBitContainer *>(comp, cfg, optimizer, trace) {}
   };
 
+// Forward union analysis over compressed sets, for analyses whose sets are
+// sparse in a very large universe
+//
+class TR_UnionHybridBitVectorAnalysis : public TR_UnionDFSetAnalysis<TR_HybridBitVector *>
+   {
+   public:
+   typedef TR_HybridBitVector ContainerType;
+   TR_UnionHybridBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace) :
+      TR_UnionDFSetAnalysis<TR_HybridBitVector *>(comp, cfg, optimizer, trace) {}
+   };
+
 class TR_ReachingDefinitions : public TR_UnionBitVectorAnalysis
    {
    public:
@@ -527,6 +565,7 @@ template<class Container>class TR_BackwardDFSetAnalysis<Container *> :
 
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool analyzeBlocksWithWorklist();
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *) {}
@@ -582,6 +621,15 @@ class TR_BackwardIntersectionBitVectorAnalysis :
       : TR_BackwardIntersectionDFSetAnalysis<TR_BitVector *>(comp, cfg, optimizer, trace) { }
    };
 
+class TR_BackwardIntersectionHybridBitVectorAnalysis :
+   public TR_BackwardIntersectionDFSetAnalysis<TR_HybridBitVector *>
+   {
+   public:
+   typedef TR_HybridBitVector ContainerType;
+   TR_BackwardIntersectionHybridBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_BackwardIntersectionDFSetAnalysis<TR_HybridBitVector *>(comp, cfg, optimizer, trace) { }
+   };
+
 // Backward union bit vector analysis
 //
 template<class Container>class TR_BackwardUnionDFSetAnalysis<Container *> :
@@ -618,6 +666,15 @@ class TR_BackwardUnionSingleBitContainerAnalysis :
       : TR_BackwardUnionDFSetAnalysis<TR_SingleBitContainer *>(comp, cfg, optimizer, trace) { }
    };
 
+class TR_BackwardUnionHybridBitVectorAnalysis :
+   public TR_BackwardUnionDFSetAnalysis<TR_HybridBitVector *>
+   {
+   public:
+   typedef TR_HybridBitVector ContainerType;
+   TR_BackwardUnionHybridBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace)
+      : TR_BackwardUnionDFSetAnalysis<TR_HybridBitVector *>(comp, cfg, optimizer, trace) { }
+   };
+
 // First dataflow analysis in Partial Redundancy Elimination
 //
 class TR_GlobalAnticipatability
@@ -636,6 +693,7 @@ class TR_GlobalAnticipatability
    bool isExceptionalInBlock(TR::Node *, int32_t, ContainerType *, vcount_t);
    void killBasedOnSuccTransparency(TR::Block *);
    virtual bool postInitializationProcessing();
+   virtual bool supportsWorklistSolver();
 
    TR_LocalAnalysisInfo _localAnalysisInfo;
    TR_LocalTransparency _localTransparency; // _localTransparency should be before _localAnticipatability
@@ -874,6 +932,30 @@ class TR_Liveness : public TR_BackwardUnionBitVectorAnalysis
    bool    _traceLiveness;
    };
 
+// Liveness solved over compressed sets, for methods with very many locals.
+// TR_Liveness uses it under enableHybridBitVectorLiveness and copies the
+// result back into its own bit vectors, so its consumers are unchanged.
+//
+class TR_HybridLiveness : public TR_BackwardUnionHybridBitVectorAnalysis
+   {
+   public:
+
+   TR_HybridLiveness(TR::Compilation *comp, TR::Optimizer *optimizer, TR_Structure *,
+                     TR_LiveVariableInformation *liveVariableInfo);
+
+   virtual int32_t getNumberOfBits();
+   virtual bool supportsGenAndKillSets();
+   virtual void initializeGenAndKillSetInfo();
+   virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_HybridBitVector *);
+   virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
+
+   private:
+
+   void compress(TR_BitVector *from, TR_HybridBitVector **to);
+
+   TR_LiveVariableInformation *_liveVariableInfo;
+   };
+
 // Live on all paths (LOAP) - analysis that identifies when a variable definition is
 // live on all subsequent paths.
 // Backward Intersection BitVector analysis.
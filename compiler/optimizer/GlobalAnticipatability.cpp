@@ -81,6 +81,17 @@ void TR_GlobalAnticipatability::analyzeNode(TR::Node *, vcount_t, TR_BlockStruct
 
 
 
+// The in set of a block is computed from the in sets of its successors and
+// whether they have been analyzed yet.  PRE's correctness depends on these
+// sets, and the worklist solver reaches a larger fixpoint for intersection
+// problems in nested loops, so anticipatability stays on the structural solver
+//
+bool TR_GlobalAnticipatability::supportsWorklistSolver()
+   {
+   return false;
+   }
+
+
 TR_GlobalAnticipatability::TR_GlobalAnticipatability(TR::Compilation *comp, TR::Optimizer *optimizer, TR_Structure *rootStructure, bool trace)
    : TR_BackwardIntersectionBitVectorAnalysis(comp, comp->getFlowGraph(), optimizer, trace),
      _localAnalysisInfo(comp, trace),
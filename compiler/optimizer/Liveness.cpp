@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "env/StackMemoryRegion.hpp"
 #include "compile/Compilation.hpp"
 #include "control/Options.hpp"
@@ -29,6 +30,7 @@
 #include "il/Node.hpp"
 #include "infra/Assert.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/HybridBitVector.hpp"
 #include "optimizer/DataFlowAnalysis.hpp"
 
 class TR_BlockStructure;
@@ -95,7 +97,19 @@ TR_Liveness::TR_Liveness(TR::Compilation           *comp,
    {
    TR::StackMemoryRegion stackMemoryRegion(*trMemory());
 
-   performAnalysis(rootStructure, false);
+   if (comp->getOption(TR_EnableHybridBitVectorLiveness))
+      {
+      TR_HybridLiveness hybridLiveness(comp, optimizer, rootStructure, _liveVariableInfo);
+      for (int32_t i = 0; i < _numberOfNodes; ++i)
+         {
+         if (hybridLiveness._blockAnalysisInfo[i])
+            *_blockAnalysisInfo[i] = *hybridLiveness._blockAnalysisInfo[i];
+         else
+            _blockAnalysisInfo[i]->empty();
+         }
+      }
+   else
+      performAnalysis(rootStructure, false);
 
    if (traceLiveness())
       {
@@ -155,3 +169,66 @@ void TR_Liveness::analyzeTreeTopsInBlockStructure(TR_BlockStructure *blockStruct
    {
    TR_ASSERT(false, "Liveness should use gen and kill sets");
    }
+
+
+TR_HybridLiveness::TR_HybridLiveness(TR::Compilation           *comp,
+                                     TR::Optimizer             *optimizer,
+                                     TR_Structure               *rootStructure,
+                                     TR_LiveVariableInformation *liveVariableInfo)
+   : TR_BackwardUnionHybridBitVectorAnalysis(comp, comp->getFlowGraph(), optimizer, comp->getOption(TR_TraceLiveness)),
+     _liveVariableInfo(liveVariableInfo)
+   {
+   initializeBlockInfo();
+   performAnalysis(rootStructure, false);
+   }
+
+int32_t TR_HybridLiveness::getNumberOfBits()
+   {
+   return _liveVariableInfo->numLocals();
+   }
+
+bool TR_HybridLiveness::supportsGenAndKillSets()
+   {
+   return true;
+   }
+
+void TR_HybridLiveness::analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_HybridBitVector *)
+   {
+   }
+
+void TR_HybridLiveness::initializeGenAndKillSetInfo()
+   {
+   // The local variable information only builds bit vectors; compress them
+   int32_t arraySize = _numberOfNodes * sizeof(TR_BitVector *);
+   TR_BitVector **regularGenSetInfo = (TR_BitVector **)trMemory()->allocateStackMemory(arraySize);
+   memset(regularGenSetInfo, 0, arraySize);
+   TR_BitVector **regularKillSetInfo = (TR_BitVector **)trMemory()->allocateStackMemory(arraySize);
+   memset(regularKillSetInfo, 0, arraySize);
+   TR_BitVector **exceptionGenSetInfo = (TR_BitVector **)trMemory()->allocateStackMemory(arraySize);
+   memset(exceptionGenSetInfo, 0, arraySize);
+   TR_BitVector **exceptionKillSetInfo = (TR_BitVector **)trMemory()->allocateStackMemory(arraySize);
+   memset(exceptionKillSetInfo, 0, arraySize);
+
+   _liveVariableInfo->initializeGenAndKillSetInfo(regularGenSetInfo, regularKillSetInfo, exceptionGenSetInfo, exceptionKillSetInfo);
+
+   for (int32_t i = 0; i < _numberOfNodes; ++i)
+      {
+      compress(regularGenSetInfo[i], &_regularGenSetInfo[i]);
+      compress(regularKillSetInfo[i], &_regularKillSetInfo[i]);
+      compress(exceptionGenSetInfo[i], &_exceptionGenSetInfo[i]);
+      compress(exceptionKillSetInfo[i], &_exceptionKillSetInfo[i]);
+      }
+   }
+
+void TR_HybridLiveness::compress(TR_BitVector *from, TR_HybridBitVector **to)
+   {
+   if (from == NULL)
+      return;
+   allocateContainer(to);
+   **to = *from;
+   }
+
+void TR_HybridLiveness::analyzeTreeTopsInBlockStructure(TR_BlockStructure *blockStructure)
+   {
+   TR_ASSERT(false, "Liveness should use gen and kill sets");
+   }
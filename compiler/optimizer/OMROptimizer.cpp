@@ -29,6 +29,7 @@
 #include "codegen/CodeGenerator.hpp"
 #include "codegen/FrontEnd.hpp"
 #include "compile/Compilation.hpp"
+#include "compile/CompilationBudget.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/Method.hpp"
 #include "compile/SymbolReferenceTable.hpp"
@@ -1233,6 +1234,22 @@ static bool hasMoreThanOneBlock( TR::Compilation *comp)
    return (comp->getStartBlock() && comp->getStartBlock()->getNextBlock());
    }
 
+// Optimizations whose cost grows fastest with the size of the method; these
+// give way first when a compilation runs short of time or scratch memory.
+//
+static bool isExpensiveOptimization(OMR::Optimizations optNum)
+   {
+   switch (optNum)
+      {
+      case OMR::globalValuePropagation:
+      case OMR::partialRedundancyElimination:
+      case OMR::loopVersioner:
+         return true;
+      default:
+         return false;
+      }
+   }
+
 static void breakForTesting(int index)
    {
    static char *optimizerBreakLocationStr = feGetEnv("TR_optimizerBreakLocation");
@@ -1641,9 +1658,6 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
    //
    // This is a real optimization.
    //
-   TR::RegionProfiler rp(comp()->trMemory()->heapMemoryRegion(), *comp(), "opt/%s/%s", comp()->getHotnessName(comp()->getMethodHotness()),
-      getOptimizationName(optNum));
-
    if (comp()->isOutermostMethod())
       comp()->incOptIndex(); // Note that we count the opt even if we're not doing it, to keep the opt indexes more stable
 
@@ -1673,6 +1687,36 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       if (regex && TR::SimpleRegex::match(regex, manager->name()))
          return 0;
 
+      // Once the compilation's budget runs low, expensive optimizations are
+      // skipped (global value propagation is done locally instead), and once
+      // it is exhausted only the optimizations that must be done are run.
+      //
+      TR::CompilationBudget *budget = comp()->getBudget();
+      if (budget && !mustBeDone)
+         {
+         TR::CompilationBudget::State state = budget->update();
+         if (state == TR::CompilationBudget::Exhausted ||
+             (state == TR::CompilationBudget::Low && isExpensiveOptimization(optNum)))
+            {
+            if (comp()->getOption(TR_TraceOpts) && comp()->isOutermostMethod())
+               traceMsg(comp(), "%*s%s skipped: compilation budget %s\n", optDepth*3, " ", manager->name(),
+                  TR::CompilationBudget::getStateName(state));
+
+            // Local value propagation takes over the index of global value
+            // propagation rather than counting as another optimization, so that
+            // later opt indexes are unchanged for lastOptIndex= bisection.
+            //
+            if (state == TR::CompilationBudget::Low && optNum == OMR::globalValuePropagation &&
+                isEnabled(OMR::localValuePropagation))
+               {
+               optNum = OMR::localValuePropagation;
+               manager = getOptimization(optNum);
+               }
+            else
+               return 0;
+            }
+         }
+
       // actually doing optimization
       regex = comp()->getOptions()->getBreakOnOpts();
       if (regex && TR::SimpleRegex::match(regex, optIndex))
@@ -1687,6 +1731,9 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
          return 0;
          }
 
+      TR::RegionProfiler rp(comp()->trMemory()->heapMemoryRegion(), *comp(), getMethodSymbol(), "opt/%s/%s",
+         comp()->getHotnessName(comp()->getMethodHotness()), getOptimizationName(optNum));
+
       if (comp()->getOption(TR_TraceOptDetails) || comp()->getOption(TR_TraceOptTrees))
          {
          if (comp()->isOutermostMethod())
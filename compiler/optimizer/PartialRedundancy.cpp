@@ -6042,6 +6042,14 @@ bool TR_RedundantExpressionAdjustment::supportsGenAndKillSetsForStructures()
    return false;
    }
 
+// analyzeBlockStructure is overridden, so blocks cannot be analyzed on their
+// own from a worklist
+//
+bool TR_RedundantExpressionAdjustment::supportsWorklistSolver()
+   {
+   return false;
+   }
+
 int32_t TR_RedundantExpressionAdjustment::getNumberOfBits()
    {
    return _partialRedundancy->getNumberOfBits();
@@ -288,6 +288,7 @@ class TR_RedundantExpressionAdjustment
    virtual int32_t getNumberOfBits();
    virtual bool supportsGenAndKillSets();
    virtual bool supportsGenAndKillSetsForStructures();
+   virtual bool supportsWorklistSolver();
    virtual void initializeGenAndKillSetInfo();
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, ContainerType *);
    ////virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
@@ -85,6 +85,7 @@
 #include "infra/Array.hpp"
 #include "infra/Assert.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/HybridBitVector.hpp"
 #include "infra/List.hpp"
 #include "infra/SimpleRegex.hpp"
 #include "infra/CfgNode.hpp"
@@ -880,6 +881,33 @@ TR_Debug::print(TR::FILE *pOutFile, TR_SingleBitContainer *sbc)
       trfprintf(pOutFile,"{0}");
    }
 
+void
+TR_Debug::print(TR::FILE *pOutFile, TR_HybridBitVector *hbv)
+   {
+   if (pOutFile == NULL) return;
+
+   trfprintf(pOutFile,"{");
+   bool firstOne = true;
+   int32_t num = 0;
+   TR_HybridBitVector::Cursor bi(*hbv);
+   for (bi.SetToFirstOne(); bi.Valid(); bi.SetToNextOne())
+      {
+      if (!firstOne)
+         trfprintf(pOutFile,", ");
+      else
+         firstOne = false;
+      trfprintf(pOutFile,"%d",(uint32_t)bi);
+
+      if (num > 30)
+         {
+         trfprintf(pOutFile,"\n");
+         num = 0;
+         }
+      num++;
+      }
+   trfprintf(pOutFile,"}");
+   }
+
 void
 TR_Debug::print(TR::FILE *pOutFile, TR::BitVector * bv)
    {
@@ -63,6 +63,7 @@ namespace TR { class CompilationFilters; }
 class TR_FilterBST;
 class TR_FrontEnd;
 class TR_GCStackMap;
+class TR_HybridBitVector;
 class TR_InductionVariable;
 class TR_PrettyPrinterString;
 class TR_PseudoRandomNumbersListElement;
@@ -488,6 +489,7 @@ public:
    virtual void         print(TR::LabelSymbol *, TR_PrettyPrinterString&);
    virtual void         print(TR::FILE *, TR_BitVector *);
    virtual void         print(TR::FILE *, TR_SingleBitContainer *);
+   virtual void         print(TR::FILE *, TR_HybridBitVector *);
    virtual void         print(TR::FILE *pOutFile, TR::BitVector * bv);
    virtual void         print(TR::FILE *pOutFile, TR::SparseBitVector * sparse);
    virtual void         print(TR::FILE *, TR::SymbolReferenceTable *);
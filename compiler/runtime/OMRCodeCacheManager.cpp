@@ -42,6 +42,7 @@
 #include "runtime/CodeCacheManager.hpp"
 #include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/CodeCacheConfig.hpp"
+#include "runtime/PerfToolWriter.hpp"
 #include "runtime/Runtime.hpp"
 
 #if (HOST_OS == OMR_LINUX)
@@ -79,6 +80,12 @@ OMR::CodeCacheManager::RepositoryMonitorCriticalSection::RepositoryMonitorCritic
    }
 
 
+OMR::CodeCacheManager::CacheCreationCriticalSection::CacheCreationCriticalSection(TR::CodeCacheManager *mgr)
+   : CriticalSection(mgr->_codeCacheCreationMonitor)
+   {
+   }
+
+
 TR::CodeCache *
 OMR::CodeCacheManager::initialize(
       bool allocateMonolithicCodeCache,
@@ -140,6 +147,9 @@ OMR::CodeCacheManager::initialize(
    _codeCacheList._mutex = TR::Monitor::create("JIT-CodeCacheListMutex");
    if (_codeCacheList._mutex == NULL)
       return NULL;
+   _codeCacheCreationMonitor = TR::Monitor::create("JIT-CodeCacheCreationMutex");
+   if (_codeCacheCreationMonitor == NULL)
+      return NULL;
 
 #if defined(TR_HOST_POWER)
    #define REACHEABLE_RANGE_KB (32*1024)
@@ -338,16 +348,10 @@ OMR::CodeCacheManager::reserveCodeCache(bool compilationCodeAllocationsMustBeCon
       }
 
    // No existing code cache is available; try to allocate a new one
-   if (self()->canAddNewCodeCache())
-      {
-      TR::CodeCacheConfig &config = self()->codeCacheConfig();
-      codeCache = self()->allocateCodeCacheFromNewSegment(config.codeCacheKB() << 10, compThreadID);
-      }
-   else
-      {
-      if (numCachesAlreadyReserved > 0)
-         self()->setHasFailedCodeCacheAllocation();
-      }
+   TR::CodeCacheConfig &config = self()->codeCacheConfig();
+   codeCache = self()->growCodeCache(config.codeCacheKB() << 10, compThreadID);
+   if (!codeCache && numCachesAlreadyReserved > 0)
+      self()->setHasFailedCodeCacheAllocation();
 
    if (codeCache)
       {
@@ -375,14 +379,8 @@ OMR::CodeCacheManager::reserveCodeCache(bool compilationCodeAllocationsMustBeCon
 TR::CodeCache *
 OMR::CodeCacheManager::getNewCodeCache(int32_t reservingCompThreadID)
    {
-   TR::CodeCache *codeCache = NULL;
-   if (self()->canAddNewCodeCache())
-      {
-      TR::CodeCacheConfig &config = self()->codeCacheConfig();
-      codeCache = self()->allocateCodeCacheFromNewSegment(config.codeCacheKB() << 10, reservingCompThreadID);
-      }
-
-   return codeCache;
+   TR::CodeCacheConfig &config = self()->codeCacheConfig();
+   return self()->growCodeCache(config.codeCacheKB() << 10, reservingCompThreadID);
    }
 
 
@@ -723,7 +721,7 @@ OMR::CodeCacheManager::allocateCodeMemoryWithRetries(size_t warmCodeSize,
       }
 
    /* Create a new code cache structure and initialize it */
-   codeCache = self()->allocateCodeCacheFromNewSegment(segmentSize, compThreadID);
+   codeCache = self()->growCodeCache(segmentSize, compThreadID);
    if (!codeCache)
       {
       self()->setCodeCacheFull();
@@ -866,9 +864,11 @@ OMR::CodeCacheManager::repositoryCodeCacheCreated()
    }
 
 void
-OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize)
+OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp)
    {
 #if (HOST_OS == OMR_LINUX)
+   // The symbol lists are shared by all compilation threads
+   CacheListCriticalSection updateSymbols(self());
 
    TR::CodeCacheSymbol *newSymbol = static_cast<TR::CodeCacheSymbol *> (self()->getMemory(sizeof(TR::CodeCacheSymbol)));
    uint32_t nameLength = strlen(sig) + 1;
@@ -903,6 +903,36 @@ OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC,
       _relocatableSymbolContainer->_numSymbols++;
       _relocatableSymbolContainer->_totalSymbolNameLength += nameLength;
    }
+
+   TR::PerfToolWriter *perfToolWriter = TR::PerfToolWriter::instance();
+   if (perfToolWriter)
+      perfToolWriter->codeLoad(sig, startPC, codeSize, comp);
+#endif // HOST_OS == OMR_LINUX
+   }
+
+void
+OMR::CodeCacheManager::registerMovedMethod(const char *sig, uint8_t *oldStartPC, uint8_t *newStartPC, uint32_t codeSize)
+   {
+#if (HOST_OS == OMR_LINUX)
+   CacheListCriticalSection updateSymbols(self());
+
+   for (TR::CodeCacheSymbol *symbol = _symbolContainer->_head; symbol; symbol = symbol->_next)
+      {
+      if (symbol->_start == oldStartPC)
+         symbol->_start = newStartPC;
+      }
+   if (_elfRelocatableGenerator)
+      {
+      for (TR::CodeCacheSymbol *symbol = _relocatableSymbolContainer->_head; symbol; symbol = symbol->_next)
+         {
+         if (symbol->_start == oldStartPC)
+            symbol->_start = newStartPC;
+         }
+      }
+
+   TR::PerfToolWriter *perfToolWriter = TR::PerfToolWriter::instance();
+   if (perfToolWriter)
+      perfToolWriter->codeMove(sig, oldStartPC, newStartPC, codeSize);
 #endif // HOST_OS == OMR_LINUX
    }
 
@@ -912,6 +942,7 @@ OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relo
 #if (HOST_OS == OMR_LINUX)
    if (_elfRelocatableGenerator)
       {
+      CacheListCriticalSection updateSymbols(self());
       const char * const symbolName(relocation.symbol());
       uint32_t nameLength = strlen(symbolName) + 1;
       char *name = static_cast<char *>(self()->getMemory(nameLength * sizeof(char)));
@@ -1138,6 +1169,20 @@ OMR::CodeCacheManager::initializeExecutableELFGenerator(void)
 #endif // HOST_OS==OMR_LINUX
 
 
+TR::CodeCache *
+OMR::CodeCacheManager::growCodeCache(
+      size_t segmentSizeInBytes,
+      int32_t reservingCompilationTID)
+   {
+   // Compilation threads race to grow the cache once all existing caches are
+   // reserved; without this the maximum number of caches can be exceeded.
+   CacheCreationCriticalSection createCodeCache(self());
+   if (!self()->canAddNewCodeCache())
+      return NULL;
+   return self()->allocateCodeCacheFromNewSegment(segmentSizeInBytes, reservingCompilationTID);
+   }
+
+
 TR::CodeCache *
 OMR::CodeCacheManager::allocateCodeCacheFromNewSegment(
       size_t segmentSizeInBytes,
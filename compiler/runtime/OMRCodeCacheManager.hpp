@@ -39,6 +39,7 @@ class TR_OpaqueMethodBlock;
 class TR_Memory;
 
 namespace TR { class CodeCache; }
+namespace TR { class Compilation; }
 namespace TR { class CodeCacheManager; }
 namespace TR { class CodeCacheMemorySegment; }
 namespace TR { class CodeGenerator; }
@@ -128,6 +129,12 @@ public:
       RepositoryMonitorCriticalSection(TR::CodeCacheManager *mgr);
       };
 
+   class CacheCreationCriticalSection : public CriticalSection
+      {
+      public:
+      CacheCreationCriticalSection(TR::CodeCacheManager *mgr);
+      };
+
    TR::CodeCacheConfig & codeCacheConfig() { return _config; }
 
    /**
@@ -194,6 +201,21 @@ public:
       size_t segmentSizeInBytes,
       int32_t reservingCompilationTID);
 
+   /**
+    * @brief Allocates a new code cache if the configured maximum number of
+    *        code caches has not been reached.  The check and the allocation
+    *        are atomic with respect to other threads growing the code cache.
+    *
+    * @param[in] segmentSizeInBytes : segment size to create the code cache from
+    * @param[in] reservingCompilationTID : as for allocateCodeCacheFromNewSegment
+    *
+    * @return the new, reserved, TR::CodeCache; NULL if no cache may be added
+    *         or the allocation failed.
+    */
+   TR::CodeCache * growCodeCache(
+      size_t segmentSizeInBytes,
+      int32_t reservingCompilationTID);
+
    TR::CodeCache * findCodeCacheFromPC(void *inCacheAddress);
 
    /**
@@ -256,7 +278,16 @@ public:
    bool lowCodeCacheSpaceThresholdReached() { return _lowCodeCacheSpaceThresholdReached; }
 
    void repositoryCodeCacheCreated();
-   void registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize);
+   /**
+    * @brief Add code to the symbols written out for tools such as perf.
+    * @param comp the compilation that produced the code, or NULL if it was
+    * not compiled from IL
+    */
+   void registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp = NULL);
+   /**
+    * @brief Report registered code that has been copied to a new address.
+    */
+   void registerMovedMethod(const char *sig, uint8_t *oldStartPC, uint8_t *newStartPC, uint32_t codeSize);
    void registerStaticRelocation(const TR::StaticRelocation &relocation);
 
    /**
@@ -287,6 +318,8 @@ protected:
    TR::CodeCacheMemorySegment    *_codeCacheRepositorySegment;
    TR::Monitor                   *_codeCacheRepositoryMonitor;
 
+   TR::Monitor                   *_codeCacheCreationMonitor;          /*!< serializes growing the set of code caches */
+
    bool                           _initialized;                       /*!< flag to indicate if code cache manager has been initialized or not */
    bool                           _lowCodeCacheSpaceThresholdReached; /*!< true if close to exhausting available code cache */
    bool                           _codeCacheFull;
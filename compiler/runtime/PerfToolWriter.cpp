@@ -0,0 +1,634 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/PerfToolWriter.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/VerboseLog.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+
+#if defined(LINUX)
+#define PERF_TOOL_SUPPORTED
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// Initial size of the buffer records are formatted into
+#define PERF_TOOL_BUFFER_SIZE (64 * 1024)
+
+TR::PerfToolWriter *OMR::PerfToolWriter::_instance = NULL;
+
+#if defined(PERF_TOOL_SUPPORTED)
+
+// The jitdump format is described in tools/perf/Documentation/jitdump-specification.txt
+// of the Linux sources.  All fields are in the byte order of the process.
+#define JITDUMP_MAGIC 0x4A695444
+#define JITDUMP_VERSION 1
+
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#define JITDUMP_ELF_MACHINE EM_X86_64
+#elif defined(TR_HOST_X86)
+#define JITDUMP_ELF_MACHINE EM_386
+#elif defined(TR_HOST_POWER) && defined(TR_HOST_64BIT)
+#define JITDUMP_ELF_MACHINE EM_PPC64
+#elif defined(TR_HOST_POWER)
+#define JITDUMP_ELF_MACHINE EM_PPC
+#elif defined(TR_HOST_S390)
+#define JITDUMP_ELF_MACHINE EM_S390
+#elif defined(TR_HOST_ARM64)
+#define JITDUMP_ELF_MACHINE EM_AARCH64
+#elif defined(TR_HOST_ARM)
+#define JITDUMP_ELF_MACHINE EM_ARM
+#else
+#define JITDUMP_ELF_MACHINE EM_NONE
+#endif
+
+struct OMR::PerfToolWriter::Thread
+   {
+   pthread_mutex_t _lock;
+   pthread_cond_t _workAvailable;
+   pthread_t _thread;
+   };
+
+namespace {
+
+enum JitDumpRecordType
+   {
+   JIT_CODE_LOAD = 0,
+   JIT_CODE_MOVE = 1,
+   JIT_CODE_DEBUG_INFO = 2,
+   JIT_CODE_CLOSE = 3
+   };
+
+struct JitDumpFileHeader
+   {
+   uint32_t _magic;
+   uint32_t _version;
+   uint32_t _totalSize;
+   uint32_t _elfMachine;
+   uint32_t _pad1;
+   uint32_t _pid;
+   uint64_t _timestamp;
+   uint64_t _flags;
+   };
+
+struct JitDumpRecordHeader
+   {
+   uint32_t _id;
+   uint32_t _totalSize;
+   uint64_t _timestamp;
+   };
+
+struct JitDumpCodeLoad
+   {
+   JitDumpRecordHeader _header;
+   uint32_t _pid;
+   uint32_t _tid;
+   uint64_t _vma;
+   uint64_t _codeAddress;
+   uint64_t _codeSize;
+   uint64_t _codeIndex;
+   // followed by the name and the code
+   };
+
+struct JitDumpCodeMove
+   {
+   JitDumpRecordHeader _header;
+   uint32_t _pid;
+   uint32_t _tid;
+   uint64_t _vma;
+   uint64_t _oldCodeAddress;
+   uint64_t _newCodeAddress;
+   uint64_t _codeSize;
+   uint64_t _codeIndex;
+   };
+
+struct JitDumpDebugInfo
+   {
+   JitDumpRecordHeader _header;
+   uint64_t _codeAddress;
+   uint64_t _numEntries;
+   // followed by the entries
+   };
+
+struct JitDumpDebugEntry
+   {
+   uint64_t _address;
+   int32_t _line;
+   int32_t _discriminator;
+   // followed by the file name
+   };
+
+/// perf matches the records against samples with the clock perf record -k mono uses
+uint64_t
+timestamp()
+   {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return static_cast<uint64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+   }
+
+void
+fillRecordHeader(JitDumpRecordHeader &header, JitDumpRecordType id, size_t totalSize)
+   {
+   header._id = id;
+   header._totalSize = static_cast<uint32_t>(totalSize);
+   header._timestamp = timestamp();
+   }
+
+bool
+writeFully(int fd, const char *data, size_t size)
+   {
+   while (size > 0)
+      {
+      ssize_t written = write(fd, data, size);
+      if (written < 0)
+         {
+         if (EINTR == errno)
+            continue;
+         return false;
+         }
+      data += written;
+      size -= written;
+      }
+   return true;
+   }
+
+int
+openPerfFile(const char *format, int flags)
+   {
+   char fileName[64];
+   snprintf(fileName, sizeof(fileName), format, static_cast<long long>(getpid()));
+   int fd = open(fileName, flags, 0644);
+   if (fd < 0 && TR::Options::getVerboseOption(TR_VerbosePerformance))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Cannot open %s", fileName);
+   return fd;
+   }
+
+/**
+ * Visit the instructions of a compilation where the bytecode index changes,
+ * in address order.  Instructions ahead of the entry point, such as the data
+ * that precedes it, are not part of the symbol and are left out.
+ */
+template <typename Visitor>
+void
+forEachLineChange(TR::Compilation *comp, const uint8_t *startPC, uint32_t codeSize, Visitor &visitor)
+   {
+   int32_t lastIndex = -1;
+   for (TR::Instruction *instruction = comp->cg()->getFirstInstruction(); instruction; instruction = instruction->getNext())
+      {
+      TR::Node *node = instruction->getNode();
+      uint8_t *address = instruction->getBinaryEncoding();
+      if (!node || address < startPC || address >= startPC + codeSize || instruction->getBinaryLength() == 0)
+         continue;
+      int32_t index = node->getByteCodeIndex();
+      if (index < 0 || index == lastIndex)
+         continue;
+      lastIndex = index;
+      visitor.visit(address, index);
+      }
+   }
+
+struct LineCounter
+   {
+   LineCounter() : _count(0) { }
+   void visit(uint8_t *address, int32_t index) { _count++; }
+   uint64_t _count;
+   };
+
+struct LineWriter
+   {
+   LineWriter(char *cursor, const char *fileName, size_t fileNameSize) :
+      _cursor(cursor), _fileName(fileName), _fileNameSize(fileNameSize) { }
+   void visit(uint8_t *address, int32_t index)
+      {
+      JitDumpDebugEntry entry;
+      entry._address = reinterpret_cast<uintptr_t>(address);
+      entry._line = index;
+      entry._discriminator = 0;
+      memcpy(_cursor, &entry, sizeof(entry));
+      memcpy(_cursor + sizeof(entry), _fileName, _fileNameSize);
+      _cursor += sizeof(entry) + _fileNameSize;
+      }
+   char *_cursor;
+   const char *_fileName;
+   size_t _fileNameSize;
+   };
+
+} // anonymous namespace
+
+#endif
+
+OMR::PerfToolWriter::PerfToolWriter(int perfMapFd, int jitDumpFd, void *jitDumpMapping, bool lineInfo, TR::RawAllocator rawAllocator) :
+   _rawAllocator(rawAllocator),
+   _jitDumpMapping(jitDumpMapping),
+   _lineInfo(lineInfo),
+   _codeIndices(CodeIndexMap::key_compare(), CodeIndexAllocator(rawAllocator)),
+   _nextCodeIndex(0),
+   _droppedRecords(0),
+   _shuttingDown(false),
+   _thread(NULL)
+   {
+   Buffer empty = { NULL, 0, 0 };
+   _perfMap._fd = perfMapFd;
+   _perfMap._pending = empty;
+   _perfMap._writing = empty;
+   _jitDump._fd = jitDumpFd;
+   _jitDump._pending = empty;
+   _jitDump._writing = empty;
+   }
+
+OMR::PerfToolWriter::~PerfToolWriter() throw()
+   {
+   Stream *streams[] = { &_perfMap, &_jitDump };
+   for (size_t i = 0; i < sizeof(streams) / sizeof(streams[0]); i++)
+      {
+      if (streams[i]->_pending._data)
+         _rawAllocator.deallocate(streams[i]->_pending._data);
+      if (streams[i]->_writing._data)
+         _rawAllocator.deallocate(streams[i]->_writing._data);
+#if defined(PERF_TOOL_SUPPORTED)
+      if (streams[i]->_fd >= 0)
+         close(streams[i]->_fd);
+#endif
+      }
+#if defined(PERF_TOOL_SUPPORTED)
+   if (_jitDumpMapping)
+      munmap(_jitDumpMapping, sysconf(_SC_PAGESIZE));
+   if (_thread)
+      {
+      pthread_cond_destroy(&_thread->_workAvailable);
+      pthread_mutex_destroy(&_thread->_lock);
+      _rawAllocator.deallocate(_thread);
+      }
+#endif
+   }
+
+void
+OMR::PerfToolWriter::initialize(bool perfMap, bool jitDump, bool lineInfo)
+   {
+   if (NULL != _instance || !(perfMap || jitDump))
+      return;
+
+#if defined(PERF_TOOL_SUPPORTED)
+   int perfMapFd = perfMap ? openPerfFile("/tmp/perf-%lld.map", O_WRONLY | O_CREAT | O_APPEND) : -1;
+
+   int jitDumpFd = -1;
+   void *jitDumpMapping = NULL;
+   if (jitDump)
+      {
+      jitDumpFd = openPerfFile("/tmp/jit-%lld.dump", O_RDWR | O_CREAT | O_TRUNC);
+      JitDumpFileHeader header;
+      memset(&header, 0, sizeof(header));
+      header._magic = JITDUMP_MAGIC;
+      header._version = JITDUMP_VERSION;
+      header._totalSize = sizeof(header);
+      header._elfMachine = JITDUMP_ELF_MACHINE;
+      header._pid = getpid();
+      header._timestamp = timestamp();
+      if (jitDumpFd >= 0 && writeFully(jitDumpFd, reinterpret_cast<const char *>(&header), sizeof(header)))
+         {
+         // perf record only learns about the file from an executable mapping of it
+         void *address = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, jitDumpFd, 0);
+         if (MAP_FAILED != address)
+            jitDumpMapping = address;
+         }
+      if (jitDumpFd >= 0 && !jitDumpMapping)
+         {
+         close(jitDumpFd);
+         jitDumpFd = -1;
+         }
+      }
+
+   if (perfMapFd < 0 && jitDumpFd < 0)
+      return;
+
+   TR::RawAllocator rawAllocator;
+   TR::PerfToolWriter *writer = new (rawAllocator) TR::PerfToolWriter(perfMapFd, jitDumpFd, jitDumpMapping, lineInfo, rawAllocator);
+   Thread *thread = static_cast<Thread *>(rawAllocator.allocate(sizeof(Thread)));
+   pthread_mutex_init(&thread->_lock, NULL);
+   pthread_cond_init(&thread->_workAvailable, NULL);
+   writer->_thread = thread;
+   if (0 != pthread_create(&thread->_thread, NULL, writerThread, writer))
+      {
+      writer->~PerfToolWriter();
+      rawAllocator.deallocate(writer);
+      return;
+      }
+   _instance = writer;
+#else
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "The perf map and jitdump files are not supported on this platform");
+#endif
+   }
+
+void
+OMR::PerfToolWriter::shutdown()
+   {
+   TR::PerfToolWriter *writer = _instance;
+   if (NULL == writer)
+      return;
+   _instance = NULL;
+
+#if defined(PERF_TOOL_SUPPORTED)
+   Thread *thread = writer->_thread;
+   pthread_mutex_lock(&thread->_lock);
+   writer->appendJitDumpClose();
+   writer->_shuttingDown = true;
+   pthread_cond_signal(&thread->_workAvailable);
+   pthread_mutex_unlock(&thread->_lock);
+   pthread_join(thread->_thread, NULL);
+
+   if (writer->_droppedRecords > 0 && TR::Options::getCmdLineOptions() && TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_PERF,
+         "Perf tool records dropped for lack of memory: %llu",
+         static_cast<unsigned long long>(writer->_droppedRecords)
+         );
+      }
+#endif
+
+   TR::RawAllocator rawAllocator(writer->_rawAllocator);
+   writer->~PerfToolWriter();
+   rawAllocator.deallocate(writer);
+   }
+
+void
+OMR::PerfToolWriter::codeLoad(const char *name, const uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp)
+   {
+#if defined(PERF_TOOL_SUPPORTED)
+   // Compiled methods are named with their hotness so that each body of a
+   // recompiled method can be told apart
+   char nameBuffer[1024];
+   if (comp && snprintf(nameBuffer, sizeof(nameBuffer), "%s_%s (compiled code)", comp->signature(), comp->getHotnessName(comp->getMethodHotness())) < static_cast<int>(sizeof(nameBuffer)))
+      name = nameBuffer;
+   size_t nameSize = strlen(name) + 1;
+
+   pthread_mutex_lock(&_thread->_lock);
+
+   if (_perfMap._fd >= 0)
+      appendPerfMapLine(name, startPC, codeSize);
+
+   if (_jitDump._fd >= 0)
+      {
+      uint64_t codeIndex = _nextCodeIndex++;
+      _codeIndices[reinterpret_cast<uintptr_t>(startPC)] = codeIndex;
+
+      // The debug information must come before the code it describes
+      if (_lineInfo && comp && comp->cg())
+         appendDebugInfo(startPC, codeSize, comp);
+
+      size_t recordSize = sizeof(JitDumpCodeLoad) + nameSize + codeSize;
+      char *record = reserve(_jitDump, recordSize);
+      if (record)
+         {
+         JitDumpCodeLoad load;
+         fillRecordHeader(load._header, JIT_CODE_LOAD, recordSize);
+         load._pid = getpid();
+         load._tid = static_cast<uint32_t>(syscall(SYS_gettid));
+         load._vma = reinterpret_cast<uintptr_t>(startPC);
+         load._codeAddress = reinterpret_cast<uintptr_t>(startPC);
+         load._codeSize = codeSize;
+         load._codeIndex = codeIndex;
+         memcpy(record, &load, sizeof(load));
+         memcpy(record + sizeof(load), name, nameSize);
+         memcpy(record + sizeof(load) + nameSize, startPC, codeSize);
+         }
+      }
+
+   wakeWriter();
+   pthread_mutex_unlock(&_thread->_lock);
+#endif
+   }
+
+void
+OMR::PerfToolWriter::codeMove(const char *name, const uint8_t *oldStartPC, const uint8_t *newStartPC, uint32_t codeSize)
+   {
+#if defined(PERF_TOOL_SUPPORTED)
+   pthread_mutex_lock(&_thread->_lock);
+
+   // A perf map line cannot be retracted, so the old range stays listed as well
+   if (_perfMap._fd >= 0)
+      appendPerfMapLine(name, newStartPC, codeSize);
+
+   if (_jitDump._fd >= 0)
+      {
+      // perf inject names the image for the code after the index of its load
+      uint64_t codeIndex;
+      CodeIndexMap::iterator loaded = _codeIndices.find(reinterpret_cast<uintptr_t>(oldStartPC));
+      if (loaded != _codeIndices.end())
+         {
+         codeIndex = loaded->second;
+         _codeIndices.erase(loaded);
+         }
+      else
+         {
+         codeIndex = _nextCodeIndex++;
+         }
+      _codeIndices[reinterpret_cast<uintptr_t>(newStartPC)] = codeIndex;
+
+      char *record = reserve(_jitDump, sizeof(JitDumpCodeMove));
+      if (record)
+         {
+         JitDumpCodeMove move;
+         fillRecordHeader(move._header, JIT_CODE_MOVE, sizeof(move));
+         move._pid = getpid();
+         move._tid = static_cast<uint32_t>(syscall(SYS_gettid));
+         move._vma = reinterpret_cast<uintptr_t>(newStartPC);
+         move._oldCodeAddress = reinterpret_cast<uintptr_t>(oldStartPC);
+         move._newCodeAddress = reinterpret_cast<uintptr_t>(newStartPC);
+         move._codeSize = codeSize;
+         move._codeIndex = codeIndex;
+         memcpy(record, &move, sizeof(move));
+         }
+      }
+
+   wakeWriter();
+   pthread_mutex_unlock(&_thread->_lock);
+#endif
+   }
+
+#if defined(PERF_TOOL_SUPPORTED)
+
+/**
+ * Make room for a record at the end of the pending buffer of a stream.
+ * Must be called with the lock held.
+ * @return NULL if the buffer cannot grow; the record is dropped
+ */
+char *
+OMR::PerfToolWriter::reserve(Stream &stream, size_t size)
+   {
+   Buffer &pending = stream._pending;
+   if (pending._size + size > pending._capacity)
+      {
+      size_t capacity = pending._capacity ? pending._capacity : PERF_TOOL_BUFFER_SIZE;
+      while (capacity < pending._size + size)
+         capacity *= 2;
+      char *data = static_cast<char *>(_rawAllocator.allocate(capacity, std::nothrow));
+      if (!data)
+         {
+         _droppedRecords++;
+         return NULL;
+         }
+      if (pending._data)
+         {
+         memcpy(data, pending._data, pending._size);
+         _rawAllocator.deallocate(pending._data);
+         }
+      pending._data = data;
+      pending._capacity = capacity;
+      }
+   char *record = pending._data + pending._size;
+   pending._size += size;
+   return record;
+   }
+
+/// Must be called with the lock held
+void
+OMR::PerfToolWriter::appendPerfMapLine(const char *name, const uint8_t *startPC, uint32_t codeSize)
+   {
+   // perf wants the start and size in hex without a leading 0x
+   unsigned long long start = reinterpret_cast<uintptr_t>(startPC);
+   int lineSize = snprintf(NULL, 0, "%llx %x %s\n", start, codeSize, name);
+   char *line = reserve(_perfMap, lineSize + 1);
+   if (line)
+      {
+      snprintf(line, lineSize + 1, "%llx %x %s\n", start, codeSize, name);
+      _perfMap._pending._size--; // the terminating NUL
+      }
+   }
+
+/**
+ * Append a debug-info record mapping the code of a compilation to the
+ * bytecode indices of its IL.  Must be called with the lock held.
+ */
+void
+OMR::PerfToolWriter::appendDebugInfo(const uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp)
+   {
+   LineCounter counter;
+   forEachLineChange(comp, startPC, codeSize, counter);
+   if (counter._count == 0)
+      return;
+
+   const char *fileName = comp->signature();
+   size_t fileNameSize = strlen(fileName) + 1;
+   size_t recordSize = sizeof(JitDumpDebugInfo) + counter._count * (sizeof(JitDumpDebugEntry) + fileNameSize);
+   char *record = reserve(_jitDump, recordSize);
+   if (!record)
+      return;
+
+   JitDumpDebugInfo debugInfo;
+   fillRecordHeader(debugInfo._header, JIT_CODE_DEBUG_INFO, recordSize);
+   debugInfo._codeAddress = reinterpret_cast<uintptr_t>(startPC);
+   debugInfo._numEntries = counter._count;
+   memcpy(record, &debugInfo, sizeof(debugInfo));
+
+   LineWriter writer(record + sizeof(debugInfo), fileName, fileNameSize);
+   forEachLineChange(comp, startPC, codeSize, writer);
+   }
+
+/// Must be called with the lock held
+void
+OMR::PerfToolWriter::appendJitDumpClose()
+   {
+   if (_jitDump._fd < 0)
+      return;
+   char *record = reserve(_jitDump, sizeof(JitDumpRecordHeader));
+   if (record)
+      {
+      JitDumpRecordHeader close;
+      fillRecordHeader(close, JIT_CODE_CLOSE, sizeof(close));
+      memcpy(record, &close, sizeof(close));
+      }
+   }
+
+/// Wake the writer thread for records just appended; must be called with the lock held
+void
+OMR::PerfToolWriter::wakeWriter()
+   {
+   pthread_cond_signal(&_thread->_workAvailable);
+   }
+
+/**
+ * Write out the buffer a stream's pending records were moved to.  Called by
+ * the writer thread without the lock; records that cannot be written are lost.
+ */
+void
+OMR::PerfToolWriter::flush(Stream &stream)
+   {
+   Buffer &writing = stream._writing;
+   if (stream._fd >= 0 && writing._size > 0)
+      writeFully(stream._fd, writing._data, writing._size);
+   writing._size = 0;
+   }
+
+/**
+ * Body of the writer thread: wait for records, swap the pending buffers with
+ * the ones just written so that registering threads can keep appending, and
+ * write them out.
+ */
+void
+OMR::PerfToolWriter::run()
+   {
+   pthread_mutex_lock(&_thread->_lock);
+   while (true)
+      {
+      while (!_shuttingDown && 0 == _perfMap._pending._size && 0 == _jitDump._pending._size)
+         pthread_cond_wait(&_thread->_workAvailable, &_thread->_lock);
+
+      bool done = _shuttingDown;
+      std::swap(_perfMap._pending, _perfMap._writing);
+      std::swap(_jitDump._pending, _jitDump._writing);
+      pthread_mutex_unlock(&_thread->_lock);
+
+      flush(_perfMap);
+      flush(_jitDump);
+
+      pthread_mutex_lock(&_thread->_lock);
+      if (done && 0 == _perfMap._pending._size && 0 == _jitDump._pending._size)
+         break;
+      }
+   pthread_mutex_unlock(&_thread->_lock);
+   }
+
+void *
+OMR::PerfToolWriter::writerThread(void *writer)
+   {
+   static_cast<TR::PerfToolWriter *>(writer)->run();
+   return NULL;
+   }
+
+#endif
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_PERF_TOOL_WRITER
+#define OMR_PERF_TOOL_WRITER
+
+#pragma once
+
+#ifndef TR_PERF_TOOL_WRITER
+#define TR_PERF_TOOL_WRITER
+namespace OMR { class PerfToolWriter; }
+namespace TR { using OMR::PerfToolWriter; }
+#endif
+
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include "env/RawAllocator.hpp"
+#include "env/TypedAllocator.hpp"
+
+namespace TR { class Compilation; }
+
+namespace OMR {
+
+/**
+ * @brief The PerfToolWriter class tells the Linux perf tool about compiled
+ * code as it is registered, so that JIT frames can be symbolized in profiles
+ * taken at any point in the run.
+ *
+ * Two files can be written:
+ *
+ * - /tmp/perf-<pid>.map, one "start size name" line per method, which perf
+ *   reads directly;
+ * - /tmp/jit-<pid>.dump, a jitdump file with code-load records holding a copy
+ *   of the code, code-move records and, on request, debug-info records that
+ *   map code addresses to the bytecode index of the IL they were generated
+ *   from.  `perf inject --jit` turns the records into ELF images; the file is
+ *   mapped executable so that perf record notices it.
+ *
+ * Records are formatted into memory by the registering thread and written out
+ * by a background thread, so compilation threads never wait on the file
+ * system.  All members may be called from any thread.
+ */
+class PerfToolWriter
+   {
+public:
+   /**
+    * @brief Start the process-wide writer if either file is requested.
+    * @param perfMap write /tmp/perf-<pid>.map
+    * @param jitDump write /tmp/jit-<pid>.dump
+    * @param lineInfo add debug-info records to the jitdump file
+    */
+   static void initialize(bool perfMap, bool jitDump, bool lineInfo);
+   /**
+    * @brief Write out pending records, stop the background thread and close
+    * the files.
+    */
+   static void shutdown();
+   static TR::PerfToolWriter *instance() throw() { return _instance; }
+
+   /**
+    * @brief Record a method that has been placed in the code cache.
+    * @param name the symbol for the code
+    * @param startPC the first byte of the code
+    * @param codeSize the size of the code in bytes
+    * @param comp the compilation that produced the code, or NULL for code
+    * such as trampolines that has no IL; used for the line information
+    */
+   void codeLoad(const char *name, const uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp);
+   /**
+    * @brief Record code that has been moved within the code cache.
+    */
+   void codeMove(const char *name, const uint8_t *oldStartPC, const uint8_t *newStartPC, uint32_t codeSize);
+
+private:
+   struct Buffer
+      {
+      char *_data;
+      size_t _size;
+      size_t _capacity;
+      };
+
+   struct Thread;
+
+   struct Stream
+      {
+      int _fd;
+      Buffer _pending;
+      Buffer _writing;
+      };
+
+   typedef TR::typed_allocator<std::pair<const uintptr_t, uint64_t>, TR::RawAllocator> CodeIndexAllocator;
+   typedef std::map<uintptr_t, uint64_t, std::less<uintptr_t>, CodeIndexAllocator> CodeIndexMap;
+
+   PerfToolWriter(int perfMapFd, int jitDumpFd, void *jitDumpMapping, bool lineInfo, TR::RawAllocator rawAllocator);
+   ~PerfToolWriter() throw();
+
+   char *reserve(Stream &stream, size_t size);
+   void appendPerfMapLine(const char *name, const uint8_t *startPC, uint32_t codeSize);
+   void appendDebugInfo(const uint8_t *startPC, uint32_t codeSize, TR::Compilation *comp);
+   void appendJitDumpClose();
+   void wakeWriter();
+   void flush(Stream &stream);
+   void run();
+   static void *writerThread(void *writer);
+
+   static TR::PerfToolWriter *_instance;
+
+   TR::RawAllocator _rawAllocator;
+   Stream _perfMap;
+   Stream _jitDump;
+   void * const _jitDumpMapping;
+   bool const _lineInfo;
+   CodeIndexMap _codeIndices;
+   uint64_t _nextCodeIndex;
+   uint64_t _droppedRecords;
+   bool _shuttingDown;
+   Thread *_thread;
+   };
+
+} // namespace OMR
+
+#endif // OMR_PERF_TOOL_WRITER
@@ -0,0 +1,774 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/PersistentCodeCache.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/FrontEnd.hpp"
+#include "codegen/StaticRelocation.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/ResolvedMethod.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/VerboseLog.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "il/symbol/MethodSymbol.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "infra/Assert.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+#if defined(TR_TARGET_X86) && defined(TR_TARGET_64BIT) && (defined(LINUX) || defined(OSX))
+#define PERSISTENT_CODE_CACHE_SUPPORTED
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+TR::PersistentCodeCache *OMR::PersistentCodeCache::_instance = NULL;
+
+// Bump whenever the layout of the file or of the code stored in it changes
+static const uint32_t PERSISTENT_CODE_CACHE_VERSION = 1;
+static const char PERSISTENT_CODE_CACHE_MAGIC[8] = { 'O', 'M', 'R', 'J', 'I', 'T', 'P', 'C' };
+static const uint32_t PERSISTENT_CODE_RECORD_MAGIC = 0x4d434a4f; // "OJCM"
+
+struct OMR::PersistentCodeCache::FileHeader
+   {
+   char _magic[8];
+   uint32_t _version;
+   uint32_t _pointerSize;
+   uint64_t _environment;
+   };
+
+/**
+ * A record is followed by _numRelocations Relocations, the NUL terminated
+ * method signature, the NUL terminated relocation target names and, at
+ * _codeOffset from the start of the record, the code.  Records are 8 byte
+ * aligned.
+ */
+struct OMR::PersistentCodeCache::RecordHeader
+   {
+   uint32_t _magic;
+   uint32_t _size;
+   uint64_t _key;
+   uint32_t _numRelocations;
+   uint32_t _signatureLength;
+   uint32_t _codeOffset;
+   uint32_t _codeSize;
+   uint32_t _entryOffset;
+   uint32_t _checksum;
+   };
+
+namespace {
+
+struct Relocation
+   {
+   uint32_t _offset;
+   uint32_t _nameLength;
+   };
+
+const uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+
+inline uint64_t
+hashValue(uint64_t hash, uint64_t value)
+   {
+   for (int32_t i = 0; i < 8; ++i)
+      {
+      hash ^= (value >> (8 * i)) & 0xff;
+      hash *= 0x100000001b3ULL;
+      }
+   return hash;
+   }
+
+inline uint64_t
+hashString(uint64_t hash, const char *string)
+   {
+   for (const unsigned char *s = reinterpret_cast<const unsigned char *>(string); *s; ++s)
+      {
+      hash ^= *s;
+      hash *= 0x100000001b3ULL;
+      }
+   return hashValue(hash, 0);
+   }
+
+uint32_t
+checksum(const uint8_t *data, size_t size)
+   {
+   uint32_t sum = 0;
+   for (size_t i = 0; i < size; ++i)
+      sum = (sum << 5) + sum + data[i];
+   return sum;
+   }
+
+inline size_t
+alignRecord(size_t size)
+   {
+   return (size + 7) & ~static_cast<size_t>(7);
+   }
+
+/**
+ * Hashes the trees of a method.  Every node contributes its global index, so
+ * commoned nodes are hashed once and the shape of the commoning is kept.
+ * Calls to methods with a known address contribute the method's name rather
+ * than its address, as the address is bound when the code is installed.
+ */
+class TreeHasher
+   {
+public:
+   TreeHasher(TR::Compilation *comp) : _comp(comp), _visited(comp), _hash(HASH_SEED), _cacheable(true) {}
+
+   void hashTree(TR::Node *node);
+   uint64_t hash() const { return _hash; }
+   bool cacheable() const { return _cacheable; }
+
+private:
+   void hashConstant(TR::Node *node);
+   void hashSymbol(TR::Node *node);
+   void hashDestination(TR::TreeTop *destination);
+
+   TR::Compilation *_comp;
+   TR::NodeChecklist _visited;
+   uint64_t _hash;
+   bool _cacheable;
+   };
+
+void
+TreeHasher::hashTree(TR::Node *node)
+   {
+   _hash = hashValue(_hash, node->getGlobalIndex());
+   if (_visited.contains(node))
+      return;
+   _visited.add(node);
+
+   TR::ILOpCode &op = node->getOpCode();
+   _hash = hashValue(_hash, op.getOpCodeValue());
+   _hash = hashValue(_hash, node->getDataType().getDataType());
+   _hash = hashValue(_hash, node->getNumChildren());
+
+   // Jump tables are emitted outside the method body
+   if (node->getOpCodeValue() == TR::table)
+      _cacheable = false;
+
+   if (op.isLoadConst())
+      hashConstant(node);
+   else if (node->getOpCodeValue() == TR::BBStart || node->getOpCodeValue() == TR::BBEnd)
+      {
+      TR::Block *block = node->getBlock();
+      _hash = hashValue(_hash, block->getNumber());
+      _hash = hashValue(_hash, block->getFrequency());
+      _hash = hashValue(_hash, block->isCold());
+      }
+   else if (op.isCase())
+      {
+      _hash = hashValue(_hash, node->getCaseConstant());
+      hashDestination(node->getBranchDestination());
+      }
+   else if (op.isBranch())
+      hashDestination(node->getBranchDestination());
+
+   if (op.hasSymbolReference() && node->getSymbolReference())
+      hashSymbol(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      hashTree(node->getChild(i));
+   }
+
+void
+TreeHasher::hashConstant(TR::Node *node)
+   {
+   if (node->canGet64bitIntegralValue())
+      _hash = hashValue(_hash, node->get64bitIntegralValue());
+   else if (node->getDataType() == TR::Float)
+      _hash = hashValue(_hash, node->getFloatBits());
+   else if (node->getDataType() == TR::Double)
+      _hash = hashValue(_hash, node->getDoubleBits());
+   else
+      _cacheable = false;
+   }
+
+void
+TreeHasher::hashDestination(TR::TreeTop *destination)
+   {
+   if (destination)
+      _hash = hashValue(_hash, destination->getNode()->getBlock()->getNumber());
+   else
+      _cacheable = false;
+   }
+
+void
+TreeHasher::hashSymbol(TR::Node *node)
+   {
+   TR::SymbolReference *symRef = node->getSymbolReference();
+   TR::Symbol *sym = symRef->getSymbol();
+   _hash = hashValue(_hash, symRef->getReferenceNumber());
+   _hash = hashValue(_hash, symRef->getOffset());
+   _hash = hashValue(_hash, sym->getKind());
+   _hash = hashValue(_hash, sym->getDataType().getDataType());
+   _hash = hashValue(_hash, sym->getSize());
+
+   // The address of a static would be baked into the code
+   if (sym->isStatic())
+      {
+      _cacheable = false;
+      }
+   else if (sym->isMethod())
+      {
+      TR::MethodSymbol *methodSym = sym->castToMethodSymbol();
+      TR::ResolvedMethodSymbol *resolvedMethodSym = sym->getResolvedMethodSymbol();
+      if (_comp->isRecursiveMethodTarget(sym))
+         _hash = hashValue(_hash, 1);
+      else if (methodSym->isHelper())
+         _cacheable = false;
+      else if (resolvedMethodSym && methodSym->getMethodAddress())
+         _hash = hashString(_hash, resolvedMethodSym->getResolvedMethod()->externalName(_comp->trMemory()));
+      else if (!node->getOpCode().isCallIndirect())
+         _cacheable = false;
+      }
+   }
+
+/**
+ * Finds the address of an external method called under a node from the name
+ * its static relocation was recorded with.
+ */
+uintptr_t
+findCallTarget(TR::Compilation *comp, TR::Node *node, const char *name, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return 0;
+   visited.add(node);
+
+   if (node->getOpCode().isCall() && node->getSymbolReference())
+      {
+      TR::ResolvedMethodSymbol *resolvedMethodSym = node->getSymbolReference()->getSymbol()->getResolvedMethodSymbol();
+      if (resolvedMethodSym
+          && resolvedMethodSym->getMethodAddress()
+          && 0 == strcmp(name, resolvedMethodSym->getResolvedMethod()->externalName(comp->trMemory())))
+         return reinterpret_cast<uintptr_t>(resolvedMethodSym->getMethodAddress());
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      uintptr_t target = findCallTarget(comp, node->getChild(i), name, visited);
+      if (target)
+         return target;
+      }
+   return 0;
+   }
+
+uintptr_t
+findCallTarget(TR::Compilation *comp, const char *name)
+   {
+   TR::NodeChecklist visited(comp);
+   for (TR::TreeTop *tt = comp->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      uintptr_t target = findCallTarget(comp, tt->getNode(), name, visited);
+      if (target)
+         return target;
+      }
+   return 0;
+   }
+
+#if defined(PERSISTENT_CODE_CACHE_SUPPORTED)
+bool
+writeFully(int fd, const void *data, size_t size, off_t offset)
+   {
+   const uint8_t *cursor = static_cast<const uint8_t *>(data);
+   while (size > 0)
+      {
+      ssize_t written = pwrite(fd, cursor, size, offset);
+      if (written <= 0)
+         return false;
+      cursor += written;
+      offset += written;
+      size -= written;
+      }
+   return true;
+   }
+
+uint64_t
+hashEnvironment(const char *options)
+   {
+   uint64_t hash = HASH_SEED;
+   hash = hashValue(hash, PERSISTENT_CODE_CACHE_VERSION);
+   hash = hashString(hash, options ? options : "");
+   const char *envOptions = feGetEnv("TR_Options");
+   hash = hashString(hash, envOptions ? envOptions : "");
+   hash = hashString(hash, __DATE__ " " __TIME__);
+   hash = hashValue(hash, TR::Compiler->target.cpu.getX86ProcessorFeatureFlags());
+   hash = hashValue(hash, TR::Compiler->target.cpu.getX86ProcessorFeatureFlags2());
+   hash = hashValue(hash, TR::Compiler->target.cpu.getX86ProcessorFeatureFlags8());
+
+   // Code compiled by a different build of the JIT may refer to other helpers
+   // or have a different layout, so the executable is part of the environment
+#if defined(LINUX)
+   struct stat executable;
+   if (0 == stat("/proc/self/exe", &executable))
+      {
+      hash = hashValue(hash, executable.st_size);
+      hash = hashValue(hash, executable.st_mtime);
+      }
+#endif
+   return hash;
+   }
+#endif
+
+} // anonymous namespace
+
+OMR::PersistentCodeCache::PersistentCodeCache(int fd, const uint8_t *mapping, size_t mappingSize, uint64_t environment, TR::RawAllocator rawAllocator) :
+   _rawAllocator(rawAllocator),
+   _monitor(TR::Monitor::create("JIT-PersistentCodeCacheMonitor")),
+   _fd(fd),
+   _mapping(mapping),
+   _mappingSize(mappingSize),
+   _environment(environment),
+   _index(NULL),
+   _indexSize(0),
+   _hits(0),
+   _misses(0),
+   _stores(0)
+   {
+   }
+
+OMR::PersistentCodeCache::~PersistentCodeCache() throw()
+   {
+   if (_index)
+      _rawAllocator.deallocate(_index);
+#if defined(PERSISTENT_CODE_CACHE_SUPPORTED)
+   if (_mapping)
+      munmap(const_cast<uint8_t *>(_mapping), _mappingSize);
+   close(_fd);
+#endif
+   TR::Monitor::destroy(_monitor);
+   }
+
+void
+OMR::PersistentCodeCache::initialize(const char *fileName, const char *options)
+   {
+   if (NULL != _instance || NULL == fileName)
+      return;
+
+#if defined(PERSISTENT_CODE_CACHE_SUPPORTED)
+   int fd = open(fileName, O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      {
+      if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Cannot open persistent code cache %s", fileName);
+      return;
+      }
+
+   uint64_t environment = hashEnvironment(options);
+   FileHeader header;
+   struct stat status;
+
+   // A file written by another build, with other options or for another
+   // processor is replaced by an empty one.  The new file is renamed over the
+   // old one so processes that still map the old file are not affected.
+   flock(fd, LOCK_SH);
+   if (0 != fstat(fd, &status)
+       || status.st_size < static_cast<off_t>(sizeof(header))
+       || sizeof(header) != pread(fd, &header, sizeof(header), 0)
+       || 0 != memcmp(header._magic, PERSISTENT_CODE_CACHE_MAGIC, sizeof(header._magic))
+       || PERSISTENT_CODE_CACHE_VERSION != header._version
+       || sizeof(void *) != header._pointerSize
+       || environment != header._environment)
+      {
+      flock(fd, LOCK_UN);
+      close(fd);
+
+      memcpy(header._magic, PERSISTENT_CODE_CACHE_MAGIC, sizeof(header._magic));
+      header._version = PERSISTENT_CODE_CACHE_VERSION;
+      header._pointerSize = sizeof(void *);
+      header._environment = environment;
+
+      TR::RawAllocator rawAllocator;
+      size_t newFileNameLength = strlen(fileName) + 32;
+      char *newFileName = static_cast<char *>(rawAllocator.allocate(newFileNameLength));
+      snprintf(newFileName, newFileNameLength, "%s.%lld", fileName, static_cast<long long>(getpid()));
+      fd = open(newFileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+      bool created = fd >= 0
+         && writeFully(fd, &header, sizeof(header), 0)
+         && 0 == rename(newFileName, fileName);
+      if (!created)
+         {
+         if (fd >= 0)
+            {
+            close(fd);
+            unlink(newFileName);
+            }
+         rawAllocator.deallocate(newFileName);
+         return;
+         }
+      rawAllocator.deallocate(newFileName);
+      flock(fd, LOCK_SH);
+      status.st_size = sizeof(header);
+      }
+
+   const uint8_t *mapping = NULL;
+   size_t mappingSize = status.st_size;
+   if (mappingSize > sizeof(header))
+      {
+      void *address = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (MAP_FAILED != address)
+         mapping = static_cast<const uint8_t *>(address);
+      }
+   flock(fd, LOCK_UN);
+
+   TR::RawAllocator rawAllocator;
+   _instance = new (rawAllocator) TR::PersistentCodeCache(fd, mapping, mapping ? mappingSize : 0, environment, rawAllocator);
+   size_t validSize = _instance->buildIndex();
+
+   // Records appended after one cut short by a crash could never be found,
+   // so drop the partial record unless another process has appended since
+   if (mapping && validSize < mappingSize)
+      {
+      flock(fd, LOCK_EX);
+      if (0 == fstat(fd, &status) && static_cast<size_t>(status.st_size) == mappingSize)
+         {
+         if (0 != ftruncate(fd, validSize) && TR::Options::getVerboseOption(TR_VerbosePerformance))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Cannot drop the partial record at the end of %s", fileName);
+         }
+      flock(fd, LOCK_UN);
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_CODECACHE,
+         "Persistent code cache %s: %llu methods",
+         fileName,
+         static_cast<unsigned long long>(_instance->_indexSize)
+         );
+      }
+#else
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "The persistent code cache is not supported on this platform");
+#endif
+   }
+
+void
+OMR::PersistentCodeCache::shutdown()
+   {
+   TR::PersistentCodeCache *cache = _instance;
+   if (NULL == cache)
+      return;
+
+   if (TR::Options::getCmdLineOptions() && TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_CODECACHE,
+         "Persistent code cache: %llu methods installed, %llu not found, %llu stored",
+         static_cast<unsigned long long>(cache->hits()),
+         static_cast<unsigned long long>(cache->misses()),
+         static_cast<unsigned long long>(cache->stores())
+         );
+      }
+
+   _instance = NULL;
+   TR::RawAllocator rawAllocator(cache->_rawAllocator);
+   cache->~PersistentCodeCache();
+   rawAllocator.deallocate(cache);
+   }
+
+const OMR::PersistentCodeCache::RecordHeader *
+OMR::PersistentCodeCache::nextRecord(const uint8_t *cursor, const uint8_t *end)
+   {
+   if (static_cast<size_t>(end - cursor) < sizeof(RecordHeader))
+      return NULL;
+
+   // A record cut short by a crash ends the scan
+   const RecordHeader *record = reinterpret_cast<const RecordHeader *>(cursor);
+   if (PERSISTENT_CODE_RECORD_MAGIC != record->_magic
+       || record->_size < sizeof(RecordHeader)
+       || 0 != (record->_size & 7)
+       || record->_size > static_cast<size_t>(end - cursor)
+       || record->_codeOffset > record->_size
+       || record->_codeSize > record->_size - record->_codeOffset
+       || record->_entryOffset >= record->_codeSize
+       || record->_numRelocations > (record->_codeOffset - sizeof(RecordHeader)) / sizeof(Relocation))
+      return NULL;
+
+   // The signature and relocation target names must be terminated before
+   // the code and every relocation must be within the code
+   const Relocation *relocations = reinterpret_cast<const Relocation *>(record + 1);
+   size_t stringsEnd = sizeof(RecordHeader) + record->_numRelocations * sizeof(Relocation) + record->_signatureLength;
+   if (0 == record->_signatureLength || stringsEnd > record->_codeOffset || '\0' != cursor[stringsEnd - 1])
+      return NULL;
+   for (uint32_t i = 0; i < record->_numRelocations; ++i)
+      {
+      stringsEnd += relocations[i]._nameLength;
+      if (0 == relocations[i]._nameLength
+          || stringsEnd > record->_codeOffset
+          || '\0' != cursor[stringsEnd - 1]
+          || relocations[i]._offset > record->_codeSize - sizeof(uintptr_t))
+         return NULL;
+      }
+
+   return record;
+   }
+
+/**
+ * @return the size of the part of the mapping made of the file header and
+ * complete records
+ */
+size_t
+OMR::PersistentCodeCache::buildIndex()
+   {
+   if (!_mapping)
+      return _mappingSize;
+
+   const uint8_t *start = _mapping + sizeof(FileHeader);
+   const uint8_t *end = _mapping + _mappingSize;
+   const uint8_t *validEnd = start;
+   size_t numRecords = 0;
+   for (const RecordHeader *record; NULL != (record = nextRecord(validEnd, end)); validEnd += record->_size)
+      ++numRecords;
+   size_t validSize = validEnd - _mapping;
+   if (0 == numRecords)
+      return validSize;
+
+   _index = static_cast<IndexEntry *>(_rawAllocator.allocate(numRecords * sizeof(IndexEntry), std::nothrow));
+   if (!_index)
+      return validSize;
+
+   for (const uint8_t *cursor = start; const RecordHeader *record = nextRecord(cursor, end); cursor += record->_size)
+      {
+      _index[_indexSize]._key = record->_key;
+      _index[_indexSize]._record = record;
+      ++_indexSize;
+      }
+
+   struct ByKey
+      {
+      bool operator()(const IndexEntry &a, const IndexEntry &b) const { return a._key < b._key; }
+      };
+   std::stable_sort(_index, _index + _indexSize, ByKey());
+   return validSize;
+   }
+
+/// @return the position of the first index entry for the key, if any
+size_t
+OMR::PersistentCodeCache::lowerBound(uint64_t key) const
+   {
+   size_t low = 0;
+   size_t high = _indexSize;
+   while (low < high)
+      {
+      size_t middle = low + (high - low) / 2;
+      if (_index[middle]._key < key)
+         low = middle + 1;
+      else
+         high = middle;
+      }
+   return low;
+   }
+
+/**
+ * Checks that a record found by key is intact and was written for this very
+ * method, and that every external method its code calls is called by this
+ * method too.
+ */
+bool
+OMR::PersistentCodeCache::matches(TR::Compilation *comp, const RecordHeader *record) const
+   {
+   const Relocation *relocations = reinterpret_cast<const Relocation *>(record + 1);
+   const char *signature = reinterpret_cast<const char *>(relocations + record->_numRelocations);
+   const uint8_t *code = reinterpret_cast<const uint8_t *>(record) + record->_codeOffset;
+   if (0 != strcmp(signature, comp->signature()) || record->_checksum != checksum(code, record->_codeSize))
+      return false;
+
+   const char *name = signature + record->_signatureLength;
+   for (uint32_t i = 0; i < record->_numRelocations; ++i)
+      {
+      if (0 == findCallTarget(comp, name))
+         return false;
+      name += relocations[i]._nameLength;
+      }
+   return true;
+   }
+
+bool
+OMR::PersistentCodeCache::computeKey(TR::Compilation *comp, uint64_t &key)
+   {
+   TreeHasher hasher(comp);
+   for (TR::TreeTop *tt = comp->getStartTree(); tt && hasher.cacheable(); tt = tt->getNextTreeTop())
+      hasher.hashTree(tt->getNode());
+
+   if (!hasher.cacheable())
+      return false;
+
+   uint64_t hash = hashValue(hasher.hash(), _environment);
+   hash = hashValue(hash, comp->getMethodHotness());
+   key = hashString(hash, comp->signature());
+   return true;
+   }
+
+bool
+OMR::PersistentCodeCache::install(TR::Compilation *comp, uint64_t key)
+   {
+   // A damaged record must not hide a good one stored again for the same key
+   const RecordHeader *record = NULL;
+   for (size_t i = lowerBound(key); NULL == record && i < _indexSize && _index[i]._key == key; ++i)
+      {
+      if (matches(comp, _index[i]._record))
+         record = _index[i]._record;
+      }
+
+   if (NULL == record)
+      {
+      OMR::CriticalSection missing(_monitor);
+      ++_misses;
+      return false;
+      }
+
+   TR::CodeGenerator *cg = comp->cg();
+   cg->reserveCodeCache();
+   uint8_t *coldCode = NULL;
+   uint8_t *buffer = cg->allocateCodeMemory(record->_codeSize, 0, &coldCode);
+   cg->commitToCodeCache();
+   const Relocation *relocations = reinterpret_cast<const Relocation *>(record + 1);
+   const char *signature = reinterpret_cast<const char *>(relocations + record->_numRelocations);
+   memcpy(buffer, reinterpret_cast<const uint8_t *>(record) + record->_codeOffset, record->_codeSize);
+
+   const char *name = signature + record->_signatureLength;
+   for (uint32_t i = 0; i < record->_numRelocations; ++i)
+      {
+      uintptr_t target = findCallTarget(comp, name);
+      memcpy(buffer + relocations[i]._offset, &target, sizeof(target));
+      name += relocations[i]._nameLength;
+      }
+
+   cg->setBinaryBufferStart(buffer);
+   cg->setBinaryBufferCursor(buffer + record->_codeSize);
+   cg->setPrePrologueSize(record->_entryOffset);
+   TR::CodeGenerator::syncCode(buffer, record->_codeSize);
+
+   OMR::CriticalSection installed(_monitor);
+   ++_hits;
+   return true;
+   }
+
+void
+OMR::PersistentCodeCache::store(TR::Compilation *comp, uint64_t key)
+   {
+#if defined(PERSISTENT_CODE_CACHE_SUPPORTED)
+   TR::CodeGenerator *cg = comp->cg();
+   if (cg->hasProjectSpecializedRelocations() || 0 != cg->getJitMethodEntryPaddingSize())
+      return;
+
+   const uint8_t *start = cg->getBinaryBufferStart();
+   const uint8_t *end = cg->getCodeEnd();
+   size_t codeSize = end - start;
+   const char *signature = comp->signature();
+   size_t signatureLength = strlen(signature) + 1;
+
+   TR::list<TR::StaticRelocation> &staticRelocations = cg->getStaticRelocations();
+   size_t numRelocations = 0;
+   size_t namesLength = 0;
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it)
+      {
+      if (TR::StaticRelocationSize::word64 != it->size()
+          || TR::StaticRelocationType::Absolute != it->type()
+          || it->location() < start
+          || it->location() + sizeof(uintptr_t) > end)
+         return;
+      ++numRelocations;
+      namesLength += strlen(it->symbol()) + 1;
+      }
+
+   // Code holding its own address cannot be moved; the relocated words hold
+   // addresses of other methods, so they are skipped
+   for (const uint8_t *cursor = start; cursor + sizeof(uintptr_t) <= end; ++cursor)
+      {
+      uintptr_t value;
+      memcpy(&value, cursor, sizeof(value));
+      if (value < reinterpret_cast<uintptr_t>(start) || value > reinterpret_cast<uintptr_t>(end))
+         continue;
+
+      bool relocated = false;
+      for (auto it = staticRelocations.begin(); !relocated && it != staticRelocations.end(); ++it)
+         relocated = it->location() == cursor;
+      if (!relocated)
+         return;
+      }
+
+   size_t codeOffset = alignRecord(sizeof(RecordHeader) + numRelocations * sizeof(Relocation) + signatureLength + namesLength);
+   size_t recordSize = alignRecord(codeOffset + codeSize);
+   if (recordSize > UINT32_MAX)
+      return;
+
+   uint8_t *buffer = static_cast<uint8_t *>(comp->trMemory()->allocateHeapMemory(recordSize));
+   memset(buffer, 0, recordSize);
+
+   RecordHeader *record = reinterpret_cast<RecordHeader *>(buffer);
+   record->_magic = PERSISTENT_CODE_RECORD_MAGIC;
+   record->_size = static_cast<uint32_t>(recordSize);
+   record->_key = key;
+   record->_numRelocations = static_cast<uint32_t>(numRelocations);
+   record->_signatureLength = static_cast<uint32_t>(signatureLength);
+   record->_codeOffset = static_cast<uint32_t>(codeOffset);
+   record->_codeSize = static_cast<uint32_t>(codeSize);
+   record->_entryOffset = static_cast<uint32_t>(cg->getCodeStart() - start);
+
+   Relocation *relocations = reinterpret_cast<Relocation *>(record + 1);
+   char *names = reinterpret_cast<char *>(relocations + numRelocations);
+   memcpy(names, signature, signatureLength);
+   names += signatureLength;
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it, ++relocations)
+      {
+      relocations->_offset = static_cast<uint32_t>(it->location() - start);
+      relocations->_nameLength = static_cast<uint32_t>(strlen(it->symbol()) + 1);
+      memcpy(names, it->symbol(), relocations->_nameLength);
+      names += relocations->_nameLength;
+      }
+
+   uint8_t *code = buffer + codeOffset;
+   memcpy(code, start, codeSize);
+   relocations = reinterpret_cast<Relocation *>(record + 1);
+   for (size_t i = 0; i < numRelocations; ++i)
+      memset(code + relocations[i]._offset, 0, sizeof(uintptr_t));
+   record->_checksum = checksum(code, codeSize);
+
+   // Another process may have started the file afresh since it was mapped
+   OMR::CriticalSection storing(_monitor);
+   flock(_fd, LOCK_EX);
+   FileHeader header;
+   struct stat status;
+   if (sizeof(header) == pread(_fd, &header, sizeof(header), 0)
+       && _environment == header._environment
+       && 0 == fstat(_fd, &status)
+       && writeFully(_fd, buffer, recordSize, status.st_size))
+      ++_stores;
+   flock(_fd, LOCK_UN);
+#endif
+   }
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_PERSISTENT_CODE_CACHE
+#define OMR_PERSISTENT_CODE_CACHE
+
+#pragma once
+
+#ifndef TR_PERSISTENT_CODE_CACHE
+#define TR_PERSISTENT_CODE_CACHE
+namespace OMR { class PersistentCodeCache; }
+namespace TR { using OMR::PersistentCodeCache; }
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/RawAllocator.hpp"
+
+namespace TR { class Compilation; }
+namespace TR { class Monitor; }
+
+namespace OMR {
+
+/**
+ * @brief The PersistentCodeCache class keeps compiled method bodies in a file
+ * so later runs can install them instead of compiling the method again.
+ *
+ * A method is identified by a hash of its trees as they come out of IL
+ * generation, which is mixed with a hash of the JIT options, the processor
+ * features and the executable the JIT is linked into.  The file holds a
+ * header followed by one record per method: the method signature, the code
+ * from the start of the binary buffer to the end of the method and the static
+ * relocations for the external methods it calls, which are bound by name when
+ * the record is installed.
+ *
+ * The file is mapped when the JIT starts; records written by this process are
+ * appended to the file under an exclusive lock and are found by the next run.
+ * Only x86-64 Linux and OSX are supported, and only methods whose code does
+ * not refer to helpers, statics or absolute addresses within itself are kept.
+ *
+ * All members may be called from any compilation thread.
+ */
+class PersistentCodeCache
+   {
+public:
+   /**
+    * @brief Open or create the process-wide cache.
+    * @param fileName the cache file, or NULL to leave the cache disabled
+    * @param options the JIT command line options, part of every key
+    */
+   static void initialize(const char *fileName, const char *options);
+   /**
+    * @brief Report the cache statistics to the verbose log if requested and
+    * close the process-wide cache.
+    */
+   static void shutdown();
+   static TR::PersistentCodeCache *instance() throw() { return _instance; }
+
+   /**
+    * @brief Hash the trees of a compilation right after IL generation.
+    * @return false if the method cannot be kept in the cache
+    */
+   bool computeKey(TR::Compilation *comp, uint64_t &key);
+   /**
+    * @brief Install the cached body for the key into the code cache and
+    * point the code generator's binary buffer at it.
+    * @return true if the compilation can finish without optimizing and
+    * generating code
+    */
+   bool install(TR::Compilation *comp, uint64_t key);
+   /**
+    * @brief Append the method just compiled to the cache file if its code
+    * can be moved to another process.
+    */
+   void store(TR::Compilation *comp, uint64_t key);
+
+   uint64_t hits() const throw() { return _hits; }
+   uint64_t misses() const throw() { return _misses; }
+   uint64_t stores() const throw() { return _stores; }
+
+private:
+   struct FileHeader;
+   struct RecordHeader;
+   struct IndexEntry
+      {
+      uint64_t _key;
+      const RecordHeader *_record;
+      };
+
+   PersistentCodeCache(int fd, const uint8_t *mapping, size_t mappingSize, uint64_t environment, TR::RawAllocator rawAllocator);
+   ~PersistentCodeCache() throw();
+
+   size_t buildIndex();
+   size_t lowerBound(uint64_t key) const;
+   bool matches(TR::Compilation *comp, const RecordHeader *record) const;
+   static const RecordHeader *nextRecord(const uint8_t *cursor, const uint8_t *end);
+
+   static TR::PersistentCodeCache *_instance;
+
+   TR::RawAllocator _rawAllocator;
+   TR::Monitor *_monitor;
+   int const _fd;
+   const uint8_t * const _mapping;
+   size_t const _mappingSize;
+   uint64_t const _environment;
+   IndexEntry *_index;
+   size_t _indexSize;
+   uint64_t _hits;
+   uint64_t _misses;
+   uint64_t _stores;
+   };
+
+} // namespace OMR
+
+#endif // OMR_PERSISTENT_CODE_CACHE
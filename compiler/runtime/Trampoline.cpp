@@ -71,7 +71,6 @@ ppcCodeCacheConfig(int32_t ccSizeInByte, int32_t *numTempTrampolines)
    *numTempTrampolines = ccSizeInByte>>12;
    }
 
-extern void registerTrampoline(uint8_t *start, uint32_t size, const char *name);
 
 void
 ppcCreateHelperTrampolines(uint8_t *trampPtr, int32_t numHelpers)
@@ -156,7 +155,6 @@ ppcCreateHelperTrampolines(uint8_t *trampPtr, int32_t numHelpers)
          sprintf(name, "unknown helper (trampoline)", helperName);
 
       manager.registerCompiledMethod(name, bufferStart, buffer - bufferStart);
-      registerTrampoline(bufferStart, buffer - bufferStart, name);
       }
 
    ppcCodeSync(trampPtr, config.trampolineCodeSize() * numHelpers);
@@ -187,6 +187,21 @@ TEST(OmrAlgoTest, PoolTestPuddleSharing)
 	ASSERT_EQ(0, testPoolPuddleListSharing(omrTestEnv->getPortLibrary()));
 }
 
+TEST(OmrAlgoTest, PoolTestThreadMagazines)
+{
+	ASSERT_EQ(0, testPoolThreadMagazines(omrTestEnv->getPortLibrary()));
+}
+
+TEST(OmrAlgoTest, PoolTestThreadMagazinesThreadExit)
+{
+	ASSERT_EQ(0, testPoolThreadMagazinesThreadExit(omrTestEnv->getPortLibrary()));
+}
+
+TEST(OmrAlgoTest, PoolTestThreadMagazinesLateExit)
+{
+	ASSERT_EQ(0, testPoolThreadMagazinesLateExit(omrTestEnv->getPortLibrary()));
+}
+
 TEST(OmrAlgoTest, hookabletest)
 {
 	uintptr_t passCount = 0;
@@ -221,8 +236,33 @@ TEST_P(HashtableTest, NoForce)
 	ASSERT_EQ(0, buildAndVerifyHashtable(omrTestEnv->getPortLibrary(), &params)) << "Test verification failed for " << params.hashtableName;
 }
 
+TEST_P(HashtableTest, OpenAddressingForce)
+{
+	HashtableInputData params = GetParam();
+	params.forceCollisions = TRUE;
+	params.collisionResistant = FALSE;
+	params.openAddressing = TRUE;
+
+	ASSERT_EQ(0, buildAndVerifyHashtable(omrTestEnv->getPortLibrary(), &params)) << "Test verification failed for " << params.hashtableName;
+}
+
+TEST_P(HashtableTest, OpenAddressingNoForce)
+{
+	HashtableInputData params = GetParam();
+	params.forceCollisions = FALSE;
+	params.collisionResistant = FALSE;
+	params.openAddressing = TRUE;
+
+	ASSERT_EQ(0, buildAndVerifyHashtable(omrTestEnv->getPortLibrary(), &params)) << "Test verification failed for " << params.hashtableName;
+}
+
 INSTANTIATE_TEST_CASE_P(OmrAlgoTest, HashtableTest, ::testing::ValuesIn(hastableParams));
 
+TEST(OmrAlgoTest, HashtableConcurrentRead)
+{
+	ASSERT_EQ(0, testConcurrentReadHashtable(omrTestEnv->getPortLibrary()));
+}
+
 class CollisionResilientHashtableTest: public ::testing::TestWithParam< ::testing::tuple<HashtableInputData, uint32_t> >
 {
 };
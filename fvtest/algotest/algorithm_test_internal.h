@@ -50,6 +50,7 @@ typedef struct HashtableInputData {
 	uint32_t listToTreeThreshold;
 	BOOLEAN forceCollisions;
 	BOOLEAN collisionResistant;
+	BOOLEAN openAddressing;
 } HashtableInputData;
 
 /* ---------------- avltest.c ---------------- */
@@ -82,6 +83,30 @@ createAndVerifyPool(OMRPortLibrary *portLib, PoolInputData *input);
 int32_t
 testPoolPuddleListSharing(OMRPortLibrary *portLib);
 
+/**
+* @brief
+* @param *portLib
+* @return int32_t
+*/
+int32_t
+testPoolThreadMagazines(OMRPortLibrary *portLib);
+
+/**
+* @brief
+* @param *portLib
+* @return int32_t
+*/
+int32_t
+testPoolThreadMagazinesThreadExit(OMRPortLibrary *portLib);
+
+/**
+* @brief
+* @param *portLib
+* @return int32_t
+*/
+int32_t
+testPoolThreadMagazinesLateExit(OMRPortLibrary *portLib);
+
 /* ---------------- hooktest.c ---------------- */
 
 /**
@@ -110,6 +135,14 @@ verifyHashtable(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCo
 int32_t
 buildAndVerifyHashtable(OMRPortLibrary *portLib, HashtableInputData *inputData);
 
+/**
+* @brief
+* @param *portLib
+* @return int32_t
+*/
+int32_t
+testConcurrentReadHashtable(OMRPortLibrary *portLib);
+
 #ifdef __cplusplus
 }
 #endif
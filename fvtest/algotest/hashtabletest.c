@@ -25,8 +25,10 @@
 #include "avl_api.h"
 #include "hashtable_api.h"
 #include "omrport.h"
+#include "omrthread.h"
 /*
- * Testing the following functions of J9HashTable using the J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION flag:
+ * Testing the following functions of J9HashTable using the J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION
+ * and J9HASH_TABLE_OPEN_ADDRESSING flags:
  * 		hashTableAdd()
  * 		hashTableGetCount()
  * 		hashTableFind()
@@ -216,6 +218,9 @@ allocateHashtable(OMRPortLibrary *portLib, HashtableInputData *inputData)
 				NULL,
 				userData);
 	} else {
+		if (TRUE == inputData->openAddressing) {
+			flags |= J9HASH_TABLE_OPEN_ADDRESSING;
+		}
 		hashtable = hashTableNew(portLib,
 				tableName,
 				tableSize,
@@ -259,3 +264,138 @@ fail:
 	hashTableFree(table);
 	return result;
 }
+
+#define CONCURRENT_READ_STABLE_KEYS 256
+#define CONCURRENT_READ_VOLATILE_KEYS 256
+#define CONCURRENT_READ_WRITER_ROUNDS 2
+#define CONCURRENT_READ_READERS 2
+
+typedef struct ConcurrentReadTestData {
+	J9HashTable *table;
+	omrthread_monitor_t monitor;
+	volatile uintptr_t stop;
+	uintptr_t startedReaders;
+	uintptr_t finishedReaders;
+	uintptr_t failures;
+	uintptr_t lookups;
+} ConcurrentReadTestData;
+
+static int J9THREAD_PROC
+concurrentReadTestReader(void *arg)
+{
+	ConcurrentReadTestData *testData = (ConcurrentReadTestData *)arg;
+	uintptr_t failures = 0;
+	uintptr_t lookups = 0;
+
+	omrthread_monitor_enter(testData->monitor);
+	testData->startedReaders += 1;
+	omrthread_monitor_notify_all(testData->monitor);
+	omrthread_monitor_exit(testData->monitor);
+
+	while (0 == testData->stop) {
+		uintptr_t key = 0;
+		for (key = 1; key <= CONCURRENT_READ_STABLE_KEYS; key++) {
+			uintptr_t *node = hashTableFind(testData->table, &key);
+			if ((NULL == node) || (*node != key)) {
+				failures += 1;
+			}
+			lookups += 1;
+		}
+	}
+
+	omrthread_monitor_enter(testData->monitor);
+	testData->failures += failures;
+	testData->lookups += lookups;
+	testData->finishedReaders += 1;
+	omrthread_monitor_notify_all(testData->monitor);
+	omrthread_monitor_exit(testData->monitor);
+	return 0;
+}
+
+/*
+ * Readers look up a fixed set of keys without locking while the main thread adds and
+ * removes other keys, growing the table several times. Every lookup must succeed.
+ */
+int32_t
+testConcurrentReadHashtable(OMRPortLibrary *portLib)
+{
+	ConcurrentReadTestData testData;
+	uintptr_t key = 0;
+	uintptr_t round = 0;
+	uintptr_t i = 0;
+	uintptr_t readersStarted = 0;
+	int32_t result = 0;
+
+	memset(&testData, 0, sizeof(testData));
+	testData.table = hashTableNew(portLib, OMR_GET_CALLSITE(), 0, sizeof(uintptr_t), sizeof(uintptr_t), J9HASH_TABLE_CONCURRENT_READ, OMRMEM_CATEGORY_VM, hashFn, hashEqualFn, NULL, NULL);
+	if (NULL == testData.table) {
+		return -1;
+	}
+	if (0 != omrthread_monitor_init_with_name(&testData.monitor, 0, "concurrentReadTest")) {
+		hashTableFree(testData.table);
+		return -2;
+	}
+
+	for (key = 1; key <= CONCURRENT_READ_STABLE_KEYS; key++) {
+		if (NULL == hashTableAdd(testData.table, &key)) {
+			result = -3;
+			goto done;
+		}
+	}
+
+	for (i = 0; i < CONCURRENT_READ_READERS; i++) {
+		omrthread_t thread = NULL;
+		if (0 == omrthread_create(&thread, 0, J9THREAD_PRIORITY_NORMAL, 0, concurrentReadTestReader, &testData)) {
+			readersStarted += 1;
+		}
+	}
+	if (0 == readersStarted) {
+		result = -4;
+		goto done;
+	}
+
+	omrthread_monitor_enter(testData.monitor);
+	while (testData.startedReaders < readersStarted) {
+		omrthread_monitor_wait(testData.monitor);
+	}
+	omrthread_monitor_exit(testData.monitor);
+
+	/* yield regularly so that the readers also run on a single CPU */
+	for (round = 0; round < CONCURRENT_READ_WRITER_ROUNDS; round++) {
+		for (key = CONCURRENT_READ_STABLE_KEYS + 1; key <= (CONCURRENT_READ_STABLE_KEYS + CONCURRENT_READ_VOLATILE_KEYS); key++) {
+			if (NULL == hashTableAdd(testData.table, &key)) {
+				result = -5;
+			}
+			if (0 == (key % 16)) {
+				omrthread_yield();
+			}
+		}
+		for (key = CONCURRENT_READ_STABLE_KEYS + 1; key <= (CONCURRENT_READ_STABLE_KEYS + CONCURRENT_READ_VOLATILE_KEYS); key++) {
+			if (0 != hashTableRemove(testData.table, &key)) {
+				result = -6;
+			}
+			if (0 == (key % 16)) {
+				omrthread_yield();
+			}
+		}
+	}
+
+	testData.stop = 1;
+	omrthread_monitor_enter(testData.monitor);
+	while (testData.finishedReaders < readersStarted) {
+		omrthread_monitor_wait(testData.monitor);
+	}
+	omrthread_monitor_exit(testData.monitor);
+
+	if ((0 == result) && (0 != testData.failures)) {
+		result = -7;
+	}
+	if ((0 == result) && (CONCURRENT_READ_STABLE_KEYS != hashTableGetCount(testData.table))) {
+		result = -8;
+	}
+
+done:
+	omrthread_monitor_destroy(testData.monitor);
+	hashTableFree(testData.table);
+	return result;
+}
@@ -21,6 +21,7 @@
 
 #include <string.h>
 #include "omrport.h"
+#include "omrthread.h"
 #include "hookable_api.h"
 #include "hooksample_internal.h"
 
@@ -36,8 +37,23 @@ static void testDispatch(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_
 static uintptr_t testAllocateAgentID(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface);
 static void hookNormalEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData);
 static void hookOrderedEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData);
+static void hookUnregisteringEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData);
+static void hookChurningEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData);
+static void hookBlockingEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData);
+static void testSnapshotReclamation(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface);
+static void testSnapshotReclamationAcrossThreads(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface);
+
+typedef struct BlockingDispatchData {
+	omrthread_monitor_t monitor;
+	uintptr_t inDispatch;
+	uintptr_t leaveDispatch;
+	uintptr_t finished;
+} BlockingDispatchData;
 
 static SampleHookInterface sampleHookInterface;
+static uintptr_t snapshotsKeptDuringDispatch;
+
+#define SNAPSHOT_CHURN_COUNT 100
 
 int32_t
 verifyHookable(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount)
@@ -163,9 +179,145 @@ testHookInterface(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *fail
 	testRegisterWithAgent(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT3, agent2, 3, 0);
 	testDispatch(portLib, passCount, failCount, TESTHOOK_EVENT3, 5);
 
+	/* a listener unregistered by an earlier listener of the same dispatch must not be called */
+	if (0 == (*hookInterface)->J9HookRegister(hookInterface, TESTHOOK_EVENT2 | J9HOOK_TAG_AGENT_ID, hookUnregisteringEvent, NULL, J9HOOK_AGENTID_FIRST)) {
+		(*passCount)++;
+	} else {
+		(*failCount)++;
+	}
+	testRegister(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT2, 0);
+	testDispatch(portLib, passCount, failCount, TESTHOOK_EVENT2, 1);
+	testDispatch(portLib, passCount, failCount, TESTHOOK_EVENT2, 1);
+	(*hookInterface)->J9HookUnregister(hookInterface, TESTHOOK_EVENT2, hookUnregisteringEvent, NULL);
+	testDispatch(portLib, passCount, failCount, TESTHOOK_EVENT2, 0);
+
+	testSnapshotReclamation(portLib, passCount, failCount, hookInterface);
+
 	return rc;
 }
 
+static void
+testSnapshotReclamation(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	J9CommonHookInterface *commonInterface = (J9CommonHookInterface *)hookInterface;
+	uintptr_t i = 0;
+
+	/* with no dispatch in progress, replaced snapshots are freed straight away */
+	for (i = 0; i < SNAPSHOT_CHURN_COUNT; i++) {
+		testRegister(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT4, 0);
+		testUnregister(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT4);
+	}
+	if ((NULL == commonInterface->retiredSnapshots) && (NULL == commonInterface->drainingSnapshots)) {
+		(*passCount)++;
+	} else {
+		omrtty_printf("Replaced hook snapshots were not freed after registration churn.\n");
+		(*failCount)++;
+	}
+
+	/* snapshots replaced while a dispatch is running are kept until it returns */
+	snapshotsKeptDuringDispatch = FALSE;
+	if (0 == (*hookInterface)->J9HookRegister(hookInterface, TESTHOOK_EVENT2, hookChurningEvent, NULL)) {
+		(*passCount)++;
+	} else {
+		(*failCount)++;
+	}
+	testDispatch(portLib, passCount, failCount, TESTHOOK_EVENT2, 1);
+	(*hookInterface)->J9HookUnregister(hookInterface, TESTHOOK_EVENT2, hookChurningEvent, NULL);
+	if (snapshotsKeptDuringDispatch
+		&& (NULL == commonInterface->retiredSnapshots)
+		&& (NULL == commonInterface->drainingSnapshots)
+	) {
+		(*passCount)++;
+	} else {
+		omrtty_printf("Hook snapshots replaced during a dispatch were %s.\n", snapshotsKeptDuringDispatch ? "not freed afterwards" : "freed while in use");
+		(*failCount)++;
+	}
+
+	testSnapshotReclamationAcrossThreads(portLib, passCount, failCount, hookInterface);
+}
+
+static int J9THREAD_PROC
+blockingDispatchThread(void *arg)
+{
+	BlockingDispatchData *data = (BlockingDispatchData *)arg;
+	uintptr_t count = 0;
+
+	TRIGGER_TESTHOOK_EVENT2(sampleHookInterface, 1, count, -1);
+
+	omrthread_monitor_enter(data->monitor);
+	data->finished = TRUE;
+	omrthread_monitor_notify_all(data->monitor);
+	omrthread_monitor_exit(data->monitor);
+	return 0;
+}
+
+/*
+ * Snapshots replaced while another thread is dispatching are kept until that dispatch returns,
+ * and freed by the next registration afterwards.
+ */
+static void
+testSnapshotReclamationAcrossThreads(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	J9CommonHookInterface *commonInterface = (J9CommonHookInterface *)hookInterface;
+	BlockingDispatchData data;
+	omrthread_t thread = NULL;
+	uintptr_t kept = FALSE;
+	uintptr_t i = 0;
+
+	memset(&data, 0, sizeof(data));
+	if (0 != omrthread_monitor_init_with_name(&data.monitor, 0, "hookSnapshotTest")) {
+		omrtty_printf("Could not create the monitor for the cross-thread snapshot test.\n");
+		(*failCount)++;
+		return;
+	}
+	if (0 != (*hookInterface)->J9HookRegister(hookInterface, TESTHOOK_EVENT2, hookBlockingEvent, &data)) {
+		(*failCount)++;
+		omrthread_monitor_destroy(data.monitor);
+		return;
+	}
+	if (0 != omrthread_create(&thread, 0, J9THREAD_PRIORITY_NORMAL, 0, blockingDispatchThread, &data)) {
+		omrtty_printf("Could not start the dispatching thread for the cross-thread snapshot test.\n");
+		(*failCount)++;
+		(*hookInterface)->J9HookUnregister(hookInterface, TESTHOOK_EVENT2, hookBlockingEvent, &data);
+		omrthread_monitor_destroy(data.monitor);
+		return;
+	}
+
+	omrthread_monitor_enter(data.monitor);
+	while (!data.inDispatch) {
+		omrthread_monitor_wait(data.monitor);
+	}
+	omrthread_monitor_exit(data.monitor);
+
+	for (i = 0; i < SNAPSHOT_CHURN_COUNT; i++) {
+		testRegister(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT4, 0);
+		testUnregister(portLib, passCount, failCount, hookInterface, TESTHOOK_EVENT4);
+	}
+	kept = (NULL != commonInterface->retiredSnapshots) || (NULL != commonInterface->drainingSnapshots);
+
+	omrthread_monitor_enter(data.monitor);
+	data.leaveDispatch = TRUE;
+	omrthread_monitor_notify_all(data.monitor);
+	while (!data.finished) {
+		omrthread_monitor_wait(data.monitor);
+	}
+	omrthread_monitor_exit(data.monitor);
+
+	(*hookInterface)->J9HookUnregister(hookInterface, TESTHOOK_EVENT2, hookBlockingEvent, &data);
+	if (kept
+		&& (NULL == commonInterface->retiredSnapshots)
+		&& (NULL == commonInterface->drainingSnapshots)
+	) {
+		(*passCount)++;
+	} else {
+		omrtty_printf("Hook snapshots replaced during another thread's dispatch were %s.\n", kept ? "not freed afterwards" : "freed while in use");
+		(*failCount)++;
+	}
+	omrthread_monitor_destroy(data.monitor);
+}
+
 static void
 testEnabled(OMRPortLibrary *portLib, uintptr_t *passCount, uintptr_t *failCount, J9HookInterface **hookInterface, uintptr_t event, uintptr_t expectedResult)
 {
@@ -369,3 +521,43 @@ hookOrderedEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData
 	}
 
 }
+
+static void
+hookUnregisteringEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData)
+{
+	if (TESTHOOK_EVENT2 == eventNum) {
+		((TestHookEvent2 *)voidEventData)->count += 1;
+	}
+	(*hook)->J9HookUnregister(hook, eventNum, hookNormalEvent, NULL);
+}
+
+static void
+hookBlockingEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData)
+{
+	BlockingDispatchData *data = (BlockingDispatchData *)userData;
+
+	omrthread_monitor_enter(data->monitor);
+	data->inDispatch = TRUE;
+	omrthread_monitor_notify_all(data->monitor);
+	while (!data->leaveDispatch) {
+		omrthread_monitor_wait(data->monitor);
+	}
+	omrthread_monitor_exit(data->monitor);
+}
+
+static void
+hookChurningEvent(J9HookInterface **hook, uintptr_t eventNum, void *voidEventData, void *userData)
+{
+	J9CommonHookInterface *commonInterface = (J9CommonHookInterface *)hook;
+	uintptr_t i = 0;
+
+	if (TESTHOOK_EVENT2 == eventNum) {
+		((TestHookEvent2 *)voidEventData)->count += 1;
+	}
+	for (i = 0; i < SNAPSHOT_CHURN_COUNT; i++) {
+		(*hook)->J9HookRegister(hook, TESTHOOK_EVENT4, hookNormalEvent, NULL);
+		(*hook)->J9HookUnregister(hook, TESTHOOK_EVENT4, hookNormalEvent, NULL);
+	}
+	/* this dispatch still reads the snapshot of TESTHOOK_EVENT2, so the replaced EVENT4 snapshots cannot all be freed */
+	snapshotsKeptDuringDispatch = (NULL != commonInterface->retiredSnapshots) || (NULL != commonInterface->drainingSnapshots);
+}
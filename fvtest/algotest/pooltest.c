@@ -20,7 +20,11 @@
  *******************************************************************************/
 
 #include <string.h>
+#if defined(LINUX) || defined(OSX)
+#include <pthread.h>
+#endif /* defined(LINUX) || defined(OSX) */
 #include "omrport.h"
+#include "omrthread.h"
 #include "omrutil.h"
 #include "pool_api.h"
 #include "algorithm_test_internal.h"
@@ -33,6 +37,11 @@ static int32_t sharedPuddleListReferenceCount = 0;
 
 #define NUM_POOLS_TO_SHARE_PUDDLE_LIST 16
 
+#define MAGAZINE_TEST_ELEMENTS 100
+#define MAGAZINE_TEST_THREADS 4
+#define MAGAZINE_TEST_ITERATIONS 2000
+#define MAGAZINE_TEST_LIVE_ELEMENTS 8
+
 #define FIRST_BYTE_MARKER 1
 #define BYTE_MARKER 2
 #define LAST_BYTE_MARKER 4
@@ -401,3 +410,339 @@ error:
 
 	return result;
 }
+
+typedef struct MagazineTestData {
+	J9Pool *pool;
+	omrthread_monitor_t monitor;
+	uintptr_t finishedThreads;
+	uintptr_t failures;
+} MagazineTestData;
+
+static int J9THREAD_PROC
+magazineTestThread(void *arg)
+{
+	MagazineTestData *testData = (MagazineTestData *)arg;
+	uintptr_t *live[MAGAZINE_TEST_LIVE_ELEMENTS];
+	uintptr_t self = (uintptr_t)live;
+	uintptr_t failures = 0;
+	uintptr_t iteration = 0;
+	uintptr_t i = 0;
+
+	for (iteration = 0; iteration < MAGAZINE_TEST_ITERATIONS; iteration++) {
+		for (i = 0; i < MAGAZINE_TEST_LIVE_ELEMENTS; i++) {
+			live[i] = (uintptr_t *)pool_newElement(testData->pool);
+			if ((NULL == live[i]) || (0 != live[i][0])) {
+				failures += 1;
+				live[i] = NULL;
+			} else {
+				live[i][0] = self;
+			}
+		}
+		if (0 == (iteration % 64)) {
+			omrthread_yield();
+		}
+		for (i = 0; i < MAGAZINE_TEST_LIVE_ELEMENTS; i++) {
+			if (NULL != live[i]) {
+				/* Another thread was handed the same element if the tag changed. */
+				if (self != live[i][0]) {
+					failures += 1;
+				}
+				pool_removeElement(testData->pool, live[i]);
+			}
+		}
+	}
+
+	omrthread_monitor_enter(testData->monitor);
+	testData->failures += failures;
+	testData->finishedThreads += 1;
+	omrthread_monitor_notify_all(testData->monitor);
+	omrthread_monitor_exit(testData->monitor);
+
+	return 0;
+}
+
+int32_t
+testPoolThreadMagazines(OMRPortLibrary *portLib)
+{
+	J9Pool *pool = NULL;
+	void *elements[MAGAZINE_TEST_ELEMENTS];
+	MagazineTestData testData;
+	pool_state state;
+	uintptr_t threadsStarted = 0;
+	uintptr_t walkCount = 0;
+	uintptr_t i = 0;
+	void *element = NULL;
+	int32_t result = 0;
+
+	pool = pool_new(4 * sizeof(uintptr_t), 10, 0, POOL_THREAD_MAGAZINES, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_VM, POOL_FOR_PORT(portLib));
+	if (NULL == pool) {
+		return -1;
+	}
+
+	for (i = 0; i < MAGAZINE_TEST_ELEMENTS; i++) {
+		elements[i] = pool_newElement(pool);
+		if (NULL == elements[i]) {
+			result = -2;
+			goto done;
+		}
+		*(uintptr_t *)elements[i] = i;
+	}
+	if (MAGAZINE_TEST_ELEMENTS != pool_numElements(pool)) {
+		result = -3;
+		goto done;
+	}
+
+	/* Free every other element: the freed ones are cached, and must not be seen by iteration. */
+	for (i = 0; i < MAGAZINE_TEST_ELEMENTS; i += 2) {
+		pool_removeElement(pool, elements[i]);
+		if (pool_includesElement(pool, elements[i])) {
+			result = -4;
+			goto done;
+		}
+	}
+	/* Removing an element twice must be ignored. */
+	pool_removeElement(pool, elements[0]);
+	if ((MAGAZINE_TEST_ELEMENTS / 2) != pool_numElements(pool)) {
+		result = -5;
+		goto done;
+	}
+	element = pool_startDo(pool, &state);
+	while (NULL != element) {
+		if (1 != (*(uintptr_t *)element % 2)) {
+			result = -6;
+			goto done;
+		}
+		walkCount += 1;
+		element = pool_nextDo(&state);
+	}
+	if ((MAGAZINE_TEST_ELEMENTS / 2) != walkCount) {
+		result = -7;
+		goto done;
+	}
+
+	/* Once everything is freed and flushed, only the first puddle remains. */
+	for (i = 1; i < MAGAZINE_TEST_ELEMENTS; i += 2) {
+		pool_removeElement(pool, elements[i]);
+	}
+	pool_flushMagazines(pool);
+	if ((0 != pool_numElements(pool)) || (pool->elementsPerPuddle != pool_capacity(pool))) {
+		result = -8;
+		goto done;
+	}
+
+	/* Clearing the pool discards cached elements. */
+	for (i = 0; i < MAGAZINE_TEST_ELEMENTS; i++) {
+		elements[i] = pool_newElement(pool);
+	}
+	pool_removeElement(pool, elements[0]);
+	pool_clear(pool);
+	if ((0 != pool_numElements(pool)) || (NULL != pool_startDo(pool, &state))) {
+		result = -9;
+		goto done;
+	}
+
+	/* Threads allocate and free concurrently without an external lock. */
+	memset(&testData, 0, sizeof(testData));
+	testData.pool = pool;
+	if (0 != omrthread_monitor_init_with_name(&testData.monitor, 0, "poolMagazineTest")) {
+		result = -10;
+		goto done;
+	}
+	for (i = 0; i < MAGAZINE_TEST_THREADS; i++) {
+		omrthread_t thread = NULL;
+		if (0 == omrthread_create(&thread, 0, J9THREAD_PRIORITY_NORMAL, 0, magazineTestThread, &testData)) {
+			threadsStarted += 1;
+		}
+	}
+	omrthread_monitor_enter(testData.monitor);
+	while (testData.finishedThreads < threadsStarted) {
+		omrthread_monitor_wait(testData.monitor);
+	}
+	omrthread_monitor_exit(testData.monitor);
+	omrthread_monitor_destroy(testData.monitor);
+
+	if ((0 == threadsStarted) || (0 != testData.failures)) {
+		result = -11;
+	} else if (0 != pool_numElements(pool)) {
+		result = -12;
+	}
+
+done:
+	pool_kill(pool);
+	return result;
+}
+
+#define MAGAZINE_EXIT_TEST_ROUNDS 32
+
+static int J9THREAD_PROC
+magazineExitTestThread(void *arg)
+{
+	J9Pool *pool = (J9Pool *)arg;
+	void *live[MAGAZINE_TEST_LIVE_ELEMENTS];
+	uintptr_t i = 0;
+
+	for (i = 0; i < MAGAZINE_TEST_LIVE_ELEMENTS; i++) {
+		live[i] = pool_newElement(pool);
+	}
+	for (i = 0; i < MAGAZINE_TEST_LIVE_ELEMENTS; i++) {
+		if (NULL != live[i]) {
+			pool_removeElement(pool, live[i]);
+		}
+	}
+
+	/* The freed elements stay in this thread's magazine until it terminates. */
+	return 0;
+}
+
+int32_t
+testPoolThreadMagazinesThreadExit(OMRPortLibrary *portLib)
+{
+	J9Pool *pool = NULL;
+	omrthread_attr_t attr = NULL;
+	uintptr_t round = 0;
+	int32_t result = 0;
+
+	pool = pool_new(4 * sizeof(uintptr_t), 10, 0, POOL_THREAD_MAGAZINES, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_VM, POOL_FOR_PORT(portLib));
+	if (NULL == pool) {
+		return -1;
+	}
+	if ((J9THREAD_SUCCESS != omrthread_attr_init(&attr))
+		|| (J9THREAD_SUCCESS != omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE))
+	) {
+		result = -2;
+		goto done;
+	}
+
+	/* Short-lived threads one after another must not leave magazines, or elements in them, behind. */
+	for (round = 0; round < MAGAZINE_EXIT_TEST_ROUNDS; round++) {
+		omrthread_t thread = NULL;
+		J9PoolMagazine *magazine = NULL;
+		uintptr_t magazines = 0;
+
+		if (J9THREAD_SUCCESS != omrthread_create_ex(&thread, &attr, 0, magazineExitTestThread, pool)) {
+			result = -3;
+			goto done;
+		}
+		if (J9THREAD_SUCCESS != omrthread_join(thread)) {
+			result = -4;
+			goto done;
+		}
+
+		for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+			magazines += 1;
+			if ((0 != magazine->owner) || (0 != magazine->count)) {
+				result = -5;
+				goto done;
+			}
+		}
+		if (1 != magazines) {
+			result = -6;
+			goto done;
+		}
+	}
+
+	/* Nothing was flushed explicitly, yet every puddle but the first has been released. */
+	if ((0 != pool_numElements(pool)) || (pool->elementsPerPuddle != pool_capacity(pool))) {
+		result = -7;
+	}
+
+done:
+	if (NULL != attr) {
+		omrthread_attr_destroy(&attr);
+	}
+	pool_kill(pool);
+	return result;
+}
+
+#if defined(LINUX) || defined(OSX)
+static pthread_key_t magazineLateExitKey;
+
+static void
+magazineLateExitDestructor(void *arg)
+{
+	J9Pool *pool = (J9Pool *)arg;
+	void *element = pool_newElement(pool);
+
+	/* Runs after the pool's own thread exit destructor has given the magazines away. */
+	if (NULL != element) {
+		pool_removeElement(pool, element);
+	}
+}
+
+static int J9THREAD_PROC
+magazineLateExitTestThread(void *arg)
+{
+	magazineExitTestThread(arg);
+	pthread_setspecific(magazineLateExitKey, arg);
+	return 0;
+}
+#endif /* defined(LINUX) || defined(OSX) */
+
+int32_t
+testPoolThreadMagazinesLateExit(OMRPortLibrary *portLib)
+{
+	int32_t result = 0;
+#if defined(LINUX) || defined(OSX)
+	J9Pool *armingPool = NULL;
+	J9Pool *pool = NULL;
+	omrthread_attr_t attr = NULL;
+	omrthread_t thread = NULL;
+	J9PoolMagazine *magazine = NULL;
+	void *element = NULL;
+
+	armingPool = pool_new(4 * sizeof(uintptr_t), 10, 0, POOL_THREAD_MAGAZINES, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_VM, POOL_FOR_PORT(portLib));
+	pool = pool_new(4 * sizeof(uintptr_t), 10, 0, POOL_THREAD_MAGAZINES, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_VM, POOL_FOR_PORT(portLib));
+	if ((NULL == armingPool) || (NULL == pool)) {
+		result = -1;
+		goto done;
+	}
+
+	/* Create the pool's thread exit key first, so that its destructor runs before the one below. */
+	element = pool_newElement(armingPool);
+	if (NULL != element) {
+		pool_removeElement(armingPool, element);
+	}
+	if (0 != pthread_key_create(&magazineLateExitKey, magazineLateExitDestructor)) {
+		result = -2;
+		goto done;
+	}
+
+	if ((J9THREAD_SUCCESS != omrthread_attr_init(&attr))
+		|| (J9THREAD_SUCCESS != omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE))
+	) {
+		result = -3;
+		goto deleteKey;
+	}
+	if ((J9THREAD_SUCCESS != omrthread_create_ex(&thread, &attr, 0, magazineLateExitTestThread, pool))
+		|| (J9THREAD_SUCCESS != omrthread_join(thread))
+	) {
+		result = -4;
+		goto deleteKey;
+	}
+
+	/* The late destructor must have claimed a magazine of its own, and given it back in turn. */
+	for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+		if ((0 != magazine->owner) || (0 != magazine->count)) {
+			result = -5;
+			break;
+		}
+	}
+	if ((0 == result) && (0 != pool_numElements(pool))) {
+		result = -6;
+	}
+
+deleteKey:
+	pthread_key_delete(magazineLateExitKey);
+done:
+	if (NULL != attr) {
+		omrthread_attr_destroy(&attr);
+	}
+	if (NULL != pool) {
+		pool_kill(pool);
+	}
+	if (NULL != armingPool) {
+		pool_kill(armingPool);
+	}
+#endif /* defined(LINUX) || defined(OSX) */
+	return result;
+}
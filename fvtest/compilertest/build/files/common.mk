@@ -31,6 +31,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/infra/BitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Checklist.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/HashTab.cpp \
+    $(JIT_OMR_DIRTY_DIR)/infra/HybridBitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/STLUtils.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/IGBase.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/IGNode.cpp \
@@ -65,6 +66,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/il/OMRSymbolReference.cpp \
     $(JIT_OMR_DIRTY_DIR)/il/Aliases.cpp \
     $(JIT_OMR_DIRTY_DIR)/compile/OMRCompilation.cpp \
+    $(JIT_OMR_DIRTY_DIR)/compile/CompilationBudget.cpp \
     $(JIT_OMR_DIRTY_DIR)/compile/TLSCompilationManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRCPU.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRObjectModel.cpp \
@@ -76,6 +78,9 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/SegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentAllocator.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentProvider.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentCache.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/PassProfile.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/RegionProfiler.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/DebugSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/Region.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/StackMemoryRegion.cpp \
@@ -225,16 +230,23 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_PRODUCT_DIR)/tests/injectors/FooIlInjector.cpp \
     $(JIT_PRODUCT_DIR)/tests/injectors/Qux2IlInjector.cpp \
     $(JIT_PRODUCT_DIR)/tests/BuilderTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/CompilationBudgetTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/FooBarTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/HybridBitVectorTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/LimitFileTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/LogFileTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/OMRTestEnv.cpp \
     $(JIT_PRODUCT_DIR)/tests/OptionSetTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/PassProfileTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/PerfToolWriterTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/PersistentAllocatorTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/OpCodesTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/PPCOpCodesTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/Qux2Test.cpp \
     $(JIT_PRODUCT_DIR)/tests/SimplifierFoldAndTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/SingleBitContainerTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/SystemSegmentCacheTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/WorklistDataFlowTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/S390OpCodesTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/OptTestDriver.cpp \
     $(JIT_PRODUCT_DIR)/tests/TestDriver.cpp \
@@ -275,6 +287,8 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheMemorySegment.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheConfig.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/PersistentCodeCache.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/PerfToolWriter.cpp \
     $(JIT_PRODUCT_DIR)/compile/Method.cpp \
     $(JIT_PRODUCT_DIR)/control/TestJit.cpp \
     $(JIT_PRODUCT_DIR)/env/FrontEnd.cpp \
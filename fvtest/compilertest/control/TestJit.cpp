@@ -203,6 +203,8 @@ shutdownJit()
 
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
    codeCacheManager.destroy();
+
+   commonJitShutdown(*fe);
    }
 
 extern "C"
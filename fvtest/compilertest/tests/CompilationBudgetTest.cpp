@@ -0,0 +1,365 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "compile/CompilationBudget.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <new>
+#include <string>
+#include "gtest/gtest.h"
+#include "compile/Compilation.hpp"
+#include "compile/Method.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/DebugSegmentProvider.hpp"
+#include "env/PassProfile.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
+#include "ilgen/IlInjector.hpp"
+#include "ilgen/MethodInfo.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "OptTestDriver.hpp"
+#include "ras/IlVerifier.hpp"
+
+namespace TestCompiler
+{
+
+static const size_t budgetSegmentSize = 1 << 16;
+static const char *budgetProfileFileName = "compilationBudgetTest.json";
+
+/**
+ * A provider hands out segments up to its allocation limit and throws
+ * std::bad_alloc beyond it, including once the limit has been lowered below
+ * what is already in use.
+ */
+static void
+checkAllocationLimit(TR::SegmentAllocator &provider)
+   {
+   provider.setAllocationLimit(2 * budgetSegmentSize);
+   TR::MemorySegment &first = provider.request(budgetSegmentSize);
+   EXPECT_THROW(provider.request(2 * budgetSegmentSize), std::bad_alloc);
+   TR::MemorySegment &second = provider.request(budgetSegmentSize);
+   EXPECT_THROW(provider.request(1), std::bad_alloc);
+   provider.release(second);
+
+   provider.setAllocationLimit(budgetSegmentSize / 2);
+   EXPECT_THROW(provider.request(1), std::bad_alloc);
+   provider.release(first);
+   }
+
+TEST(ScratchSegmentLimitTest, SystemSegmentProviderRefusesPastLimit)
+   {
+   TR::RawAllocator rawAllocator;
+   TR::SystemSegmentProvider provider(budgetSegmentSize, rawAllocator);
+   checkAllocationLimit(provider);
+   }
+
+TEST(ScratchSegmentLimitTest, DebugSegmentProviderRefusesPastLimit)
+   {
+   TR::RawAllocator rawAllocator;
+   TR::DebugSegmentProvider provider(budgetSegmentSize, rawAllocator);
+   checkAllocationLimit(provider);
+   }
+
+/* How the injector runs down the compilation's budget before the optimizer starts */
+enum BudgetPressure
+   {
+   NoPressure,
+   LowMemory,      // scratch memory in use until the budget is low
+   OutOfTime,      // wait until the time budget is exhausted
+   PastScratchLimit // allocate scratch memory until a request is refused
+   };
+
+/* Sums 0 <= i < n in a loop, after spending the compilation's budget. */
+class BudgetLoopIlInjector : public TR::IlInjector
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::IlGenerator)
+
+   BudgetLoopIlInjector(TR::TypeDictionary *types, TestDriver *test, BudgetPressure pressure)
+   :
+      TR::IlInjector(types, test),
+      _pressure(pressure),
+      _limitIgnored(false)
+      {
+      }
+
+   bool limitIgnored() const { return _limitIgnored; }
+
+   bool injectIL()
+      {
+      spendBudget();
+
+      createBlocks(4);
+
+      TR::SymbolReference *i = newTemp(Int32);
+      TR::SymbolReference *sum = newTemp(Int32);
+
+      // Block0: i = 0; sum = 0;
+      storeToTemp(i, iconst(0));
+      storeToTemp(sum, iconst(0));
+      generateFallThrough();
+
+      // Block1: if (i >= n) goto Block3;
+      ifjump(TR::ificmpge, loadTemp(i), parameter(0, Int32), 3);
+
+      // Block2: sum += i; i++; goto Block1;
+      storeToTemp(sum, createWithoutSymRef(TR::iadd, 2, loadTemp(sum), loadTemp(i)));
+      storeToTemp(i, createWithoutSymRef(TR::iadd, 2, loadTemp(i), iconst(1)));
+      branchToBlock(1);
+
+      // Block3: return sum;
+      generateToBlock(3);
+      returnValue(loadTemp(sum));
+
+      return true;
+      }
+
+   private:
+
+   void spendBudget()
+      {
+      TR::CompilationBudget *budget = comp()->getBudget();
+      switch (_pressure)
+         {
+         case LowMemory:
+            while (budget->update() == TR::CompilationBudget::Available)
+               comp()->trMemory()->allocateHeapMemory(budgetSegmentSize);
+            break;
+         case OutOfTime:
+            while (budget->update() != TR::CompilationBudget::Exhausted)
+               ;
+            break;
+         case PastScratchLimit:
+            {
+            // Give up, failing the test rather than the machine, if the limit is not enforced
+            size_t allocated = 0;
+            while (allocated <= 2 * comp()->getScratchSpaceLimit())
+               {
+               comp()->trMemory()->allocateHeapMemory(budgetSegmentSize);
+               allocated += budgetSegmentSize;
+               }
+            _limitIgnored = true;
+            break;
+            }
+         default:
+            break;
+         }
+      }
+
+   BudgetPressure _pressure;
+   bool _limitIgnored;
+   };
+
+class BudgetLoopInfo : public TestCompiler::MethodInfo
+   {
+   public:
+   BudgetLoopInfo(TestDriver *test, BudgetPressure pressure)
+   :
+      _ilInjector(&_types, test, pressure)
+      {
+      TR::IlType* Int32 = _types.PrimitiveType(TR::Int32);
+      _args[0] = Int32;
+      DefineFunction(__FILE__, LINETOSTR(__LINE__), "budgetLoop", 1, _args, Int32);
+      DefineILInjector(&_ilInjector);
+      }
+
+   bool limitIgnored() const { return _ilInjector.limitIgnored(); }
+
+   typedef int32_t (*MethodType)(int32_t);
+
+   private:
+   TR::TypeDictionary _types;
+   TestCompiler::BudgetLoopIlInjector _ilInjector;
+   TR::IlType *_args[1];
+   };
+
+/* Records where the optimizer left the opt index and the budget. */
+class BudgetIlVerifier : public TR::IlVerifier
+   {
+   public:
+   BudgetIlVerifier() : _optIndex(-1), _state(TR::CompilationBudget::Available) {}
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      TR::Compilation *comp = sym->comp();
+      _optIndex = comp->getOptIndex();
+      if (comp->getBudget())
+         _state = comp->getBudget()->state();
+      return 0;
+      }
+
+   int32_t _optIndex;
+   TR::CompilationBudget::State _state;
+   };
+
+static const OptimizationStrategy budgetStrategy[] =
+   {
+   { OMR::globalValuePropagation,       OMR::Always },
+   { OMR::partialRedundancyElimination, OMR::Always },
+   { OMR::loopVersioner,                OMR::Always },
+   { OMR::treeSimplification,           OMR::Always },
+   { OMR::endOpts }
+   };
+
+class CompilationBudgetTest : public OptTestDriver
+   {
+   public:
+   CompilationBudgetTest() : _scratchSpaceLimit(0)
+      {
+      addOptimizations(budgetStrategy);
+      }
+
+   void invokeTests()
+      {
+      auto testCompiledMethod = getCompiledMethod<BudgetLoopInfo::MethodType>();
+      ASSERT_EQ(0, testCompiledMethod(0));
+      ASSERT_EQ(45, testCompiledMethod(10));
+      }
+
+   /**
+    * Compile \p info with its budget run down as it asks, and return the
+    * pass profile of the compilation.
+    */
+   std::string compileProfiled(BudgetLoopInfo &info, BudgetIlVerifier &ilVer)
+      {
+      setMethodInfo(&info);
+      setIlVerifier(&ilVer);
+      TR::PassProfile::initialize(budgetProfileFileName);
+      VerifyAndInvoke();
+      TR::PassProfile::shutdown();
+
+      std::string text;
+      FILE *file = fopen(budgetProfileFileName, "r");
+      if (NULL == file)
+         return text;
+      char buffer[4096];
+      size_t bytesRead;
+      while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+         text.append(buffer, bytesRead);
+      fclose(file);
+      remove(budgetProfileFileName);
+      return text;
+      }
+
+   static bool ran(const std::string &profile, OMR::Optimizations opt)
+      {
+      std::string key = std::string("{\"name\": \"opt/warm/") + TR::Optimizer::getOptimizationName(opt) + "\",";
+      return std::string::npos != profile.find(key);
+      }
+
+   protected:
+   virtual void SetUp()
+      {
+      ASSERT_TRUE(NULL == TR::PassProfile::instance()) << "the JIT must not have been started with a pass profile";
+      _scratchSpaceLimit = TR::Options::getScratchSpaceLimit();
+      remove(budgetProfileFileName);
+      }
+
+   virtual void TearDown()
+      {
+      TR::PassProfile::shutdown();
+      remove(budgetProfileFileName);
+      TR::Options::setScratchSpaceLimit(_scratchSpaceLimit);
+      TR::Options::getCmdLineOptions()->setCompilationTimeBudget(0);
+      }
+
+   size_t _scratchSpaceLimit;
+   };
+
+/* Once its budget runs low, a compilation skips PRE and the loop versioner and
+ * does value propagation locally, under the opt index global value propagation
+ * would have had.
+ */
+TEST_F(CompilationBudgetTest, LowBudgetScalesBackOptimizations)
+   {
+   TR::Options::setScratchSpaceLimit(32 * 1024 * 1024);
+
+   BudgetLoopInfo baselineInfo(this, NoPressure);
+   BudgetIlVerifier baselineVerifier;
+   std::string baseline = compileProfiled(baselineInfo, baselineVerifier);
+   ASSERT_EQ(TR::CompilationBudget::Available, baselineVerifier._state);
+   EXPECT_TRUE(ran(baseline, OMR::globalValuePropagation)) << baseline;
+   EXPECT_TRUE(ran(baseline, OMR::partialRedundancyElimination)) << baseline;
+   EXPECT_TRUE(ran(baseline, OMR::loopVersioner)) << baseline;
+   EXPECT_FALSE(ran(baseline, OMR::localValuePropagation)) << baseline;
+
+   BudgetLoopInfo lowInfo(this, LowMemory);
+   BudgetIlVerifier lowVerifier;
+   std::string low = compileProfiled(lowInfo, lowVerifier);
+   ASSERT_EQ(TR::CompilationBudget::Low, lowVerifier._state);
+   EXPECT_FALSE(ran(low, OMR::globalValuePropagation)) << low;
+   EXPECT_TRUE(ran(low, OMR::localValuePropagation)) << low;
+   EXPECT_FALSE(ran(low, OMR::partialRedundancyElimination)) << low;
+   EXPECT_FALSE(ran(low, OMR::loopVersioner)) << low;
+   EXPECT_TRUE(ran(low, OMR::treeSimplification)) << low;
+   EXPECT_EQ(baselineVerifier._optIndex, lowVerifier._optIndex);
+   }
+
+/* An exhausted budget skips every optimization that need not be done, but
+ * still counts each one.
+ */
+TEST_F(CompilationBudgetTest, ExhaustedBudgetSkipsOptionalOptimizations)
+   {
+   BudgetLoopInfo baselineInfo(this, NoPressure);
+   BudgetIlVerifier baselineVerifier;
+   compileProfiled(baselineInfo, baselineVerifier);
+
+   TR::Options::getCmdLineOptions()->setCompilationTimeBudget(1);
+   BudgetLoopInfo exhaustedInfo(this, OutOfTime);
+   BudgetIlVerifier exhaustedVerifier;
+   std::string exhausted = compileProfiled(exhaustedInfo, exhaustedVerifier);
+   ASSERT_EQ(TR::CompilationBudget::Exhausted, exhaustedVerifier._state);
+   for (const OptimizationStrategy *opt = budgetStrategy; opt->_num != OMR::endOpts; ++opt)
+      EXPECT_FALSE(ran(exhausted, opt->_num)) << exhausted;
+   EXPECT_FALSE(ran(exhausted, OMR::localValuePropagation)) << exhausted;
+   EXPECT_EQ(baselineVerifier._optIndex, exhaustedVerifier._optIndex);
+   }
+
+/* Scratch memory past the limit fails the compilation, and leaves nothing
+ * behind to stop the next one.
+ */
+TEST_F(CompilationBudgetTest, CompilationPastScratchLimitFails)
+   {
+   TR::Options::setScratchSpaceLimit(4 * 1024 * 1024);
+
+   BudgetLoopInfo failingInfo(this, PastScratchLimit);
+   TR::ResolvedMethod resolvedMethod = failingInfo.ResolvedMethod();
+   TR::IlGeneratorMethodDetails details(&resolvedMethod);
+   int32_t rc = 0;
+   uint8_t *entry = compileMethod(details, warm, rc);
+   ASSERT_FALSE(failingInfo.limitIgnored()) << "scratch memory was not limited";
+   EXPECT_TRUE(NULL == entry);
+   EXPECT_NE(COMPILATION_SUCCEEDED, rc);
+   EXPECT_TRUE(NULL == TR::comp());
+
+   BudgetLoopInfo info(this, NoPressure);
+   BudgetIlVerifier ilVer;
+   compileProfiled(info, ilVer);
+   }
+
+}
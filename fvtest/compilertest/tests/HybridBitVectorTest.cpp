@@ -0,0 +1,494 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/HybridBitVector.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "compile/Compilation.hpp"
+#include "compile/Method.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
+#include "ilgen/IlInjector.hpp"
+#include "ilgen/MethodInfo.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "optimizer/DataFlowAnalysis.hpp"
+#include "optimizer/StructuralAnalysis.hpp"
+#include "ras/IlVerifier.hpp"
+#include "gtest/gtest.h"
+#include "OptTestDriver.hpp"
+
+namespace {
+
+// Spans four chunks so that chunk insertion and removal are exercised
+const int32_t UNIVERSE = 4 * TR_HybridBitVector::ChunkBits;
+
+// Deterministic generator so that failures reproduce
+class Random {
+	public:
+	Random(uint32_t seed) : _state(seed) {}
+	uint32_t next(uint32_t bound) {
+		_state = _state * 1103515245u + 12345u;
+		return (_state >> 8) % bound;
+	}
+	private:
+	uint32_t _state;
+};
+
+class HybridBitVectorTest : public :: testing :: Test {
+
+	protected:
+		TR::RawAllocator rawAllocator;
+		TR::SystemSegmentProvider segmentProvider;
+		TR::Region region;
+		TR_BitVector *scratch;
+
+	HybridBitVectorTest() : segmentProvider(1 << 16, rawAllocator), region(segmentProvider, rawAllocator) {}
+
+	virtual void SetUp() {
+		scratch = new (region) TR_BitVector(UNIVERSE, region);
+	}
+
+	// Check a hybrid vector against the dense vector holding the same bits
+	void expectSame(TR_HybridBitVector &hybrid, TR_BitVector &dense, const char *operation) {
+		*scratch = hybrid;
+		ASSERT_TRUE(*scratch == dense) << "contents differ after " << operation;
+		ASSERT_EQ(dense.elementCount(), hybrid.elementCount()) << "count differs after " << operation;
+		ASSERT_EQ(dense.isEmpty(), hybrid.isEmpty()) << operation;
+		ASSERT_EQ(dense.hasMoreThanOneElement(), hybrid.hasMoreThanOneElement()) << operation;
+	}
+
+	// Fill a pair of vectors with bits whose density varies by chunk
+	void fill(Random &random, TR_HybridBitVector &hybrid, TR_BitVector &dense) {
+		static const uint32_t densities[] = { 0, 2, 40, 300, 2000, 6000, 30000 };
+		hybrid.empty();
+		dense.empty();
+		for (int32_t base = 0; base < UNIVERSE; base += TR_HybridBitVector::ChunkBits) {
+			uint32_t count = densities[random.next(sizeof(densities) / sizeof(densities[0]))];
+			for (uint32_t i = 0; i < count; i++) {
+				int32_t bit = base + random.next(TR_HybridBitVector::ChunkBits);
+				hybrid.set(bit);
+				dense.set(bit);
+			}
+		}
+	}
+};
+
+TEST_F(HybridBitVectorTest, SetAndReset) {
+	TR_HybridBitVector hybrid(UNIVERSE, region);
+	TR_BitVector dense(UNIVERSE, region);
+
+	ASSERT_TRUE(hybrid.isEmpty());
+	ASSERT_EQ(hybrid.get(12345), 0);
+
+	// Grow one chunk past the array limit so that it becomes a bitmap
+	for (int32_t i = 0; i < 2 * TR_HybridBitVector::ArrayLimit; i++) {
+		hybrid.set(TR_HybridBitVector::ChunkBits + 3 * i);
+		dense.set(TR_HybridBitVector::ChunkBits + 3 * i);
+	}
+	hybrid.set(7);
+	dense.set(7);
+	expectSame(hybrid, dense, "set");
+	ASSERT_TRUE(hybrid.isSet(TR_HybridBitVector::ChunkBits + 3));
+	ASSERT_FALSE(hybrid.isSet(TR_HybridBitVector::ChunkBits + 4));
+
+	// And shrink it back to an array and then to nothing
+	for (int32_t i = 0; i < 2 * TR_HybridBitVector::ArrayLimit; i++) {
+		hybrid.reset(TR_HybridBitVector::ChunkBits + 3 * i);
+		dense.reset(TR_HybridBitVector::ChunkBits + 3 * i);
+		if (i % 1000 == 0)
+			expectSame(hybrid, dense, "reset");
+	}
+	expectSame(hybrid, dense, "reset");
+	ASSERT_EQ(hybrid.elementCount(), 1);
+
+	hybrid.reset(7);
+	ASSERT_TRUE(hybrid.isEmpty());
+}
+
+TEST_F(HybridBitVectorTest, Ranges) {
+	TR_HybridBitVector hybrid(UNIVERSE, region);
+	TR_BitVector dense(UNIVERSE, region);
+
+	hybrid.setAll(100);
+	dense.setAll(100);
+	expectSame(hybrid, dense, "setAll(n)");
+
+	hybrid.setAll(TR_HybridBitVector::ChunkBits - 10, 2 * TR_HybridBitVector::ChunkBits + 5000);
+	dense.setAll(TR_HybridBitVector::ChunkBits - 10, 2 * TR_HybridBitVector::ChunkBits + 5000);
+	expectSame(hybrid, dense, "setAll(m, n)");
+
+	hybrid.resetAll(50, TR_HybridBitVector::ChunkBits + 63);
+	dense.resetAll(50, TR_HybridBitVector::ChunkBits + 63);
+	expectSame(hybrid, dense, "resetAll(m, n)");
+
+	hybrid.resetAll(2 * TR_HybridBitVector::ChunkBits + 1000, 2 * TR_HybridBitVector::ChunkBits + 4999);
+	dense.resetAll(2 * TR_HybridBitVector::ChunkBits + 1000, 2 * TR_HybridBitVector::ChunkBits + 4999);
+	expectSame(hybrid, dense, "resetAll(m, n)");
+
+	hybrid.setAll(UNIVERSE);
+	ASSERT_EQ(hybrid.elementCount(), UNIVERSE);
+	hybrid.resetAll(0, UNIVERSE - 1);
+	ASSERT_TRUE(hybrid.isEmpty());
+}
+
+TEST_F(HybridBitVectorTest, CursorAndConversion) {
+	TR_HybridBitVector hybrid(UNIVERSE, region);
+	TR_BitVector dense(UNIVERSE, region);
+	Random random(7);
+	fill(random, hybrid, dense);
+
+	int32_t count = 0;
+	int32_t previous = -1;
+	TR_HybridBitVector::Cursor cursor(hybrid);
+	for (cursor.SetToFirstOne(); cursor.Valid(); cursor.SetToNextOne()) {
+		int32_t bit = (uint32_t)cursor;
+		ASSERT_LT(previous, bit);
+		ASSERT_TRUE(dense.isSet(bit));
+		previous = bit;
+		count++;
+	}
+	ASSERT_EQ(count, dense.elementCount());
+
+	TR_HybridBitVector converted(region);
+	converted = dense;
+	ASSERT_TRUE(converted == hybrid);
+}
+
+TEST_F(HybridBitVectorTest, OperationsMatchDenseVectors) {
+	const int32_t numVectors = 4;
+	Random random(2026);
+	TR_HybridBitVector *hybrid[numVectors];
+	TR_BitVector *dense[numVectors];
+	for (int32_t i = 0; i < numVectors; i++) {
+		hybrid[i] = new (region) TR_HybridBitVector(UNIVERSE, region);
+		dense[i] = new (region) TR_BitVector(UNIVERSE, region);
+		fill(random, *hybrid[i], *dense[i]);
+	}
+
+	for (int32_t step = 0; step < 600; step++) {
+		int32_t a = random.next(numVectors);
+		int32_t b = random.next(numVectors);
+		const char *operation = NULL;
+		switch (random.next(9)) {
+			case 0:
+				operation = "|=";
+				*hybrid[a] |= *hybrid[b];
+				*dense[a] |= *dense[b];
+				break;
+			case 1:
+				operation = "&=";
+				*hybrid[a] &= *hybrid[b];
+				*dense[a] &= *dense[b];
+				break;
+			case 2:
+				operation = "-=";
+				*hybrid[a] -= *hybrid[b];
+				*dense[a] -= *dense[b];
+				break;
+			case 3:
+				operation = "=";
+				*hybrid[a] = *hybrid[b];
+				*dense[a] = *dense[b];
+				break;
+			case 4: {
+				operation = "setAll";
+				int32_t first = random.next(UNIVERSE);
+				int32_t last = first + random.next(UNIVERSE - first);
+				hybrid[a]->setAll(first, last);
+				dense[a]->setAll(first, last);
+				break;
+			}
+			case 5: {
+				operation = "resetAll";
+				int32_t first = random.next(UNIVERSE);
+				int32_t last = first + random.next(UNIVERSE - first);
+				hybrid[a]->resetAll(first, last);
+				dense[a]->resetAll(first, last);
+				break;
+			}
+			case 6:
+				operation = "empty";
+				hybrid[a]->empty();
+				dense[a]->empty();
+				break;
+			default:
+				operation = "fill";
+				fill(random, *hybrid[a], *dense[a]);
+				break;
+		}
+
+		expectSame(*hybrid[a], *dense[a], operation);
+		ASSERT_EQ(dense[a]->intersects(*dense[b]), hybrid[a]->intersects(*hybrid[b])) << "intersects after " << operation;
+		ASSERT_EQ(*dense[a] == *dense[b], *hybrid[a] == *hybrid[b]) << "== after " << operation;
+		for (int32_t probe = 0; probe < 16; probe++) {
+			int32_t bit = random.next(UNIVERSE);
+			ASSERT_EQ(dense[a]->get(bit) != 0, hybrid[a]->get(bit) != 0) << "get after " << operation;
+		}
+	}
+}
+
+// A synthetic liveness problem shaped like a very large method: tens of
+// thousands of temporaries, each live over a short stretch of blocks, and a
+// few loops.  Each block is described by the symbols it uses before defining
+// them and the symbols it defines.
+class LivenessProblem {
+	public:
+	static const int32_t numBlocks = 2000;
+	static const int32_t defsPerBlock = 15;
+	static const int32_t usesPerBlock = 10;
+	static const int32_t numSymbols = numBlocks * defsPerBlock;
+
+	LivenessProblem() {
+		Random random(49);
+		for (int32_t b = 0; b < numBlocks; b++) {
+			// Uses of temporaries defined in the preceding few blocks, and of
+			// the values defined on entry.  Every fourth block is a diamond whose
+			// arm is skipped by an edge from the block before it, so values
+			// defined on the arm are not used past it.
+			for (int32_t u = 0; u < usesPerBlock; u++) {
+				int32_t from = b - 1 - (int32_t)random.next(3);
+				if (from < 0 || u == 0) {
+					_uses[b][u] = random.next(defsPerBlock);
+				} else {
+					if (from % 4 == 1)
+						from--;
+					_uses[b][u] = from * defsPerBlock + random.next(defsPerBlock);
+				}
+			}
+
+			_numSuccessors[b] = 0;
+			if (b + 1 < numBlocks)
+				_successors[b][_numSuccessors[b]++] = b + 1;
+			if (b + 2 < numBlocks && b % 4 == 0)
+				_successors[b][_numSuccessors[b]++] = b + 2;
+			if (b % 50 == 49)
+				_successors[b][_numSuccessors[b]++] = b - 40;
+		}
+	}
+
+	// Solve backward liveness to a fixed point and return the number of passes
+	template <class Set>
+	int32_t solve(TR::Region &region, Set **liveIn) {
+		Set **gen = (Set **)region.allocate(numBlocks * sizeof(Set *));
+		Set **kill = (Set **)region.allocate(numBlocks * sizeof(Set *));
+		for (int32_t b = 0; b < numBlocks; b++) {
+			gen[b] = new (region) Set(numSymbols, region);
+			kill[b] = new (region) Set(numSymbols, region);
+			liveIn[b] = new (region) Set(numSymbols, region);
+			for (int32_t u = 0; u < usesPerBlock; u++)
+				gen[b]->set(_uses[b][u]);
+			kill[b]->setAll(b * defsPerBlock, (b + 1) * defsPerBlock - 1);
+		}
+
+		Set liveOut(numSymbols, region);
+		Set newIn(numSymbols, region);
+		int32_t passes = 0;
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			passes++;
+			for (int32_t b = numBlocks - 1; b >= 0; b--) {
+				liveOut.empty();
+				for (int32_t s = 0; s < _numSuccessors[b]; s++)
+					liveOut |= *liveIn[_successors[b][s]];
+				liveOut -= *kill[b];
+				newIn = liveOut;
+				newIn |= *gen[b];
+				if (!(newIn == *liveIn[b])) {
+					*liveIn[b] = newIn;
+					changed = true;
+				}
+			}
+		}
+		return passes;
+	}
+
+	private:
+	int32_t _uses[numBlocks][usesPerBlock];
+	int32_t _successors[numBlocks][3];
+	int32_t _numSuccessors[numBlocks];
+};
+
+template <class Set>
+static double
+solveAndMeasure(LivenessProblem &problem, TR::Region &region, Set **liveIn, int32_t &passes) {
+	clock_t start = clock();
+	passes = problem.solve(region, liveIn);
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+TEST(HybridBitVectorBenchmark, LargeMethodLiveness) {
+	TR::RawAllocator rawAllocator;
+	LivenessProblem *problem = new LivenessProblem();
+
+	TR::SystemSegmentProvider denseSegments(1 << 16, rawAllocator);
+	TR::Region denseRegion(denseSegments, rawAllocator);
+	TR_BitVector **denseIn = (TR_BitVector **)denseRegion.allocate(LivenessProblem::numBlocks * sizeof(TR_BitVector *));
+	int32_t densePasses = 0;
+	double denseMillis = solveAndMeasure(*problem, denseRegion, denseIn, densePasses);
+
+	TR::SystemSegmentProvider hybridSegments(1 << 16, rawAllocator);
+	TR::Region hybridRegion(hybridSegments, rawAllocator);
+	TR_HybridBitVector **hybridIn = (TR_HybridBitVector **)hybridRegion.allocate(LivenessProblem::numBlocks * sizeof(TR_HybridBitVector *));
+	int32_t hybridPasses = 0;
+	double hybridMillis = solveAndMeasure(*problem, hybridRegion, hybridIn, hybridPasses);
+
+	ASSERT_EQ(densePasses, hybridPasses);
+	int64_t liveBits = 0;
+	TR_BitVector converted(LivenessProblem::numSymbols, denseRegion);
+	for (int32_t b = 0; b < LivenessProblem::numBlocks; b++) {
+		converted = *hybridIn[b];
+		ASSERT_TRUE(converted == *denseIn[b]) << "live-in sets differ at block " << b;
+		liveBits += hybridIn[b]->elementCount();
+	}
+
+	printf("%d blocks, %d symbols, %.1f live on entry per block, %d passes\n",
+		LivenessProblem::numBlocks, LivenessProblem::numSymbols, (double)liveBits / LivenessProblem::numBlocks, densePasses);
+	printf("  dense:  %8.1f ms %10llu bytes\n", denseMillis, (unsigned long long)denseRegion.bytesAllocated());
+	printf("  hybrid: %8.1f ms %10llu bytes\n", hybridMillis, (unsigned long long)hybridRegion.bytesAllocated());
+
+	// The point of the compressed form is that sparse sets are small
+	EXPECT_LT(hybridRegion.bytesAllocated(), denseRegion.bytesAllocated());
+
+	delete problem;
+}
+
+// Sums the squares below its argument: a loop keeps several locals live around a back edge
+class SumOfSquaresIlInjector : public TR::IlInjector {
+	public:
+	TR_ALLOC(TR_Memory::IlGenerator)
+
+	SumOfSquaresIlInjector(TR::TypeDictionary *types, TestCompiler::TestDriver *test) : TR::IlInjector(types, test) {}
+
+	bool injectIL() {
+		createBlocks(4);
+		TR::SymbolReference *i = newTemp(Int32);
+		TR::SymbolReference *sum = newTemp(Int32);
+
+		// Block0: i = 0; sum = 0;
+		storeToTemp(i, iconst(0));
+		storeToTemp(sum, iconst(0));
+		generateFallThrough();
+
+		// Block1: if (i >= n) goto Block3;
+		ifjump(TR::ificmpge, loadTemp(i), parameter(0, Int32), 3);
+
+		// Block2: sum += i * i; i++; goto Block1;
+		storeToTemp(sum, createWithoutSymRef(TR::iadd, 2, loadTemp(sum), createWithoutSymRef(TR::imul, 2, loadTemp(i), loadTemp(i))));
+		storeToTemp(i, createWithoutSymRef(TR::iadd, 2, loadTemp(i), iconst(1)));
+		branchToBlock(1);
+
+		// Block3: return sum;
+		generateToBlock(3);
+		returnValue(loadTemp(sum));
+		return true;
+	}
+};
+
+class SumOfSquaresInfo : public TestCompiler::MethodInfo {
+	public:
+	SumOfSquaresInfo(TestCompiler::TestDriver *test) : _ilInjector(&_types, test) {
+		_args[0] = _types.PrimitiveType(TR::Int32);
+		DefineFunction(__FILE__, LINETOSTR(__LINE__), "sumOfSquares", 1, _args, _types.PrimitiveType(TR::Int32));
+		DefineILInjector(&_ilInjector);
+	}
+
+	typedef int32_t (*MethodType)(int32_t);
+
+	private:
+	TR::TypeDictionary _types;
+	SumOfSquaresIlInjector _ilInjector;
+	TR::IlType *_args[1];
+};
+
+// Solves liveness over the method both ways and compares the sets TR_Liveness hands out
+class HybridLivenessVerifier : public TR::IlVerifier {
+	public:
+	HybridLivenessVerifier() : _blocksCompared(0), _liveOnEntry(0) {}
+
+	int32_t verify(TR::ResolvedMethodSymbol *sym) {
+		TR::Compilation *comp = sym->comp();
+		TR::CFG *cfg = comp->getFlowGraph();
+		TR_Structure *oldStructure = cfg->getStructure();
+		TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+		cfg->setStructure(TR_RegionAnalysis::getRegions(comp));
+
+		comp->getOptions()->setOption(TR_EnableHybridBitVectorLiveness, false);
+		TR_Liveness dense(comp, comp->getOptimizer(), cfg->getStructure());
+		comp->getOptions()->setOption(TR_EnableHybridBitVectorLiveness, true);
+		TR_Liveness hybrid(comp, comp->getOptimizer(), cfg->getStructure());
+		comp->getOptions()->setOption(TR_EnableHybridBitVectorLiveness, false);
+
+		int32_t rc = 0;
+		if (dense.getLiveVariableInfo()->numLocals() == 0) {
+			ADD_FAILURE() << "no locals to analyze";
+			rc = 1;
+		}
+		for (int32_t i = 0; rc == 0 && i < cfg->getNextNodeNumber(); i++) {
+			if (!(*dense._blockAnalysisInfo[i] == *hybrid._blockAnalysisInfo[i])) {
+				ADD_FAILURE() << "live-in sets differ at block_" << i;
+				rc = 1;
+			}
+			_liveOnEntry += dense._blockAnalysisInfo[i]->elementCount();
+			_blocksCompared++;
+		}
+
+		cfg->setStructure(oldStructure);
+		return rc;
+	}
+
+	int32_t _blocksCompared;
+	int32_t _liveOnEntry;
+};
+
+class HybridLivenessTest : public TestCompiler::OptTestDriver {
+	public:
+	void invokeTests() {
+		SumOfSquaresInfo::MethodType sumOfSquares = getCompiledMethod<SumOfSquaresInfo::MethodType>();
+		ASSERT_EQ(0, sumOfSquares(0));
+		ASSERT_EQ(14, sumOfSquares(4));
+		ASSERT_EQ(285, sumOfSquares(10));
+	}
+};
+
+TEST_F(HybridLivenessTest, MatchesDenseLiveness) {
+	SumOfSquaresInfo info(this);
+	setMethodInfo(&info);
+	HybridLivenessVerifier verifier;
+	setIlVerifier(&verifier);
+
+	VerifyAndInvoke();
+
+	ASSERT_LT(0, verifier._blocksCompared);
+	ASSERT_LT(0, verifier._liveOnEntry) << "the loop should keep locals live";
+}
+
+}
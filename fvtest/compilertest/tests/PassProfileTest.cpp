@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/PassProfile.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "compile/Method.hpp"
+#include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
+#include "ilgen/IlInjector.hpp"
+#include "ilgen/MethodInfo.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "OptTestDriver.hpp"
+#include "ras/IlVerifier.hpp"
+
+namespace TestCompiler
+{
+
+static const char *passProfileFileName = "passProfileTest.json";
+
+static std::string
+readPassProfile()
+   {
+   std::string text;
+   FILE *file = fopen(passProfileFileName, "r");
+   if (NULL == file)
+      return text;
+   char buffer[4096];
+   size_t bytesRead;
+   while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      text.append(buffer, bytesRead);
+   fclose(file);
+   return text;
+   }
+
+/**
+ * Return the line of the profile that describes the pass \p name,
+ * or an empty string if it was not profiled.
+ */
+static std::string
+passLine(const std::string &profile, const char *name)
+   {
+   std::string key = std::string("{\"name\": \"") + name + "\",";
+   size_t start = profile.find(key);
+   if (std::string::npos == start)
+      return std::string();
+   return profile.substr(start, profile.find('\n', start) - start);
+   }
+
+class PassProfileTest : public ::testing::Test
+   {
+   protected:
+   virtual void SetUp()
+      {
+      ASSERT_TRUE(NULL == TR::PassProfile::instance()) << "the JIT must not have been started with a pass profile";
+      remove(passProfileFileName);
+      }
+
+   virtual void TearDown()
+      {
+      TR::PassProfile::shutdown();
+      remove(passProfileFileName);
+      }
+   };
+
+TEST_F(PassProfileTest, AggregatesAndSortsByTime)
+   {
+   TR::PassProfile::initialize(passProfileFileName);
+   TR::PassProfile *profile = TR::PassProfile::instance();
+   ASSERT_TRUE(NULL != profile);
+
+   profile->record("opt/warm/b", 30, 100, 0, 10, 8, true);
+   profile->record("comp/\"quoted\"", 5, 1, 2, 0, 0, false);
+   profile->record("opt/warm/b", 20, 50, 4096, 8, 9, true);
+   profile->record("opt/warm/a", 50, 0, 0, 3, 3, true);
+   profile->record("codegen/warm/c", 70, 7, 0, 0, 0, false);
+
+   TR::PassProfile::shutdown();
+   ASSERT_TRUE(NULL == TR::PassProfile::instance());
+
+   // Sorted by total time, ties broken by name; node counts only for passes that count them
+   std::string expected =
+      "{\n"
+      "  \"passes\": [\n"
+      "    {\"name\": \"codegen/warm/c\", \"invocations\": 1, \"timeUSec\": 70, \"maxTimeUSec\": 70, \"regionBytes\": 7, \"segmentBytes\": 0},\n"
+      "    {\"name\": \"opt/warm/a\", \"invocations\": 1, \"timeUSec\": 50, \"maxTimeUSec\": 50, \"regionBytes\": 0, \"segmentBytes\": 0, \"nodesBefore\": 3, \"nodesAfter\": 3},\n"
+      "    {\"name\": \"opt/warm/b\", \"invocations\": 2, \"timeUSec\": 50, \"maxTimeUSec\": 30, \"regionBytes\": 150, \"segmentBytes\": 4096, \"nodesBefore\": 18, \"nodesAfter\": 17},\n"
+      "    {\"name\": \"comp/\\\"quoted\\\"\", \"invocations\": 1, \"timeUSec\": 5, \"maxTimeUSec\": 5, \"regionBytes\": 1, \"segmentBytes\": 2}\n"
+      "  ]\n"
+      "}\n";
+   ASSERT_EQ(expected, readPassProfile());
+   }
+
+TEST_F(PassProfileTest, InactiveWithoutFileName)
+   {
+   TR::PassProfile::initialize(NULL);
+   ASSERT_TRUE(NULL == TR::PassProfile::instance());
+   TR::PassProfile::shutdown();
+   ASSERT_TRUE(readPassProfile().empty()) << "no profile should be written";
+   }
+
+/* Returns its argument plus one; enough IL for the simplifier and codegen to run over. */
+class PassProfileIlInjector : public TR::IlInjector
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::IlGenerator)
+
+   PassProfileIlInjector(TR::TypeDictionary *types, TestDriver *test)
+   :
+      TR::IlInjector(types, test)
+      {
+      }
+
+   bool injectIL()
+      {
+      createBlocks(1);
+      returnValue(createWithoutSymRef(TR::iadd, 2, parameter(0, Int32), iconst(1)));
+      return true;
+      }
+   };
+
+class PassProfileInfo : public TestCompiler::MethodInfo
+   {
+   public:
+   PassProfileInfo(TestDriver *test)
+   :
+      _ilInjector(&_types, test)
+      {
+      TR::IlType* Int32 = _types.PrimitiveType(TR::Int32);
+      _args[0] = Int32;
+      DefineFunction(__FILE__, LINETOSTR(__LINE__), "passProfileMethod", 1, _args, Int32);
+      DefineILInjector(&_ilInjector);
+      }
+
+   typedef int32_t (*MethodType)(int32_t);
+
+   private:
+   TR::TypeDictionary _types;
+   TestCompiler::PassProfileIlInjector _ilInjector;
+   TR::IlType *_args[1];
+   };
+
+class AcceptAllIlVerifier : public TR::IlVerifier
+   {
+   public:
+   int32_t verify(TR::ResolvedMethodSymbol *sym) { return 0; }
+   };
+
+class PassProfileCompileTest : public OptTestDriver
+   {
+   public:
+   PassProfileCompileTest()
+      {
+      addOptimization(OMR::treeSimplification);
+      }
+
+   void invokeTests()
+      {
+      auto testCompiledMethod = getCompiledMethod<PassProfileInfo::MethodType>();
+      ASSERT_EQ(1, testCompiledMethod(0));
+      ASSERT_EQ(-41, testCompiledMethod(-42));
+      }
+
+   protected:
+   virtual void SetUp()
+      {
+      ASSERT_TRUE(NULL == TR::PassProfile::instance()) << "the JIT must not have been started with a pass profile";
+      remove(passProfileFileName);
+      }
+
+   virtual void TearDown()
+      {
+      TR::PassProfile::shutdown();
+      remove(passProfileFileName);
+      }
+   };
+
+/* The region profilers in the compilation, optimizer and codegen phases feed the profile */
+TEST_F(PassProfileCompileTest, ProfilesCompilation)
+   {
+   PassProfileInfo info(this);
+   setMethodInfo(&info);
+   AcceptAllIlVerifier ilVer;
+   setIlVerifier(&ilVer);
+
+   TR::PassProfile::initialize(passProfileFileName);
+   VerifyAndInvoke();
+   TR::PassProfile::shutdown();
+
+   std::string profile = readPassProfile();
+   ASSERT_FALSE(profile.empty());
+
+   // Whole phases are profiled without node counts
+   std::string ilgen = passLine(profile, "comp/ilgen");
+   ASSERT_FALSE(ilgen.empty()) << profile;
+   EXPECT_NE(std::string::npos, ilgen.find("\"invocations\": 1,")) << ilgen;
+   EXPECT_EQ(std::string::npos, ilgen.find("nodesBefore")) << ilgen;
+   EXPECT_FALSE(passLine(profile, "comp/opt").empty()) << profile;
+   EXPECT_FALSE(passLine(profile, "comp/codegen").empty()) << profile;
+
+   // Each optimization is profiled with the IL node counts around it
+   std::string simplifier = passLine(profile, "opt/warm/treeSimplification");
+   ASSERT_FALSE(simplifier.empty()) << profile;
+   EXPECT_NE(std::string::npos, simplifier.find("\"invocations\": 1,")) << simplifier;
+   EXPECT_NE(std::string::npos, simplifier.find("\"nodesBefore\": ")) << simplifier;
+   EXPECT_EQ(std::string::npos, simplifier.find("\"nodesBefore\": 0,")) << simplifier;
+
+   EXPECT_NE(std::string::npos, profile.find("{\"name\": \"codegen/warm/")) << profile;
+   }
+
+}
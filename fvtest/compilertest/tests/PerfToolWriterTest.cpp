@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/PerfToolWriter.hpp"
+
+#if defined(LINUX)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace {
+
+// Layouts from tools/perf/Documentation/jitdump-specification.txt of the Linux sources
+const uint32_t JITDUMP_MAGIC = 0x4A695444;
+const uint32_t JIT_CODE_LOAD = 0;
+const uint32_t JIT_CODE_MOVE = 1;
+const uint32_t JIT_CODE_CLOSE = 3;
+const size_t FILE_HEADER_SIZE = 40;
+const size_t RECORD_HEADER_SIZE = 16;
+const size_t CODE_LOAD_FIXED_SIZE = RECORD_HEADER_SIZE + 8 + 4 * 8;
+const size_t CODE_MOVE_SIZE = RECORD_HEADER_SIZE + 8 + 5 * 8;
+
+template <typename T>
+T read(const std::vector<uint8_t> &data, size_t offset) {
+	T value;
+	memcpy(&value, &data[offset], sizeof(value));
+	return value;
+}
+
+bool readFile(const char *fileName, std::vector<uint8_t> &data) {
+	FILE *file = fopen(fileName, "rb");
+	if (NULL == file)
+		return false;
+	uint8_t buffer[4096];
+	size_t bytesRead;
+	while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		data.insert(data.end(), buffer, buffer + bytesRead);
+	fclose(file);
+	return true;
+}
+
+class PerfToolWriterTest : public :: testing :: Test {
+
+	protected:
+		char perfMapName[64];
+		char jitDumpName[64];
+
+	PerfToolWriterTest() {
+		snprintf(perfMapName, sizeof(perfMapName), "/tmp/perf-%lld.map", static_cast<long long>(getpid()));
+		snprintf(jitDumpName, sizeof(jitDumpName), "/tmp/jit-%lld.dump", static_cast<long long>(getpid()));
+	}
+
+	virtual void SetUp() {
+		ASSERT_TRUE(NULL == TR::PerfToolWriter::instance()) << "the JIT must not have been started with the perf tool files";
+		unlink(perfMapName);
+		unlink(jitDumpName);
+	}
+
+	virtual void TearDown() {
+		TR::PerfToolWriter::shutdown();
+		unlink(perfMapName);
+		unlink(jitDumpName);
+	}
+};
+
+TEST_F(PerfToolWriterTest, perfMapAndJitDump) {
+	static const uint8_t code[] = { 0x55, 0x48, 0x89, 0xe5, 0x8b, 0xc7, 0x5d, 0xc3, 0x90, 0x90, 0x90 };
+	static const uint8_t movedCode[sizeof(code)] = { 0 };
+
+	TR::PerfToolWriter::initialize(true, true, false);
+	TR::PerfToolWriter *writer = TR::PerfToolWriter::instance();
+	ASSERT_TRUE(NULL != writer);
+	writer->codeLoad("perfToolTestMethod", code, sizeof(code), NULL);
+	writer->codeMove("perfToolTestMethod", code, movedCode, sizeof(code));
+	TR::PerfToolWriter::shutdown();
+
+	// One "start size name" line per load and per move, in hex without 0x
+	std::vector<uint8_t> map;
+	ASSERT_TRUE(readFile(perfMapName, map)) << perfMapName;
+	std::string mapText(map.begin(), map.end());
+	char expected[256];
+	snprintf(expected, sizeof(expected), "%llx %x perfToolTestMethod\n%llx %x perfToolTestMethod\n",
+		static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(code)), static_cast<unsigned>(sizeof(code)),
+		static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(movedCode)), static_cast<unsigned>(sizeof(code)));
+	ASSERT_EQ(std::string(expected), mapText);
+
+	std::vector<uint8_t> dump;
+	ASSERT_TRUE(readFile(jitDumpName, dump)) << jitDumpName;
+	ASSERT_GE(dump.size(), FILE_HEADER_SIZE);
+	ASSERT_EQ(JITDUMP_MAGIC, read<uint32_t>(dump, 0));
+	ASSERT_EQ(1u, read<uint32_t>(dump, 4)) << "version";
+	ASSERT_EQ(FILE_HEADER_SIZE, read<uint32_t>(dump, 8)) << "header size";
+	ASSERT_EQ(static_cast<uint32_t>(getpid()), read<uint32_t>(dump, 20));
+
+	// Code load: header, pid, tid, vma, code address, size, index, name, code
+	size_t offset = FILE_HEADER_SIZE;
+	const char *name = "perfToolTestMethod";
+	size_t loadSize = CODE_LOAD_FIXED_SIZE + strlen(name) + 1 + sizeof(code);
+	ASSERT_GE(dump.size(), offset + loadSize);
+	ASSERT_EQ(JIT_CODE_LOAD, read<uint32_t>(dump, offset));
+	ASSERT_EQ(loadSize, read<uint32_t>(dump, offset + 4));
+	uint64_t loadTimestamp = read<uint64_t>(dump, offset + 8);
+	ASSERT_EQ(static_cast<uint32_t>(getpid()), read<uint32_t>(dump, offset + 16));
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(code), read<uint64_t>(dump, offset + 24)) << "vma";
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(code), read<uint64_t>(dump, offset + 32)) << "code address";
+	ASSERT_EQ(sizeof(code), read<uint64_t>(dump, offset + 40));
+	uint64_t codeIndex = read<uint64_t>(dump, offset + 48);
+	ASSERT_STREQ(name, reinterpret_cast<const char *>(&dump[offset + CODE_LOAD_FIXED_SIZE]));
+	ASSERT_EQ(0, memcmp(code, &dump[offset + loadSize - sizeof(code)], sizeof(code)));
+	offset += loadSize;
+
+	// Code move: keeps the index of the load it moves
+	ASSERT_GE(dump.size(), offset + CODE_MOVE_SIZE);
+	ASSERT_EQ(JIT_CODE_MOVE, read<uint32_t>(dump, offset));
+	ASSERT_EQ(CODE_MOVE_SIZE, read<uint32_t>(dump, offset + 4));
+	ASSERT_LE(loadTimestamp, read<uint64_t>(dump, offset + 8));
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(movedCode), read<uint64_t>(dump, offset + 24)) << "vma";
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(code), read<uint64_t>(dump, offset + 32)) << "old address";
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(movedCode), read<uint64_t>(dump, offset + 40)) << "new address";
+	ASSERT_EQ(sizeof(code), read<uint64_t>(dump, offset + 48));
+	ASSERT_EQ(codeIndex, read<uint64_t>(dump, offset + 56));
+	offset += CODE_MOVE_SIZE;
+
+	// Close, written at shutdown, ends the file
+	ASSERT_EQ(offset + RECORD_HEADER_SIZE, dump.size());
+	ASSERT_EQ(JIT_CODE_CLOSE, read<uint32_t>(dump, offset));
+	ASSERT_EQ(RECORD_HEADER_SIZE, read<uint32_t>(dump, offset + 4));
+}
+
+TEST_F(PerfToolWriterTest, perfMapOnly) {
+	static const uint8_t code[] = { 0xc3 };
+
+	TR::PerfToolWriter::initialize(true, false, false);
+	ASSERT_TRUE(NULL != TR::PerfToolWriter::instance());
+	TR::PerfToolWriter::instance()->codeLoad("perfToolTrampoline", code, sizeof(code), NULL);
+	TR::PerfToolWriter::shutdown();
+	ASSERT_TRUE(NULL == TR::PerfToolWriter::instance());
+
+	std::vector<uint8_t> map;
+	ASSERT_TRUE(readFile(perfMapName, map));
+	char expected[128];
+	snprintf(expected, sizeof(expected), "%llx 1 perfToolTrampoline\n", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(code)));
+	ASSERT_EQ(std::string(expected), std::string(map.begin(), map.end()));
+	ASSERT_NE(0, access(jitDumpName, F_OK)) << "no jitdump file was requested";
+}
+
+}
+
+#endif /* defined(LINUX) */
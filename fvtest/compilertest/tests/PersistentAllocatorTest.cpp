@@ -0,0 +1,292 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/PersistentAllocator.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#if !defined(OMR_OS_WINDOWS)
+#include <pthread.h>
+#endif /* !defined(OMR_OS_WINDOWS) */
+#include "env/PersistentAllocatorKit.hpp"
+#include "env/RawAllocator.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+const uint32_t CATEGORY = 7;
+const uint32_t OTHER_CATEGORY = 3;
+
+const size_t CLASS_SIZES[] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024,
+	1280, 1536, 1792, 2048
+	};
+const size_t NUM_CLASSES = sizeof(CLASS_SIZES) / sizeof(CLASS_SIZES[0]);
+
+// Size of the slab class a request of the given size is rounded up to
+size_t classSizeFor(size_t size) {
+	for (size_t i = 0; i < NUM_CLASSES; i++)
+		{
+		if (size <= CLASS_SIZES[i])
+			return CLASS_SIZES[i];
+		}
+	return size;
+}
+
+class PersistentAllocatorTest : public :: testing :: Test {
+
+	protected:
+		TR::RawAllocator rawAllocator;
+		TR::PersistentAllocator allocator;
+
+	PersistentAllocatorTest() : allocator(TR::PersistentAllocatorKit(rawAllocator)) {}
+};
+
+TEST_F(PersistentAllocatorTest, sizeClassBoundaries) {
+	ASSERT_TRUE(allocator.slabsEnabled());
+
+	// Every class edge, and one byte either side of it
+	for (size_t i = 0; i < NUM_CLASSES; i++)
+		{
+		for (size_t size = CLASS_SIZES[i] - 1; size <= CLASS_SIZES[i] + 1 && size <= TR::PersistentAllocator::MaxSlabBlockSize; size++)
+			{
+			size_t classSize = classSizeFor(size);
+			void *p = allocator.allocate(size, CATEGORY, std::nothrow);
+			ASSERT_TRUE(NULL != p) << "size " << size;
+			ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(p) & 15) << "size " << size;
+			ASSERT_EQ(classSize, allocator.bytesInUse(CATEGORY)) << "size " << size;
+			memset(p, 0xA5, classSize);
+			allocator.deallocate(p);
+			ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY)) << "size " << size;
+			}
+		}
+	ASSERT_NE(0u, allocator.slabBytesCommitted());
+}
+
+TEST_F(PersistentAllocatorTest, largeAllocations) {
+	size_t sizes[] = { TR::PersistentAllocator::MaxSlabBlockSize + 1, 64 * 1024, 1024 * 1024 };
+	void *blocks[sizeof(sizes) / sizeof(sizes[0])];
+	size_t total = 0;
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		{
+		blocks[i] = allocator.allocate(sizes[i], CATEGORY, std::nothrow);
+		ASSERT_TRUE(NULL != blocks[i]) << "size " << sizes[i];
+		memset(blocks[i], 0x5A, sizes[i]);
+		total += sizes[i];
+		ASSERT_EQ(total, allocator.bytesInUse(CATEGORY)) << "large blocks are accounted at their exact size";
+		}
+	ASSERT_EQ(0u, allocator.slabBytesCommitted()) << "large blocks must not come from slabs";
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		allocator.deallocate(blocks[i]);
+	ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY));
+
+	void *uncategorized = allocator.allocate(sizes[0]);
+	ASSERT_EQ(sizes[0], allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory));
+	allocator.deallocate(uncategorized);
+	ASSERT_EQ(0u, allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory));
+}
+
+TEST_F(PersistentAllocatorTest, categoryAccounting) {
+	void *a = allocator.allocate(100, CATEGORY, std::nothrow);
+	void *b = allocator.allocate(100, OTHER_CATEGORY, std::nothrow);
+	void *c = allocator.allocate(3000, OTHER_CATEGORY, std::nothrow);
+	void *d = allocator.allocate(8, TR::PersistentAllocator::NumCategories + 5, std::nothrow);
+
+	ASSERT_EQ(112u, allocator.bytesInUse(CATEGORY));
+	ASSERT_EQ(112u + 3000u, allocator.bytesInUse(OTHER_CATEGORY));
+	ASSERT_EQ(16u, allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory)) << "out of range categories are uncategorized";
+	ASSERT_EQ(0u, allocator.bytesInUse(TR::PersistentAllocator::NumCategories));
+
+	// A block freed and handed out again takes the category of its new owner
+	allocator.deallocate(a);
+	void *e = allocator.allocate(100, OTHER_CATEGORY, std::nothrow);
+	ASSERT_EQ(a, e);
+	ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY));
+	ASSERT_EQ(2 * 112u + 3000u, allocator.bytesInUse(OTHER_CATEGORY));
+
+	allocator.deallocate(b);
+	allocator.deallocate(c);
+	allocator.deallocate(d);
+	allocator.deallocate(e);
+	ASSERT_EQ(0u, allocator.bytesInUse(OTHER_CATEGORY));
+	ASSERT_EQ(0u, allocator.bytesInUse(TR::PersistentAllocator::UncategorizedCategory));
+}
+
+TEST(PersistentAllocatorKitTest, slabsDisabled) {
+	TR::RawAllocator rawAllocator;
+	TR::PersistentAllocator allocator(TR::PersistentAllocatorKit(rawAllocator, false));
+
+	ASSERT_FALSE(allocator.slabsEnabled());
+	void *p = allocator.allocate(64, CATEGORY, std::nothrow);
+	ASSERT_TRUE(NULL != p);
+	allocator.deallocate(p);
+	ASSERT_EQ(0u, allocator.slabBytesReserved());
+	ASSERT_EQ(0u, allocator.threadCacheCount());
+}
+
+#if !defined(OMR_OS_WINDOWS)
+
+const size_t CROSS_THREAD_BLOCKS = 1000;
+
+struct CrossThreadFree {
+	TR::PersistentAllocator *allocator;
+	void **blocks;
+	size_t count;
+	size_t cachesWhileRunning;
+};
+
+void *
+freeOnThread(void *arg) {
+	CrossThreadFree *work = static_cast<CrossThreadFree *>(arg);
+	for (size_t i = 0; i < work->count; i++)
+		work->allocator->deallocate(work->blocks[i]);
+	work->cachesWhileRunning = work->allocator->threadCacheCount();
+	return NULL;
+}
+
+TEST_F(PersistentAllocatorTest, crossThreadFree) {
+	void *blocks[CROSS_THREAD_BLOCKS];
+	for (size_t i = 0; i < CROSS_THREAD_BLOCKS; i++)
+		{
+		blocks[i] = allocator.allocate(40, CATEGORY, std::nothrow);
+		ASSERT_TRUE(NULL != blocks[i]);
+		}
+	ASSERT_EQ(CROSS_THREAD_BLOCKS * 48, allocator.bytesInUse(CATEGORY));
+	size_t committed = allocator.slabBytesCommitted();
+	size_t caches = allocator.threadCacheCount();
+
+	CrossThreadFree work = { &allocator, blocks, CROSS_THREAD_BLOCKS, 0 };
+	pthread_t thread;
+	ASSERT_EQ(0, pthread_create(&thread, NULL, freeOnThread, &work));
+	ASSERT_EQ(0, pthread_join(thread, NULL));
+
+	// The freeing thread's counters are folded back when it exits
+	ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY));
+#if defined(SUPPORTS_THREAD_LOCAL)
+	ASSERT_EQ(caches + 1, work.cachesWhileRunning) << "the freeing thread should have had a cache of its own";
+	ASSERT_EQ(caches, allocator.threadCacheCount()) << "the exited thread's cache should have been released";
+#endif
+
+	// and the blocks it freed are available to this thread again
+	for (size_t i = 0; i < CROSS_THREAD_BLOCKS; i++)
+		{
+		blocks[i] = allocator.allocate(40, CATEGORY, std::nothrow);
+		ASSERT_TRUE(NULL != blocks[i]);
+		}
+	ASSERT_EQ(committed, allocator.slabBytesCommitted()) << "freed blocks should be reused before new slabs";
+	for (size_t i = 0; i < CROSS_THREAD_BLOCKS; i++)
+		allocator.deallocate(blocks[i]);
+	ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY));
+
+#if defined(SUPPORTS_THREAD_LOCAL)
+	allocator.releaseThreadCache();
+	ASSERT_EQ(0u, allocator.threadCacheCount());
+	ASSERT_EQ(0u, allocator.bytesInUse(CATEGORY));
+#endif
+}
+
+struct CacheAcrossAllocators {
+	TR::PersistentAllocator *allocator;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	int phase;
+	size_t bytesWhileHeld;
+	size_t cachesWhileHeld;
+};
+
+void
+waitForPhase(CacheAcrossAllocators *work, int phase) {
+	pthread_mutex_lock(&work->mutex);
+	while (work->phase < phase)
+		pthread_cond_wait(&work->cond, &work->mutex);
+	pthread_mutex_unlock(&work->mutex);
+}
+
+void
+setPhase(CacheAcrossAllocators *work, int phase) {
+	pthread_mutex_lock(&work->mutex);
+	work->phase = phase;
+	pthread_cond_broadcast(&work->cond);
+	pthread_mutex_unlock(&work->mutex);
+}
+
+// Allocates from the first allocator, then from a second one built at the
+// same address after the first has been destroyed under it.
+void *
+allocateAcrossAllocators(void *arg) {
+	CacheAcrossAllocators *work = static_cast<CacheAcrossAllocators *>(arg);
+	work->allocator->deallocate(work->allocator->allocate(40, CATEGORY, std::nothrow));
+	setPhase(work, 1);
+
+	waitForPhase(work, 2);
+	void *p = work->allocator->allocate(40, CATEGORY, std::nothrow);
+	work->bytesWhileHeld = work->allocator->bytesInUse(CATEGORY);
+	work->cachesWhileHeld = work->allocator->threadCacheCount();
+	work->allocator->deallocate(p);
+	setPhase(work, 3);
+	return NULL;
+}
+
+TEST(PersistentAllocatorLifetimeTest, cacheOfDestroyedAllocator) {
+	TR::RawAllocator rawAllocator;
+	void *storage = malloc(sizeof(TR::PersistentAllocator));
+	ASSERT_TRUE(NULL != storage);
+	CacheAcrossAllocators work;
+	work.allocator = new (storage) TR::PersistentAllocator(TR::PersistentAllocatorKit(rawAllocator));
+	pthread_mutex_init(&work.mutex, NULL);
+	pthread_cond_init(&work.cond, NULL);
+	work.phase = 0;
+	work.bytesWhileHeld = 0;
+	work.cachesWhileHeld = 0;
+
+	pthread_t thread;
+	ASSERT_EQ(0, pthread_create(&thread, NULL, allocateAcrossAllocators, &work));
+	waitForPhase(&work, 1);
+
+	// The thread still holds the cache it had from the destroyed allocator
+	work.allocator->~PersistentAllocator();
+	work.allocator = new (storage) TR::PersistentAllocator(TR::PersistentAllocatorKit(rawAllocator));
+	setPhase(&work, 2);
+	waitForPhase(&work, 3);
+	ASSERT_EQ(0, pthread_join(thread, NULL));
+
+	EXPECT_EQ(48u, work.bytesWhileHeld) << "the thread's allocation should be accounted to the new allocator";
+	EXPECT_EQ(1u, work.cachesWhileHeld) << "the thread should have taken its slot over for the new allocator";
+	EXPECT_EQ(0u, work.allocator->bytesInUse(CATEGORY));
+	EXPECT_EQ(0u, work.allocator->threadCacheCount()) << "the exited thread's cache should have been released";
+
+	work.allocator->~PersistentAllocator();
+	free(storage);
+	pthread_cond_destroy(&work.cond);
+	pthread_mutex_destroy(&work.mutex);
+}
+
+#endif /* !defined(OMR_OS_WINDOWS) */
+
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/SystemSegmentCache.hpp"
+
+#include <stddef.h>
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+const size_t SEGMENT_SIZE = 1 << 16;
+
+class SystemSegmentCacheTest : public :: testing :: Test {
+
+	protected:
+		TR::RawAllocator rawAllocator;
+		TR::SystemSegmentCache cache;
+
+	SystemSegmentCacheTest() : cache(SEGMENT_SIZE, 16 * SEGMENT_SIZE, rawAllocator) {}
+
+	// Take count segments from the cache and give them all back
+	void cycle(size_t count) {
+		void *segments[16];
+		bool reused = false;
+		ASSERT_LE(count, sizeof(segments) / sizeof(segments[0]));
+		for (size_t i = 0; i < count; i++)
+			segments[i] = cache.allocate(reused);
+		for (size_t i = 0; i < count; i++)
+			cache.deallocate(segments[i]);
+	}
+};
+
+TEST_F(SystemSegmentCacheTest, reuse) {
+	bool reused = true;
+
+	cache.attach();
+	void *first = cache.allocate(reused);
+	ASSERT_FALSE(reused) << "an empty cache cannot reuse a segment";
+	cache.deallocate(first);
+	ASSERT_EQ(SEGMENT_SIZE, cache.cachedBytes());
+
+	void *second = cache.allocate(reused);
+	ASSERT_TRUE(reused);
+	ASSERT_EQ(first, second) << "the cached segment should be handed out again";
+	ASSERT_EQ(0u, cache.cachedBytes());
+	cache.deallocate(second);
+	cache.detach();
+
+	ASSERT_EQ(2u, cache.requests());
+	ASSERT_EQ(1u, cache.hits());
+}
+
+TEST_F(SystemSegmentCacheTest, capacity) {
+	TR::SystemSegmentCache small(SEGMENT_SIZE, 2 * SEGMENT_SIZE, rawAllocator);
+	void *segments[4];
+	bool reused = false;
+
+	small.attach();
+	for (size_t i = 0; i < 4; i++)
+		segments[i] = small.allocate(reused);
+	for (size_t i = 0; i < 4; i++)
+		small.deallocate(segments[i]);
+	ASSERT_EQ(2 * SEGMENT_SIZE, small.cachedBytes()) << "segments beyond the capacity should be freed";
+	ASSERT_EQ(2 * SEGMENT_SIZE, small.peakCachedBytes());
+	small.detach();
+}
+
+TEST_F(SystemSegmentCacheTest, trimOnLastDetach) {
+	cache.attach();
+	cache.attach();
+	cycle(6);
+	ASSERT_EQ(6 * SEGMENT_SIZE, cache.cachedBytes());
+
+	cache.detach();
+	ASSERT_EQ(6 * SEGMENT_SIZE, cache.cachedBytes()) << "the cache must not be trimmed while a provider is attached";
+	cache.detach();
+	ASSERT_EQ(6 * SEGMENT_SIZE, cache.cachedBytes()) << "the high-water mark of 6 segments should be kept";
+	ASSERT_EQ(0u, cache.trimmedBytes());
+
+	// Smaller compilations let the retained memory decay by a quarter per idle
+	// period, rounded down, but never below what they use
+	size_t expected[] = { 5, 4, 3, 3 };
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+		{
+		cache.attach();
+		cycle(2);
+		cache.detach();
+		ASSERT_EQ(expected[i] * SEGMENT_SIZE, cache.cachedBytes()) << "after idle period " << i;
+		}
+	ASSERT_EQ(3 * SEGMENT_SIZE, cache.trimmedBytes());
+
+	// A larger compilation raises the target straight away
+	cache.attach();
+	cycle(10);
+	cache.detach();
+	ASSERT_EQ(10 * SEGMENT_SIZE, cache.cachedBytes());
+}
+
+TEST_F(SystemSegmentCacheTest, sharedByProviders) {
+	for (int compilation = 0; compilation < 3; compilation++)
+		{
+		TR::SystemSegmentProvider provider(SEGMENT_SIZE, rawAllocator, &cache);
+			{
+			TR::Region region(provider, rawAllocator);
+			for (int i = 0; i < 4; i++)
+				region.allocate(SEGMENT_SIZE / 2);
+			}
+		if (compilation > 0)
+			ASSERT_EQ(provider.cachedSegmentRequests(), provider.cachedSegmentHits()) << "later compilations should only reuse segments";
+		else
+			ASSERT_EQ(0u, provider.cachedSegmentHits());
+		}
+	ASSERT_NE(0u, cache.cachedBytes());
+	ASSERT_EQ(0u, cache.trimmedBytes());
+}
+
+}
@@ -0,0 +1,248 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <stdint.h>
+#include "gtest/gtest.h"
+#include "compile/Compilation.hpp"
+#include "compile/Method.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
+#include "ilgen/IlInjector.hpp"
+#include "ilgen/MethodInfo.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "optimizer/DataFlowAnalysis.hpp"
+#include "optimizer/StructuralAnalysis.hpp"
+#include "OptTestDriver.hpp"
+#include "ras/IlVerifier.hpp"
+
+namespace TestCompiler
+{
+
+/* Sums i * j over 0 <= j < i < n.  The inner loop is nested in the outer one,
+ * which is where the worklist and structural solvers can part ways.
+ */
+class NestedLoopIlInjector : public TR::IlInjector
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::IlGenerator)
+
+   NestedLoopIlInjector(TR::TypeDictionary *types, TestDriver *test)
+   :
+      TR::IlInjector(types, test)
+      {
+      }
+
+   bool injectIL()
+      {
+      createBlocks(7);
+
+      TR::SymbolReference *i = newTemp(Int32);
+      TR::SymbolReference *j = newTemp(Int32);
+      TR::SymbolReference *sum = newTemp(Int32);
+
+      // Block0: i = 0; sum = 0;
+      storeToTemp(i, iconst(0));
+      storeToTemp(sum, iconst(0));
+      generateFallThrough();
+
+      // Block1: if (i >= n) goto Block6;
+      ifjump(TR::ificmpge, loadTemp(i), parameter(0, Int32), 6);
+
+      // Block2: j = 0;
+      storeToTemp(j, iconst(0));
+      generateFallThrough();
+
+      // Block3: if (j >= i) goto Block5;
+      ifjump(TR::ificmpge, loadTemp(j), loadTemp(i), 5);
+
+      // Block4: sum += i * j; j++; goto Block3;
+      storeToTemp(sum, createWithoutSymRef(TR::iadd, 2, loadTemp(sum), createWithoutSymRef(TR::imul, 2, loadTemp(i), loadTemp(j))));
+      storeToTemp(j, createWithoutSymRef(TR::iadd, 2, loadTemp(j), iconst(1)));
+      branchToBlock(3);
+
+      // Block5: i++; goto Block1;
+      generateToBlock(5);
+      storeToTemp(i, createWithoutSymRef(TR::iadd, 2, loadTemp(i), iconst(1)));
+      branchToBlock(1);
+
+      // Block6: return sum;
+      generateToBlock(6);
+      returnValue(loadTemp(sum));
+
+      return true;
+      }
+   };
+
+class NestedLoopInfo : public TestCompiler::MethodInfo
+   {
+   public:
+   NestedLoopInfo(TestDriver *test)
+   :
+      _ilInjector(&_types, test)
+      {
+      TR::IlType* Int32 = _types.PrimitiveType(TR::Int32);
+      _args[0] = Int32;
+      DefineFunction(__FILE__, LINETOSTR(__LINE__), "nestedLoop", 1, _args, Int32);
+      DefineILInjector(&_ilInjector);
+      }
+
+   typedef int32_t (*MethodType)(int32_t);
+
+   private:
+   TR::TypeDictionary _types;
+   TestCompiler::NestedLoopIlInjector _ilInjector;
+   TR::IlType *_args[1];
+   };
+
+/* Solves a union analysis (liveness) and an intersection analysis (live on
+ * all paths) over the optimized IL both by structure and from the worklist.
+ * Union analyses must agree exactly.  The worklist reaches the maximal
+ * fixpoint of an intersection analysis, so its sets may only be larger.
+ */
+class WorklistDataFlowVerifier : public TR::IlVerifier
+   {
+   public:
+   WorklistDataFlowVerifier() : _blocksCompared(0) {}
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      TR::Compilation *comp = sym->comp();
+      TR::CFG *cfg = comp->getFlowGraph();
+      TR_Structure *oldStructure = cfg->getStructure();
+      TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+      cfg->setStructure(TR_RegionAnalysis::getRegions(comp));
+
+      comp->getOptions()->setOption(TR_EnableWorklistDataFlow, false);
+      TR_Liveness structuralLiveness(comp, comp->getOptimizer(), cfg->getStructure());
+      TR_LiveOnAllPaths structuralLiveOnAllPaths(comp, comp->getOptimizer(), cfg->getStructure());
+      comp->getOptions()->setOption(TR_EnableWorklistDataFlow, true);
+      TR_Liveness worklistLiveness(comp, comp->getOptimizer(), cfg->getStructure());
+      TR_LiveOnAllPaths worklistLiveOnAllPaths(comp, comp->getOptimizer(), cfg->getStructure());
+      comp->getOptions()->setOption(TR_EnableWorklistDataFlow, false);
+
+      int32_t rc = 0;
+      if (structuralLiveness.getLiveVariableInfo()->numLocals() == 0)
+         {
+         ADD_FAILURE() << "no locals to analyze";
+         rc = 1;
+         }
+
+      TR_BitVector onlyStructural(comp->trMemory()->currentStackRegion());
+      for (int32_t i = 0; rc == 0 && i < cfg->getNextNodeNumber(); i++)
+         {
+         if (!(*structuralLiveness._blockAnalysisInfo[i] == *worklistLiveness._blockAnalysisInfo[i]))
+            {
+            ADD_FAILURE() << "live variables differ at block_" << i;
+            rc = 1;
+            }
+
+         TR_BitVector *structural = structuralLiveOnAllPaths._blockAnalysisInfo[i];
+         TR_BitVector *worklist = worklistLiveOnAllPaths._blockAnalysisInfo[i];
+         if (structural && worklist)
+            {
+            onlyStructural = *structural;
+            onlyStructural -= *worklist;
+            if (!onlyStructural.isEmpty())
+               {
+               ADD_FAILURE() << "worklist live on all paths set is smaller than the structural one at block_" << i;
+               rc = 1;
+               }
+            }
+         else if (structural != worklist)
+            {
+            ADD_FAILURE() << "live on all paths was solved for block_" << i << " by only one solver";
+            rc = 1;
+            }
+         _blocksCompared++;
+         }
+
+      cfg->setStructure(oldStructure);
+      return rc;
+      }
+
+   int32_t _blocksCompared;
+   };
+
+static int32_t
+expectedNestedLoop(int32_t n)
+   {
+   int32_t sum = 0;
+   for (int32_t i = 0; i < n; i++)
+      for (int32_t j = 0; j < i; j++)
+         sum += i * j;
+   return sum;
+   }
+
+class WorklistDataFlowTest : public OptTestDriver
+   {
+   public:
+   void invokeTests()
+      {
+      invokeNestedLoop(getCompiledMethod<NestedLoopInfo::MethodType>());
+      }
+
+   void invokeNestedLoop(NestedLoopInfo::MethodType nestedLoop)
+      {
+      ASSERT_EQ(expectedNestedLoop(0), nestedLoop(0));
+      ASSERT_EQ(expectedNestedLoop(1), nestedLoop(1));
+      ASSERT_EQ(expectedNestedLoop(5), nestedLoop(5));
+      ASSERT_EQ(expectedNestedLoop(40), nestedLoop(40));
+      }
+   };
+
+TEST_F(WorklistDataFlowTest, AgreesWithStructuralSolver)
+   {
+   NestedLoopInfo info(this);
+   setMethodInfo(&info);
+   WorklistDataFlowVerifier verifier;
+   setIlVerifier(&verifier);
+
+   VerifyAndInvoke();
+
+   ASSERT_LT(0, verifier._blocksCompared);
+   }
+
+/* Compile through the full hot strategy, whose loop, PRE and register
+ * allocation passes run their bit vector analyses from the worklist.
+ */
+TEST_F(WorklistDataFlowTest, CompilesHotWithWorklistSolver)
+   {
+   NestedLoopInfo info(this);
+   TR::ResolvedMethod resolvedMethod = info.ResolvedMethod();
+   TR::IlGeneratorMethodDetails details(&resolvedMethod);
+
+   TR::Options::getCmdLineOptions()->setOption(TR_EnableWorklistDataFlow);
+   int32_t rc = 0;
+   uint8_t *entry = compileMethod(details, hot, rc);
+   TR::Options::getCmdLineOptions()->setOption(TR_EnableWorklistDataFlow, false);
+
+   ASSERT_EQ(0, rc) << "compilation failed";
+   ASSERT_TRUE(NULL != entry);
+   invokeNestedLoop(reinterpret_cast<NestedLoopInfo::MethodType>(entry));
+   }
+
+}
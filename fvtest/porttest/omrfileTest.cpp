@@ -215,6 +215,25 @@ TEST_F(PortFileTest2, file_test0)
 			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_fstat is NULL\n");
 		}
 
+		/* omrfile_test41 */
+		if (NULL == OMRPORTLIB->file_pread) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_pread is NULL\n");
+		}
+		if (NULL == OMRPORTLIB->file_pwrite) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_pwrite is NULL\n");
+		}
+		if (NULL == OMRPORTLIB->file_preadv) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_preadv is NULL\n");
+		}
+		if (NULL == OMRPORTLIB->file_pwritev) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_pwritev is NULL\n");
+		}
+
+		/* omrfile_test42 */
+		if (NULL == OMRPORTLIB->file_copy_range) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_copy_range is NULL\n");
+		}
+
 		/* Not tested, implementation dependent.  No known functionality.
 		 * Startup is private to the portlibary, it is not re-entrant safe
 		 */
@@ -4784,6 +4803,184 @@ exit:
 	reportTestExit(OMRPORTLIB, testName);
 }
 
+/**
+ * Verify port file system.
+ * @ref omrfile.c::omrfile_pread "omrfile_pread()"
+ * @ref omrfile.c::omrfile_pwrite "omrfile_pwrite()"
+ * @ref omrfile.c::omrfile_preadv "omrfile_preadv()"
+ * @ref omrfile.c::omrfile_pwritev "omrfile_pwritev()"
+ */
+TEST_F(PortFileTest2, file_test41)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = APPEND_ASYNC(omrfile_test41);
+	const char *fileName = "tfileTest41.tst";
+	char head[] = "0123456789";
+	char tail[] = "abcdefghij";
+	char buffer[32];
+	char first[5];
+	char second[15];
+	OMRFileIOVec vectors[2];
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	I_64 filePtr = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+	omrfile_unlink(fileName);
+
+	fd = omrfile_open(fileName, EsOpenCreate | EsOpenRead | EsOpenWrite, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+
+	/* write the second half first, leaving a gap at the start of the file */
+	rc = omrfile_pwrite(fd, tail, 10, 10);
+	if (10 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pwrite() returned %zd expected 10\n", rc);
+		goto exit;
+	}
+	vectors[0].buffer = head;
+	vectors[0].length = 4;
+	vectors[1].buffer = head + 4;
+	vectors[1].length = 6;
+	rc = omrfile_pwritev(fd, vectors, 2, 0);
+	if (10 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pwritev() returned %zd expected 10\n", rc);
+		goto exit;
+	}
+#if !defined(OMR_OS_WINDOWS)
+	/* positional I/O leaves the file pointer alone */
+	filePtr = omrfile_seek(fd, 0, EsSeekCur);
+	if (0 != filePtr) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "file pointer moved to %lld by positional writes\n", filePtr);
+	}
+#endif /* !defined(OMR_OS_WINDOWS) */
+
+	memset(buffer, 0, sizeof(buffer));
+	rc = omrfile_pread(fd, buffer, sizeof(buffer), 0);
+	if (20 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pread() returned %zd expected 20\n", rc);
+	} else if ((0 != memcmp(buffer, head, 10)) || (0 != memcmp(buffer + 10, tail, 10))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pread() read unexpected data %.20s\n", buffer);
+	}
+
+	/* a vectored read that runs into the end of the file */
+	vectors[0].buffer = first;
+	vectors[0].length = sizeof(first);
+	vectors[1].buffer = second;
+	vectors[1].length = sizeof(second);
+	rc = omrfile_preadv(fd, vectors, 2, 8);
+	if (12 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_preadv() returned %zd expected 12\n", rc);
+	} else if ((0 != memcmp(first, "89abc", 5)) || (0 != memcmp(second, "defghij", 7))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_preadv() read unexpected data\n");
+	}
+
+	rc = omrfile_pread(fd, buffer, sizeof(buffer), 20);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pread() at end of file returned %zd expected 0\n", rc);
+	}
+	rc = omrfile_pread(fd, buffer, sizeof(buffer), -1);
+	if (OMRPORT_ERROR_FILE_INVAL != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pread() at a negative offset returned %zd\n", rc);
+	}
+
+exit:
+	if (-1 != fd) {
+		omrfile_close(fd);
+	}
+	omrfile_unlink(fileName);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify port file system.
+ * @ref omrfile.c::omrfile_copy_range "omrfile_copy_range()"
+ */
+TEST_F(PortFileTest2, file_test42)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = APPEND_ASYNC(omrfile_test42);
+	const char *fileNameIn = "tfileTest42in.tst";
+	const char *fileNameOut = "tfileTest42out.tst";
+	/* larger than the user space copy buffer */
+	const intptr_t fileSize = 200 * 1024;
+	char *data = NULL;
+	char *copy = NULL;
+	intptr_t fdIn = -1;
+	intptr_t fdOut = -1;
+	int64_t copied = 0;
+	intptr_t rc = 0;
+	intptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+	omrfile_unlink(fileNameIn);
+	omrfile_unlink(fileNameOut);
+
+	data = (char *)omrmem_allocate_memory(fileSize, OMRMEM_CATEGORY_PORT_LIBRARY);
+	copy = (char *)omrmem_allocate_memory(fileSize, OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == data) || (NULL == copy)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrmem_allocate_memory() failed\n");
+		goto exit;
+	}
+	for (i = 0; i < fileSize; i++) {
+		data[i] = (char)(i % 251);
+	}
+
+	fdIn = omrfile_open(fileNameIn, EsOpenCreate | EsOpenRead | EsOpenWrite, 0666);
+	fdOut = omrfile_open(fileNameOut, EsOpenCreate | EsOpenRead | EsOpenWrite, 0666);
+	if ((-1 == fdIn) || (-1 == fdOut)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+	for (i = 0; i < fileSize; i += rc) {
+		rc = omrfile_pwrite(fdIn, data + i, fileSize - i, i);
+		if (rc <= 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pwrite() returned %zd\n", rc);
+			goto exit;
+		}
+	}
+
+	/* copy all but the first 100 bytes, asking for more than the file holds */
+	copied = omrfile_copy_range(fdIn, 100, fdOut, 0, fileSize);
+	if ((fileSize - 100) != copied) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() returned %lld expected %zd\n", copied, fileSize - 100);
+		goto exit;
+	}
+	if ((fileSize - 100) != omrfile_flength(fdOut)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "copy has length %lld expected %zd\n", omrfile_flength(fdOut), fileSize - 100);
+	}
+	for (i = 0; i < fileSize - 100; i += rc) {
+		rc = omrfile_pread(fdOut, copy + i, fileSize - 100 - i, i);
+		if (rc <= 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_pread() returned %zd\n", rc);
+			goto exit;
+		}
+	}
+	if (0 != memcmp(data + 100, copy, fileSize - 100)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "copied data differs from the source\n");
+	}
+
+	copied = omrfile_copy_range(fdIn, fileSize, fdOut, 0, 10);
+	if (0 != copied) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_copy_range() past the end of the source returned %lld\n", copied);
+	}
+
+exit:
+	if (-1 != fdIn) {
+		omrfile_close(fdIn);
+	}
+	if (-1 != fdOut) {
+		omrfile_close(fdOut);
+	}
+	omrfile_unlink(fileNameIn);
+	omrfile_unlink(fileNameOut);
+	omrmem_free_memory(data);
+	omrmem_free_memory(copy);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
 /**
  * Verify omrfile_lastmod() returns -1 on an invalid file.
  * @ref omrfile.c::omrfile_lastmod "omrfile_lastmod()"
@@ -0,0 +1,345 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup PortTest
+ * @brief Verify port library asynchronous file I/O.
+ *
+ * Exercise the API for port library asynchronous file operations. These functions
+ * can be found in the file @ref omrfile_async.c
+ */
+#include <string.h>
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "testHelpers.hpp"
+
+#define ASYNC_TEST_BLOCK_SIZE 4096
+#define ASYNC_TEST_BLOCKS 8
+
+/**
+ * Verify port library properly setup to run asynchronous file tests.
+ */
+TEST(PortFileAsyncTest, file_async_test_function_table)
+{
+	const char *testName = "file_async_test_function_table";
+
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (NULL == OMRPORTLIB->file_async_create) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_async_create is NULL\n");
+	}
+	if (NULL == OMRPORTLIB->file_async_submit) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_async_submit is NULL\n");
+	}
+	if (NULL == OMRPORTLIB->file_async_wait) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_async_wait is NULL\n");
+	}
+	if (NULL == OMRPORTLIB->file_async_backend) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_async_backend is NULL\n");
+	}
+	if (NULL == OMRPORTLIB->file_async_destroy) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->file_async_destroy is NULL\n");
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+#if !defined(OMR_OS_WINDOWS)
+/**
+ * Wait for exactly count completions, checking that none failed and that each
+ * transferred expectedBytes. The userData of each completion is recorded in seen,
+ * indexed by the integer value the test stored there.
+ */
+static void
+collectCompletions(struct OMRPortLibrary *portLibrary, const char *testName, OMRFileAsyncContext *context, uintptr_t count, intptr_t expectedBytes, BOOLEAN *seen)
+{
+	OMRFileAsyncCompletion completions[ASYNC_TEST_BLOCKS];
+	uintptr_t received = 0;
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	while (received < count) {
+		intptr_t rc = omrfile_async_wait(context, completions, count - received, 1);
+		intptr_t i = 0;
+		if (rc <= 0) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_wait() returned %zd\n", rc);
+			return;
+		}
+		for (i = 0; i < rc; i++) {
+			uintptr_t index = (uintptr_t)completions[i].userData;
+			if (completions[i].result != expectedBytes) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "operation %zu returned %zd, expected %zd\n", index, completions[i].result, expectedBytes);
+			}
+			if ((index >= ASYNC_TEST_BLOCKS) || seen[index]) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "unexpected completion token %zu\n", index);
+			} else {
+				seen[index] = TRUE;
+			}
+		}
+		received += rc;
+	}
+}
+
+/**
+ * Write a file with positional writes, make it durable, read it back with
+ * vectored reads and check the contents.
+ */
+static void
+exerciseContext(struct OMRPortLibrary *portLibrary, const char *testName, uint32_t flags, int32_t expectedBackend)
+{
+	const char *fileName = "omrfile_async_test.tmp";
+	OMRFileAsyncContext *context = NULL;
+	OMRFileAsyncRequest requests[ASYNC_TEST_BLOCKS];
+	OMRFileIOVec vectors[ASYNC_TEST_BLOCKS][2];
+	BOOLEAN seen[ASYNC_TEST_BLOCKS];
+	char *writeBuffer = NULL;
+	char *readBuffer = NULL;
+	intptr_t fd = -1;
+	intptr_t rc = 0;
+	uintptr_t i = 0;
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	rc = omrfile_async_create(ASYNC_TEST_BLOCKS, flags, &context);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_create() returned %zd\n", rc);
+		return;
+	}
+	if ((0 != expectedBackend) && (expectedBackend != omrfile_async_backend(context))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_backend() returned %d, expected %d\n", omrfile_async_backend(context), expectedBackend);
+	}
+	portTestEnv->log("backend is %d\n", omrfile_async_backend(context));
+
+	writeBuffer = (char *)omrmem_allocate_memory(ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS, OMRMEM_CATEGORY_PORT_LIBRARY);
+	readBuffer = (char *)omrmem_allocate_memory(ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS, OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == writeBuffer) || (NULL == readBuffer)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "buffer allocation failed\n");
+		goto exit;
+	}
+	for (i = 0; i < ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS; i++) {
+		writeBuffer[i] = (char)(i * 7 + i / ASYNC_TEST_BLOCK_SIZE);
+	}
+	memset(readBuffer, 0, ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS);
+
+	omrfile_unlink(fileName);
+	fd = omrfile_open(fileName, EsOpenCreate | EsOpenRead | EsOpenWrite | EsOpenTruncate, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_open() failed\n");
+		goto exit;
+	}
+
+	/* write the blocks in reverse order so that completion order is independent of file order */
+	memset(requests, 0, sizeof(requests));
+	for (i = 0; i < ASYNC_TEST_BLOCKS; i++) {
+		uintptr_t block = ASYNC_TEST_BLOCKS - 1 - i;
+		requests[i].operation = OMRPORT_FILE_ASYNC_WRITE;
+		requests[i].fd = fd;
+		requests[i].offset = block * ASYNC_TEST_BLOCK_SIZE;
+		requests[i].buffer = writeBuffer + block * ASYNC_TEST_BLOCK_SIZE;
+		requests[i].length = ASYNC_TEST_BLOCK_SIZE;
+		requests[i].userData = (void *)block;
+	}
+	rc = omrfile_async_submit(context, requests, ASYNC_TEST_BLOCKS);
+	if (ASYNC_TEST_BLOCKS != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of writes returned %zd\n", rc);
+		goto exit;
+	}
+	memset(seen, 0, sizeof(seen));
+	collectCompletions(OMRPORTLIB, testName, context, ASYNC_TEST_BLOCKS, ASYNC_TEST_BLOCK_SIZE, seen);
+
+	memset(requests, 0, sizeof(requests));
+	requests[0].operation = OMRPORT_FILE_ASYNC_FSYNC;
+	requests[0].fd = fd;
+	rc = omrfile_async_submit(context, requests, 1);
+	if (1 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of fsync returned %zd\n", rc);
+		goto exit;
+	}
+	memset(seen, 0, sizeof(seen));
+	collectCompletions(OMRPORTLIB, testName, context, 1, 0, seen);
+
+	if ((ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS) != omrfile_flength(fd)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "file length is %lld\n", omrfile_flength(fd));
+	}
+
+	/* read each block back as two halves in one vectored read */
+	for (i = 0; i < ASYNC_TEST_BLOCKS; i++) {
+		vectors[i][0].buffer = readBuffer + i * ASYNC_TEST_BLOCK_SIZE;
+		vectors[i][0].length = ASYNC_TEST_BLOCK_SIZE / 2;
+		vectors[i][1].buffer = readBuffer + i * ASYNC_TEST_BLOCK_SIZE + ASYNC_TEST_BLOCK_SIZE / 2;
+		vectors[i][1].length = ASYNC_TEST_BLOCK_SIZE / 2;
+		requests[i].operation = OMRPORT_FILE_ASYNC_READV;
+		requests[i].vectorCount = 2;
+		requests[i].fd = fd;
+		requests[i].offset = i * ASYNC_TEST_BLOCK_SIZE;
+		requests[i].buffer = vectors[i];
+		requests[i].userData = (void *)i;
+	}
+	rc = omrfile_async_submit(context, requests, ASYNC_TEST_BLOCKS);
+	if (ASYNC_TEST_BLOCKS != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of reads returned %zd\n", rc);
+		goto exit;
+	}
+	memset(seen, 0, sizeof(seen));
+	collectCompletions(OMRPORTLIB, testName, context, ASYNC_TEST_BLOCKS, ASYNC_TEST_BLOCK_SIZE, seen);
+
+	if (0 != memcmp(writeBuffer, readBuffer, ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "data read back differs from data written\n");
+	}
+
+	/* a read at the end of the file transfers nothing */
+	memset(requests, 0, sizeof(requests));
+	requests[0].operation = OMRPORT_FILE_ASYNC_READ;
+	requests[0].fd = fd;
+	requests[0].offset = ASYNC_TEST_BLOCK_SIZE * ASYNC_TEST_BLOCKS;
+	requests[0].buffer = readBuffer;
+	requests[0].length = ASYNC_TEST_BLOCK_SIZE;
+	rc = omrfile_async_submit(context, requests, 1);
+	if (1 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of read at end of file returned %zd\n", rc);
+		goto exit;
+	}
+	memset(seen, 0, sizeof(seen));
+	collectCompletions(OMRPORTLIB, testName, context, 1, 0, seen);
+
+exit:
+	omrfile_async_destroy(context);
+	if (-1 != fd) {
+		omrfile_close(fd);
+	}
+	omrfile_unlink(fileName);
+	omrmem_free_memory(writeBuffer);
+	omrmem_free_memory(readBuffer);
+}
+
+/**
+ * Verify asynchronous writes, fsync and vectored reads with the default backend.
+ */
+TEST(PortFileAsyncTest, file_async_test_default_backend)
+{
+	const char *testName = "file_async_test_default_backend";
+
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	reportTestEntry(OMRPORTLIB, testName);
+
+	exerciseContext(OMRPORTLIB, testName, 0, 0);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify asynchronous writes, fsync and vectored reads with the worker thread backend.
+ */
+TEST(PortFileAsyncTest, file_async_test_thread_backend)
+{
+	const char *testName = "file_async_test_thread_backend";
+
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	reportTestEntry(OMRPORTLIB, testName);
+
+	exerciseContext(OMRPORTLIB, testName, OMRPORT_FILE_ASYNC_FORCE_THREADS, OMRPORT_FILE_ASYNC_BACKEND_THREADS);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+/**
+ * Verify that submission stops at the queue depth and at invalid requests, and
+ * that failures are reported through the completion.
+ */
+TEST(PortFileAsyncTest, file_async_test_limits_and_errors)
+{
+	const char *testName = "file_async_test_limits_and_errors";
+	uint32_t flags[] = { 0, OMRPORT_FILE_ASYNC_FORCE_THREADS };
+	uintptr_t f = 0;
+
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	reportTestEntry(OMRPORTLIB, testName);
+
+	for (f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+		OMRFileAsyncContext *context = NULL;
+		OMRFileAsyncRequest requests[4];
+		OMRFileAsyncCompletion completions[4];
+		char buffer[16];
+		intptr_t rc = 0;
+		uintptr_t i = 0;
+
+		rc = omrfile_async_create(2, flags[f], &context);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_create() returned %zd\n", rc);
+			continue;
+		}
+
+		/* reads from a bad descriptor: only the queue depth is accepted, and each fails */
+		memset(requests, 0, sizeof(requests));
+		for (i = 0; i < 4; i++) {
+			requests[i].operation = OMRPORT_FILE_ASYNC_READ;
+			requests[i].fd = -1;
+			requests[i].buffer = buffer;
+			requests[i].length = sizeof(buffer);
+			requests[i].userData = (void *)i;
+		}
+		rc = omrfile_async_submit(context, requests, 4);
+		if (2 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() accepted %zd requests, expected 2\n", rc);
+		}
+		rc = omrfile_async_submit(context, requests, 4);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() on a full queue returned %zd\n", rc);
+		}
+		rc = omrfile_async_wait(context, completions, 4, 4);
+		if (2 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_wait() returned %zd, expected 2\n", rc);
+		}
+		for (i = 0; (intptr_t)i < rc; i++) {
+			if (OMRPORT_ERROR_FILE_BADF != completions[i].result) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "read of bad descriptor returned %zd\n", completions[i].result);
+			}
+		}
+
+		/* nothing in flight: polling returns immediately */
+		rc = omrfile_async_wait(context, completions, 4, 0);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_wait() with nothing in flight returned %zd\n", rc);
+		}
+
+		/* invalid requests are rejected at submission */
+		requests[0].operation = 0;
+		rc = omrfile_async_submit(context, requests, 1);
+		if (OMRPORT_ERROR_FILE_INVAL != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() of an unknown operation returned %zd\n", rc);
+		}
+		requests[0].operation = OMRPORT_FILE_ASYNC_READ;
+		requests[1].operation = OMRPORT_FILE_ASYNC_READ;
+		requests[1].offset = -1;
+		rc = omrfile_async_submit(context, requests, 2);
+		if (1 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrfile_async_submit() before a negative offset returned %zd\n", rc);
+		}
+
+		/* destroy waits for the request still in flight */
+		omrfile_async_destroy(context);
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+#endif /* !defined(OMR_OS_WINDOWS) */
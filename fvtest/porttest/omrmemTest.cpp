@@ -1464,6 +1464,184 @@ TEST(PortMemTest, mem_test9_category_walk)
 	reportTestExit(OMRPORTLIB, testName);
 }
 
+/*
+ * Tests that category counts survive the per-CPU counter stripes being removed and
+ * reinstalled while blocks are live, and that blocks freed against different stripes
+ * than they were allocated against still sum to the right totals.
+ */
+TEST(PortMemTest, mem_test10_category_stripes)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_test10_category_stripes";
+	struct CategoriesState categoriesState;
+	void *blocks[100];
+	uintptr_t initialBlocks = 0;
+	uintptr_t initialBytes = 0;
+	uintptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t) &dummyCategorySet);
+	if (NULL == dummyCategoryTwo.counterStripes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "dummyCategoryTwo has no counter stripes after registration\n");
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	initialBlocks = categoriesState.dummyCategoryTwoBlocks;
+	initialBytes = categoriesState.dummyCategoryTwoBytes;
+
+	for (i = 0; i < 100; i++) {
+		blocks[i] = omrmem_allocate_memory(16, DUMMY_CATEGORY_TWO);
+		if (NULL == blocks[i]) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+			while (i > 0) {
+				omrmem_free_memory(blocks[--i]);
+			}
+			goto end;
+		}
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != (initialBlocks + 100)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after allocate. Expected %zd, got %zd.\n", initialBlocks + 100, categoriesState.dummyCategoryTwoBlocks);
+	}
+
+	/* Removing the stripes folds them into the category itself */
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+	if (NULL != dummyCategoryTwo.counterStripes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "dummyCategoryTwo still has counter stripes after reset\n");
+	}
+	if (dummyCategoryTwo.liveAllocations != (initialBlocks + 100)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Stripes not folded on reset. Expected %zd blocks, got %zd.\n", initialBlocks + 100, dummyCategoryTwo.liveAllocations);
+	}
+
+	/* Free the blocks against a fresh set of stripes */
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, (uintptr_t) &dummyCategorySet);
+	for (i = 0; i < 100; i++) {
+		omrmem_free_memory(blocks[i]);
+	}
+
+	getCategoriesState(OMRPORTLIB, &categoriesState);
+	if (categoriesState.dummyCategoryTwoBlocks != initialBlocks) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after free. Expected %zd, got %zd.\n", initialBlocks, categoriesState.dummyCategoryTwoBlocks);
+	}
+	if (categoriesState.dummyCategoryTwoBytes != initialBytes) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of bytes after free. Expected %zd, got %zd.\n", initialBytes, categoriesState.dummyCategoryTwoBytes);
+	}
+
+end:
+	omrport_control(OMRPORT_CTLDATA_MEM_CATEGORIES_SET, 0);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+#if !defined(OMR_OS_WINDOWS)
+/*
+ * Tests the size-class cache selected by OMR_MEM_SIZE_CLASS_CACHE at port library startup:
+ * that cached blocks are tagged and counted like any other, that freed blocks are reused,
+ * and that reallocation moves contents between cached and uncached blocks.
+ */
+TEST(PortMemTest, mem_test11_size_class_cache)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrmem_test11_size_class_cache";
+	OMRPortLibrary cachedPortLibrary;
+	struct CategoriesState categoriesState;
+	void *blocks[200];
+	uintptr_t initialBlocks = 0;
+	uintptr_t i = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	/* The cache can only be selected at startup, so start a second port library with it */
+	setenv("OMR_MEM_SIZE_CLASS_CACHE", "TRUE", 1);
+	rc = omrport_init_library(&cachedPortLibrary, sizeof(OMRPortLibrary));
+	unsetenv("OMR_MEM_SIZE_CLASS_CACHE");
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrport_init_library() returned %d expected 0\n", rc);
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	if (1 != cachedPortLibrary.port_control(&cachedPortLibrary, OMRPORT_CTLDATA_MEM_SIZE_CLASS_CACHE, 0)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "size-class cache not enabled by OMR_MEM_SIZE_CLASS_CACHE\n");
+	}
+
+	{
+		/* Errors are reported through the default port library so they don't perturb the counts */
+		OMRPortLibrary *cached = &cachedPortLibrary;
+		void *block = NULL;
+		void *reusedBlock = NULL;
+		uint8_t *contents = NULL;
+
+		getCategoriesState(cached, &categoriesState);
+		initialBlocks = categoriesState.portLibraryBlocks;
+
+		/* Sizes span every size class and go past the largest one */
+		for (i = 0; i < 200; i++) {
+			blocks[i] = cached->mem_allocate_memory(cached, (i * 13) + 1, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			if (NULL == blocks[i]) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+				break;
+			}
+			memset(blocks[i], (int)i, (i * 13) + 1);
+		}
+		getCategoriesState(cached, &categoriesState);
+		if (categoriesState.portLibraryBlocks != (initialBlocks + i)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after allocate. Expected %zd, got %zd.\n", initialBlocks + i, categoriesState.portLibraryBlocks);
+		}
+		while (i > 0) {
+			i -= 1;
+			if (((uint8_t *)blocks[i])[i * 13] != (uint8_t)i) {
+				outputErrorMessage(PORTTEST_ERROR_ARGS, "Block %zd overwritten\n", i);
+			}
+			cached->mem_free_memory(cached, blocks[i]);
+		}
+		getCategoriesState(cached, &categoriesState);
+		if (categoriesState.portLibraryBlocks != initialBlocks) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after free. Expected %zd, got %zd.\n", initialBlocks, categoriesState.portLibraryBlocks);
+		}
+
+		/* A freed block is the next one handed out for its size class on this thread */
+		block = cached->mem_allocate_memory(cached, 100, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		cached->mem_free_memory(cached, block);
+		reusedBlock = cached->mem_allocate_memory(cached, 110, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (block != reusedBlock) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Freed block %p not reused, got %p\n", block, reusedBlock);
+		}
+
+		/* Grow out of the cache and shrink back into it */
+		contents = (uint8_t *)reusedBlock;
+		for (i = 0; i < 110; i++) {
+			contents[i] = (uint8_t)i;
+		}
+		contents = (uint8_t *)cached->mem_reallocate_memory(cached, reusedBlock, 8192, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == contents) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected native OOM\n");
+			cached->mem_free_memory(cached, reusedBlock);
+		} else {
+			contents = (uint8_t *)cached->mem_reallocate_memory(cached, contents, 50, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			for (i = 0; i < 50; i++) {
+				if (contents[i] != (uint8_t)i) {
+					outputErrorMessage(PORTTEST_ERROR_ARGS, "Contents lost on reallocate at offset %zd\n", i);
+					break;
+				}
+			}
+			cached->mem_free_memory(cached, contents);
+		}
+
+		getCategoriesState(cached, &categoriesState);
+		if (categoriesState.portLibraryBlocks != initialBlocks) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "Unexpected number of blocks after reallocate. Expected %zd, got %zd.\n", initialBlocks, categoriesState.portLibraryBlocks);
+		}
+	}
+
+	cachedPortLibrary.port_shutdown_library(&cachedPortLibrary);
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+#endif /* !defined(OMR_OS_WINDOWS) */
+
 /* attempt to free all mem pointers stored in memPtrs array with length */
 static void
 freeMemPointers(struct OMRPortLibrary *portLibrary, void **memPtrs, uintptr_t length)
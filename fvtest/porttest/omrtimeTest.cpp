@@ -126,6 +126,26 @@ TEST(PortTimeTest, time_test0)
 		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->time_hires_delta is NULL\n");
 	}
 
+	/* omrtime_test_fast_clock */
+	if (NULL == OMRPORTLIB->time_fast_ticks) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->time_fast_ticks is NULL\n");
+	}
+
+	/* omrtime_test_fast_clock */
+	if (NULL == OMRPORTLIB->time_fast_ticks_to_nanos) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->time_fast_ticks_to_nanos is NULL\n");
+	}
+
+	/* omrtime_test_fast_clock */
+	if (NULL == OMRPORTLIB->time_fast_frequency) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->time_fast_frequency is NULL\n");
+	}
+
+	/* omrtime_test_fast_clock */
+	if (NULL == OMRPORTLIB->time_fast_clock_source) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "portLibrary->time_fast_clock_source is NULL\n");
+	}
+
 	reportTestExit(OMRPORTLIB, testName);
 }
 
@@ -760,3 +780,111 @@ TEST(PortTimeTest, time_test_hires_delta_rounding)
 exit:
 	reportTestExit(OMRPORTLIB, testName);
 }
+
+/**
+ * Verify that the fast clock advances monotonically and that its ticks convert to
+ * nanoseconds consistently with omrtime_nano_time().
+ *
+ * Functions verified by this test:
+ * @arg @ref omrtime_fast.c::omrtime_fast_ticks "omrtime_fast_ticks()"
+ * @arg @ref omrtime_fast.c::omrtime_fast_ticks_to_nanos "omrtime_fast_ticks_to_nanos()"
+ * @arg @ref omrtime_fast.c::omrtime_fast_frequency "omrtime_fast_frequency()"
+ * @arg @ref omrtime_fast.c::omrtime_fast_clock_source "omrtime_fast_clock_source()"
+ */
+TEST(PortTimeTest, time_test_fast_clock)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrtime_test_fast_clock";
+	int32_t source = omrtime_fast_clock_source();
+	uint64_t frequency = omrtime_fast_frequency();
+	uint64_t previousTicks = 0;
+	uint64_t startTicks = 0;
+	uint64_t fastNanos = 0;
+	int64_t startNanos = 0;
+	int64_t osNanos = 0;
+	uintptr_t i = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	portTestEnv->log("source: %d    frequency: %llu\n", source, frequency);
+	if ((OMRPORT_TIME_FAST_CLOCK_OS != source) && (OMRPORT_TIME_FAST_CLOCK_TSC != source) && (OMRPORT_TIME_FAST_CLOCK_CNTVCT != source)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_fast_clock_source returned unknown source %d\n", source);
+	}
+	if (0 == frequency) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_fast_frequency returned 0\n");
+	}
+
+	/* One second of ticks is one second */
+	fastNanos = omrtime_fast_ticks_to_nanos(frequency);
+	if (omrtime_test_compute_error_pct((double)OMRPORT_TIME_DELTA_IN_NANOSECONDS, (double)fastNanos) > 0.01) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_fast_ticks_to_nanos(frequency) returned %llu\n", fastNanos);
+	}
+
+	previousTicks = omrtime_fast_ticks();
+	for (i = 0; i < 100000; i++) {
+		uint64_t ticks = omrtime_fast_ticks();
+		if (ticks < previousTicks) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "omrtime_fast_ticks went backwards from %llu to %llu\n", previousTicks, ticks);
+			break;
+		}
+		previousTicks = ticks;
+	}
+
+	startTicks = omrtime_fast_ticks();
+	startNanos = omrtime_nano_time();
+	omrthread_sleep(100);
+	fastNanos = omrtime_fast_ticks_to_nanos(omrtime_fast_ticks() - startTicks);
+	osNanos = omrtime_nano_time() - startNanos;
+	portTestEnv->log("fast clock: %llu ns    nano_time: %lld ns\n", fastNanos, osNanos);
+	if (omrtime_test_compute_error_pct((double)osNanos, (double)fastNanos) > 0.02) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "fast clock measured %llu ns where omrtime_nano_time measured %lld ns\n", fastNanos, osNanos);
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+#if !defined(OMR_OS_WINDOWS)
+/**
+ * Verify that OMR_TIME_FAST_CLOCK=OS selects the omrtime_nano_time() fallback.
+ */
+TEST(PortTimeTest, time_test_fast_clock_fallback)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrtime_test_fast_clock_fallback";
+	OMRPortLibrary fallbackPortLibrary;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	/* The clock is selected at startup, so start a second port library with the fallback */
+	setenv("OMR_TIME_FAST_CLOCK", "OS", 1);
+	rc = omrport_init_library(&fallbackPortLibrary, sizeof(OMRPortLibrary));
+	unsetenv("OMR_TIME_FAST_CLOCK");
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrport_init_library() returned %d expected 0\n", rc);
+	} else {
+		OMRPortLibrary *fallback = &fallbackPortLibrary;
+		uint64_t ticks = 0;
+		int64_t nanos = 0;
+
+		if (OMRPORT_TIME_FAST_CLOCK_OS != fallback->time_fast_clock_source(fallback)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "OMR_TIME_FAST_CLOCK=OS did not select the OS clock\n");
+		}
+		if (OMRPORT_TIME_DELTA_IN_NANOSECONDS != fallback->time_fast_frequency(fallback)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "OS clock frequency is %llu\n", fallback->time_fast_frequency(fallback));
+		}
+		if (12345 != fallback->time_fast_ticks_to_nanos(fallback, 12345)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "OS clock ticks are not nanoseconds\n");
+		}
+		/* Ticks come from omrtime_nano_time */
+		ticks = fallback->time_fast_ticks(fallback);
+		nanos = omrtime_nano_time();
+		if (omrtime_test_compute_error_pct((double)nanos, (double)ticks) > 0.01) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "OS clock ticks %llu do not match omrtime_nano_time %lld\n", ticks, nanos);
+		}
+		fallback->port_shutdown_library(fallback);
+	}
+
+	reportTestExit(OMRPORTLIB, testName);
+}
+#endif /* !defined(OMR_OS_WINDOWS) */
@@ -2343,3 +2343,316 @@ TEST(PortSysinfoTest, sysinfo_cgroup_get_memlimit)
 	reportTestExit(OMRPORTLIB, testName);
 	return;
 }
+
+#if defined(LINUX)
+/**
+ * Write a file for the fake cgroup hierarchy used by sysinfo_cgroup_v2_fake_root.
+ */
+static void
+writeCgroupV2File(struct OMRPortLibrary *portLibrary, const char *testName, const char *root, const char *fileName, const char *contents)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	char path[EsMaxPath];
+	intptr_t fd = -1;
+
+	omrstr_printf(path, sizeof(path), "%s/%s", root, fileName);
+	fd = omrfile_open(path, EsOpenCreate | EsOpenWrite | EsOpenTruncate, 0666);
+	if (-1 == fd) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to create %s\n", path);
+		return;
+	}
+	if ((intptr_t)strlen(contents) != omrfile_write(fd, contents, strlen(contents))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "failed to write %s\n", path);
+	}
+	omrfile_close(fd);
+}
+
+/**
+ * Test the cgroup v2 (unified hierarchy) support against a fake hierarchy selected with
+ * OMR_CGROUP_ROOT: memory.max and memory.high for the memory limit, cpu.max and
+ * cpuset.cpus.effective for the CPU count, memory.current and memory.stat for memory
+ * usage, and memory.pressure through the metric iterator.
+ */
+TEST(PortSysinfoTest, sysinfo_cgroup_v2_fake_root)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsysinfo_cgroup_v2_fake_root";
+	const char *root = "omrsysinfo_cgroup_v2_root";
+	const char *files[] = {
+		"cgroup.controllers", "memory.max", "memory.high", "memory.current", "memory.swap.max",
+		"memory.swap.current", "memory.stat", "memory.pressure", "cpu.max", "cpuset.cpus.effective"
+	};
+	OMRPortLibrary cgroupPortLibrary;
+	OMRPortLibrary *cgroupPort = &cgroupPortLibrary;
+	char cwd[EsMaxPath];
+	char rootPath[EsMaxPath];
+	uintptr_t i = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	if (0 != omrsysinfo_get_cwd(cwd, sizeof(cwd))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cwd failed\n");
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	omrstr_printf(rootPath, sizeof(rootPath), "%s/%s", cwd, root);
+	omrfile_mkdir(rootPath);
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cgroup.controllers", "cpuset cpu io memory pids\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.max", "268435456\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.high", "max\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.current", "67108864\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.swap.max", "0\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.swap.current", "0\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.stat", "anon 1024\nfile 4096\nfile_mapped 512\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.pressure", "some avg10=1.50 avg60=0.50 avg300=0.10 total=1234\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=56\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cpu.max", "100000 100000\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cpuset.cpus.effective", "0\n");
+
+	/* The hierarchy is located at startup, so start a second port library with it */
+	setenv("OMR_CGROUP_ROOT", rootPath, 1);
+	rc = omrport_init_library(&cgroupPortLibrary, sizeof(OMRPortLibrary));
+	unsetenv("OMR_CGROUP_ROOT");
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrport_init_library() returned %d expected 0\n", rc);
+		goto cleanup;
+	}
+
+	{
+		uint64_t enabled = 0;
+		uint64_t memLimit = 0;
+		J9MemoryInfo memInfo = {0};
+		OMRCgroupMetricIteratorState state;
+		OMRCgroupMetricElement element;
+		BOOLEAN foundPressure = FALSE;
+
+		if (!cgroupPort->sysinfo_cgroup_is_system_available(cgroupPort)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "cgroup v2 hierarchy at %s not available\n", rootPath);
+			goto shutdown;
+		}
+		enabled = cgroupPort->sysinfo_cgroup_enable_subsystems(cgroupPort, OMR_CGROUP_SUBSYSTEM_ALL);
+		if (OMR_CGROUP_SUBSYSTEM_ALL != enabled) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "enabled subsystems 0x%llx, expected 0x%llx\n", enabled, OMR_CGROUP_SUBSYSTEM_ALL);
+		}
+
+		rc = cgroupPort->sysinfo_cgroup_get_memlimit(cgroupPort, &memLimit);
+		if ((0 != rc) || (268435456 != memLimit)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "memlimit returned %d, %llu, expected memory.max 268435456\n", rc, memLimit);
+		}
+		if (268435456 != cgroupPort->sysinfo_get_physical_memory(cgroupPort)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "physical memory does not match memory.max\n");
+		}
+
+		/* memory.high below memory.max becomes the limit */
+		writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.high", "134217728\n");
+		rc = cgroupPort->sysinfo_cgroup_get_memlimit(cgroupPort, &memLimit);
+		if ((0 != rc) || (134217728 != memLimit)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "memlimit returned %d, %llu, expected memory.high 134217728\n", rc, memLimit);
+		}
+
+		rc = cgroupPort->sysinfo_get_memory_info(cgroupPort, &memInfo);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "sysinfo_get_memory_info returned %d\n", rc);
+		} else if ((134217728 != memInfo.totalPhysical) || ((134217728 - 67108864) != memInfo.availPhysical) || (4096 != memInfo.cached)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "memory info total %llu avail %llu cached %llu does not match the cgroup\n", memInfo.totalPhysical, memInfo.availPhysical, memInfo.cached);
+		}
+
+		/* cpu.max and cpuset.cpus.effective both allow one CPU */
+		if (1 != cgroupPort->sysinfo_get_number_CPUs_by_type(cgroupPort, OMRPORT_CPU_BOUND)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "bound CPUs %zu, expected 1\n", cgroupPort->sysinfo_get_number_CPUs_by_type(cgroupPort, OMRPORT_CPU_BOUND));
+		}
+		writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cpu.max", "max 100000\n");
+		writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cpuset.cpus.effective", "0-1023\n");
+		if (omrsysinfo_get_number_CPUs_by_type(OMRPORT_CPU_BOUND) != cgroupPort->sysinfo_get_number_CPUs_by_type(cgroupPort, OMRPORT_CPU_BOUND)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "unlimited cpu.max changed the number of bound CPUs\n");
+		}
+
+		memset(&state, 0, sizeof(state));
+		rc = cgroupPort->sysinfo_cgroup_subsystem_iterator_init(cgroupPort, OMR_CGROUP_SUBSYSTEM_MEMORY, &state);
+		if (0 != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "sysinfo_cgroup_subsystem_iterator_init returned %d\n", rc);
+		}
+		while ((0 == rc) && cgroupPort->sysinfo_cgroup_subsystem_iterator_hasNext(cgroupPort, &state)) {
+			const char *metricKey = NULL;
+
+			if (0 != cgroupPort->sysinfo_cgroup_subsystem_iterator_metricKey(cgroupPort, &state, &metricKey)) {
+				metricKey = NULL;
+			}
+			if (0 == cgroupPort->sysinfo_cgroup_subsystem_iterator_next(cgroupPort, &state, &element)) {
+				portTestEnv->log("%s: %s\n", (NULL != metricKey) ? metricKey : "?", element.value);
+				if ((NULL != metricKey) && (0 == strcmp(metricKey, "Some tasks stalled on memory"))) {
+					foundPressure = TRUE;
+					if (0 != strcmp(element.value, "avg10=1.50 avg60=0.50 avg300=0.10 total=1234")) {
+						outputErrorMessage(PORTTEST_ERROR_ARGS, "memory.pressure read as \"%s\"\n", element.value);
+					}
+				}
+			}
+		}
+		cgroupPort->sysinfo_cgroup_subsystem_iterator_destroy(cgroupPort, &state);
+		if (!foundPressure) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "memory.pressure not reported by the metric iterator\n");
+		}
+	}
+
+shutdown:
+	cgroupPort->port_shutdown_library(cgroupPort);
+cleanup:
+	for (i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+		char path[EsMaxPath];
+
+		omrstr_printf(path, sizeof(path), "%s/%s", rootPath, files[i]);
+		omrfile_unlink(path);
+	}
+	omrfile_unlinkdir(rootPath);
+	reportTestExit(OMRPORTLIB, testName);
+}
+
+typedef struct MemoryPressureTestState {
+	omrthread_monitor_t monitor;
+	uintptr_t calls;
+	OMRMemoryPressureEvent last;
+} MemoryPressureTestState;
+
+static void
+memoryPressureTestHandler(struct OMRPortLibrary *portLibrary, const struct OMRMemoryPressureEvent *event, void *userData)
+{
+	MemoryPressureTestState *state = (MemoryPressureTestState *)userData;
+
+	omrthread_monitor_enter(state->monitor);
+	state->calls += 1;
+	state->last = *event;
+	omrthread_monitor_notify_all(state->monitor);
+	omrthread_monitor_exit(state->monitor);
+}
+
+/**
+ * Wait up to timeoutMillis for the handler to have been called expectedCalls times.
+ */
+static BOOLEAN
+waitForMemoryPressureCalls(MemoryPressureTestState *state, uintptr_t expectedCalls, uintptr_t timeoutMillis)
+{
+	uintptr_t waits = 0;
+	BOOLEAN reached = FALSE;
+
+	omrthread_monitor_enter(state->monitor);
+	while ((state->calls < expectedCalls) && (waits < (timeoutMillis / 100))) {
+		omrthread_monitor_wait_timed(state->monitor, 100, 0);
+		waits += 1;
+	}
+	reached = (state->calls >= expectedCalls);
+	omrthread_monitor_exit(state->monitor);
+	return reached;
+}
+
+/**
+ * Test memory pressure notifications against a simulated cgroup v2 hierarchy selected with
+ * OMR_CGROUP_ROOT: memory.events counters going up, and memory.pressure stall totals below
+ * and above the registered threshold. No notification may follow unregistration.
+ */
+TEST(PortSysinfoTest, sysinfo_memory_pressure_fake_root)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portTestEnv->getPortLibrary());
+	const char *testName = "omrsysinfo_memory_pressure_fake_root";
+	const char *root = "omrsysinfo_memory_pressure_root";
+	const char *files[] = { "cgroup.controllers", "memory.events", "memory.pressure" };
+	OMRPortLibrary cgroupPortLibrary;
+	OMRPortLibrary *cgroupPort = &cgroupPortLibrary;
+	MemoryPressureTestState state;
+	char cwd[EsMaxPath];
+	char rootPath[EsMaxPath];
+	uintptr_t i = 0;
+	int32_t rc = 0;
+
+	reportTestEntry(OMRPORTLIB, testName);
+
+	memset(&state, 0, sizeof(state));
+	if (0 != omrthread_monitor_init_with_name(&state.monitor, 0, "sysinfo_memory_pressure_test")) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrthread_monitor_init_with_name failed\n");
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	if (0 != omrsysinfo_get_cwd(cwd, sizeof(cwd))) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_get_cwd failed\n");
+		omrthread_monitor_destroy(state.monitor);
+		reportTestExit(OMRPORTLIB, testName);
+		return;
+	}
+	omrstr_printf(rootPath, sizeof(rootPath), "%s/%s", cwd, root);
+	omrfile_mkdir(rootPath);
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "cgroup.controllers", "cpu memory pids\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.events", "low 0\nhigh 2\nmax 0\noom 0\noom_kill 0\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.pressure", "some avg10=0.00 avg60=0.00 avg300=0.00 total=1000\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+
+	setenv("OMR_CGROUP_ROOT", rootPath, 1);
+	rc = omrport_init_library(&cgroupPortLibrary, sizeof(OMRPortLibrary));
+	unsetenv("OMR_CGROUP_ROOT");
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrport_init_library() returned %d expected 0\n", rc);
+		goto cleanup;
+	}
+
+	rc = cgroupPort->sysinfo_memory_pressure_register(cgroupPort, memoryPressureTestHandler, &state, 0, 0, 0);
+	if (OMRPORT_ERROR_INVALID_ARGUMENTS != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "registering no events returned %d expected OMRPORT_ERROR_INVALID_ARGUMENTS\n", rc);
+	}
+	rc = cgroupPort->sysinfo_memory_pressure_register(cgroupPort, memoryPressureTestHandler, &state,
+			OMRPORT_MEMORY_PRESSURE_SOME | OMRPORT_MEMORY_PRESSURE_HIGH | OMRPORT_MEMORY_PRESSURE_MAX, 100000, 1000000);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_memory_pressure_register() returned %d expected 0\n", rc);
+		goto shutdown;
+	}
+
+	/* memory.high was hit three more times than when the monitor started */
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.events", "low 0\nhigh 5\nmax 0\noom 0\noom_kill 0\n");
+	if (!waitForMemoryPressureCalls(&state, 1, 5000)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "no notification for memory.events high\n");
+		goto unregister;
+	}
+	if ((OMRPORT_MEMORY_PRESSURE_HIGH != state.last.type) || (5 != state.last.total) || (3 != state.last.delta)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "memory.events high reported type 0x%zx total %llu delta %llu, expected 0x%zx 5 3\n",
+				state.last.type, state.last.total, state.last.delta, OMRPORT_MEMORY_PRESSURE_HIGH);
+	}
+
+	/* 50ms of stall is below the threshold, a further 100ms reaches it */
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.pressure", "some avg10=1.00 avg60=0.00 avg300=0.00 total=51000\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+	writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.pressure", "some avg10=3.00 avg60=0.00 avg300=0.00 total=151000\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+	if (!waitForMemoryPressureCalls(&state, 2, 5000)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "no notification for memory.pressure some\n");
+		goto unregister;
+	}
+	if ((2 != state.calls) || (OMRPORT_MEMORY_PRESSURE_SOME != state.last.type) || (151000 != state.last.total) || (150000 != state.last.delta)) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "memory.pressure reported %zu calls, type 0x%zx total %llu delta %llu, expected 2 calls 0x%zx 151000 150000\n",
+				state.calls, state.last.type, state.last.total, state.last.delta, OMRPORT_MEMORY_PRESSURE_SOME);
+	}
+
+unregister:
+	rc = cgroupPort->sysinfo_memory_pressure_unregister(cgroupPort, memoryPressureTestHandler, &state);
+	if (0 != rc) {
+		outputErrorMessage(PORTTEST_ERROR_ARGS, "omrsysinfo_memory_pressure_unregister() returned %d expected 0\n", rc);
+	} else {
+		uintptr_t callsBefore = state.calls;
+
+		writeCgroupV2File(OMRPORTLIB, testName, rootPath, "memory.events", "low 0\nhigh 5\nmax 1\noom 0\noom_kill 0\n");
+		if (waitForMemoryPressureCalls(&state, callsBefore + 1, 500)) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "handler called after omrsysinfo_memory_pressure_unregister()\n");
+		}
+		rc = cgroupPort->sysinfo_memory_pressure_unregister(cgroupPort, memoryPressureTestHandler, &state);
+		if (OMRPORT_ERROR_INVALID_ARGUMENTS != rc) {
+			outputErrorMessage(PORTTEST_ERROR_ARGS, "second unregister returned %d expected OMRPORT_ERROR_INVALID_ARGUMENTS\n", rc);
+		}
+	}
+
+shutdown:
+	cgroupPort->port_shutdown_library(cgroupPort);
+cleanup:
+	for (i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+		char path[EsMaxPath];
+
+		omrstr_printf(path, sizeof(path), "%s/%s", rootPath, files[i]);
+		omrfile_unlink(path);
+	}
+	omrfile_unlinkdir(rootPath);
+	omrthread_monitor_destroy(state.monitor);
+	reportTestExit(OMRPORTLIB, testName);
+}
+#endif /* defined(LINUX) */
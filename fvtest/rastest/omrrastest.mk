@@ -34,6 +34,8 @@ OBJECTS := \
   rasTestHelpers \
   traceLifecycleTest \
   traceLogTest \
+  traceOutputTest \
+  tracePointBenchmark \
   traceRecordHelpers \
   traceTest \
   ut_omr_test
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omr.h"
+#include "omrrasinit.h"
+#include "omrTest.h"
+#include "omrTestHelpers.h"
+#include "omrtrace.h"
+#include "omrtraceformat.h"
+#include "omrvm.h"
+#include "ut_omr_test.h"
+
+#include "rasTestHelpers.hpp"
+
+#define TEST_OUTPUT_GENERATIONS 2
+#define TEST_OUTPUT_FILE_SIZE (16 * 1024)
+#define TEST_TRACEPOINT_COUNT 4000
+
+static char *getTestFormatString(const char *componentName, int32_t tracepoint);
+
+TEST(RASTraceOutputTest, MappedOutputGenerations)
+{
+	OMRTestVM testVM;
+	OMR_VMThread *vmthread = NULL;
+	uint64_t totalFormatted = 0;
+	char fileName[64];
+	char textName[64];
+	uint32_t i = 0;
+
+	OMRPORT_ACCESS_FROM_OMRPORT(rasTestEnv->getPortLibrary());
+	char *datDir = getTraceDatDir(rasTestEnv->_argc, (const char **)rasTestEnv->_argv);
+
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMInit(&testVM, OMRPORTLIB));
+
+	/* WARNING: This negative test leaks memory. */
+	OMRTEST_ASSERT_ERROR(omr_ras_initTraceEngine(&testVM.omrVM, "buffers=1k:maximal=all:output=traceOutputTest.trc,16k,2", datDir), OMR_ERROR_ILLEGAL_ARGUMENT);
+
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_initTraceEngine(&testVM.omrVM, "buffers=1k:maximal=all:maximal=!j9thr:output=traceOutputTest#.trc,16k,2", datDir));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Init(&testVM.omrVM, NULL, &vmthread, "traceOutputTest"));
+
+	UT_OMR_TEST_MODULE_LOADED(testVM.omrVM._trcEngine->utIntf);
+	for (i = 0; i < TEST_TRACEPOINT_COUNT; i++) {
+		Trc_OMR_Test_String(vmthread, "mapped output test");
+	}
+	UT_OMR_TEST_MODULE_UNLOADED(testVM.omrVM._trcEngine->utIntf);
+
+	/* Shutting down the trace engine flushes the last buffer and trims the current generation. */
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_cleanupTraceEngine(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Free(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMFini(&testVM));
+
+	for (i = 0; i < TEST_OUTPUT_GENERATIONS; i++) {
+		uint64_t formatted = 0;
+		intptr_t textFile = -1;
+		int64_t fileLength = 0;
+
+		omrstr_printf(fileName, sizeof(fileName), "traceOutputTest%u.trc", i);
+		fileLength = omrfile_length(fileName);
+		ASSERT_LT(0, fileLength) << "missing generation " << fileName;
+		ASSERT_GE(TEST_OUTPUT_FILE_SIZE, fileLength) << fileName << " exceeds the configured size";
+
+		omrstr_printf(textName, sizeof(textName), "traceOutputTest%u.txt", i);
+		textFile = omrfile_open(textName, EsOpenCreate | EsOpenWrite | EsOpenTruncate, 0666);
+		ASSERT_NE(-1, textFile);
+		OMRTEST_ASSERT_ERROR_NONE(omr_trc_formatTraceFile(OMRPORTLIB, fileName, getTestFormatString, textFile, &formatted));
+		omrfile_close(textFile);
+		ASSERT_LT((uint64_t)0, formatted) << "no tracepoints formatted from " << fileName;
+		totalFormatted += formatted;
+
+		/* Every record written by this thread must format back to the original tracepoint text. */
+		{
+			char line[256];
+			BOOLEAN found = FALSE;
+			textFile = omrfile_open(textName, EsOpenRead, 0);
+			ASSERT_NE(-1, textFile);
+			if (NULL != omrfile_read_text(textFile, line, sizeof(line))) {
+				found = (NULL != strstr(line, "String: mapped output test"));
+			}
+			omrfile_close(textFile);
+			EXPECT_TRUE(found) << "unexpected formatted output in " << textName;
+		}
+
+		omrfile_unlink(textName);
+		omrfile_unlink(fileName);
+	}
+
+	/* Older generations are overwritten, so only part of the trace history survives. */
+	ASSERT_GT((uint64_t)TEST_TRACEPOINT_COUNT, totalFormatted);
+
+}
+
+static char *
+getTestFormatString(const char *componentName, int32_t tracepoint)
+{
+	static char const *omrTestFormats[] = {
+		"Trace engine initialized for module omr_test",
+		"String: %s",
+		"Ptr: %p",
+		"Number: %d",
+		"String: %s Ptr: %p Number: %u"
+	};
+	char const *format = "UNKNOWN TRACEPOINT ID";
+
+	if ((0 == strcmp(componentName, "omr_test"))
+		&& (0 <= tracepoint)
+		&& (tracepoint < (int32_t)(sizeof(omrTestFormats) / sizeof(omrTestFormats[0])))
+	) {
+		format = omrTestFormats[tracepoint];
+	}
+	return (char *)format;
+}
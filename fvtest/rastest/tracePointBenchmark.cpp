@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * Copyright (c) 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omr.h"
+#include "omragent.h"
+#include "omrrasinit.h"
+#include "omrTest.h"
+#include "omrTestHelpers.h"
+#include "omrtrace.h"
+#include "omrvm.h"
+#include "ut_omr_test.h"
+
+#include "rasTestHelpers.hpp"
+
+/*
+ * This test covers:
+ * - Tracepoints with fixed-size arguments recorded through the packed entry point
+ *   produce the same trace data as the varargs entry point
+ * - The cost per enabled maximal tracepoint of both entry points
+ */
+
+#define BENCHMARK_ITERATIONS 2000000
+#define MAX_CAPTURED_TRACEPOINTS 4
+#define MAX_CAPTURED_BYTES 16
+
+/* Call the varargs entry point directly, as tracepoint macros did before arguments were packed. */
+#define Trc_OMR_Test_Int_Varargs(thr, P1) \
+	omr_test_UtModuleInfo.intf->Trace(UT_THREAD(thr), &omr_test_UtModuleInfo, ((3u << 8) | omr_test_UtActive[3]), "\4", P1)
+#define Trc_OMR_Test_Ptr_Varargs(thr, P1) \
+	omr_test_UtModuleInfo.intf->Trace(UT_THREAD(thr), &omr_test_UtModuleInfo, ((2u << 8) | omr_test_UtActive[2]), "\6", P1)
+
+typedef struct CapturedTracePoints {
+	PerThreadWrapBuffer wrapBuffer;
+	uint32_t count;
+	uint32_t id[MAX_CAPTURED_TRACEPOINTS];
+	uint32_t length[MAX_CAPTURED_TRACEPOINTS];
+	uint8_t data[MAX_CAPTURED_TRACEPOINTS][MAX_CAPTURED_BYTES];
+} CapturedTracePoints;
+
+static omr_error_t captureTracePoints(UtSubscription *subscriptionID);
+static omr_error_t captureTracePointsIter(void *userData, const char *tpMod, const uint32_t tpModLength, const uint32_t tpId,
+		const UtTraceRecord *record, uint32_t firstParameterOffset, uint32_t parameterDataLength, int32_t isBigEndian);
+
+TEST(RASTracePointBenchmark, PackedArgumentsMatchVarargs)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(rasTestEnv->getPortLibrary());
+	OMRTestVM testVM;
+	OMR_VMThread *vmthread = NULL;
+	const OMR_TI *ti = omr_agent_getTI();
+	UtSubscription *subscription = NULL;
+	CapturedTracePoints captured;
+
+	memset(&captured, 0, sizeof(captured));
+	initWrapBuffer(&captured.wrapBuffer);
+
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMInit(&testVM, OMRPORTLIB));
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_initTraceEngine(&testVM.omrVM, "buffers=1k:maximal=all:maximal=!j9thr", NULL));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Init(&testVM.omrVM, NULL, &vmthread, "packedArguments"));
+	UT_OMR_TEST_MODULE_LOADED(testVM.omrVM._trcEngine->utIntf);
+
+	OMRTEST_ASSERT_ERROR_NONE(
+		ti->RegisterRecordSubscriber(vmthread, "packed", captureTracePoints, NULL, (void *)&captured, &subscription));
+
+	Trc_OMR_Test_Int(vmthread, 0x12345678);
+	Trc_OMR_Test_Int_Varargs(vmthread, 0x12345678);
+	Trc_OMR_Test_Ptr(vmthread, vmthread);
+	Trc_OMR_Test_Ptr_Varargs(vmthread, vmthread);
+
+	/* Fill the 1k buffer so that it is published to the subscriber. */
+	for (uint32_t i = 0; i < 100; i++) {
+		Trc_OMR_Test_String(vmthread, "filler");
+	}
+	OMRTEST_ASSERT_ERROR_NONE(ti->FlushTraceData(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(ti->DeregisterRecordSubscriber(vmthread, subscription));
+
+	UT_OMR_TEST_MODULE_UNLOADED(testVM.omrVM._trcEngine->utIntf);
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_cleanupTraceEngine(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Free(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMFini(&testVM));
+	freeWrapBuffer(&captured.wrapBuffer);
+
+	ASSERT_EQ((uint32_t)MAX_CAPTURED_TRACEPOINTS, captured.count);
+	for (uint32_t i = 0; i < MAX_CAPTURED_TRACEPOINTS; i += 2) {
+		EXPECT_EQ(captured.id[i], captured.id[i + 1]);
+		ASSERT_EQ(captured.length[i], captured.length[i + 1]) << "omr_test." << captured.id[i];
+		EXPECT_EQ(0, memcmp(captured.data[i], captured.data[i + 1], captured.length[i])) << "omr_test." << captured.id[i];
+		EXPECT_EQ((3 == captured.id[i]) ? sizeof(int32_t) : sizeof(void *), captured.length[i]) << "omr_test." << captured.id[i];
+	}
+}
+
+TEST(RASTracePointBenchmark, NanosecondsPerTracePoint)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(rasTestEnv->getPortLibrary());
+	OMRTestVM testVM;
+	OMR_VMThread *vmthread = NULL;
+	uint64_t start = 0;
+	uint64_t varargsNanos = 0;
+	uint64_t packedNanos = 0;
+
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMInit(&testVM, OMRPORTLIB));
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_initTraceEngine(&testVM.omrVM, "maximal=all:maximal=!j9thr", NULL));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Init(&testVM.omrVM, NULL, &vmthread, "tracePointBenchmark"));
+	UT_OMR_TEST_MODULE_LOADED(testVM.omrVM._trcEngine->utIntf);
+
+	/* warm up the thread's trace buffer */
+	for (uint32_t i = 0; i < 1000; i++) {
+		Trc_OMR_Test_Int(vmthread, i);
+		Trc_OMR_Test_Int_Varargs(vmthread, i);
+	}
+
+	start = omrtime_nano_time();
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		Trc_OMR_Test_Int_Varargs(vmthread, i);
+	}
+	varargsNanos = omrtime_nano_time() - start;
+
+	start = omrtime_nano_time();
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		Trc_OMR_Test_Int(vmthread, i);
+	}
+	packedNanos = omrtime_nano_time() - start;
+
+	omrtty_printf("maximal tracepoint with one int: varargs=%.1f ns packed=%.1f ns\n",
+		(double)varargsNanos / BENCHMARK_ITERATIONS, (double)packedNanos / BENCHMARK_ITERATIONS);
+
+	start = omrtime_nano_time();
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		Trc_OMR_Test_Ptr_Varargs(vmthread, vmthread);
+	}
+	varargsNanos = omrtime_nano_time() - start;
+
+	start = omrtime_nano_time();
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		Trc_OMR_Test_Ptr(vmthread, vmthread);
+	}
+	packedNanos = omrtime_nano_time() - start;
+
+	omrtty_printf("maximal tracepoint with one pointer: varargs=%.1f ns packed=%.1f ns\n",
+		(double)varargsNanos / BENCHMARK_ITERATIONS, (double)packedNanos / BENCHMARK_ITERATIONS);
+
+	UT_OMR_TEST_MODULE_UNLOADED(testVM.omrVM._trcEngine->utIntf);
+	OMRTEST_ASSERT_ERROR_NONE(omr_ras_cleanupTraceEngine(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(OMR_Thread_Free(vmthread));
+	OMRTEST_ASSERT_ERROR_NONE(omrTestVMFini(&testVM));
+}
+
+static omr_error_t
+captureTracePoints(UtSubscription *subscriptionID)
+{
+	CapturedTracePoints *captured = (CapturedTracePoints *)subscriptionID->userData;
+	return processTraceRecord(&captured->wrapBuffer, subscriptionID, captureTracePointsIter, captured);
+}
+
+static omr_error_t
+captureTracePointsIter(void *userData, const char *tpMod, const uint32_t tpModLength, const uint32_t tpId,
+		const UtTraceRecord *record, uint32_t firstParameterOffset, uint32_t parameterDataLength, int32_t isBigEndian)
+{
+	CapturedTracePoints *captured = (CapturedTracePoints *)userData;
+	const uint32_t omr_test_len = sizeof("omr_test") - 1;
+
+	/* Trc_OMR_Test_Ptr is omr_test.2 and Trc_OMR_Test_Int is omr_test.3 */
+	if ((omr_test_len == tpModLength) && (0 == memcmp("omr_test", tpMod, omr_test_len))
+		&& ((2 == tpId) || (3 == tpId))
+		&& (captured->count < MAX_CAPTURED_TRACEPOINTS)
+		&& (parameterDataLength <= MAX_CAPTURED_BYTES)
+	) {
+		uint32_t i = captured->count;
+		captured->id[i] = tpId;
+		captured->length[i] = parameterDataLength;
+		for (uint32_t j = 0; j < parameterDataLength; j++) {
+			captured->data[i][j] = getU8FromTraceRecord(record, firstParameterOffset + j);
+		}
+		captured->count += 1;
+	}
+	return OMR_ERROR_NONE;
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/*
+ * Compares the chained and open addressed (J9HASH_TABLE_OPEN_ADDRESSING) J9HashTable
+ * implementations: insert and lookup throughput and memory used per entry.
+ */
+
+#include "omrport.h"
+#include "hashtable_api.h"
+
+#include "omrTest.h"
+#include "testEnvironment.hpp"
+
+extern PortEnvironment *omrTestEnv;
+
+#define HASHTABLE_BENCHMARK_MIN_LOOKUPS 1000000
+/* prime stride used to visit the keys in a different order than they were inserted */
+#define HASHTABLE_BENCHMARK_LOOKUP_STRIDE 7919
+
+typedef struct HashtableBenchmarkResult {
+	uint64_t insertNanos;
+	uint64_t hitNanos;
+	uint64_t missNanos;
+	uintptr_t lookups;
+	uintptr_t liveBytes;
+} HashtableBenchmarkResult;
+
+static uintptr_t
+benchmarkHashFn(void *entry, void *userData)
+{
+	return *(uintptr_t *)entry;
+}
+
+static uintptr_t
+benchmarkHashEqualFn(void *leftEntry, void *rightEntry, void *userData)
+{
+	return *(uintptr_t *)leftEntry == *(uintptr_t *)rightEntry;
+}
+
+/* Spread sequential indices over the key space; multiplying by an odd constant is a bijection */
+static uintptr_t
+benchmarkKey(uintptr_t i)
+{
+#if defined(OMR_ENV_DATA64)
+	return (i + 1) * (uintptr_t)J9CONST64(0x9E3779B97F4A7C15);
+#else /* OMR_ENV_DATA64 */
+	return (i + 1) * (uintptr_t)0x9E3779B1;
+#endif /* OMR_ENV_DATA64 */
+}
+
+static uintptr_t
+liveBytesWalkFn(uint32_t categoryCode, const char *categoryName, uintptr_t liveBytes, uintptr_t liveAllocations, BOOLEAN isRoot, uint32_t parentCategoryCode, OMRMemCategoryWalkState *state)
+{
+	if ((uintptr_t)categoryCode == (uintptr_t)state->userData1) {
+		*(uintptr_t *)state->userData2 = liveBytes;
+		return J9MEM_CATEGORIES_STOP_ITERATING;
+	}
+	return J9MEM_CATEGORIES_KEEP_ITERATING;
+}
+
+static uintptr_t
+categoryLiveBytes(OMRPortLibrary *portLib, uint32_t categoryCode)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	OMRMemCategoryWalkState walkState;
+	uintptr_t liveBytes = 0;
+
+	memset(&walkState, 0, sizeof(walkState));
+	walkState.walkFunction = liveBytesWalkFn;
+	walkState.userData1 = (void *)(uintptr_t)categoryCode;
+	walkState.userData2 = &liveBytes;
+	omrmem_walk_categories(&walkState);
+	return liveBytes;
+}
+
+static void
+runHashtableBenchmark(OMRPortLibrary *portLib, uint32_t flags, uintptr_t count, HashtableBenchmarkResult *result)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	uintptr_t rounds = (HASHTABLE_BENCHMARK_MIN_LOOKUPS + count - 1) / count;
+	uintptr_t bytesBefore = categoryLiveBytes(portLib, OMRMEM_CATEGORY_UNKNOWN);
+	uintptr_t found = 0;
+	uintptr_t i = 0;
+	uintptr_t round = 0;
+	uint64_t start = 0;
+
+	J9HashTable *table = hashTableNew(portLib, OMR_GET_CALLSITE(), 0, sizeof(uintptr_t), sizeof(uintptr_t), flags, OMRMEM_CATEGORY_UNKNOWN, benchmarkHashFn, benchmarkHashEqualFn, NULL, NULL);
+	ASSERT_TRUE(NULL != table);
+
+	start = omrtime_nano_time();
+	for (i = 0; i < count; i++) {
+		uintptr_t key = benchmarkKey(i);
+		ASSERT_TRUE(NULL != hashTableAdd(table, &key));
+	}
+	result->insertNanos = omrtime_nano_time() - start;
+	result->liveBytes = categoryLiveBytes(portLib, OMRMEM_CATEGORY_UNKNOWN) - bytesBefore;
+	ASSERT_EQ(count, (uintptr_t)hashTableGetCount(table));
+
+	start = omrtime_nano_time();
+	for (round = 0; round < rounds; round++) {
+		for (i = 0; i < count; i++) {
+			uintptr_t key = benchmarkKey((i * HASHTABLE_BENCHMARK_LOOKUP_STRIDE) % count);
+			if (NULL != hashTableFind(table, &key)) {
+				found += 1;
+			}
+		}
+	}
+	result->hitNanos = omrtime_nano_time() - start;
+	ASSERT_EQ(rounds * count, found);
+
+	found = 0;
+	start = omrtime_nano_time();
+	for (round = 0; round < rounds; round++) {
+		for (i = 0; i < count; i++) {
+			uintptr_t key = benchmarkKey(count + ((i * HASHTABLE_BENCHMARK_LOOKUP_STRIDE) % count));
+			if (NULL != hashTableFind(table, &key)) {
+				found += 1;
+			}
+		}
+	}
+	result->missNanos = omrtime_nano_time() - start;
+	ASSERT_EQ((uintptr_t)0, found);
+
+	result->lookups = rounds * count;
+	hashTableFree(table);
+}
+
+static void
+reportHashtableBenchmark(OMRPortLibrary *portLib, const char *name, uintptr_t count, HashtableBenchmarkResult *result)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+
+	omrtty_printf("%-8s entries=%8zu insert=%5zu ns/op find(hit)=%5zu ns/op find(miss)=%5zu ns/op memory=%5zu.%02zu bytes/entry\n",
+		name,
+		count,
+		(uintptr_t)(result->insertNanos / count),
+		(uintptr_t)(result->hitNanos / result->lookups),
+		(uintptr_t)(result->missNanos / result->lookups),
+		result->liveBytes / count,
+		((result->liveBytes % count) * 100) / count);
+}
+
+TEST(UtilTest, hashtableBenchmark)
+{
+	const uintptr_t counts[] = {100, 10000, 1000000};
+	OMRPortLibrary *portLib = omrTestEnv->getPortLibrary();
+
+	for (uintptr_t i = 0; i < (sizeof(counts) / sizeof(counts[0])); i++) {
+		HashtableBenchmarkResult chained;
+		HashtableBenchmarkResult open;
+
+		memset(&chained, 0, sizeof(chained));
+		memset(&open, 0, sizeof(open));
+		runHashtableBenchmark(portLib, 0, counts[i], &chained);
+		runHashtableBenchmark(portLib, J9HASH_TABLE_OPEN_ADDRESSING, counts[i], &open);
+		reportHashtableBenchmark(portLib, "chained", counts[i], &chained);
+		reportHashtableBenchmark(portLib, "open", counts[i], &open);
+	}
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/*
+ * Measures J9HookDispatch latency for an event with 0 to 16 listeners attached, both
+ * with every listener call timed for the hook dump information (the default) and with
+ * timing sampled once every 100 calls.
+ */
+
+#include "omrport.h"
+#include "omrhookable.h"
+#include "hookable_api.h"
+
+#include "omrTest.h"
+#include "testEnvironment.hpp"
+
+extern PortEnvironment *omrTestEnv;
+
+#define HOOK_BENCHMARK_EVENT 1
+#define HOOK_BENCHMARK_EVENT_COUNT 2
+#define HOOK_BENCHMARK_DISPATCHES 1000000
+#define HOOK_BENCHMARK_SAMPLING_INTERVAL 100
+
+/* Same layout as an interface produced by hookgen, with HOOK_BENCHMARK_EVENT_COUNT events. */
+typedef struct BenchmarkHookInterface {
+	struct J9CommonHookInterface common;
+	uint8_t flags[HOOK_BENCHMARK_EVENT_COUNT];
+	struct OMREventInfo4Dump infos4Dump[HOOK_BENCHMARK_EVENT_COUNT];
+	J9HookRecord *hooks[HOOK_BENCHMARK_EVENT_COUNT];
+} BenchmarkHookInterface;
+
+static void
+benchmarkListener(J9HookInterface **hookInterface, uintptr_t eventNum, void *eventData, void *userData)
+{
+	*(uintptr_t *)eventData += 1;
+}
+
+TEST(UtilTest, hookDispatchBenchmark)
+{
+	const uintptr_t listenerCounts[] = {0, 1, 4, 16};
+	OMRPortLibrary *portLib = omrTestEnv->getPortLibrary();
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	BenchmarkHookInterface benchmarkInterface;
+	J9HookInterface **hookInterface = J9_HOOK_INTERFACE(benchmarkInterface);
+	uintptr_t registered = 0;
+
+	ASSERT_EQ(0, J9HookInitializeInterface(hookInterface, portLib, sizeof(benchmarkInterface)));
+
+	for (uintptr_t i = 0; i < (sizeof(listenerCounts) / sizeof(listenerCounts[0])); i++) {
+		uintptr_t calls = 0;
+		uint64_t elapsed[2];
+
+		while (registered < listenerCounts[i]) {
+			registered += 1;
+			ASSERT_EQ(0, (*hookInterface)->J9HookRegisterWithCallSite(hookInterface, HOOK_BENCHMARK_EVENT, benchmarkListener, OMR_GET_CALLSITE(), (void *)registered));
+		}
+
+		for (uintptr_t sampled = 0; sampled < 2; sampled++) {
+			uintptr_t taggedEvent = HOOK_BENCHMARK_EVENT;
+			uint64_t start = 0;
+
+			if (1 == sampled) {
+				taggedEvent |= (HOOK_BENCHMARK_SAMPLING_INTERVAL << 16) & J9HOOK_TAG_SAMPLING_MASK;
+			}
+			calls = 0;
+			start = omrtime_nano_time();
+			for (uintptr_t d = 0; d < HOOK_BENCHMARK_DISPATCHES; d++) {
+				/* dispatch the way the TRIGGER_ macros generated by hookgen do */
+				if (J9_EVENT_IS_HOOKED(benchmarkInterface, HOOK_BENCHMARK_EVENT)) {
+					(*hookInterface)->J9HookDispatch(hookInterface, taggedEvent, &calls);
+				}
+			}
+			elapsed[sampled] = omrtime_nano_time() - start;
+			ASSERT_EQ(registered * HOOK_BENCHMARK_DISPATCHES, calls);
+		}
+
+		omrtty_printf("listeners=%2zu dispatch=%5zu ns/event sampled(1/%d)=%5zu ns/event\n",
+			registered,
+			(uintptr_t)(elapsed[0] / HOOK_BENCHMARK_DISPATCHES),
+			HOOK_BENCHMARK_SAMPLING_INTERVAL,
+			(uintptr_t)(elapsed[1] / HOOK_BENCHMARK_DISPATCHES));
+	}
+
+	(*hookInterface)->J9HookShutdownInterface(hookInterface);
+}
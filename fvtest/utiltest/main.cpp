@@ -25,13 +25,25 @@
 #include "omrutil.h"
 
 #include "omrTest.h"
+#include "testEnvironment.hpp"
+
+extern "C" {
+int omr_main_entry(int argc, char **argv, char **envp);
+}
+
+PortEnvironment *omrTestEnv;
 
 int
-main(int argc, char **argv, char **envp)
+omr_main_entry(int argc, char **argv, char **envp)
 {
 	::testing::InitGoogleTest(&argc, argv);
 	OMREventListener::setDefaultTestListener();
-	return RUN_ALL_TESTS();
+
+	INITIALIZE_THREADLIBRARY_AND_ATTACH();
+	omrTestEnv = (PortEnvironment *)testing::AddGlobalTestEnvironment(new PortEnvironment(argc, argv));
+	int result = RUN_ALL_TESTS();
+	DETACH_AND_DESTROY_THREADLIBRARY();
+	return result;
 }
 
 TEST(UtilTest, detectVMDirectory)
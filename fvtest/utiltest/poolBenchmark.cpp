@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/*
+ * Measures J9Pool allocate/free throughput under contention: a pool protected by an
+ * external monitor (the usual pattern) against a pool using thread-local magazines
+ * (POOL_THREAD_MAGAZINES) with no external lock.
+ */
+
+#include "omrport.h"
+#include "omrthread.h"
+#include "omrutil.h"
+#include "pool_api.h"
+
+#include "omrTest.h"
+#include "testEnvironment.hpp"
+
+extern PortEnvironment *omrTestEnv;
+
+#define POOL_BENCHMARK_OPERATIONS 2000000
+#define POOL_BENCHMARK_LIVE_ELEMENTS 4
+#define POOL_BENCHMARK_ELEMENT_SIZE 64
+
+typedef struct PoolBenchmarkData {
+	J9Pool *pool;
+	omrthread_monitor_t poolMonitor;
+	omrthread_monitor_t controlMonitor;
+	uintptr_t useMagazines;
+	uintptr_t operationsPerThread;
+	uintptr_t startedThreads;
+	uintptr_t finishedThreads;
+	uintptr_t go;
+	uintptr_t failures;
+} PoolBenchmarkData;
+
+static int J9THREAD_PROC
+poolBenchmarkThread(void *arg)
+{
+	PoolBenchmarkData *data = (PoolBenchmarkData *)arg;
+	void *live[POOL_BENCHMARK_LIVE_ELEMENTS];
+	uintptr_t failures = 0;
+	uintptr_t done = 0;
+	uintptr_t i = 0;
+
+	omrthread_monitor_enter(data->controlMonitor);
+	data->startedThreads += 1;
+	omrthread_monitor_notify_all(data->controlMonitor);
+	while (0 == data->go) {
+		omrthread_monitor_wait(data->controlMonitor);
+	}
+	omrthread_monitor_exit(data->controlMonitor);
+
+	while (done < data->operationsPerThread) {
+		for (i = 0; i < POOL_BENCHMARK_LIVE_ELEMENTS; i++) {
+			if (data->useMagazines) {
+				live[i] = pool_newElement(data->pool);
+			} else {
+				omrthread_monitor_enter(data->poolMonitor);
+				live[i] = pool_newElement(data->pool);
+				omrthread_monitor_exit(data->poolMonitor);
+			}
+			if (NULL == live[i]) {
+				failures += 1;
+			}
+		}
+		for (i = 0; i < POOL_BENCHMARK_LIVE_ELEMENTS; i++) {
+			if (data->useMagazines) {
+				pool_removeElement(data->pool, live[i]);
+			} else {
+				omrthread_monitor_enter(data->poolMonitor);
+				pool_removeElement(data->pool, live[i]);
+				omrthread_monitor_exit(data->poolMonitor);
+			}
+		}
+		done += 2 * POOL_BENCHMARK_LIVE_ELEMENTS;
+	}
+
+	omrthread_monitor_enter(data->controlMonitor);
+	data->failures += failures;
+	data->finishedThreads += 1;
+	omrthread_monitor_notify_all(data->controlMonitor);
+	omrthread_monitor_exit(data->controlMonitor);
+
+	return 0;
+}
+
+static uint64_t
+runPoolBenchmark(OMRPortLibrary *portLib, uintptr_t useMagazines, uintptr_t threadCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	PoolBenchmarkData data;
+	uint64_t start = 0;
+	uint64_t elapsed = 0;
+	uintptr_t i = 0;
+
+	memset(&data, 0, sizeof(data));
+	data.useMagazines = useMagazines;
+	data.operationsPerThread = POOL_BENCHMARK_OPERATIONS / threadCount;
+	data.pool = pool_new(POOL_BENCHMARK_ELEMENT_SIZE, 0, 0, useMagazines ? POOL_THREAD_MAGAZINES : 0, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_VM, POOL_FOR_PORT(portLib));
+	EXPECT_TRUE(NULL != data.pool);
+	EXPECT_EQ(0, omrthread_monitor_init_with_name(&data.poolMonitor, 0, "poolBenchmarkPool"));
+	EXPECT_EQ(0, omrthread_monitor_init_with_name(&data.controlMonitor, 0, "poolBenchmarkControl"));
+
+	for (i = 0; i < threadCount; i++) {
+		omrthread_t thread = NULL;
+		EXPECT_EQ(0, omrthread_create(&thread, 0, J9THREAD_PRIORITY_NORMAL, 0, poolBenchmarkThread, &data));
+	}
+
+	omrthread_monitor_enter(data.controlMonitor);
+	while (data.startedThreads < threadCount) {
+		omrthread_monitor_wait(data.controlMonitor);
+	}
+	start = omrtime_nano_time();
+	data.go = 1;
+	omrthread_monitor_notify_all(data.controlMonitor);
+	while (data.finishedThreads < threadCount) {
+		omrthread_monitor_wait(data.controlMonitor);
+	}
+	elapsed = omrtime_nano_time() - start;
+	omrthread_monitor_exit(data.controlMonitor);
+
+	EXPECT_EQ((uintptr_t)0, data.failures);
+	EXPECT_EQ((uintptr_t)0, pool_numElements(data.pool));
+
+	omrthread_monitor_destroy(data.controlMonitor);
+	omrthread_monitor_destroy(data.poolMonitor);
+	pool_kill(data.pool);
+
+	return elapsed / (data.operationsPerThread * threadCount);
+}
+
+TEST(UtilTest, poolContentionBenchmark)
+{
+	const uintptr_t threadCounts[] = {1, 2, 4, 8};
+	OMRPortLibrary *portLib = omrTestEnv->getPortLibrary();
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+
+	for (uintptr_t i = 0; i < (sizeof(threadCounts) / sizeof(threadCounts[0])); i++) {
+		uint64_t locked = runPoolBenchmark(portLib, FALSE, threadCounts[i]);
+		uint64_t magazines = runPoolBenchmark(portLib, TRUE, threadCounts[i]);
+
+		omrtty_printf("threads=%2zu locked=%5zu ns/op magazines=%5zu ns/op\n",
+			threadCounts[i], (uintptr_t)locked, (uintptr_t)magazines);
+	}
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+/*
+ * Verifies OMRZeroMemory on unaligned areas of every size class it distinguishes, and
+ * compares its throughput against memset over a sweep of sizes.
+ */
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omrutil.h"
+
+#include "omrTest.h"
+#include "testEnvironment.hpp"
+
+extern PortEnvironment *omrTestEnv;
+
+#define ZERO_BENCHMARK_BYTES_PER_SIZE ((uintptr_t)256 * 1024 * 1024)
+#define ZERO_BENCHMARK_MAX_SIZE ((uintptr_t)64 * 1024 * 1024)
+#define ZERO_TEST_GUARD 64
+#define ZERO_TEST_FILL 0xA5
+
+static bool
+checkZeroed(const uint8_t *buffer, uintptr_t offset, uintptr_t length, uintptr_t bufferSize)
+{
+	for (uintptr_t i = 0; i < bufferSize; i++) {
+		uint8_t expected = ((i >= offset) && (i < (offset + length))) ? 0 : ZERO_TEST_FILL;
+		if (buffer[i] != expected) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST(UtilTest, zeroMemory)
+{
+	const uintptr_t lengths[] = {0, 1, 7, 63, 255, 256, 257, 1000, 2047, 2048, 4099, 65536 + 24, 1024 * 1024, 3 * 1024 * 1024 + 40};
+	OMRPORT_ACCESS_FROM_OMRPORT(omrTestEnv->getPortLibrary());
+	uintptr_t bufferSize = lengths[(sizeof(lengths) / sizeof(lengths[0])) - 1] + (2 * ZERO_TEST_GUARD);
+	uint8_t *buffer = (uint8_t *)omrmem_allocate_memory(bufferSize, OMRMEM_CATEGORY_VM);
+
+	ASSERT_TRUE(NULL != buffer);
+	for (uintptr_t i = 0; i < (sizeof(lengths) / sizeof(lengths[0])); i++) {
+		for (uintptr_t offset = 0; offset < ZERO_TEST_GUARD; offset += 8) {
+			memset(buffer, ZERO_TEST_FILL, bufferSize);
+			OMRZeroMemory(buffer + offset, lengths[i]);
+			ASSERT_TRUE(checkZeroed(buffer, offset, lengths[i], bufferSize)) << "length=" << lengths[i] << " offset=" << offset;
+		}
+	}
+	omrmem_free_memory(buffer);
+}
+
+/*
+ * From 8MB on OMRZeroMemory uses streaming stores, with overlapping unaligned stores for the
+ * head and tail of the area. Odd starts and odd lengths make both of them partial.
+ */
+TEST(UtilTest, zeroMemoryNonTemporal)
+{
+	const uintptr_t megabyte = 1024 * 1024;
+	const uintptr_t lengths[] = {8 * megabyte, 8 * megabyte + 1, 8 * megabyte + 63, 8 * megabyte + 4097, 9 * megabyte + 33, 12 * megabyte + 7};
+	const uintptr_t offsets[] = {0, 1, 7, 31, 33, ZERO_TEST_GUARD - 1};
+	OMRPORT_ACCESS_FROM_OMRPORT(omrTestEnv->getPortLibrary());
+	/* a full guard before the area as well as after it */
+	uintptr_t bufferSize = lengths[(sizeof(lengths) / sizeof(lengths[0])) - 1] + (3 * ZERO_TEST_GUARD);
+	uint8_t *buffer = (uint8_t *)omrmem_allocate_memory(bufferSize, OMRMEM_CATEGORY_VM);
+
+	ASSERT_TRUE(NULL != buffer);
+	for (uintptr_t i = 0; i < (sizeof(lengths) / sizeof(lengths[0])); i++) {
+		for (uintptr_t j = 0; j < (sizeof(offsets) / sizeof(offsets[0])); j++) {
+			uintptr_t start = ZERO_TEST_GUARD + offsets[j];
+
+			memset(buffer, ZERO_TEST_FILL, bufferSize);
+			OMRZeroMemory(buffer + start, lengths[i]);
+			ASSERT_TRUE(checkZeroed(buffer, start, lengths[i], bufferSize)) << "length=" << lengths[i] << " offset=" << offsets[j];
+		}
+	}
+	omrmem_free_memory(buffer);
+}
+
+TEST(UtilTest, zeroMemoryBenchmark)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(omrTestEnv->getPortLibrary());
+	uint8_t *buffer = (uint8_t *)omrmem_allocate_memory(ZERO_BENCHMARK_MAX_SIZE, OMRMEM_CATEGORY_VM);
+
+	ASSERT_TRUE(NULL != buffer);
+	/* touch every page up front so that page faults are not measured */
+	memset(buffer, ZERO_TEST_FILL, ZERO_BENCHMARK_MAX_SIZE);
+
+	for (uintptr_t size = 64; size <= ZERO_BENCHMARK_MAX_SIZE; size *= 4) {
+		uintptr_t iterations = ZERO_BENCHMARK_BYTES_PER_SIZE / size;
+		uint64_t memsetNanos = 0;
+		uint64_t zeroNanos = 0;
+		uint64_t start = 0;
+
+		start = omrtime_nano_time();
+		for (uintptr_t i = 0; i < iterations; i++) {
+			memset(buffer, 0, size);
+			/* keep the compiler from dropping or merging the stores */
+			((volatile uint8_t *)buffer)[0] = 1;
+		}
+		memsetNanos = omrtime_nano_time() - start;
+
+		start = omrtime_nano_time();
+		for (uintptr_t i = 0; i < iterations; i++) {
+			OMRZeroMemory(buffer, size);
+			((volatile uint8_t *)buffer)[0] = 1;
+		}
+		zeroNanos = omrtime_nano_time() - start;
+
+		/* bytes per nanosecond is GB/s */
+		omrtty_printf("size=%9zu memset=%6.2f GB/s OMRZeroMemory=%6.2f GB/s\n",
+			size,
+			(double)(iterations * size) / (double)(memsetNanos + 1),
+			(double)(iterations * size) / (double)(zeroNanos + 1));
+	}
+	omrmem_free_memory(buffer);
+}
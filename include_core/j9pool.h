@@ -57,6 +57,7 @@ typedef struct J9PoolPuddle {
 	J9WSRP nextAvailablePuddle;
 	uintptr_t userData;
 	uintptr_t flags;
+	uintptr_t reservedElements;
 } J9PoolPuddle;
 
 
@@ -79,16 +80,37 @@ typedef struct J9Pool {
 	uint16_t alignment;
 	uint16_t flags;
 	uint32_t memoryCategory;
+	uintptr_t magazineLock;
+	uintptr_t magazineLockDepth;
+	uintptr_t magazineId;
+	struct J9PoolMagazine *magazines;
+	struct J9Pool *nextMagazinePool;
+	struct J9Pool *prevMagazinePool;
 } J9Pool;
 
+#define POOL_MAGAZINE_SIZE  32
+
+/*
+ * @ddr_namespace: map_to_type=J9PoolMagazine
+ */
+
+typedef struct J9PoolMagazine {
+	struct J9PoolMagazine *next;
+	uintptr_t owner;
+	uintptr_t count;
+	void *elements[POOL_MAGAZINE_SIZE];
+} J9PoolMagazine;
+
 #define POOL_NO_ZERO  8
 #define POOL_ROUND_TO_PAGE_SIZE  16
 #define POOL_USES_HOLES  32
+#define POOL_THREAD_MAGAZINES  64
 #define POOL_NEVER_FREE_PUDDLES  2
 #define POOL_ALLOC_TYPE_PUDDLE  1
 #define POOL_ALWAYS_KEEP_SORTED  4
 #define POOL_ALLOC_TYPE_PUDDLE_LIST  2
 #define POOL_ALLOC_TYPE_POOL  0
+#define POOL_ALLOC_TYPE_MAGAZINE  3
 
 /*
  * @ddr_namespace: map_to_type=J9PoolState
@@ -51,6 +51,13 @@ extern "C" {
 #define J9HASH_TABLE_ALLOCATE_ELEMENTS_USING_MALLOC32	0x00000004	/*!< Allocate table elements using the malloc32 function */
 #define J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION	0x00000008	/*!< Allow space optimized hashTable, some functions not supported */
 #define J9HASH_TABLE_DO_NOT_REHASH	0x00000010	/*!< Do not rehash the table while set */
+#define J9HASH_TABLE_OPEN_ADDRESSING	0x00000020	/*!< Use open addressing with group-probed control bytes instead of chained buckets */
+#define J9HASH_TABLE_CONCURRENT_READ	0x00000040	/*!< Allow hashTableFind() without locking; writers are serialized internally */
+
+/**
+ * Number of reader counters per epoch in a J9HASH_TABLE_CONCURRENT_READ table
+ */
+#define J9HASH_TABLE_READER_STRIPES 16
 
 /*
  * This used to include a cast to uintptr_t, but ddrgen doesn't
@@ -87,6 +94,8 @@ extern "C" {
 * Hash table state queries
 */
 #define hashTableIsSpaceOptimized(table) (NULL == table->listNodePool)
+#define hashTableIsOpenAddressed(table) (J9HASH_TABLE_OPEN_ADDRESSING == ((table)->flags & J9HASH_TABLE_OPEN_ADDRESSING))
+#define hashTableIsConcurrentRead(table) (J9HASH_TABLE_CONCURRENT_READ == ((table)->flags & J9HASH_TABLE_CONCURRENT_READ))
 
 
 struct J9HashTable; /* Forward struct declaration */
@@ -108,7 +117,9 @@ typedef struct J9HashTable {
 	uint32_t flags;
 	uint32_t memoryCategory;
 	uint32_t listToTreeThreshold;
+	uint32_t growthLeft;
 	void **nodes;
+	uint8_t *controlBytes;
 	struct J9Pool *listNodePool;
 	struct J9Pool *treeNodePool;
 	struct J9Pool *treePool;
@@ -120,6 +131,10 @@ typedef struct J9HashTable {
 	void *equalFnUserData;
 	void *hashFnUserData;
 	struct J9HashTable *previous;
+	uintptr_t writerLock;
+	uintptr_t readerEpoch;
+	uintptr_t resizeCount;
+	uintptr_t *readerCounts;
 } J9HashTable;
 
 typedef struct J9HashTableState {
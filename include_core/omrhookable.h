@@ -107,6 +107,11 @@ typedef struct J9CommonHookInterface {
 	struct OMRPortLibrary *portLib;		/* for accessing PortLibrary  */
 	uint64_t threshold4Trace;			/* the threshold for triggering tracepoint */
 	uintptr_t eventSize;				/* how many events supported by this hook interface */
+	struct J9HookSnapshot **snapshots;	/* per-event immutable listener arrays used by dispatch, NULL entries fall back to the records */
+	struct J9HookSnapshot *retiredSnapshots;	/* snapshots replaced since the draining snapshots were retired */
+	struct J9HookSnapshot *drainingSnapshots;	/* snapshots freed once every dispatch in drainingWaits has returned */
+	struct J9HookDispatchWait *drainingWaits;	/* the dispatches which were in progress when the draining snapshots were retired */
+	uintptr_t drainingWaitCount;		/* number of entries in drainingWaits */
 } J9CommonHookInterface;
 
 
@@ -125,6 +130,33 @@ typedef struct J9HookRecord {
 	uintptr_t agentID;
 } J9HookRecord;
 
+/*
+ * A copy of the valid listeners of an event, in dispatch order. Snapshots are never modified
+ * once published: registration builds and publishes a new one. The record id captured in
+ * each entry lets dispatch skip listeners which were unregistered after the snapshot was taken.
+ */
+typedef struct J9HookSnapshotEntry {
+	struct J9HookRecord *record;
+	uintptr_t id;
+	J9HookFunction function;
+	void *userData;
+} J9HookSnapshotEntry;
+
+typedef struct J9HookSnapshot {
+	struct J9HookSnapshot *nextRetired;
+	uintptr_t count;
+	struct J9HookSnapshotEntry entries[1];
+} J9HookSnapshot;
+
+/*
+ * A dispatch which may still read retired snapshots: the dispatch slot of its thread and the
+ * sequence number of that slot when the snapshots were retired.
+ */
+typedef struct J9HookDispatchWait {
+	uintptr_t slot;
+	uintptr_t sequence;
+} J9HookDispatchWait;
+
 
 /* magic hooks supported by every hook interface */
 
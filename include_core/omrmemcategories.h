@@ -31,6 +31,11 @@
 
 #include "omrcfg.h"
 
+typedef struct OMRMemCategoryCounters {
+	uintptr_t liveBytes;
+	uintptr_t liveAllocations;
+} OMRMemCategoryCounters;
+
 typedef struct OMRMemCategory {
 	const char *const name;
 	const uint32_t categoryCode;
@@ -38,6 +43,12 @@ typedef struct OMRMemCategory {
 	uintptr_t liveAllocations;
 	const uint32_t numberOfChildren;
 	const uint32_t *const children;
+	/* Per-CPU counter stripes installed by the port library when the category set is registered.
+	 * Stripe n is at ((uint8_t *)counterStripes + (n * counterStripeStride)). The live totals are
+	 * liveBytes/liveAllocations plus the sum over all stripes; see omrmem_walk_categories.
+	 */
+	OMRMemCategoryCounters *counterStripes;
+	uintptr_t counterStripeStride;
 } OMRMemCategory;
 
 typedef struct OMRMemCategorySet {
@@ -90,31 +101,31 @@ typedef struct OMRMemCategorySet {
 #define OMRMEM_OMR_CATEGORY_INDEX_FROM_CODE(code) (((uint32_t)0x7FFFFFFF) & (code))
 
 #define OMRMEM_CATEGORY_NO_CHILDREN(description, code) \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 0, NULL}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 0, NULL, NULL, 0}
 #define OMRMEM_CATEGORY_1_CHILD(description, code, c1) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 1, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 1, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_2_CHILDREN(description, code, c1, c2) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 2, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 2, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_3_CHILDREN(description, code, c1, c2, c3) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 3, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 3, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_4_CHILDREN(description, code, c1, c2, c3, c4) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3, c4}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 4, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 4, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_5_CHILDREN(description, code, c1, c2, c3, c4, c5) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3, c4, c5}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 5, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 5, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_6_CHILDREN(description, code, c1, c2, c3, c4, c5, c6) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3, c4, c5, c6}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 6, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 6, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_7_CHILDREN(description, code, c1, c2, c3, c4, c5, c6, c7) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3, c4, c5, c6, c7}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 7, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 7, _omrmem_##code##_child_categories, NULL, 0}
 #define OMRMEM_CATEGORY_8_CHILDREN(description, code, c1, c2, c3, c4, c5, c6, c7, c8) \
 	static uint32_t _omrmem_##code##_child_categories[] = {c1, c2, c3, c4, c5, c6, c7, c8}; \
-	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 8, _omrmem_##code##_child_categories}
+	static OMRMemCategory _omrmem_category_##code = {description, code, 0, 0, 8, _omrmem_##code##_child_categories, NULL, 0}
 
 #define CATEGORY_TABLE_ENTRY(name) &_omrmem_category_##name
 
@@ -240,6 +240,16 @@
 #define OMRPORT_TIME_DELTA_IN_NANOSECONDS ((uint64_t) 1000000000)
 /** @} */
 
+/**
+ * @name Fast Clock Sources
+ * Counter read by @ref omrtime_fast.c::omrtime_fast_ticks "omrtime_fast_ticks"
+ * @{
+ */
+#define OMRPORT_TIME_FAST_CLOCK_OS 1 /* omrtime_nano_time, ticks are nanoseconds */
+#define OMRPORT_TIME_FAST_CLOCK_TSC 2 /* x86 invariant time stamp counter */
+#define OMRPORT_TIME_FAST_CLOCK_CNTVCT 3 /* AArch64 virtual counter */
+/** @} */
+
 #if defined(S390) || defined(J9ZOS390)
 /**
  * @name Constants to calculate time from high-resolution timer
@@ -319,6 +329,60 @@ typedef struct J9FileStatFilesystem {
 	uint64_t totalSizeBytes;
 } J9FileStatFilesystem;
 
+/**
+ * Describes one buffer of a vectored file operation.
+ */
+typedef struct OMRFileIOVec {
+	void *buffer;
+	uintptr_t length;
+} OMRFileIOVec;
+
+/* Operations accepted by omrfile_async_submit */
+#define OMRPORT_FILE_ASYNC_READ 1
+#define OMRPORT_FILE_ASYNC_WRITE 2
+#define OMRPORT_FILE_ASYNC_READV 3
+#define OMRPORT_FILE_ASYNC_WRITEV 4
+#define OMRPORT_FILE_ASYNC_FSYNC 5
+
+/* Flags accepted by omrfile_async_create */
+#define OMRPORT_FILE_ASYNC_FORCE_THREADS 0x1
+
+/* Values returned by omrfile_async_backend */
+#define OMRPORT_FILE_ASYNC_BACKEND_THREADS 1
+#define OMRPORT_FILE_ASYNC_BACKEND_IO_URING 2
+
+/**
+ * An asynchronous file operation. For READ and WRITE, buffer and length describe
+ * a single buffer; for READV and WRITEV, buffer points to an array of vectorCount
+ * OMRFileIOVec. The buffers (and the vector array) must remain valid until the
+ * matching completion has been returned by omrfile_async_wait. The offset is
+ * always explicit; the file position of fd is neither used nor changed.
+ */
+typedef struct OMRFileAsyncRequest {
+	uint32_t operation;
+	uint32_t vectorCount;
+	intptr_t fd;
+	int64_t offset;
+	void *buffer;
+	uintptr_t length;
+	void *userData;
+} OMRFileAsyncRequest;
+
+/**
+ * The outcome of an asynchronous file operation. result is the number of bytes
+ * transferred (0 for FSYNC), or a negative portable error code on failure.
+ */
+typedef struct OMRFileAsyncCompletion {
+	void *userData;
+	intptr_t result;
+} OMRFileAsyncCompletion;
+
+/**
+ * A queue of asynchronous file operations.
+ * Private, platform specific implementation.
+ */
+typedef struct OMRFileAsyncContext OMRFileAsyncContext;
+
 /**
  * A handle to a filestream.
  * Private, platform specific implementation.
@@ -423,6 +487,33 @@ typedef struct OMRCgroupMetricIteratorState {
 	char *fileContent;
 } OMRCgroupMetricIteratorState;
 
+/**
+ * @name Memory Pressure Events
+ * Bits requested from omrsysinfo_memory_pressure_register, and the type of each delivered OMRMemoryPressureEvent.
+ * SOME and FULL come from pressure stall information (memory.pressure, or /proc/pressure/memory outside
+ * a cgroup v2 hierarchy); the rest are counters from the cgroup v2 memory.events file.
+ * @{
+ */
+#define OMRPORT_MEMORY_PRESSURE_SOME ((uintptr_t)0x1) /**< some tasks stalled on memory for longer than the threshold */
+#define OMRPORT_MEMORY_PRESSURE_FULL ((uintptr_t)0x2) /**< all tasks stalled on memory for longer than the threshold */
+#define OMRPORT_MEMORY_PRESSURE_HIGH ((uintptr_t)0x4) /**< usage went over memory.high and the cgroup was throttled */
+#define OMRPORT_MEMORY_PRESSURE_MAX ((uintptr_t)0x8) /**< usage was about to go over memory.max */
+#define OMRPORT_MEMORY_PRESSURE_OOM ((uintptr_t)0x10) /**< usage reached memory.max and an allocation failed */
+#define OMRPORT_MEMORY_PRESSURE_OOM_KILL ((uintptr_t)0x20) /**< a process in the cgroup was killed by the OOM killer */
+#define OMRPORT_MEMORY_PRESSURE_PSI (OMRPORT_MEMORY_PRESSURE_SOME | OMRPORT_MEMORY_PRESSURE_FULL)
+#define OMRPORT_MEMORY_PRESSURE_EVENTS (OMRPORT_MEMORY_PRESSURE_HIGH | OMRPORT_MEMORY_PRESSURE_MAX | OMRPORT_MEMORY_PRESSURE_OOM | OMRPORT_MEMORY_PRESSURE_OOM_KILL)
+#define OMRPORT_MEMORY_PRESSURE_ALL (OMRPORT_MEMORY_PRESSURE_PSI | OMRPORT_MEMORY_PRESSURE_EVENTS)
+/** @} */
+
+typedef struct OMRMemoryPressureEvent {
+	uintptr_t type; /**< one OMRPORT_MEMORY_PRESSURE_* bit */
+	uint64_t total; /**< PSI: total stall time in microseconds; memory.events: the counter's value */
+	uint64_t delta; /**< increase of total since the previous reading */
+} OMRMemoryPressureEvent;
+
+struct OMRPortLibrary;
+typedef void (*omrsysinfo_memory_pressure_handler_fn)(struct OMRPortLibrary *portLibrary, const struct OMRMemoryPressureEvent *event, void *userData);
+
 
 
 /**
@@ -718,6 +809,7 @@ typedef struct J9ProcessorInfos {
 #define OMRPORT_CTLDATA_NOIPT  "NOIPT"
 #define OMRPORT_CTLDATA_TIME_CLEAR_TICK_TOCK  "TIME_CLEAR_TICK_TOCK"
 #define OMRPORT_CTLDATA_MEM_CATEGORIES_SET  "MEM_CATEGORIES_SET"
+#define OMRPORT_CTLDATA_MEM_SIZE_CLASS_CACHE  "MEM_SIZE_CLASS_CACHE"
 #define OMRPORT_CTLDATA_AIX_PROC_ATTR  "AIX_PROC_ATTR"
 #define OMRPORT_CTLDATA_ALLOCATE32_COMMIT_SIZE  "ALLOCATE32_COMMIT_SIZE"
 #define OMRPORT_CTLDATA_NOSUBALLOC32BITMEM  "NOSUBALLOC32BITMEM"
@@ -1133,6 +1225,14 @@ typedef struct OMRPortLibrary {
 	uint64_t (*time_hires_frequency)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrtime.c::omrtime_hires_delta "omrtime_hires_delta"*/
 	uint64_t (*time_hires_delta)(struct OMRPortLibrary *portLibrary, uint64_t startTime, uint64_t endTime, uint64_t requiredResolution) ;
+	/** see @ref omrtime_fast.c::omrtime_fast_ticks "omrtime_fast_ticks"*/
+	uint64_t (*time_fast_ticks)(struct OMRPortLibrary *portLibrary) ;
+	/** see @ref omrtime_fast.c::omrtime_fast_ticks_to_nanos "omrtime_fast_ticks_to_nanos"*/
+	uint64_t (*time_fast_ticks_to_nanos)(struct OMRPortLibrary *portLibrary, uint64_t ticks) ;
+	/** see @ref omrtime_fast.c::omrtime_fast_frequency "omrtime_fast_frequency"*/
+	uint64_t (*time_fast_frequency)(struct OMRPortLibrary *portLibrary) ;
+	/** see @ref omrtime_fast.c::omrtime_fast_clock_source "omrtime_fast_clock_source"*/
+	int32_t (*time_fast_clock_source)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_startup "omrsysinfo_startup"*/
 	int32_t (*sysinfo_startup)(struct OMRPortLibrary *portLibrary) ;
 	/** see @ref omrsysinfo.c::omrsysinfo_shutdown "omrsysinfo_shutdown"*/
@@ -1495,10 +1595,30 @@ typedef struct OMRPortLibrary {
 	intptr_t (*file_convert_native_fd_to_omrfile_fd)(struct OMRPortLibrary *portLibrary, intptr_t nativeFD) ;
 	/** see @ref omrfile.c::omrfile_convert_omrfile_fd_to_native_fd "omrfile_convert_omrfile_fd_to_native_fd"*/
 	intptr_t (*file_convert_omrfile_fd_to_native_fd)(struct OMRPortLibrary *portLibrary, intptr_t omrfileFD) ;
+	/** see @ref omrfile.c::omrfile_pread "omrfile_pread"*/
+	intptr_t (*file_pread)(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes, int64_t offset) ;
+	/** see @ref omrfile.c::omrfile_pwrite "omrfile_pwrite"*/
+	intptr_t (*file_pwrite)(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf, intptr_t nbytes, int64_t offset) ;
+	/** see @ref omrfile.c::omrfile_preadv "omrfile_preadv"*/
+	intptr_t (*file_preadv)(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset) ;
+	/** see @ref omrfile.c::omrfile_pwritev "omrfile_pwritev"*/
+	intptr_t (*file_pwritev)(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset) ;
+	/** see @ref omrfile.c::omrfile_copy_range "omrfile_copy_range"*/
+	int64_t (*file_copy_range)(struct OMRPortLibrary *portLibrary, intptr_t fdIn, int64_t offsetIn, intptr_t fdOut, int64_t offsetOut, int64_t length) ;
 	/** see @ref omrfile_blockingasync.c::omrfile_blockingasync_unlock_bytes "omrfile_blockingasync_unlock_bytes"*/
 	int32_t (*file_blockingasync_unlock_bytes)(struct OMRPortLibrary *portLibrary, intptr_t fd, uint64_t offset, uint64_t length) ;
 	/** see @ref omrfile_blockingasync.c::omrfile_blockingasync_lock_bytes "omrfile_blockingasync_lock_bytes"*/
 	int32_t (*file_blockingasync_lock_bytes)(struct OMRPortLibrary *portLibrary, intptr_t fd, int32_t lockFlags, uint64_t offset, uint64_t length) ;
+	/** see @ref omrfile_async.c::omrfile_async_create "omrfile_async_create"*/
+	int32_t (*file_async_create)(struct OMRPortLibrary *portLibrary, uint32_t queueDepth, uint32_t flags, OMRFileAsyncContext **context) ;
+	/** see @ref omrfile_async.c::omrfile_async_submit "omrfile_async_submit"*/
+	intptr_t (*file_async_submit)(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count) ;
+	/** see @ref omrfile_async.c::omrfile_async_wait "omrfile_async_wait"*/
+	intptr_t (*file_async_wait)(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions) ;
+	/** see @ref omrfile_async.c::omrfile_async_backend "omrfile_async_backend"*/
+	int32_t (*file_async_backend)(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context) ;
+	/** see @ref omrfile_async.c::omrfile_async_destroy "omrfile_async_destroy"*/
+	void (*file_async_destroy)(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context) ;
 	/** see @ref omrstr.c::omrstr_ftime "omrstr_ftime"*/
 	uintptr_t (*str_ftime)(struct OMRPortLibrary *portLibrary, char *buf, uintptr_t bufLen, const char *format, int64_t timeMillis) ;
 	/** see @ref omrmmap.c::omrmmap_startup "omrmmap_startup"*/
@@ -1569,6 +1689,10 @@ typedef struct OMRPortLibrary {
 	int32_t (*sysinfo_cgroup_subsystem_iterator_next)(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state, struct OMRCgroupMetricElement *metricElement);
 	/** see @ref omrsysinfo.c::omrsysinfo_cgroup_subsystem_iterator_destroy "omrsysinfo_cgroup_subsystem_iterator_destroy"*/
 	void (*sysinfo_cgroup_subsystem_iterator_destroy)(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state);
+	/** see @ref omrmempressure.c::omrsysinfo_memory_pressure_register "omrsysinfo_memory_pressure_register"*/
+	int32_t (*sysinfo_memory_pressure_register)(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData, uintptr_t events, uint64_t stallMicros, uint64_t windowMicros);
+	/** see @ref omrmempressure.c::omrsysinfo_memory_pressure_unregister "omrsysinfo_memory_pressure_unregister"*/
+	int32_t (*sysinfo_memory_pressure_unregister)(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData);
 	/** see @ref omrport.c::omrport_init_library "omrport_init_library"*/
 	int32_t (*port_init_library)(struct OMRPortLibrary *portLibrary, uintptr_t size) ;
 	/** see @ref omrport.c::omrport_startup_library "omrport_startup_library"*/
@@ -1817,6 +1941,10 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrtime_hires_clock() privateOmrPortLibrary->time_hires_clock(privateOmrPortLibrary)
 #define omrtime_hires_frequency() privateOmrPortLibrary->time_hires_frequency(privateOmrPortLibrary)
 #define omrtime_hires_delta(param1,param2,param3) privateOmrPortLibrary->time_hires_delta(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrtime_fast_ticks() privateOmrPortLibrary->time_fast_ticks(privateOmrPortLibrary)
+#define omrtime_fast_ticks_to_nanos(param1) privateOmrPortLibrary->time_fast_ticks_to_nanos(privateOmrPortLibrary, (param1))
+#define omrtime_fast_frequency() privateOmrPortLibrary->time_fast_frequency(privateOmrPortLibrary)
+#define omrtime_fast_clock_source() privateOmrPortLibrary->time_fast_clock_source(privateOmrPortLibrary)
 #define omrsysinfo_startup() privateOmrPortLibrary->sysinfo_startup(privateOmrPortLibrary)
 #define omrsysinfo_shutdown() privateOmrPortLibrary->sysinfo_shutdown(privateOmrPortLibrary)
 #define omrsysinfo_process_exists(param1) privateOmrPortLibrary->sysinfo_process_exists(privateOmrPortLibrary, (param1))
@@ -1879,6 +2007,11 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrfile_blockingasync_lock_bytes(param1,param2,param3,param4) privateOmrPortLibrary->file_blockingasync_lock_bytes(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrfile_blockingasync_set_length(param1,param2) privateOmrPortLibrary->file_blockingasync_set_length(privateOmrPortLibrary, (param1), (param2))
 #define omrfile_blockingasync_flength(param1) privateOmrPortLibrary->file_blockingasync_flength(privateOmrPortLibrary, (param1))
+#define omrfile_async_create(param1,param2,param3) privateOmrPortLibrary->file_async_create(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_async_submit(param1,param2,param3) privateOmrPortLibrary->file_async_submit(privateOmrPortLibrary, (param1), (param2), (param3))
+#define omrfile_async_wait(param1,param2,param3,param4) privateOmrPortLibrary->file_async_wait(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_async_backend(param1) privateOmrPortLibrary->file_async_backend(privateOmrPortLibrary, (param1))
+#define omrfile_async_destroy(param1) privateOmrPortLibrary->file_async_destroy(privateOmrPortLibrary, (param1))
 #define omrfilestream_startup() privateOmrPortLibrary->filestream_startup(privatePortLibrary)
 #define omrfilestream_shutdown() privateOmrPortLibrary->filestream_shutdown(privatePortLibrary)
 #define omrfilestream_open(param1, param2, param3) privateOmrPortLibrary->filestream_open(privateOmrPortLibrary, (param1), (param2), (param3))
@@ -1999,6 +2132,11 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrfile_lock_bytes(param1,param2,param3,param4) privateOmrPortLibrary->file_lock_bytes(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrfile_convert_native_fd_to_omrfile_fd(param1) privateOmrPortLibrary->file_convert_native_fd_to_omrfile_fd(privateOmrPortLibrary, (param1))
 #define omrfile_convert_omrfile_fd_to_native_fd(param1) privateOmrPortLibrary->file_convert_omrfile_fd_to_native_fd(privateOmrPortLibrary,param1)
+#define omrfile_pread(param1,param2,param3,param4) privateOmrPortLibrary->file_pread(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_pwrite(param1,param2,param3,param4) privateOmrPortLibrary->file_pwrite(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_preadv(param1,param2,param3,param4) privateOmrPortLibrary->file_preadv(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_pwritev(param1,param2,param3,param4) privateOmrPortLibrary->file_pwritev(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
+#define omrfile_copy_range(param1,param2,param3,param4,param5) privateOmrPortLibrary->file_copy_range(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
 #define omrstr_ftime(param1,param2,param3,param4) privateOmrPortLibrary->str_ftime(privateOmrPortLibrary, (param1), (param2), (param3), (param4))
 #define omrmmap_startup() privateOmrPortLibrary->mmap_startup(privateOmrPortLibrary)
 #define omrmmap_shutdown() privateOmrPortLibrary->mmap_shutdown(privateOmrPortLibrary)
@@ -2033,6 +2171,8 @@ extern J9_CFUNC int32_t omrport_getVersion(struct OMRPortLibrary *portLibrary);
 #define omrsysinfo_cgroup_subsystem_iterator_metricKey(param1, param2) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_metricKey(privateOmrPortLibrary, param1, param2)
 #define omrsysinfo_cgroup_subsystem_iterator_next(param1, param2) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_next(privateOmrPortLibrary, param1, param2)
 #define omrsysinfo_cgroup_subsystem_iterator_destroy(param1) privateOmrPortLibrary->sysinfo_cgroup_subsystem_iterator_destroy(privateOmrPortLibrary, param1)
+#define omrsysinfo_memory_pressure_register(param1,param2,param3,param4,param5) privateOmrPortLibrary->sysinfo_memory_pressure_register(privateOmrPortLibrary, (param1), (param2), (param3), (param4), (param5))
+#define omrsysinfo_memory_pressure_unregister(param1,param2) privateOmrPortLibrary->sysinfo_memory_pressure_unregister(privateOmrPortLibrary, (param1), (param2))
 #define omrintrospect_startup() privateOmrPortLibrary->introspect_startup(privateOmrPortLibrary)
 #define omrintrospect_shutdown() privateOmrPortLibrary->introspect_shutdown(privateOmrPortLibrary)
 #define omrintrospect_set_suspend_signal_offset(param1) privateOmrPortLibrary->introspect_set_suspend_signal_offset(privateOmrPortLibrary, param1)
@@ -53,7 +53,7 @@ extern "C" {
 #define UT_IPRINT_KEYWORD             "IPRINT"
 #define UT_EXCEPTION_KEYWORD          "EXCEPTION"
 #define UT_NONE_KEYWORD               "NONE"
-#define UT_OUTPUT_KEYWORD             "OUTPUT" /* deprecated */
+#define UT_OUTPUT_KEYWORD             "OUTPUT"
 #define UT_LEVEL_KEYWORD              "LEVEL"
 #define UT_SUSPEND_KEYWORD            "SUSPEND"
 #define UT_RESUME_KEYWORD             "RESUME"
@@ -75,6 +75,7 @@ typedef struct OMR_TraceBuffer {
 	struct OMR_TraceBuffer *next;		/* Next thread/freebuffer           */
 	volatile uint32_t flags;			/* Flags                            */
 	int32_t bufferType;					/* Buffer type                      */
+	uint32_t index;						/* Index in the trace buffer table  */
 	struct OMR_TraceThread *thr;		/* The thread that last owned this  */
 	/* This section written to disk     */
 	UtTraceRecord record;				/* Disk record                      */
@@ -137,6 +137,25 @@ const char *omr_trc_formatNextTracePoint(UtTracePointIterator *iter, char *buffe
  */
 omr_error_t omr_trc_freeTracePointIterator(UtTracePointIterator *iter);
 
+/**
+ * Format every trace point in a trace file offline, one line per trace point
+ * prefixed by the name of the thread that logged it.
+ *
+ * Files written by a subscriber (the trace metadata followed by whole trace records)
+ * and files written by the output= trace option, including unused space at the end
+ * of a pre-sized file, are both accepted.
+ *
+ * @param[in] portLib An initialized OMRPortLibraryStructure.
+ * @param[in] fileName The name of the trace file to format.
+ * @param[in] getFormatString A callback the formatter can use to obtain a format string for a trace point id in a named module.
+ * @param[in] outputFile An open file handle to write the formatted trace points to, or -1 to only count them.
+ * @param[out] tracePointCount If not NULL, set to the number of trace points formatted.
+ *
+ * @return OMR_ERROR_NONE on success, or an error code from omr_trc_getTraceFileIterator
+ * or omr_trc_getTracePointIteratorForNextBuffer.
+ */
+omr_error_t omr_trc_formatTraceFile(OMRPortLibrary *portLib, char *fileName, FormatStringCallback getFormatString, intptr_t outputFile, uint64_t *tracePointCount);
+
 /**
  * @deprecated
  *
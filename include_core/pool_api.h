@@ -73,6 +73,14 @@ pool_clear(J9Pool *aPool);
 void
 pool_do(J9Pool *aPool, void (*aFunction)(void *anElement, void *userData), void *userData);
 
+/**
+* @brief
+* @param aPool
+* @return void
+*/
+void
+pool_flushMagazines(J9Pool *aPool);
+
 /**
 * @brief
 * @param aPool
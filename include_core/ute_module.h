@@ -34,6 +34,7 @@
 #define UTE_VERSION_1_1                0x7E000101
 
 #include <stdio.h>
+#include <string.h>
 
 #if defined(LINUX) || defined(OSX)
 #include <unistd.h>
@@ -58,6 +59,13 @@ extern "C" {
 
 #define UT_SPECIAL_ASSERTION 0x00400000
 
+/*
+ * Bits of a tracepoint's active byte that UtModuleInterface.TracePacked can
+ * service: minimal and maximal buffer trace. Any other output type needs the
+ * original arguments and is routed through UtModuleInterface.Trace instead.
+ */
+#define UT_TRACE_PACKED_OUTPUT 0x03
+
 /*
  * =============================================================================
  *   Forward declarations
@@ -142,6 +150,8 @@ struct  UtModuleInterface {
 	void (*TraceState)(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *, ...);
 	void (*TraceInit)(void *env, UtModuleInfo *mod);
 	void (*TraceTerm)(void *env, UtModuleInfo *mod);
+	/* Record a tracepoint whose arguments were already packed into buffer layout by the generated macro. May be NULL. */
+	void (*TracePacked)(void *env, UtModuleInfo *modInfo, uint32_t traceId, const void *data, uint32_t length);
 };
 
 #ifdef  __cplusplus
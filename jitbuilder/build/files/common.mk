@@ -33,6 +33,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/infra/BitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Checklist.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/HashTab.cpp \
+    $(JIT_OMR_DIRTY_DIR)/infra/HybridBitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/STLUtils.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/IGBase.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/IGNode.cpp \
@@ -64,6 +65,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/il/OMRSymbolReference.cpp \
     $(JIT_OMR_DIRTY_DIR)/il/Aliases.cpp \
     $(JIT_OMR_DIRTY_DIR)/compile/OMRCompilation.cpp \
+    $(JIT_OMR_DIRTY_DIR)/compile/CompilationBudget.cpp \
     $(JIT_OMR_DIRTY_DIR)/compile/TLSCompilationManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRCPU.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRObjectModel.cpp \
@@ -75,6 +77,9 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/SegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentAllocator.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentProvider.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentCache.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/PassProfile.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/RegionProfiler.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/DebugSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/Region.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/StackMemoryRegion.cpp \
@@ -244,10 +249,14 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheMemorySegment.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheConfig.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/PersistentCodeCache.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/PerfToolWriter.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRCompilerEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/PersistentAllocator.cpp \
     $(JIT_PRODUCT_DIR)/compile/Method.cpp \
+    $(JIT_PRODUCT_DIR)/control/CompilationService.cpp \
     $(JIT_PRODUCT_DIR)/control/Jit.cpp \
+    $(JIT_PRODUCT_DIR)/control/TieredCompilation.cpp \
     $(JIT_PRODUCT_DIR)/env/FrontEnd.cpp \
     $(JIT_PRODUCT_DIR)/ilgen/JBIlGeneratorMethodDetails.cpp \
     $(JIT_PRODUCT_DIR)/optimizer/JBOptimizer.cpp \
@@ -0,0 +1,358 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <new>
+#include <stddef.h>
+#include "compile/Compilation.hpp"
+#include "control/CompilationService.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "ilgen/MethodBuilder.hpp"
+
+// Compilations recurse deeply; do not rely on the platform default for
+// secondary threads, which can be as small as 512KB.
+#define COMPILATION_THREAD_STACK_SIZE (4 * 1024 * 1024)
+
+namespace JitBuilder
+{
+
+struct CompilationRequest
+   {
+   CompilationRequest *_next;
+   CompilationService *_service;
+   TR::MethodBuilder *_methodBuilder;
+   int32_t _priority;
+   TR_Hotness _hotness;
+   CompilationCallback _callback;
+   void *_userData;
+   void *_entryPoint;
+   int32_t _returnCode;
+   bool _done;
+   };
+
+}
+
+JitBuilder::CompilationService *JitBuilder::CompilationService::_instance = NULL;
+
+#if !defined(OMR_OS_WINDOWS)
+
+JitBuilder::CompilationService::CompilationService() :
+   _queue(NULL),
+   _active(NULL),
+   _numThreads(0),
+   _shuttingDown(false)
+   {
+   pthread_mutex_init(&_lock, NULL);
+   pthread_cond_init(&_queueChanged, NULL);
+   pthread_cond_init(&_requestCompleted, NULL);
+   }
+
+JitBuilder::CompilationService *
+JitBuilder::CompilationService::start(int32_t numThreads)
+   {
+   if (_instance || numThreads <= 0)
+      return NULL;
+   if (numThreads > MAX_COMPILATION_THREADS)
+      numThreads = MAX_COMPILATION_THREADS;
+
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(CompilationService), std::nothrow);
+   if (!storage)
+      return NULL;
+   CompilationService *service = new (storage) CompilationService();
+
+   pthread_attr_t attr;
+   pthread_attr_init(&attr);
+   pthread_attr_setstacksize(&attr, COMPILATION_THREAD_STACK_SIZE);
+   for (int32_t i = 0; i < numThreads; ++i)
+      {
+      if (pthread_create(&service->_threads[service->_numThreads], &attr, compilationThreadEntry, service) != 0)
+         break;
+      service->_numThreads++;
+      }
+   pthread_attr_destroy(&attr);
+
+   if (service->_numThreads == 0)
+      {
+      pthread_cond_destroy(&service->_requestCompleted);
+      pthread_cond_destroy(&service->_queueChanged);
+      pthread_mutex_destroy(&service->_lock);
+      TR::Compiler->persistentAllocator().deallocate(service);
+      return NULL;
+      }
+
+   _instance = service;
+   return service;
+   }
+
+/**
+ * The service object is not freed: handles of requests submitted without a
+ * callback keep pointing at it and may still be passed to wait().
+ */
+void
+JitBuilder::CompilationService::shutdown()
+   {
+   CompilationService *service = _instance;
+   if (!service)
+      return;
+
+   pthread_mutex_lock(&service->_lock);
+   service->_shuttingDown = true;
+   pthread_cond_broadcast(&service->_queueChanged);
+   pthread_mutex_unlock(&service->_lock);
+
+   for (int32_t i = 0; i < service->_numThreads; ++i)
+      pthread_join(service->_threads[i], NULL);
+   service->_numThreads = 0;
+   _instance = NULL;
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationService::submit(TR::MethodBuilder *methodBuilder, int32_t priority, CompilationCallback callback, void *userData, TR_Hotness hotness)
+   {
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(CompilationRequest), std::nothrow);
+   if (!storage)
+      return NULL;
+   CompilationRequest *request = static_cast<CompilationRequest *>(storage);
+   request->_service = this;
+   request->_methodBuilder = methodBuilder;
+   request->_priority = priority;
+   request->_hotness = hotness;
+   request->_callback = callback;
+   request->_userData = userData;
+   request->_entryPoint = NULL;
+   request->_returnCode = COMPILATION_REQUESTED;
+   request->_done = false;
+
+   pthread_mutex_lock(&_lock);
+   CompilationRequest **link = &_queue;
+   while (*link && (*link)->_priority >= priority)
+      link = &(*link)->_next;
+   request->_next = *link;
+   *link = request;
+   pthread_cond_broadcast(&_queueChanged);
+   pthread_mutex_unlock(&_lock);
+
+   return request;
+   }
+
+int32_t
+JitBuilder::CompilationService::wait(CompilationRequest *request, void **entryPoint)
+   {
+   CompilationService *service = request->_service;
+   pthread_mutex_lock(&service->_lock);
+   while (!request->_done)
+      pthread_cond_wait(&service->_requestCompleted, &service->_lock);
+   pthread_mutex_unlock(&service->_lock);
+
+   int32_t rc = request->_returnCode;
+   *entryPoint = request->_entryPoint;
+   TR::Compiler->persistentAllocator().deallocate(request);
+   return rc;
+   }
+
+bool
+JitBuilder::CompilationService::isDone(CompilationRequest *request)
+   {
+   CompilationService *service = request->_service;
+   pthread_mutex_lock(&service->_lock);
+   bool done = request->_done;
+   pthread_mutex_unlock(&service->_lock);
+   return done;
+   }
+
+int32_t
+JitBuilder::CompilationService::compile(TR::MethodBuilder *methodBuilder, void **entryPoint, TR_Hotness hotness)
+   {
+   TR::TypeDictionary *types = methodBuilder->typeDictionary();
+   ActiveCompilation active;
+
+   pthread_mutex_lock(&_lock);
+   while (isBusy(types))
+      pthread_cond_wait(&_queueChanged, &_lock);
+   beginCompilation(active, types);
+   pthread_mutex_unlock(&_lock);
+
+   int32_t rc = compileMethod(methodBuilder, hotness, entryPoint);
+
+   pthread_mutex_lock(&_lock);
+   endCompilation(active);
+   pthread_mutex_unlock(&_lock);
+   return rc;
+   }
+
+void *
+JitBuilder::CompilationService::compilationThreadEntry(void *service)
+   {
+   static_cast<CompilationService *>(service)->run();
+   return NULL;
+   }
+
+void
+JitBuilder::CompilationService::run()
+   {
+   pthread_mutex_lock(&_lock);
+   while (true)
+      {
+      CompilationRequest *request = dequeue();
+      if (!request)
+         {
+         if (_shuttingDown && !_queue)
+            break;
+         pthread_cond_wait(&_queueChanged, &_lock);
+         continue;
+         }
+
+      ActiveCompilation active;
+      beginCompilation(active, request->_methodBuilder->typeDictionary());
+      pthread_mutex_unlock(&_lock);
+
+      void *entryPoint = NULL;
+      int32_t rc = compileMethod(request->_methodBuilder, request->_hotness, &entryPoint);
+
+      pthread_mutex_lock(&_lock);
+      endCompilation(active);
+      if (!request->_callback)
+         {
+         request->_returnCode = rc;
+         request->_entryPoint = entryPoint;
+         request->_done = true;
+         pthread_cond_broadcast(&_requestCompleted);
+         continue;
+         }
+      pthread_mutex_unlock(&_lock);
+
+      // The callback runs without the lock so that it may submit or compile
+      // further methods, including ones sharing this TypeDictionary.
+      request->_callback(request->_userData, rc, entryPoint);
+      TR::Compiler->persistentAllocator().deallocate(request);
+      pthread_mutex_lock(&_lock);
+      }
+   pthread_mutex_unlock(&_lock);
+   }
+
+/// Takes the first queued request whose TypeDictionary is not in use.  Must be called with _lock held.
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationService::dequeue()
+   {
+   for (CompilationRequest **link = &_queue; *link; link = &(*link)->_next)
+      {
+      CompilationRequest *request = *link;
+      if (!isBusy(request->_methodBuilder->typeDictionary()))
+         {
+         *link = request->_next;
+         request->_next = NULL;
+         return request;
+         }
+      }
+   return NULL;
+   }
+
+bool
+JitBuilder::CompilationService::isBusy(TR::TypeDictionary *types)
+   {
+   for (ActiveCompilation *active = _active; active; active = active->_next)
+      {
+      if (active->_types == types)
+         return true;
+      }
+   return false;
+   }
+
+void
+JitBuilder::CompilationService::beginCompilation(ActiveCompilation &active, TR::TypeDictionary *types)
+   {
+   active._types = types;
+   active._next = _active;
+   _active = &active;
+   }
+
+void
+JitBuilder::CompilationService::endCompilation(ActiveCompilation &active)
+   {
+   for (ActiveCompilation **link = &_active; *link; link = &(*link)->_next)
+      {
+      if (*link == &active)
+         {
+         *link = active._next;
+         break;
+         }
+      }
+   // Requests held back by this dictionary may be runnable now
+   pthread_cond_broadcast(&_queueChanged);
+   }
+
+int32_t
+JitBuilder::CompilationService::compileMethod(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, void **entryPoint)
+   {
+   try
+      {
+      return methodBuilder->Compile(entryPoint, hotness);
+      }
+   catch (...)
+      {
+      *entryPoint = NULL;
+      return COMPILATION_FAILED;
+      }
+   }
+
+#else /* !defined(OMR_OS_WINDOWS) */
+
+// No compilation threads on this host: start() fails, so instance() stays
+// NULL and callers compile synchronously.
+
+JitBuilder::CompilationService *
+JitBuilder::CompilationService::start(int32_t numThreads)
+   {
+   return NULL;
+   }
+
+void
+JitBuilder::CompilationService::shutdown()
+   {
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationService::submit(TR::MethodBuilder *methodBuilder, int32_t priority, CompilationCallback callback, void *userData, TR_Hotness hotness)
+   {
+   return NULL;
+   }
+
+int32_t
+JitBuilder::CompilationService::wait(CompilationRequest *request, void **entryPoint)
+   {
+   *entryPoint = NULL;
+   return COMPILATION_FAILED;
+   }
+
+bool
+JitBuilder::CompilationService::isDone(CompilationRequest *request)
+   {
+   return true;
+   }
+
+int32_t
+JitBuilder::CompilationService::compile(TR::MethodBuilder *methodBuilder, void **entryPoint, TR_Hotness hotness)
+   {
+   return methodBuilder->Compile(entryPoint, hotness);
+   }
+
+#endif /* !defined(OMR_OS_WINDOWS) */
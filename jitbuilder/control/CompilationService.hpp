@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_COMPILATIONSERVICE_INCL
+#define JITBUILDER_COMPILATIONSERVICE_INCL
+
+#include <stdint.h>
+#if !defined(OMR_OS_WINDOWS)
+#include <pthread.h>
+#endif /* !defined(OMR_OS_WINDOWS) */
+#include "compile/CompilationTypes.hpp"
+
+namespace TR { class MethodBuilder; }
+namespace TR { class TypeDictionary; }
+
+namespace JitBuilder
+{
+
+/**
+ * Completion callback for an asynchronous compilation.  Invoked on the
+ * compilation thread once the method has been compiled, with the return
+ * code of the compilation and the entry point of the compiled code (NULL
+ * on failure).
+ */
+typedef void (*CompilationCallback)(void *userData, int32_t returnCode, void *entryPoint);
+
+struct CompilationRequest;
+
+/**
+ * A pool of compilation threads fed from a priority queue of MethodBuilder
+ * compilation requests.
+ *
+ * Requests with a larger priority are compiled first; requests of equal
+ * priority are compiled in submission order.  Two compilations that share a
+ * TypeDictionary never run at the same time, because struct and union field
+ * symbol references are recorded on the dictionary during a compilation.
+ * Synchronous compilations issued through compile() take part in the same
+ * exclusion while the service is running.
+ *
+ * A MethodBuilder must not be resubmitted or otherwise used until its
+ * compilation has completed.
+ *
+ * The service is built on pthreads and is only available on POSIX hosts.
+ * Elsewhere start() always returns NULL, so no instance ever exists and
+ * compilations stay on the calling thread.
+ */
+class CompilationService
+   {
+public:
+
+   static const int32_t MAX_COMPILATION_THREADS = 64;
+
+   /**
+    * @brief Starts the service with the given number of compilation threads.
+    *        Returns NULL if the service is already running or no thread could
+    *        be created.
+    */
+   static CompilationService *start(int32_t numThreads);
+
+   /**
+    * @brief Compiles every queued request, then stops and joins all
+    *        compilation threads.  Requests not yet waited for are freed.
+    */
+   static void shutdown();
+
+   static CompilationService *instance() { return _instance; }
+
+   /**
+    * @brief Queues a method for compilation.
+    *
+    * When a callback is given it is called on completion and the request is
+    * released by the service; the returned handle must not be used after
+    * that.  Otherwise the caller must pass the handle to wait() exactly once.
+    *
+    * @return the request handle, or NULL if it could not be allocated
+    */
+   CompilationRequest *submit(TR::MethodBuilder *methodBuilder, int32_t priority, CompilationCallback callback, void *userData, TR_Hotness hotness = warm);
+
+   /**
+    * @brief Blocks until a request without callback has been compiled,
+    *        stores its entry point and releases the request.
+    */
+   static int32_t wait(CompilationRequest *request, void **entryPoint);
+
+   static bool isDone(CompilationRequest *request);
+
+   /// Compiles on the calling thread, honouring the TypeDictionary exclusion
+   int32_t compile(TR::MethodBuilder *methodBuilder, void **entryPoint, TR_Hotness hotness = warm);
+
+   int32_t numThreads() const { return _numThreads; }
+
+private:
+
+   struct ActiveCompilation
+      {
+      ActiveCompilation *_next;
+      TR::TypeDictionary *_types;
+      };
+
+   CompilationService();
+
+   static void *compilationThreadEntry(void *service);
+   void run();
+
+   CompilationRequest *dequeue();
+   bool isBusy(TR::TypeDictionary *types);
+   void beginCompilation(ActiveCompilation &active, TR::TypeDictionary *types);
+   void endCompilation(ActiveCompilation &active);
+   static int32_t compileMethod(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, void **entryPoint);
+
+   static CompilationService *_instance;
+
+#if !defined(OMR_OS_WINDOWS)
+   pthread_mutex_t _lock;
+   pthread_cond_t _queueChanged;
+   pthread_cond_t _requestCompleted;
+
+   CompilationRequest *_queue;
+   ActiveCompilation *_active;
+   pthread_t _threads[MAX_COMPILATION_THREADS];
+#endif /* !defined(OMR_OS_WINDOWS) */
+   int32_t _numThreads;
+   bool _shuttingDown;
+   };
+
+}
+
+#endif // !defined(JITBUILDER_COMPILATIONSERVICE_INCL)
@@ -24,7 +24,9 @@
 #include "codegen/CodeGenerator.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/Method.hpp"
+#include "control/CompilationService.hpp"
 #include "control/CompileMethod.hpp"
+#include "control/TieredCompilation.hpp"
 #include "env/CompilerEnv.hpp"
 #include "env/FrontEnd.hpp"
 #include "env/IO.hpp"
@@ -168,6 +170,18 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 //     compileMethodBuilder() as many times as needed to create compiled code
 //     shuwdownJit() when the test is complete
 //
+// Methods can also be compiled in the background: startCompilationThreads()
+// sizes the pool of compilation threads (one thread is started on first use
+// otherwise), compileMethodBuilderAsync() queues a method and either calls
+// back on completion or returns a handle for waitForCompilation().
+// Background compilation needs pthreads; on other hosts
+// startCompilationThreads() returns false and compileMethodBuilderAsync()
+// returns NULL.
+//
+// compileMethodBuilderTiered() compiles a method cold and recompiles it warm
+// and then hot as its invocation count crosses the tieredWarmCount and
+// tieredHotCount options, behind an entry point that stays valid throughout.
+//
 
 
 
@@ -187,14 +201,59 @@ internal_initializeJit()
 int32_t
 internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry)
    {
+   JitBuilder::CompilationService *service = JitBuilder::CompilationService::instance();
+   if (service)
+      return service->compile(m, entry);
    return m->Compile(entry);
    }
 
+int32_t
+internal_compileMethodBuilderTiered(TR::MethodBuilder *m, void **entry)
+   {
+   return JitBuilder::TieredCompilation::compile(m, entry);
+   }
+
+bool
+internal_startCompilationThreads(int32_t numThreads)
+   {
+   return JitBuilder::CompilationService::start(numThreads) != NULL;
+   }
+
+// callback is a JitBuilder::CompilationCallback; if it is NULL the returned
+// handle must be passed to waitForCompilation()
+void *
+internal_compileMethodBuilderAsync(TR::MethodBuilder *m, int32_t priority, void *callback, void *userData)
+   {
+   JitBuilder::CompilationService *service = JitBuilder::CompilationService::instance();
+   if (!service)
+      service = JitBuilder::CompilationService::start(1);
+   if (!service)
+      return NULL;
+   return service->submit(m, priority, reinterpret_cast<JitBuilder::CompilationCallback>(callback), userData);
+   }
+
+int32_t
+internal_waitForCompilation(void *request, void **entry)
+   {
+   return JitBuilder::CompilationService::wait(static_cast<JitBuilder::CompilationRequest *>(request), entry);
+   }
+
+bool
+internal_isCompilationDone(void *request)
+   {
+   return JitBuilder::CompilationService::isDone(static_cast<JitBuilder::CompilationRequest *>(request));
+   }
+
 void
 internal_shutdownJit()
    {
+   JitBuilder::CompilationService::shutdown();
+   JitBuilder::TieredCompilation::shutdown();
+
    auto fe = JitBuilder::FrontEnd::instance();
 
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
    codeCacheManager.destroy();
+
+   commonJitShutdown(*fe);
    }
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <algorithm>
+#include <new>
+#include <string.h>
+#include "AtomicSupport.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "control/CompilationService.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "control/TieredCompilation.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+// jmp through the word at offset TRAMPOLINE_TARGET_OFFSET
+#define TRAMPOLINE_SIZE 16
+#define TRAMPOLINE_TARGET_OFFSET 8
+
+// A method whose recompilation fails this many times stays at its tier
+#define MAX_FAILED_RECOMPILATIONS 3
+
+namespace JitBuilder
+{
+
+struct TieredMethod
+   {
+   TieredMethod *_next;
+   TR::MethodBuilder *_methodBuilder;
+   uint8_t *_trampoline;
+   int32_t _counter;
+   TR_Hotness _hotness;
+   TR_Hotness _nextHotness;
+   volatile uint32_t _recompiling;
+   uint32_t _failedRecompilations;
+   };
+
+}
+
+JitBuilder::TieredMethod * volatile JitBuilder::TieredCompilation::_methods = NULL;
+
+int32_t
+JitBuilder::TieredCompilation::compile(TR::MethodBuilder *methodBuilder, void **entryPoint)
+   {
+   uint8_t *trampoline = allocateTrampoline();
+   if (!trampoline)
+      return compileAt(methodBuilder, warm, entryPoint);
+
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(TieredMethod), std::nothrow);
+   if (!storage)
+      return compileAt(methodBuilder, warm, entryPoint);
+   TieredMethod *method = static_cast<TieredMethod *>(storage);
+   method->_methodBuilder = methodBuilder;
+   method->_trampoline = trampoline;
+   method->_counter = std::max(TR::Options::getCmdLineOptions()->getTieredWarmCount(), 1);
+   method->_hotness = cold;
+   method->_nextHotness = cold;
+   method->_recompiling = 0;
+   method->_failedRecompilations = 0;
+
+   methodBuilder->setInvocationCounter(&method->_counter, reinterpret_cast<void *>(countdownExpired), method);
+   void *coldEntryPoint = NULL;
+   int32_t rc = compileAt(methodBuilder, cold, &coldEntryPoint);
+   if (rc != COMPILATION_SUCCEEDED)
+      {
+      // The trampoline is not reclaimed: code cache space is only ever freed with its method
+      methodBuilder->setInvocationCounter(NULL, NULL, NULL);
+      TR::Compiler->persistentAllocator().deallocate(method);
+      *entryPoint = NULL;
+      return rc;
+      }
+
+   setTrampolineTarget(trampoline, coldEntryPoint);
+
+   // Methods are only ever pushed, and taken all at once by shutdown()
+   TieredMethod *next = NULL;
+   do
+      {
+      next = _methods;
+      method->_next = next;
+      }
+   while (VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_methods), reinterpret_cast<uintptr_t>(next), reinterpret_cast<uintptr_t>(method)) != reinterpret_cast<uintptr_t>(next));
+
+   *entryPoint = trampoline;
+   return rc;
+   }
+
+void
+JitBuilder::TieredCompilation::shutdown()
+   {
+   TieredMethod *method = NULL;
+   do
+      {
+      method = _methods;
+      }
+   while (VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_methods), reinterpret_cast<uintptr_t>(method), 0) != reinterpret_cast<uintptr_t>(method));
+
+   while (method)
+      {
+      TieredMethod *next = method->_next;
+      method->_methodBuilder->setInvocationCounter(NULL, NULL, NULL);
+      TR::Compiler->persistentAllocator().deallocate(method);
+      method = next;
+      }
+   }
+
+int32_t
+JitBuilder::TieredCompilation::compileAt(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, void **entryPoint)
+   {
+   JitBuilder::CompilationService *service = JitBuilder::CompilationService::instance();
+   if (service)
+      return service->compile(methodBuilder, entryPoint, hotness);
+   return methodBuilder->Compile(entryPoint, hotness);
+   }
+
+/**
+ * Called from compiled code when the invocation counter of a method reaches
+ * zero.  Code still running the older body keeps decrementing the counter
+ * while the next tier compiles; _recompiling keeps the handler from being
+ * reentered until that code is installed and the counter is re-armed.
+ */
+void
+JitBuilder::TieredCompilation::countdownExpired(TieredMethod *method)
+   {
+   if (VM_AtomicSupport::lockCompareExchangeU32(&method->_recompiling, 0, 1) != 0)
+      return;
+
+   TR::MethodBuilder *methodBuilder = method->_methodBuilder;
+   if (method->_hotness == cold)
+      {
+      method->_nextHotness = warm;
+      method->_counter = std::max(TR::Options::getCmdLineOptions()->getTieredHotCount(), 1);
+      }
+   else
+      {
+      method->_nextHotness = hot;
+      methodBuilder->setInvocationCounter(NULL, NULL, NULL);
+      }
+
+   JitBuilder::CompilationService *service = JitBuilder::CompilationService::instance();
+   if (service && service->submit(methodBuilder, 0, recompiled, method, method->_nextHotness))
+      return;
+
+   void *entryPoint = NULL;
+   int32_t rc = compileAt(methodBuilder, method->_nextHotness, &entryPoint);
+   recompiled(method, rc, entryPoint);
+   }
+
+void
+JitBuilder::TieredCompilation::recompiled(void *tieredMethod, int32_t returnCode, void *entryPoint)
+   {
+   TieredMethod *method = static_cast<TieredMethod *>(tieredMethod);
+   if (returnCode != COMPILATION_SUCCEEDED)
+      {
+      // Keep running the current body.  Unless this tier keeps failing,
+      // count down again and retry; otherwise _recompiling stays set, so the
+      // handler ignores the counter from now on.
+      if (++method->_failedRecompilations >= MAX_FAILED_RECOMPILATIONS)
+         return;
+      if (method->_nextHotness == hot)
+         method->_methodBuilder->setInvocationCounter(&method->_counter, reinterpret_cast<void *>(countdownExpired), method);
+      method->_counter = std::max(method->_hotness == cold ?
+                                     TR::Options::getCmdLineOptions()->getTieredWarmCount() :
+                                     TR::Options::getCmdLineOptions()->getTieredHotCount(),
+                                  1);
+      VM_AtomicSupport::writeBarrier();
+      method->_recompiling = 0;
+      return;
+      }
+
+   setTrampolineTarget(method->_trampoline, entryPoint);
+   method->_hotness = method->_nextHotness;
+   if (method->_hotness != hot)
+      {
+      // Re-arm the counter: the previous body may have taken it below zero while this one compiled
+      method->_counter = std::max(TR::Options::getCmdLineOptions()->getTieredHotCount(), 1);
+      VM_AtomicSupport::writeBarrier();
+      method->_recompiling = 0;
+      }
+   }
+
+uint8_t *
+JitBuilder::TieredCompilation::allocateTrampoline()
+   {
+#if defined(TR_TARGET_X86)
+   TR::CodeCacheManager *manager = TR::CodeCacheManager::instance();
+   int32_t numReserved = 0;
+   TR::CodeCache *codeCache = manager->reserveCodeCache(false, TRAMPOLINE_SIZE, -1, &numReserved);
+   if (!codeCache)
+      return NULL;
+   uint8_t *coldCode = NULL;
+   uint8_t *trampoline = manager->allocateCodeMemory(TRAMPOLINE_SIZE, 0, &codeCache, &coldCode, false, false);
+   if (codeCache)
+      codeCache->unreserve();
+   if (!trampoline)
+      return NULL;
+
+   memset(trampoline, 0xcc, TRAMPOLINE_SIZE);
+   trampoline[0] = 0xff; // jmp [target]
+   trampoline[1] = 0x25;
+#if defined(TR_TARGET_64BIT)
+   *reinterpret_cast<int32_t *>(trampoline + 2) = TRAMPOLINE_TARGET_OFFSET - 6; // RIP relative
+#else
+   *reinterpret_cast<uint32_t *>(trampoline + 2) = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(trampoline + TRAMPOLINE_TARGET_OFFSET));
+#endif
+   return trampoline;
+#else
+   return NULL;
+#endif
+   }
+
+/// The target word is naturally aligned, so the store is seen whole by racing callers
+void
+JitBuilder::TieredCompilation::setTrampolineTarget(uint8_t *trampoline, void *target)
+   {
+   VM_AtomicSupport::writeBarrier();
+   *reinterpret_cast<void * volatile *>(trampoline + TRAMPOLINE_TARGET_OFFSET) = target;
+   TR::CodeGenerator::syncCode(trampoline, TRAMPOLINE_SIZE);
+   }
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_TIEREDCOMPILATION_INCL
+#define JITBUILDER_TIEREDCOMPILATION_INCL
+
+#include <stdint.h>
+#include "compile/CompilationTypes.hpp"
+
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+struct TieredMethod;
+
+/**
+ * Tiered compilation of MethodBuilders.
+ *
+ * A method is first compiled cold, with code that counts its invocations,
+ * and is called through an entry trampoline.  After tieredWarmCount
+ * invocations it is recompiled warm, still counting, and after a further
+ * tieredHotCount invocations it is recompiled hot.  Every new body is
+ * installed by retargeting the trampoline, so callers keep using the entry
+ * point they were given.  Recompilations run on the CompilationService
+ * threads when the service is running and on the invoking thread otherwise;
+ * a recompilation that fails leaves the method at its current tier and is
+ * retried after another countdown, until it has failed a few times.
+ *
+ * The MethodBuilder must stay alive, and must not be compiled by other
+ * means, until the JIT is shut down.  Targets without entry trampolines get
+ * a single warm compilation.
+ */
+class TieredCompilation
+   {
+public:
+
+   static int32_t compile(TR::MethodBuilder *methodBuilder, void **entryPoint);
+
+   /// Releases all tiered methods; their code must no longer run
+   static void shutdown();
+
+private:
+
+   static int32_t compileAt(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, void **entryPoint);
+   static void countdownExpired(TieredMethod *method);
+   static void recompiled(void *method, int32_t returnCode, void *entryPoint);
+
+   static uint8_t *allocateTrampoline();
+   static void setTrampolineTarget(uint8_t *trampoline, void *target);
+
+   static TieredMethod * volatile _methods;
+   };
+
+}
+
+#endif // !defined(JITBUILDER_TIEREDCOMPILATION_INCL)
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <iostream>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "AsyncCompile.hpp"
+
+using std::cout;
+using std::cerr;
+
+#define TOSTR(x)     #x
+#define LINETOSTR(x) TOSTR(x)
+
+#define NUM_METHODS 8
+#define NUM_SUBMITTERS 4
+#define METHODS_PER_SUBMITTER 6
+
+typedef int32_t (AddConstantFunction)(int32_t);
+
+struct CallbackResult
+   {
+   volatile int32_t rc;
+   void * volatile entry;
+   volatile bool done;
+   };
+
+static void
+compilationDone(void *userData, int32_t rc, void *entry)
+   {
+   CallbackResult *result = static_cast<CallbackResult *>(userData);
+   result->rc = rc;
+   result->entry = entry;
+   __sync_synchronize();
+   result->done = true;
+   }
+
+static bool
+check(AddConstantMethod &method, int32_t rc, void *entry)
+   {
+   if (rc != 0 || entry == NULL)
+      {
+      cerr << "FAIL: compilation error " << rc << " for constant " << method.constant() << "\n";
+      return false;
+      }
+   AddConstantFunction *f = (AddConstantFunction *) entry;
+   int32_t v = 5;
+   if (f(v) != v + method.constant())
+      {
+      cerr << "FAIL: add" << method.constant() << "(" << v << ") returned " << f(v) << "\n";
+      return false;
+      }
+   cout << "add" << method.constant() << "(" << v << ") == " << f(v) << "\n";
+   return true;
+   }
+
+static bool
+collect(AddConstantMethod &method, void *request, CallbackResult &result, bool useCallback)
+   {
+   if (useCallback)
+      {
+      while (!result.done)
+         usleep(1000);
+      __sync_synchronize();
+      return check(method, result.rc, result.entry);
+      }
+   void *entry = NULL;
+   int32_t rc = waitForCompilation(request, &entry);
+   return check(method, rc, entry);
+   }
+
+struct Submitter
+   {
+   pthread_t thread;
+   int32_t id;
+   OMR::JitBuilder::TypeDictionary *sharedTypes;
+   bool passed;
+   };
+
+// Runs on a client thread: queues a batch of methods, half of them on the
+// dictionary shared by all submitters, while the other submitters do the
+// same, then collects every result.
+static void *
+submitConcurrently(void *arg)
+   {
+   Submitter *submitter = static_cast<Submitter *>(arg);
+   OMR::JitBuilder::TypeDictionary ownTypes;
+   AddConstantMethod *methods[METHODS_PER_SUBMITTER];
+   void *requests[METHODS_PER_SUBMITTER];
+   CallbackResult results[METHODS_PER_SUBMITTER];
+
+   submitter->passed = true;
+   for (int32_t i = 0; i < METHODS_PER_SUBMITTER; i++)
+      {
+      OMR::JitBuilder::TypeDictionary *types = (i % 2) ? submitter->sharedTypes : &ownTypes;
+      methods[i] = new AddConstantMethod(types, 1000 * (submitter->id + 1) + i);
+      results[i].done = false;
+      bool useCallback = (i % 3) == 0;
+      requests[i] = compileMethodBuilderAsync(methods[i], i % 3, useCallback ? (void *) compilationDone : NULL, &results[i]);
+      if (requests[i] == NULL)
+         {
+         cerr << "FAIL: submitter " << submitter->id << " could not submit method " << i << "\n";
+         submitter->passed = false;
+         return NULL;
+         }
+      }
+
+   for (int32_t i = 0; i < METHODS_PER_SUBMITTER; i++)
+      submitter->passed = collect(*methods[i], requests[i], results[i], (i % 3) == 0) && submitter->passed;
+   return NULL;
+   }
+
+int
+main(int argc, char *argv[])
+   {
+   cout << "Step 1: initialize JIT\n";
+   bool initialized = initializeJit();
+   if (!initialized)
+      {
+      cerr << "FAIL: could not initialize JIT\n";
+      exit(-1);
+      }
+
+   cout << "Step 2: start compilation threads\n";
+   if (!startCompilationThreads(2))
+      {
+      cerr << "FAIL: could not start compilation threads\n";
+      exit(-1);
+      }
+
+   cout << "Step 3: define type dictionaries\n";
+   // Odd methods share one dictionary, so those compilations must be serialized
+   OMR::JitBuilder::TypeDictionary sharedTypes;
+   OMR::JitBuilder::TypeDictionary *types[NUM_METHODS];
+   AddConstantMethod *methods[NUM_METHODS];
+   for (int32_t i = 0; i < NUM_METHODS; i++)
+      {
+      types[i] = (i % 2) ? &sharedTypes : new OMR::JitBuilder::TypeDictionary();
+      methods[i] = new AddConstantMethod(types[i], i + 1);
+      }
+
+   cout << "Step 4: submit method builders\n";
+   void *requests[NUM_METHODS];
+   CallbackResult results[NUM_METHODS];
+   for (int32_t i = 0; i < NUM_METHODS; i++)
+      {
+      results[i].done = false;
+      bool useCallback = (i % 4) >= 2;
+      requests[i] = compileMethodBuilderAsync(methods[i], i, useCallback ? (void *) compilationDone : NULL, &results[i]);
+      if (requests[i] == NULL)
+         {
+         cerr << "FAIL: could not submit method " << i << "\n";
+         exit(-2);
+         }
+      }
+
+   cout << "Step 5: collect results\n";
+   bool passed = true;
+   for (int32_t i = 0; i < NUM_METHODS; i++)
+      passed = collect(*methods[i], requests[i], results[i], (i % 4) >= 2) && passed;
+
+   cout << "Step 6: submit and collect from " << NUM_SUBMITTERS << " threads at once\n";
+   Submitter submitters[NUM_SUBMITTERS];
+   for (int32_t i = 0; i < NUM_SUBMITTERS; i++)
+      {
+      submitters[i].id = i;
+      submitters[i].sharedTypes = &sharedTypes;
+      submitters[i].passed = false;
+      if (pthread_create(&submitters[i].thread, NULL, submitConcurrently, &submitters[i]) != 0)
+         {
+         cerr << "FAIL: could not create submitter thread " << i << "\n";
+         exit(-2);
+         }
+      }
+   for (int32_t i = 0; i < NUM_SUBMITTERS; i++)
+      {
+      pthread_join(submitters[i].thread, NULL);
+      passed = submitters[i].passed && passed;
+      }
+
+   cout << "Step 7: compile synchronously while the service is running\n";
+   AddConstantMethod syncMethod(&sharedTypes, 100);
+   void *entry = NULL;
+   int32_t rc = compileMethodBuilder(&syncMethod, &entry);
+   passed = check(syncMethod, rc, entry) && passed;
+
+   cout << "Step 8: shutdown JIT\n";
+   shutdownJit();
+
+   if (!passed)
+      exit(-3);
+   cout << "PASS\n";
+   }
+
+
+
+AddConstantMethod::AddConstantMethod(OMR::JitBuilder::TypeDictionary *d, int32_t constant)
+   : OMR::JitBuilder::MethodBuilder(d, (OMR::JitBuilder::VirtualMachineState *) NULL),
+   _constant(constant)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   snprintf(_name, sizeof(_name), "add%d", constant);
+   DefineName(_name);
+   DefineParameter("value", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+AddConstantMethod::buildIL()
+   {
+   Return(
+      Add(
+         Load("value"),
+         ConstInt32(_constant)));
+
+   return true;
+   }
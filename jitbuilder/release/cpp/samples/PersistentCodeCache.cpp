@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "PersistentCodeCache.hpp"
+
+using std::cout;
+using std::cerr;
+
+#define TOSTR(x)     #x
+#define LINETOSTR(x) TOSTR(x)
+
+// Size of the header at the start of a cache file; a file holding no more
+// than this has no methods in it
+#define CACHE_FILE_HEADER_SIZE 24
+
+typedef int32_t (ScaleFunction)(int32_t);
+typedef int32_t (SumToFunction)(int32_t);
+
+static char cacheFile[64];
+static char options[256];
+
+static long
+cacheFileSize()
+   {
+   struct stat status;
+   if (stat(cacheFile, &status) != 0)
+      return -1;
+   return (long) status.st_size;
+   }
+
+// One run of a JIT client: start the JIT on the cache file, compile both
+// methods, call them and shut the JIT down again.  Whether the methods were
+// compiled or installed from the cache is seen from the size of the file.
+static bool
+runJit(const char *label)
+   {
+   cout << label << "\n";
+   if (!initializeJitWithOptions(options))
+      {
+      cerr << "FAIL: could not initialize JIT\n";
+      return false;
+      }
+
+   bool passed = true;
+   OMR::JitBuilder::TypeDictionary types;
+
+   ScaleMethod scaleMethod(&types);
+   void *entry = NULL;
+   int32_t rc = compileMethodBuilder(&scaleMethod, &entry);
+   if (rc != 0)
+      {
+      cerr << "FAIL: compilation error " << rc << " for scale\n";
+      passed = false;
+      }
+   else
+      {
+      ScaleFunction *scale = (ScaleFunction *) entry;
+      if (scale(7) != 7 * 13 + 5)
+         {
+         cerr << "FAIL: scale(7) returned " << scale(7) << "\n";
+         passed = false;
+         }
+      }
+
+   SumToMethod sumToMethod(&types);
+   rc = compileMethodBuilder(&sumToMethod, &entry);
+   if (rc != 0)
+      {
+      cerr << "FAIL: compilation error " << rc << " for sumTo\n";
+      passed = false;
+      }
+   else
+      {
+      SumToFunction *sumTo = (SumToFunction *) entry;
+      if (sumTo(100) != 5050 || sumTo(0) != 0)
+         {
+         cerr << "FAIL: sumTo(100) returned " << sumTo(100) << ", sumTo(0) returned " << sumTo(0) << "\n";
+         passed = false;
+         }
+      }
+
+   shutdownJit();
+   return passed;
+   }
+
+static bool
+expectSize(long expected, const char *why)
+   {
+   long size = cacheFileSize();
+   if (size != expected)
+      {
+      cerr << "FAIL: cache file holds " << size << " bytes rather than " << expected << ": " << why << "\n";
+      return false;
+      }
+   return true;
+   }
+
+int
+main(int argc, char *argv[])
+   {
+   snprintf(cacheFile, sizeof(cacheFile), "persistentcodecache-%ld.cache", (long) getpid());
+   snprintf(options, sizeof(options), "-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,persistentCodeCache=%s", cacheFile);
+   unlink(cacheFile);
+
+   bool passed = runJit("Step 1: compile both methods and store them in the cache");
+   long storedSize = cacheFileSize();
+   if (storedSize <= CACHE_FILE_HEADER_SIZE)
+      {
+      cerr << "FAIL: nothing was stored in the cache, the file holds " << storedSize << " bytes\n";
+      unlink(cacheFile);
+      exit(-1);
+      }
+
+   passed = runJit("Step 2: install both methods from the cache") && passed;
+   passed = expectSize(storedSize, "methods installed from the cache are not stored again") && passed;
+
+   cout << "Step 3: cut the last method short\n";
+   if (truncate(cacheFile, storedSize - 8) != 0)
+      {
+      cerr << "FAIL: could not truncate the cache file\n";
+      passed = false;
+      }
+   passed = runJit("Step 4: compile the method that was cut short again") && passed;
+   passed = expectSize(storedSize, "the partial record is dropped and the method is stored anew") && passed;
+
+   cout << "Step 5: corrupt the file header\n";
+   FILE *file = fopen(cacheFile, "r+b");
+   if (file == NULL || fwrite("garbage!", 1, 8, file) != 8)
+      {
+      cerr << "FAIL: could not overwrite the cache file header\n";
+      passed = false;
+      }
+   if (file != NULL)
+      fclose(file);
+   passed = runJit("Step 6: compile both methods into a fresh cache") && passed;
+   passed = expectSize(storedSize, "the corrupted file is replaced by one holding both methods") && passed;
+
+   passed = runJit("Step 7: install both methods from the recovered cache") && passed;
+   passed = expectSize(storedSize, "methods installed from the cache are not stored again") && passed;
+
+   unlink(cacheFile);
+   if (!passed)
+      exit(-2);
+   cout << "PASS\n";
+   }
+
+
+
+ScaleMethod::ScaleMethod(OMR::JitBuilder::TypeDictionary *d)
+   : OMR::JitBuilder::MethodBuilder(d, (OMR::JitBuilder::VirtualMachineState *) NULL)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   DefineName("scale");
+   DefineParameter("value", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+ScaleMethod::buildIL()
+   {
+   Return(
+      Add(
+         Mul(
+            Load("value"),
+            ConstInt32(13)),
+         ConstInt32(5)));
+
+   return true;
+   }
+
+SumToMethod::SumToMethod(OMR::JitBuilder::TypeDictionary *d)
+   : OMR::JitBuilder::MethodBuilder(d, (OMR::JitBuilder::VirtualMachineState *) NULL)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   DefineName("sumTo");
+   DefineParameter("n", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+SumToMethod::buildIL()
+   {
+   Store("sum",
+      ConstInt32(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop,
+      ConstInt32(1),
+      Add(
+         Load("n"),
+         ConstInt32(1)),
+      ConstInt32(1));
+
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Load("i")));
+
+   Return(
+      Load("sum"));
+
+   return true;
+   }
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "TieredCompile.hpp"
+
+TieredFibonacciMethod::TieredFibonacciMethod(OMR::JitBuilder::TypeDictionary *types, const char *name)
+   : OMR::JitBuilder::MethodBuilder(types),
+   _name(name)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   DefineName(name);
+   DefineParameter("n", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+TieredFibonacciMethod::buildIL()
+   {
+   OMR::JitBuilder::IlBuilder *baseCase=NULL, *recursiveCase=NULL;
+   IfThenElse(&baseCase, &recursiveCase,
+      LessThan(
+         Load("n"),
+         ConstInt32(2)));
+
+   DefineLocal("result", Int32);
+
+   baseCase->Store("result",
+   baseCase->   Load("n"));
+
+   recursiveCase->Store("result",
+   recursiveCase->   Add(
+   recursiveCase->      Call(_name, 1,
+   recursiveCase->         Sub(
+   recursiveCase->            Load("n"),
+   recursiveCase->            ConstInt32(1))),
+   recursiveCase->      Call(_name, 1,
+   recursiveCase->         Sub(
+   recursiveCase->            Load("n"),
+   recursiveCase->            ConstInt32(2)))));
+
+   Return(
+      Load("result"));
+
+   return true;
+   }
+
+FailingRecompileMethod::FailingRecompileMethod(OMR::JitBuilder::TypeDictionary *types, int32_t failingBuild)
+   : OMR::JitBuilder::MethodBuilder(types),
+   _failingBuild(failingBuild),
+   _builds(0)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   DefineName("add_failing");
+   DefineParameter("n", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+FailingRecompileMethod::buildIL()
+   {
+   if (++_builds == _failingBuild)
+      return false;
+
+   Return(
+      Add(
+         Load("n"),
+         ConstInt32(3)));
+
+   return true;
+   }
+
+static int32_t
+fib(int32_t n)
+   {
+   int32_t last = 0, sum = 1;
+   if (n < 2)
+      return n;
+   for (int32_t i = 1; i < n; i++)
+      {
+      int32_t next = sum + last;
+      last = sum;
+      sum = next;
+      }
+   return sum;
+   }
+
+// Calls enough times for the method to go through every tier
+static bool
+runFib(TieredFibFunctionType *tiered_fib)
+   {
+   for (int32_t round = 0; round < 10; round++)
+      {
+      for (int32_t n = 0; n < 24; n++)
+         {
+         int32_t result = tiered_fib(n);
+         if (result != fib(n))
+            {
+            fprintf(stderr, "FAIL: fib(%d) returned %d, expected %d\n", n, result, fib(n));
+            return false;
+            }
+         }
+      }
+   printf("fib(%2d) = %d\n", 23, tiered_fib(23));
+   return true;
+   }
+
+int
+main(int argc, char *argv[])
+   {
+   printf("Step 1: initialize JIT\n");
+   bool initialized = initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,tieredWarmCount=100,tieredHotCount=10000");
+   if (!initialized)
+      {
+      fprintf(stderr, "FAIL: could not initialize JIT\n");
+      exit(-1);
+      }
+
+   printf("Step 2: define type dictionary\n");
+   OMR::JitBuilder::TypeDictionary types;
+
+   printf("Step 3: compile method builder tiered, recompiling on the calling thread\n");
+   TieredFibonacciMethod syncMethodBuilder(&types, "fib_sync");
+   void *entry = 0;
+   int32_t rc = compileMethodBuilderTiered(&syncMethodBuilder, &entry);
+   if (rc != 0)
+      {
+      fprintf(stderr,"FAIL: compilation error %d\n", rc);
+      exit(-2);
+      }
+
+   printf("Step 4: invoke compiled code\n");
+   if (!runFib((TieredFibFunctionType *)entry))
+      exit(-3);
+
+   printf("Step 5: compile method builder tiered, failing its first recompilation\n");
+   // The first warm compilation fails; the method must keep running cold,
+   // count down again and then make it through the warm and hot tiers.
+   FailingRecompileMethod failingMethodBuilder(&types, 2);
+   rc = compileMethodBuilderTiered(&failingMethodBuilder, &entry);
+   if (rc != 0)
+      {
+      fprintf(stderr,"FAIL: compilation error %d\n", rc);
+      exit(-7);
+      }
+   TieredAddFunctionType *tiered_add = (TieredAddFunctionType *)entry;
+   for (int32_t n = 0; n < 12000; n++)
+      {
+      if (tiered_add(n) != n + 3)
+         {
+         fprintf(stderr, "FAIL: add_failing(%d) returned %d\n", n, tiered_add(n));
+         exit(-8);
+         }
+      }
+   if (failingMethodBuilder.builds() != 4)
+      {
+      fprintf(stderr, "FAIL: add_failing was built %d times rather than cold, failed warm, warm and hot\n", failingMethodBuilder.builds());
+      exit(-9);
+      }
+
+#if !defined(_WIN32)
+   printf("Step 6: compile method builder tiered, recompiling on a compilation thread\n");
+   if (!startCompilationThreads(1))
+      {
+      fprintf(stderr, "FAIL: could not start compilation threads\n");
+      exit(-4);
+      }
+   TieredFibonacciMethod asyncMethodBuilder(&types, "fib_async");
+   rc = compileMethodBuilderTiered(&asyncMethodBuilder, &entry);
+   if (rc != 0)
+      {
+      fprintf(stderr,"FAIL: compilation error %d\n", rc);
+      exit(-5);
+      }
+
+   printf("Step 7: invoke compiled code\n");
+   if (!runFib((TieredFibFunctionType *)entry))
+      exit(-6);
+#endif /* !defined(_WIN32) */
+
+   printf("Step 8: shutdown JIT\n");
+   shutdownJit();
+
+   printf("PASS\n");
+   }
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef TIEREDCOMPILE_INCL
+#define TIEREDCOMPILE_INCL
+
+#include "JitBuilder.hpp"
+
+typedef int32_t (TieredFibFunctionType)(int32_t);
+
+class TieredFibonacciMethod : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   TieredFibonacciMethod(OMR::JitBuilder::TypeDictionary *types, const char *name);
+   virtual bool buildIL();
+
+   private:
+   const char *_name;
+   };
+
+typedef int32_t (TieredAddFunctionType)(int32_t);
+
+// Fails to build its IL for the compilation given by failingBuild (counting from 1)
+class FailingRecompileMethod : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   FailingRecompileMethod(OMR::JitBuilder::TypeDictionary *types, int32_t failingBuild);
+   virtual bool buildIL();
+
+   int32_t builds() const { return _builds; }
+
+   private:
+   int32_t _failingBuild;
+   int32_t _builds;
+   };
+
+#endif // !defined(TIEREDCOMPILE_INCL)
@@ -48,10 +48,12 @@ extern "C" {
  */
 #define OMR_ENABLE_EXCEPTION_OUTPUT 0
 
-/* Temporarily allow and ignore the output=<filename> command-line option until
- * it has been removed from all test scripts.
+/* Allow the output=<filename>[,<size>[,<generations>]] option, which writes published
+ * trace buffers to a rotating set of memory-mapped files.
  */
 #define OMR_ALLOW_OUTPUT_OPTION 1
+#define UT_DEFAULT_OUTPUT_FILE_SIZE (16 * 1024 * 1024)
+#define UT_MAX_OUTPUT_GENERATIONS 36
 
 #define UT_DEBUG                      "UTE_DEBUG"
 #if OMR_ENABLE_EXCEPTION_OUTPUT
@@ -211,6 +213,15 @@ typedef enum OMR_TraceEngineInitState {
  *  Trace Global Data
  * =============================================================================
  */
+/*
+ * Every trace buffer is given an index (starting at 1) in a segmented table, so
+ * the lock-free free buffer stack can pair a 32-bit buffer index with an ABA tag
+ * in a single 64-bit compare and swap.
+ */
+#define UT_BUFFER_TABLE_SEGMENT_SHIFT 10
+#define UT_BUFFER_TABLE_SEGMENT_SIZE (1 << UT_BUFFER_TABLE_SEGMENT_SHIFT)
+#define UT_BUFFER_TABLE_SEGMENTS 256
+
 struct OMR_TraceGlobal {
 	const OMR_VM *vm;				/* Client identifier               */
 	OMRPortLibrary *portLibrary;    /* Port Library                    */
@@ -234,8 +245,8 @@ struct OMR_TraceGlobal {
 	OMR_TraceBuffer *exceptionTrcBuf;	/* Exception trace buffers         */
 #endif /* OMR_ENABLE_EXCEPTION_OUTPUT */
 	OMR_TraceThread *lastPrint;		/* OMR_TraceThread for last print     */
-	OMR_TraceBuffer *freeQueue;		/* Free buffer queue               */
-	omrthread_monitor_t freeQueueLock;	/* lock for free queue */
+	volatile uint64_t freeBuffers;	/* Lock-free stack of free buffers: ABA tag in the high 32 bits, index of the top buffer in the low 32 bits */
+	volatile uintptr_t publishQueue;	/* Lock-free stack of published buffers waiting to be passed to the subscribers */
 	UtTraceCfg *config;				/* Trace selection cmds link/list  */
 	UtTraceFileHdr *traceHeader;	/* Trace file header               */
 	UtComponentList *componentList;	/* registered or configured component */
@@ -248,7 +259,10 @@ struct OMR_TraceGlobal {
 	int fatalassert;				/* Whether assertion type trace points are fatal or not. */
 	OMR_TraceLanguageInterface languageIntf;				 /* Language interface */
 	J9Pool *bufferPool;				/* Pool for allocating all UtTraceBuffers */
+	OMR_TraceBuffer **bufferTable[UT_BUFFER_TABLE_SEGMENTS];	/* Maps buffer indices to buffers. Segments are allocated on demand. */
+	uint32_t bufferTableCount;		/* Number of buffer indices handed out. Protected by bufferPoolLock. */
 	omrthread_monitor_t bufferPoolLock;	/* Lock for buffer pool. Do not allow tracepoints while locking, holding, or releasing this monitor. */
+	struct UtMappedOutput *mappedOutput;	/* Memory-mapped binary trace output, or NULL */
 	J9Pool *threadPool;				/* Pool for allocating all UtThreadData */
 	omrthread_monitor_t threadPoolLock;	/* Lock for thread pool. Do not allow tracepoints while locking, holding, or releasing this monitor. */
 };
@@ -464,6 +478,21 @@ omr_error_t setFormat(const char *datDir);
  */
 void doTracePoint(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char *spec, va_list varArgs);
 
+/**
+ * @brief Creates a trace point from pre-packed arguments
+ *
+ * The packed equivalent of doTracePoint(). The generated trace macros pack fixed-size
+ * arguments into the same layout that maximal trace writes to the buffer, so data is
+ * copied without interpreting a spec. Only minimal and maximal trace are recorded.
+ *
+ * @param[in] thr The OMR_TraceThread for the currently executing thread. Must not be NULL.
+ * @param[in] modInfo A pointer to the UtModuleInfo for the module this trace point belongs to.
+ * @param[in] traceId The trace point id for this trace point.
+ * @param[in] data    The packed trace point arguments.
+ * @param[in] length  The number of bytes at data.
+ */
+void doPackedTracePoint(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const void *data, uint32_t length);
+
 void enlistRecordSubscriber(UtSubscription *subscription);
 void delistRecordSubscriber(UtSubscription *subscription);
 void deleteRecordSubscriber(OMR_TraceGlobal *global, UtSubscription *subscription);
@@ -514,6 +543,7 @@ omr_error_t trcDeregisterRecordSubscriber(OMR_TraceThread *thr, UtSubscription *
  *  All functions on the module interface (and only functions on the module interface) start
  *  with j9 **/
 void omrTrace(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *spec, ...);
+void omrTracePacked(void *env, UtModuleInfo *modInfo, uint32_t traceId, const void *data, uint32_t length);
 
 
 /**
@@ -536,6 +566,45 @@ omr_error_t publishTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf
  */
 omr_error_t releaseTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf);
 
+/**
+ * @brief Pass published trace buffers to the subscribers.
+ *
+ * Buffers are published by pushing them on a lock-free queue. Whichever thread
+ * acquires OMR_TRACEGLOBAL(subscribersLock) delivers the queued buffers, in
+ * publication order, on behalf of all publishers and then releases them. A
+ * publishing thread that fails to acquire the lock returns immediately; the
+ * lock owner rechecks the queue after releasing the lock, so no buffer is stranded.
+ *
+ * @param[in] currentThr The current thread.
+ * @param[in] wait If TRUE, block until the lock is acquired and the queue is drained.
+ */
+void deliverPublishedTraceBuffers(OMR_TraceThread *currentThr, BOOLEAN wait);
+
+/**
+ * @brief Start writing published trace buffers to memory-mapped files.
+ *
+ * Registers an internal subscriber that copies each published record into a
+ * pre-sized file mapping. Only used while processing options at startup.
+ *
+ * @param[in] fileName The output file name. '#' is replaced by the generation number.
+ * @param[in] fileSize The size of each file.
+ * @param[in] generations The number of files to rotate through.
+ * @return an OMR error code
+ */
+omr_error_t startMappedTraceOutput(const char *fileName, uint64_t fileSize, uint32_t generations);
+
+/**
+ * @brief Close the memory-mapped trace output and free its state.
+ *
+ * @param[in] global The trace global data, which may no longer be reachable via omrTraceGlobal.
+ */
+void stopMappedTraceOutput(OMR_TraceGlobal *global);
+
+/**
+ * @brief Stop the memory-mapped trace output in a forked child, leaving the parent's file intact.
+ */
+void detachMappedTraceOutputAfterFork(void);
+
 /**
  * @brief Get a recycled trace buffer.
  *
@@ -269,6 +269,7 @@ postForkCleanupGlobals(OMR_TraceThread *thr)
 	}
 	OMR_TRACEGLOBAL(lastPrint) = NULL;
 	OMR_TRACEGLOBAL(lostRecords) = 0;
+	detachMappedTraceOutputAfterFork();
 #if OMR_ENABLE_EXCEPTION_OUTPUT
 	OMR_TRACEGLOBAL(exceptionTrcBuf) = NULL;
 	OMR_TRACEGLOBAL(exceptionContext) = NULL;
@@ -278,8 +279,10 @@ postForkCleanupGlobals(OMR_TraceThread *thr)
 void
 postForkCleanupBuffers(OMR_TraceThread *thr)
 {
-	/* Clear all buffers in the pool and in freeQueue. */
-	OMR_TRACEGLOBAL(freeQueue) = NULL;
+	/* Clear all buffers in the pool, the free buffer stack and the publish queue. */
+	OMR_TRACEGLOBAL(freeBuffers) = 0;
+	OMR_TRACEGLOBAL(publishQueue) = 0;
+	OMR_TRACEGLOBAL(bufferTableCount) = 0;
 	if (NULL != thr) {
 		thr->trcBuf = NULL;
 	}
@@ -219,6 +219,14 @@ omr_trc_getTracePointIteratorForNextBuffer(UtTraceFileIterator *fileIterator, Ut
 		}
 	}
 
+	if (0 == iterator->buffer->record.firstEntry) {
+		/* An unused slot. The rest of a pre-sized, memory-mapped trace file is empty. */
+		omrmem_free_memory(iterator->buffer);
+		omrmem_free_memory(iterator);
+		*bufferIteratorPtr = NULL;
+		return OMR_ERROR_NONE;
+	}
+
 	iterator->recordLength = fileIterator->header->bufferSize;
 	iterator->end = iterator->buffer->record.nextEntry;
 	iterator->start = iterator->buffer->record.firstEntry;
@@ -227,7 +235,7 @@ omr_trc_getTracePointIteratorForNextBuffer(UtTraceFileIterator *fileIterator, Ut
 	iterator->currentPos = iterator->buffer->record.nextEntry;
 	iterator->startPlatform = fileIterator->traceSection->startPlatform;
 	iterator->startSystem = fileIterator->traceSection->startSystem;
-	iterator->endPlatform = omrtime_hires_clock(); /* TODO - Is there a better timestamp we can use here? */
+	iterator->endPlatform = omrtime_fast_ticks(); /* TODO - Is there a better timestamp we can use here? */
 	iterator->endSystem = ((uint64_t) omrtime_current_time_millis()); /* TODO - Is there a better timestamp we can use here? */
 	iterator->portLib = fileIterator->portLib;
 	iterator->getFormatStringFn = fileIterator->getFormatStringFn;
@@ -265,6 +273,43 @@ omr_trc_getTracePointIteratorForNextBuffer(UtTraceFileIterator *fileIterator, Ut
 
 }
 
+omr_error_t
+omr_trc_formatTraceFile(OMRPortLibrary *portLib, char *fileName, FormatStringCallback getFormatStringFn, intptr_t outputFile, uint64_t *tracePointCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+	UtTraceFileIterator *fileIterator = NULL;
+	UtTracePointIterator *bufferIterator = NULL;
+	char threadName[UT_MAX_THREAD_NAME_LENGTH + 1];
+	char line[1024];
+	uint64_t count = 0;
+	omr_error_t rc = omr_trc_getTraceFileIterator(OMRPORTLIB, fileName, &fileIterator, getFormatStringFn);
+
+	if (OMR_ERROR_NONE != rc) {
+		return rc;
+	}
+
+	for (;;) {
+		rc = omr_trc_getTracePointIteratorForNextBuffer(fileIterator, &bufferIterator);
+		if ((OMR_ERROR_NONE != rc) || (NULL == bufferIterator)) {
+			break;
+		}
+		omr_trc_getBufferIteratorThreadName(bufferIterator, threadName, sizeof(threadName));
+		while (NULL != omr_trc_formatNextTracePoint(bufferIterator, line, sizeof(line))) {
+			if (-1 != outputFile) {
+				omrfile_printf(outputFile, "%s %s\n", threadName, line);
+			}
+			count += 1;
+		}
+		omr_trc_freeTracePointIterator(bufferIterator);
+	}
+	omr_trc_freeTraceFileIterator(fileIterator);
+
+	if (NULL != tracePointCount) {
+		*tracePointCount = count;
+	}
+	return rc;
+}
+
 uint64_t
 omr_trc_getBufferIteratorThreadId(UtTracePointIterator *iter)
 {
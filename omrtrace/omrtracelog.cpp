@@ -216,9 +216,9 @@ getTrcBuf(OMR_TraceThread *thr, OMR_TraceBuffer *oldBuf, int bufferType)
 	uint64_t writeSystem;
 
 	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
-	writePlatform = omrtime_hires_clock();
+	writePlatform = omrtime_fast_ticks();
 	writeSystem = ((uint64_t) omrtime_current_time_millis());
-	writePlatform = (writePlatform >> 1) + (omrtime_hires_clock() >> 1);
+	writePlatform = (writePlatform >> 1) + (omrtime_fast_ticks() >> 1);
 
 	if (oldBuf != NULL) {
 		/*
@@ -617,46 +617,32 @@ traceCount(UtModuleInfo *moduleInfo, uint32_t traceId)
 }
 
 /*******************************************************************************
- * name        - utTraceV
- * description - Make a tracepoint
- * parameters  - OMR_TraceThread, tracepoint identifier and trace data.
- * returns     - void
+ * name        - beginTraceRecord
+ * description - Write the tracepoint id, timestamp and component name of a
+ *               new trace entry into the thread's (or exception) buffer
+ * parameters  - OMR_TraceThread, module, tracepoint identifier, buffer type,
+ *               and out parameters for the buffer, cursor and entry length
+ * returns     - TRUE if an entry was started, FALSE if no buffer is available
  *
+ * On success the cursor points at the entry's length byte, which is where any
+ * tracepoint data is written.
  ******************************************************************************/
-static void
-traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char *spec,
-	   va_list var, int bufferType)
+static BOOLEAN
+beginTraceRecord(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, int bufferType,
+	   OMR_TraceBuffer **trcBufPtr, char **pPtr, int *entryLengthPtr)
 {
 	OMR_TraceBuffer   *trcBuf;
 	int                lastSequence;
 	int                entryLength;
 	int                length;
 	char              *p;
-	const signed char *str;
-	char              *format = NULL;
 	int32_t               intVar;
 	char               charVar;
-	unsigned short     shortVar;
-	int64_t               i64Var;
-	double             doubleVar;
-	char              *ptrVar;
 	const char        *stringVar;
 	size_t             stringVarLen;
 	char              *containerModuleVar = NULL;
 	size_t             containerModuleVarLen = 0;
 	char               temp[3];
-	static char        lengthConversion[] = {0,
-											 sizeof(char),
-											 sizeof(short),
-											 0,
-											 sizeof(int32_t),
-											 sizeof(float),
-											 sizeof(char *),
-											 sizeof(double),
-											 sizeof(int64_t),
-											 sizeof(long double),
-											 0
-											};
 	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
 
 	if (modInfo != NULL) {
@@ -681,18 +667,18 @@ traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char
 		if (((trcBuf = thr->trcBuf) == NULL)
 		 && ((trcBuf = getTrcBuf(thr, NULL, bufferType)) == NULL)
 		) {
-			return;
+			return FALSE;
 		}
 #if OMR_ENABLE_EXCEPTION_OUTPUT
 	} else if (bufferType == UT_EXCEPTION_BUFFER) {
 		if (((trcBuf = OMR_TRACEGLOBAL(exceptionTrcBuf)) == NULL)
 		 && ((trcBuf = getTrcBuf(thr, NULL, bufferType)) == NULL)
 		) {
-			return;
+			return FALSE;
 		}
 #endif
 	} else {
-		return;
+		return FALSE;
 	}
 
 	if (trcBuf->flags & UT_TRC_BUFFER_NEW) {
@@ -700,7 +686,7 @@ traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char
 		trcBuf->thr = thr;
 	}
 	lastSequence = (int32_t)(trcBuf->record.sequence >> 32);
-	trcBuf->record.sequence = omrtime_hires_clock();
+	trcBuf->record.sequence = omrtime_fast_ticks();
 	p = (char *)&trcBuf->record + trcBuf->record.nextEntry + 1;
 
 	/* additional sanity check */
@@ -712,7 +698,7 @@ traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char
 		thr->trcBuf = NULL;
 		trcBuf = getTrcBuf(thr, NULL, bufferType);
 		if (trcBuf == NULL) {
-			return;
+			return FALSE;
 		}
 
 		p = (char *)&trcBuf->record + trcBuf->record.nextEntry + 1;
@@ -811,6 +797,92 @@ traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char
 		entryLength--;
 	}
 
+	*trcBufPtr = trcBuf;
+	*pPtr = p;
+	*entryLengthPtr = entryLength;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * name        - endTraceRecord
+ * description - Complete a trace entry whose length byte is at p, adding the
+ *               extended length marker for long entries
+ * parameters  - OMR_TraceThread, buffer type, current buffer, cursor and
+ *               entry length
+ * returns     - void
+ *
+ ******************************************************************************/
+static void
+endTraceRecord(OMR_TraceThread *thr, int bufferType, OMR_TraceBuffer *trcBuf, char *p, int entryLength)
+{
+	/*
+	 *  Most tracepoints should now be complete, so we might bail out now.
+	 *  We don't need a -1 in the nextEntry assignment as we do elsewhere when
+	 *  copyToBuffer's been involved because p is decremented above.
+	 */
+	if (entryLength <= UT_MAX_TRC_LENGTH) {
+		trcBuf->record.nextEntry =
+			(int32_t)(p - (char *)&trcBuf->record);
+	} else {
+		/*
+		 *  Handle long trace records
+		 */
+		char temp[4];
+		p++;
+		temp[0] = 0;
+		temp[1] = 0;
+		temp[2] = (char)(entryLength >> 8);
+		temp[3] = UT_TRC_EXTENDED_LENGTH;
+		copyToBuffer(thr, bufferType, temp, &p, 4, &entryLength, &trcBuf);
+		/* copyToBuffer increments p past the last byte written, but nextEntry
+		 * needs to point to the length byte so we need -1 here.
+		 */
+		trcBuf->record.nextEntry =
+			(int32_t)(p - (char *)&trcBuf->record - 1);
+	}
+}
+
+/*******************************************************************************
+ * name        - utTraceV
+ * description - Make a tracepoint
+ * parameters  - OMR_TraceThread, tracepoint identifier and trace data.
+ * returns     - void
+ *
+ ******************************************************************************/
+static void
+traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char *spec,
+	   va_list var, int bufferType)
+{
+	OMR_TraceBuffer   *trcBuf;
+	int                entryLength;
+	int                length;
+	char              *p;
+	const signed char *str;
+	char              *format = NULL;
+	int32_t               intVar;
+	char               charVar;
+	unsigned short     shortVar;
+	int64_t               i64Var;
+	double             doubleVar;
+	char              *ptrVar;
+	const char        *stringVar;
+	static char        lengthConversion[] = {0,
+											 sizeof(char),
+											 sizeof(short),
+											 0,
+											 sizeof(int32_t),
+											 sizeof(float),
+											 sizeof(char *),
+											 sizeof(double),
+											 sizeof(int64_t),
+											 sizeof(long double),
+											 0
+											};
+
+	if (!beginTraceRecord(thr, modInfo, traceId, bufferType, &trcBuf, &p, &entryLength)) {
+		return;
+	}
+
 	/*
 	 * Process maximal trace
 	 */
@@ -1090,32 +1162,55 @@ traceV(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const char
 		}
 	}
 
+	endTraceRecord(thr, bufferType, trcBuf, p, entryLength);
+}
+
+/*******************************************************************************
+ * name        - tracePacked
+ * description - Make a tracepoint from arguments that the generated tracepoint
+ *               macro has already packed into trace buffer layout
+ * parameters  - OMR_TraceThread, tracepoint identifier, packed data and its
+ *               length
+ * returns     - void
+ *
+ ******************************************************************************/
+static void
+tracePacked(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const void *data,
+	   uint32_t length, int bufferType)
+{
+	OMR_TraceBuffer   *trcBuf;
+	int                entryLength;
+	char              *p;
+
+	if (!beginTraceRecord(thr, modInfo, traceId, bufferType, &trcBuf, &p, &entryLength)) {
+		return;
+	}
+
 	/*
-	 *  Most tracepoints should now be complete, so we might bail out now.
-	 *  We don't need a -1 in the nextEntry assignment as we do elsewhere when
-	 *  copyToBuffer's been involved because p is decremented above.
+	 * The data is already in the layout that traceV produces for the same spec,
+	 * so maximal trace is a single copy and the formatter sees no difference.
 	 */
-	if (entryLength <= UT_MAX_TRC_LENGTH) {
-		trcBuf->record.nextEntry =
-			(int32_t)(p - (char *)&trcBuf->record);
-		return;
-	} else {
-		/*
-		 *  Handle long trace records
-		 */
-		char temp[4];
-		p++;
-		temp[0] = 0;
-		temp[1] = 0;
-		temp[2] = (char)(entryLength >> 8);
-		temp[3] = UT_TRC_EXTENDED_LENGTH;
-		copyToBuffer(thr, bufferType, temp, &p, 4, &entryLength, &trcBuf);
-		/* copyToBuffer increments p past the last byte written, but nextEntry
-		 * needs to point to the length byte so we need -1 here.
-		 */
-		trcBuf->record.nextEntry =
-			(int32_t)(p - (char *)&trcBuf->record - 1);
+	if (OMR_ARE_ANY_BITS_SET(thr->currentOutputMask, UT_MAXIMAL) && (0 != length)) {
+		if ((p + length + 1) < ((char *)&trcBuf->record + OMR_TRACEGLOBAL(bufferSize))) {
+			memcpy(p, data, length);
+			p += length;
+			entryLength += (int)length;
+			*p = (unsigned char)entryLength;
+		} else {
+			char charVar;
+			copyToBuffer(thr, bufferType, (const char *)data, &p, (int)length, &entryLength, &trcBuf);
+			if (((char *)&trcBuf->record + OMR_TRACEGLOBAL(bufferSize) - p) > (int32_t)sizeof(char)) {
+				*p = (unsigned char)entryLength;
+			} else {
+				charVar = (unsigned char)entryLength;
+				copyToBuffer(thr, bufferType, &charVar, &p, sizeof(char), &entryLength, &trcBuf);
+				entryLength--;
+				p--;
+			}
+		}
 	}
+
+	endTraceRecord(thr, bufferType, trcBuf, p, entryLength);
 }
 
 #if OMR_ENABLE_EXCEPTION_OUTPUT
@@ -1198,6 +1293,45 @@ omrTrace(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *spec, .
 	}
 }
 
+void
+omrTracePacked(void *env, UtModuleInfo *modInfo, uint32_t traceId, const void *data, uint32_t length)
+{
+	OMR_TraceThread *thr = OMR_TRACE_THREAD_FROM_ENV(env);
+	if (NULL != thr) {
+		doPackedTracePoint(thr, modInfo, traceId, data, length);
+	}
+}
+
+/*******************************************************************************
+ * name        - doPackedTracePoint
+ * description - Make a tracepoint whose arguments are already packed, not
+ *               called directly outside of rastrace
+ * parameters  - OMR_TraceThread, tracepoint identifier and packed trace data.
+ * returns     - void
+ *
+ * Only minimal and maximal buffer trace is recorded; the generated macros
+ * route every other output type through doTracePoint.
+ ******************************************************************************/
+void
+doPackedTracePoint(OMR_TraceThread *thr, UtModuleInfo *modInfo, uint32_t traceId, const void *data, uint32_t length)
+{
+	if ((NULL == omrTraceGlobal) || (OMR_TRACE_ENGINE_SHUTDOWN_STARTED == OMR_TRACEGLOBAL(initState))) {
+		return;
+	}
+
+	if ((NULL == thr) || thr->recursion) {
+		return;
+	}
+	incrementRecursionCounter(thr);
+
+	thr->currentOutputMask = (unsigned char)(traceId & UT_TRACE_PACKED_OUTPUT);
+	if ((OMR_TRACEGLOBAL(traceSuspend) == 0) && (thr->suspendResume >= 0) && (0 != thr->currentOutputMask)) {
+		tracePacked(thr, modInfo, traceId, data, length, UT_NORMAL_BUFFER);
+	}
+
+	decrementRecursionCounter(thr);
+}
+
 /*******************************************************************************
  * name        - doTracePoint
  * description - Make a tracepoint, not called directly outside of rastrace
@@ -1353,6 +1487,30 @@ allocateTraceBuffer(OMR_TraceThread *currentThread)
 	}
 	omrthread_monitor_enter(OMR_TRACEGLOBAL(bufferPoolLock));
 	newTrcBuffer = (OMR_TraceBuffer *)pool_newElement(OMR_TRACEGLOBAL(bufferPool));
+	if (NULL != newTrcBuffer) {
+		/* Enter the buffer in the buffer table so it can be linked into the lock-free free buffer stack */
+		uint32_t slot = OMR_TRACEGLOBAL(bufferTableCount);
+		uint32_t segment = slot >> UT_BUFFER_TABLE_SEGMENT_SHIFT;
+		OMR_TraceBuffer **segmentBase = NULL;
+
+		if (segment < UT_BUFFER_TABLE_SEGMENTS) {
+			segmentBase = OMR_TRACEGLOBAL(bufferTable)[segment];
+			if (NULL == segmentBase) {
+				OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+				segmentBase = (OMR_TraceBuffer **)omrmem_allocate_memory(UT_BUFFER_TABLE_SEGMENT_SIZE * sizeof(OMR_TraceBuffer *), OMRMEM_CATEGORY_TRACE);
+				OMR_TRACEGLOBAL(bufferTable)[segment] = segmentBase;
+			}
+		}
+		if (NULL == segmentBase) {
+			UT_DBGOUT(1, ("<UT> Unable to index trace buffer %u\n", slot + 1));
+			pool_removeElement(OMR_TRACEGLOBAL(bufferPool), newTrcBuffer);
+			newTrcBuffer = NULL;
+		} else {
+			segmentBase[slot & (UT_BUFFER_TABLE_SEGMENT_SIZE - 1)] = newTrcBuffer;
+			newTrcBuffer->index = slot + 1;
+			OMR_TRACEGLOBAL(bufferTableCount) = slot + 1;
+		}
+	}
 	omrthread_monitor_exit(OMR_TRACEGLOBAL(bufferPoolLock));
 	if (NULL != currentThread) {
 		decrementRecursionCounter(currentThread);
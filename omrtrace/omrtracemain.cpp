@@ -392,6 +392,8 @@ freeTrace(void)
 		global->traceHeader = NULL;
 	}
 
+	stopMappedTraceOutput(global);
+
 	UtSubscription *subscription = (UtSubscription *)global->subscribers;
 	while (NULL != subscription) {
 		UtSubscription *next = subscription->next;
@@ -403,15 +405,20 @@ freeTrace(void)
 	omrthread_monitor_destroy(global->subscribersLock);
 	global->subscribersLock = NULL;
 
-	omrthread_monitor_destroy(global->freeQueueLock);
-	global->freeQueueLock = NULL;
-
 	omrthread_monitor_destroy(global->traceLock);
 	global->traceLock = NULL;
 
 	omrthread_monitor_destroy(global->bufferPoolLock);
 	global->bufferPoolLock = NULL;
 
+	global->freeBuffers = 0;
+	for (uint32_t segment = 0; segment < UT_BUFFER_TABLE_SEGMENTS; segment++) {
+		if (NULL != global->bufferTable[segment]) {
+			omrmem_free_memory(global->bufferTable[segment]);
+			global->bufferTable[segment] = NULL;
+		}
+	}
+
 	pool_kill(global->bufferPool);
 	global->bufferPool = NULL;
 
@@ -548,11 +555,6 @@ initializeTrace(OMR_VM *vm, const char *datDir, const OMR_TraceLanguageInterface
 		rc = OMR_ERROR_FAILED_TO_ALLOCATE_MONITOR;
 		goto fail;
 	}
-	if (0 != omrthread_monitor_init_with_name(&OMR_TRACEGLOBAL(freeQueueLock), 0, "Global Trace Free Queue")) {
-		UT_DBGOUT(1, ("<UT> Initialization of freeQueueLock failed\n"));
-		rc = OMR_ERROR_FAILED_TO_ALLOCATE_MONITOR;
-		goto fail;
-	}
 	if (0 != omrthread_monitor_init_with_name(&OMR_TRACEGLOBAL(bufferPoolLock), 0, "Global Trace Buffer Pool")) {
 		UT_DBGOUT(1, ("<UT> Initialization of bufferPoolLock failed\n"));
 		rc = OMR_ERROR_FAILED_TO_ALLOCATE_MONITOR;
@@ -730,6 +732,10 @@ trcDeregisterRecordSubscriber(OMR_TraceThread *thr, UtSubscription *subscription
 	}
 
 	incrementRecursionCounter(thr);
+
+	/* Buffers published before deregistration are still delivered to the subscriber */
+	deliverPublishedTraceBuffers(thr, TRUE);
+
 	UT_DBGOUT(5, ("<UT thr=" UT_POINTER_SPEC "> Acquiring lock for deregistration\n", thr));
 	omrthread_monitor_enter(OMR_TRACEGLOBAL(subscribersLock));
 	UT_DBGOUT(5, ("<UT thr=" UT_POINTER_SPEC "> Lock acquired for deregistration\n", thr));
@@ -760,6 +766,12 @@ trcDeregisterRecordSubscriber(OMR_TraceThread *thr, UtSubscription *subscription
 static omr_error_t
 trcFlushTraceData(OMR_TraceThread *thr)
 {
+	if (NULL == thr) {
+		return OMR_THREAD_NOT_ATTACHED;
+	}
+
+	/* Pass any buffers queued by other publishers to the subscribers now */
+	deliverPublishedTraceBuffers(thr, TRUE);
 	return OMR_ERROR_NONE;
 }
 
@@ -811,11 +823,11 @@ setStartTime(void)
 	 * Try to get the time of the next millisecond rollover
 	 */
 	millis[0] = (uint64_t)omrtime_current_time_millis();
-	hires[0] = (uint64_t)omrtime_hires_clock();
+	hires[0] = (uint64_t)omrtime_fast_ticks();
 	do {
 		i ^= 1;
 		millis[i] = (uint64_t)omrtime_current_time_millis();
-		hires[i] = (uint64_t)omrtime_hires_clock();
+		hires[i] = (uint64_t)omrtime_fast_ticks();
 	} while (millis[0] == millis[1]);
 
 	OMR_TRACEGLOBAL(startPlatform) = ((hires[0] >> 1) + (hires[1] >> 1));
@@ -851,6 +863,7 @@ fillInUTInterfaces(UtInterface **utIntf, OMR_TraceInterface *omrTraceIntf, UtMod
 		utModuleIntf->Trace           = omrTrace;
 		utModuleIntf->TraceInit       = omrTraceInit;
 		utModuleIntf->TraceTerm       = omrTraceTerm;
+		utModuleIntf->TracePacked     = omrTracePacked;
 
 		/*
 		 * Make the interfaces available.
@@ -367,7 +367,95 @@ setException(OMR_TraceThread *thr, const char *value, BOOLEAN atRuntime)
 static omr_error_t
 setOutput(OMR_TraceThread *thr, const char *value, BOOLEAN atRuntime)
 {
-	return OMR_ERROR_NONE;
+	char *localBuffer = NULL;
+	char *fileName = NULL;
+	omr_error_t rc = OMR_ERROR_NONE;
+	uint64_t fileSize = UT_DEFAULT_OUTPUT_FILE_SIZE;
+	int generations = 1;
+	int numberOfArgs = 0;
+	int i;
+
+	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+
+	if ((NULL == value) || ('\0' == *value)) {
+		reportCommandLineError(atRuntime, "-Xtrace:output expects a file name.");
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+	numberOfArgs = getParmNumber(value);
+	if (numberOfArgs > 3) {
+		reportCommandLineError(atRuntime, "Too many parameters for -Xtrace:output - \"%s\"", value);
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+	localBuffer = (char *)omrmem_allocate_memory(strlen(value) + 1, OMRMEM_CATEGORY_TRACE);
+	fileName = (char *)omrmem_allocate_memory(strlen(value) + 1, OMRMEM_CATEGORY_TRACE);
+	if ((NULL == localBuffer) || (NULL == fileName)) {
+		UT_DBGOUT(1, ("<UT> Out of memory in setOutput\n"));
+		rc = OMR_ERROR_OUT_OF_NATIVE_MEMORY;
+		goto end;
+	}
+
+	for (i = 0; i < numberOfArgs; i++) {
+		int argSize = 0;
+		const char *startOfThisArg = getPositionalParm(i + 1, value, &argSize);
+
+		strncpy(localBuffer, startOfThisArg, argSize);
+		localBuffer[argSize] = '\0';
+
+		if (0 == i) {
+			if (0 == argSize) {
+				reportCommandLineError(atRuntime, "-Xtrace:output expects a file name.");
+				rc = OMR_ERROR_ILLEGAL_ARGUMENT;
+				goto end;
+			}
+			strcpy(fileName, localBuffer);
+		} else if (0 == argSize) {
+			/* keep the default */
+		} else if (1 == i) {
+			/* nnn, nnnk or nnnm */
+			const char *suffix = localBuffer;
+			BOOLEAN validSize = TRUE;
+
+			while (isdigit(*suffix)) {
+				suffix++;
+			}
+			fileSize = (uint64_t)atoi(localBuffer);
+			if ((suffix == localBuffer) || ((suffix - localBuffer) < (argSize - 1))) {
+				validSize = FALSE;
+			} else if ('K' == j9_cmdla_toupper(*suffix)) {
+				fileSize *= 1024;
+			} else if ('M' == j9_cmdla_toupper(*suffix)) {
+				fileSize *= 1024 * 1024;
+			} else if ('\0' != *suffix) {
+				validSize = FALSE;
+			}
+			if (!validSize) {
+				reportCommandLineError(atRuntime, "Invalid file size for -Xtrace:output - \"%s\"", localBuffer);
+				rc = OMR_ERROR_ILLEGAL_ARGUMENT;
+				goto end;
+			}
+		} else {
+			generations = decimalString2Int(localBuffer, FALSE, &rc, atRuntime);
+			if (OMR_ERROR_NONE != rc) {
+				goto end;
+			}
+			if ((generations < 1) || (generations > UT_MAX_OUTPUT_GENERATIONS)) {
+				reportCommandLineError(atRuntime, "Number of generations for -Xtrace:output must be between 1 and %d", UT_MAX_OUTPUT_GENERATIONS);
+				rc = OMR_ERROR_ILLEGAL_ARGUMENT;
+				goto end;
+			}
+		}
+	}
+
+	rc = startMappedTraceOutput(fileName, fileSize, (uint32_t)generations);
+
+end:
+	if (NULL != localBuffer) {
+		omrmem_free_memory(localBuffer);
+	}
+	if (NULL != fileName) {
+		omrmem_free_memory(fileName);
+	}
+	return rc;
 }
 #endif /* OMR_ALLOW_OUTPUT_OPTION */
 
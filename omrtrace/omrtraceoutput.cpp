@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Copyright (c) 2015, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/*
+ * Memory-mapped binary trace output, enabled with output=<filename>[,<size>[,<generations>]].
+ *
+ * Published trace records are copied straight into a shared mapping of a pre-sized file.
+ * Each file starts with the trace file header (the trace metadata) followed by whole
+ * records, i.e. the same layout that omr_trc_getTraceFileIterator() reads. When a file
+ * is full, output moves to the next generation, reusing the oldest file once all
+ * generations have been written, so the disk space used is bounded by size * generations.
+ *
+ * The subscriber callback is serialized by OMR_TRACEGLOBAL(subscribersLock), so the
+ * output state needs no locking of its own.
+ */
+
+#include <string.h>
+
+#include "omrtrace_internal.h"
+
+#define UT_OUTPUT_GENERATION_CHAR '#'
+
+typedef struct UtMappedOutput {
+	char *fileNameTemplate;			/* File name, '#' is replaced by the generation number */
+	char *fileName;					/* Name of the current file */
+	uint64_t fileSize;				/* Size of each file */
+	uint32_t generations;			/* Number of files to rotate through */
+	uint32_t generation;			/* Generation of the current file */
+	intptr_t fileHandle;			/* Handle of the current file, or -1 */
+	J9MmapHandle *mapping;			/* Shared mapping of the current file, or NULL */
+	uintptr_t offset;				/* Offset of the next record in the current file */
+	BOOLEAN failed;					/* No more output is written after a failure */
+} UtMappedOutput;
+
+static omr_error_t writeMappedTraceRecord(UtSubscription *subscription);
+static void mappedTraceOutputAlarm(UtSubscription *subscription);
+static omr_error_t openMappedTraceGeneration(OMRPortLibrary *portLibrary, UtMappedOutput *output, uint32_t generation, uintptr_t recordLength);
+static void closeMappedTraceGeneration(OMRPortLibrary *portLibrary, UtMappedOutput *output, BOOLEAN trimFile);
+
+omr_error_t
+startMappedTraceOutput(const char *fileName, uint64_t fileSize, uint32_t generations)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+	UtMappedOutput *output = NULL;
+	UtSubscription *subscription = NULL;
+	const char *description = "Memory-mapped trace output";
+	size_t fileNameLength = strlen(fileName);
+
+	if (NULL != OMR_TRACEGLOBAL(mappedOutput)) {
+		reportCommandLineError(FALSE, "Trace output has already been configured");
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+	if (OMR_ARE_NO_BITS_SET(omrmmap_capabilities(), OMRPORT_MMAP_CAPABILITY_WRITE)) {
+		reportCommandLineError(FALSE, "Trace output requires writable memory-mapped files, which are not supported on this platform");
+		return OMR_ERROR_NOT_AVAILABLE;
+	}
+	if ((generations > 1) && (NULL == strchr(fileName, UT_OUTPUT_GENERATION_CHAR))) {
+		reportCommandLineError(FALSE, "The trace output file name must contain '%c' when generations are used", UT_OUTPUT_GENERATION_CHAR);
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+
+	output = (UtMappedOutput *)omrmem_allocate_memory(sizeof(UtMappedOutput), OMRMEM_CATEGORY_TRACE);
+	subscription = (UtSubscription *)omrmem_allocate_memory(sizeof(UtSubscription), OMRMEM_CATEGORY_TRACE);
+	if ((NULL == output) || (NULL == subscription)) {
+		goto nomem;
+	}
+	memset(output, 0, sizeof(UtMappedOutput));
+	memset(subscription, 0, sizeof(UtSubscription));
+
+	output->fileNameTemplate = (char *)omrmem_allocate_memory(fileNameLength + 1, OMRMEM_CATEGORY_TRACE);
+	/* A generation number takes at most 10 digits in place of the '#' */
+	output->fileName = (char *)omrmem_allocate_memory(fileNameLength + 10 + 1, OMRMEM_CATEGORY_TRACE);
+	subscription->description = (char *)omrmem_allocate_memory(strlen(description) + 1, OMRMEM_CATEGORY_TRACE);
+	if ((NULL == output->fileNameTemplate) || (NULL == output->fileName) || (NULL == subscription->description)) {
+		goto nomem;
+	}
+	strcpy(output->fileNameTemplate, fileName);
+	strcpy(subscription->description, description);
+	output->fileSize = fileSize;
+	output->generations = generations;
+	output->fileHandle = -1;
+
+	subscription->subscriber = writeMappedTraceRecord;
+	subscription->alarm = mappedTraceOutputAlarm;
+	subscription->userData = output;
+
+	/* Options are processed before any thread attaches to the trace engine */
+	omrthread_monitor_enter(OMR_TRACEGLOBAL(subscribersLock));
+	enlistRecordSubscriber(subscription);
+	OMR_TRACEGLOBAL(traceInCore) = FALSE;
+	OMR_TRACEGLOBAL(mappedOutput) = output;
+	omrthread_monitor_exit(OMR_TRACEGLOBAL(subscribersLock));
+
+	UT_DBGOUT(1, ("<UT> Trace output to %s, %llu bytes, %u generation(s)\n", fileName, (unsigned long long)fileSize, generations));
+	return OMR_ERROR_NONE;
+
+nomem:
+	UT_DBGOUT(1, ("<UT> Out of memory configuring trace output\n"));
+	if (NULL != output) {
+		omrmem_free_memory(output->fileNameTemplate);
+		omrmem_free_memory(output->fileName);
+		omrmem_free_memory(output);
+	}
+	if (NULL != subscription) {
+		omrmem_free_memory(subscription->description);
+		omrmem_free_memory(subscription);
+	}
+	return OMR_ERROR_OUT_OF_NATIVE_MEMORY;
+}
+
+void
+stopMappedTraceOutput(OMR_TraceGlobal *global)
+{
+	UtMappedOutput *output = global->mappedOutput;
+
+	if (NULL != output) {
+		OMRPORT_ACCESS_FROM_OMRPORT(global->portLibrary);
+
+		closeMappedTraceGeneration(OMRPORTLIB, output, TRUE);
+		omrmem_free_memory(output->fileNameTemplate);
+		omrmem_free_memory(output->fileName);
+		omrmem_free_memory(output);
+		global->mappedOutput = NULL;
+	}
+}
+
+void
+detachMappedTraceOutputAfterFork(void)
+{
+	UtMappedOutput *output = OMR_TRACEGLOBAL(mappedOutput);
+
+	if (NULL != output) {
+		/* The file belongs to the parent process; release the child's mapping without touching it */
+		output->failed = TRUE;
+		closeMappedTraceGeneration(OMR_TRACEGLOBAL(portLibrary), output, FALSE);
+	}
+}
+
+/**
+ * Subscriber callback. Copy a published record into the current file,
+ * moving to the next generation when the file is full.
+ */
+static omr_error_t
+writeMappedTraceRecord(UtSubscription *subscription)
+{
+	UtMappedOutput *output = (UtMappedOutput *)subscription->userData;
+	uintptr_t recordLength = (uintptr_t)subscription->dataLength;
+
+	if (output->failed) {
+		return OMR_ERROR_INTERNAL;
+	}
+
+	if ((NULL == output->mapping) || ((output->offset + recordLength) > output->mapping->size)) {
+		uint32_t generation = 0;
+		if (NULL != output->mapping) {
+			generation = (output->generation + 1) % output->generations;
+		}
+		if (OMR_ERROR_NONE != openMappedTraceGeneration(OMR_TRACEGLOBAL(portLibrary), output, generation, recordLength)) {
+			output->failed = TRUE;
+			return OMR_ERROR_INTERNAL;
+		}
+	}
+
+	memcpy((uint8_t *)output->mapping->pointer + output->offset, subscription->data, recordLength);
+	output->offset += recordLength;
+	return OMR_ERROR_NONE;
+}
+
+/**
+ * Called when the subscription is removed after a failure. Release the current file.
+ */
+static void
+mappedTraceOutputAlarm(UtSubscription *subscription)
+{
+	UtMappedOutput *output = (UtMappedOutput *)subscription->userData;
+
+	UT_DBGOUT(1, ("<UT> Trace output to %s stopped\n", output->fileName));
+	output->failed = TRUE;
+	closeMappedTraceGeneration(OMR_TRACEGLOBAL(portLibrary), output, TRUE);
+}
+
+/**
+ * Create (or truncate) the file for a generation, pre-size it, map it and
+ * write the trace file header at its start.
+ */
+static omr_error_t
+openMappedTraceGeneration(OMRPortLibrary *portLibrary, UtMappedOutput *output, uint32_t generation, uintptr_t recordLength)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	UtTraceFileHdr *header = NULL;
+	uintptr_t headerLength = 0;
+	const char *generationChar = strchr(output->fileNameTemplate, UT_OUTPUT_GENERATION_CHAR);
+
+	closeMappedTraceGeneration(OMRPORTLIB, output, TRUE);
+
+	if ((OMR_ERROR_NONE != initTraceHeader()) || (NULL == OMR_TRACEGLOBAL(traceHeader))) {
+		return OMR_ERROR_INTERNAL;
+	}
+	header = OMR_TRACEGLOBAL(traceHeader);
+	headerLength = (uintptr_t)header->header.length;
+	if ((headerLength + recordLength) > output->fileSize) {
+		UT_DBGOUT(1, ("<UT> Trace output file size %llu is too small for one trace buffer\n", (unsigned long long)output->fileSize));
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+
+	if (NULL == generationChar) {
+		strcpy(output->fileName, output->fileNameTemplate);
+	} else {
+		omrstr_printf(output->fileName, (uint32_t)(strlen(output->fileNameTemplate) + 10 + 1), "%.*s%u%s",
+				(int)(generationChar - output->fileNameTemplate), output->fileNameTemplate, generation, generationChar + 1);
+	}
+
+	output->fileHandle = omrfile_open(output->fileName, EsOpenCreate | EsOpenRead | EsOpenWrite | EsOpenTruncate, 0666);
+	if (-1 == output->fileHandle) {
+		UT_DBGOUT(1, ("<UT> Unable to open trace output file %s\n", output->fileName));
+		return OMR_ERROR_FILE_UNAVAILABLE;
+	}
+	if (0 != omrfile_set_length(output->fileHandle, (int64_t)output->fileSize)) {
+		UT_DBGOUT(1, ("<UT> Unable to size trace output file %s\n", output->fileName));
+		omrfile_close(output->fileHandle);
+		output->fileHandle = -1;
+		return OMR_ERROR_FILE_UNAVAILABLE;
+	}
+	output->mapping = omrmmap_map_file(output->fileHandle, 0, (uintptr_t)output->fileSize, output->fileName,
+			OMRPORT_MMAP_FLAG_WRITE | OMRPORT_MMAP_FLAG_SHARED, OMRMEM_CATEGORY_TRACE);
+	if (NULL == output->mapping) {
+		UT_DBGOUT(1, ("<UT> Unable to map trace output file %s\n", output->fileName));
+		omrfile_close(output->fileHandle);
+		output->fileHandle = -1;
+		return OMR_ERROR_FILE_UNAVAILABLE;
+	}
+
+	memcpy(output->mapping->pointer, header, headerLength);
+	output->offset = headerLength;
+	output->generation = generation;
+	return OMR_ERROR_NONE;
+}
+
+/**
+ * Unmap and close the current file. If trimFile is TRUE, the unused tail is cut
+ * off so the file only holds the header and whole records.
+ */
+static void
+closeMappedTraceGeneration(OMRPortLibrary *portLibrary, UtMappedOutput *output, BOOLEAN trimFile)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	if (NULL != output->mapping) {
+		omrmmap_unmap_file(output->mapping);
+		output->mapping = NULL;
+	}
+	if (-1 != output->fileHandle) {
+		if (trimFile) {
+			omrfile_set_length(output->fileHandle, (int64_t)output->offset);
+		}
+		omrfile_close(output->fileHandle);
+		output->fileHandle = -1;
+	}
+}
@@ -25,6 +25,18 @@
 #include "omrtrace_internal.h"
 #include "thread_api.h"
 
+/* Accessors for the packed head of OMR_TRACEGLOBAL(freeBuffers) */
+#define FREE_BUFFERS_INDEX(head) ((uint32_t)(head))
+#define FREE_BUFFERS_TAG(head) ((uint32_t)((head) >> 32))
+#define FREE_BUFFERS_HEAD(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+
+static OMR_TraceBuffer *
+getTraceBufferFromIndex(uint32_t index)
+{
+	uint32_t slot = index - 1;
+	return OMR_TRACEGLOBAL(bufferTable)[slot >> UT_BUFFER_TABLE_SEGMENT_SHIFT][slot & (UT_BUFFER_TABLE_SEGMENT_SIZE - 1)];
+}
+
 omr_error_t
 publishTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf)
 {
@@ -41,6 +53,8 @@ publishTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf)
 		 * the thread that owns the trace buffer.
 		 */
 		buf->thr->trcBuf = NULL;
+		/* The buffer may be released by another thread, after its owner has detached */
+		buf->thr = NULL;
 	}
 
 	/* only publish a buffer if data has been written to it */
@@ -49,37 +63,89 @@ publishTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf)
 		/* CAS is not needed because flags is modified only by the thread that owns the buffer */
 		buf->flags = newFlags;
 
-		omrthread_monitor_t const subscribersLock = OMR_TRACEGLOBAL(subscribersLock);
-		omrthread_monitor_enter(subscribersLock);
-		for (UtSubscription *subscription = (UtSubscription *)OMR_TRACEGLOBAL(subscribers); subscription; subscription = subscription->next) {
-			subscription->dataLength = OMR_TRACEGLOBAL(bufferSize);
-			subscription->data = &(buf->record);
+		volatile uintptr_t *publishQueue = &OMR_TRACEGLOBAL(publishQueue);
+		uintptr_t oldHead = 0;
+		do {
+			oldHead = *publishQueue;
+			buf->next = (OMR_TraceBuffer *)oldHead;
+		} while (oldHead != VM_AtomicSupport::lockCompareExchange(publishQueue, oldHead, (uintptr_t)buf));
+
+		deliverPublishedTraceBuffers(currentThr, FALSE);
+	} else {
+		releaseTraceBuffer(currentThr, buf);
+	}
+
+	decrementRecursionCounter(currentThr);
+	return rc;
+}
+
+void
+deliverPublishedTraceBuffers(OMR_TraceThread *currentThr, BOOLEAN wait)
+{
+	omrthread_monitor_t const subscribersLock = OMR_TRACEGLOBAL(subscribersLock);
+	volatile uintptr_t *publishQueue = &OMR_TRACEGLOBAL(publishQueue);
+
+	incrementRecursionCounter(currentThr);
+
+	do {
+		if (wait) {
+			omrthread_monitor_enter(subscribersLock);
+			wait = FALSE;
+		} else if (0 != omrthread_monitor_try_enter(subscribersLock)) {
+			/* The owner of the lock will deliver the queued buffers */
+			break;
+		}
+
+		while (0 != *publishQueue) {
+			/* Take the whole queue and reverse it, so buffers are delivered in publication order */
+			OMR_TraceBuffer *lifo = (OMR_TraceBuffer *)VM_AtomicSupport::set(publishQueue, 0);
+			OMR_TraceBuffer *fifo = NULL;
+			while (NULL != lifo) {
+				OMR_TraceBuffer *next = lifo->next;
+				lifo->next = fifo;
+				fifo = lifo;
+				lifo = next;
+			}
 
-			omr_error_t subscriberRc = subscription->subscriber(subscription);
-			if (OMR_ERROR_NONE != subscriberRc) {
-				/* If the subscriber callback fails, call the alarm callback and
-				 * remove the subscription.
-				 */
-				UtSubscription *subscriptionToDestroy = subscription;
+			while (NULL != fifo) {
+				OMR_TraceBuffer *buf = fifo;
+				fifo = buf->next;
 
-				/* adjust the loop iterator */
-				subscription = subscriptionToDestroy->prev;
+				for (UtSubscription *subscription = (UtSubscription *)OMR_TRACEGLOBAL(subscribers); subscription; subscription = subscription->next) {
+					subscription->dataLength = OMR_TRACEGLOBAL(bufferSize);
+					subscription->data = &(buf->record);
 
-				getTraceLock(currentThr);
-				destroyRecordSubscriber(currentThr, subscriptionToDestroy, 1);
-				freeTraceLock(currentThr);
+					omr_error_t subscriberRc = subscription->subscriber(subscription);
+					if (OMR_ERROR_NONE != subscriberRc) {
+						/* If the subscriber callback fails, call the alarm callback and
+						 * remove the subscription.
+						 */
+						UtSubscription *subscriptionToDestroy = subscription;
 
-				if (NULL == subscription) {
-					break;
+						/* adjust the loop iterator */
+						subscription = subscriptionToDestroy->prev;
+
+						getTraceLock(currentThr);
+						destroyRecordSubscriber(currentThr, subscriptionToDestroy, 1);
+						freeTraceLock(currentThr);
+
+						if (NULL == subscription) {
+							break;
+						}
+					}
 				}
+				releaseTraceBuffer(currentThr, buf);
 			}
 		}
 		omrthread_monitor_exit(subscribersLock);
-	}
-	releaseTraceBuffer(currentThr, buf);
+
+		/* A publisher may have queued a buffer and failed to get the lock just before it was released.
+		 * Order the release of the lock before the recheck of the queue.
+		 */
+		VM_AtomicSupport::readWriteBarrier();
+	} while (0 != *publishQueue);
 
 	decrementRecursionCounter(currentThr);
-	return rc;
 }
 
 omr_error_t
@@ -95,12 +161,19 @@ releaseTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf)
 		 * the thread that owns the trace buffer.
 		 */
 		buf->thr->trcBuf = NULL;
+		buf->thr = NULL;
 	}
 
-	omrthread_monitor_enter(OMR_TRACEGLOBAL(freeQueueLock));
-	buf->next = OMR_TRACEGLOBAL(freeQueue);
-	OMR_TRACEGLOBAL(freeQueue) = buf;
-	omrthread_monitor_exit(OMR_TRACEGLOBAL(freeQueueLock));
+	/* Push the buffer on the free stack. The tag changes on every update to defeat ABA. */
+	volatile uint64_t *freeBuffers = &OMR_TRACEGLOBAL(freeBuffers);
+	uint64_t oldHead = 0;
+	uint64_t newHead = 0;
+	do {
+		oldHead = VM_AtomicSupport::getU64(freeBuffers);
+		uint32_t topIndex = FREE_BUFFERS_INDEX(oldHead);
+		buf->next = (0 == topIndex) ? NULL : getTraceBufferFromIndex(topIndex);
+		newHead = FREE_BUFFERS_HEAD(FREE_BUFFERS_TAG(oldHead) + 1, buf->index);
+	} while (oldHead != VM_AtomicSupport::lockCompareExchangeU64(freeBuffers, oldHead, newHead));
 
 	decrementRecursionCounter(currentThr);
 	return OMR_ERROR_NONE;
@@ -109,15 +182,31 @@ releaseTraceBuffer(OMR_TraceThread *currentThr, OMR_TraceBuffer *buf)
 OMR_TraceBuffer *
 recycleTraceBuffer(OMR_TraceThread *currentThr)
 {
+	OMR_TraceBuffer *recycledBuf = NULL;
+	volatile uint64_t *freeBuffers = &OMR_TRACEGLOBAL(freeBuffers);
+	uint64_t oldHead = 0;
+	uint64_t newHead = 0;
+
 	incrementRecursionCounter(currentThr);
 
-	omrthread_monitor_enter(OMR_TRACEGLOBAL(freeQueueLock));
-	OMR_TraceBuffer *recycledBuf = OMR_TRACEGLOBAL(freeQueue);
-	if (recycledBuf) {
-		OMR_TRACEGLOBAL(freeQueue) = recycledBuf->next;
+	do {
+		oldHead = VM_AtomicSupport::getU64(freeBuffers);
+		uint32_t topIndex = FREE_BUFFERS_INDEX(oldHead);
+		if (0 == topIndex) {
+			recycledBuf = NULL;
+			break;
+		}
+		/* Buffers are never freed while trace is running, so reading next from a buffer
+		 * that another thread has just popped is safe; the tag makes the CAS fail.
+		 */
+		recycledBuf = getTraceBufferFromIndex(topIndex);
+		OMR_TraceBuffer *next = recycledBuf->next;
+		newHead = FREE_BUFFERS_HEAD(FREE_BUFFERS_TAG(oldHead) + 1, (NULL == next) ? 0 : next->index);
+	} while (oldHead != VM_AtomicSupport::lockCompareExchangeU64(freeBuffers, oldHead, newHead));
+
+	if (NULL != recycledBuf) {
 		recycledBuf->next = NULL;
 	}
-	omrthread_monitor_exit(OMR_TRACEGLOBAL(freeQueueLock));
 
 	decrementRecursionCounter(currentThr);
 	return recycledBuf;
@@ -817,3 +817,97 @@ omrfile_convert_omrfile_fd_to_native_fd(struct OMRPortLibrary *portLibrary, intp
 {
 	return omrfileFD;
 }
+
+/**
+ * Read bytes from a given offset of a file into a user provided buffer. The file
+ * offset of fd is not used; on platforms other than Windows it is not changed either,
+ * so several threads may read the same file without coordinating seeks.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd The file descriptor.
+ * @param[in,out] buf Buffer to read into.
+ * @param[in] nbytes Size of buffer.
+ * @param[in] offset Offset in the file to read from.
+ *
+ * @return The number of bytes read, 0 at end of file, or a negative portable error code on failure.
+ */
+intptr_t
+omrfile_pread(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes, int64_t offset)
+{
+	return -1;
+}
+
+/**
+ * Write bytes from a user provided buffer at a given offset of a file. The file offset
+ * of fd is not used; on platforms other than Windows it is not changed either.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd The file descriptor.
+ * @param[in] buf Buffer to be written.
+ * @param[in] nbytes Size of buffer.
+ * @param[in] offset Offset in the file to write to.
+ *
+ * @return The number of bytes written, which may be less than nbytes, or a negative portable error code on failure.
+ */
+intptr_t
+omrfile_pwrite(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf, intptr_t nbytes, int64_t offset)
+{
+	return -1;
+}
+
+/**
+ * Read from a given offset of a file into several buffers, filling each in turn.
+ * Where the platform has a vectored read this is a single system call.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd The file descriptor.
+ * @param[in] vectors The buffers to read into.
+ * @param[in] vectorCount Number of entries in vectors.
+ * @param[in] offset Offset in the file to read from.
+ *
+ * @return The total number of bytes read, 0 at end of file, or a negative portable error code on failure.
+ */
+intptr_t
+omrfile_preadv(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	return -1;
+}
+
+/**
+ * Write several buffers, in order, at a given offset of a file.
+ * Where the platform has a vectored write this is a single system call.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fd The file descriptor.
+ * @param[in] vectors The buffers to be written.
+ * @param[in] vectorCount Number of entries in vectors.
+ * @param[in] offset Offset in the file to write to.
+ *
+ * @return The total number of bytes written, or a negative portable error code on failure.
+ */
+intptr_t
+omrfile_pwritev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	return -1;
+}
+
+/**
+ * Copy a range of bytes from one file to another. Where the platform supports it the
+ * copy is done in the kernel, without moving the data through user space. The file
+ * offsets of fdIn and fdOut are not used.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] fdIn The file descriptor to copy from.
+ * @param[in] offsetIn Offset in fdIn of the first byte to copy.
+ * @param[in] fdOut The file descriptor to copy to.
+ * @param[in] offsetOut Offset in fdOut to copy to.
+ * @param[in] length Number of bytes to copy.
+ *
+ * @return The number of bytes copied, which is less than length only if the end of fdIn
+ * was reached, or a negative portable error code on failure.
+ */
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t fdIn, int64_t offsetIn, intptr_t fdOut, int64_t offsetOut, int64_t length)
+{
+	return -1;
+}
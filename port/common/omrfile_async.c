@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Asynchronous file I/O
+ *
+ * Platforms without an asynchronous file implementation get these stubs, which
+ * fail context creation so callers fall back to the synchronous omrfile functions.
+ */
+
+#include "omrport.h"
+#include "omrportpriv.h"
+
+/**
+ * Create a queue for asynchronous file operations.
+ *
+ * The queue accepts up to queueDepth operations that have been submitted but
+ * whose completions have not yet been returned by @ref omrfile_async_wait.
+ * A context must not be used by more than one thread at a time.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queueDepth Maximum number of operations in flight
+ * @param[in] flags OMRPORT_FILE_ASYNC_FORCE_THREADS to bypass kernel asynchronous I/O
+ * @param[out] context The new context
+ *
+ * @return 0 on success, negative portable error code on failure.
+ */
+int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t queueDepth, uint32_t flags, OMRFileAsyncContext **context)
+{
+	*context = NULL;
+	return OMRPORT_ERROR_FILE_OPFAILED;
+}
+
+/**
+ * Queue asynchronous file operations. Operations are started in order but may
+ * complete in any order; the userData of each request identifies its completion.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ * @param[in] requests The operations to start
+ * @param[in] count Number of entries in requests
+ *
+ * @return the number of leading requests accepted, which is less than count when
+ * the queue is full, or a negative portable error code if none could be accepted.
+ */
+intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	return OMRPORT_ERROR_FILE_OPFAILED;
+}
+
+/**
+ * Collect completed asynchronous file operations, blocking until at least
+ * minCompletions are available. minCompletions is limited to the number of
+ * operations in flight.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ * @param[out] completions Storage for the completions
+ * @param[in] maxCompletions Number of entries in completions
+ * @param[in] minCompletions Number of completions to wait for, 0 to poll
+ *
+ * @return the number of completions stored, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_wait(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	return OMRPORT_ERROR_FILE_OPFAILED;
+}
+
+/**
+ * Report which mechanism services a context.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ *
+ * @return OMRPORT_FILE_ASYNC_BACKEND_IO_URING or OMRPORT_FILE_ASYNC_BACKEND_THREADS,
+ * or 0 if context is NULL.
+ */
+int32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	return 0;
+}
+
+/**
+ * Destroy a context, first waiting for any operations still in flight.
+ * Their completions are discarded.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create, may be NULL
+ */
+void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+}
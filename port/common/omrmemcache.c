@@ -0,0 +1,492 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Size-class caching backend for omrmem_allocate_memory
+ */
+
+
+/*
+ * This file contains the optional size-class cache used by omrmemtag.c for small
+ * blocks. It is enabled at port library startup by setting the environment
+ * variable OMR_MEM_SIZE_CLASS_CACHE to TRUE or 1, and stays enabled or disabled
+ * for the lifetime of the port library, so whether a block came from the cache
+ * is decided from its tagged size alone.
+ *
+ * Blocks are carved from chunks owned by per-category arenas. Each attached
+ * thread keeps a small LIFO cache of free blocks per size class, which it refills
+ * from, and overflows into, the arenas. The cache sits below omrmemtag.c, so
+ * every block is still wrapped in memory tags and counted against the category
+ * it was allocated for. A free block may be reused for any category.
+ */
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrthread.h"
+
+/* Size of the chunks that arenas carve blocks from */
+#define OMRMEM_CACHE_CHUNK_SIZE ((uintptr_t)64 * 1024)
+/* Maximum number of free blocks of one size class a thread holds */
+#define OMRMEM_CACHE_THREAD_LIMIT 32
+/* Number of blocks moved between a thread and an arena at once */
+#define OMRMEM_CACHE_BATCH_SIZE (OMRMEM_CACHE_THREAD_LIMIT / 2)
+/* Number of arena slots. Must be a power of 2. */
+#define OMRMEM_CACHE_ARENA_SLOTS 64
+#define OMRMEM_CACHE_SIZE_CLASSES (sizeof(sizeClassSizes) / sizeof(sizeClassSizes[0]))
+
+/* Free blocks are linked through the word after the (freed) header tag */
+#define FREE_BLOCK_NEXT(block) (((void **)((uint8_t *)(block) + sizeof(J9MemTag)))[0])
+#define FREE_BLOCK_ARENA(block) (((OMRMemCacheArena **)((uint8_t *)(block) + sizeof(J9MemTag)))[1])
+
+/* Block sizes, including memory tags. Sizes are multiples of 16 so blocks stay 16 byte aligned. */
+static const uint32_t sizeClassSizes[] = {
+	48, 64, 80, 96, 112, 128, 160, 192, 224, 256,
+	320, 384, 448, 512, 640, 768, 896, 1024,
+	1280, 1536, 1792, OMRMEM_CACHE_MAX_BLOCK_SIZE
+};
+
+typedef struct OMRMemCacheChunk {
+	struct OMRMemCacheChunk *next;
+	uintptr_t padding;
+} OMRMemCacheChunk;
+
+typedef struct OMRMemCacheArena {
+	uint32_t categoryCode;
+	MUTEX mutex;
+	void *freeBlocks[OMRMEM_CACHE_SIZE_CLASSES];
+	uint8_t *chunkCursor;
+	uint8_t *chunkEnd;
+	OMRMemCacheChunk *chunks;
+} OMRMemCacheArena;
+
+typedef struct OMRMemCacheThread {
+	struct OMRPortLibrary *portLibrary;
+	struct OMRMemCacheThread *next;
+	struct OMRMemCacheThread *previous;
+	uint32_t freeCounts[OMRMEM_CACHE_SIZE_CLASSES];
+	void *freeBlocks[OMRMEM_CACHE_SIZE_CLASSES];
+} OMRMemCacheThread;
+
+struct OMRMemCache {
+	omrthread_tls_key_t tlsKey;
+	MUTEX threadsMutex;
+	OMRMemCacheThread *threads;
+	OMRMemCacheArena *arenas[OMRMEM_CACHE_ARENA_SLOTS];
+	OMRMemCacheArena sharedArena;
+	uint8_t sizeClassIndex[(OMRMEM_CACHE_MAX_BLOCK_SIZE / 16) + 1];
+};
+
+#ifndef _J9VMATOMICFUNCTIONS_
+#define _J9VMATOMICFUNCTIONS_
+extern uintptr_t compareAndSwapUDATA(uintptr_t *location, uintptr_t oldValue, uintptr_t newValue);
+extern void issueReadWriteBarrier(void);
+#endif /* _J9VMATOMICFUNCTIONS_ */
+
+static OMRMemCacheArena *get_arena(struct OMRPortLibrary *portLibrary, OMRMemCache *cache, uint32_t categoryCode);
+static OMRMemCacheThread *get_thread_cache(struct OMRPortLibrary *portLibrary, OMRMemCache *cache);
+static void *take_from_arena(struct OMRPortLibrary *portLibrary, OMRMemCacheArena *arena, uintptr_t sizeClass, uintptr_t count, void **rest);
+static void return_to_arenas(OMRMemCacheThread *thread, uintptr_t sizeClass, uintptr_t count);
+static void J9THREAD_PROC thread_cache_finalizer(void *entry);
+static void free_arena_chunks(struct OMRPortLibrary *portLibrary, OMRMemCacheArena *arena);
+
+/**
+ * Returns the arena for a category, creating it if needed. Categories that don't fit
+ * in the arena table, or whose arena can't be allocated, use the shared arena.
+ */
+static OMRMemCacheArena *
+get_arena(struct OMRPortLibrary *portLibrary, OMRMemCache *cache, uint32_t categoryCode)
+{
+	uintptr_t slot = ((uintptr_t)categoryCode * 0x9E3779B1) & (OMRMEM_CACHE_ARENA_SLOTS - 1);
+	OMRMemCacheArena *arena = NULL;
+	uintptr_t probes = 0;
+
+	for (probes = 0; probes < OMRMEM_CACHE_ARENA_SLOTS; probes++) {
+		arena = cache->arenas[slot];
+		if (NULL == arena) {
+			OMRMemCacheArena *newArena = omrmem_allocate_memory_basic(portLibrary, sizeof(OMRMemCacheArena));
+			if (NULL == newArena) {
+				break;
+			}
+			memset(newArena, 0, sizeof(OMRMemCacheArena));
+			newArena->categoryCode = categoryCode;
+			if (!MUTEX_INIT(newArena->mutex)) {
+				omrmem_free_memory_basic(portLibrary, newArena);
+				break;
+			}
+			issueReadWriteBarrier();
+			if (0 == compareAndSwapUDATA((uintptr_t *)&cache->arenas[slot], 0, (uintptr_t)newArena)) {
+				return newArena;
+			}
+			/* another thread filled the slot first */
+			MUTEX_DESTROY(newArena->mutex);
+			omrmem_free_memory_basic(portLibrary, newArena);
+			arena = cache->arenas[slot];
+		}
+		if (arena->categoryCode == categoryCode) {
+			return arena;
+		}
+		slot = (slot + 1) & (OMRMEM_CACHE_ARENA_SLOTS - 1);
+	}
+	return &cache->sharedArena;
+}
+
+/**
+ * Returns the calling thread's cache, creating it if needed, or NULL if the
+ * thread isn't attached or the cache couldn't be allocated.
+ */
+static OMRMemCacheThread *
+get_thread_cache(struct OMRPortLibrary *portLibrary, OMRMemCache *cache)
+{
+	omrthread_t self = omrthread_self();
+	OMRMemCacheThread *thread = NULL;
+
+	if (NULL == self) {
+		return NULL;
+	}
+	thread = omrthread_tls_get(self, cache->tlsKey);
+	if (NULL == thread) {
+		/* Use the basic allocator, the tagged one would recurse into the cache */
+		thread = omrmem_allocate_memory_basic(portLibrary, sizeof(OMRMemCacheThread));
+		if (NULL == thread) {
+			return NULL;
+		}
+		memset(thread, 0, sizeof(OMRMemCacheThread));
+		thread->portLibrary = portLibrary;
+		if (0 != omrthread_tls_set(self, cache->tlsKey, thread)) {
+			omrmem_free_memory_basic(portLibrary, thread);
+			return NULL;
+		}
+		MUTEX_ENTER(cache->threadsMutex);
+		thread->next = cache->threads;
+		if (NULL != cache->threads) {
+			cache->threads->previous = thread;
+		}
+		cache->threads = thread;
+		MUTEX_EXIT(cache->threadsMutex);
+	}
+	return thread;
+}
+
+/**
+ * Takes up to count blocks of a size class from an arena. Free blocks are reused
+ * first, then new blocks are carved from the arena's current chunk.
+ *
+ * @param[out] rest the blocks other than the one returned, linked through FREE_BLOCK_NEXT, or NULL
+ *
+ * @return a block, or NULL if no memory could be obtained
+ */
+static void *
+take_from_arena(struct OMRPortLibrary *portLibrary, OMRMemCacheArena *arena, uintptr_t sizeClass, uintptr_t count, void **rest)
+{
+	uintptr_t blockSize = sizeClassSizes[sizeClass];
+	void *blocks = NULL;
+	uintptr_t taken = 0;
+
+	MUTEX_ENTER(arena->mutex);
+	while ((taken < count) && (NULL != arena->freeBlocks[sizeClass])) {
+		void *block = arena->freeBlocks[sizeClass];
+		arena->freeBlocks[sizeClass] = FREE_BLOCK_NEXT(block);
+		FREE_BLOCK_NEXT(block) = blocks;
+		blocks = block;
+		taken += 1;
+	}
+
+	while (taken < count) {
+		void *block = NULL;
+		if ((uintptr_t)(arena->chunkEnd - arena->chunkCursor) < blockSize) {
+			OMRMemCacheChunk *chunk = omrmem_allocate_memory_basic(portLibrary, OMRMEM_CACHE_CHUNK_SIZE);
+			if (NULL == chunk) {
+				break;
+			}
+			chunk->next = arena->chunks;
+			arena->chunks = chunk;
+			arena->chunkCursor = (uint8_t *)(chunk + 1);
+			arena->chunkEnd = (uint8_t *)chunk + OMRMEM_CACHE_CHUNK_SIZE;
+		}
+		block = arena->chunkCursor;
+		arena->chunkCursor += blockSize;
+		FREE_BLOCK_NEXT(block) = blocks;
+		blocks = block;
+		taken += 1;
+	}
+	MUTEX_EXIT(arena->mutex);
+
+	if (NULL != blocks) {
+		*rest = FREE_BLOCK_NEXT(blocks);
+	} else {
+		*rest = NULL;
+	}
+	return blocks;
+}
+
+/**
+ * Moves count blocks of a size class from a thread cache back to the arenas of the
+ * categories that freed them, locking each arena once per run of its blocks.
+ */
+static void
+return_to_arenas(OMRMemCacheThread *thread, uintptr_t sizeClass, uintptr_t count)
+{
+	while ((count > 0) && (NULL != thread->freeBlocks[sizeClass])) {
+		void *block = thread->freeBlocks[sizeClass];
+		OMRMemCacheArena *arena = FREE_BLOCK_ARENA(block);
+
+		MUTEX_ENTER(arena->mutex);
+		while ((count > 0) && (NULL != block) && (FREE_BLOCK_ARENA(block) == arena)) {
+			void *next = FREE_BLOCK_NEXT(block);
+			FREE_BLOCK_NEXT(block) = arena->freeBlocks[sizeClass];
+			arena->freeBlocks[sizeClass] = block;
+			thread->freeCounts[sizeClass] -= 1;
+			count -= 1;
+			block = next;
+		}
+		MUTEX_EXIT(arena->mutex);
+		thread->freeBlocks[sizeClass] = block;
+	}
+}
+
+/**
+ * Frees the chunks of an arena, and so every block carved from it.
+ */
+static void
+free_arena_chunks(struct OMRPortLibrary *portLibrary, OMRMemCacheArena *arena)
+{
+	OMRMemCacheChunk *chunk = arena->chunks;
+
+	while (NULL != chunk) {
+		OMRMemCacheChunk *next = chunk->next;
+		omrmem_free_memory_basic(portLibrary, chunk);
+		chunk = next;
+	}
+	arena->chunks = NULL;
+}
+
+/**
+ * Returns the blocks cached by an exiting thread to the arenas.
+ */
+static void J9THREAD_PROC
+thread_cache_finalizer(void *entry)
+{
+	OMRMemCacheThread *thread = (OMRMemCacheThread *)entry;
+	struct OMRPortLibrary *portLibrary = thread->portLibrary;
+	OMRMemCache *cache = portLibrary->portGlobals->memCache;
+	uintptr_t sizeClass = 0;
+
+	for (sizeClass = 0; sizeClass < OMRMEM_CACHE_SIZE_CLASSES; sizeClass++) {
+		return_to_arenas(thread, sizeClass, thread->freeCounts[sizeClass]);
+	}
+
+	MUTEX_ENTER(cache->threadsMutex);
+	if (NULL != thread->next) {
+		thread->next->previous = thread->previous;
+	}
+	if (cache->threads == thread) {
+		cache->threads = thread->next;
+	} else if (NULL != thread->previous) {
+		thread->previous->next = thread->next;
+	}
+	MUTEX_EXIT(cache->threadsMutex);
+
+	omrmem_free_memory_basic(portLibrary, thread);
+}
+
+/**
+ * Allocate a block from the size-class cache.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] byteAmount Size of the block including memory tags, at most OMRMEM_CACHE_MAX_BLOCK_SIZE
+ * @param[in] categoryCode Memory category the block is being allocated for
+ *
+ * @return pointer to the block on success, NULL on error.
+ */
+void *
+omrmem_cache_allocate(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount, uint32_t categoryCode)
+{
+	OMRMemCache *cache = portLibrary->portGlobals->memCache;
+	uintptr_t sizeClass = cache->sizeClassIndex[(byteAmount + 15) / 16];
+	OMRMemCacheThread *thread = get_thread_cache(portLibrary, cache);
+	OMRMemCacheArena *arena = NULL;
+	void *block = NULL;
+	void *rest = NULL;
+
+	if (NULL != thread) {
+		block = thread->freeBlocks[sizeClass];
+		if (NULL != block) {
+			thread->freeBlocks[sizeClass] = FREE_BLOCK_NEXT(block);
+			thread->freeCounts[sizeClass] -= 1;
+			return block;
+		}
+	}
+
+	/* Map unregistered codes to the unknown category, as tagging will */
+	arena = get_arena(portLibrary, cache, omrmem_get_category(portLibrary, categoryCode)->categoryCode);
+	if (NULL == thread) {
+		return take_from_arena(portLibrary, arena, sizeClass, 1, &rest);
+	}
+
+	block = take_from_arena(portLibrary, arena, sizeClass, OMRMEM_CACHE_BATCH_SIZE, &rest);
+	while (NULL != rest) {
+		void *next = FREE_BLOCK_NEXT(rest);
+		FREE_BLOCK_ARENA(rest) = arena;
+		FREE_BLOCK_NEXT(rest) = thread->freeBlocks[sizeClass];
+		thread->freeBlocks[sizeClass] = rest;
+		thread->freeCounts[sizeClass] += 1;
+		rest = next;
+	}
+	return block;
+}
+
+/**
+ * Free a block allocated by omrmem_cache_allocate.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] memoryPointer The block, starting at its (already checked) header tag
+ * @param[in] byteAmount Size of the block including memory tags
+ * @param[in] category Memory category the block was allocated for
+ */
+void
+omrmem_cache_free(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, OMRMemCategory *category)
+{
+	OMRMemCache *cache = portLibrary->portGlobals->memCache;
+	uintptr_t sizeClass = cache->sizeClassIndex[(byteAmount + 15) / 16];
+	OMRMemCacheThread *thread = get_thread_cache(portLibrary, cache);
+	OMRMemCacheArena *arena = get_arena(portLibrary, cache, category->categoryCode);
+
+	FREE_BLOCK_ARENA(memoryPointer) = arena;
+
+	if (NULL == thread) {
+		MUTEX_ENTER(arena->mutex);
+		FREE_BLOCK_NEXT(memoryPointer) = arena->freeBlocks[sizeClass];
+		arena->freeBlocks[sizeClass] = memoryPointer;
+		MUTEX_EXIT(arena->mutex);
+		return;
+	}
+
+	if (thread->freeCounts[sizeClass] >= OMRMEM_CACHE_THREAD_LIMIT) {
+		return_to_arenas(thread, sizeClass, OMRMEM_CACHE_BATCH_SIZE);
+	}
+	FREE_BLOCK_NEXT(memoryPointer) = thread->freeBlocks[sizeClass];
+	thread->freeBlocks[sizeClass] = memoryPointer;
+	thread->freeCounts[sizeClass] += 1;
+}
+
+/**
+ * Start the size-class cache if it has been requested. The cache is optional,
+ * so failing to start it is not an error.
+ *
+ * @param[in] portLibrary The port library
+ *
+ * @return 0
+ */
+int32_t
+omrmem_cache_startup(struct OMRPortLibrary *portLibrary)
+{
+	OMRMemCache *cache = NULL;
+	char option[8];
+	uintptr_t size = 16;
+	uintptr_t sizeClass = 0;
+
+	portLibrary->portGlobals->memCache = NULL;
+	if (0 != portLibrary->sysinfo_get_env(portLibrary, "OMR_MEM_SIZE_CLASS_CACHE", option, sizeof(option))) {
+		return 0;
+	}
+	if ((0 != strcmp("TRUE", option)) && (0 != strcmp("1", option))) {
+		return 0;
+	}
+
+	cache = omrmem_allocate_memory_basic(portLibrary, sizeof(OMRMemCache));
+	if (NULL == cache) {
+		return 0;
+	}
+	memset(cache, 0, sizeof(OMRMemCache));
+	if (!MUTEX_INIT(cache->threadsMutex)) {
+		omrmem_free_memory_basic(portLibrary, cache);
+		return 0;
+	}
+	if (!MUTEX_INIT(cache->sharedArena.mutex)) {
+		MUTEX_DESTROY(cache->threadsMutex);
+		omrmem_free_memory_basic(portLibrary, cache);
+		return 0;
+	}
+	if (0 != omrthread_tls_alloc_with_finalizer(&cache->tlsKey, thread_cache_finalizer)) {
+		MUTEX_DESTROY(cache->sharedArena.mutex);
+		MUTEX_DESTROY(cache->threadsMutex);
+		omrmem_free_memory_basic(portLibrary, cache);
+		return 0;
+	}
+
+	/* sizeClassIndex[n] is the smallest class that holds n * 16 bytes */
+	cache->sizeClassIndex[0] = 0;
+	for (size = 16; size <= OMRMEM_CACHE_MAX_BLOCK_SIZE; size += 16) {
+		while (sizeClassSizes[sizeClass] < size) {
+			sizeClass += 1;
+		}
+		cache->sizeClassIndex[size / 16] = (uint8_t)sizeClass;
+	}
+
+	portLibrary->portGlobals->memCache = cache;
+	return 0;
+}
+
+/**
+ * Release all memory held by the size-class cache, including blocks that were
+ * never freed.
+ *
+ * @param[in] portLibrary The port library
+ */
+void
+omrmem_cache_shutdown(struct OMRPortLibrary *portLibrary)
+{
+	OMRMemCache *cache = portLibrary->portGlobals->memCache;
+	OMRMemCacheThread *thread = NULL;
+	uintptr_t slot = 0;
+
+	if (NULL == cache) {
+		return;
+	}
+	portLibrary->portGlobals->memCache = NULL;
+
+	/* Clears every thread's cache pointer so no finalizer runs after this */
+	omrthread_tls_free(cache->tlsKey);
+	thread = cache->threads;
+	while (NULL != thread) {
+		OMRMemCacheThread *next = thread->next;
+		omrmem_free_memory_basic(portLibrary, thread);
+		thread = next;
+	}
+
+	for (slot = 0; slot < OMRMEM_CACHE_ARENA_SLOTS; slot++) {
+		OMRMemCacheArena *arena = cache->arenas[slot];
+		if (NULL != arena) {
+			free_arena_chunks(portLibrary, arena);
+			MUTEX_DESTROY(arena->mutex);
+			omrmem_free_memory_basic(portLibrary, arena);
+		}
+	}
+	free_arena_chunks(portLibrary, &cache->sharedArena);
+
+	MUTEX_DESTROY(cache->sharedArena.mutex);
+	MUTEX_DESTROY(cache->threadsMutex);
+	omrmem_free_memory_basic(portLibrary, cache);
+}
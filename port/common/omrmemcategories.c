@@ -32,7 +32,17 @@
  *
  * Memory categories are used to break down native memory usage under
  * areas a language programmer would understand.
+ *
+ * Once a category set is registered, every category gets a stripe of
+ * counters per CPU so that concurrent allocations don't all update the same
+ * cache line. The stripes are only summed when the categories are walked.
  */
+#if defined(LINUX) && !defined(OMRZTPF)
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* !defined(_GNU_SOURCE) */
+#include <sched.h>
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
 #include <stdlib.h>
 #include <string.h>
 
@@ -45,8 +55,16 @@
 #ifndef _J9VMATOMICFUNCTIONS_
 #define _J9VMATOMICFUNCTIONS_
 extern uintptr_t compareAndSwapUDATA(uintptr_t *location, uintptr_t oldValue, uintptr_t newValue);
+extern void issueWriteBarrier(void);
 #endif /* _J9VMATOMICFUNCTIONS_ */
 
+#define CATEGORY_STRIPE_ALIGNMENT 64
+
+static void add_to_counter(uintptr_t *counter, uintptr_t delta);
+static OMRMemCategoryCounters *get_counter_stripe(OMRMemCategory *category);
+static void get_category_totals(OMRMemCategory *category, uintptr_t *liveBytes, uintptr_t *liveAllocations);
+static void remove_category_stripes(struct OMRPortLibrary *portLibrary);
+
 
 /* Templates for categories that are copied into malloc'd memory in omrmem_startup_categories */
 OMRMEM_CATEGORY_NO_CHILDREN("Unknown", OMRMEM_CATEGORY_UNKNOWN);
@@ -59,6 +77,74 @@ OMRMEM_CATEGORY_1_CHILD("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY, OMRMEM_CAT
 OMRMEM_CATEGORY_NO_CHILDREN("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY);
 #endif /* OMR_ENV_DATA64 */
 
+/**
+ * Atomically adds delta to a counter. Decrements are passed as the two's complement.
+ */
+static void
+add_to_counter(uintptr_t *counter, uintptr_t delta)
+{
+	uintptr_t oldValue;
+
+	do {
+		oldValue = *counter;
+	} while (compareAndSwapUDATA(counter, oldValue, oldValue + delta) != oldValue);
+}
+
+/**
+ * Returns the counters to update for the calling thread, or NULL if the category
+ * has no stripes and the shared counters in the category must be used.
+ *
+ * On Linux the stripe is chosen by the current CPU. Elsewhere, threads are spread
+ * over the stripes by the address of their stack.
+ */
+static OMRMemCategoryCounters *
+get_counter_stripe(OMRMemCategory *category)
+{
+	OMRMemCategoryCounters *stripes = category->counterStripes;
+	uintptr_t stripe = 0;
+
+	if (NULL == stripes) {
+		return NULL;
+	}
+#if defined(LINUX) && !defined(OMRZTPF)
+	stripe = (uintptr_t)sched_getcpu();
+#else /* defined(LINUX) && !defined(OMRZTPF) */
+	stripe = (uintptr_t)&stripes;
+	stripe = (stripe >> 16) ^ (stripe >> 20);
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+	stripe &= (OMRMEM_CATEGORY_COUNTER_STRIPES - 1);
+
+	return (OMRMemCategoryCounters *)((uint8_t *)stripes + (stripe * category->counterStripeStride));
+}
+
+/**
+ * Sums the shared counters and all stripes of a category.
+ *
+ * The result is not a snapshot: allocations made on other threads while the stripes
+ * are read may or may not be included, and an allocation and its free can be counted
+ * on different stripes, so individual stripes may wrap. The total is exact once the
+ * category is quiescent.
+ */
+static void
+get_category_totals(OMRMemCategory *category, uintptr_t *liveBytes, uintptr_t *liveAllocations)
+{
+	OMRMemCategoryCounters *stripes = category->counterStripes;
+	uintptr_t bytes = category->liveBytes;
+	uintptr_t allocations = category->liveAllocations;
+
+	if (NULL != stripes) {
+		uint32_t i;
+		for (i = 0; i < OMRMEM_CATEGORY_COUNTER_STRIPES; i++) {
+			OMRMemCategoryCounters *counters = (OMRMemCategoryCounters *)((uint8_t *)stripes + (i * category->counterStripeStride));
+			bytes += counters->liveBytes;
+			allocations += counters->liveAllocations;
+		}
+	}
+
+	*liveBytes = bytes;
+	*liveAllocations = allocations;
+}
+
 /**
  * Increments the counters for a memory category.
  *
@@ -67,16 +153,18 @@ OMRMEM_CATEGORY_NO_CHILDREN("Port Library", OMRMEM_CATEGORY_PORT_LIBRARY);
 void
 omrmem_categories_increment_counters(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryCounters *counters = NULL;
 
 	Trc_Assert_PTR_mem_categories_increment_counters_NULL_category(NULL != category);
 
-	/* Increment block count */
-	do {
-		oldValue = category->liveAllocations;
-	} while (compareAndSwapUDATA(&category->liveAllocations, oldValue, oldValue + 1) != oldValue);
-
-	omrmem_categories_increment_bytes(category, size);
+	counters = get_counter_stripe(category);
+	if (NULL != counters) {
+		add_to_counter(&counters->liveAllocations, 1);
+		add_to_counter(&counters->liveBytes, size);
+	} else {
+		add_to_counter(&category->liveAllocations, 1);
+		add_to_counter(&category->liveBytes, size);
+	}
 }
 
 /**
@@ -87,14 +175,12 @@ omrmem_categories_increment_counters(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_increment_bytes(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryCounters *counters = NULL;
 
 	Trc_Assert_PTR_mem_categories_increment_bytes_NULL_category(NULL != category);
 
-	/* Increment bytes */
-	do {
-		oldValue = category->liveBytes;
-	} while (compareAndSwapUDATA(&category->liveBytes, oldValue, oldValue + size) != oldValue);
+	counters = get_counter_stripe(category);
+	add_to_counter((NULL != counters) ? &counters->liveBytes : &category->liveBytes, size);
 }
 
 /**
@@ -105,16 +191,18 @@ omrmem_categories_increment_bytes(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_decrement_counters(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryCounters *counters = NULL;
 
 	Trc_Assert_PTR_mem_categories_decrement_counters_NULL_category(NULL != category);
 
-	/* Decrement block count */
-	do {
-		oldValue = category->liveAllocations;
-	} while (compareAndSwapUDATA(&category->liveAllocations, oldValue, oldValue - 1) != oldValue);
-
-	omrmem_categories_decrement_bytes(category, size);
+	counters = get_counter_stripe(category);
+	if (NULL != counters) {
+		add_to_counter(&counters->liveAllocations, (uintptr_t)-1);
+		add_to_counter(&counters->liveBytes, (uintptr_t)0 - size);
+	} else {
+		add_to_counter(&category->liveAllocations, (uintptr_t)-1);
+		add_to_counter(&category->liveBytes, (uintptr_t)0 - size);
+	}
 }
 
 /**
@@ -125,14 +213,127 @@ omrmem_categories_decrement_counters(OMRMemCategory *category, uintptr_t size)
 void
 omrmem_categories_decrement_bytes(OMRMemCategory *category, uintptr_t size)
 {
-	uintptr_t oldValue;
+	OMRMemCategoryCounters *counters = NULL;
 
 	Trc_Assert_PTR_mem_categories_decrement_bytes_NULL_category(NULL != category);
 
-	/* Decrement size */
-	do {
-		oldValue = category->liveBytes;
-	} while (compareAndSwapUDATA(&category->liveBytes, oldValue, oldValue - size) != oldValue);
+	counters = get_counter_stripe(category);
+	add_to_counter((NULL != counters) ? &counters->liveBytes : &category->liveBytes, (uintptr_t)0 - size);
+}
+
+/**
+ * Allocates per-CPU counter stripes for every registered category that doesn't
+ * have them yet. Called by port control once the category set is registered.
+ *
+ * The stripes are laid out stripe-major, with each stripe padded to a cache line,
+ * so the counters one CPU updates for all categories are adjacent and never share
+ * a line with another CPU's.
+ *
+ * @param[in] portLibrary The port library
+ *
+ * @return 0 on success, or if the stripes couldn't be allocated, in which case
+ * the shared counters continue to be used.
+ */
+int32_t
+omrmem_install_category_stripes(struct OMRPortLibrary *portLibrary)
+{
+	J9PortControlData *portControl = &portLibrary->portGlobals->control;
+	OMRMemCategorySet *sets[2];
+	uintptr_t categoryCount = 0;
+	uintptr_t stride = 0;
+	uintptr_t next = 0;
+	uint8_t *stripes = NULL;
+	uint32_t i = 0;
+	uint32_t j = 0;
+
+	sets[0] = &portControl->language_memory_categories;
+	sets[1] = &portControl->omr_memory_categories;
+
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < sets[i]->numberOfCategories; j++) {
+			OMRMemCategory *category = sets[i]->categories[j];
+			if ((NULL != category) && (NULL == category->counterStripes)) {
+				categoryCount += 1;
+			}
+		}
+	}
+	if ((0 == categoryCount) || (NULL != portControl->memory_category_stripes)) {
+		return 0;
+	}
+
+	stride = categoryCount * sizeof(OMRMemCategoryCounters);
+	stride = (stride + CATEGORY_STRIPE_ALIGNMENT - 1) & ~(uintptr_t)(CATEGORY_STRIPE_ALIGNMENT - 1);
+	/* We are calling the real omrmem_allocate_memory, not the macro. */
+	portControl->memory_category_stripes = portLibrary->mem_allocate_memory(portLibrary,
+			(stride * OMRMEM_CATEGORY_COUNTER_STRIPES) + CATEGORY_STRIPE_ALIGNMENT, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == portControl->memory_category_stripes) {
+		return 0;
+	}
+	memset(portControl->memory_category_stripes, 0, (stride * OMRMEM_CATEGORY_COUNTER_STRIPES) + CATEGORY_STRIPE_ALIGNMENT);
+	stripes = (uint8_t *)(((uintptr_t)portControl->memory_category_stripes + CATEGORY_STRIPE_ALIGNMENT - 1) & ~(uintptr_t)(CATEGORY_STRIPE_ALIGNMENT - 1));
+
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < sets[i]->numberOfCategories; j++) {
+			OMRMemCategory *category = sets[i]->categories[j];
+			if ((NULL != category) && (NULL == category->counterStripes)) {
+				category->counterStripeStride = stride;
+				/* publish the stride before the stripes that it indexes */
+				issueWriteBarrier();
+				category->counterStripes = (OMRMemCategoryCounters *)(stripes + (next * sizeof(OMRMemCategoryCounters)));
+				next += 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/**
+ * Folds every category's stripes back into its shared counters and detaches them,
+ * then frees the stripes.
+ *
+ * Categories can only be reset while no other thread is allocating, so no update
+ * can be in flight on a stripe that is being removed.
+ */
+static void
+remove_category_stripes(struct OMRPortLibrary *portLibrary)
+{
+	J9PortControlData *portControl = &portLibrary->portGlobals->control;
+	uint8_t *stripesStart = NULL;
+	uint8_t *stripesEnd = NULL;
+	OMRMemCategorySet *sets[2];
+	uint32_t i = 0;
+	uint32_t j = 0;
+
+	if (NULL == portControl->memory_category_stripes) {
+		return;
+	}
+	stripesStart = (uint8_t *)portControl->memory_category_stripes;
+	sets[0] = &portControl->language_memory_categories;
+	sets[1] = &portControl->omr_memory_categories;
+
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < sets[i]->numberOfCategories; j++) {
+			OMRMemCategory *category = sets[i]->categories[j];
+			if ((NULL != category) && ((uint8_t *)category->counterStripes >= stripesStart)) {
+				uintptr_t liveBytes = 0;
+				uintptr_t liveAllocations = 0;
+				if (NULL == stripesEnd) {
+					stripesEnd = stripesStart + (category->counterStripeStride * OMRMEM_CATEGORY_COUNTER_STRIPES) + CATEGORY_STRIPE_ALIGNMENT;
+				}
+				if ((uint8_t *)category->counterStripes < stripesEnd) {
+					get_category_totals(category, &liveBytes, &liveAllocations);
+					category->counterStripes = NULL;
+					category->counterStripeStride = 0;
+					category->liveBytes = liveBytes;
+					category->liveAllocations = liveAllocations;
+				}
+			}
+		}
+	}
+
+	/* We are calling the real omrmem_free_memory, not the macro. */
+	portLibrary->mem_free_memory(portLibrary, portControl->memory_category_stripes);
+	portControl->memory_category_stripes = NULL;
 }
 
 /**
@@ -190,7 +391,11 @@ _recursive_category_walk_children(struct OMRPortLibrary *portLibrary, OMRMemCate
 	for (i = 0; i < parent->numberOfChildren; i++) {
 		uint32_t childCode = parent->children[i];
 		OMRMemCategory *child = omrmem_get_category(portLibrary, childCode);
-		result = state->walkFunction(child->categoryCode, child->name, child->liveBytes, child->liveAllocations, FALSE, parent->categoryCode, state);
+		uintptr_t liveBytes = 0;
+		uintptr_t liveAllocations = 0;
+
+		get_category_totals(child, &liveBytes, &liveAllocations);
+		result = state->walkFunction(child->categoryCode, child->name, liveBytes, liveAllocations, FALSE, parent->categoryCode, state);
 
 		if (result == J9MEM_CATEGORIES_KEEP_ITERATING) {
 			result = _recursive_category_walk_children(portLibrary, state, child);
@@ -210,8 +415,11 @@ static uintptr_t
 _recursive_category_walk_root(struct OMRPortLibrary *portLibrary, OMRMemCategoryWalkState *state, OMRMemCategory *walkPoint)
 {
 	uintptr_t result;
+	uintptr_t liveBytes = 0;
+	uintptr_t liveAllocations = 0;
 
-	result = state->walkFunction(walkPoint->categoryCode, walkPoint->name, walkPoint->liveBytes, walkPoint->liveAllocations, TRUE, 0, state);
+	get_category_totals(walkPoint, &liveBytes, &liveAllocations);
+	result = state->walkFunction(walkPoint->categoryCode, walkPoint->name, liveBytes, liveAllocations, TRUE, 0, state);
 
 	if (result == J9MEM_CATEGORIES_KEEP_ITERATING) {
 		return _recursive_category_walk_children(portLibrary, state, walkPoint);
@@ -279,6 +487,7 @@ omrmem_startup_categories(struct OMRPortLibrary *portLibrary)
 	portLibrary->portGlobals->control.language_memory_categories.categories = NULL;
 	portLibrary->portGlobals->control.omr_memory_categories.numberOfCategories = 0;
 	portLibrary->portGlobals->control.omr_memory_categories.categories = NULL;
+	portLibrary->portGlobals->control.memory_category_stripes = NULL;
 	return 0;
 }
 
@@ -294,6 +503,8 @@ void
 omrmem_shutdown_categories(struct OMRPortLibrary *portLibrary)
 {
 	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	/* Fold the stripes back into the categories, which may outlive this port library. */
+	remove_category_stripes(portLibrary);
 	/* Free any allocated memory categories data. */
 	if (NULL != portLibrary->portGlobals->control.language_memory_categories.categories) {
 		portLibrary->mem_free_memory(OMRPORTLIB, portLibrary->portGlobals->control.language_memory_categories.categories);
@@ -0,0 +1,785 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Memory pressure notifications
+ *
+ * Handlers registered with omrsysinfo_memory_pressure_register are called on a
+ * dedicated port library thread when the kernel reports memory pressure: pressure
+ * stall information (PSI) crossing a threshold, or the cgroup v2 memory.events
+ * counters for memory.high, memory.max and the OOM killer going up.
+ *
+ * PSI thresholds are armed as kernel triggers where the process may write them.
+ * Otherwise the pressure file is sampled: on a timer for the kernel's files, and
+ * whenever it is modified for ordinary files, such as those of a simulated cgroup
+ * root given with OMR_CGROUP_ROOT.
+ */
+
+#if defined(LINUX) && !defined(OMRZTPF)
+/* for pipe2 */
+#define _GNU_SOURCE
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutil.h"
+#include "thread_api.h"
+#include "ut_omrport.h"
+
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+
+#ifndef CGROUP2_SUPER_MAGIC
+#define CGROUP2_SUPER_MAGIC 0x63677270
+#endif /* CGROUP2_SUPER_MAGIC */
+#ifndef PROC_SUPER_MAGIC
+#define PROC_SUPER_MAGIC 0x9fa0
+#endif /* PROC_SUPER_MAGIC */
+
+#ifndef _J9VMATOMICFUNCTIONS_
+#define _J9VMATOMICFUNCTIONS_
+extern uintptr_t compareAndSwapUDATA(uintptr_t *location, uintptr_t oldValue, uintptr_t newValue);
+extern void issueReadWriteBarrier(void);
+#endif /* _J9VMATOMICFUNCTIONS_ */
+
+/* System-wide PSI, used when the process is not in a cgroup v2 hierarchy */
+#define OMR_MEMORY_PRESSURE_SYSTEM_FILE "/proc/pressure/memory"
+/* Defaults for a zero stall or window, as in the kernel's PSI documentation */
+#define OMR_MEMORY_PRESSURE_DEFAULT_STALL_MICROS ((uint64_t)150000)
+#define OMR_MEMORY_PRESSURE_DEFAULT_WINDOW_MICROS ((uint64_t)1000000)
+#define OMR_MEMORY_PRESSURE_THREAD_STACK_SIZE (128 * 1024)
+#define OMR_MEMORY_PRESSURE_FILE_BUFFER_SIZE 512
+
+/* Indices of the PSI lines and memory.events counters */
+#define OMR_MEMORY_PRESSURE_PSI_LINES 2
+#define OMR_MEMORY_PRESSURE_EVENT_COUNTERS 4
+
+static const char *psiLineNames[OMR_MEMORY_PRESSURE_PSI_LINES] = { "some", "full" };
+static const uintptr_t psiLineTypes[OMR_MEMORY_PRESSURE_PSI_LINES] = { OMRPORT_MEMORY_PRESSURE_SOME, OMRPORT_MEMORY_PRESSURE_FULL };
+static const char *eventCounterNames[OMR_MEMORY_PRESSURE_EVENT_COUNTERS] = { "high", "max", "oom", "oom_kill" };
+static const uintptr_t eventCounterTypes[OMR_MEMORY_PRESSURE_EVENT_COUNTERS] = {
+	OMRPORT_MEMORY_PRESSURE_HIGH, OMRPORT_MEMORY_PRESSURE_MAX, OMRPORT_MEMORY_PRESSURE_OOM, OMRPORT_MEMORY_PRESSURE_OOM_KILL
+};
+
+typedef struct OMRMemoryPressureSubscription {
+	struct OMRMemoryPressureSubscription *next;
+	omrsysinfo_memory_pressure_handler_fn handler;
+	void *userData;
+	uintptr_t events;
+	uint64_t stallMicros;
+	uint64_t windowMicros;
+	BOOLEAN retired; /* unregistered; unlinked and freed by the monitor thread */
+	int triggerFds[OMR_MEMORY_PRESSURE_PSI_LINES]; /* armed PSI trigger, or -1 if the line is sampled */
+	uint64_t baseline[OMR_MEMORY_PRESSURE_PSI_LINES]; /* stall total at the start of the window */
+	uint64_t baselineNanos[OMR_MEMORY_PRESSURE_PSI_LINES];
+} OMRMemoryPressureSubscription;
+
+typedef struct OMRMemoryPressureMonitor {
+	struct OMRPortLibrary *portLibrary;
+	omrthread_monitor_t monitor;
+	OMRMemoryPressureSubscription *subscriptions;
+	char pressurePath[EsMaxPath];
+	char eventsPath[EsMaxPath];
+	BOOLEAN hasPressure;
+	BOOLEAN hasEvents;
+	BOOLEAN pressureIsKernelFile; /* triggers can be armed, but inotify does not see changes */
+	int inotifyFd;
+	int pressureWatch;
+	int eventsWatch;
+	int wakeFds[2]; /* written to when subscriptions change or at shutdown */
+	uint64_t eventCounts[OMR_MEMORY_PRESSURE_EVENT_COUNTERS];
+	BOOLEAN threadAlive;
+	BOOLEAN shutdown;
+	/* poll set of the monitor thread */
+	struct pollfd *pollFds;
+	OMRMemoryPressureSubscription **pollSubscriptions;
+	uintptr_t *pollLines;
+	uintptr_t pollCapacity;
+} OMRMemoryPressureMonitor;
+
+/* The first two entries of the poll set */
+#define OMR_MEMORY_PRESSURE_POLL_WAKE 0
+#define OMR_MEMORY_PRESSURE_POLL_INOTIFY 1
+
+/**
+ * Reads a small file into buffer, NUL terminated.
+ *
+ * @return the number of bytes read, or -1 on failure
+ */
+static intptr_t
+readPressureFile(int fd, const char *path, char *buffer, uintptr_t size)
+{
+	intptr_t bytesRead = -1;
+
+	if (-1 != fd) {
+		bytesRead = pread(fd, buffer, size - 1, 0);
+	} else {
+		int pathFd = open(path, O_RDONLY | O_CLOEXEC);
+		if (-1 != pathFd) {
+			bytesRead = read(pathFd, buffer, size - 1);
+			close(pathFd);
+		}
+	}
+	buffer[(bytesRead > 0) ? bytesRead : 0] = '\0';
+	return bytesRead;
+}
+
+/**
+ * Finds the value of "name" in a file of newline terminated "name value" lines (memory.events),
+ * or of the "total=" field in a "name avg10=.. total=value" line (PSI). Lines without a newline
+ * are ignored, since they may belong to a file that is being rewritten.
+ *
+ * @return TRUE if the value was found
+ */
+static BOOLEAN
+findPressureValue(const char *content, const char *name, const char *field, uint64_t *value)
+{
+	uintptr_t nameLength = strlen(name);
+	const char *line = content;
+
+	while ('\0' != *line) {
+		const char *end = strchr(line, '\n');
+		if (NULL == end) {
+			break;
+		}
+		if ((0 == strncmp(line, name, nameLength)) && (' ' == line[nameLength])) {
+			const char *start = line + nameLength + 1;
+			if (NULL != field) {
+				start = strstr(start, field);
+				if ((NULL == start) || (start > end)) {
+					return FALSE;
+				}
+				start += strlen(field);
+			}
+			*value = strtoull(start, NULL, 10);
+			return TRUE;
+		}
+		line = end + 1;
+	}
+	return FALSE;
+}
+
+static void
+deliverEvent(OMRMemoryPressureMonitor *pm, OMRMemoryPressureSubscription *subscription, uintptr_t type, uint64_t total, uint64_t delta)
+{
+	OMRMemoryPressureEvent event;
+
+	event.type = type;
+	event.total = total;
+	event.delta = delta;
+	Trc_PRT_sysinfo_memory_pressure_event(subscription->handler, type, total, delta);
+	subscription->handler(pm->portLibrary, &event, subscription->userData);
+}
+
+/**
+ * Reads memory.events and reports the counters that went up. Called with the monitor held.
+ */
+static void
+checkEventCounters(OMRMemoryPressureMonitor *pm, BOOLEAN deliver)
+{
+	char buffer[OMR_MEMORY_PRESSURE_FILE_BUFFER_SIZE];
+	uintptr_t i = 0;
+
+	if (readPressureFile(-1, pm->eventsPath, buffer, sizeof(buffer)) <= 0) {
+		return;
+	}
+	for (i = 0; i < OMR_MEMORY_PRESSURE_EVENT_COUNTERS; i++) {
+		uint64_t count = 0;
+		if (findPressureValue(buffer, eventCounterNames[i], NULL, &count) && (count > pm->eventCounts[i])) {
+			uint64_t delta = count - pm->eventCounts[i];
+			pm->eventCounts[i] = count;
+			if (deliver) {
+				OMRMemoryPressureSubscription *subscription = NULL;
+				for (subscription = pm->subscriptions; NULL != subscription; subscription = subscription->next) {
+					if (!subscription->retired && (0 != (subscription->events & eventCounterTypes[i]))) {
+						deliverEvent(pm, subscription, eventCounterTypes[i], count, delta);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Compares the stall totals in the pressure file with each sampled subscription's window.
+ * A subscription is notified when the stall since the start of its window reaches its
+ * threshold; windows that pass without reaching it start again from the current total.
+ * Called with the monitor held.
+ */
+static void
+samplePressure(OMRMemoryPressureMonitor *pm)
+{
+	struct OMRPortLibrary *portLibrary = pm->portLibrary;
+	char buffer[OMR_MEMORY_PRESSURE_FILE_BUFFER_SIZE];
+	uint64_t totals[OMR_MEMORY_PRESSURE_PSI_LINES];
+	BOOLEAN found[OMR_MEMORY_PRESSURE_PSI_LINES];
+	uint64_t now = portLibrary->time_nano_time(portLibrary);
+	OMRMemoryPressureSubscription *subscription = NULL;
+	uintptr_t i = 0;
+
+	if (readPressureFile(-1, pm->pressurePath, buffer, sizeof(buffer)) <= 0) {
+		return;
+	}
+	for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+		found[i] = findPressureValue(buffer, psiLineNames[i], "total=", &totals[i]);
+	}
+	for (subscription = pm->subscriptions; NULL != subscription; subscription = subscription->next) {
+		for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+			if (subscription->retired
+				|| !found[i]
+				|| (0 == (subscription->events & psiLineTypes[i]))
+				|| (-1 != subscription->triggerFds[i])
+			) {
+				continue;
+			}
+			if (totals[i] < subscription->baseline[i]) {
+				/* the file was replaced; start a new window */
+				subscription->baseline[i] = totals[i];
+				subscription->baselineNanos[i] = now;
+			} else if ((totals[i] - subscription->baseline[i]) >= subscription->stallMicros) {
+				uint64_t delta = totals[i] - subscription->baseline[i];
+				subscription->baseline[i] = totals[i];
+				subscription->baselineNanos[i] = now;
+				deliverEvent(pm, subscription, psiLineTypes[i], totals[i], delta);
+			} else if ((now - subscription->baselineNanos[i]) >= (subscription->windowMicros * 1000)) {
+				subscription->baseline[i] = totals[i];
+				subscription->baselineNanos[i] = now;
+			}
+		}
+	}
+}
+
+/**
+ * Reports a fired kernel trigger. Called with the monitor held.
+ */
+static void
+triggerFired(OMRMemoryPressureMonitor *pm, OMRMemoryPressureSubscription *subscription, uintptr_t line)
+{
+	char buffer[OMR_MEMORY_PRESSURE_FILE_BUFFER_SIZE];
+	uint64_t total = 0;
+	uint64_t delta = 0;
+
+	if ((readPressureFile(subscription->triggerFds[line], NULL, buffer, sizeof(buffer)) > 0)
+		&& findPressureValue(buffer, psiLineNames[line], "total=", &total)
+		&& (total >= subscription->baseline[line])
+	) {
+		delta = total - subscription->baseline[line];
+	}
+	subscription->baseline[line] = total;
+	deliverEvent(pm, subscription, psiLineTypes[line], total, delta);
+}
+
+/**
+ * Frees retired subscriptions and rebuilds the poll set. Called with the monitor held.
+ *
+ * @param[out] timeout the sampling interval in milliseconds, or -1 if nothing needs sampling
+ *
+ * @return the number of entries in the poll set, or 0 on allocation failure
+ */
+static uintptr_t
+buildPollSet(OMRMemoryPressureMonitor *pm, int *timeout)
+{
+	struct OMRPortLibrary *portLibrary = pm->portLibrary;
+	OMRMemoryPressureSubscription **link = &pm->subscriptions;
+	OMRMemoryPressureSubscription *subscription = NULL;
+	uintptr_t count = 2;
+	uintptr_t needed = 2;
+	uint64_t sampleMicros = 0;
+
+	while (NULL != *link) {
+		subscription = *link;
+		if (subscription->retired) {
+			uintptr_t i = 0;
+			for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+				if (-1 != subscription->triggerFds[i]) {
+					close(subscription->triggerFds[i]);
+				}
+			}
+			*link = subscription->next;
+			portLibrary->mem_free_memory(portLibrary, subscription);
+		} else {
+			needed += OMR_MEMORY_PRESSURE_PSI_LINES;
+			link = &subscription->next;
+		}
+	}
+
+	if (needed > pm->pollCapacity) {
+		portLibrary->mem_free_memory(portLibrary, pm->pollFds);
+		pm->pollFds = portLibrary->mem_allocate_memory(portLibrary,
+				needed * (sizeof(struct pollfd) + sizeof(OMRMemoryPressureSubscription *) + sizeof(uintptr_t)),
+				OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == pm->pollFds) {
+			pm->pollCapacity = 0;
+			return 0;
+		}
+		pm->pollSubscriptions = (OMRMemoryPressureSubscription **)(pm->pollFds + needed);
+		pm->pollLines = (uintptr_t *)(pm->pollSubscriptions + needed);
+		pm->pollCapacity = needed;
+	}
+
+	pm->pollFds[OMR_MEMORY_PRESSURE_POLL_WAKE].fd = pm->wakeFds[0];
+	pm->pollFds[OMR_MEMORY_PRESSURE_POLL_WAKE].events = POLLIN;
+	pm->pollFds[OMR_MEMORY_PRESSURE_POLL_INOTIFY].fd = pm->inotifyFd;
+	pm->pollFds[OMR_MEMORY_PRESSURE_POLL_INOTIFY].events = POLLIN;
+
+	for (subscription = pm->subscriptions; NULL != subscription; subscription = subscription->next) {
+		uintptr_t i = 0;
+		for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+			if (0 == (subscription->events & psiLineTypes[i])) {
+				continue;
+			}
+			if (-1 != subscription->triggerFds[i]) {
+				pm->pollFds[count].fd = subscription->triggerFds[i];
+				pm->pollFds[count].events = POLLPRI;
+				pm->pollSubscriptions[count] = subscription;
+				pm->pollLines[count] = i;
+				count += 1;
+			} else if (pm->pressureIsKernelFile) {
+				if ((0 == sampleMicros) || (subscription->windowMicros < sampleMicros)) {
+					sampleMicros = subscription->windowMicros;
+				}
+			}
+		}
+	}
+
+	*timeout = (0 == sampleMicros) ? -1 : (int)OMR_MAX(sampleMicros / 1000, 1);
+	return count;
+}
+
+static int J9THREAD_PROC
+memoryPressureThread(void *entryArg)
+{
+	OMRMemoryPressureMonitor *pm = (OMRMemoryPressureMonitor *)entryArg;
+
+	omrthread_monitor_enter(pm->monitor);
+	while (!pm->shutdown) {
+		int timeout = -1;
+		uintptr_t count = buildPollSet(pm, &timeout);
+		BOOLEAN pressureChanged = FALSE;
+		BOOLEAN eventsChanged = FALSE;
+		uintptr_t i = 0;
+		int rc = 0;
+
+		if (0 == count) {
+			break;
+		}
+
+		omrthread_monitor_exit(pm->monitor);
+		rc = poll(pm->pollFds, (nfds_t)count, timeout);
+		omrthread_monitor_enter(pm->monitor);
+
+		if (pm->shutdown) {
+			break;
+		}
+		if (rc < 0) {
+			continue;
+		}
+		if (0 == rc) {
+			pressureChanged = TRUE;
+		}
+		if (0 != (pm->pollFds[OMR_MEMORY_PRESSURE_POLL_WAKE].revents & POLLIN)) {
+			char drain[64];
+			while (read(pm->wakeFds[0], drain, sizeof(drain)) > 0) {
+			}
+		}
+		if (0 != (pm->pollFds[OMR_MEMORY_PRESSURE_POLL_INOTIFY].revents & POLLIN)) {
+			char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+			intptr_t length = 0;
+			while ((length = read(pm->inotifyFd, events, sizeof(events))) > 0) {
+				char *cursor = events;
+				while (cursor < (events + length)) {
+					struct inotify_event *event = (struct inotify_event *)cursor;
+					if (event->wd == pm->eventsWatch) {
+						eventsChanged = TRUE;
+					} else if (event->wd == pm->pressureWatch) {
+						pressureChanged = TRUE;
+					}
+					cursor += sizeof(struct inotify_event) + event->len;
+				}
+			}
+		}
+		if (eventsChanged) {
+			checkEventCounters(pm, TRUE);
+		}
+		if (pressureChanged) {
+			samplePressure(pm);
+		}
+		for (i = 2; i < count; i++) {
+			OMRMemoryPressureSubscription *subscription = pm->pollSubscriptions[i];
+			short revents = pm->pollFds[i].revents;
+			if (subscription->retired || (0 == revents)) {
+				continue;
+			}
+			if (0 != (revents & (POLLERR | POLLNVAL))) {
+				/* the cgroup went away; stop watching this trigger */
+				close(subscription->triggerFds[pm->pollLines[i]]);
+				subscription->triggerFds[pm->pollLines[i]] = -1;
+			} else if (0 != (revents & POLLPRI)) {
+				triggerFired(pm, subscription, pm->pollLines[i]);
+			}
+		}
+	}
+
+	pm->threadAlive = FALSE;
+	omrthread_monitor_notify_all(pm->monitor);
+	omrthread_exit(pm->monitor);
+
+	/* unreachable */
+	return 0;
+}
+
+static void
+wakeMonitorThread(OMRMemoryPressureMonitor *pm)
+{
+	char wake = 0;
+	ssize_t rc = write(pm->wakeFds[1], &wake, 1);
+	(void)rc; /* a full pipe already has a wakeup pending */
+}
+
+/**
+ * Arms a kernel PSI trigger on the pressure file.
+ *
+ * @return the trigger file descriptor, or -1 if the kernel or the file's permissions do not allow it
+ */
+static int
+armTrigger(OMRMemoryPressureMonitor *pm, uintptr_t line, uint64_t stallMicros, uint64_t windowMicros)
+{
+	struct OMRPortLibrary *portLibrary = pm->portLibrary;
+	char trigger[64];
+	int fd = -1;
+
+	if (!pm->pressureIsKernelFile) {
+		return -1;
+	}
+	fd = open(pm->pressurePath, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (-1 != fd) {
+		portLibrary->str_printf(portLibrary, trigger, sizeof(trigger), "%s %llu %llu", psiLineNames[line], (unsigned long long)stallMicros, (unsigned long long)windowMicros);
+		/* the kernel expects the terminating NUL to be written */
+		if (write(fd, trigger, strlen(trigger) + 1) < 0) {
+			close(fd);
+			fd = -1;
+		}
+	}
+	return fd;
+}
+
+static void
+destroyMonitor(OMRMemoryPressureMonitor *pm)
+{
+	struct OMRPortLibrary *portLibrary = pm->portLibrary;
+	OMRMemoryPressureSubscription *subscription = pm->subscriptions;
+
+	while (NULL != subscription) {
+		OMRMemoryPressureSubscription *next = subscription->next;
+		uintptr_t i = 0;
+		for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+			if (-1 != subscription->triggerFds[i]) {
+				close(subscription->triggerFds[i]);
+			}
+		}
+		portLibrary->mem_free_memory(portLibrary, subscription);
+		subscription = next;
+	}
+	if (-1 != pm->inotifyFd) {
+		close(pm->inotifyFd);
+	}
+	if (-1 != pm->wakeFds[0]) {
+		close(pm->wakeFds[0]);
+		close(pm->wakeFds[1]);
+	}
+	if (NULL != pm->monitor) {
+		omrthread_monitor_destroy(pm->monitor);
+	}
+	portLibrary->mem_free_memory(portLibrary, pm->pollFds);
+	portLibrary->mem_free_memory(portLibrary, pm);
+}
+
+/**
+ * Returns the port library's memory pressure monitor, creating it on first use. The
+ * sources are chosen once: the process' cgroup v2 memory.pressure and memory.events,
+ * or the system-wide PSI file when there is no cgroup v2 memory controller.
+ */
+static OMRMemoryPressureMonitor *
+getMonitor(struct OMRPortLibrary *portLibrary)
+{
+	OMRMemoryPressureMonitor *pm = portLibrary->portGlobals->memoryPressureMonitor;
+	struct statfs fsInfo;
+
+	if (NULL != pm) {
+		return pm;
+	}
+	pm = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRMemoryPressureMonitor), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == pm) {
+		return NULL;
+	}
+	memset(pm, 0, sizeof(OMRMemoryPressureMonitor));
+	pm->portLibrary = portLibrary;
+	pm->inotifyFd = -1;
+	pm->pressureWatch = -1;
+	pm->eventsWatch = -1;
+	pm->wakeFds[0] = -1;
+	pm->wakeFds[1] = -1;
+
+	if ((0 != omrthread_monitor_init_with_name(&pm->monitor, 0, "portLibrary_omrsysinfo_memory_pressure_monitor"))
+		|| (0 != pipe2(pm->wakeFds, O_NONBLOCK | O_CLOEXEC))
+	) {
+		pm->wakeFds[0] = -1;
+		destroyMonitor(pm);
+		return NULL;
+	}
+	pm->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if ((0 == omrsysinfo_cgroup_v2_memory_file_path(portLibrary, "memory.pressure", pm->pressurePath, sizeof(pm->pressurePath)))
+		&& (0 == access(pm->pressurePath, R_OK))
+	) {
+		pm->hasPressure = TRUE;
+	} else if (0 == access(OMR_MEMORY_PRESSURE_SYSTEM_FILE, R_OK)) {
+		portLibrary->str_printf(portLibrary, pm->pressurePath, sizeof(pm->pressurePath), "%s", OMR_MEMORY_PRESSURE_SYSTEM_FILE);
+		pm->hasPressure = TRUE;
+	}
+	if ((0 == omrsysinfo_cgroup_v2_memory_file_path(portLibrary, "memory.events", pm->eventsPath, sizeof(pm->eventsPath)))
+		&& (0 == access(pm->eventsPath, R_OK))
+	) {
+		pm->hasEvents = TRUE;
+	}
+
+	if (pm->hasPressure) {
+		if ((0 == statfs(pm->pressurePath, &fsInfo))
+			&& ((CGROUP2_SUPER_MAGIC == fsInfo.f_type) || (PROC_SUPER_MAGIC == fsInfo.f_type))
+		) {
+			pm->pressureIsKernelFile = TRUE;
+		} else if (-1 != pm->inotifyFd) {
+			pm->pressureWatch = inotify_add_watch(pm->inotifyFd, pm->pressurePath, IN_MODIFY);
+		}
+	}
+	if (pm->hasEvents) {
+		if (-1 != pm->inotifyFd) {
+			pm->eventsWatch = inotify_add_watch(pm->inotifyFd, pm->eventsPath, IN_MODIFY);
+		}
+		checkEventCounters(pm, FALSE);
+	}
+	Trc_PRT_sysinfo_memory_pressure_sources(pm->hasPressure ? pm->pressurePath : "", pm->hasEvents ? pm->eventsPath : "", pm->pressureIsKernelFile);
+
+	issueReadWriteBarrier();
+	if (0 != compareAndSwapUDATA((uintptr_t *)&portLibrary->portGlobals->memoryPressureMonitor, 0, (uintptr_t)pm)) {
+		/* another thread created the monitor first */
+		destroyMonitor(pm);
+		pm = portLibrary->portGlobals->memoryPressureMonitor;
+	}
+	return pm;
+}
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+/**
+ * Register a handler to be called when the system or the process' cgroup is under memory pressure.
+ *
+ * Handlers run on a port library thread, started by the first registration, with an internal
+ * monitor held; they should return quickly, for example after requesting a garbage collection.
+ * A handler may register or unregister handlers, including itself.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handler The function to call.
+ * @param[in] userData Passed to handler, and used with handler to identify the registration.
+ * @param[in] events A mask of OMRPORT_MEMORY_PRESSURE_* events to report.
+ * @param[in] stallMicros For SOME and FULL: the stall time that must accumulate within a window
+ * before handler is called. 0 selects 150ms.
+ * @param[in] windowMicros For SOME and FULL: the window length. 0 selects 1s.
+ *
+ * @return 0 on success,
+ * OMRPORT_ERROR_INVALID_ARGUMENTS if handler is NULL, events is empty or unknown, or stallMicros exceeds windowMicros,
+ * OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED if SOME or FULL is requested and the kernel does not provide PSI,
+ * OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE if a memory.events event is requested and the process is
+ * not in a cgroup v2 hierarchy with the memory controller, or another negative error code on failure.
+ */
+int32_t
+omrsysinfo_memory_pressure_register(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData, uintptr_t events, uint64_t stallMicros, uint64_t windowMicros)
+{
+#if defined(LINUX) && !defined(OMRZTPF)
+	OMRMemoryPressureMonitor *pm = NULL;
+	OMRMemoryPressureSubscription *subscription = NULL;
+	int32_t rc = 0;
+	uintptr_t i = 0;
+
+	if (0 == stallMicros) {
+		stallMicros = OMR_MEMORY_PRESSURE_DEFAULT_STALL_MICROS;
+	}
+	if (0 == windowMicros) {
+		windowMicros = OMR_MEMORY_PRESSURE_DEFAULT_WINDOW_MICROS;
+	}
+	if ((NULL == handler)
+		|| (0 == events)
+		|| (0 != (events & ~OMRPORT_MEMORY_PRESSURE_ALL))
+		|| (stallMicros > windowMicros)
+	) {
+		return OMRPORT_ERROR_INVALID_ARGUMENTS;
+	}
+
+	pm = getMonitor(portLibrary);
+	if (NULL == pm) {
+		return portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED, "could not start the memory pressure monitor");
+	}
+
+	omrthread_monitor_enter(pm->monitor);
+	if ((0 != (events & OMRPORT_MEMORY_PRESSURE_PSI)) && !pm->hasPressure) {
+		rc = portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED, "pressure stall information is not available");
+		goto done;
+	}
+	if ((0 != (events & OMRPORT_MEMORY_PRESSURE_EVENTS)) && !pm->hasEvents) {
+		rc = portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE, "cgroup v2 memory.events is not available");
+		goto done;
+	}
+
+	subscription = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRMemoryPressureSubscription), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == subscription) {
+		rc = OMRPORT_ERROR_SYSINFO_MEMORY_ALLOC_FAILED;
+		goto done;
+	}
+	memset(subscription, 0, sizeof(OMRMemoryPressureSubscription));
+	subscription->handler = handler;
+	subscription->userData = userData;
+	subscription->events = events;
+	subscription->stallMicros = stallMicros;
+	subscription->windowMicros = windowMicros;
+	for (i = 0; i < OMR_MEMORY_PRESSURE_PSI_LINES; i++) {
+		subscription->triggerFds[i] = -1;
+		if (0 != (events & psiLineTypes[i])) {
+			char buffer[OMR_MEMORY_PRESSURE_FILE_BUFFER_SIZE];
+			subscription->triggerFds[i] = armTrigger(pm, i, stallMicros, windowMicros);
+			if (readPressureFile(-1, pm->pressurePath, buffer, sizeof(buffer)) > 0) {
+				findPressureValue(buffer, psiLineNames[i], "total=", &subscription->baseline[i]);
+			}
+			subscription->baselineNanos[i] = portLibrary->time_nano_time(portLibrary);
+		}
+	}
+
+	if (!pm->threadAlive) {
+		omrthread_t thread = NULL;
+		if (J9THREAD_SUCCESS != createThreadWithCategory(
+				&thread,
+				OMR_MEMORY_PRESSURE_THREAD_STACK_SIZE,
+				J9THREAD_PRIORITY_NORMAL,
+				0,
+				&memoryPressureThread,
+				pm,
+				J9THREAD_CATEGORY_SYSTEM_THREAD)
+		) {
+			subscription->retired = TRUE;
+			subscription->next = pm->subscriptions;
+			pm->subscriptions = subscription;
+			rc = portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED, "could not start the memory pressure thread");
+			goto done;
+		}
+		pm->threadAlive = TRUE;
+	}
+	subscription->next = pm->subscriptions;
+	pm->subscriptions = subscription;
+	Trc_PRT_sysinfo_memory_pressure_register(handler, userData, events, stallMicros, windowMicros, subscription->triggerFds[0], subscription->triggerFds[1]);
+	wakeMonitorThread(pm);
+
+done:
+	omrthread_monitor_exit(pm->monitor);
+	return rc;
+#else /* defined(LINUX) && !defined(OMRZTPF) */
+	return OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+}
+
+/**
+ * Remove a handler registered with @ref omrsysinfo_memory_pressure_register. Once this
+ * returns the handler will not be called again for that registration.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] handler The registered function.
+ * @param[in] userData The userData it was registered with.
+ *
+ * @return 0 on success, OMRPORT_ERROR_INVALID_ARGUMENTS if no such registration exists,
+ * OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED on platforms without memory pressure notifications.
+ */
+int32_t
+omrsysinfo_memory_pressure_unregister(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData)
+{
+#if defined(LINUX) && !defined(OMRZTPF)
+	OMRMemoryPressureMonitor *pm = portLibrary->portGlobals->memoryPressureMonitor;
+	OMRMemoryPressureSubscription *subscription = NULL;
+	int32_t rc = OMRPORT_ERROR_INVALID_ARGUMENTS;
+
+	if (NULL == pm) {
+		return rc;
+	}
+	omrthread_monitor_enter(pm->monitor);
+	for (subscription = pm->subscriptions; NULL != subscription; subscription = subscription->next) {
+		if (!subscription->retired && (handler == subscription->handler) && (userData == subscription->userData)) {
+			/* the monitor thread unlinks it and closes its triggers */
+			subscription->retired = TRUE;
+			wakeMonitorThread(pm);
+			rc = 0;
+			break;
+		}
+	}
+	omrthread_monitor_exit(pm->monitor);
+	return rc;
+#else /* defined(LINUX) && !defined(OMRZTPF) */
+	return OMRPORT_ERROR_SYSINFO_NOT_SUPPORTED;
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+}
+
+/**
+ * Stop the memory pressure thread and free every registration. Called while shutting
+ * down the port library, before sysinfo and the thread library go away.
+ *
+ * @param[in] portLibrary The port library.
+ */
+void
+omrsysinfo_memory_pressure_shutdown(struct OMRPortLibrary *portLibrary)
+{
+#if defined(LINUX) && !defined(OMRZTPF)
+	OMRMemoryPressureMonitor *pm = NULL;
+
+	if (NULL == portLibrary->portGlobals) {
+		return;
+	}
+	pm = portLibrary->portGlobals->memoryPressureMonitor;
+	if (NULL == pm) {
+		return;
+	}
+	omrthread_monitor_enter(pm->monitor);
+	pm->shutdown = TRUE;
+	wakeMonitorThread(pm);
+	while (pm->threadAlive) {
+		omrthread_monitor_wait(pm->monitor);
+	}
+	omrthread_monitor_exit(pm->monitor);
+
+	destroyMonitor(pm);
+	portLibrary->portGlobals->memoryPressureMonitor = NULL;
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+}
@@ -58,6 +58,7 @@
 static void setTagSumCheck(J9MemTag *tag, uint32_t eyeCatcher);
 static void *wrapBlockAndSetTags(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, const char *callSite, const uint32_t category);
 static void *unwrapBlockAndCheckTags(struct OMRPortLibrary *portLibrary, void *memoryPointer);
+static BOOLEAN mustMoveToReallocate(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount);
 
 /* Typedefs for basic allocators */
 typedef void *(*allocate_memory_func_t)(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount);
@@ -65,6 +66,10 @@ typedef void (*free_memory_func_t)(struct OMRPortLibrary *portLibrary, void *mem
 typedef void (*advise_and_free_memory_func_t)(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t memorySize);
 typedef void *(*reallocate_memory_func_t)(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount);
 
+/* Blocks of up to OMRMEM_CACHE_MAX_BLOCK_SIZE come from the size-class cache if it was enabled at startup */
+#define IS_CACHED_BLOCK_SIZE(portLibrary, roundedByteAmount) \
+	((NULL != (portLibrary)->portGlobals->memCache) && ((roundedByteAmount) <= OMRMEM_CACHE_MAX_BLOCK_SIZE))
+
 static void
 setTagSumCheck(J9MemTag *tag, uint32_t eyeCatcher)
 {
@@ -148,6 +153,26 @@ unwrapBlockAndCheckTags(struct OMRPortLibrary *portLibrary, void *memoryPointer)
 	return headerTag;
 }
 
+/**
+ * Returns TRUE if reallocating the block to byteAmount involves the size-class cache,
+ * either because the block came from it or because the new size belongs in it.
+ * Blocks with a corrupt header return FALSE, and are reported by the realloc path.
+ */
+static BOOLEAN
+mustMoveToReallocate(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount)
+{
+	J9MemTag *headerTag = omrmem_get_header_tag(memoryPointer);
+
+	if (NULL == portLibrary->portGlobals->memCache) {
+		return FALSE;
+	}
+	if (0 != checkTagSumCheck(headerTag, J9MEMTAG_EYECATCHER_ALLOC_HEADER)) {
+		return FALSE;
+	}
+	return IS_CACHED_BLOCK_SIZE(portLibrary, ROUNDED_BYTE_AMOUNT(headerTag->allocSize))
+		|| IS_CACHED_BLOCK_SIZE(portLibrary, ROUNDED_BYTE_AMOUNT(byteAmount));
+}
+
 /**
  * Allocate memory.
  *
@@ -177,7 +202,11 @@ omrmem_allocate_memory(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount,
 	Trc_PRT_mem_omrmem_allocate_memory_Entry(byteAmount, callSite);
 	allocationByteAmount = ROUNDED_BYTE_AMOUNT(byteAmount);
 
-	pointer = allocateFunction(portLibrary, allocationByteAmount);
+	if (IS_CACHED_BLOCK_SIZE(portLibrary, allocationByteAmount)) {
+		pointer = omrmem_cache_allocate(portLibrary, allocationByteAmount, category);
+	} else {
+		pointer = allocateFunction(portLibrary, allocationByteAmount);
+	}
 	if (NULL == pointer) {
 		Trc_PRT_memory_alloc_returned_null_2(callSite, allocationByteAmount);
 	} else {
@@ -202,8 +231,14 @@ omrmem_free_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer)
 	Trc_PRT_mem_omrmem_free_memory_Entry(memoryPointer);
 
 	if (memoryPointer != NULL) {
-		memoryPointer = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
-		freeFunction(portLibrary, memoryPointer);
+		J9MemTag *headerTag = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
+		uintptr_t allocationByteAmount = ROUNDED_BYTE_AMOUNT(headerTag->allocSize);
+
+		if (IS_CACHED_BLOCK_SIZE(portLibrary, allocationByteAmount)) {
+			omrmem_cache_free(portLibrary, headerTag, allocationByteAmount, headerTag->category);
+		} else {
+			freeFunction(portLibrary, headerTag);
+		}
 	}
 	Trc_PRT_mem_omrmem_free_memory_Exit();
 }
@@ -239,7 +274,12 @@ omrmem_advise_and_free_memory(struct OMRPortLibrary *portLibrary, void *memoryPo
 		}
 #endif /* (defined(LINUX) || defined (AIXPPC) || defined(J9ZOS390) || defined(OSX)) */
 		memoryPointer = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
-		adviseAndFreeFunction(portLibrary, memoryPointer, memorySize);
+		if (IS_CACHED_BLOCK_SIZE(portLibrary, ROUNDED_BYTE_AMOUNT(((J9MemTag *)memoryPointer)->allocSize))) {
+			/* Cached blocks are smaller than a page, there is nothing to advise */
+			omrmem_cache_free(portLibrary, memoryPointer, ROUNDED_BYTE_AMOUNT(((J9MemTag *)memoryPointer)->allocSize), ((J9MemTag *)memoryPointer)->category);
+		} else {
+			adviseAndFreeFunction(portLibrary, memoryPointer, memorySize);
+		}
 	}
 	Trc_PRT_mem_omrmem_advise_and_free_memory_Exit();
 }
@@ -283,6 +323,18 @@ omrmem_reallocate_memory(struct OMRPortLibrary *portLibrary, void *memoryPointer
 		pointer = omrmem_allocate_memory(portLibrary, byteAmount, NULL == callSite ? OMR_GET_CALLSITE() : callSite, category);
 	} else if (byteAmount == 0) {
 		omrmem_free_memory(portLibrary, memoryPointer);
+	} else if (mustMoveToReallocate(portLibrary, memoryPointer, byteAmount)) {
+		/* Cached blocks can't be resized in place, so move the contents to a new block */
+		J9MemTag *headerTag = omrmem_get_header_tag(memoryPointer);
+		uintptr_t copyAmount = OMR_MIN(headerTag->allocSize, byteAmount);
+
+		pointer = omrmem_allocate_memory(portLibrary, byteAmount, (NULL == callSite) ? headerTag->callSite : callSite, category);
+		if (NULL != pointer) {
+			memcpy(pointer, memoryPointer, copyAmount);
+			omrmem_free_memory(portLibrary, memoryPointer);
+		} else {
+			Trc_PRT_mem_omrmem_reallocate_memory_failed_2(callSite, memoryPointer, ROUNDED_BYTE_AMOUNT(byteAmount));
+		}
 	} else {
 		memoryPointer = unwrapBlockAndCheckTags(portLibrary, memoryPointer);
 		if (NULL == callSite) {
@@ -326,6 +378,7 @@ omrmem_shutdown(struct OMRPortLibrary *portLibrary)
 #endif /* OMR_ENV_DATA64 */
 
 	if (NULL != portLibrary->portGlobals) {
+		omrmem_cache_shutdown(portLibrary);
 		omrmem_shutdown_basic(portLibrary);
 		portLibrary->portGlobals = NULL;
 	}
@@ -380,6 +433,9 @@ omrmem_startup(struct OMRPortLibrary *portLibrary, uintptr_t portGlobalSize)
 	}
 #endif /* OMR_ENV_DATA64 */
 
+	/* Must be decided before the first tagged allocation, so it can't be changed later */
+	omrmem_cache_startup(portLibrary);
+
 	return 0;
 }
 
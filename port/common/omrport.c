@@ -56,6 +56,10 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrtime_hires_clock, /* time_hires_clock */
 	omrtime_hires_frequency, /* time_hires_frequency */
 	omrtime_hires_delta, /* time_hires_delta */
+	omrtime_fast_ticks, /* time_fast_ticks */
+	omrtime_fast_ticks_to_nanos, /* time_fast_ticks_to_nanos */
+	omrtime_fast_frequency, /* time_fast_frequency */
+	omrtime_fast_clock_source, /* time_fast_clock_source */
 	omrsysinfo_startup, /* sysinfo_startup */
 	omrsysinfo_shutdown, /* sysinfo_shutdown */
 	omrsysinfo_process_exists, /* sysinfo_process_exists */
@@ -242,8 +246,18 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrfile_lock_bytes, /* file_lock_bytes */
 	omrfile_convert_native_fd_to_omrfile_fd, /* file_convert_native_fd_to_omrfile_fd */
 	omrfile_convert_omrfile_fd_to_native_fd,
+	omrfile_pread, /* file_pread */
+	omrfile_pwrite, /* file_pwrite */
+	omrfile_preadv, /* file_preadv */
+	omrfile_pwritev, /* file_pwritev */
+	omrfile_copy_range, /* file_copy_range */
 	omrfile_blockingasync_unlock_bytes, /* file_blockingasync_unlock_bytes */
 	omrfile_blockingasync_lock_bytes, /* file_blockingasync_lock_bytes */
+	omrfile_async_create, /* file_async_create */
+	omrfile_async_submit, /* file_async_submit */
+	omrfile_async_wait, /* file_async_wait */
+	omrfile_async_backend, /* file_async_backend */
+	omrfile_async_destroy, /* file_async_destroy */
 	omrstr_ftime, /* str_ftime */
 	omrmmap_startup, /* mmap_startup */
 	omrmmap_shutdown, /* mmap_shutdown */
@@ -279,6 +293,8 @@ static OMRPortLibrary MasterPortLibraryTable = {
 	omrsysinfo_cgroup_subsystem_iterator_metricKey, /* sysinfo_cgroup_subsystem_iterator_metricKey */
 	omrsysinfo_cgroup_subsystem_iterator_next, /* sysinfo_cgroup_subsystem_iterator_next */
 	omrsysinfo_cgroup_subsystem_iterator_destroy, /* sysinfo_cgroup_subsystem_iterator_destroy */
+	omrsysinfo_memory_pressure_register, /* sysinfo_memory_pressure_register */
+	omrsysinfo_memory_pressure_unregister, /* sysinfo_memory_pressure_unregister */
 	omrport_init_library, /* port_init_library */
 	omrport_startup_library, /* port_startup_library */
 	omrport_create_library, /* port_create_library */
@@ -431,6 +447,8 @@ omrport_shutdown_library(struct OMRPortLibrary *portLibrary)
 	/* vmem shutdown now requires sl support.*/
 	portLibrary->vmem_shutdown(portLibrary);
 	portLibrary->sl_shutdown(portLibrary);
+	/* Stop the memory pressure thread while the thread and sysinfo support it relies on are still up */
+	omrsysinfo_memory_pressure_shutdown(portLibrary);
 	portLibrary->sysinfo_shutdown(portLibrary);
 	portLibrary->exit_shutdown(portLibrary);
 	portLibrary->dump_shutdown(portLibrary);
@@ -585,6 +603,11 @@ omrport_startup_library(struct OMRPortLibrary *portLibrary)
 		goto cleanup;
 	}
 
+	rc = omrtime_fast_startup(portLibrary);
+	if (0 != rc) {
+		goto cleanup;
+	}
+
 	rc = portLibrary->exit_startup(portLibrary);
 	if (0 != rc) {
 		goto cleanup;
@@ -258,7 +258,7 @@ omrport_control(struct OMRPortLibrary *portLibrary, const char *key, uintptr_t v
 #endif
 			portControl->language_memory_categories.numberOfCategories = languageCategoryCount;
 			portControl->omr_memory_categories.numberOfCategories = omrCategoryCount;
-			return 0;
+			return omrmem_install_category_stripes(portLibrary);
 		} else {
 			Trc_Assert_PRT_mem_categories_already_set(NULL != portControl->language_memory_categories.categories);
 			return 1;
@@ -279,6 +279,11 @@ omrport_control(struct OMRPortLibrary *portLibrary, const char *key, uintptr_t v
 	}
 #endif
 
+	/* The size-class cache can only be selected at startup; report whether it was */
+	if (0 == strcmp(OMRPORT_CTLDATA_MEM_SIZE_CLASS_CACHE, key)) {
+		return (NULL != portLibrary->portGlobals->memCache) ? 1 : 0;
+	}
+
 	if (0 == strcmp(OMRPORT_CTLDATA_VMEM_ADVISE_OS_ONFREE, key)) {
 		portLibrary->portGlobals->vmemAdviseOSonFree = value;
 		return 0;
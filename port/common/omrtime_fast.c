@@ -0,0 +1,428 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Low overhead high resolution clock
+ */
+
+
+/*
+ * This file contains a clock that reads a CPU counter directly instead of going
+ * through the OS. The counter is chosen once at port library startup:
+ *
+ *  - x86: the time stamp counter, if the CPU reports it as invariant and, on
+ *    Linux, the kernel itself uses it as its clocksource.
+ *  - AArch64: the virtual counter cntvct_el0, whose frequency is in cntfrq_el0.
+ *
+ * The frequency reported by the CPU (cpuid leaf 0x15, cntfrq_el0) is used when
+ * present. Otherwise the counter is calibrated against omrtime_nano_time and must
+ * be monotonic and agree with itself across two calibration runs, or else
+ * omrtime_nano_time is used instead. The choice is made once per process and
+ * shared by every port library started after it, so only the first startup can
+ * pay for calibration. Setting the environment variable OMR_TIME_FAST_CLOCK to OS
+ * forces the fallback.
+ */
+#include <string.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "ut_omrport.h"
+
+#if defined(OMR_ARCH_X86) && (defined(__GNUC__) || defined(_MSC_VER))
+#define OMRTIME_FAST_TSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else /* defined(_MSC_VER) */
+#include <cpuid.h>
+#endif /* defined(_MSC_VER) */
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define OMRTIME_FAST_CNTVCT
+#endif /* defined(OMR_ARCH_X86) && (defined(__GNUC__) || defined(_MSC_VER)) */
+
+#define OMRTIME_FAST_NANOS_PER_SECOND ((uint64_t)1000000000)
+/* Length of one calibration run */
+#define OMRTIME_FAST_CALIBRATION_NANOS ((int64_t)1000000)
+/* Calibration runs must agree to within 1/N */
+#define OMRTIME_FAST_TOLERANCE 100
+#define OMRTIME_FAST_CALIBRATION_ATTEMPTS 5
+
+#ifndef _J9VMATOMICFUNCTIONS_
+#define _J9VMATOMICFUNCTIONS_
+extern uintptr_t compareAndSwapUDATA(uintptr_t *location, uintptr_t oldValue, uintptr_t newValue);
+extern void issueReadWriteBarrier(void);
+#endif /* _J9VMATOMICFUNCTIONS_ */
+
+#define OMRTIME_FAST_PROCESS_CLOCK_UNSET 0
+#define OMRTIME_FAST_PROCESS_CLOCK_SELECTING 1
+#define OMRTIME_FAST_PROCESS_CLOCK_READY 2
+
+/* The counter chosen for this process, valid once the state is READY */
+static OMRTimeFastClock processFastClock;
+static volatile uintptr_t processFastClockState = OMRTIME_FAST_PROCESS_CLOCK_UNSET;
+
+#if defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT)
+
+static VMINLINE uint64_t
+readCounter(void)
+{
+#if defined(OMRTIME_FAST_TSC)
+#if defined(_MSC_VER)
+	return __rdtsc();
+#else /* defined(_MSC_VER) */
+	uint32_t lo = 0;
+	uint32_t hi = 0;
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+	return ((uint64_t)hi << 32) | lo;
+#endif /* defined(_MSC_VER) */
+#else /* defined(OMRTIME_FAST_TSC) */
+	uint64_t ticks = 0;
+	/* isb keeps the read from being hoisted above earlier instructions */
+	__asm__ __volatile__ ("isb; mrs %0, cntvct_el0" : "=r" (ticks) : : "memory");
+	return ticks;
+#endif /* defined(OMRTIME_FAST_TSC) */
+}
+
+static BOOLEAN
+withinTolerance(uint64_t a, uint64_t b)
+{
+	uint64_t difference = (a > b) ? (a - b) : (b - a);
+	return difference <= (a / OMRTIME_FAST_TOLERANCE);
+}
+
+/**
+ * Measure the counter frequency against omrtime_nano_time. Each end of the
+ * interval reads the counter on both sides of the OS clock and uses the midpoint.
+ *
+ * @return ticks per second, or 0 if the counter went backwards or the run was disturbed.
+ */
+static uint64_t
+measureFrequency(struct OMRPortLibrary *portLibrary)
+{
+	uint64_t startBefore = readCounter();
+	int64_t startNanos = portLibrary->time_nano_time(portLibrary);
+	uint64_t startAfter = readCounter();
+	uint64_t endBefore = 0;
+	uint64_t endAfter = 0;
+	int64_t endNanos = 0;
+	uint64_t ticks = 0;
+	uint64_t nanos = 0;
+
+	do {
+		endBefore = readCounter();
+		endNanos = portLibrary->time_nano_time(portLibrary);
+		endAfter = readCounter();
+		if ((endBefore < startAfter) || (endAfter < endBefore)) {
+			return 0;
+		}
+	} while ((endNanos - startNanos) < OMRTIME_FAST_CALIBRATION_NANOS);
+
+	if ((startAfter < startBefore) || (endNanos <= startNanos)) {
+		return 0;
+	}
+	/* A bracket wider than the whole run means the thread was preempted mid-read */
+	if (((startAfter - startBefore) + (endAfter - endBefore)) > ((endBefore - startAfter) / OMRTIME_FAST_TOLERANCE)) {
+		return 0;
+	}
+
+	ticks = (endBefore + ((endAfter - endBefore) / 2)) - (startBefore + ((startAfter - startBefore) / 2));
+	nanos = (uint64_t)(endNanos - startNanos);
+	return ((ticks / nanos) * OMRTIME_FAST_NANOS_PER_SECOND) + (((ticks % nanos) * OMRTIME_FAST_NANOS_PER_SECOND) / nanos);
+}
+
+/**
+ * @return ticks per second, or 0 if two calibration runs could not be made to agree.
+ */
+static uint64_t
+calibrateFrequency(struct OMRPortLibrary *portLibrary)
+{
+	uint64_t previous = 0;
+	uintptr_t attempt = 0;
+
+	for (attempt = 0; attempt < OMRTIME_FAST_CALIBRATION_ATTEMPTS; attempt++) {
+		uint64_t frequency = measureFrequency(portLibrary);
+		if (0 != frequency) {
+			if ((0 != previous) && withinTolerance(previous, frequency)) {
+				return (previous + frequency) / 2;
+			}
+			previous = frequency;
+		}
+	}
+	return 0;
+}
+
+#endif /* defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT) */
+
+#if defined(OMRTIME_FAST_TSC)
+
+static void
+readCpuid(uint32_t leaf, uint32_t *regs)
+{
+#if defined(_MSC_VER)
+	int cpuInfo[4];
+	__cpuid(cpuInfo, (int)leaf);
+	regs[0] = (uint32_t)cpuInfo[0];
+	regs[1] = (uint32_t)cpuInfo[1];
+	regs[2] = (uint32_t)cpuInfo[2];
+	regs[3] = (uint32_t)cpuInfo[3];
+#else /* defined(_MSC_VER) */
+	__cpuid(leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif /* defined(_MSC_VER) */
+}
+
+/**
+ * @return TRUE if the TSC runs at a constant rate in all P-, C- and T-states.
+ */
+static BOOLEAN
+isInvariantTSC(void)
+{
+	uint32_t regs[4] = {0, 0, 0, 0};
+
+	readCpuid(0x80000000, regs);
+	if (regs[0] < 0x80000007) {
+		return FALSE;
+	}
+	readCpuid(0x80000007, regs);
+	return 0 != (regs[3] & 0x100);
+}
+
+/**
+ * @return the TSC frequency enumerated by cpuid leaf 0x15, or 0 if the CPU does not report it.
+ */
+static uint64_t
+enumeratedTSCFrequency(void)
+{
+	uint32_t regs[4] = {0, 0, 0, 0};
+
+	readCpuid(0, regs);
+	if (regs[0] < 0x15) {
+		return 0;
+	}
+	readCpuid(0x15, regs);
+	/* eax = denominator, ebx = numerator, ecx = crystal clock in Hz */
+	if ((0 == regs[0]) || (0 == regs[1]) || (0 == regs[2])) {
+		return 0;
+	}
+	return ((uint64_t)regs[2] * regs[1]) / regs[0];
+}
+
+/**
+ * On Linux, a kernel that does not trust the TSC (for example because it is not
+ * synchronized across sockets or the hypervisor does not keep it stable) will
+ * have switched to another clocksource.
+ *
+ * @return FALSE if the kernel is known to be using a clocksource other than the TSC.
+ */
+static BOOLEAN
+isKernelClocksourceTSC(struct OMRPortLibrary *portLibrary)
+{
+#if defined(LINUX)
+	char clocksource[32];
+	intptr_t bytesRead = 0;
+	intptr_t fd = portLibrary->file_open(portLibrary, "/sys/devices/system/clocksource/clocksource0/current_clocksource", EsOpenRead, 0);
+
+	if (-1 == fd) {
+		/* Nothing to go on; rely on the CPU flags and calibration */
+		return TRUE;
+	}
+	bytesRead = portLibrary->file_read(portLibrary, fd, clocksource, sizeof(clocksource) - 1);
+	portLibrary->file_close(portLibrary, fd);
+	if (bytesRead <= 0) {
+		return TRUE;
+	}
+	clocksource[bytesRead] = '\0';
+	return (0 == strncmp(clocksource, "tsc", 3)) && (('\n' == clocksource[3]) || ('\0' == clocksource[3]));
+#else /* defined(LINUX) */
+	return TRUE;
+#endif /* defined(LINUX) */
+}
+
+#endif /* defined(OMRTIME_FAST_TSC) */
+
+/**
+ * Select the counter for this process and, if the CPU does not report its
+ * frequency, calibrate it.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[out] clock The selected counter, or the OS clock if there is none.
+ */
+static void
+selectCounter(struct OMRPortLibrary *portLibrary, OMRTimeFastClock *clock)
+{
+	clock->source = OMRPORT_TIME_FAST_CLOCK_OS;
+	clock->frequency = OMRTIME_FAST_NANOS_PER_SECOND;
+	clock->multiplier = 1;
+	clock->shift = 0;
+
+#if defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT)
+	{
+		int32_t source = OMRPORT_TIME_FAST_CLOCK_OS;
+		uint64_t frequency = 0;
+
+#if defined(OMRTIME_FAST_TSC)
+		if (isInvariantTSC() && isKernelClocksourceTSC(portLibrary)) {
+			frequency = enumeratedTSCFrequency();
+			if (0 == frequency) {
+				frequency = calibrateFrequency(portLibrary);
+			}
+			if (0 != frequency) {
+				source = OMRPORT_TIME_FAST_CLOCK_TSC;
+			}
+		}
+#else /* defined(OMRTIME_FAST_TSC) */
+		__asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r" (frequency));
+		/* Firmware is supposed to set cntfrq_el0; measure the counter if it did not */
+		if (0 == frequency) {
+			frequency = calibrateFrequency(portLibrary);
+		}
+		if (0 != frequency) {
+			source = OMRPORT_TIME_FAST_CLOCK_CNTVCT;
+		}
+#endif /* defined(OMRTIME_FAST_TSC) */
+
+		if (OMRPORT_TIME_FAST_CLOCK_OS != source) {
+			uint32_t shift = 32;
+			/* Largest shift that keeps the multiplier to 32 bits, see omrtime_fast_ticks_to_nanos */
+			while ((shift > 0) && (((OMRTIME_FAST_NANOS_PER_SECOND << shift) / frequency) > 0xFFFFFFFF)) {
+				shift -= 1;
+			}
+			clock->source = source;
+			clock->frequency = frequency;
+			clock->shift = shift;
+			clock->multiplier = (OMRTIME_FAST_NANOS_PER_SECOND << shift) / frequency;
+		}
+	}
+#endif /* defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT) */
+}
+
+/**
+ * Select the counter used by @ref omrtime_fast_ticks.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return 0 on success. The OS clock is always available, so this does not fail.
+ *
+ * @note Called from omrport_startup_library after time_startup. The counter is
+ * selected by the first port library to start and reused by later ones.
+ */
+int32_t
+omrtime_fast_startup(struct OMRPortLibrary *portLibrary)
+{
+	OMRTimeFastClock *clock = &portLibrary->portGlobals->fastClock;
+	char option[8];
+
+	if ((0 == portLibrary->sysinfo_get_env(portLibrary, "OMR_TIME_FAST_CLOCK", option, sizeof(option)))
+		&& (0 == strcmp("OS", option))
+	) {
+		clock->source = OMRPORT_TIME_FAST_CLOCK_OS;
+		clock->frequency = OMRTIME_FAST_NANOS_PER_SECOND;
+		clock->multiplier = 1;
+		clock->shift = 0;
+	} else if (OMRTIME_FAST_PROCESS_CLOCK_READY == processFastClockState) {
+		issueReadWriteBarrier();
+		*clock = processFastClock;
+	} else if (OMRTIME_FAST_PROCESS_CLOCK_UNSET == compareAndSwapUDATA((uintptr_t *)&processFastClockState, OMRTIME_FAST_PROCESS_CLOCK_UNSET, OMRTIME_FAST_PROCESS_CLOCK_SELECTING)) {
+		selectCounter(portLibrary, &processFastClock);
+		*clock = processFastClock;
+		issueReadWriteBarrier();
+		processFastClockState = OMRTIME_FAST_PROCESS_CLOCK_READY;
+	} else {
+		/* Another port library is selecting right now; rather than wait, select independently */
+		selectCounter(portLibrary, clock);
+	}
+
+	Trc_PRT_time_fast_startup_source(clock->source, clock->frequency);
+	return 0;
+}
+
+/**
+ * Read the fast clock.
+ *
+ * The counter is chosen at port library startup, see @ref omrtime_fast_clock_source.
+ * Reading it does not enter the kernel. Ticks are only meaningful as differences
+ * within one process, and are converted with @ref omrtime_fast_ticks_to_nanos.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return the current counter value.
+ */
+uint64_t
+omrtime_fast_ticks(struct OMRPortLibrary *portLibrary)
+{
+#if defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT)
+	if (OMRPORT_TIME_FAST_CLOCK_OS != portLibrary->portGlobals->fastClock.source) {
+		return readCounter();
+	}
+#endif /* defined(OMRTIME_FAST_TSC) || defined(OMRTIME_FAST_CNTVCT) */
+	return (uint64_t)portLibrary->time_nano_time(portLibrary);
+}
+
+/**
+ * Convert fast clock ticks, typically the difference of two @ref omrtime_fast_ticks
+ * values, to nanoseconds.
+ *
+ * @param[in] portLibrary The port library.
+ * @param[in] ticks Number of ticks.
+ *
+ * @return ticks in nanoseconds.
+ */
+uint64_t
+omrtime_fast_ticks_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t ticks)
+{
+	OMRTimeFastClock *clock = &portLibrary->portGlobals->fastClock;
+	uint64_t lo = ticks & 0xFFFFFFFF;
+	uint64_t hi = ticks >> 32;
+
+	if (0 == clock->shift) {
+		return ticks * clock->multiplier;
+	}
+	/* The multiplier fits in 32 bits, so each half can be multiplied without overflow */
+	return ((lo * clock->multiplier) >> clock->shift) + ((hi * clock->multiplier) << (32 - clock->shift));
+}
+
+/**
+ * Query the frequency of the fast clock.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return number of ticks per second.
+ */
+uint64_t
+omrtime_fast_frequency(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->portGlobals->fastClock.frequency;
+}
+
+/**
+ * Query which counter backs the fast clock.
+ *
+ * @param[in] portLibrary The port library.
+ *
+ * @return OMRPORT_TIME_FAST_CLOCK_TSC, OMRPORT_TIME_FAST_CLOCK_CNTVCT, or
+ * OMRPORT_TIME_FAST_CLOCK_OS if no suitable CPU counter was found.
+ */
+int32_t
+omrtime_fast_clock_source(struct OMRPortLibrary *portLibrary)
+{
+	return portLibrary->portGlobals->fastClock.source;
+}
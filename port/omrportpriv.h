@@ -34,6 +34,9 @@
 #include "omrport.h"
 #include <signal.h>
 
+/* Number of stripes each memory category's counters are spread over. Must be a power of 2. */
+#define OMRMEM_CATEGORY_COUNTER_STRIPES 16
+
 #define FLAG_IS_SET(flag,bitmap)		(0 != (flag & bitmap))
 #define FLAG_IS_NOT_SET(flag,bitmap) 	(0 == (flag & bitmap))
 
@@ -53,6 +56,7 @@ typedef struct J9PortControlData {
 	uintptr_t sig_flags;
 	OMRMemCategorySet language_memory_categories;
 	OMRMemCategorySet omr_memory_categories;
+	void *memory_category_stripes;
 #if defined(AIXPPC)
 	uintptr_t aix_proc_attr;
 #endif
@@ -107,6 +111,22 @@ typedef struct J9CudaGlobalData {
 } J9CudaGlobalData;
 #endif /* OMR_OPT_CUDA */
 
+/* Largest block, including memory tags, served by the size-class cache in omrmemcache.c */
+#define OMRMEM_CACHE_MAX_BLOCK_SIZE 2048
+
+typedef struct OMRMemCache OMRMemCache;
+
+/**
+ * Conversion from the counter read by omrtime_fast_ticks to nanoseconds:
+ * nanoseconds = (ticks * multiplier) >> shift.
+ */
+typedef struct OMRTimeFastClock {
+	int32_t source; /* OMRPORT_TIME_FAST_CLOCK_* */
+	uint32_t shift;
+	uint64_t multiplier;
+	uint64_t frequency; /* ticks per second */
+} OMRTimeFastClock;
+
 /* these port library globals are initialized to zero in omrmem_startup_basic */
 typedef struct OMRPortLibraryGlobalData {
 	void *corruptedMemoryBlock;
@@ -126,6 +146,9 @@ typedef struct OMRPortLibraryGlobalData {
 	uintptr_t vmemAdviseOSonFree;					/** For softmx to determine whether OS should be advised of freed vmem */
 	uintptr_t vectorRegsSupportOn;				/* Turn on vector regs support */
 	uintptr_t userSpecifiedCPUs;						/* Number of user-specified CPUs */
+	OMRMemCache *memCache;						/* Size-class cache, or NULL if not enabled at startup */
+	OMRTimeFastClock fastClock;					/* Counter behind omrtime_fast_ticks, chosen at startup */
+	struct OMRMemoryPressureMonitor *memoryPressureMonitor;	/* Started by the first omrsysinfo_memory_pressure_register */
 #if defined(OMR_OPT_CUDA)
 	J9CudaGlobalData cudaGlobals;
 #endif /* OMR_OPT_CUDA */
@@ -236,6 +259,16 @@ extern J9_CFUNC intptr_t
 omrfile_convert_native_fd_to_omrfile_fd(struct OMRPortLibrary *portLibrary, intptr_t nativeFD);
 extern J9_CFUNC intptr_t
 omrfile_convert_omrfile_fd_to_native_fd(struct OMRPortLibrary *portLibrary, intptr_t nativeFD);
+extern J9_CFUNC intptr_t
+omrfile_pread(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes, int64_t offset);
+extern J9_CFUNC intptr_t
+omrfile_pwrite(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf, intptr_t nbytes, int64_t offset);
+extern J9_CFUNC intptr_t
+omrfile_preadv(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset);
+extern J9_CFUNC intptr_t
+omrfile_pwritev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset);
+extern J9_CFUNC int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t fdIn, int64_t offsetIn, intptr_t fdOut, int64_t offsetOut, int64_t length);
 
 /* J9SourceJ9File_BlockingAsyncText*/
 extern J9_CFUNC int32_t
@@ -259,6 +292,22 @@ omrfile_blockingasync_startup(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC void
 omrfile_blockingasync_shutdown(struct OMRPortLibrary *portLibrary);
 
+/* J9SourceJ9FileAsync */
+extern J9_CFUNC int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t queueDepth, uint32_t flags, OMRFileAsyncContext **context);
+extern J9_CFUNC intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count);
+extern J9_CFUNC intptr_t
+omrfile_async_wait(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions);
+extern J9_CFUNC int32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+extern J9_CFUNC void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+#if !defined(OMR_OS_WINDOWS)
+extern J9_CFUNC int32_t
+omrfile_portable_error_from_errno(int32_t errorCode);
+#endif /* !defined(OMR_OS_WINDOWS) */
+
 /* J9SourceJ9FileStream */
 extern J9_CFUNC int32_t
 omrfilestream_startup(struct OMRPortLibrary *portLibrary);
@@ -350,6 +399,16 @@ omrmem_free_memory32(struct OMRPortLibrary *portLibrary, void *memoryPointer);
 extern J9_CFUNC uintptr_t
 omrmem_ensure_capacity32(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount);
 
+/* omrmemcache.c */
+extern J9_CFUNC void *
+omrmem_cache_allocate(struct OMRPortLibrary *portLibrary, uintptr_t byteAmount, uint32_t categoryCode);
+extern J9_CFUNC void
+omrmem_cache_free(struct OMRPortLibrary *portLibrary, void *memoryPointer, uintptr_t byteAmount, OMRMemCategory *category);
+extern J9_CFUNC int32_t
+omrmem_cache_startup(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC void
+omrmem_cache_shutdown(struct OMRPortLibrary *portLibrary);
+
 /* omrmemcategories.c */
 extern J9_CFUNC OMRMemCategory *
 omrmem_get_category(struct OMRPortLibrary *portLibrary, uint32_t categoryCode);
@@ -359,6 +418,8 @@ extern J9_CFUNC int32_t
 omrmem_startup_categories(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC void
 omrmem_shutdown_categories(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC int32_t
+omrmem_install_category_stripes(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC void
 omrmem_categories_increment_counters(OMRMemCategory *category, uintptr_t size);
 extern J9_CFUNC void
@@ -549,6 +610,18 @@ extern J9_CFUNC int32_t
 omrsysinfo_cgroup_subsystem_iterator_next(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state, struct OMRCgroupMetricElement *metricElement);
 extern J9_CFUNC void
 omrsysinfo_cgroup_subsystem_iterator_destroy(struct OMRPortLibrary *portLibrary, struct OMRCgroupMetricIteratorState *state);
+#if defined(LINUX) && !defined(OMRZTPF)
+extern J9_CFUNC int32_t
+omrsysinfo_cgroup_v2_memory_file_path(struct OMRPortLibrary *portLibrary, const char *fileName, char *fullPath, uintptr_t bufferLength);
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+/* omrmempressure.c */
+extern J9_CFUNC int32_t
+omrsysinfo_memory_pressure_register(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData, uintptr_t events, uint64_t stallMicros, uint64_t windowMicros);
+extern J9_CFUNC int32_t
+omrsysinfo_memory_pressure_unregister(struct OMRPortLibrary *portLibrary, omrsysinfo_memory_pressure_handler_fn handler, void *userData);
+extern J9_CFUNC void
+omrsysinfo_memory_pressure_shutdown(struct OMRPortLibrary *portLibrary);
 
 /* J9SourceJ9Signal*/
 extern J9_CFUNC int32_t
@@ -646,6 +719,18 @@ omrtime_msec_clock(struct OMRPortLibrary *portLibrary);
 extern J9_CFUNC uint64_t
 omrtime_current_time_nanos(struct OMRPortLibrary *portLibrary, uintptr_t *success);
 
+/* J9SourceJ9TimeFast*/
+extern J9_CFUNC uint64_t
+omrtime_fast_ticks(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC uint64_t
+omrtime_fast_ticks_to_nanos(struct OMRPortLibrary *portLibrary, uint64_t ticks);
+extern J9_CFUNC uint64_t
+omrtime_fast_frequency(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC int32_t
+omrtime_fast_clock_source(struct OMRPortLibrary *portLibrary);
+extern J9_CFUNC int32_t
+omrtime_fast_startup(struct OMRPortLibrary *portLibrary);
+
 /* J9SourceJ9TTY*/
 extern J9_CFUNC void
 omrtty_shutdown(struct OMRPortLibrary *portLibrary);
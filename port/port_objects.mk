@@ -117,6 +117,7 @@ ifneq (win,$(OMR_HOST_OS))
 endif
 
 OBJECTS += omrfile_blockingasync
+OBJECTS += omrfile_async
 
 ifeq (win,$(OMR_HOST_OS))
   OBJECTS += omrfilehelpers
@@ -129,7 +130,9 @@ endif
 OBJECTS += omrheap
 OBJECTS += omrmem
 OBJECTS += omrmemtag
+OBJECTS += omrmemcache
 OBJECTS += omrmemcategories
+OBJECTS += omrmempressure
 OBJECTS += omrport
 OBJECTS += omrmmap
 OBJECTS += j9nls
@@ -157,6 +160,7 @@ ifeq (win,$(OMR_HOST_OS))
   OBJECTS += omrsyslogmessages.res
 endif
 OBJECTS += omrtime
+OBJECTS += omrtime_fast
 OBJECTS += omrtlshelpers
 OBJECTS += omrtty
 OBJECTS += omrvmem
@@ -50,6 +50,11 @@
 #include "portnls.h"
 #include "ut_omrport.h"
 #include <sys/stat.h>
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define OMRFILE_HAS_PREADV
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
 
 #ifdef J9ZOS390
 /* The following undef is to address CMVC 95221 */
@@ -64,6 +69,9 @@ typedef struct statvfs PlatformStatfs;
 #endif /* defined(LINUX) || defined(OSX) */
 
 
+/* Size of the buffer used by omrfile_copy_range when the kernel can't copy directly */
+#define OMRFILE_COPY_BUFFER_SIZE (64 * 1024)
+
 static const char *const fileFStatErrorMsgPrefix = "fstat : ";
 static const char *const fileFStatFSErrorMsgPrefix = "fstatfs : ";
 #if defined(AIXPPC) && !defined(J9OS_I5)
@@ -73,6 +81,9 @@ static const char *const fileFStatVFSErrorMsgPrefix = "fstatvfs : ";
 static int32_t EsTranslateOpenFlags(int32_t flags);
 static void setPortableError(OMRPortLibrary *portLibrary, const char *funcName, int32_t portlibErrno, int systemErrno);
 static int32_t findError(int32_t errorCode);
+#if !defined(OMRFILE_HAS_PREADV)
+static intptr_t transferVectors(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset, BOOLEAN isWrite);
+#endif /* !defined(OMRFILE_HAS_PREADV) */
 #if (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || (defined(AIXPPC) && !defined(J9OS_I5))
 static void updateJ9FileStat(struct OMRPortLibrary *portLibrary, J9FileStat *j9statBuf, struct stat *statBuf, PlatformStatfs *statfsBuf);
 #else /* (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || (defined(AIXPPC) && !defined(J9OS_I5)) */
@@ -202,6 +213,21 @@ findError(int32_t errorCode)
 	}
 }
 
+/**
+ * @internal
+ * Maps an errno value to a portable file error code for the other file
+ * modules of the port library.
+ *
+ * @param[in] errorCode The error code reported by the OS
+ *
+ * @return	the (negative) portable error code
+ */
+int32_t
+omrfile_portable_error_from_errno(int32_t errorCode)
+{
+	return findError(errorCode);
+}
+
 /**
  * Populate J9FileStat using system specific structures.
  *
@@ -1279,3 +1305,242 @@ omrfile_convert_omrfile_fd_to_native_fd(struct OMRPortLibrary *portLibrary, intp
 
 	return omrfileFD;
 }
+
+intptr_t
+omrfile_pread(struct OMRPortLibrary *portLibrary, intptr_t inFD, void *buf, intptr_t nbytes, int64_t offset)
+{
+	int fd = (int)inFD;
+	intptr_t result = 0;
+
+	Trc_PRT_file_pread_Entry(inFD, buf, nbytes, offset);
+
+	if ((nbytes < 0) || (offset < 0)) {
+		result = portLibrary->error_set_last_error(portLibrary, EINVAL, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_pread_Exit(result);
+		return result;
+	}
+#if (FD_BIAS != 0)
+	if (fd < FD_BIAS) {
+		/* Positional reads are not possible on the standard streams */
+		result = portLibrary->error_set_last_error(portLibrary, -1, OMRPORT_ERROR_FILE_BADF);
+		Trc_PRT_file_pread_Exit(result);
+		return result;
+	}
+#endif /* (FD_BIAS != 0) */
+
+	do {
+		result = pread(fd - FD_BIAS, buf, (size_t)nbytes, (off_t)offset);
+	} while ((-1 == result) && (EINTR == errno));
+
+	if (-1 == result) {
+		result = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+	}
+
+	Trc_PRT_file_pread_Exit(result);
+	return result;
+}
+
+intptr_t
+omrfile_pwrite(struct OMRPortLibrary *portLibrary, intptr_t inFD, const void *buf, intptr_t nbytes, int64_t offset)
+{
+	int fd = (int)inFD;
+	intptr_t result = 0;
+
+	Trc_PRT_file_pwrite_Entry(inFD, buf, nbytes, offset);
+
+	if ((nbytes < 0) || (offset < 0)) {
+		result = portLibrary->error_set_last_error(portLibrary, EINVAL, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_pwrite_Exit(result);
+		return result;
+	}
+#if (FD_BIAS != 0)
+	if (fd < FD_BIAS) {
+		/* Positional writes are not possible on the standard streams */
+		result = portLibrary->error_set_last_error(portLibrary, -1, OMRPORT_ERROR_FILE_BADF);
+		Trc_PRT_file_pwrite_Exit(result);
+		return result;
+	}
+#endif /* (FD_BIAS != 0) */
+
+	do {
+		result = pwrite(fd - FD_BIAS, buf, (size_t)nbytes, (off_t)offset);
+	} while ((-1 == result) && (EINTR == errno));
+
+	if (-1 == result) {
+		result = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+	}
+
+	Trc_PRT_file_pwrite_Exit(result);
+	return result;
+}
+
+#if !defined(OMRFILE_HAS_PREADV)
+/**
+ * @internal
+ * Vectored positional I/O for platforms without preadv/pwritev: one call per
+ * buffer, stopping at the first short transfer. An error is only reported if
+ * it happens before any bytes were transferred.
+ */
+static intptr_t
+transferVectors(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset, BOOLEAN isWrite)
+{
+	intptr_t total = 0;
+	uint32_t i = 0;
+
+	for (i = 0; i < vectorCount; i++) {
+		intptr_t rc = 0;
+		if (isWrite) {
+			rc = portLibrary->file_pwrite(portLibrary, fd, vectors[i].buffer, (intptr_t)vectors[i].length, offset + total);
+		} else {
+			rc = portLibrary->file_pread(portLibrary, fd, vectors[i].buffer, (intptr_t)vectors[i].length, offset + total);
+		}
+		if (rc < 0) {
+			return (0 == total) ? rc : total;
+		}
+		total += rc;
+		if ((uintptr_t)rc < vectors[i].length) {
+			break;
+		}
+	}
+	return total;
+}
+#endif /* !defined(OMRFILE_HAS_PREADV) */
+
+intptr_t
+omrfile_preadv(struct OMRPortLibrary *portLibrary, intptr_t inFD, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_preadv_Entry(inFD, vectors, vectorCount, offset);
+
+	if (offset < 0) {
+		result = portLibrary->error_set_last_error(portLibrary, EINVAL, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_preadv_Exit(result);
+		return result;
+	}
+
+#if defined(OMRFILE_HAS_PREADV)
+	do {
+		/* OMRFileIOVec has the layout of struct iovec */
+		result = preadv((int)inFD - FD_BIAS, (const struct iovec *)vectors, (int)vectorCount, (off_t)offset);
+	} while ((-1 == result) && (EINTR == errno));
+
+	if (-1 == result) {
+		result = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+	}
+#else /* defined(OMRFILE_HAS_PREADV) */
+	result = transferVectors(portLibrary, inFD, vectors, vectorCount, offset, FALSE);
+#endif /* defined(OMRFILE_HAS_PREADV) */
+
+	Trc_PRT_file_preadv_Exit(result);
+	return result;
+}
+
+intptr_t
+omrfile_pwritev(struct OMRPortLibrary *portLibrary, intptr_t inFD, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_pwritev_Entry(inFD, vectors, vectorCount, offset);
+
+	if (offset < 0) {
+		result = portLibrary->error_set_last_error(portLibrary, EINVAL, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_pwritev_Exit(result);
+		return result;
+	}
+
+#if defined(OMRFILE_HAS_PREADV)
+	do {
+		/* OMRFileIOVec has the layout of struct iovec */
+		result = pwritev((int)inFD - FD_BIAS, (const struct iovec *)vectors, (int)vectorCount, (off_t)offset);
+	} while ((-1 == result) && (EINTR == errno));
+
+	if (-1 == result) {
+		result = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+	}
+#else /* defined(OMRFILE_HAS_PREADV) */
+	result = transferVectors(portLibrary, inFD, vectors, vectorCount, offset, TRUE);
+#endif /* defined(OMRFILE_HAS_PREADV) */
+
+	Trc_PRT_file_pwritev_Exit(result);
+	return result;
+}
+
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t fdIn, int64_t offsetIn, intptr_t fdOut, int64_t offsetOut, int64_t length)
+{
+	int64_t copied = 0;
+	char *buffer = NULL;
+
+	Trc_PRT_file_copy_range_Entry(fdIn, offsetIn, fdOut, offsetOut, length);
+
+	if ((offsetIn < 0) || (offsetOut < 0) || (length < 0)) {
+		copied = portLibrary->error_set_last_error(portLibrary, EINVAL, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_copy_range_Exit(copied);
+		return copied;
+	}
+
+#if defined(LINUX) && !defined(OMRZTPF) && defined(__NR_copy_file_range)
+	while (copied < length) {
+		loff_t in = (loff_t)(offsetIn + copied);
+		loff_t out = (loff_t)(offsetOut + copied);
+		size_t chunk = (size_t)OMR_MIN(length - copied, (int64_t)0x40000000);
+		intptr_t rc = (intptr_t)syscall(__NR_copy_file_range, (int)fdIn - FD_BIAS, &in, (int)fdOut - FD_BIAS, &out, chunk, 0);
+
+		if (rc > 0) {
+			copied += rc;
+		} else if (0 == rc) {
+			/* end of the input file */
+			Trc_PRT_file_copy_range_Exit(copied);
+			return copied;
+		} else if (EINTR == errno) {
+			continue;
+		} else if ((ENOSYS == errno) || (EXDEV == errno) || (EINVAL == errno) || (EOPNOTSUPP == errno)) {
+			/* the kernel or file system can't do this copy, finish it in user space */
+			break;
+		} else {
+			copied = portLibrary->error_set_last_error(portLibrary, errno, findError(errno));
+			Trc_PRT_file_copy_range_Exit(copied);
+			return copied;
+		}
+	}
+#endif /* defined(LINUX) && !defined(OMRZTPF) && defined(__NR_copy_file_range) */
+
+	if (copied < length) {
+		buffer = portLibrary->mem_allocate_memory(portLibrary, OMRFILE_COPY_BUFFER_SIZE, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+		if (NULL == buffer) {
+			copied = portLibrary->error_set_last_error(portLibrary, ENOMEM, OMRPORT_ERROR_FILE_OPFAILED);
+			Trc_PRT_file_copy_range_Exit(copied);
+			return copied;
+		}
+	}
+	while (copied < length) {
+		intptr_t chunk = (intptr_t)OMR_MIN(length - copied, (int64_t)OMRFILE_COPY_BUFFER_SIZE);
+		intptr_t bytesRead = portLibrary->file_pread(portLibrary, fdIn, buffer, chunk, offsetIn + copied);
+		intptr_t bytesWritten = 0;
+
+		if (bytesRead <= 0) {
+			if (bytesRead < 0) {
+				copied = bytesRead;
+			}
+			break;
+		}
+		while (bytesWritten < bytesRead) {
+			intptr_t rc = portLibrary->file_pwrite(portLibrary, fdOut, buffer + bytesWritten, bytesRead - bytesWritten, offsetOut + copied + bytesWritten);
+			if (rc < 0) {
+				bytesWritten = rc;
+				break;
+			}
+			bytesWritten += rc;
+		}
+		if (bytesWritten < 0) {
+			copied = bytesWritten;
+			break;
+		}
+		copied += bytesWritten;
+	}
+	portLibrary->mem_free_memory(portLibrary, buffer);
+
+	Trc_PRT_file_copy_range_Exit(copied);
+	return copied;
+}
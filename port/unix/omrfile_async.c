@@ -0,0 +1,728 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup Port
+ * @brief Asynchronous file I/O
+ *
+ * Operations are serviced by io_uring where the kernel provides it. Otherwise,
+ * or when the caller asks for it, a small pool of worker threads performs the
+ * operations with the positional omrfile functions.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "omrport.h"
+#include "omrportpriv.h"
+#include "omrutil.h"
+#include "thread_api.h"
+
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define OMRFILE_ASYNC_IO_URING
+#endif /* defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) */
+#endif /* __has_include(<linux/io_uring.h>) */
+#endif /* defined(__has_include) */
+#endif /* defined(LINUX) && !defined(OMRZTPF) */
+
+#ifndef _J9VMATOMICFUNCTIONS_
+#define _J9VMATOMICFUNCTIONS_
+extern void issueReadWriteBarrier(void);
+#endif /* _J9VMATOMICFUNCTIONS_ */
+
+/* Upper bound on the worker threads started for one context */
+#define OMRFILE_ASYNC_MAX_WORKERS 4
+#define OMRFILE_ASYNC_WORKER_STACK_SIZE (64 * 1024)
+
+#if defined(OMRFILE_ASYNC_IO_URING)
+/**
+ * Per-operation state that must outlive the submission call: the single
+ * buffer of a READ or WRITE is passed to the kernel as a one-entry vector.
+ */
+typedef struct OMRFileAsyncSlot {
+	struct iovec vector;
+	void *userData;
+} OMRFileAsyncSlot;
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+
+struct OMRFileAsyncContext {
+	struct OMRPortLibrary *portLibrary;
+	int32_t backend;
+	uintptr_t depth;
+	/* operations submitted whose completion has not been returned by omrfile_async_wait */
+	uintptr_t inFlight;
+
+	/* thread backend, all fields below are protected by monitor */
+	omrthread_monitor_t monitor;
+	OMRFileAsyncRequest *pending;
+	uintptr_t pendingHead;
+	uintptr_t pendingCount;
+	OMRFileAsyncCompletion *completed;
+	uintptr_t completedHead;
+	uintptr_t completedCount;
+	uintptr_t liveWorkers;
+	BOOLEAN shutdown;
+
+#if defined(OMRFILE_ASYNC_IO_URING)
+	/* io_uring backend */
+	int ringFD;
+	void *sqRing;
+	size_t sqRingSize;
+	void *cqRing;
+	size_t cqRingSize;
+	struct io_uring_sqe *sqes;
+	size_t sqesSize;
+	volatile uint32_t *sqHead;
+	volatile uint32_t *sqTail;
+	uint32_t sqMask;
+	uint32_t *sqArray;
+	volatile uint32_t *cqHead;
+	volatile uint32_t *cqTail;
+	uint32_t cqMask;
+	struct io_uring_cqe *cqes;
+	/* entries placed in the submission ring that the kernel has not yet consumed */
+	uintptr_t unsubmitted;
+	OMRFileAsyncSlot *slots;
+	uint32_t *freeSlots;
+	uintptr_t freeSlotCount;
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+};
+
+static BOOLEAN validRequest(const OMRFileAsyncRequest *request);
+static intptr_t performRequest(struct OMRPortLibrary *portLibrary, const OMRFileAsyncRequest *request);
+static int32_t startWorkers(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+static void stopWorkers(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+static int J9THREAD_PROC asyncWorker(void *entryArg);
+static intptr_t submitToWorkers(OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count);
+static intptr_t waitForWorkers(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions);
+#if defined(OMRFILE_ASYNC_IO_URING)
+static int32_t startRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+static void stopRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context);
+static int ringEnter(OMRFileAsyncContext *context, uintptr_t toSubmit, uintptr_t minComplete, uint32_t flags);
+static intptr_t submitToRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count);
+static uintptr_t reapRing(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions);
+static intptr_t waitForRing(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions);
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+
+static BOOLEAN
+validRequest(const OMRFileAsyncRequest *request)
+{
+	if ((request->offset < 0) && (OMRPORT_FILE_ASYNC_FSYNC != request->operation)) {
+		return FALSE;
+	}
+	switch (request->operation) {
+	case OMRPORT_FILE_ASYNC_READ:
+	case OMRPORT_FILE_ASYNC_WRITE:
+	case OMRPORT_FILE_ASYNC_FSYNC:
+		return TRUE;
+	case OMRPORT_FILE_ASYNC_READV:
+	case OMRPORT_FILE_ASYNC_WRITEV:
+		return (0 != request->vectorCount) && (NULL != request->buffer);
+	default:
+		return FALSE;
+	}
+}
+
+/**
+ * Perform one operation synchronously on the calling thread.
+ *
+ * @return bytes transferred, or a negative portable error code.
+ */
+static intptr_t
+performRequest(struct OMRPortLibrary *portLibrary, const OMRFileAsyncRequest *request)
+{
+	intptr_t result = 0;
+
+	switch (request->operation) {
+	case OMRPORT_FILE_ASYNC_READ:
+		return portLibrary->file_pread(portLibrary, request->fd, request->buffer, (intptr_t)request->length, request->offset);
+	case OMRPORT_FILE_ASYNC_WRITE:
+		return portLibrary->file_pwrite(portLibrary, request->fd, request->buffer, (intptr_t)request->length, request->offset);
+	case OMRPORT_FILE_ASYNC_READV:
+		return portLibrary->file_preadv(portLibrary, request->fd, (const OMRFileIOVec *)request->buffer, request->vectorCount, request->offset);
+	case OMRPORT_FILE_ASYNC_WRITEV:
+		return portLibrary->file_pwritev(portLibrary, request->fd, (const OMRFileIOVec *)request->buffer, request->vectorCount, request->offset);
+	default:
+		do {
+			result = fsync((int)portLibrary->file_convert_omrfile_fd_to_native_fd(portLibrary, request->fd));
+		} while ((-1 == result) && (EINTR == errno));
+		if (-1 == result) {
+			return omrfile_portable_error_from_errno(errno);
+		}
+		return 0;
+	}
+}
+
+static int J9THREAD_PROC
+asyncWorker(void *entryArg)
+{
+	OMRFileAsyncContext *context = (OMRFileAsyncContext *)entryArg;
+	struct OMRPortLibrary *portLibrary = context->portLibrary;
+
+	omrthread_monitor_enter(context->monitor);
+	for (;;) {
+		OMRFileAsyncRequest request;
+		intptr_t result = 0;
+		uintptr_t slot = 0;
+
+		while ((0 == context->pendingCount) && !context->shutdown) {
+			omrthread_monitor_wait(context->monitor);
+		}
+		if (0 == context->pendingCount) {
+			/* shutting down and nothing left to do */
+			break;
+		}
+		request = context->pending[context->pendingHead];
+		context->pendingHead = (context->pendingHead + 1) % context->depth;
+		context->pendingCount -= 1;
+		omrthread_monitor_exit(context->monitor);
+
+		result = performRequest(portLibrary, &request);
+
+		omrthread_monitor_enter(context->monitor);
+		slot = (context->completedHead + context->completedCount) % context->depth;
+		context->completed[slot].userData = request.userData;
+		context->completed[slot].result = result;
+		context->completedCount += 1;
+		omrthread_monitor_notify_all(context->monitor);
+	}
+	context->liveWorkers -= 1;
+	omrthread_monitor_notify_all(context->monitor);
+	omrthread_exit(context->monitor);
+
+	/* unreachable */
+	return 0;
+}
+
+static int32_t
+startWorkers(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	uintptr_t workers = OMR_MIN(context->depth, OMRFILE_ASYNC_MAX_WORKERS);
+	uintptr_t i = 0;
+
+	context->pending = portLibrary->mem_allocate_memory(portLibrary, context->depth * sizeof(OMRFileAsyncRequest), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == context->pending) {
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	for (i = 0; i < workers; i++) {
+		omrthread_t thread = NULL;
+		omrthread_monitor_enter(context->monitor);
+		context->liveWorkers += 1;
+		omrthread_monitor_exit(context->monitor);
+		if (J9THREAD_SUCCESS != createThreadWithCategory(
+				&thread,
+				OMRFILE_ASYNC_WORKER_STACK_SIZE,
+				J9THREAD_PRIORITY_NORMAL,
+				0,
+				&asyncWorker,
+				context,
+				J9THREAD_CATEGORY_SYSTEM_THREAD)
+		) {
+			omrthread_monitor_enter(context->monitor);
+			context->liveWorkers -= 1;
+			omrthread_monitor_exit(context->monitor);
+			stopWorkers(portLibrary, context);
+			return OMRPORT_ERROR_FILE_OPFAILED;
+		}
+	}
+	context->backend = OMRPORT_FILE_ASYNC_BACKEND_THREADS;
+	return 0;
+}
+
+/**
+ * Stop the worker threads once they have finished every queued operation.
+ */
+static void
+stopWorkers(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	omrthread_monitor_enter(context->monitor);
+	context->shutdown = TRUE;
+	omrthread_monitor_notify_all(context->monitor);
+	while (0 != context->liveWorkers) {
+		omrthread_monitor_wait(context->monitor);
+	}
+	omrthread_monitor_exit(context->monitor);
+
+	portLibrary->mem_free_memory(portLibrary, context->pending);
+	context->pending = NULL;
+}
+
+static intptr_t
+submitToWorkers(OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	uintptr_t accepted = 0;
+
+	omrthread_monitor_enter(context->monitor);
+	for (accepted = 0; (accepted < count) && (context->inFlight < context->depth); accepted++) {
+		uintptr_t slot = (context->pendingHead + context->pendingCount) % context->depth;
+		if (!validRequest(&requests[accepted])) {
+			break;
+		}
+		context->pending[slot] = requests[accepted];
+		context->pendingCount += 1;
+		context->inFlight += 1;
+	}
+	if (0 != accepted) {
+		omrthread_monitor_notify_all(context->monitor);
+	}
+	omrthread_monitor_exit(context->monitor);
+
+	return (intptr_t)accepted;
+}
+
+static intptr_t
+waitForWorkers(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	uintptr_t count = 0;
+
+	omrthread_monitor_enter(context->monitor);
+	while (context->completedCount < minCompletions) {
+		omrthread_monitor_wait(context->monitor);
+	}
+	while ((count < maxCompletions) && (0 != context->completedCount)) {
+		completions[count] = context->completed[context->completedHead];
+		context->completedHead = (context->completedHead + 1) % context->depth;
+		context->completedCount -= 1;
+		count += 1;
+	}
+	context->inFlight -= count;
+	omrthread_monitor_exit(context->monitor);
+
+	return (intptr_t)count;
+}
+
+#if defined(OMRFILE_ASYNC_IO_URING)
+/**
+ * Set up an io_uring instance. Fails quietly when the kernel lacks io_uring or
+ * it has been disabled, so that the caller can use the worker threads instead.
+ */
+static int32_t
+startRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	struct io_uring_params params;
+	uintptr_t i = 0;
+	int fd = -1;
+
+	memset(&params, 0, sizeof(params));
+	fd = (int)syscall(__NR_io_uring_setup, (unsigned int)context->depth, &params);
+	if (fd < 0) {
+		return -1;
+	}
+	context->ringFD = fd;
+
+	context->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	context->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if (OMR_ARE_ANY_BITS_SET(params.features, IORING_FEAT_SINGLE_MMAP)) {
+		context->sqRingSize = OMR_MAX(context->sqRingSize, context->cqRingSize);
+		context->cqRingSize = 0;
+	}
+	context->sqRing = mmap(NULL, context->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (MAP_FAILED == context->sqRing) {
+		context->sqRing = NULL;
+		goto fail;
+	}
+	if (0 == context->cqRingSize) {
+		context->cqRing = context->sqRing;
+	} else {
+		context->cqRing = mmap(NULL, context->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (MAP_FAILED == context->cqRing) {
+			context->cqRing = NULL;
+			goto fail;
+		}
+	}
+	context->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	context->sqes = mmap(NULL, context->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (MAP_FAILED == context->sqes) {
+		context->sqes = NULL;
+		goto fail;
+	}
+
+	context->sqHead = (volatile uint32_t *)((uint8_t *)context->sqRing + params.sq_off.head);
+	context->sqTail = (volatile uint32_t *)((uint8_t *)context->sqRing + params.sq_off.tail);
+	context->sqMask = *(uint32_t *)((uint8_t *)context->sqRing + params.sq_off.ring_mask);
+	context->sqArray = (uint32_t *)((uint8_t *)context->sqRing + params.sq_off.array);
+	context->cqHead = (volatile uint32_t *)((uint8_t *)context->cqRing + params.cq_off.head);
+	context->cqTail = (volatile uint32_t *)((uint8_t *)context->cqRing + params.cq_off.tail);
+	context->cqMask = *(uint32_t *)((uint8_t *)context->cqRing + params.cq_off.ring_mask);
+	context->cqes = (struct io_uring_cqe *)((uint8_t *)context->cqRing + params.cq_off.cqes);
+
+	context->slots = portLibrary->mem_allocate_memory(portLibrary, context->depth * sizeof(OMRFileAsyncSlot), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	context->freeSlots = portLibrary->mem_allocate_memory(portLibrary, context->depth * sizeof(uint32_t), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if ((NULL == context->slots) || (NULL == context->freeSlots)) {
+		goto fail;
+	}
+	for (i = 0; i < context->depth; i++) {
+		context->freeSlots[i] = (uint32_t)i;
+	}
+	context->freeSlotCount = context->depth;
+	context->backend = OMRPORT_FILE_ASYNC_BACKEND_IO_URING;
+	return 0;
+
+fail:
+	stopRing(portLibrary, context);
+	return -1;
+}
+
+static void
+stopRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	if (NULL != context->sqes) {
+		munmap(context->sqes, context->sqesSize);
+		context->sqes = NULL;
+	}
+	if ((NULL != context->cqRing) && (context->cqRing != context->sqRing)) {
+		munmap(context->cqRing, context->cqRingSize);
+	}
+	context->cqRing = NULL;
+	if (NULL != context->sqRing) {
+		munmap(context->sqRing, context->sqRingSize);
+		context->sqRing = NULL;
+	}
+	if (-1 != context->ringFD) {
+		close(context->ringFD);
+		context->ringFD = -1;
+	}
+	portLibrary->mem_free_memory(portLibrary, context->slots);
+	context->slots = NULL;
+	portLibrary->mem_free_memory(portLibrary, context->freeSlots);
+	context->freeSlots = NULL;
+}
+
+static int
+ringEnter(OMRFileAsyncContext *context, uintptr_t toSubmit, uintptr_t minComplete, uint32_t flags)
+{
+	int rc = (int)syscall(__NR_io_uring_enter, context->ringFD, (unsigned int)toSubmit, (unsigned int)minComplete, flags, NULL, 0);
+	if (rc > 0) {
+		context->unsubmitted -= (uintptr_t)rc;
+	}
+	return rc;
+}
+
+static intptr_t
+submitToRing(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	uint32_t tail = *context->sqTail;
+	uintptr_t accepted = 0;
+
+	for (accepted = 0; (accepted < count) && (0 != context->freeSlotCount); accepted++) {
+		const OMRFileAsyncRequest *request = &requests[accepted];
+		uint32_t index = tail & context->sqMask;
+		struct io_uring_sqe *sqe = &context->sqes[index];
+		uint32_t slotIndex = 0;
+		OMRFileAsyncSlot *slot = NULL;
+
+		if (!validRequest(request)) {
+			break;
+		}
+		slotIndex = context->freeSlots[--context->freeSlotCount];
+		slot = &context->slots[slotIndex];
+		slot->userData = request->userData;
+
+		memset(sqe, 0, sizeof(*sqe));
+		sqe->fd = (int32_t)portLibrary->file_convert_omrfile_fd_to_native_fd(portLibrary, request->fd);
+		sqe->user_data = slotIndex;
+		switch (request->operation) {
+		case OMRPORT_FILE_ASYNC_READ:
+		case OMRPORT_FILE_ASYNC_WRITE:
+			slot->vector.iov_base = request->buffer;
+			slot->vector.iov_len = (size_t)request->length;
+			sqe->opcode = (OMRPORT_FILE_ASYNC_READ == request->operation) ? IORING_OP_READV : IORING_OP_WRITEV;
+			sqe->addr = (uint64_t)(uintptr_t)&slot->vector;
+			sqe->len = 1;
+			sqe->off = (uint64_t)request->offset;
+			break;
+		case OMRPORT_FILE_ASYNC_READV:
+		case OMRPORT_FILE_ASYNC_WRITEV:
+			/* OMRFileIOVec has the layout of struct iovec */
+			sqe->opcode = (OMRPORT_FILE_ASYNC_READV == request->operation) ? IORING_OP_READV : IORING_OP_WRITEV;
+			sqe->addr = (uint64_t)(uintptr_t)request->buffer;
+			sqe->len = request->vectorCount;
+			sqe->off = (uint64_t)request->offset;
+			break;
+		default:
+			sqe->opcode = IORING_OP_FSYNC;
+			break;
+		}
+		context->sqArray[index] = index;
+		tail += 1;
+	}
+
+	if (0 != accepted) {
+		/* the entries must be visible before the kernel can observe the new tail */
+		issueReadWriteBarrier();
+		*context->sqTail = tail;
+		issueReadWriteBarrier();
+		context->unsubmitted += accepted;
+		context->inFlight += accepted;
+		/* On failure the entries stay in the ring and are handed over again by omrfile_async_wait. */
+		ringEnter(context, context->unsubmitted, 0, 0);
+	}
+
+	return (intptr_t)accepted;
+}
+
+static uintptr_t
+reapRing(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions)
+{
+	uint32_t head = *context->cqHead;
+	uint32_t tail = 0;
+	uintptr_t count = 0;
+
+	issueReadWriteBarrier();
+	tail = *context->cqTail;
+	issueReadWriteBarrier();
+	while ((head != tail) && (count < maxCompletions)) {
+		struct io_uring_cqe *cqe = &context->cqes[head & context->cqMask];
+		uint32_t slotIndex = (uint32_t)cqe->user_data;
+
+		completions[count].userData = context->slots[slotIndex].userData;
+		if (cqe->res < 0) {
+			completions[count].result = omrfile_portable_error_from_errno(-cqe->res);
+		} else {
+			completions[count].result = cqe->res;
+		}
+		context->freeSlots[context->freeSlotCount++] = slotIndex;
+		head += 1;
+		count += 1;
+	}
+	if (0 != count) {
+		issueReadWriteBarrier();
+		*context->cqHead = head;
+		context->inFlight -= count;
+	}
+
+	return count;
+}
+
+static intptr_t
+waitForRing(OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	uintptr_t count = 0;
+
+	if (0 != context->unsubmitted) {
+		ringEnter(context, context->unsubmitted, 0, 0);
+	}
+	for (;;) {
+		count += reapRing(context, completions + count, maxCompletions - count);
+		if ((count >= minCompletions) || (count == maxCompletions)) {
+			break;
+		}
+		if (ringEnter(context, context->unsubmitted, minCompletions - count, IORING_ENTER_GETEVENTS) < 0) {
+			if ((EINTR != errno) && (EAGAIN != errno) && (EBUSY != errno)) {
+				if (0 == count) {
+					return omrfile_portable_error_from_errno(errno);
+				}
+				break;
+			}
+		}
+	}
+
+	return (intptr_t)count;
+}
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+
+/**
+ * Create a queue for asynchronous file operations.
+ *
+ * The queue accepts up to queueDepth operations that have been submitted but
+ * whose completions have not yet been returned by @ref omrfile_async_wait.
+ * A context must not be used by more than one thread at a time.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] queueDepth Maximum number of operations in flight
+ * @param[in] flags OMRPORT_FILE_ASYNC_FORCE_THREADS to bypass kernel asynchronous I/O
+ * @param[out] context The new context
+ *
+ * @return 0 on success, negative portable error code on failure.
+ */
+int32_t
+omrfile_async_create(struct OMRPortLibrary *portLibrary, uint32_t queueDepth, uint32_t flags, OMRFileAsyncContext **context)
+{
+	OMRFileAsyncContext *newContext = NULL;
+	int32_t rc = 0;
+
+	*context = NULL;
+	if (0 == queueDepth) {
+		return OMRPORT_ERROR_FILE_INVAL;
+	}
+	newContext = portLibrary->mem_allocate_memory(portLibrary, sizeof(OMRFileAsyncContext), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newContext) {
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	memset(newContext, 0, sizeof(OMRFileAsyncContext));
+	newContext->portLibrary = portLibrary;
+	newContext->depth = queueDepth;
+	newContext->completed = portLibrary->mem_allocate_memory(portLibrary, queueDepth * sizeof(OMRFileAsyncCompletion), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == newContext->completed) {
+		portLibrary->mem_free_memory(portLibrary, newContext);
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+	if (0 != omrthread_monitor_init_with_name(&newContext->monitor, 0, "portLibrary_omrfile_async_monitor")) {
+		portLibrary->mem_free_memory(portLibrary, newContext->completed);
+		portLibrary->mem_free_memory(portLibrary, newContext);
+		return OMRPORT_ERROR_FILE_OPFAILED;
+	}
+
+#if defined(OMRFILE_ASYNC_IO_URING)
+	newContext->ringFD = -1;
+	if (OMR_ARE_NO_BITS_SET(flags, OMRPORT_FILE_ASYNC_FORCE_THREADS)) {
+		startRing(portLibrary, newContext);
+	}
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+	if (0 == newContext->backend) {
+		rc = startWorkers(portLibrary, newContext);
+		if (0 != rc) {
+			omrthread_monitor_destroy(newContext->monitor);
+			portLibrary->mem_free_memory(portLibrary, newContext->completed);
+			portLibrary->mem_free_memory(portLibrary, newContext);
+			return rc;
+		}
+	}
+
+	*context = newContext;
+	return 0;
+}
+
+/**
+ * Queue asynchronous file operations. Operations are started in order but may
+ * complete in any order; the userData of each request identifies its completion.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ * @param[in] requests The operations to start
+ * @param[in] count Number of entries in requests
+ *
+ * @return the number of leading requests accepted, which is less than count when
+ * the queue is full, or a negative portable error code if none could be accepted.
+ */
+intptr_t
+omrfile_async_submit(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, const OMRFileAsyncRequest *requests, uintptr_t count)
+{
+	intptr_t accepted = 0;
+
+	if ((NULL == context) || ((0 != count) && (NULL == requests))) {
+		return OMRPORT_ERROR_FILE_INVAL;
+	}
+#if defined(OMRFILE_ASYNC_IO_URING)
+	if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == context->backend) {
+		accepted = submitToRing(portLibrary, context, requests, count);
+	} else
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+	{
+		accepted = submitToWorkers(context, requests, count);
+	}
+
+	if ((0 == accepted) && (0 != count) && !validRequest(&requests[0])) {
+		return OMRPORT_ERROR_FILE_INVAL;
+	}
+	return accepted;
+}
+
+/**
+ * Collect completed asynchronous file operations, blocking until at least
+ * minCompletions are available. minCompletions is limited to the number of
+ * operations in flight.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ * @param[out] completions Storage for the completions
+ * @param[in] maxCompletions Number of entries in completions
+ * @param[in] minCompletions Number of completions to wait for, 0 to poll
+ *
+ * @return the number of completions stored, or a negative portable error code.
+ */
+intptr_t
+omrfile_async_wait(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context, OMRFileAsyncCompletion *completions, uintptr_t maxCompletions, uintptr_t minCompletions)
+{
+	if ((NULL == context) || ((0 != maxCompletions) && (NULL == completions))) {
+		return OMRPORT_ERROR_FILE_INVAL;
+	}
+	minCompletions = OMR_MIN(minCompletions, OMR_MIN(maxCompletions, context->inFlight));
+
+#if defined(OMRFILE_ASYNC_IO_URING)
+	if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == context->backend) {
+		return waitForRing(context, completions, maxCompletions, minCompletions);
+	}
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+	return waitForWorkers(context, completions, maxCompletions, minCompletions);
+}
+
+/**
+ * Report which mechanism services a context.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create
+ *
+ * @return OMRPORT_FILE_ASYNC_BACKEND_IO_URING or OMRPORT_FILE_ASYNC_BACKEND_THREADS,
+ * or 0 if context is NULL.
+ */
+int32_t
+omrfile_async_backend(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	if (NULL == context) {
+		return 0;
+	}
+	return context->backend;
+}
+
+/**
+ * Destroy a context, first waiting for any operations still in flight.
+ * Their completions are discarded.
+ *
+ * @param[in] portLibrary The port library
+ * @param[in] context The context returned by @ref omrfile_async_create, may be NULL
+ */
+void
+omrfile_async_destroy(struct OMRPortLibrary *portLibrary, OMRFileAsyncContext *context)
+{
+	OMRFileAsyncCompletion discarded[16];
+
+	if (NULL == context) {
+		return;
+	}
+	while (0 != context->inFlight) {
+		if (omrfile_async_wait(portLibrary, context, discarded, sizeof(discarded) / sizeof(discarded[0]), 1) < 0) {
+			break;
+		}
+	}
+#if defined(OMRFILE_ASYNC_IO_URING)
+	if (OMRPORT_FILE_ASYNC_BACKEND_IO_URING == context->backend) {
+		stopRing(portLibrary, context);
+	} else
+#endif /* defined(OMRFILE_ASYNC_IO_URING) */
+	{
+		stopWorkers(portLibrary, context);
+	}
+	omrthread_monitor_destroy(context->monitor);
+	portLibrary->mem_free_memory(portLibrary, context->completed);
+	portLibrary->mem_free_memory(portLibrary, context);
+}
@@ -260,6 +260,11 @@ struct  {
 #if defined(LINUX)
 
 #define OMR_CGROUP_V1_MOUNT_POINT "/sys/fs/cgroup"
+#define OMR_CGROUP_V2_MOUNT_POINT "/sys/fs/cgroup"
+#define OMR_CGROUP_V2_CONTROLLERS_FILE "cgroup.controllers"
+#if !defined(CGROUP2_SUPER_MAGIC)
+#define CGROUP2_SUPER_MAGIC 0x63677270
+#endif /* !defined(CGROUP2_SUPER_MAGIC) */
 #define ROOT_CGROUP "/"
 #define SYSTEMD_INIT_CGROUP "/init.scope"
 #define OMR_PROC_PID_ONE_CGROUP_FILE "/proc/1/cgroup"
@@ -274,6 +279,8 @@ struct  {
  */
 #define PROC_PID_CGROUP_ENTRY_FORMAT "%d:%[^:]:%s"
 #define PROC_PID_CGROUP_SYSTEMD_ENTRY_FORMAT "%d::%s"
+/* The unified (v2) hierarchy has a single entry with hierarchy ID 0 and no subsystems */
+#define PROC_PID_CGROUP_V2_ENTRY_PREFIX "0::"
 
 #define SINGLE_CGROUP_METRIC 1
 
@@ -370,6 +377,38 @@ static struct OMRCgroupSubsystemMetricMap omrCgroupCpusetMetricMap[] = {
 	{ "cpuset.mems", &(OMRCgroupMetricInfoElement){ "Mems", NULL, NULL, FALSE }, SINGLE_CGROUP_METRIC }
 };
 
+static struct OMRCgroupMetricInfoElement memoryPressureMetricElementList[] = {
+	{ "Some tasks stalled on memory", "some", NULL, FALSE },
+	{ "All tasks stalled on memory", "full", NULL, FALSE }
+};
+
+static struct OMRCgroupMetricInfoElement cpuV2StatMetricElementList[] = {
+	{ "Period intervals elapsed count", "nr_periods", NULL, FALSE },
+	{ "Throttled count", "nr_throttled", NULL, FALSE },
+	{ "Total throttle time", "throttled_usec", "microseconds", FALSE }
+};
+
+/* Metrics of the unified (v2) hierarchy. Limits read as "max" when not set. */
+static struct OMRCgroupSubsystemMetricMap omrCgroupV2MemoryMetricMap[] = {
+	{ "memory.max", &(OMRCgroupMetricInfoElement){ "Memory Limit", NULL, "bytes", TRUE }, SINGLE_CGROUP_METRIC },
+	{ "memory.high", &(OMRCgroupMetricInfoElement){ "Memory Throttle Limit", NULL, "bytes", TRUE }, SINGLE_CGROUP_METRIC },
+	{ "memory.swap.max", &(OMRCgroupMetricInfoElement){ "Swap Limit", NULL, "bytes", TRUE }, SINGLE_CGROUP_METRIC },
+	{ "memory.current", &(OMRCgroupMetricInfoElement){ "Memory Usage", NULL, "bytes", FALSE }, SINGLE_CGROUP_METRIC },
+	{ "memory.swap.current", &(OMRCgroupMetricInfoElement){ "Swap Usage", NULL, "bytes", FALSE }, SINGLE_CGROUP_METRIC },
+	{ "memory.pressure", &memoryPressureMetricElementList[0], sizeof(memoryPressureMetricElementList)/sizeof(memoryPressureMetricElementList[0]) }
+};
+
+static struct OMRCgroupSubsystemMetricMap omrCgroupV2CpuMetricMap[] = {
+	{ "cpu.max", &(OMRCgroupMetricInfoElement){ "CPU Quota and Period", NULL, "microseconds", FALSE }, SINGLE_CGROUP_METRIC },
+	{ "cpu.weight", &(OMRCgroupMetricInfoElement){ "CPU Weight", NULL, NULL, FALSE }, SINGLE_CGROUP_METRIC },
+	{ "cpu.stat", &cpuV2StatMetricElementList[0], sizeof(cpuV2StatMetricElementList)/sizeof(cpuV2StatMetricElementList[0]) }
+};
+
+static struct OMRCgroupSubsystemMetricMap omrCgroupV2CpusetMetricMap[] = {
+	{ "cpuset.cpus.effective", &(OMRCgroupMetricInfoElement){ "CPUs", NULL, NULL, FALSE }, SINGLE_CGROUP_METRIC },
+	{ "cpuset.mems.effective", &(OMRCgroupMetricInfoElement){ "Mems", NULL, NULL, FALSE }, SINGLE_CGROUP_METRIC }
+};
+
 static uint32_t attachedPortLibraries;
 static omrthread_monitor_t cgroupEntryListMonitor;
 #endif /* defined(LINUX) */
@@ -402,15 +441,21 @@ static uint64_t getPhysicalMemory();
 
 #if defined(LINUX) && !defined(OMRZTPF)
 static BOOLEAN isCgroupV1Available(struct OMRPortLibrary *portLibrary);
+static BOOLEAN isCgroupV2Available(struct OMRPortLibrary *portLibrary);
 static void freeCgroupEntries(struct OMRPortLibrary *portLibrary, OMRCgroupEntry *cgEntryList);
 static char * getCgroupNameForSubsystem(struct OMRPortLibrary *portLibrary, OMRCgroupEntry *cgEntryList, const char *subsystem);
 static int32_t addCgroupEntry(struct OMRPortLibrary *portLibrary, OMRCgroupEntry **cgEntryList, int32_t hierId, const char *subsystem, const char *cgroupName, uint64_t flag);
 static int32_t readCgroupFile(struct OMRPortLibrary *portLibrary, int pid, BOOLEAN inContainer, OMRCgroupEntry **cgroupEntryList, uint64_t *availableSubsystems);
+static int32_t readCgroupV2Controllers(struct OMRPortLibrary *portLibrary, int pid, OMRCgroupEntry **cgroupEntryList, uint64_t *availableSubsystems);
 static OMRCgroupSubsystem getCgroupSubsystemFromFlag(uint64_t subsystemFlag);
 static int32_t getAbsolutePathOfCgroupSubsystemFile(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, char *fullPath, intptr_t *bufferLength);
 static int32_t  getHandleOfCgroupSubsystemFile(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, FILE **subsystemFile);
 static int32_t readCgroupMetricFromFile(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, const char *metricKeyInFile, char **fileContent, char *value);
 static int32_t readCgroupSubsystemFile(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, int32_t numItemsToRead, const char *format, ...);
+static int32_t readCgroupV2Limit(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, uint64_t *limit);
+static int32_t getCgroupCpuQuota(struct OMRPortLibrary *portLibrary, int64_t *cpuQuota, uint64_t *cpuPeriod);
+static int32_t getCgroupCpusetCount(struct OMRPortLibrary *portLibrary, int32_t *cpuCount);
+static const struct OMRCgroupSubsystemMetricMap *getCgroupSubsystemMetricMap(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, uint32_t *numElements);
 static int32_t isRunningInContainer(struct OMRPortLibrary *portLibrary, BOOLEAN *inContainer);
 static int32_t getCgroupMemoryLimit(struct OMRPortLibrary *portLibrary, uint64_t *limit);
 #endif /* defined(LINUX) */
@@ -1354,17 +1399,21 @@ omrsysinfo_get_number_CPUs_by_type(struct OMRPortLibrary *portLibrary, uintptr_t
 		/* If system calls failed to retrieve info, do not check cgroup at all, and give an error */
 		if (0 == toReturn) {
 			Trc_PRT_sysinfo_get_number_CPUs_by_type_failedBound("errno: ", errno);
-		} else if (portLibrary->sysinfo_cgroup_are_subsystems_enabled(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU)) {
-			int32_t rc = 0;
-			int64_t cpuQuota = 0;
-			uint64_t cpuPeriod = 0;
-			int32_t numItemsToRead = 1; /* cpu.cfs_quota_us and cpu.cfs_period_us files each contain only one integer value */
-
-			/* If either file read fails, ignore cgroup cpu quota limits and continue */
-			rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU, "cpu.cfs_quota_us", numItemsToRead, "%ld", &cpuQuota);
-			if (0 == rc) {
-				rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU, "cpu.cfs_period_us", numItemsToRead, "%lu", &cpuPeriod);
-				if (0 == rc) {
+		} else {
+			if (portLibrary->sysinfo_cgroup_are_subsystems_enabled(portLibrary, OMR_CGROUP_SUBSYSTEM_CPUSET)) {
+				int32_t numCpusCpuset = 0;
+
+				/* The affinity mask normally reflects the cpuset already, but not if the cpuset was changed after the mask was set */
+				if ((0 == getCgroupCpusetCount(portLibrary, &numCpusCpuset)) && (numCpusCpuset > 0) && (numCpusCpuset < toReturn)) {
+					toReturn = numCpusCpuset;
+				}
+			}
+			if (portLibrary->sysinfo_cgroup_are_subsystems_enabled(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU)) {
+				int64_t cpuQuota = 0;
+				uint64_t cpuPeriod = 0;
+
+				/* If the quota can't be read, ignore cgroup cpu quota limits and continue */
+				if (0 == getCgroupCpuQuota(portLibrary, &cpuQuota, &cpuPeriod)) {
 					int32_t numCpusQuota = (int32_t) (((double) cpuQuota / cpuPeriod) + 0.5);
 
 					if ((cpuQuota > 0) && (numCpusQuota < toReturn)) {
@@ -1603,6 +1652,16 @@ _cleanup:
 #define CGROUP_MEMORY_STAT_CACHE "cache"
 #define CGROUP_MEMORY_STAT_CACHE_SZ (sizeof(CGROUP_MEMORY_STAT_CACHE)-1)
 
+#define CGROUP_V2_MEMORY_MAX_FILE "memory.max"
+#define CGROUP_V2_MEMORY_HIGH_FILE "memory.high"
+#define CGROUP_V2_MEMORY_CURRENT_FILE "memory.current"
+#define CGROUP_V2_MEMORY_SWAP_MAX_FILE "memory.swap.max"
+#define CGROUP_V2_MEMORY_SWAP_CURRENT_FILE "memory.swap.current"
+
+/* Page cache is reported as "file" in the unified hierarchy; the space keeps it from matching "file_mapped" etc. */
+#define CGROUP_V2_MEMORY_STAT_FILE_CACHE "file "
+#define CGROUP_V2_MEMORY_STAT_FILE_CACHE_SZ (sizeof(CGROUP_V2_MEMORY_STAT_FILE_CACHE)-1)
+
 #if !defined(OMRZTPF)
 /**
  * Function collects memory usage statistics from the memory subsystem of the process's cgroup.
@@ -1618,6 +1677,8 @@ retrieveLinuxCgroupMemoryStats(struct OMRPortLibrary *portLibrary, struct OMRCgr
 	int32_t rc = 0;
 	FILE *memStatFs = NULL;
 	int32_t numItemsToRead = 1;
+	const char *cacheKey = CGROUP_MEMORY_STAT_CACHE;
+	uintptr_t cacheKeyLength = CGROUP_MEMORY_STAT_CACHE_SZ;
 
 	Assert_PRT_true(NULL != cgroupMemInfo);
 
@@ -1627,37 +1688,81 @@ retrieveLinuxCgroupMemoryStats(struct OMRPortLibrary *portLibrary, struct OMRCgr
 	cgroupMemInfo->memoryAndSwapUsage = OMRPORT_MEMINFO_NOT_AVAILABLE;
 	cgroupMemInfo->cached = OMRPORT_MEMINFO_NOT_AVAILABLE;
 
-	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_LIMIT_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryLimit);
-	if (0 != rc) {
-		goto _exit;
-	}
-	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_USAGE_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryUsage);
-	if (0 != rc) {
-		goto _exit;
-	}
-	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_SWAP_LIMIT_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryAndSwapLimit);
-	if (0 != rc) {
-		if (OMRPORT_ERROR_FILE_NOENT == rc) {
-			/* It is possible file memory.memsw.limit_in_bytes is not present if
-			 * swap space is not configured. In such cases, set memoryAndSwapLimit to same as memoryLimit.
-			 */
-			cgroupMemInfo->memoryAndSwapLimit = cgroupMemInfo->memoryLimit;
-			rc = 0;
-		} else {
+	if (2 == PPG_cgroupVersion) {
+		uint64_t memoryHigh = 0;
+		uint64_t swapLimit = 0;
+		uint64_t swapUsage = 0;
+
+		/* memory.high is where the kernel starts throttling and reclaiming, so treat the lower of the two as the limit */
+		rc = readCgroupV2Limit(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_MAX_FILE, &cgroupMemInfo->memoryLimit);
+		if (0 != rc) {
 			goto _exit;
 		}
-	}
-	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_SWAP_USAGE_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryAndSwapUsage);
-	if (0 != rc) {
+		rc = readCgroupV2Limit(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_HIGH_FILE, &memoryHigh);
+		if (0 != rc) {
+			goto _exit;
+		}
+		if (memoryHigh < cgroupMemInfo->memoryLimit) {
+			cgroupMemInfo->memoryLimit = memoryHigh;
+		}
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_CURRENT_FILE, numItemsToRead, "%" SCNu64, &cgroupMemInfo->memoryUsage);
+		if (0 != rc) {
+			goto _exit;
+		}
+		/* The swap files are absent if swap accounting is disabled; the swap files count swap alone, not memory + swap */
+		rc = readCgroupV2Limit(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_SWAP_MAX_FILE, &swapLimit);
+		if (0 != rc) {
+			goto _exit;
+		}
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_SWAP_CURRENT_FILE, numItemsToRead, "%" SCNu64, &swapUsage);
 		if (OMRPORT_ERROR_FILE_NOENT == rc) {
-			/* It is possible file memory.memsw.usage_in_bytes is not present if
-			 * swap space is not configured. In such cases, set memoryAndSwapUsage to memoryUsage.
-			 */
-			cgroupMemInfo->memoryAndSwapUsage = cgroupMemInfo->memoryUsage;
+			swapLimit = 0;
+			swapUsage = 0;
 			rc = 0;
+		} else if (0 != rc) {
+			goto _exit;
+		}
+		if (swapLimit > (UINT64_MAX - cgroupMemInfo->memoryLimit)) {
+			cgroupMemInfo->memoryAndSwapLimit = UINT64_MAX;
 		} else {
+			cgroupMemInfo->memoryAndSwapLimit = cgroupMemInfo->memoryLimit + swapLimit;
+		}
+		cgroupMemInfo->memoryAndSwapUsage = cgroupMemInfo->memoryUsage + swapUsage;
+		cacheKey = CGROUP_V2_MEMORY_STAT_FILE_CACHE;
+		cacheKeyLength = CGROUP_V2_MEMORY_STAT_FILE_CACHE_SZ;
+	} else {
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_LIMIT_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryLimit);
+		if (0 != rc) {
 			goto _exit;
 		}
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_USAGE_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryUsage);
+		if (0 != rc) {
+			goto _exit;
+		}
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_SWAP_LIMIT_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryAndSwapLimit);
+		if (0 != rc) {
+			if (OMRPORT_ERROR_FILE_NOENT == rc) {
+				/* It is possible file memory.memsw.limit_in_bytes is not present if
+				 * swap space is not configured. In such cases, set memoryAndSwapLimit to same as memoryLimit.
+				 */
+				cgroupMemInfo->memoryAndSwapLimit = cgroupMemInfo->memoryLimit;
+				rc = 0;
+			} else {
+				goto _exit;
+			}
+		}
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_MEMORY_SWAP_USAGE_IN_BYTES_FILE, numItemsToRead, "%lu", &cgroupMemInfo->memoryAndSwapUsage);
+		if (0 != rc) {
+			if (OMRPORT_ERROR_FILE_NOENT == rc) {
+				/* It is possible file memory.memsw.usage_in_bytes is not present if
+				 * swap space is not configured. In such cases, set memoryAndSwapUsage to memoryUsage.
+				 */
+				cgroupMemInfo->memoryAndSwapUsage = cgroupMemInfo->memoryUsage;
+				rc = 0;
+			} else {
+				goto _exit;
+			}
+		}
 	}
 
 	/* Read value of page cache memory from memory.stat file */
@@ -1678,12 +1783,12 @@ retrieveLinuxCgroupMemoryStats(struct OMRPortLibrary *portLibrary, struct OMRCgr
 		tmpPtr = (char *)statEntry;
 
 		/* Extract "cache" value */
-		if (0 == strncmp(tmpPtr, CGROUP_MEMORY_STAT_CACHE, CGROUP_MEMORY_STAT_CACHE_SZ)) {
-			tmpPtr += CGROUP_MEMORY_STAT_CACHE_SZ;
+		if (0 == strncmp(tmpPtr, cacheKey, cacheKeyLength)) {
+			tmpPtr += cacheKeyLength;
 			rc = sscanf(tmpPtr, "%" SCNu64, &cgroupMemInfo->cached);
 			if (1 != rc) {
-				Trc_PRT_retrieveLinuxCgroupMemoryStats_invalidValue(CGROUP_MEMORY_STAT_CACHE, CGROUP_MEMORY_STAT_FILE);
-				rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "invalid value for field %s in file %s", CGROUP_MEMORY_STAT_CACHE, CGROUP_MEMORY_STAT_FILE);
+				Trc_PRT_retrieveLinuxCgroupMemoryStats_invalidValue(cacheKey, CGROUP_MEMORY_STAT_FILE);
+				rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "invalid value for field %s in file %s", cacheKey, CGROUP_MEMORY_STAT_FILE);
 			} else {
 				/* reset 'rc' to success code */
 				rc = 0;
@@ -2098,6 +2203,10 @@ omrsysinfo_shutdown(struct OMRPortLibrary *portLibrary)
 		freeCgroupEntries(portLibrary, PPG_cgroupEntryList);
 		PPG_cgroupEntryList = NULL;
 		omrthread_monitor_exit(cgroupEntryListMonitor);
+		if (NULL != PPG_cgroupRoot) {
+			portLibrary->mem_free_memory(portLibrary, PPG_cgroupRoot);
+			PPG_cgroupRoot = NULL;
+		}
 		attachedPortLibraries -= 1;
 		if (0 == attachedPortLibraries) {
 			omrthread_monitor_destroy(cgroupEntryListMonitor);
@@ -2120,6 +2229,22 @@ omrsysinfo_startup(struct OMRPortLibrary *portLibrary)
 
 #if defined(LINUX) && !defined(OMRZTPF)
 	PPG_cgroupEntryList = NULL;
+	PPG_cgroupVersion = 0;
+	PPG_cgroupRoot = NULL;
+	{
+		/* OMR_CGROUP_ROOT names the mount point of a unified (v2) hierarchy to use instead of /sys/fs/cgroup */
+		const char *cgroupRoot = getenv("OMR_CGROUP_ROOT");
+
+		if ((NULL != cgroupRoot) && ('\0' != cgroupRoot[0])) {
+			uintptr_t length = strlen(cgroupRoot) + 1;
+
+			PPG_cgroupRoot = portLibrary->mem_allocate_memory(portLibrary, length, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+			if (NULL == PPG_cgroupRoot) {
+				return -1;
+			}
+			memcpy(PPG_cgroupRoot, cgroupRoot, length);
+		}
+	}
 	/* To handle the case where multiple port libraries are started and shutdown,
 	 * as done by some fvtests (eg fvtest/porttest/j9portTest.cpp) that create fake portlibrary
 	 * to test its management and lifecycle,
@@ -3839,6 +3964,32 @@ isCgroupV1Available(struct OMRPortLibrary *portLibrary)
 	return result;
 }
 
+/**
+ * @internal
+ * Checks if the unified (cgroup v2) hierarchy is mounted. It is taken to be
+ * available if OMR_CGROUP_ROOT names an alternative mount point.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ *
+ * @return TRUE if cgroup v2 system is available, FALSE otherwise
+ */
+static BOOLEAN
+isCgroupV2Available(struct OMRPortLibrary *portLibrary)
+{
+	struct statfs buf = {0};
+	BOOLEAN result = FALSE;
+
+	if (NULL != PPG_cgroupRoot) {
+		result = TRUE;
+	} else if ((0 == statfs(OMR_CGROUP_V2_MOUNT_POINT, &buf)) && (CGROUP2_SUPER_MAGIC == buf.f_type)) {
+		/* In the hybrid layout, cgroup2 is mounted under /sys/fs/cgroup/unified and the controllers are on v1 */
+		result = TRUE;
+	}
+	Trc_PRT_isCgroupV2Available(OMR_CGROUP_V2_MOUNT_POINT, (uintptr_t)result);
+
+	return result;
+}
+
 /**
  * @internal
  * Free resources allocated for OMRCgroupEntry
@@ -4072,6 +4223,123 @@ _end:
 	return rc;
 }
 
+/**
+ * Reads the cgroup of the given process from its unified (v2) hierarchy entry in
+ * /proc/<pid>/cgroup, and the controllers enabled for that cgroup from its
+ * cgroup.controllers file. Each supported controller gets an entry in the list.
+ *
+ * If the cgroup is not found under the mount point, as when a container mounts its own
+ * cgroup without a cgroup namespace, the root of the mount point is used instead.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[in] pid process id
+ * @param[out] cgroupEntryList pointer to OMRCgroupEntry *. On successful return, *cgroupEntry
+ * points to a circular linked list with an element for each supported controller.
+ * @param[out] availableSubsystems on successful return, contains bitwise-OR of flags of type OMR_CGROUP_SUBSYSTEMS_*
+ * indicating the subsystems available for use
+ *
+ * returns 0 on success, negative code on error
+ */
+static int32_t
+readCgroupV2Controllers(struct OMRPortLibrary *portLibrary, int pid, OMRCgroupEntry **cgroupEntryList, uint64_t *availableSubsystems)
+{
+	const char *mountPoint = (NULL != PPG_cgroupRoot) ? PPG_cgroupRoot : OMR_CGROUP_V2_MOUNT_POINT;
+	char cgroupFilePath[PATH_MAX];
+	char controllersPath[PATH_MAX];
+	char cgroup[PATH_MAX];
+	char controllers[MAX_LINE_LENGTH];
+	FILE *cgroupFile = NULL;
+	FILE *controllersFile = NULL;
+	OMRCgroupEntry *cgEntryList = NULL;
+	uint64_t available = 0;
+	char *token = NULL;
+	char *savePtr = NULL;
+	int32_t rc = 0;
+
+	Assert_PRT_true(NULL != cgroupEntryList);
+
+	portLibrary->str_printf(portLibrary, cgroupFilePath, sizeof(cgroupFilePath), "/proc/%d/cgroup", pid);
+	strcpy(cgroup, ROOT_CGROUP);
+	cgroupFile = fopen(cgroupFilePath, "r");
+	if (NULL == cgroupFile) {
+		int32_t osErrCode = errno;
+		Trc_PRT_readCgroupFile_fopen_failed(cgroupFilePath, osErrCode);
+		rc = portLibrary->error_set_last_error(portLibrary, osErrCode, OMRPORT_ERROR_SYSINFO_PROCESS_CGROUP_FILE_FOPEN_FAILED);
+		goto _end;
+	}
+	while (0 == feof(cgroupFile)) {
+		char buffer[PATH_MAX];
+
+		if (NULL == fgets(buffer, PATH_MAX, cgroupFile)) {
+			break;
+		}
+		if (0 == strncmp(buffer, PROC_PID_CGROUP_V2_ENTRY_PREFIX, sizeof(PROC_PID_CGROUP_V2_ENTRY_PREFIX) - 1)) {
+			char *newLine = NULL;
+
+			strcpy(cgroup, buffer + sizeof(PROC_PID_CGROUP_V2_ENTRY_PREFIX) - 1);
+			newLine = strchr(cgroup, '\n');
+			if (NULL != newLine) {
+				*newLine = '\0';
+			}
+			break;
+		}
+	}
+
+	portLibrary->str_printf(portLibrary, controllersPath, sizeof(controllersPath), "%s%s/%s", mountPoint, cgroup, OMR_CGROUP_V2_CONTROLLERS_FILE);
+	if (0 != access(controllersPath, F_OK)) {
+		strcpy(cgroup, ROOT_CGROUP);
+		portLibrary->str_printf(portLibrary, controllersPath, sizeof(controllersPath), "%s/%s", mountPoint, OMR_CGROUP_V2_CONTROLLERS_FILE);
+	}
+	controllersFile = fopen(controllersPath, "r");
+	if (NULL == controllersFile) {
+		int32_t osErrCode = errno;
+		Trc_PRT_readCgroupFile_fopen_failed(controllersPath, osErrCode);
+		rc = portLibrary->error_set_last_error(portLibrary, osErrCode, OMRPORT_ERROR_SYSINFO_PROCESS_CGROUP_FILE_FOPEN_FAILED);
+		goto _end;
+	}
+	/* The file is a single space separated line, e.g. "cpuset cpu io memory pids", and may be empty */
+	if (NULL == fgets(controllers, sizeof(controllers), controllersFile)) {
+		controllers[0] = '\0';
+	}
+
+	for (token = strtok_r(controllers, " \n", &savePtr); NULL != token; token = strtok_r(NULL, " \n", &savePtr)) {
+		int32_t i = 0;
+
+		for (i = 0; i < sizeof(supportedSubsystems) / sizeof(supportedSubsystems[0]); i++) {
+			if (OMR_ARE_NO_BITS_SET(available, supportedSubsystems[i].flag)
+				&& !strcmp(token, supportedSubsystems[i].name)
+			) {
+				rc = addCgroupEntry(portLibrary, &cgEntryList, 0, token, cgroup, supportedSubsystems[i].flag);
+				if (0 != rc) {
+					goto _end;
+				}
+				available |= supportedSubsystems[i].flag;
+			}
+		}
+	}
+	rc = 0;
+
+_end:
+	if (NULL != cgroupFile) {
+		fclose(cgroupFile);
+	}
+	if (NULL != controllersFile) {
+		fclose(controllersFile);
+	}
+	if (0 != rc) {
+		freeCgroupEntries(portLibrary, cgEntryList);
+		cgEntryList = NULL;
+	} else {
+		*cgroupEntryList = cgEntryList;
+		if (NULL != availableSubsystems) {
+			*availableSubsystems = available;
+			Trc_PRT_readCgroupFile_available_subsystems(available);
+		}
+	}
+
+	return rc;
+}
+
 /**
  * Given a subsystem flag, returns enum for that subsystem
  *
@@ -4132,6 +4400,21 @@ getAbsolutePathOfCgroupSubsystemFile(struct OMRPortLibrary *portLibrary, uint64_
 		goto _end;
 	}
 
+	if (2 == PPG_cgroupVersion) {
+		/* absolute path of the file to be read is: /sys/fs/cgroup/cgroup/fileName, all controllers share one hierarchy */
+		const char *mountPoint = (NULL != PPG_cgroupRoot) ? PPG_cgroupRoot : OMR_CGROUP_V2_MOUNT_POINT;
+
+		fullPathLen = portLibrary->str_printf(portLibrary, NULL, (uint32_t)-1, "%s/%s/%s", mountPoint, cgroup, fileName);
+		if (fullPathLen > *bufferLength) {
+			*bufferLength = fullPathLen;
+			rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_STRING_BUFFER_TOO_SMALL, "buffer size should be %d bytes", fullPathLen);
+			goto _end;
+		}
+
+		portLibrary->str_printf(portLibrary, fullPath, fullPathLen, "%s/%s/%s", mountPoint, cgroup, fileName);
+		goto _end;
+	}
+
 	/* absolute path of the file to be read is: /sys/fs/cgroup/subsystemNames[subsystem]/cgroup/filenName */
 	fullPathLen = portLibrary->str_printf(portLibrary, NULL, (uint32_t)-1, "%s/%s/%s/%s", OMR_CGROUP_V1_MOUNT_POINT, subsystemNames[subsystem], cgroup, fileName);
 	if (fullPathLen > *bufferLength) {
@@ -4146,6 +4429,31 @@ _end:
 	return rc;
 }
 
+/**
+ * Returns the absolute path of a file in the memory controller of the unified (v2) hierarchy.
+ * Used by the memory pressure monitor to locate memory.pressure and memory.events.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[in] fileName name of the file in the process' cgroup
+ * @param[out] fullPath buffer to receive the path
+ * @param[in] bufferLength size of fullPath
+ *
+ * @return 0 on success, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE if the process is not in a
+ * cgroup v2 hierarchy with the memory controller, or another negative error code on failure
+ */
+int32_t
+omrsysinfo_cgroup_v2_memory_file_path(struct OMRPortLibrary *portLibrary, const char *fileName, char *fullPath, uintptr_t bufferLength)
+{
+	intptr_t length = (intptr_t)bufferLength;
+
+	if ((OMR_CGROUP_SUBSYSTEM_MEMORY != portLibrary->sysinfo_cgroup_are_subsystems_available(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY))
+		|| (2 != PPG_cgroupVersion)
+	) {
+		return OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE;
+	}
+	return getAbsolutePathOfCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, fileName, fullPath, &length);
+}
+
 /**
  * Returns FILE pointer for the specified file in the cgroup subsystem.
  *
@@ -4309,7 +4617,8 @@ isRunningInContainer(struct OMRPortLibrary *portLibrary, BOOLEAN *inContainer)
 	/* Assume we are not in container */
 	*inContainer = FALSE;
 
-	if (isCgroupV1Available(portLibrary)) {
+	/* The unified hierarchy's single entry, "0::/", parses the same way as a systemd entry */
+	if (isCgroupV1Available(portLibrary) || isCgroupV2Available(portLibrary)) {
 		/* Read PID 1's cgroup file /proc/1/cgroup and check cgroup name for each subsystem.
 		 * If cgroup name for each subsystem points to the root cgroup "/",
 		 * then the process is not running in a container.
@@ -4384,15 +4693,35 @@ getCgroupMemoryLimit(struct OMRPortLibrary *portLibrary, uint64_t *limit)
 
 	Trc_PRT_sysinfo_cgroup_get_memlimit_Entry();
 
-	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, "memory.limit_in_bytes", numItemsToRead, "%" SCNu64, &cgroupMemLimit);
-	if (0 != rc) {
-		Trc_PRT_sysinfo_cgroup_get_memlimit_memory_limit_read_failed("memory.limit_in_bytes", rc);
-		goto _end;
+	if (2 == PPG_cgroupVersion) {
+		uint64_t cgroupMemHigh = 0;
+
+		/* memory.high is where the kernel starts throttling and reclaiming, so treat the lower of the two as the limit */
+		rc = readCgroupV2Limit(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_MAX_FILE, &cgroupMemLimit);
+		if (0 != rc) {
+			Trc_PRT_sysinfo_cgroup_get_memlimit_memory_limit_read_failed(CGROUP_V2_MEMORY_MAX_FILE, rc);
+			goto _end;
+		}
+		rc = readCgroupV2Limit(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, CGROUP_V2_MEMORY_HIGH_FILE, &cgroupMemHigh);
+		if (0 != rc) {
+			Trc_PRT_sysinfo_cgroup_get_memlimit_memory_limit_read_failed(CGROUP_V2_MEMORY_HIGH_FILE, rc);
+			goto _end;
+		}
+		if (cgroupMemHigh < cgroupMemLimit) {
+			cgroupMemLimit = cgroupMemHigh;
+		}
+	} else {
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_MEMORY, "memory.limit_in_bytes", numItemsToRead, "%" SCNu64, &cgroupMemLimit);
+		if (0 != rc) {
+			Trc_PRT_sysinfo_cgroup_get_memlimit_memory_limit_read_failed("memory.limit_in_bytes", rc);
+			goto _end;
+		}
 	}
 
 	physicalMemLimit = getPhysicalMemory(portLibrary);
 	/* If the cgroup is not imposing any memory limit then the value in memory.limit_in_bytes
 	 * is close to max value of 64-bit integer, and is more than the physical memory in the system.
+	 * An unset cgroup v2 limit ("max") reads as UINT64_MAX.
 	 */
 	if (cgroupMemLimit > physicalMemLimit) {
 		Trc_PRT_sysinfo_cgroup_get_memlimit_unlimited();
@@ -4408,6 +4737,177 @@ _end:
 	return rc;
 }
 
+/**
+ * Read a limit from a file of the unified (v2) hierarchy, such as memory.max.
+ * The file holds either a number of bytes or "max" if no limit is set.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[in] subsystemFlag flag of type OMR_CGROUP_SUBSYSTEMS_* representing the cgroup subsystem
+ * @param[in] fileName name of the file under cgroup subsystem
+ * @param[out] limit the limit, or UINT64_MAX if it is "max" or the file does not exist, as in the root cgroup
+ *
+ * @return 0 on success, negative error code on any error
+ */
+static int32_t
+readCgroupV2Limit(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, const char *fileName, uint64_t *limit)
+{
+	char value[32];
+	char *end = NULL;
+	int32_t rc = readCgroupSubsystemFile(portLibrary, subsystemFlag, fileName, 1, "%31s", value);
+
+	if (OMRPORT_ERROR_FILE_NOENT == rc) {
+		*limit = UINT64_MAX;
+		rc = 0;
+	} else if (0 == rc) {
+		if (0 == strcmp(value, "max")) {
+			*limit = UINT64_MAX;
+		} else {
+			*limit = (uint64_t)strtoull(value, &end, 10);
+			if ((end == value) || ('\0' != *end)) {
+				Trc_PRT_retrieveLinuxCgroupMemoryStats_invalidValue(value, fileName);
+				rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "invalid value %s in file %s", value, fileName);
+			}
+		}
+	}
+
+	return rc;
+}
+
+/**
+ * Read the CPU bandwidth limit of the cgroup: cpu.cfs_quota_us and cpu.cfs_period_us
+ * for cgroup v1, or cpu.max ("<quota> <period>", where quota may be "max") for cgroup v2.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[out] cpuQuota run time allowed per period in microseconds, or -1 if unlimited
+ * @param[out] cpuPeriod length of a period in microseconds
+ *
+ * @return 0 on success, negative error code on any error
+ */
+static int32_t
+getCgroupCpuQuota(struct OMRPortLibrary *portLibrary, int64_t *cpuQuota, uint64_t *cpuPeriod)
+{
+	int32_t rc = 0;
+
+	if (2 == PPG_cgroupVersion) {
+		char quota[32];
+
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU, "cpu.max", 2, "%31s %" SCNu64, quota, cpuPeriod);
+		if (0 == rc) {
+			if (0 == strcmp(quota, "max")) {
+				*cpuQuota = -1;
+			} else if (1 != sscanf(quota, "%" SCNd64, cpuQuota)) {
+				rc = portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "invalid value %s in file %s", quota, "cpu.max");
+			}
+		}
+	} else {
+		int32_t numItemsToRead = 1; /* cpu.cfs_quota_us and cpu.cfs_period_us files each contain only one integer value */
+
+		rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU, "cpu.cfs_quota_us", numItemsToRead, "%" SCNd64, cpuQuota);
+		if (0 == rc) {
+			rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPU, "cpu.cfs_period_us", numItemsToRead, "%" SCNu64, cpuPeriod);
+		}
+	}
+	if ((0 == rc) && (0 == *cpuPeriod)) {
+		rc = portLibrary->error_set_last_error_with_message(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "cgroup cpu period is 0");
+	}
+
+	return rc;
+}
+
+/**
+ * Count the CPUs in the cgroup v2 file cpuset.cpus.effective, a list of CPUs and
+ * CPU ranges such as "0-3,8,10-11".
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[out] cpuCount number of CPUs in the list
+ *
+ * @return 0 on success, negative error code on any error or if the hierarchy is not cgroup v2
+ */
+static int32_t
+getCgroupCpusetCount(struct OMRPortLibrary *portLibrary, int32_t *cpuCount)
+{
+	char cpus[CGROUP_METRIC_FILE_CONTENT_MAX_LIMIT];
+	char *cursor = cpus;
+	int32_t count = 0;
+	int32_t rc = 0;
+
+	if (2 != PPG_cgroupVersion) {
+		return OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_METRIC_NOT_AVAILABLE;
+	}
+	rc = readCgroupSubsystemFile(portLibrary, OMR_CGROUP_SUBSYSTEM_CPUSET, "cpuset.cpus.effective", 1, "%1023s", cpus);
+	if (0 != rc) {
+		return rc;
+	}
+
+	while ('\0' != *cursor) {
+		char *end = NULL;
+		unsigned long first = strtoul(cursor, &end, 10);
+		unsigned long last = first;
+
+		if (end == cursor) {
+			goto _invalid;
+		}
+		if ('-' == *end) {
+			cursor = end + 1;
+			last = strtoul(cursor, &end, 10);
+			if ((end == cursor) || (last < first)) {
+				goto _invalid;
+			}
+		}
+		count += (int32_t)(last - first + 1);
+		cursor = end;
+		if (',' == *cursor) {
+			cursor += 1;
+		} else if ('\0' != *cursor) {
+			goto _invalid;
+		}
+	}
+	*cpuCount = count;
+	return 0;
+
+_invalid:
+	return portLibrary->error_set_last_error_with_message_format(portLibrary, OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_FILE_INVALID_VALUE, "invalid value %s in file %s", cpus, "cpuset.cpus.effective");
+}
+
+/**
+ * Returns the metrics reported by the metric iterator for a subsystem, for the
+ * cgroup version in use.
+ *
+ * @param[in] portLibrary pointer to OMRPortLibrary
+ * @param[in] subsystemFlag flag of type OMR_CGROUP_SUBSYSTEMS_* representing the cgroup subsystem
+ * @param[out] numElements number of entries in the returned map, may be NULL
+ *
+ * @return the metric map, or NULL if the subsystem is not supported
+ */
+static const struct OMRCgroupSubsystemMetricMap *
+getCgroupSubsystemMetricMap(struct OMRPortLibrary *portLibrary, uint64_t subsystemFlag, uint32_t *numElements)
+{
+	const struct OMRCgroupSubsystemMetricMap *map = NULL;
+	uint32_t count = 0;
+	BOOLEAN isV2 = (2 == PPG_cgroupVersion);
+
+	switch (subsystemFlag) {
+	case OMR_CGROUP_SUBSYSTEM_MEMORY:
+		map = isV2 ? omrCgroupV2MemoryMetricMap : omrCgroupMemoryMetricMap;
+		count = isV2 ? (sizeof(omrCgroupV2MemoryMetricMap) / sizeof(omrCgroupV2MemoryMetricMap[0])) : (sizeof(omrCgroupMemoryMetricMap) / sizeof(omrCgroupMemoryMetricMap[0]));
+		break;
+	case OMR_CGROUP_SUBSYSTEM_CPU:
+		map = isV2 ? omrCgroupV2CpuMetricMap : omrCgroupCpuMetricMap;
+		count = isV2 ? (sizeof(omrCgroupV2CpuMetricMap) / sizeof(omrCgroupV2CpuMetricMap[0])) : (sizeof(omrCgroupCpuMetricMap) / sizeof(omrCgroupCpuMetricMap[0]));
+		break;
+	case OMR_CGROUP_SUBSYSTEM_CPUSET:
+		map = isV2 ? omrCgroupV2CpusetMetricMap : omrCgroupCpusetMetricMap;
+		count = isV2 ? (sizeof(omrCgroupV2CpusetMetricMap) / sizeof(omrCgroupV2CpusetMetricMap[0])) : (sizeof(omrCgroupCpusetMetricMap) / sizeof(omrCgroupCpusetMetricMap[0]));
+		break;
+	default:
+		break;
+	}
+	if (NULL != numElements) {
+		*numElements = count;
+	}
+	return map;
+}
+
 #endif /* defined(LINUX) && !defined(OMRZTPF) */
 
 BOOLEAN
@@ -4419,7 +4919,19 @@ omrsysinfo_cgroup_is_system_available(struct OMRPortLibrary *portLibrary)
 
 	Trc_PRT_sysinfo_cgroup_is_system_available_Entry();
 	if (NULL == PPG_cgroupEntryList) {
-		if (isCgroupV1Available(portLibrary)) {
+		if (isCgroupV2Available(portLibrary)) {
+			omrthread_monitor_enter(cgroupEntryListMonitor);
+			if (NULL == PPG_cgroupEntryList) {
+				rc = readCgroupV2Controllers(portLibrary, getpid(), &PPG_cgroupEntryList, &PPG_cgroupSubsystemsAvailable);
+				if (0 == rc) {
+					PPG_cgroupVersion = 2;
+				}
+			}
+			omrthread_monitor_exit(cgroupEntryListMonitor);
+			if (0 != rc) {
+				goto _end;
+			}
+		} else if (isCgroupV1Available(portLibrary)) {
 			BOOLEAN inContainer = FALSE;
 
 			rc = isRunningInContainer(portLibrary, &inContainer);
@@ -4429,6 +4941,9 @@ omrsysinfo_cgroup_is_system_available(struct OMRPortLibrary *portLibrary)
 			omrthread_monitor_enter(cgroupEntryListMonitor);
 			if (NULL == PPG_cgroupEntryList) {
 				rc = readCgroupFile(portLibrary, getpid(), inContainer, &PPG_cgroupEntryList, &PPG_cgroupSubsystemsAvailable);
+				if (0 == rc) {
+					PPG_cgroupVersion = 1;
+				}
 			}
 			omrthread_monitor_exit(cgroupEntryListMonitor);
 			if (0 != rc) {
@@ -4586,17 +5101,7 @@ omrsysinfo_cgroup_subsystem_iterator_init(struct OMRPortLibrary *portLibrary, ui
 	state->count = 0;
 	state->subsystemid = subsystem;
 	state->fileMetricCounter = 0;
-	switch (subsystem) {
-	case OMR_CGROUP_SUBSYSTEM_MEMORY :
-		 state->numElements = sizeof(omrCgroupMemoryMetricMap) / sizeof(omrCgroupMemoryMetricMap[0]);
-		 break;
-	case OMR_CGROUP_SUBSYSTEM_CPU :
-		 state->numElements = sizeof(omrCgroupCpuMetricMap) / sizeof(omrCgroupCpuMetricMap[0]);
-		 break;
-	case OMR_CGROUP_SUBSYSTEM_CPUSET :
-		 state->numElements = sizeof(omrCgroupCpusetMetricMap) / sizeof(omrCgroupCpusetMetricMap[0]);
-		 break;
-	default :
+	if (NULL == getCgroupSubsystemMetricMap(portLibrary, subsystem, &state->numElements)) {
 		goto _end;
 	}
 	rc = 0;
@@ -4622,18 +5127,8 @@ omrsysinfo_cgroup_subsystem_iterator_metricKey(struct OMRPortLibrary *portLibrar
 	int32_t rc = OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_METRIC_NOT_AVAILABLE;
 #if defined(LINUX) && !defined(OMRZTPF)
 	if (NULL != metricKey) {
-		const struct OMRCgroupSubsystemMetricMap *subsystemMetricMap = NULL;
-		switch (state->subsystemid) {
-		case OMR_CGROUP_SUBSYSTEM_MEMORY:
-			subsystemMetricMap = omrCgroupMemoryMetricMap;
-			break;
-		case OMR_CGROUP_SUBSYSTEM_CPU:
-			subsystemMetricMap = omrCgroupCpuMetricMap;
-			break;
-		case OMR_CGROUP_SUBSYSTEM_CPUSET:
-			subsystemMetricMap = omrCgroupCpusetMetricMap;
-			break;
-		default:
+		const struct OMRCgroupSubsystemMetricMap *subsystemMetricMap = getCgroupSubsystemMetricMap(portLibrary, state->subsystemid, NULL);
+		if (NULL == subsystemMetricMap) {
 			rc = OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE;
 			goto _end;
 		}
@@ -4660,17 +5155,8 @@ omrsysinfo_cgroup_subsystem_iterator_next(struct OMRPortLibrary *portLibrary, st
 	if (state->count >= state->numElements) {
 		goto _end;
 	}
-	switch (state->subsystemid) {
-	case OMR_CGROUP_SUBSYSTEM_MEMORY:
-		subsystemMetricMap = omrCgroupMemoryMetricMap;
-		break;
-	case OMR_CGROUP_SUBSYSTEM_CPU:
-		subsystemMetricMap = omrCgroupCpuMetricMap;
-		break;
-	case OMR_CGROUP_SUBSYSTEM_CPUSET:
-		subsystemMetricMap = omrCgroupCpusetMetricMap;
-		break;
-	default:
+	subsystemMetricMap = getCgroupSubsystemMetricMap(portLibrary, state->subsystemid, NULL);
+	if (NULL == subsystemMetricMap) {
 		rc = OMRPORT_ERROR_SYSINFO_CGROUP_SUBSYSTEM_UNAVAILABLE;
 		state->count += 1;
 		goto _end;
@@ -4748,7 +5234,8 @@ _end:
 		if (currentElement->isValueToBeChecked) {
 			int64_t result = 0;
 			sscanf(metricElement->value, "%" PRId64, &result);
-			if ((result > (MAX_DEFAULT_VALUE_CHECK)) || (result < 0)) {
+			/* cgroup v2 limits read "max" when not set */
+			if ((result > (MAX_DEFAULT_VALUE_CHECK)) || (result < 0) || (0 == strcmp(metricElement->value, "max"))) {
 				metricElement->units = NULL;
 				strcpy(metricElement->value, "Not Set");
 			}
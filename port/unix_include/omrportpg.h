@@ -88,6 +88,8 @@ typedef struct OMRPortPlatformGlobals {
 	uint64_t cgroupSubsystemsAvailable; /**< cgroup subsystems available for port library to use; it is valid only when cgroupEntryList is non-null */
 	uint64_t cgroupSubsystemsEnabled; /**< cgroup subsystems enabled in port library; it is valid only when cgroupEntryList is non-null */
 	OMRCgroupEntry *cgroupEntryList; /**< head of the circular linked list, each element contains information about cgroup of the process for a subsystem */
+	uint32_t cgroupVersion; /**< 1 or 2 for the cgroup v1 or unified (v2) hierarchy; it is valid only when cgroupEntryList is non-null */
+	char *cgroupRoot; /**< mount point of the unified hierarchy given by OMR_CGROUP_ROOT, or NULL to use /sys/fs/cgroup */
 	BOOLEAN syscallNotAllowed; /**< Assigned True if the mempolicy syscall is failed due to security opts (Can be seen in case of docker) */
 #endif /* defined(LINUX) */
 } OMRPortPlatformGlobals;
@@ -135,6 +137,8 @@ typedef struct OMRPortPlatformGlobals {
 #define PPG_cgroupSubsystemsAvailable (portLibrary->portGlobals->platformGlobals.cgroupSubsystemsAvailable)
 #define PPG_cgroupSubsystemsEnabled (portLibrary->portGlobals->platformGlobals.cgroupSubsystemsEnabled)
 #define PPG_cgroupEntryList (portLibrary->portGlobals->platformGlobals.cgroupEntryList)
+#define PPG_cgroupVersion (portLibrary->portGlobals->platformGlobals.cgroupVersion)
+#define PPG_cgroupRoot (portLibrary->portGlobals->platformGlobals.cgroupRoot)
 #define PPG_numaSyscallNotAllowed (portLibrary->portGlobals->platformGlobals.syscallNotAllowed)
 #endif /* defined(LINUX) */
 
@@ -39,6 +39,9 @@
 #define J9FILE_UNC_EXTENDED_LENGTH_PREFIX (L"\\\\?\\")
 #define J9FILE_UNC_EXTENDED_LENGTH_PREFIX_NETWORK (L"\\\\?\\UNC")
 
+/* Size of the buffer used by omrfile_copy_range */
+#define OMRFILE_COPY_BUFFER_SIZE (64 * 1024)
+
 /* Convert file descriptor to windows file handle.
  * OMRPORT_TTY_IN, OMRPORT_TTY_OUT and OMRPORT_TTY_ERR are handled as a special case because they don't
  * match UNIX standard stream file descriptors.
@@ -1104,3 +1107,161 @@ omrfile_convert_omrfile_fd_to_native_fd(struct OMRPortLibrary *portLibrary, intp
 {
 	return (intptr_t) toHandle(portLibrary, omrfileFD);
 }
+
+/**
+ * @internal
+ * Positional transfer with an OVERLAPPED offset. On a handle opened for
+ * synchronous I/O this also moves the file pointer.
+ */
+static intptr_t
+transferAtOffset(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes, int64_t offset, BOOLEAN isWrite)
+{
+	HANDLE handle = toHandle(portLibrary, fd);
+	OVERLAPPED overlapped;
+	DWORD transferred = 0;
+	BOOL success = FALSE;
+
+	if ((nbytes < 0) || (offset < 0)) {
+		return portLibrary->error_set_last_error(portLibrary, ERROR_INVALID_PARAMETER, OMRPORT_ERROR_FILE_INVAL);
+	}
+
+	memset(&overlapped, 0, sizeof(overlapped));
+	overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+	overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+	/* ReadFile and WriteFile limit a transfer to DWORD size, callers handle short transfers */
+	if (isWrite) {
+		success = WriteFile(handle, buf, (DWORD)OMR_MIN(nbytes, 0x7FFFFFFF), &transferred, &overlapped);
+	} else {
+		success = ReadFile(handle, buf, (DWORD)OMR_MIN(nbytes, 0x7FFFFFFF), &transferred, &overlapped);
+	}
+	if (FALSE == success) {
+		int32_t error = GetLastError();
+		if (!isWrite && (ERROR_HANDLE_EOF == error)) {
+			return 0;
+		}
+		return portLibrary->error_set_last_error(portLibrary, error, findError(error));
+	}
+	return (intptr_t)transferred;
+}
+
+/**
+ * @internal
+ * Vectored positional I/O: one call per buffer, stopping at the first short
+ * transfer. An error is only reported if it happens before any bytes were transferred.
+ */
+static intptr_t
+transferVectors(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset, BOOLEAN isWrite)
+{
+	intptr_t total = 0;
+	uint32_t i = 0;
+
+	if (offset < 0) {
+		return portLibrary->error_set_last_error(portLibrary, ERROR_INVALID_PARAMETER, OMRPORT_ERROR_FILE_INVAL);
+	}
+	for (i = 0; i < vectorCount; i++) {
+		intptr_t rc = transferAtOffset(portLibrary, fd, vectors[i].buffer, (intptr_t)vectors[i].length, offset + total, isWrite);
+		if (rc < 0) {
+			return (0 == total) ? rc : total;
+		}
+		total += rc;
+		if ((uintptr_t)rc < vectors[i].length) {
+			break;
+		}
+	}
+	return total;
+}
+
+intptr_t
+omrfile_pread(struct OMRPortLibrary *portLibrary, intptr_t fd, void *buf, intptr_t nbytes, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_pread_Entry(fd, buf, nbytes, offset);
+	result = transferAtOffset(portLibrary, fd, buf, nbytes, offset, FALSE);
+	Trc_PRT_file_pread_Exit(result);
+	return result;
+}
+
+intptr_t
+omrfile_pwrite(struct OMRPortLibrary *portLibrary, intptr_t fd, const void *buf, intptr_t nbytes, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_pwrite_Entry(fd, buf, nbytes, offset);
+	result = transferAtOffset(portLibrary, fd, (void *)buf, nbytes, offset, TRUE);
+	Trc_PRT_file_pwrite_Exit(result);
+	return result;
+}
+
+intptr_t
+omrfile_preadv(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_preadv_Entry(fd, vectors, vectorCount, offset);
+	result = transferVectors(portLibrary, fd, vectors, vectorCount, offset, FALSE);
+	Trc_PRT_file_preadv_Exit(result);
+	return result;
+}
+
+intptr_t
+omrfile_pwritev(struct OMRPortLibrary *portLibrary, intptr_t fd, const OMRFileIOVec *vectors, uint32_t vectorCount, int64_t offset)
+{
+	intptr_t result = 0;
+
+	Trc_PRT_file_pwritev_Entry(fd, vectors, vectorCount, offset);
+	result = transferVectors(portLibrary, fd, vectors, vectorCount, offset, TRUE);
+	Trc_PRT_file_pwritev_Exit(result);
+	return result;
+}
+
+int64_t
+omrfile_copy_range(struct OMRPortLibrary *portLibrary, intptr_t fdIn, int64_t offsetIn, intptr_t fdOut, int64_t offsetOut, int64_t length)
+{
+	int64_t copied = 0;
+	char *buffer = NULL;
+
+	Trc_PRT_file_copy_range_Entry(fdIn, offsetIn, fdOut, offsetOut, length);
+
+	if ((offsetIn < 0) || (offsetOut < 0) || (length < 0)) {
+		copied = portLibrary->error_set_last_error(portLibrary, ERROR_INVALID_PARAMETER, OMRPORT_ERROR_FILE_INVAL);
+		Trc_PRT_file_copy_range_Exit(copied);
+		return copied;
+	}
+	buffer = portLibrary->mem_allocate_memory(portLibrary, OMRFILE_COPY_BUFFER_SIZE, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_PORT_LIBRARY);
+	if (NULL == buffer) {
+		copied = portLibrary->error_set_last_error(portLibrary, ERROR_NOT_ENOUGH_MEMORY, OMRPORT_ERROR_FILE_OPFAILED);
+		Trc_PRT_file_copy_range_Exit(copied);
+		return copied;
+	}
+	while (copied < length) {
+		intptr_t chunk = (intptr_t)OMR_MIN(length - copied, (int64_t)OMRFILE_COPY_BUFFER_SIZE);
+		intptr_t bytesRead = transferAtOffset(portLibrary, fdIn, buffer, chunk, offsetIn + copied, FALSE);
+		intptr_t bytesWritten = 0;
+
+		if (bytesRead <= 0) {
+			if (bytesRead < 0) {
+				copied = bytesRead;
+			}
+			break;
+		}
+		while (bytesWritten < bytesRead) {
+			intptr_t rc = transferAtOffset(portLibrary, fdOut, buffer + bytesWritten, bytesRead - bytesWritten, offsetOut + copied + bytesWritten, TRUE);
+			if (rc < 0) {
+				bytesWritten = rc;
+				break;
+			}
+			bytesWritten += rc;
+		}
+		if (bytesWritten < 0) {
+			copied = bytesWritten;
+			break;
+		}
+		copied += bytesWritten;
+	}
+	portLibrary->mem_free_memory(portLibrary, buffer);
+
+	Trc_PRT_file_copy_range_Exit(copied);
+	return copied;
+}
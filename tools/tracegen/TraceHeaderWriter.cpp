@@ -127,6 +127,28 @@ const char *TP_TEMPLATE =
 "#define %s(%s%s)   /* tracepoint name: %s.%u */\n"
 "#endif\n\n";
 
+/* Tracepoint whose arguments are all fixed size. The arguments are packed into the
+ * layout that maximal trace writes to the buffer, so the trace engine only copies
+ * them. Output types other than minimal and maximal still use the varargs entry point.
+ */
+const char *TP_PACKED_TEMPLATE =
+"#if UT_TRACE_OVERHEAD >= %u\n"
+"%s" /* Place holder for option test macro (specified by "Test" option in tp spec) */
+"#define %s(%s%s) do { /* tracepoint name: %s.%u */ \\\n"
+"	if ((unsigned char) %s_UtActive[%u] != 0){ \\\n"
+"		if ((0 == (%s_UtActive[%u] & ~UT_TRACE_PACKED_OUTPUT)) && (NULL != %s_UtModuleInfo.intf->TracePacked)) { \\\n"
+"%s" /* Place holder for packed argument declarations */
+"%s" /* Place holder for packed argument copies */
+"			%s_UtModuleInfo.intf->TracePacked(%s, &%s_UtModuleInfo, ((%uu << 8) | %s_UtActive[%u]), UT_data, (uint32_t)sizeof(UT_data)); \\\n"
+"		} else { \\\n"
+"			%s_UtModuleInfo.intf->Trace(%s, &%s_UtModuleInfo, ((%uu << 8) | %s_UtActive[%u]), %s%s); \\\n"
+"		}} \\\n"
+"	} while(0)\n"
+"#else\n"
+"%s" /* Place holder for option test macro (specified by "Test" option in tp spec) */
+"#define %s(%s%s)   /* tracepoint name: %s.%u */\n"
+"#endif\n\n";
+
 RCType
 TraceHeaderWriter::writeOutputFiles(J9TDFOptions *options, J9TDFFile *tdf)
 {
@@ -214,6 +236,8 @@ TraceHeaderWriter::tpTemplate(FILE *fd, unsigned int overhead, unsigned int test
 	char *testNop =  NULL;
 	char *testMacroTemplate = (char *)  "#define TrcEnabled_%s  (%s_UtActive[%u] != 0)\n";
 	char *testNopTemplate = (char *) "#define TrcEnabled_%s  (0)\n";
+	char *packedDeclarations = NULL;
+	char *packedCopies = NULL;
 
 	parmString = (char *)Port::omrmem_calloc(1, (parmCount * sizeof(char) * 5) + 1);
 	if (NULL == parmString) {
@@ -252,6 +276,12 @@ TraceHeaderWriter::tpTemplate(FILE *fd, unsigned int overhead, unsigned int test
 		pos += sprintf(pos, ", P%u", i + 1);
 	}
 
+	if (!auxiliary) {
+		if (RC_OK != packedArguments(parameters, parmCount, &packedDeclarations, &packedCopies)) {
+			goto failed;
+		}
+	}
+
 	if (auxiliary) {
 		if (0 < fprintf(fd, TP_AUX_TEMPLATE
 				, overhead
@@ -279,6 +309,48 @@ TraceHeaderWriter::tpTemplate(FILE *fd, unsigned int overhead, unsigned int test
 			rc = RC_FAILED;
 			goto failed;
 		}
+	} else if (NULL != packedDeclarations) {
+		if (0 <= fprintf(fd, TP_PACKED_TEMPLATE
+				, overhead
+				, testMacro
+				, name
+				, envParam ? "thr" : ""
+				, envParam ? parmString : parmStringNoLeadingComma
+				, module
+				, id
+				, module
+				, id
+				, module
+				, id
+				, module
+				, packedDeclarations
+				, packedCopies
+				, module
+				, envParam ? UT_ENV_PARAM : UT_NOENV_PARAM
+				, module
+				, id
+				, module
+				, id
+				, module
+				, envParam ? UT_ENV_PARAM : UT_NOENV_PARAM
+				, module
+				, id
+				, module
+				, id
+				, parameters
+				, parmString
+				, testNop
+				, name
+				, envParam ? "thr" : ""
+				, envParam ? parmString : parmStringNoLeadingComma
+				, module
+				, id
+		)) {
+			rc = RC_OK;
+		} else {
+			rc = RC_FAILED;
+			goto failed;
+		}
 	} else {
 		if (0 <= fprintf(fd, TP_TEMPLATE
 				, overhead
@@ -313,6 +385,8 @@ TraceHeaderWriter::tpTemplate(FILE *fd, unsigned int overhead, unsigned int test
 	}
 
 	Port::omrmem_free((void **)&parmString);
+	Port::omrmem_free((void **)&packedDeclarations);
+	Port::omrmem_free((void **)&packedCopies);
 
 	if (test) {
 		Port::omrmem_free((void **)&testMacro);
@@ -323,6 +397,8 @@ TraceHeaderWriter::tpTemplate(FILE *fd, unsigned int overhead, unsigned int test
 
 failed:
 	Port::omrmem_free((void **)&parmString);
+	Port::omrmem_free((void **)&packedDeclarations);
+	Port::omrmem_free((void **)&packedCopies);
 
 	if (test) {
 		Port::omrmem_free((void **)&testMacro);
@@ -332,6 +408,106 @@ failed:
 	return rc;
 }
 
+/* Build the statements that pack a tracepoint's arguments for TracePacked.
+ * parameters is the quoted spec string generated by TDFParser, e.g. "\\4\\6".
+ * Each argument is converted to the type traceV would va_arg() for it and then
+ * truncated to the size traceV stores, so the packed bytes match maximal trace.
+ * Tracepoints without arguments, or with strings or long doubles, are not packed
+ * and leave *declarations and *copies NULL.
+ */
+RCType
+TraceHeaderWriter::packedArguments(const char *parameters, unsigned int parmCount, char **declarations, char **copies)
+{
+	const char *pos = parameters;
+	char *declPos = NULL;
+	char *copyPos = NULL;
+	/* Longest declaration: "\t\t\tunsigned short UT_p999 = (unsigned short)(P999); \\\n" */
+	const size_t declLength = 64;
+	/* Each argument adds " + sizeof(UT_p999)" to the offset of every later copy and to the data size. */
+	const size_t offsetLength = 18;
+
+	*declarations = NULL;
+	*copies = NULL;
+
+	if ((0 == parmCount) || (NULL == parameters) || ('"' != *pos)) {
+		return RC_OK;
+	}
+
+	/* Check that every argument has a fixed size before generating anything. */
+	for (pos = parameters + 1; '\\' == *pos;) {
+		char *end = NULL;
+		unsigned long type = strtoul(pos + 1, &end, 8);
+		switch (type) {
+		case 1: /* TRACE_DATA_TYPE_CHAR */
+		case 2: /* TRACE_DATA_TYPE_SHORT */
+		case 4: /* TRACE_DATA_TYPE_INT32 */
+		case 6: /* TRACE_DATA_TYPE_POINTER */
+		case 7: /* TRACE_DATA_TYPE_DOUBLE */
+		case 8: /* TRACE_DATA_TYPE_INT64 */
+			break;
+		default:
+			return RC_OK;
+		}
+		pos = end;
+	}
+	if ('"' != *pos) {
+		return RC_OK;
+	}
+
+	*declarations = (char *)Port::omrmem_calloc(1, (parmCount * (declLength + offsetLength)) + declLength + 1);
+	*copies = (char *)Port::omrmem_calloc(1, (parmCount * (declLength + (parmCount * offsetLength))) + 1);
+	if ((NULL == *declarations) || (NULL == *copies)) {
+		eprintf("Failed to allocate memory");
+		Port::omrmem_free((void **)declarations);
+		Port::omrmem_free((void **)copies);
+		return RC_FAILED;
+	}
+	declPos = *declarations;
+	copyPos = *copies;
+
+	pos = parameters + 1;
+	for (unsigned int i = 1; i <= parmCount; i++) {
+		char *end = NULL;
+		const char *type = NULL;
+		switch (strtoul(pos + 1, &end, 8)) {
+		case 1:
+			type = "char";
+			break;
+		case 2:
+			type = "unsigned short";
+			break;
+		case 4:
+			type = "int32_t";
+			break;
+		case 6:
+			type = "uintptr_t";
+			break;
+		case 7:
+			type = "double";
+			break;
+		default:
+			type = "int64_t";
+			break;
+		}
+		pos = end;
+
+		declPos += sprintf(declPos, "\t\t\t%s UT_p%u = (%s)(P%u); \\\n", type, i, type, i);
+		copyPos += sprintf(copyPos, "\t\t\tmemcpy(UT_data");
+		for (unsigned int j = 1; j < i; j++) {
+			copyPos += sprintf(copyPos, " + sizeof(UT_p%u)", j);
+		}
+		copyPos += sprintf(copyPos, ", &UT_p%u, sizeof(UT_p%u)); \\\n", i, i);
+	}
+
+	declPos += sprintf(declPos, "\t\t\tunsigned char UT_data[");
+	for (unsigned int i = 1; i <= parmCount; i++) {
+		declPos += sprintf(declPos, "%ssizeof(UT_p%u)", (1 == i) ? "" : " + ", i);
+	}
+	sprintf(declPos, "]; \\\n");
+
+	return RC_OK;
+}
+
 RCType
 TraceHeaderWriter::tpAssert(FILE *fd, unsigned int overhead, unsigned int test, const char *name, const char *module, unsigned int id, unsigned int envParam, const char *conditionStr, unsigned int parmCount)
 {
@@ -46,6 +46,17 @@ private:
 	 */
 	RCType tpTemplate(FILE *fd, unsigned int overhead, unsigned int test, const char *name, const char *module, unsigned int id, unsigned int envparam, const char *format, unsigned int formatParamCount, unsigned int auxiliary);
 
+	/**
+	 * Build the statements that pack a tracepoint's fixed-size arguments into
+	 * trace buffer layout
+	 * @param parameters Quoted argument spec generated by TDFParser
+	 * @param parmCount Number of arguments
+	 * @param declarations Set to the argument declarations, or NULL if the tracepoint can't be packed
+	 * @param copies Set to the copies into the packed data, or NULL if the tracepoint can't be packed
+	 * @return RC_OK on success, RC_FAILED on failure
+	 */
+	RCType packedArguments(const char *parameters, unsigned int parmCount, char **declarations, char **copies);
+
 	/**
 	 *  Output assertion
 	 *  @param fd Output stream
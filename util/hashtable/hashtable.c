@@ -72,6 +72,12 @@
  */
 #define ROUND_TO_SIZEOF_UDATA(number) (((number) + (sizeof(uintptr_t) - 1)) & (~(sizeof(uintptr_t) - 1)))
 
+/**
+ * Reader counters of concurrent read tables are spread over separate cache lines
+ */
+#define READER_COUNTER_STRIDE (64 / sizeof(uintptr_t))
+#define READER_COUNTERS_SIZE (2 * J9HASH_TABLE_READER_STRIPES * READER_COUNTER_STRIDE * sizeof(uintptr_t))
+
 static uint32_t hashTableNextSize(uint32_t size);
 static uintptr_t hashTableGrow(J9HashTable *table);
 static J9HashTable *hashTableNewImpl(OMRPortLibrary *portLibrary, const char *tableName,
@@ -92,6 +98,12 @@ static void rebuildFromPools(J9HashTable *table, uint32_t newSize, void **newNod
 static uintptr_t hashTableGrowSpaceOpt(J9HashTable *, uint32_t newSize);
 static uintptr_t hashTableGrowListNodes(J9HashTable *table, uint32_t newSize);
 static uintptr_t collisionResilientHashTableGrow(J9HashTable *table, uint32_t newSize);
+static void *hashTableFindConcurrent(J9HashTable *table, void *entry);
+static uintptr_t *concurrentReadEnter(J9HashTable *table);
+static void concurrentReadExit(uintptr_t *readerCount);
+static void concurrentSynchronize(J9HashTable *table);
+static void concurrentWriterLock(J9HashTable *table);
+static void concurrentWriterUnlock(J9HashTable *table);
 
 static const uint32_t primesTable[] = {
 	17,
@@ -180,7 +192,7 @@ comparatorToEqualFn(void *leftKey, void *rightKey, void *userData)
  *
  * In general, you should expect collisionResilientHashTable to be slower than a regular hashtable and use more memory.
  *
- *  J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION is not supported (will be ignored)
+ *  J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION, J9HASH_TABLE_OPEN_ADDRESSING and J9HASH_TABLE_CONCURRENT_READ are not supported (will be ignored)
  *
  */
 J9HashTable *
@@ -197,6 +209,7 @@ collisionResilientHashTableNew(
 	J9HashTablePrintFn printFn,
 	void *functionUserData)
 {
+	flags &= ~(J9HASH_TABLE_OPEN_ADDRESSING | J9HASH_TABLE_CONCURRENT_READ);
 	return hashTableNewImpl(portLibrary, tableName, tableSize, entrySize, sizeof(uintptr_t), flags | J9HASH_TABLE_COLLISION_RESILIENT, memoryCategory, listToTreeThreshold, hashFn, NULL, comparatorFn, printFn, functionUserData);
 }
 
@@ -235,6 +248,22 @@ collisionResilientHashTableNew(
  *  	hashTableRehash()
  *  	hashTableDoRemove()
  *
+ *  When J9HASH_TABLE_OPEN_ADDRESSING is set, the table is an open addressed table
+ *  of pointers to pool allocated entries, probed 16 slots at a time through a
+ *  parallel array of one-byte control words (see openhashtable.c). Entries do not
+ *  move when the table grows. The table size is rounded up to a power of two
+ *  and J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION is ignored.
+ *
+ *  When J9HASH_TABLE_CONCURRENT_READ is set, hashTableFind() may be called from any
+ *  number of threads without locking, concurrently with hashTableAdd() and
+ *  hashTableRemove(), which serialize on a lock internal to the table. Readers
+ *  announce themselves in per-epoch striped counters; a writer that unlinks a node
+ *  or replaces the bucket array waits for the readers of the previous epoch to
+ *  drain before the memory is reused. Lookups that overlap a grow or rehash and
+ *  miss are retried. Iteration and hashTableRehash() must not run concurrently
+ *  with writers. J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION and
+ *  J9HASH_TABLE_OPEN_ADDRESSING are ignored.
+ *
  */
 J9HashTable *
 hashTableNew(
@@ -271,8 +300,16 @@ hashTableNewImpl(
 {
 	J9HashTable *hashTable = NULL;
 	BOOLEAN spaceOpt = FALSE;
+	BOOLEAN openAddressing = FALSE;
+	BOOLEAN concurrentRead = (J9HASH_TABLE_CONCURRENT_READ == (flags & J9HASH_TABLE_CONCURRENT_READ));
 	HASHTABLE_DEBUG_PORT(portLibrary);
 
+	if (concurrentRead) {
+		/* lock-free readers rely on chained nodes that never move */
+		flags &= ~(J9HASH_TABLE_OPEN_ADDRESSING | J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION);
+	}
+	openAddressing = (J9HASH_TABLE_OPEN_ADDRESSING == (flags & J9HASH_TABLE_OPEN_ADDRESSING));
+
 	hashTable = portLibrary->mem_allocate_memory(portLibrary, sizeof(J9HashTable), tableName, memoryCategory);
 	hashTable_printf("hashTableNew <%s>: tableSize=%d, table=%p\n", tableName, tableSize, hashTable);
 	if (NULL == hashTable) {
@@ -302,7 +339,15 @@ hashTableNewImpl(
 
 	hashTable->entrySize = entrySize;
 	/* listNodeSize is sizeof user-data + a next-pointer */
-	if (entryAlignment) {
+	if (openAddressing) {
+		/* open addressed entries are not chained, so they need no next-pointer */
+		if (entryAlignment) {
+			hashTable->listNodeSize = ((ROUND_TO_SIZEOF_UDATA(entrySize) + entryAlignment - 1) / entryAlignment) * entryAlignment;
+		} else {
+			hashTable->listNodeSize = ROUND_TO_SIZEOF_UDATA(entrySize);
+		}
+		hashTable->treeNodeSize = 0;
+	} else if (entryAlignment) {
 		hashTable->listNodeSize = (((ROUND_TO_SIZEOF_UDATA(entrySize) + sizeof(uintptr_t)) + entryAlignment - 1) / entryAlignment) * entryAlignment;
 		hashTable->treeNodeSize = (((ROUND_TO_SIZEOF_UDATA(entrySize) + sizeof(J9AVLTreeNode)) + entryAlignment - 1) / entryAlignment) * entryAlignment;
 	} else {
@@ -312,6 +357,7 @@ hashTableNewImpl(
 	hashTable->nodeAlignment = entryAlignment;
 
 	if (J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION == ((flags & J9HASH_TABLE_ALLOW_SIZE_OPTIMIZATION))
+		&& (!openAddressing)
 		&& (hashTable->listNodeSize == (2 * sizeof(uintptr_t)))
 		&& (hashTable->tableSize <= SPACE_OPT_LIMIT)
 #if defined(OMR_ENV_DATA64)
@@ -377,13 +423,27 @@ hashTableNewImpl(
 		hashTable->hashEqualFn = hashEqualFn;
 	}
 
-	hashTable->nodes = portLibrary->mem_allocate_memory(portLibrary, sizeof(uintptr_t) * hashTable->tableSize, tableName, memoryCategory);
-	if (NULL == hashTable->nodes) {
-		goto error;
+	if (concurrentRead) {
+		hashTable->readerCounts = portLibrary->mem_allocate_memory(portLibrary, READER_COUNTERS_SIZE, tableName, memoryCategory);
+		if (NULL == hashTable->readerCounts) {
+			goto error;
+		}
+		memset(hashTable->readerCounts, 0, READER_COUNTERS_SIZE);
 	}
 
-	/* reset all the nodes */
-	memset(hashTable->nodes, 0, sizeof(uintptr_t) * hashTable->tableSize);
+	if (openAddressing) {
+		if (0 != openHashTableAllocate(hashTable, tableSize)) {
+			goto error;
+		}
+	} else {
+		hashTable->nodes = portLibrary->mem_allocate_memory(portLibrary, sizeof(uintptr_t) * hashTable->tableSize, tableName, memoryCategory);
+		if (NULL == hashTable->nodes) {
+			goto error;
+		}
+
+		/* reset all the nodes */
+		memset(hashTable->nodes, 0, sizeof(uintptr_t) * hashTable->tableSize);
+	}
 
 	return hashTable;
 
@@ -412,6 +472,12 @@ hashTableFree(J9HashTable *hashTable)
 		if (NULL != hashTable->nodes) {
 			omrmem_free_memory(hashTable->nodes);
 		}
+		if (NULL != hashTable->controlBytes) {
+			omrmem_free_memory(hashTable->controlBytes);
+		}
+		if (NULL != hashTable->readerCounts) {
+			omrmem_free_memory(hashTable->readerCounts);
+		}
 		if (NULL != hashTable->avlTreeTemplate) {
 			omrmem_free_memory(hashTable->avlTreeTemplate);
 		}
@@ -441,14 +507,24 @@ hashTableFree(J9HashTable *hashTable)
 void *
 hashTableFind(J9HashTable *table, void *entry)
 {
-	uintptr_t hash = table->hashFn(entry, table->hashFnUserData) % table->tableSize;
-	void **head = &table->nodes[hash];
+	uintptr_t hash = 0;
+	void **head = NULL;
 	void *findNode = NULL;
 	HASHTABLE_DEBUG_PORT(table->portLibrary);
 
 	hashTable_printf("hashTableFind <%s>: table=%p entry=%p\n", table->tableName, table, entry);
 
-	if (NULL == table->listNodePool) {
+	if (hashTableIsConcurrentRead(table)) {
+		/* tableSize and nodes may be replaced underneath us, so they are read with care */
+		return hashTableFindConcurrent(table, entry);
+	}
+
+	hash = table->hashFn(entry, table->hashFnUserData) % table->tableSize;
+	head = &table->nodes[hash];
+
+	if (hashTableIsOpenAddressed(table)) {
+		findNode = openHashTableFind(table, entry);
+	} else if (NULL == table->listNodePool) {
 		void **node = hashTableFindNodeSpaceOpt(table, entry, head);
 		findNode = (NULL != *node) ? node : NULL;
 	} else if (NULL == *head) {
@@ -486,6 +562,111 @@ hashTableFindNodeInList(J9HashTable *table, void *entry, void **head)
 }
 
 
+static void *
+hashTableFindConcurrent(J9HashTable *table, void *entry)
+{
+	uintptr_t hashCode = table->hashFn(entry, table->hashFnUserData);
+	uintptr_t *readerCount = concurrentReadEnter(table);
+	void *node = NULL;
+
+	for (;;) {
+		uintptr_t resizeCount = table->resizeCount;
+		uint32_t tableSize = 0;
+		void **nodes = NULL;
+
+		/* A grow publishes nodes before tableSize, so an old tableSize may be paired with the new
+		 * (larger) bucket array, but never the reverse.
+		 */
+		issueReadBarrier();
+		tableSize = table->tableSize;
+		issueReadBarrier();
+		nodes = table->nodes;
+
+		node = nodes[hashCode % tableSize];
+		while ((NULL != node) && (0 == table->hashEqualFn(node, entry, table->equalFnUserData))) {
+			node = NEXT(node);
+		}
+
+		/* A miss is only trustworthy if no grow or rehash relinked the chains while we walked them */
+		issueReadBarrier();
+		if ((NULL != node) || ((0 == (resizeCount & 1)) && (resizeCount == table->resizeCount))) {
+			break;
+		}
+	}
+
+	concurrentReadExit(readerCount);
+	return node;
+}
+
+/*
+ * Register the calling thread as a reader of the current epoch. Threads run on distinct
+ * stacks, so hashing a stack address spreads them over the counter stripes.
+ * Returns the counter to pass to concurrentReadExit().
+ */
+static uintptr_t *
+concurrentReadEnter(J9HashTable *table)
+{
+	uintptr_t stackAddress = (uintptr_t)&table;
+	uintptr_t stripe = ((((uint32_t)(stackAddress >> 16)) * (uint32_t)0x9E3779B1) >> 16) % J9HASH_TABLE_READER_STRIPES;
+
+	for (;;) {
+		uintptr_t epoch = table->readerEpoch;
+		uintptr_t *readerCount = &table->readerCounts[(((epoch & 1) * J9HASH_TABLE_READER_STRIPES) + stripe) * READER_COUNTER_STRIDE];
+
+		addAtomic(readerCount, 1);
+		issueReadWriteBarrier();
+		if (epoch == table->readerEpoch) {
+			return readerCount;
+		}
+		/* a writer flipped the epoch before it could see our count; register again in the new one */
+		subtractAtomic(readerCount, 1);
+	}
+}
+
+static void
+concurrentReadExit(uintptr_t *readerCount)
+{
+	issueReadWriteBarrier();
+	subtractAtomic(readerCount, 1);
+}
+
+/*
+ * Wait until every reader that may have observed the table before this call has finished.
+ * Must be called with the writer lock held.
+ */
+static void
+concurrentSynchronize(J9HashTable *table)
+{
+	uintptr_t oldEpoch = table->readerEpoch;
+	uintptr_t *readerCounts = NULL;
+	uintptr_t i = 0;
+
+	setAtomic(&table->readerEpoch, oldEpoch + 1);
+	issueReadWriteBarrier();
+
+	readerCounts = &table->readerCounts[(oldEpoch & 1) * J9HASH_TABLE_READER_STRIPES * READER_COUNTER_STRIDE];
+	for (i = 0; i < J9HASH_TABLE_READER_STRIPES; i++) {
+		while (0 != *(volatile uintptr_t *)&readerCounts[i * READER_COUNTER_STRIDE]) {
+			issueReadBarrier();
+		}
+	}
+}
+
+static void
+concurrentWriterLock(J9HashTable *table)
+{
+	while (0 != compareAndSwapUDATA(&table->writerLock, 0, 1)) {
+		issueReadBarrier();
+	}
+}
+
+static void
+concurrentWriterUnlock(J9HashTable *table)
+{
+	issueWriteBarrier();
+	table->writerLock = 0;
+}
+
 static void *
 hashTableFindNodeInTree(J9HashTable *table, void *entry, void **head)
 {
@@ -517,13 +698,23 @@ void *
 hashTableAdd(J9HashTable *table, void *entry)
 {
 	uintptr_t hashCode = table->hashFn(entry, table->hashFnUserData);
-	void **head = &table->nodes[hashCode % table->tableSize];
+	void **head = NULL;
 	void *addNode = NULL;
 	BOOLEAN growFailure = FALSE;
 	HASHTABLE_DEBUG_PORT(table->portLibrary);
 
 	hashTable_printf("hashTableAdd <%s>: table=%p entry=%p\n", table->tableName, table, entry);
 
+	if (hashTableIsOpenAddressed(table)) {
+		/* open addressed tables manage their own growth */
+		return openHashTableAdd(table, entry);
+	}
+
+	if (hashTableIsConcurrentRead(table)) {
+		concurrentWriterLock(table);
+	}
+	head = &table->nodes[hashCode % table->tableSize];
+
 	if ((table->numberOfNodes + 1) == table->tableSize) {
 		if (!hashTableCanGrow(table)) {
 			goto done;
@@ -550,6 +741,9 @@ hashTableAdd(J9HashTable *table, void *entry)
 		addNode = hashTableAddNodeInList(table, entry, head);
 	}
 done:
+	if (hashTableIsConcurrentRead(table)) {
+		concurrentWriterUnlock(table);
+	}
 	return addNode;
 }
 
@@ -595,7 +789,7 @@ hashTableAddNodeInList(J9HashTable *table, void *entry, void **head)
 			if (NULL != newNode) {
 				memcpy(newNode, entry, table->entrySize);
 				NEXT(newNode) = NULL;
-				if (!hashTableCanGrow(table)) {
+				if (!hashTableCanGrow(table) || hashTableIsConcurrentRead(table)) {
 					issueWriteBarrier();
 				}
 				*where = newNode;
@@ -702,14 +896,21 @@ listToTree(J9HashTable *table, void **head, uintptr_t listLength)
 uint32_t
 hashTableRemove(J9HashTable *table, void *entry)
 {
-	uintptr_t hash = table->hashFn(entry, table->hashFnUserData) % table->tableSize;
-	void **head = &table->nodes[hash];
+	uintptr_t hashCode = table->hashFn(entry, table->hashFnUserData);
+	void **head = NULL;
 	uint32_t rc = 1;
 	HASHTABLE_DEBUG_PORT(table->portLibrary);
 
 	hashTable_printf("hashTableRemove <%s>: table=%p, entry=%p\n", table->tableName, table, entry);
 
-	if (NULL == table->listNodePool) {
+	if (hashTableIsConcurrentRead(table)) {
+		concurrentWriterLock(table);
+	}
+	head = &table->nodes[hashCode % table->tableSize];
+
+	if (hashTableIsOpenAddressed(table)) {
+		rc = openHashTableRemove(table, entry);
+	} else if (NULL == table->listNodePool) {
 		rc = hashTableRemoveNodeSpaceOpt(table, entry, head);
 	} else if (NULL == *head) {
 		rc = 1;
@@ -719,6 +920,9 @@ hashTableRemove(J9HashTable *table, void *entry)
 		rc = hashTableRemoveNodeInList(table, entry, head);
 	}
 
+	if (hashTableIsConcurrentRead(table)) {
+		concurrentWriterUnlock(table);
+	}
 	return rc;
 }
 
@@ -775,6 +979,10 @@ hashTableRemoveNodeInList(J9HashTable *table, void *entry, void **head)
 	if (NULL != *node) {
 		void *nodeToRemove = *node;
 		*node = NEXT(*node);
+		if (hashTableIsConcurrentRead(table)) {
+			/* readers may still be walking through the unlinked node */
+			concurrentSynchronize(table);
+		}
 		pool_removeElement(table->listNodePool, nodeToRemove);
 		table->numberOfNodes -= 1;
 		rc = 0;
@@ -870,6 +1078,16 @@ hashTableRehash(J9HashTable *table)
 		Assert_hashTable_unreachable();
 	}
 
+	if (hashTableIsOpenAddressed(table)) {
+		openHashTableRehash(table);
+		return;
+	}
+
+	if (hashTableIsConcurrentRead(table)) {
+		/* make concurrent readers that miss while the chains are relinked retry */
+		addAtomic(&table->resizeCount, 1);
+	}
+
 	/* connect all the node-chains into one big chain */
 	for (i = 0; i < tableSize; i++) {
 		if (table->nodes[i]) {
@@ -897,6 +1115,10 @@ hashTableRehash(J9HashTable *table)
 		NEXT(node) = table->nodes[hash];
 		table->nodes[hash] = node;
 	}
+
+	if (hashTableIsConcurrentRead(table)) {
+		addAtomic(&table->resizeCount, 1);
+	}
 }
 
 static uintptr_t
@@ -1012,7 +1234,9 @@ hashTableStartDo(J9HashTable *table,  J9HashTableState *handle)
 	handle->didDeleteCurrentNode = FALSE;
 	handle->iterateState = J9HASH_TABLE_ITERATE_STATE_LIST_NODES;
 
-	if (NULL == table->listNodePool) {
+	if (hashTableIsOpenAddressed(table)) {
+		result = openHashTableStartDo(table, handle);
+	} else if (NULL == table->listNodePool) {
 		/* find the first non-empty bucket */
 		while (handle->bucketIndex < table->tableSize) {
 			void **node = &table->nodes[handle->bucketIndex];
@@ -1071,7 +1295,9 @@ hashTableNextDo(J9HashTableState *handle)
 	void *result = NULL;
 	HASHTABLE_DEBUG_PORT(table->portLibrary);
 
-	if (NULL == table->listNodePool) {
+	if (hashTableIsOpenAddressed(table)) {
+		result = openHashTableNextDo(handle);
+	} else if (NULL == table->listNodePool) {
 		/* space optimized hashTable - advance to the next bucket */
 		handle->bucketIndex += 1;
 		while (handle->bucketIndex < table->tableSize) {
@@ -1158,8 +1384,10 @@ hashTableDoRemove(J9HashTableState *handle)
 	uintptr_t rc = 1;
 	HASHTABLE_DEBUG_PORT(table->portLibrary);
 
-	/* operation not supported on a space optimized hashTable */
-	if (NULL == table->listNodePool) {
+	if (hashTableIsOpenAddressed(table)) {
+		rc = openHashTableDoRemove(handle);
+	} else if (NULL == table->listNodePool) {
+		/* operation not supported on a space optimized hashTable */
 		Assert_hashTable_unreachable();
 	} else {
 		void *currentNode = NULL;
@@ -1169,6 +1397,10 @@ hashTableDoRemove(J9HashTableState *handle)
 			currentNode = *(handle->pointerToCurrentNode);
 
 			*(handle->pointerToCurrentNode) = NEXT(currentNode);
+			if (hashTableIsConcurrentRead(table)) {
+				/* readers may still be walking through the unlinked node */
+				concurrentSynchronize(table);
+			}
 			pool_removeElement(table->listNodePool, currentNode);
 			handle->didDeleteCurrentNode = TRUE;
 			table->numberOfNodes -= 1;
@@ -1215,12 +1447,18 @@ hashTableGrowListNodes(J9HashTable *table, uint32_t newSize)
 
 	void **newNodes = table->portLibrary->mem_allocate_memory(table->portLibrary, sizeof(uintptr_t) * newSize, table->tableName, table->memoryCategory);
 	if (NULL != newNodes) {
+		void **oldNodes = table->nodes;
 		uint32_t i = 0;
 		uint32_t numberOfNodes = 0;
 
 		/* reset all the nodes */
 		memset(newNodes, 0, sizeof(uintptr_t) * newSize);
 
+		if (hashTableIsConcurrentRead(table)) {
+			/* make concurrent readers that miss while the chains are relinked retry */
+			addAtomic(&table->resizeCount, 1);
+		}
+
 		for (i = 0; i < table->tableSize; i++) {
 			void *node = table->nodes[i];
 			while (NULL != node) {
@@ -1232,9 +1470,20 @@ hashTableGrowListNodes(J9HashTable *table, uint32_t newSize)
 				numberOfNodes += 1;
 			}
 		}
-		omrmem_free_memory(table->nodes);
-		table->tableSize = newSize;
-		table->nodes = newNodes;
+		if (hashTableIsConcurrentRead(table)) {
+			/* publish the larger bucket array before its size, see hashTableFindConcurrent() */
+			issueWriteBarrier();
+			table->nodes = newNodes;
+			issueWriteBarrier();
+			table->tableSize = newSize;
+			addAtomic(&table->resizeCount, 1);
+			/* readers may still be indexing the old bucket array */
+			concurrentSynchronize(table);
+		} else {
+			table->tableSize = newSize;
+			table->nodes = newNodes;
+		}
+		omrmem_free_memory(oldNodes);
 		/* Sanity check to make sure that the old hash table had calculated the right number of nodes */
 		HASHTABLE_ASSERT(numberOfNodes == table->numberOfNodes);
 		rc = 0;
@@ -39,6 +39,83 @@
 extern "C" {
 #endif
 
+/* ---------------- openhashtable.c ---------------- */
+
+/**
+* @brief Allocate the slot and control byte arrays of an open addressed table
+* @param *table
+* @param tableSize requested number of entries
+* @return uintptr_t 0 on success, 1 on failure
+*/
+uintptr_t
+openHashTableAllocate(J9HashTable *table, uint32_t tableSize);
+
+
+/**
+* @brief
+* @param *table
+* @param *entry
+* @return void *
+*/
+void *
+openHashTableAdd(J9HashTable *table, void *entry);
+
+
+/**
+* @brief
+* @param *table
+* @param *entry
+* @return void *
+*/
+void *
+openHashTableFind(J9HashTable *table, void *entry);
+
+
+/**
+* @brief
+* @param *table
+* @param *entry
+* @return uint32_t
+*/
+uint32_t
+openHashTableRemove(J9HashTable *table, void *entry);
+
+
+/**
+* @brief
+* @param *table
+* @return void
+*/
+void
+openHashTableRehash(J9HashTable *table);
+
+
+/**
+* @brief
+* @param *table
+* @param *handle
+* @return void *
+*/
+void *
+openHashTableStartDo(J9HashTable *table, J9HashTableState *handle);
+
+
+/**
+* @brief
+* @param *handle
+* @return void *
+*/
+void *
+openHashTableNextDo(J9HashTableState *handle);
+
+
+/**
+* @brief
+* @param *handle
+* @return uintptr_t
+*/
+uintptr_t
+openHashTableDoRemove(J9HashTableState *handle);
 
 #ifdef __cplusplus
 }
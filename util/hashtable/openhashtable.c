@@ -0,0 +1,513 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/*
+ * file    : openhashtable.c
+ *
+ *  Open addressing back end for J9HashTable (J9HASH_TABLE_OPEN_ADDRESSING).
+ *
+ *  Entries still live in the table's listNodePool, so the addresses handed out
+ *  by hashTableAdd()/hashTableFind() remain stable across growth. The bucket
+ *  array (table->nodes) holds one pointer per slot and is paired with an array
+ *  of one-byte control words (table->controlBytes). A control byte is either
+ *  EMPTY, DELETED or holds the low 7 bits of the entry's mixed hash (H2). Lookups
+ *  compare GROUP_WIDTH control bytes at a time against H2 and only dereference
+ *  the slots whose control byte matches, so most probes never touch the entries.
+ *
+ *  The capacity is always a power of two no smaller than GROUP_WIDTH. The first
+ *  GROUP_WIDTH control bytes are mirrored past the end of the array so that a
+ *  group can be loaded from any slot index without wrapping.
+ */
+
+#include <string.h>
+#include "omrcfg.h"
+#include "hashtable_internal.h"
+#include "ut_hashtable.h"
+#include "omrutilbase.h"
+
+#if defined(OMR_ARCH_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define OPEN_HASH_TABLE_USE_SSE2
+#endif
+
+#define GROUP_WIDTH 16
+
+#define CTRL_EMPTY ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+#define CTRL_IS_FULL(c) (0 == ((c) & 0x80))
+
+#define OPEN_HASH_TABLE_CAPACITY_MIN GROUP_WIDTH
+#define OPEN_HASH_TABLE_CAPACITY_MAX ((uint32_t)1 << 30)
+#define OPEN_HASH_TABLE_NOT_FOUND UDATA_MAX
+
+/* maximum load factor (live entries plus tombstones) is 7/8 */
+#define GROWTH_LIMIT(capacity) ((capacity) - ((capacity) / 8))
+
+#define H1(hash) ((hash) >> 7)
+#define H2(hash) ((uint8_t)((hash) & 0x7F))
+
+static uintptr_t mixHash(J9HashTable *table, void *entry);
+static uint32_t groupMatch(const uint8_t *group, uint8_t value);
+static uint32_t groupMatchEmptyOrDeleted(const uint8_t *group);
+static uint32_t lowestSetBit(uint32_t mask);
+static uint32_t highestSetBit(uint32_t mask);
+static void setControlByte(J9HashTable *table, uintptr_t index, uint8_t value);
+static uintptr_t findSlot(J9HashTable *table, void *entry, uintptr_t hash);
+static uintptr_t findInsertSlot(J9HashTable *table, uintptr_t hash);
+static void eraseSlot(J9HashTable *table, uintptr_t index);
+static uintptr_t openHashTableResize(J9HashTable *table, uint32_t newCapacity);
+static void dropDeletedWithoutResize(J9HashTable *table);
+static uint32_t openHashTableCapacityFor(uint32_t tableSize);
+
+/*
+ * User hash functions are frequently the identity on a pointer or an integer. Both
+ * H1 (probe start) and H2 (control byte) are taken from the mixed value, so spread
+ * the input bits across the whole word first.
+ */
+static uintptr_t
+mixHash(J9HashTable *table, void *entry)
+{
+	uintptr_t hash = table->hashFn(entry, table->hashFnUserData);
+#if defined(OMR_ENV_DATA64)
+	hash *= (uintptr_t)J9CONST64(0x9E3779B97F4A7C15);
+	hash ^= hash >> 32;
+#else /* OMR_ENV_DATA64 */
+	hash *= (uintptr_t)0x9E3779B9;
+	hash ^= hash >> 16;
+#endif /* OMR_ENV_DATA64 */
+	return hash;
+}
+
+/* Returns a bit mask with bit i set if group[i] == value */
+static uint32_t
+groupMatch(const uint8_t *group, uint8_t value)
+{
+#if defined(OPEN_HASH_TABLE_USE_SSE2)
+	__m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)value), ctrl));
+#else /* OPEN_HASH_TABLE_USE_SSE2 */
+	uint32_t mask = 0;
+	uint32_t i = 0;
+	for (i = 0; i < GROUP_WIDTH; i++) {
+		if (value == group[i]) {
+			mask |= (uint32_t)1 << i;
+		}
+	}
+	return mask;
+#endif /* OPEN_HASH_TABLE_USE_SSE2 */
+}
+
+/* Returns a bit mask with bit i set if group[i] is EMPTY or DELETED */
+static uint32_t
+groupMatchEmptyOrDeleted(const uint8_t *group)
+{
+#if defined(OPEN_HASH_TABLE_USE_SSE2)
+	/* EMPTY and DELETED are the only control values with the sign bit set */
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else /* OPEN_HASH_TABLE_USE_SSE2 */
+	uint32_t mask = 0;
+	uint32_t i = 0;
+	for (i = 0; i < GROUP_WIDTH; i++) {
+		if (!CTRL_IS_FULL(group[i])) {
+			mask |= (uint32_t)1 << i;
+		}
+	}
+	return mask;
+#endif /* OPEN_HASH_TABLE_USE_SSE2 */
+}
+
+/* mask must be non-zero */
+static uint32_t
+lowestSetBit(uint32_t mask)
+{
+#if defined(__GNUC__)
+	return (uint32_t)__builtin_ctz(mask);
+#else /* __GNUC__ */
+	uint32_t bit = 0;
+	while (0 == (mask & 1)) {
+		mask >>= 1;
+		bit += 1;
+	}
+	return bit;
+#endif /* __GNUC__ */
+}
+
+/* mask must be non-zero */
+static uint32_t
+highestSetBit(uint32_t mask)
+{
+#if defined(__GNUC__)
+	return 31 - (uint32_t)__builtin_clz(mask);
+#else /* __GNUC__ */
+	uint32_t bit = 0;
+	while (0 != (mask >>= 1)) {
+		bit += 1;
+	}
+	return bit;
+#endif /* __GNUC__ */
+}
+
+static void
+setControlByte(J9HashTable *table, uintptr_t index, uint8_t value)
+{
+	table->controlBytes[index] = value;
+	if (index < GROUP_WIDTH) {
+		/* keep the mirrored copy past the end of the array in sync */
+		table->controlBytes[table->tableSize + index] = value;
+	}
+}
+
+/*
+ * Probe groups starting at H1 with a triangular stride. Since the capacity is a power
+ * of two, the sequence visits every group before repeating. The load factor limit
+ * guarantees that an EMPTY control byte is always reached.
+ */
+static uintptr_t
+findSlot(J9HashTable *table, void *entry, uintptr_t hash)
+{
+	uintptr_t mask = table->tableSize - 1;
+	uintptr_t pos = H1(hash) & mask;
+	uintptr_t stride = 0;
+	uint8_t h2 = H2(hash);
+
+#if defined(__GNUC__)
+	/* overlap the miss on the slot array with the one on the control bytes */
+	__builtin_prefetch(&table->nodes[pos]);
+#endif /* __GNUC__ */
+
+	for (;;) {
+		const uint8_t *group = &table->controlBytes[pos];
+		uint32_t match = groupMatch(group, h2);
+		while (0 != match) {
+			uintptr_t index = (pos + lowestSetBit(match)) & mask;
+			if (0 != table->hashEqualFn(table->nodes[index], entry, table->equalFnUserData)) {
+				return index;
+			}
+			match &= match - 1;
+		}
+		if (0 != groupMatch(group, CTRL_EMPTY)) {
+			return OPEN_HASH_TABLE_NOT_FOUND;
+		}
+		stride += GROUP_WIDTH;
+		pos = (pos + stride) & mask;
+	}
+}
+
+/* Find the first EMPTY or DELETED slot in the probe sequence for hash */
+static uintptr_t
+findInsertSlot(J9HashTable *table, uintptr_t hash)
+{
+	uintptr_t mask = table->tableSize - 1;
+	uintptr_t pos = H1(hash) & mask;
+	uintptr_t stride = 0;
+
+	for (;;) {
+		uint32_t match = groupMatchEmptyOrDeleted(&table->controlBytes[pos]);
+		if (0 != match) {
+			return (pos + lowestSetBit(match)) & mask;
+		}
+		stride += GROUP_WIDTH;
+		pos = (pos + stride) & mask;
+	}
+}
+
+static void
+eraseSlot(J9HashTable *table, uintptr_t index)
+{
+	uintptr_t mask = table->tableSize - 1;
+	uint32_t emptyBefore = groupMatch(&table->controlBytes[(index - GROUP_WIDTH) & mask], CTRL_EMPTY);
+	uint32_t emptyAfter = groupMatch(&table->controlBytes[index], CTRL_EMPTY);
+
+	/* If no window of GROUP_WIDTH slots covering index was ever completely non-empty, no probe
+	 * sequence can have continued past this slot, so it can go straight back to EMPTY.
+	 */
+	if ((0 != emptyBefore) && (0 != emptyAfter)
+		&& ((lowestSetBit(emptyAfter) + (GROUP_WIDTH - 1 - highestSetBit(emptyBefore))) < GROUP_WIDTH)
+	) {
+		setControlByte(table, index, CTRL_EMPTY);
+		table->growthLeft += 1;
+	} else {
+		setControlByte(table, index, CTRL_DELETED);
+	}
+	table->nodes[index] = NULL;
+	table->numberOfNodes -= 1;
+}
+
+static uint32_t
+openHashTableCapacityFor(uint32_t tableSize)
+{
+	uint32_t capacity = OPEN_HASH_TABLE_CAPACITY_MIN;
+
+	while ((capacity < OPEN_HASH_TABLE_CAPACITY_MAX) && (GROWTH_LIMIT(capacity) < tableSize)) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+
+uintptr_t
+openHashTableAllocate(J9HashTable *table, uint32_t tableSize)
+{
+	OMRPortLibrary *portLibrary = table->portLibrary;
+	uint32_t capacity = openHashTableCapacityFor(tableSize);
+
+	table->nodes = portLibrary->mem_allocate_memory(portLibrary, sizeof(uintptr_t) * capacity, table->tableName, table->memoryCategory);
+	if (NULL == table->nodes) {
+		return 1;
+	}
+	table->controlBytes = portLibrary->mem_allocate_memory(portLibrary, capacity + GROUP_WIDTH, table->tableName, table->memoryCategory);
+	if (NULL == table->controlBytes) {
+		return 1;
+	}
+	memset(table->nodes, 0, sizeof(uintptr_t) * capacity);
+	memset(table->controlBytes, CTRL_EMPTY, capacity + GROUP_WIDTH);
+	table->tableSize = capacity;
+	table->growthLeft = GROWTH_LIMIT(capacity);
+	return 0;
+}
+
+/* Rebuild the table into freshly allocated arrays of newCapacity slots. Returns 0 on success, 1 on failure. */
+static uintptr_t
+openHashTableResize(J9HashTable *table, uint32_t newCapacity)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(table->portLibrary);
+	void **oldNodes = table->nodes;
+	uint8_t *oldControlBytes = table->controlBytes;
+	uint32_t oldCapacity = table->tableSize;
+	uintptr_t rc = 1;
+
+	Trc_hashTable_openHashTableResize_Entry(table->tableName, table, oldCapacity, newCapacity, table->numberOfNodes);
+
+	table->nodes = NULL;
+	table->controlBytes = NULL;
+	if (0 == openHashTableAllocate(table, GROWTH_LIMIT(newCapacity))) {
+		uint32_t i = 0;
+
+		for (i = 0; i < oldCapacity; i++) {
+			if (CTRL_IS_FULL(oldControlBytes[i])) {
+				void *node = oldNodes[i];
+				uintptr_t hash = mixHash(table, node);
+				uintptr_t index = findInsertSlot(table, hash);
+				table->nodes[index] = node;
+				setControlByte(table, index, H2(hash));
+			}
+		}
+		table->growthLeft -= table->numberOfNodes;
+
+		omrmem_free_memory(oldNodes);
+		omrmem_free_memory(oldControlBytes);
+		rc = 0;
+	} else {
+		if (NULL != table->nodes) {
+			omrmem_free_memory(table->nodes);
+		}
+		table->nodes = oldNodes;
+		table->controlBytes = oldControlBytes;
+		table->tableSize = oldCapacity;
+	}
+
+	Trc_hashTable_openHashTableResize_Exit(rc);
+	return rc;
+}
+
+/*
+ * Rehash all entries in place, reclaiming every tombstone without allocating.
+ *
+ * All FULL slots are first marked DELETED (meaning "still to be placed") and all DELETED
+ * slots EMPTY. Each pending entry is then either left where it is, if its new position
+ * would be in the same probe group, moved into an EMPTY slot, or swapped with the pending
+ * entry occupying its target slot, which is then processed in turn.
+ */
+static void
+dropDeletedWithoutResize(J9HashTable *table)
+{
+	uintptr_t capacity = table->tableSize;
+	uintptr_t mask = capacity - 1;
+	uintptr_t i = 0;
+
+	for (i = 0; i < capacity; i++) {
+		uint8_t ctrl = table->controlBytes[i];
+		table->controlBytes[i] = CTRL_IS_FULL(ctrl) ? CTRL_DELETED : CTRL_EMPTY;
+	}
+	memcpy(&table->controlBytes[capacity], table->controlBytes, GROUP_WIDTH);
+
+	for (i = 0; i < capacity; i++) {
+		uintptr_t hash = 0;
+		uintptr_t probeStart = 0;
+		uintptr_t newIndex = 0;
+
+		if (CTRL_DELETED != table->controlBytes[i]) {
+			continue;
+		}
+		hash = mixHash(table, table->nodes[i]);
+		probeStart = H1(hash) & mask;
+		newIndex = findInsertSlot(table, hash);
+
+		if ((((newIndex - probeStart) & mask) / GROUP_WIDTH) == (((i - probeStart) & mask) / GROUP_WIDTH)) {
+			/* already in the first group the probe would reach */
+			setControlByte(table, i, H2(hash));
+		} else if (CTRL_EMPTY == table->controlBytes[newIndex]) {
+			setControlByte(table, newIndex, H2(hash));
+			table->nodes[newIndex] = table->nodes[i];
+			table->nodes[i] = NULL;
+			setControlByte(table, i, CTRL_EMPTY);
+		} else {
+			/* newIndex holds another pending entry: swap and reprocess slot i */
+			void *pending = table->nodes[newIndex];
+			setControlByte(table, newIndex, H2(hash));
+			table->nodes[newIndex] = table->nodes[i];
+			table->nodes[i] = pending;
+			i -= 1;
+		}
+	}
+
+	table->growthLeft = GROWTH_LIMIT(table->tableSize) - table->numberOfNodes;
+}
+
+void *
+openHashTableFind(J9HashTable *table, void *entry)
+{
+	uintptr_t index = findSlot(table, entry, mixHash(table, entry));
+
+	return (OPEN_HASH_TABLE_NOT_FOUND == index) ? NULL : table->nodes[index];
+}
+
+void *
+openHashTableAdd(J9HashTable *table, void *entry)
+{
+	uintptr_t hash = mixHash(table, entry);
+	uintptr_t index = findSlot(table, entry, hash);
+	void *newNode = NULL;
+
+	if (OPEN_HASH_TABLE_NOT_FOUND != index) {
+		/* found the entry in the table */
+		return table->nodes[index];
+	}
+
+	index = findInsertSlot(table, hash);
+	if ((0 == table->growthLeft) && (CTRL_EMPTY == table->controlBytes[index])) {
+		if (!hashTableCanGrow(table) || !hashTableCanRehash(table)) {
+			return NULL;
+		}
+		if (table->numberOfNodes <= (GROWTH_LIMIT(table->tableSize) / 2)) {
+			/* at least half of the used slots are tombstones, reclaim them at the current size */
+			dropDeletedWithoutResize(table);
+		} else if ((table->tableSize >= OPEN_HASH_TABLE_CAPACITY_MAX) || (0 != openHashTableResize(table, table->tableSize * 2))) {
+			return NULL;
+		}
+		index = findInsertSlot(table, hash);
+	}
+
+	newNode = pool_newElement(table->listNodePool);
+	if (NULL != newNode) {
+		memcpy(newNode, entry, table->entrySize);
+		table->nodes[index] = newNode;
+		if (CTRL_EMPTY == table->controlBytes[index]) {
+			table->growthLeft -= 1;
+		}
+		if (!hashTableCanGrow(table)) {
+			/* publish the slot before the control byte that makes it visible to readers */
+			issueWriteBarrier();
+		}
+		setControlByte(table, index, H2(hash));
+		table->numberOfNodes += 1;
+	}
+	return newNode;
+}
+
+uint32_t
+openHashTableRemove(J9HashTable *table, void *entry)
+{
+	uintptr_t index = findSlot(table, entry, mixHash(table, entry));
+	uint32_t rc = 1;
+
+	if (OPEN_HASH_TABLE_NOT_FOUND != index) {
+		void *nodeToRemove = table->nodes[index];
+		eraseSlot(table, index);
+		pool_removeElement(table->listNodePool, nodeToRemove);
+		rc = 0;
+	}
+	return rc;
+}
+
+void
+openHashTableRehash(J9HashTable *table)
+{
+	dropDeletedWithoutResize(table);
+}
+
+void *
+openHashTableStartDo(J9HashTable *table, J9HashTableState *handle)
+{
+	memset(handle, 0, sizeof(J9HashTableState));
+	handle->table = table;
+	handle->bucketIndex = 0;
+	handle->iterateState = J9HASH_TABLE_ITERATE_STATE_LIST_NODES;
+
+	while (handle->bucketIndex < table->tableSize) {
+		if (CTRL_IS_FULL(table->controlBytes[handle->bucketIndex])) {
+			handle->pointerToCurrentNode = &table->nodes[handle->bucketIndex];
+			return table->nodes[handle->bucketIndex];
+		}
+		handle->bucketIndex += 1;
+	}
+	handle->iterateState = J9HASH_TABLE_ITERATE_STATE_FINISHED;
+	return NULL;
+}
+
+void *
+openHashTableNextDo(J9HashTableState *handle)
+{
+	J9HashTable *table = handle->table;
+
+	if (J9HASH_TABLE_ITERATE_STATE_FINISHED == handle->iterateState) {
+		return NULL;
+	}
+
+	/* removing the current node never moves other entries, so always advance to the next slot */
+	handle->didDeleteCurrentNode = FALSE;
+	handle->bucketIndex += 1;
+	while (handle->bucketIndex < table->tableSize) {
+		if (CTRL_IS_FULL(table->controlBytes[handle->bucketIndex])) {
+			handle->pointerToCurrentNode = &table->nodes[handle->bucketIndex];
+			return table->nodes[handle->bucketIndex];
+		}
+		handle->bucketIndex += 1;
+	}
+	handle->iterateState = J9HASH_TABLE_ITERATE_STATE_FINISHED;
+	return NULL;
+}
+
+uintptr_t
+openHashTableDoRemove(J9HashTableState *handle)
+{
+	J9HashTable *table = handle->table;
+	uintptr_t rc = 1;
+
+	if ((J9HASH_TABLE_ITERATE_STATE_LIST_NODES == handle->iterateState) && (FALSE == handle->didDeleteCurrentNode)) {
+		void *nodeToRemove = table->nodes[handle->bucketIndex];
+		eraseSlot(table, handle->bucketIndex);
+		pool_removeElement(table->listNodePool, nodeToRemove);
+		handle->didDeleteCurrentNode = TRUE;
+		rc = 0;
+	}
+	return rc;
+}
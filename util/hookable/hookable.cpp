@@ -31,6 +31,22 @@
 #include "ut_j9hook.h"
 #include "omrtrace.h"
 
+/*
+ * Dispatching from snapshots needs compiler supported thread-local storage for the dispatch
+ * slots below. On other platforms no snapshots are published and dispatch walks the records.
+ */
+#if defined(OMR_OS_WINDOWS)
+#define HOOK_THREAD_LOCAL __declspec(thread)
+#include <windows.h>
+#elif (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || defined(AIXPPC)
+#define HOOK_THREAD_LOCAL __thread
+#include <pthread.h>
+#if defined(LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif /* defined(LINUX) */
+#endif
+
 extern "C" {
 
 static void J9HookUnregister(struct J9HookInterface **hookInterface, uintptr_t taggedEventNum, J9HookFunction function, void *userData);
@@ -43,6 +59,14 @@ static void J9HookDispatch(struct J9HookInterface **hookInterface, uintptr_t tag
 static intptr_t J9HookReserve(struct J9HookInterface **hookInterface, uintptr_t taggedEventNum);
 static uintptr_t J9HookAllocateAgentID(struct J9HookInterface **hookInterface);
 static void J9HookDeallocateAgentID(struct J9HookInterface **hookInterface, uintptr_t agentID);
+static void J9HookPublishSnapshot(J9CommonHookInterface *commonInterface, uintptr_t eventNum);
+static void J9HookReclaimSnapshots(J9CommonHookInterface *commonInterface);
+static void J9HookFreeSnapshots(J9CommonHookInterface *commonInterface, J9HookSnapshot *snapshot);
+#if defined(HOOK_THREAD_LOCAL)
+static void J9HookEnableProcessBarrier(void);
+static void J9HookProcessBarrier(void);
+#endif /* defined(HOOK_THREAD_LOCAL) */
+static void J9HookCallListener(struct J9HookInterface **hookInterface, uintptr_t eventNum, void *eventData, OMREventInfo4Dump *eventDump, uintptr_t samplingInterval, J9HookRecord *record, J9HookFunction function, void *userData);
 
 static const J9HookInterface hookFunctionTable = {
 	J9HookDispatch,
@@ -86,6 +110,58 @@ static const J9HookInterface hookFunctionTable = {
 #define HOOK_INVALID_ID(id) ((id) | 1)
 #define HOOK_VALID_ID(id) ( (((id) | 1) + 1) )
 
+/*
+ * Each thread which dispatches from snapshots claims a dispatch slot, shared by all hook
+ * interfaces. The sequence number of the slot is odd while the thread is dispatching from a
+ * snapshot, so that J9HookReclaimSnapshots can tell which dispatches may still read a retired
+ * snapshot. A thread only ever stores to its own slot. Rather than fencing those stores on every
+ * dispatch, the registering thread issues a process-wide memory barrier (membarrier on Linux,
+ * FlushProcessWriteBuffers on Windows) before it reads the slots. Where no such barrier is
+ * available, dispatch fences its own slot instead.
+ *
+ * Slots are padded so that the fields written by different threads never share a cache line.
+ * A thread which finds no free slot walks the records.
+ */
+#if defined(HOOK_THREAD_LOCAL)
+#define HOOK_DISPATCH_SLOTS 512
+#define HOOK_DISPATCH_SLOT_SIZE 128
+
+typedef struct J9HookDispatchSlot {
+	volatile uintptr_t owner;	/* non-zero once claimed by a thread */
+	volatile uintptr_t sequence;	/* odd while the owner is dispatching from a snapshot */
+	uintptr_t depth;	/* nesting depth of the owner's dispatches */
+	uint8_t padding[HOOK_DISPATCH_SLOT_SIZE - (3 * sizeof(uintptr_t))];
+} J9HookDispatchSlot;
+
+static J9HookDispatchSlot hookDispatchSlots[HOOK_DISPATCH_SLOTS];
+/* one more than the highest slot ever claimed */
+static volatile uintptr_t hookDispatchSlotCount = 0;
+static HOOK_THREAD_LOCAL J9HookDispatchSlot *hookDispatchSlot;
+static HOOK_THREAD_LOCAL uintptr_t hookDispatchSlotClaimed;
+
+#define HOOK_PROCESS_BARRIER_NONE 0
+#define HOOK_PROCESS_BARRIER_READY 1
+#define HOOK_PROCESS_BARRIER_FENCE 2
+static volatile uintptr_t hookProcessBarrierState = HOOK_PROCESS_BARRIER_NONE;
+
+#if defined(LINUX) && defined(__NR_membarrier)
+#define HOOK_MEMBARRIER_CMD_PRIVATE_EXPEDITED (1 << 3)
+#define HOOK_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED (1 << 4)
+#endif /* defined(LINUX) && defined(__NR_membarrier) */
+
+/* Key whose destructor releases the dispatch slot of each terminating thread which claimed one. */
+#define HOOK_DISPATCH_EXIT_KEY_NONE 0
+#define HOOK_DISPATCH_EXIT_KEY_CREATING 1
+#define HOOK_DISPATCH_EXIT_KEY_READY 2
+#define HOOK_DISPATCH_EXIT_KEY_FAILED 3
+static uintptr_t hookDispatchExitKeyState = HOOK_DISPATCH_EXIT_KEY_NONE;
+#if defined(OMR_OS_WINDOWS)
+static DWORD hookDispatchExitKey;
+#else /* defined(OMR_OS_WINDOWS) */
+static pthread_key_t hookDispatchExitKey;
+#endif /* defined(OMR_OS_WINDOWS) */
+#endif /* defined(HOOK_THREAD_LOCAL) */
+
 
 intptr_t
 omrhook_lib_control(const char *key, uintptr_t value)
@@ -144,6 +220,23 @@ J9HookInitializeInterface(struct J9HookInterface **hookInterface, OMRPortLibrary
 	commonInterface->threshold4Trace = OMRHOOK_DEFAULT_THRESHOLD_IN_MILLISECONDS_WARNING_CALLBACK_ELAPSED_TIME;
 
 	commonInterface->eventSize = (interfaceSize - sizeof(J9CommonHookInterface)) / (sizeof(U_8) + sizeof(OMREventInfo4Dump) + sizeof(J9HookRecord*));
+
+#if defined(HOOK_THREAD_LOCAL)
+	if (0 != commonInterface->eventSize) {
+		OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+		uintptr_t snapshotsSize = commonInterface->eventSize * sizeof(J9HookSnapshot *);
+
+		commonInterface->snapshots = (J9HookSnapshot **)omrmem_allocate_memory(snapshotsSize, OMRMEM_CATEGORY_VM);
+		if (NULL == commonInterface->snapshots) {
+			J9HookShutdownInterface(hookInterface);
+			return J9HOOK_ERR_NOMEM;
+		}
+		memset(commonInterface->snapshots, 0, snapshotsSize);
+
+		/* dispatch must know whether to fence its slot before it can read a snapshot of this interface */
+		J9HookEnableProcessBarrier();
+	}
+#endif /* defined(HOOK_THREAD_LOCAL) */
 	return 0;
 }
 
@@ -164,6 +257,427 @@ J9HookShutdownInterface(struct J9HookInterface **hookInterface)
 	if (commonInterface->pool) {
 		pool_kill(commonInterface->pool);
 	}
+
+	if (NULL != commonInterface->snapshots) {
+		OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
+		uintptr_t eventNum = 0;
+
+		for (eventNum = 0; eventNum < commonInterface->eventSize; eventNum++) {
+			omrmem_free_memory(commonInterface->snapshots[eventNum]);
+		}
+		J9HookFreeSnapshots(commonInterface, commonInterface->retiredSnapshots);
+		J9HookFreeSnapshots(commonInterface, commonInterface->drainingSnapshots);
+		omrmem_free_memory(commonInterface->drainingWaits);
+		omrmem_free_memory(commonInterface->snapshots);
+		commonInterface->snapshots = NULL;
+		commonInterface->retiredSnapshots = NULL;
+		commonInterface->drainingSnapshots = NULL;
+		commonInterface->drainingWaits = NULL;
+		commonInterface->drainingWaitCount = 0;
+	}
+}
+
+/*
+ * Free a list of retired snapshots.
+ */
+static void
+J9HookFreeSnapshots(J9CommonHookInterface *commonInterface, J9HookSnapshot *snapshot)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
+
+	while (NULL != snapshot) {
+		J9HookSnapshot *next = snapshot->nextRetired;
+		omrmem_free_memory(snapshot);
+		snapshot = next;
+	}
+}
+
+#if defined(HOOK_THREAD_LOCAL)
+/*
+ * Find out once whether a process-wide memory barrier is available for J9HookProcessBarrier.
+ * If it is not, every dispatch fences its own slot instead.
+ */
+static void
+J9HookEnableProcessBarrier(void)
+{
+	if (HOOK_PROCESS_BARRIER_NONE == hookProcessBarrierState) {
+		uintptr_t state = HOOK_PROCESS_BARRIER_FENCE;
+
+#if defined(OMR_OS_WINDOWS)
+		state = HOOK_PROCESS_BARRIER_READY;
+#elif defined(LINUX) && defined(__NR_membarrier) /* defined(OMR_OS_WINDOWS) */
+		if (0 == syscall(__NR_membarrier, HOOK_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0)) {
+			state = HOOK_PROCESS_BARRIER_READY;
+		}
+#endif /* defined(OMR_OS_WINDOWS) */
+		/* racing initializations reach the same answer */
+		hookProcessBarrierState = state;
+		VM_AtomicSupport::readWriteBarrier();
+	}
+}
+
+/*
+ * Order the calling thread's preceding accesses before its later ones, and the accesses of
+ * every other thread before the next access it makes. Unless dispatch fences its slot, this is
+ * what makes the dispatch slot stores of other threads visible to J9HookReclaimSnapshots.
+ */
+static void
+J9HookProcessBarrier(void)
+{
+	VM_AtomicSupport::readWriteBarrier();
+	if (HOOK_PROCESS_BARRIER_READY == hookProcessBarrierState) {
+#if defined(OMR_OS_WINDOWS)
+		FlushProcessWriteBuffers();
+#elif defined(LINUX) && defined(__NR_membarrier) /* defined(OMR_OS_WINDOWS) */
+		syscall(__NR_membarrier, HOOK_MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+#endif /* defined(OMR_OS_WINDOWS) */
+	}
+}
+
+/*
+ * Give up the dispatch slot of the calling thread, leaving it to the next thread which needs one.
+ * The slot keeps its sequence number, so that a retired snapshot is never kept waiting for the
+ * next owner's dispatches, nor freed under them.
+ */
+static void
+J9HookReleaseDispatchSlot(void)
+{
+	J9HookDispatchSlot *slot = hookDispatchSlot;
+
+	if (NULL != slot) {
+		if (0 != (slot->sequence & 1)) {
+			slot->sequence += 1;
+		}
+		slot->depth = 0;
+		VM_AtomicSupport::writeBarrier();
+		slot->owner = 0;
+	}
+	/* a later thread-exit destructor which dispatches an event claims a slot again */
+	hookDispatchSlot = NULL;
+	hookDispatchSlotClaimed = FALSE;
+}
+
+#if defined(OMR_OS_WINDOWS)
+static VOID WINAPI
+J9HookDispatchExitKeyDestructor(PVOID value)
+{
+	if (NULL != value) {
+		J9HookReleaseDispatchSlot();
+	}
+}
+#else /* defined(OMR_OS_WINDOWS) */
+static void
+J9HookDispatchExitKeyDestructor(void *value)
+{
+	J9HookReleaseDispatchSlot();
+}
+#endif /* defined(OMR_OS_WINDOWS) */
+
+/*
+ * Claim a dispatch slot for the calling thread, and make sure it is released when the thread
+ * terminates. A thread only looks for a slot once, so when all of them are in use it walks the
+ * records from then on.
+ *
+ * Returns the slot, or NULL if none is free.
+ */
+static J9HookDispatchSlot *
+J9HookClaimDispatchSlot(void)
+{
+	uintptr_t slotIndex = 0;
+
+	hookDispatchSlotClaimed = TRUE;
+
+	for (slotIndex = 0; slotIndex < HOOK_DISPATCH_SLOTS; slotIndex++) {
+		J9HookDispatchSlot *slot = &hookDispatchSlots[slotIndex];
+
+		if ((0 == slot->owner) && (0 == VM_AtomicSupport::lockCompareExchange(&slot->owner, 0, 1))) {
+			uintptr_t count = hookDispatchSlotCount;
+			uintptr_t state = HOOK_DISPATCH_EXIT_KEY_NONE;
+
+			/* the slot must be visible to J9HookReclaimSnapshots before the first dispatch from it */
+			while ((count <= slotIndex) && (count != VM_AtomicSupport::lockCompareExchange(&hookDispatchSlotCount, count, slotIndex + 1))) {
+				count = hookDispatchSlotCount;
+			}
+
+			for (;;) {
+				state = hookDispatchExitKeyState;
+				if (HOOK_DISPATCH_EXIT_KEY_NONE == state) {
+					if (HOOK_DISPATCH_EXIT_KEY_NONE == VM_AtomicSupport::lockCompareExchange(&hookDispatchExitKeyState, HOOK_DISPATCH_EXIT_KEY_NONE, HOOK_DISPATCH_EXIT_KEY_CREATING)) {
+#if defined(OMR_OS_WINDOWS)
+						hookDispatchExitKey = FlsAlloc(J9HookDispatchExitKeyDestructor);
+						state = (FLS_OUT_OF_INDEXES != hookDispatchExitKey) ? HOOK_DISPATCH_EXIT_KEY_READY : HOOK_DISPATCH_EXIT_KEY_FAILED;
+#else /* defined(OMR_OS_WINDOWS) */
+						state = (0 == pthread_key_create(&hookDispatchExitKey, J9HookDispatchExitKeyDestructor)) ? HOOK_DISPATCH_EXIT_KEY_READY : HOOK_DISPATCH_EXIT_KEY_FAILED;
+#endif /* defined(OMR_OS_WINDOWS) */
+						VM_AtomicSupport::writeBarrier();
+						hookDispatchExitKeyState = state;
+						break;
+					}
+				} else if (HOOK_DISPATCH_EXIT_KEY_CREATING != state) {
+					break;
+				}
+				VM_AtomicSupport::readBarrier();
+			}
+
+			if (HOOK_DISPATCH_EXIT_KEY_READY == state) {
+				/* without the key, the slot of a terminated thread is never reused */
+#if defined(OMR_OS_WINDOWS)
+				FlsSetValue(hookDispatchExitKey, (PVOID)slot);
+#else /* defined(OMR_OS_WINDOWS) */
+				pthread_setspecific(hookDispatchExitKey, (void *)slot);
+#endif /* defined(OMR_OS_WINDOWS) */
+			}
+			hookDispatchSlot = slot;
+			return slot;
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Order the dispatch slot stores against the snapshot reads of a dispatch. When the registering
+ * thread can issue a process-wide barrier, only the compiler needs to be stopped from reordering.
+ */
+static VMINLINE void
+J9HookDispatchSlotBarrier(void)
+{
+	if (HOOK_PROCESS_BARRIER_FENCE == hookProcessBarrierState) {
+		VM_AtomicSupport::readWriteBarrier();
+	} else {
+		VM_AtomicSupport::compilerReorderingBarrier();
+	}
+}
+
+/*
+ * Mark the calling thread as dispatching from snapshots. Only the outermost of nested dispatches
+ * changes the sequence number.
+ *
+ * Returns the thread's dispatch slot, or NULL if it has none and must walk the records.
+ */
+static VMINLINE J9HookDispatchSlot *
+J9HookEnterSnapshotDispatch(void)
+{
+	J9HookDispatchSlot *slot = hookDispatchSlot;
+
+	if ((NULL == slot) && !hookDispatchSlotClaimed) {
+		slot = J9HookClaimDispatchSlot();
+	}
+	if (NULL != slot) {
+		if (0 == slot->depth) {
+			slot->sequence += 1;
+			J9HookDispatchSlotBarrier();
+		}
+		slot->depth += 1;
+	}
+	return slot;
+}
+
+/*
+ * Mark the end of a dispatch started by J9HookEnterSnapshotDispatch.
+ */
+static VMINLINE void
+J9HookExitSnapshotDispatch(J9HookDispatchSlot *slot)
+{
+	slot->depth -= 1;
+	if (0 == slot->depth) {
+		/* all reads of the snapshot must complete before it can be freed */
+		J9HookDispatchSlotBarrier();
+		slot->sequence += 1;
+	}
+}
+#endif /* defined(HOOK_THREAD_LOCAL) */
+
+/*
+ * Free the snapshots which no dispatch can still be reading. The dispatches in progress when
+ * snapshots are retired are recorded by their slot and sequence number, and the snapshots are
+ * moved to the draining list. They are freed once each of those slots has moved on, so a steady
+ * stream of new dispatches does not hold reclamation off. A dispatch which never returns keeps
+ * the draining snapshots alive, but never blocks registration.
+ *
+ * All of the cost is paid here rather than in J9HookDispatch: up to two process-wide barriers
+ * and a scan of the dispatch slots.
+ *
+ * The caller must hold the interface lock.
+ */
+static void
+J9HookReclaimSnapshots(J9CommonHookInterface *commonInterface)
+{
+#if defined(HOOK_THREAD_LOCAL)
+	OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
+	J9HookDispatchWait *waits = NULL;
+	uintptr_t waitCount = 0;
+	bool retire = false;
+	uintptr_t i = 0;
+
+	if ((NULL == commonInterface->retiredSnapshots) && (NULL == commonInterface->drainingSnapshots)) {
+		return;
+	}
+
+	/* the retired snapshots must be unpublished before the dispatch slots are read */
+	J9HookProcessBarrier();
+
+	for (i = 0; i < commonInterface->drainingWaitCount; i++) {
+		J9HookDispatchWait *wait = &commonInterface->drainingWaits[i];
+
+		if (hookDispatchSlots[wait->slot].sequence == wait->sequence) {
+			return;
+		}
+	}
+
+	if (NULL != commonInterface->retiredSnapshots) {
+		uintptr_t slotCount = hookDispatchSlotCount;
+
+		if (0 != slotCount) {
+			waits = (J9HookDispatchWait *)omrmem_allocate_memory(slotCount * sizeof(J9HookDispatchWait), OMRMEM_CATEGORY_VM);
+		}
+		/* without memory for the waits, the retired snapshots are kept for the next attempt */
+		if ((0 == slotCount) || (NULL != waits)) {
+			for (i = 0; i < slotCount; i++) {
+				uintptr_t sequence = hookDispatchSlots[i].sequence;
+
+				if (0 != (sequence & 1)) {
+					waits[waitCount].slot = i;
+					waits[waitCount].sequence = sequence;
+					waitCount += 1;
+				}
+			}
+			retire = true;
+		}
+	}
+
+	/* a dispatch seen to have returned must have finished reading its snapshot before it is freed */
+	J9HookProcessBarrier();
+
+	J9HookFreeSnapshots(commonInterface, commonInterface->drainingSnapshots);
+	omrmem_free_memory(commonInterface->drainingWaits);
+	commonInterface->drainingSnapshots = NULL;
+	commonInterface->drainingWaits = NULL;
+	commonInterface->drainingWaitCount = 0;
+
+	if (retire) {
+		if (0 == waitCount) {
+			J9HookFreeSnapshots(commonInterface, commonInterface->retiredSnapshots);
+			omrmem_free_memory(waits);
+		} else {
+			commonInterface->drainingSnapshots = commonInterface->retiredSnapshots;
+			commonInterface->drainingWaits = waits;
+			commonInterface->drainingWaitCount = waitCount;
+		}
+		commonInterface->retiredSnapshots = NULL;
+	}
+#endif /* defined(HOOK_THREAD_LOCAL) */
+}
+
+/*
+ * Build an immutable copy of the valid listeners of eventNum and publish it for J9HookDispatch.
+ * The previous snapshot may still be in use by a dispatching thread, so it is retired, and freed
+ * by J9HookReclaimSnapshots once no such dispatch remains. If no memory is available, or no
+ * listener remains, the snapshot is cleared and dispatch walks the records instead.
+ *
+ * The caller must hold the interface lock.
+ */
+static void
+J9HookPublishSnapshot(J9CommonHookInterface *commonInterface, uintptr_t eventNum)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
+	J9HookSnapshot *oldSnapshot = NULL;
+	J9HookSnapshot *newSnapshot = NULL;
+	J9HookRecord *record = NULL;
+	uintptr_t count = 0;
+
+	if ((NULL == commonInterface->snapshots) || (eventNum >= commonInterface->eventSize)) {
+		return;
+	}
+
+	for (record = HOOK_RECORD(commonInterface, eventNum); NULL != record; record = record->next) {
+		if (HOOK_IS_VALID_ID(record->id)) {
+			count += 1;
+		}
+	}
+
+	if (0 != count) {
+		newSnapshot = (J9HookSnapshot *)omrmem_allocate_memory(sizeof(J9HookSnapshot) + ((count - 1) * sizeof(J9HookSnapshotEntry)), OMRMEM_CATEGORY_VM);
+		if (NULL != newSnapshot) {
+			J9HookSnapshotEntry *entry = newSnapshot->entries;
+
+			newSnapshot->nextRetired = NULL;
+			newSnapshot->count = count;
+			for (record = HOOK_RECORD(commonInterface, eventNum); NULL != record; record = record->next) {
+				if (HOOK_IS_VALID_ID(record->id)) {
+					entry->record = record;
+					entry->id = record->id;
+					entry->function = record->function;
+					entry->userData = record->userData;
+					entry += 1;
+				}
+			}
+		}
+	}
+
+	/* the snapshot contents must be visible before the snapshot itself */
+	VM_AtomicSupport::writeBarrier();
+
+	oldSnapshot = commonInterface->snapshots[eventNum];
+	commonInterface->snapshots[eventNum] = newSnapshot;
+	if (NULL != oldSnapshot) {
+		oldSnapshot->nextRetired = commonInterface->retiredSnapshots;
+		commonInterface->retiredSnapshots = oldSnapshot;
+	}
+
+	J9HookReclaimSnapshots(commonInterface);
+}
+
+/*
+ * Invoke a single listener, recording its duration in the event's dump information when sampled.
+ */
+static void
+J9HookCallListener(struct J9HookInterface **hookInterface, uintptr_t eventNum, void *eventData, OMREventInfo4Dump *eventDump, uintptr_t samplingInterval, J9HookRecord *record, J9HookFunction function, void *userData)
+{
+	J9CommonHookInterface *commonInterface = (J9CommonHookInterface *)hookInterface;
+	uint64_t startTime = 0;
+	uintptr_t count = 0;
+	bool sampling = false;
+
+	if (NULL != eventDump) {
+		count = VM_AtomicSupport::add((volatile uintptr_t *)&eventDump->count, 1);
+		sampling = (1 >= samplingInterval) || ((100 >= samplingInterval) && (0 == (count % samplingInterval)));
+	}
+	OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
+	if (sampling) {
+		startTime = omrtime_current_time_millis();
+	}
+
+	function(hookInterface, eventNum, eventData, userData);
+
+	if (sampling) {
+		uint64_t timeDelta = omrtime_current_time_millis() - startTime;
+
+		eventDump->lastHook.startTime = startTime;
+		eventDump->lastHook.callsite = record->callsite;
+		eventDump->lastHook.func_ptr = (void *)function;
+		eventDump->lastHook.duration = timeDelta;
+
+		if ((eventDump->longestHook.duration < timeDelta) ||
+			(0 == eventDump->longestHook.startTime)) {
+				eventDump->longestHook.startTime = startTime;
+				eventDump->longestHook.callsite = record->callsite;
+				eventDump->longestHook.func_ptr = (void *)function;
+				eventDump->longestHook.duration = timeDelta;
+		}
+
+		if (commonInterface->threshold4Trace <= timeDelta) {
+			const char *callsite = "UNKNOWN";
+			char buffer[32];
+			if (NULL != record->callsite) {
+				callsite = record->callsite;
+			} else {
+				/* if the callsite info can not be retrieved, use callback function pointer instead  */
+				omrstr_printf(buffer, sizeof(buffer), "0x%p", function);
+				callsite = buffer;
+			}
+			Trc_Hook_Dispatch_Exceed_Threshold_Event(callsite, timeDelta);
+		}
+	}
 }
 
 
@@ -175,6 +689,10 @@ J9HookShutdownInterface(struct J9HookInterface **hookInterface)
  * before the listeners are informed. Any attempts to add listeners to a TAG_ONCE event
  * once it has been reported will fail.
  *
+ * Listeners are normally taken from the event's published snapshot, so that dispatch is a
+ * single load followed by a loop of indirect calls. Listeners registered while a dispatch is
+ * in progress are not informed by that dispatch.
+ *
  * This function should not be called directly. It should be called through the hook interface
  *
  */
@@ -183,10 +701,9 @@ J9HookDispatch(struct J9HookInterface **hookInterface, uintptr_t taggedEventNum,
 {
 	uintptr_t eventNum = taggedEventNum & J9HOOK_EVENT_NUM_MASK;
 	J9CommonHookInterface *commonInterface = (J9CommonHookInterface *)hookInterface;
-	J9HookRecord *record = HOOK_RECORD(commonInterface, eventNum);
+	J9HookRecord *record = NULL;
 	OMREventInfo4Dump *eventDump = J9HOOK_DUMPINFO(commonInterface, eventNum);
 	uintptr_t samplingInterval = (taggedEventNum & J9HOOK_TAG_SAMPLING_MASK) >> 16;
-	bool sampling = false;
 
 	if (taggedEventNum & J9HOOK_TAG_ONCE) {
 		uint8_t oldFlags;
@@ -203,6 +720,37 @@ J9HookDispatch(struct J9HookInterface **hookInterface, uintptr_t taggedEventNum,
 		}
 	}
 
+#if defined(HOOK_THREAD_LOCAL)
+	if ((NULL != commonInterface->snapshots) && (eventNum < commonInterface->eventSize)) {
+		J9HookDispatchSlot *slot = J9HookEnterSnapshotDispatch();
+
+		if (NULL != slot) {
+			J9HookSnapshot *snapshot = ((J9HookSnapshot * volatile *)commonInterface->snapshots)[eventNum];
+			if (NULL != snapshot) {
+				uintptr_t i = 0;
+
+				/* ensure that the snapshot is read before its contents */
+				VM_AtomicSupport::readBarrier();
+
+				for (i = 0; i < snapshot->count; i++) {
+					J9HookSnapshotEntry *entry = &snapshot->entries[i];
+
+					/* skip listeners which have been unregistered since the snapshot was published */
+					if (entry->record->id == entry->id) {
+						J9HookCallListener(hookInterface, eventNum, eventData, eventDump, samplingInterval, entry->record, entry->function, entry->userData);
+					}
+				}
+			}
+			J9HookExitSnapshotDispatch(slot);
+
+			if (NULL != snapshot) {
+				return;
+			}
+		}
+	}
+#endif /* defined(HOOK_THREAD_LOCAL) */
+
+	record = HOOK_RECORD(commonInterface, eventNum);
 	while (record) {
 		J9HookFunction function;
 		void *userData;
@@ -219,50 +767,7 @@ J9HookDispatch(struct J9HookInterface **hookInterface, uintptr_t taggedEventNum,
 			/* now read the id again to make sure that nothing has changed */
 			VM_AtomicSupport::readBarrier();
 			if (record->id == id) {
-				uint64_t startTime = 0;
-				uintptr_t count = 0;
-				if (NULL != eventDump) {
-					count = VM_AtomicSupport::add((volatile uintptr_t *)&eventDump->count, 1);
-					sampling = (1 >= samplingInterval) || ((100 >= samplingInterval) && (0 == (count % samplingInterval)));
-				} else {
-					sampling =  false;
-				}
-				OMRPORT_ACCESS_FROM_OMRPORT(commonInterface->portLib);
-				if (sampling) {
-					startTime = omrtime_current_time_millis();
-				}
-
-				function(hookInterface, eventNum, eventData, userData);
-
-				if (sampling) {
-					uint64_t timeDelta = omrtime_current_time_millis() - startTime;
-
-					eventDump->lastHook.startTime = startTime;
-					eventDump->lastHook.callsite = record->callsite;
-					eventDump->lastHook.func_ptr = (void *)record->function;
-					eventDump->lastHook.duration = timeDelta;
-
-					if ((eventDump->longestHook.duration < timeDelta) ||
-						(0 == eventDump->longestHook.startTime)) {
-							eventDump->longestHook.startTime = startTime;
-							eventDump->longestHook.callsite = record->callsite;
-							eventDump->longestHook.func_ptr = (void *)record->function;
-							eventDump->longestHook.duration = timeDelta;
-					}
-
-					if (commonInterface->threshold4Trace <= timeDelta) {
-						const char *callsite = "UNKNOWN";
-						char buffer[32];
-						if (NULL != record->callsite) {
-							callsite = record->callsite;
-						} else {
-							/* if the callsite info can not be retrieved, use callback function pointer instead  */
-							omrstr_printf(buffer, sizeof(buffer), "0x%p", record->function);
-							callsite = buffer;
-						}
-						Trc_Hook_Dispatch_Exceed_Threshold_Event(callsite, timeDelta);
-					}
-				}
+				J9HookCallListener(hookInterface, eventNum, eventData, eventDump, samplingInterval, record, function, userData);
 			} else {
 				/* this record has been updated while we were reading it. Skip it. */
 			}
@@ -399,6 +904,7 @@ J9HookRegisterWithCallSitePrivate(struct J9HookInterface **hookInterface, uintpt
 
 			emptyRecord->id = HOOK_VALID_ID(emptyRecord->id);
 
+			J9HookPublishSnapshot(commonInterface, eventNum);
 			HOOK_FLAGS(commonInterface, eventNum) |= J9HOOK_FLAG_HOOKED | J9HOOK_FLAG_RESERVED;
 		} else {
 			record = (J9HookRecord *)pool_newElement(commonInterface->pool);
@@ -425,6 +931,7 @@ J9HookRegisterWithCallSitePrivate(struct J9HookInterface **hookInterface, uintpt
 					insertionPoint->next = record;
 				}
 
+				J9HookPublishSnapshot(commonInterface, eventNum);
 				HOOK_FLAGS(commonInterface, eventNum) |= J9HOOK_FLAG_HOOKED | J9HOOK_FLAG_RESERVED;
 			}
 		}
@@ -552,6 +1059,10 @@ J9HookUnregister(struct J9HookInterface **hookInterface, uintptr_t taggedEventNu
 		HOOK_FLAGS(commonInterface, eventNum) &= ~J9HOOK_FLAG_HOOKED;
 	}
 
+	if (hooksRemoved != 0) {
+		J9HookPublishSnapshot(commonInterface, eventNum);
+	}
+
 	omrthread_monitor_exit(commonInterface->lock);
 
 	if (hooksRemoved != 0) {
@@ -54,6 +54,171 @@ struct IHAPSA {
 static int isZ10orGreater = -1;
 #endif
 
+#if defined(OMR_ARCH_X86) && defined(OMR_ENV_DATA64) && (defined(__GNUC__) || defined(_MSC_VER))
+#define OMR_ZERO_MEMORY_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ZERO_TARGET_AVX2
+#else /* defined(_MSC_VER) */
+#include <cpuid.h>
+#define ZERO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif /* defined(_MSC_VER) */
+
+/* Below this size memset is used directly; from it on, rep stosb is used when the CPU has enhanced rep movsb/stosb (ERMS) */
+#define ZERO_REP_STOSB_THRESHOLD 2048
+/* From this size on, streaming stores are used so the cleared memory does not displace the cache contents */
+#define ZERO_NON_TEMPORAL_THRESHOLD ((uintptr_t)8 * 1024 * 1024)
+
+#define ZERO_FEATURES_DETECTED 0x1
+#define ZERO_FEATURE_AVX2 0x2
+#define ZERO_FEATURE_ERMS 0x4
+static uint32_t zeroMemoryFeatures = 0;
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define OMR_ZERO_MEMORY_AARCH64
+
+/* Below this size memset is used directly */
+#define ZERO_SMALL_THRESHOLD 2048
+/* DC ZVA block size in bytes, 1 if DC ZVA is prohibited, 0 if not yet known */
+static uintptr_t zeroBlockSize = 0;
+#endif
+
+#if defined(OMR_ZERO_MEMORY_X86_64)
+/**
+ * Query the CPU features used to pick a zeroing strategy.
+ *
+ * @return a mask of ZERO_FEATURE_* flags, including ZERO_FEATURES_DETECTED
+ */
+static uint32_t
+detectZeroMemoryFeatures(void)
+{
+	uint32_t features = ZERO_FEATURES_DETECTED;
+	uint32_t maxLeaf = 0;
+	uint32_t leaf1ecx = 0;
+	uint32_t leaf7ebx = 0;
+	uint64_t xcr0 = 0;
+#if defined(_MSC_VER)
+	int regs[4];
+
+	__cpuid(regs, 0);
+	maxLeaf = (uint32_t)regs[0];
+	if (maxLeaf >= 7) {
+		__cpuid(regs, 1);
+		leaf1ecx = (uint32_t)regs[2];
+		__cpuidex(regs, 7, 0);
+		leaf7ebx = (uint32_t)regs[1];
+	}
+#else /* defined(_MSC_VER) */
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	maxLeaf = __get_cpuid_max(0, NULL);
+	if (maxLeaf >= 7) {
+		__cpuid(1, eax, ebx, ecx, edx);
+		leaf1ecx = ecx;
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		leaf7ebx = ebx;
+	}
+#endif /* defined(_MSC_VER) */
+
+	/* AVX2 is usable only if the OS saves the YMM state: OSXSAVE and AVX set, and XCR0 enables XMM and YMM */
+	if ((leaf1ecx & (1 << 27)) && (leaf1ecx & (1 << 28))) {
+#if defined(_MSC_VER)
+		xcr0 = _xgetbv(0);
+#else /* defined(_MSC_VER) */
+		uint32_t xcr0Low = 0;
+		uint32_t xcr0High = 0;
+		__asm__ __volatile__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+		xcr0 = ((uint64_t)xcr0High << 32) | xcr0Low;
+#endif /* defined(_MSC_VER) */
+		if ((6 == (xcr0 & 6)) && (leaf7ebx & (1 << 5))) {
+			features |= ZERO_FEATURE_AVX2;
+		}
+	}
+	if (leaf7ebx & (1 << 9)) {
+		features |= ZERO_FEATURE_ERMS;
+	}
+
+	return features;
+}
+
+/**
+ * Zero memory with 32-byte AVX2 non-temporal stores. length must be at least 128.
+ */
+static void ZERO_TARGET_AVX2
+zeroMemoryAVX2NonTemporal(uint8_t *addr, uintptr_t length)
+{
+	__m256i zero = _mm256_setzero_si256();
+	uint8_t *end = addr + length;
+	uint8_t *limit = NULL;
+
+	/* Zero the unaligned head, then continue from the next 32 byte boundary */
+	_mm256_storeu_si256((__m256i *)addr, zero);
+	addr = (uint8_t *)(((uintptr_t)addr + 32) & ~(uintptr_t)31);
+	limit = addr + ((uintptr_t)(end - addr) & ~(uintptr_t)127);
+
+	for (; addr < limit; addr += 128) {
+		_mm256_stream_si256((__m256i *)addr, zero);
+		_mm256_stream_si256((__m256i *)(addr + 32), zero);
+		_mm256_stream_si256((__m256i *)(addr + 64), zero);
+		_mm256_stream_si256((__m256i *)(addr + 96), zero);
+	}
+	/* Order the streaming stores before any later store, e.g. one publishing the memory */
+	_mm_sfence();
+
+	/* Zero the tail with (possibly overlapping) unaligned stores */
+	if (addr < end) {
+		_mm256_storeu_si256((__m256i *)(end - 128), zero);
+		_mm256_storeu_si256((__m256i *)(end - 96), zero);
+		_mm256_storeu_si256((__m256i *)(end - 64), zero);
+		_mm256_storeu_si256((__m256i *)(end - 32), zero);
+	}
+	_mm256_zeroupper();
+}
+
+/**
+ * Zero memory with 16-byte SSE2 non-temporal stores. length must be at least 64.
+ */
+static void
+zeroMemorySSE2NonTemporal(uint8_t *addr, uintptr_t length)
+{
+	__m128i zero = _mm_setzero_si128();
+	uint8_t *end = addr + length;
+	uint8_t *limit = NULL;
+
+	_mm_storeu_si128((__m128i *)addr, zero);
+	addr = (uint8_t *)(((uintptr_t)addr + 16) & ~(uintptr_t)15);
+	limit = addr + ((uintptr_t)(end - addr) & ~(uintptr_t)63);
+
+	for (; addr < limit; addr += 64) {
+		_mm_stream_si128((__m128i *)addr, zero);
+		_mm_stream_si128((__m128i *)(addr + 16), zero);
+		_mm_stream_si128((__m128i *)(addr + 32), zero);
+		_mm_stream_si128((__m128i *)(addr + 48), zero);
+	}
+	_mm_sfence();
+
+	if (addr < end) {
+		_mm_storeu_si128((__m128i *)(end - 64), zero);
+		_mm_storeu_si128((__m128i *)(end - 48), zero);
+		_mm_storeu_si128((__m128i *)(end - 32), zero);
+		_mm_storeu_si128((__m128i *)(end - 16), zero);
+	}
+}
+
+static void
+zeroMemoryRepStosb(void *ptr, uintptr_t length)
+{
+#if defined(_MSC_VER)
+	__stosb((unsigned char *)ptr, 0, (size_t)length);
+#else /* defined(_MSC_VER) */
+	__asm__ __volatile__("rep stosb" : "+D"(ptr), "+c"(length) : "a"(0) : "memory");
+#endif /* defined(_MSC_VER) */
+}
+#endif /* defined(OMR_ZERO_MEMORY_X86_64) */
+
 void
 OMRZeroMemory(void *ptr, uintptr_t length)
 {
@@ -153,6 +318,66 @@ OMRZeroMemory(void *ptr, uintptr_t length)
 #else
 	memset(ptr, 0, (size_t)length);
 #endif
+#elif defined(OMR_ZERO_MEMORY_X86_64)
+	uint32_t features = zeroMemoryFeatures;
+
+	if (length < ZERO_REP_STOSB_THRESHOLD) {
+		memset(ptr, 0, (size_t)length);
+		return;
+	}
+
+	/* one-time-only detection of CPU features */
+	if (0 == features) {
+		features = detectZeroMemoryFeatures();
+		zeroMemoryFeatures = features;
+	}
+
+	if (length >= ZERO_NON_TEMPORAL_THRESHOLD) {
+		/* Large areas (e.g. TLHs and heap batch clearing) bypass the cache */
+		if (features & ZERO_FEATURE_AVX2) {
+			zeroMemoryAVX2NonTemporal((uint8_t *)ptr, length);
+		} else {
+			zeroMemorySSE2NonTemporal((uint8_t *)ptr, length);
+		}
+	} else if (features & ZERO_FEATURE_ERMS) {
+		zeroMemoryRepStosb(ptr, length);
+	} else {
+		memset(ptr, 0, (size_t)length);
+	}
+#elif defined(OMR_ZERO_MEMORY_AARCH64)
+	uint8_t *addr = (uint8_t *)ptr;
+	uint8_t *limit = NULL;
+	uintptr_t blockSize = zeroBlockSize;
+
+	/* one-time-only query of the DC ZVA block size */
+	if (0 == blockSize) {
+		uint64_t dczid = 0;
+
+		__asm__ __volatile__("mrs %0, dczid_el0" : "=r"(dczid));
+		if (dczid & 0x10) {
+			/* DZP: DC ZVA is prohibited */
+			blockSize = 1;
+		} else {
+			/* BS is log2 of the block size in 4 byte words */
+			blockSize = (uintptr_t)4 << (dczid & 0xF);
+		}
+		zeroBlockSize = blockSize;
+	}
+
+	if ((1 == blockSize) || (length < ZERO_SMALL_THRESHOLD) || (length < (2 * blockSize))) {
+		memset(ptr, 0, (size_t)length);
+		return;
+	}
+
+	/* Zero up to the first block boundary, then whole blocks with DC ZVA, then the remainder */
+	limit = (uint8_t *)(((uintptr_t)addr + blockSize - 1) & ~(blockSize - 1));
+	memset(addr, 0, (size_t)(limit - addr));
+	addr = limit;
+	limit = (uint8_t *)(((uintptr_t)ptr + length) & ~(blockSize - 1));
+	for (; addr < limit; addr += blockSize) {
+		__asm__ __volatile__("dc zva, %0" : /* no outputs */ : "r"(addr) : "memory");
+	}
+	memset(addr, 0, (size_t)(((uint8_t *)ptr + length) - addr));
 #elif defined(J9ZOS390)
 
 	if (((struct IHAPSA *)0)->FLCFGIEF) {
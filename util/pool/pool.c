@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "omrutilbase.h"
 #include "pool_internal.h"
 #include "ut_pool.h"
 
@@ -50,6 +51,60 @@
 #define HOLE_FREQUENCY	16
 #define ELEMENT_IS_HOLE(pool, element) (((pool)->flags & POOL_USES_HOLES) && ((uintptr_t) (element) % ((pool)->elementSize*HOLE_FREQUENCY) == 0))
 
+/*
+ * Thread-local magazines (POOL_THREAD_MAGAZINES) need compiler supported thread-local storage.
+ * On other platforms the flag is ignored and the pool behaves as an ordinary pool.
+ */
+#if defined(OMR_OS_WINDOWS)
+#define POOL_THREAD_LOCAL __declspec(thread)
+#include <windows.h>
+#elif (defined(LINUX) && !defined(OMRZTPF)) || defined(OSX) || defined(AIXPPC)
+#define POOL_THREAD_LOCAL __thread
+#include <pthread.h>
+#endif
+
+/* Number of elements moved between a magazine and the puddles in one locked operation. */
+#define POOL_MAGAZINE_BATCH (POOL_MAGAZINE_SIZE / 2)
+/* Number of pools for which a thread remembers its magazine without taking the pool lock. */
+#define POOL_MAGAZINE_CACHE_ENTRIES 4
+
+#if defined(POOL_THREAD_LOCAL)
+typedef struct J9PoolMagazineCacheEntry {
+	uintptr_t poolId;
+	J9PoolMagazine *magazine;
+} J9PoolMagazineCacheEntry;
+
+static POOL_THREAD_LOCAL J9PoolMagazineCacheEntry poolMagazineCache[POOL_MAGAZINE_CACHE_ENTRIES];
+static POOL_THREAD_LOCAL uintptr_t poolMagazineCacheVictim;
+static POOL_THREAD_LOCAL uintptr_t poolMagazineExitArmed;
+static volatile uintptr_t poolMagazineNextId = 0;
+
+/* All magazine pools, so that a terminating thread can give back the elements in its magazines. */
+static uintptr_t poolMagazineRegistryLock = 0;
+static J9Pool *poolMagazinePools = NULL;
+
+/* Key whose destructor runs poolMagazine_threadExit as each thread that used a magazine terminates. */
+#define POOL_MAGAZINE_EXIT_KEY_NONE 0
+#define POOL_MAGAZINE_EXIT_KEY_CREATING 1
+#define POOL_MAGAZINE_EXIT_KEY_READY 2
+#define POOL_MAGAZINE_EXIT_KEY_FAILED 3
+static uintptr_t poolMagazineExitKeyState = POOL_MAGAZINE_EXIT_KEY_NONE;
+#if defined(OMR_OS_WINDOWS)
+static DWORD poolMagazineExitKey;
+#else /* defined(OMR_OS_WINDOWS) */
+static pthread_key_t poolMagazineExitKey;
+#endif /* defined(OMR_OS_WINDOWS) */
+
+/* A thread is identified by the address of its thread-local magazine cache. */
+#define POOL_MAGAZINE_SELF() ((uintptr_t)poolMagazineCache)
+
+static void poolMagazine_register(J9Pool *pool);
+static void poolMagazine_unregister(J9Pool *pool);
+#endif /* defined(POOL_THREAD_LOCAL) */
+
+static void *poolPuddle_takeFreeSlot(J9Pool *pool, J9PoolPuddleList *puddleList, J9PoolPuddle **puddleOut);
+static void poolPuddle_returnFreeSlot(J9Pool *pool, J9PoolPuddleList *puddleList, J9PoolPuddle *puddle, void *anElement, uintptr_t elementsInUse);
+
 /**
  * Get a pointer to the SRP to the puddle, given a puddle element.
  *
@@ -130,6 +185,7 @@ poolPuddle_init(J9Pool *pool, J9PoolPuddle *puddle)
 	bitlength = POOL_PUDDLE_BITS_LEN(pool);
 	NNSRP_SET(puddle->firstElementAddress, COMPUTE_FIRST_ELEMENT(firstElementAlignment, puddle, bitlength));
 	puddle->usedElements = 0;
+	puddle->reservedElements = 0;
 
 	/* Mark all slots as free. */
 	bits = PUDDLE_BITS(puddle);
@@ -392,6 +448,19 @@ pool_new(uintptr_t structSizeArg,
 		pool->memFree = memFree;
 		pool->userData = userData;
 		pool->memoryCategory = memoryCategory;
+		pool->magazineLock = 0;
+		pool->magazineLockDepth = 0;
+		pool->magazineId = 0;
+		pool->magazines = NULL;
+		pool->nextMagazinePool = NULL;
+		pool->prevMagazinePool = NULL;
+#if defined(POOL_THREAD_LOCAL)
+		if (poolFlags & POOL_THREAD_MAGAZINES) {
+			pool->magazineId = addAtomic(&poolMagazineNextId, 1);
+		}
+#else /* defined(POOL_THREAD_LOCAL) */
+		pool->flags &= ~POOL_THREAD_MAGAZINES;
+#endif /* defined(POOL_THREAD_LOCAL) */
 
 		doInit = 1;
 		puddleList = memAlloc(userData, sizeof(J9PoolPuddleList), poolCreatorCallsite, memoryCategory, POOL_ALLOC_TYPE_PUDDLE_LIST, &doInit);
@@ -410,6 +479,9 @@ pool_new(uintptr_t structSizeArg,
 					memFree(userData, pool, POOL_ALLOC_TYPE_POOL);
 					pool = NULL;
 				}
+			} else {
+				/* Magazines rely on the pool lock, which does not protect a puddle list shared with other pools. */
+				pool->flags &= ~POOL_THREAD_MAGAZINES;
 			}
 		} else {
 			memFree(userData, pool, POOL_ALLOC_TYPE_POOL);
@@ -417,6 +489,12 @@ pool_new(uintptr_t structSizeArg,
 		}
 	}
 
+#if defined(POOL_THREAD_LOCAL)
+	if ((NULL != pool) && (pool->flags & POOL_THREAD_MAGAZINES)) {
+		poolMagazine_register(pool);
+	}
+#endif /* defined(POOL_THREAD_LOCAL) */
+
 	Trc_pool_new_Exit(pool);
 	return pool;
 }
@@ -440,12 +518,26 @@ pool_kill(J9Pool *pool)
 		J9PoolPuddle *walk = J9POOLPUDDLELIST_NEXTPUDDLE(puddleList);
 		J9PoolPuddle *puddle;
 
+		J9PoolMagazine *magazine = pool->magazines;
+
+#if defined(POOL_THREAD_LOCAL)
+		if (pool->flags & POOL_THREAD_MAGAZINES) {
+			poolMagazine_unregister(pool);
+		}
+#endif /* defined(POOL_THREAD_LOCAL) */
+
 		while (NULL != walk) {
 			puddle = walk;
 			walk = J9POOLPUDDLE_NEXTPUDDLE(puddle);
 			pool->memFree(pool->userData, puddle, POOL_ALLOC_TYPE_PUDDLE);
 		}
 
+		while (NULL != magazine) {
+			J9PoolMagazine *next = magazine->next;
+			pool->memFree(pool->userData, magazine, POOL_ALLOC_TYPE_MAGAZINE);
+			magazine = next;
+		}
+
 		pool->memFree(pool->userData, puddleList, POOL_ALLOC_TYPE_PUDDLE_LIST);
 		pool->memFree(pool->userData, pool, POOL_ALLOC_TYPE_POOL);
 	}
@@ -454,53 +546,31 @@ pool_kill(J9Pool *pool)
 }
 
 /**
- *	Asks for the address of a new pool element.
- *
- *	If it succeeds, the address returned will have space for
- *	one element of the correct structure size.
+ * Take a free slot from the first available puddle of the pool, allocating and linking
+ * in a new puddle if none has a free slot. The slot is unlinked from the puddle's free
+ * list, and the puddle is removed from the available list if it became full.
  *
- *	The contents of the element will be set to 0's unless the
- *  POOL_NO_ZERO flag is set on the pool, in which case the
- *  contents are undefined.
+ * The slot's bookkeeping (free bit, element counts and puddle SRP) is left to the caller.
  *
- *	If all puddles in the pool are full, a new puddle will be
- *  grafted onto the end of the pool's puddle chain and the
- *  element returned will come from this puddle.
- *
- * @param[in] pool
- *
- * @return NULL on error
- * @return pointer to a new element otherwise
+ * @param[in] pool       The pool to take the slot from.
+ * @param[in] puddleList The puddle list of the pool.
+ * @param[out] puddleOut The puddle containing the returned slot.
  *
+ * @return pointer to the slot, or NULL if a new puddle could not be allocated.
  */
-void *
-pool_newElement(J9Pool *pool)
+static void *
+poolPuddle_takeFreeSlot(J9Pool *pool, J9PoolPuddleList *puddleList, J9PoolPuddle **puddleOut)
 {
-	int32_t slot;
 	void *newElement;
 	void *nextFreeElement;
-	J9SRP *puddleSRP;
-	J9PoolPuddle *puddle;
-	J9PoolPuddleList *puddleList;
-
-	Trc_pool_newElement_Entry(pool);
-
-	if (NULL == pool) {
-		Trc_pool_newElement_ExitNoop();
-		return NULL;
-	}
+	J9PoolPuddle *puddle = J9POOLPUDDLELIST_NEXTAVAILABLEPUDDLE(puddleList);
 
-	/* Check if there is a puddle with free slots - if so use it. */
-	puddleList = J9POOL_PUDDLELIST(pool);
-
-	puddle = J9POOLPUDDLELIST_NEXTAVAILABLEPUDDLE(puddleList);
 	if (NULL == puddle) {
 		J9PoolPuddle *head;
 
 		/* No available puddles. Allocate a new one. */
 		puddle = poolPuddle_new(pool);
 		if (NULL == puddle) {
-			Trc_pool_newElement_Exit(NULL);
 			return NULL;
 		}
 
@@ -515,17 +585,7 @@ pool_newElement(J9Pool *pool)
 
 	newElement = J9POOLPUDDLE_FIRSTFREESLOT(puddle);
 	nextFreeElement = NEXT_FREE_SLOT(newElement);
-
 	SRP_SET(puddle->firstFreeSlot, nextFreeElement);
-	slot = pool_getElementPuddleSlot(pool, puddle, newElement);
-	MARK_SLOT_USED(puddle, slot);
-	puddle->usedElements++;
-	puddleList->numElements++;
-	if (!(pool->flags & POOL_NO_ZERO)) {
-		memset(newElement, 0, pool->elementSize);
-	}
-	puddleSRP = pool_getElementPuddleSRP(pool, newElement);
-	NNSRP_SET(*puddleSRP, puddle);
 
 	/* If the puddle is full, remove it from the list of available puddles. */
 	if (NULL == nextFreeElement) {
@@ -547,6 +607,614 @@ pool_newElement(J9Pool *pool)
 		WSRP_SET(puddle->prevAvailablePuddle, NULL);
 	}
 
+	*puddleOut = puddle;
+	return newElement;
+}
+
+/**
+ * Link a slot back into its puddle's free list. If no elements of the puddle remain
+ * in use the puddle is deleted (unless the pool never frees puddles), otherwise a
+ * puddle that was full is made available again.
+ *
+ * @param[in] pool          The pool containing the puddle.
+ * @param[in] puddleList    The puddle list of the pool.
+ * @param[in] puddle        The puddle containing the slot.
+ * @param[in] anElement     The slot being freed.
+ * @param[in] elementsInUse The number of slots of the puddle still in use.
+ *
+ * @return none
+ */
+static void
+poolPuddle_returnFreeSlot(J9Pool *pool, J9PoolPuddleList *puddleList, J9PoolPuddle *puddle, void *anElement, uintptr_t elementsInUse)
+{
+	void *freeLocation = (void *) J9POOLPUDDLE_FIRSTFREESLOT(puddle);
+
+	SRP_SET(puddle->firstFreeSlot, anElement);
+	LINK_TO_FREE_LIST(anElement, freeLocation);
+
+	/* If the puddle's empty, and we're allowed to free it, then remove it. */
+	if ((0 == elementsInUse) && !(pool->flags & POOL_NEVER_FREE_PUDDLES)) {
+		poolPuddle_delete(pool, puddle);
+	} else if (NULL == freeLocation) {
+		/* It was full before - but not anymore - add it to the top of the available puddles list. */
+		J9PoolPuddle *next = J9POOLPUDDLELIST_NEXTAVAILABLEPUDDLE(puddleList);
+
+		WSRP_SET(puddleList->nextAvailablePuddle, puddle);
+		WSRP_SET(puddle->prevAvailablePuddle, NULL);
+		WSRP_SET(puddle->nextAvailablePuddle, next);
+		if (NULL != next) {
+			WSRP_SET(next->prevAvailablePuddle, puddle);
+		}
+	}
+}
+
+#if defined(POOL_THREAD_LOCAL)
+/*
+ * Magazine pools (POOL_THREAD_MAGAZINES) keep a small stack of free elements per thread,
+ * so that pool_newElement and pool_removeElement usually complete without a lock.
+ * When a thread terminates, the elements in its magazines go back to their puddles
+ * and the magazines are left for the next thread that needs one.
+ *
+ * An element cached in a magazine is marked free in its puddle's bitmap and is not counted
+ * in the puddle's usedElements, so iteration and pool_includesElement do not see it. It is
+ * however unlinked from the puddle's free list and counted in the puddle's reservedElements,
+ * which keeps the puddle alive. Free bits and usedElements are updated atomically by the
+ * owning thread; everything else (free lists, puddle lists, reservedElements) is only
+ * touched while holding the pool's magazine lock.
+ *
+ * The magazine lock holds the identity of the thread that owns it and may be re-entered
+ * by that thread, so that a pool_do callback can allocate and free elements.
+ */
+
+static void
+poolMagazine_lockAs(J9Pool *pool, uintptr_t self)
+{
+	if (self == pool->magazineLock) {
+		pool->magazineLockDepth += 1;
+		return;
+	}
+	while (0 != compareAndSwapUDATA(&pool->magazineLock, 0, self)) {
+		issueReadBarrier();
+	}
+}
+
+static void
+poolMagazine_lock(J9Pool *pool)
+{
+	poolMagazine_lockAs(pool, POOL_MAGAZINE_SELF());
+}
+
+static void
+poolMagazine_unlock(J9Pool *pool)
+{
+	if (0 != pool->magazineLockDepth) {
+		pool->magazineLockDepth -= 1;
+		return;
+	}
+	issueWriteBarrier();
+	pool->magazineLock = 0;
+}
+
+static void
+poolMagazine_lockRegistry(void)
+{
+	while (0 != compareAndSwapUDATA(&poolMagazineRegistryLock, 0, 1)) {
+		issueReadBarrier();
+	}
+}
+
+static void
+poolMagazine_unlockRegistry(void)
+{
+	issueWriteBarrier();
+	poolMagazineRegistryLock = 0;
+}
+
+/**
+ * Add a magazine pool to the list walked by terminating threads.
+ *
+ * @param[in] pool The pool.
+ *
+ * @return none
+ */
+static void
+poolMagazine_register(J9Pool *pool)
+{
+	poolMagazine_lockRegistry();
+	pool->prevMagazinePool = NULL;
+	pool->nextMagazinePool = poolMagazinePools;
+	if (NULL != poolMagazinePools) {
+		poolMagazinePools->prevMagazinePool = pool;
+	}
+	poolMagazinePools = pool;
+	poolMagazine_unlockRegistry();
+}
+
+/**
+ * Remove a magazine pool from the list walked by terminating threads. Once this returns
+ * no terminating thread is looking at the pool's magazines.
+ *
+ * @param[in] pool The pool.
+ *
+ * @return none
+ */
+static void
+poolMagazine_unregister(J9Pool *pool)
+{
+	poolMagazine_lockRegistry();
+	if (NULL != pool->prevMagazinePool) {
+		pool->prevMagazinePool->nextMagazinePool = pool->nextMagazinePool;
+	} else {
+		poolMagazinePools = pool->nextMagazinePool;
+	}
+	if (NULL != pool->nextMagazinePool) {
+		pool->nextMagazinePool->prevMagazinePool = pool->prevMagazinePool;
+	}
+	poolMagazine_unlockRegistry();
+}
+
+/**
+ * Atomically set or clear the free bit of a slot.
+ *
+ * @param[in] puddle   The puddle containing the slot.
+ * @param[in] slot     The slot index.
+ * @param[in] markFree TRUE to mark the slot free, FALSE to mark it used.
+ *
+ * @return TRUE if the bit changed, FALSE if the slot was already in the requested state.
+ */
+static uintptr_t
+poolPuddle_atomicMarkSlot(J9PoolPuddle *puddle, int32_t slot, uintptr_t markFree)
+{
+	uint32_t *word = PUDDLE_BITS(puddle) + (((uint32_t)slot) >> 5);
+	uint32_t mask = (uint32_t)1 << (31 - (((uint32_t)slot) & 31));
+	uint32_t oldValue;
+	uint32_t newValue;
+
+	do {
+		oldValue = *(volatile uint32_t *)word;
+		if (markFree == (uintptr_t)(0 != (oldValue & mask))) {
+			return FALSE;
+		}
+		newValue = markFree ? (oldValue | mask) : (oldValue & ~mask);
+	} while (oldValue != compareAndSwapU32(word, oldValue, newValue));
+
+	return TRUE;
+}
+
+/**
+ * Move up to POOL_MAGAZINE_BATCH free slots from the puddles into an empty magazine.
+ *
+ * @param[in] pool     The pool.
+ * @param[in] magazine The calling thread's magazine.
+ *
+ * @return none
+ */
+static void
+poolMagazine_refill(J9Pool *pool, J9PoolMagazine *magazine)
+{
+	J9PoolPuddleList *puddleList = J9POOL_PUDDLELIST(pool);
+
+	poolMagazine_lock(pool);
+	while (magazine->count < POOL_MAGAZINE_BATCH) {
+		J9PoolPuddle *puddle = NULL;
+		void *element = poolPuddle_takeFreeSlot(pool, puddleList, &puddle);
+
+		if (NULL == element) {
+			break;
+		}
+		puddle->reservedElements++;
+		puddleList->numElements++;
+		NNSRP_SET(*pool_getElementPuddleSRP(pool, element), puddle);
+		magazine->elements[magazine->count] = element;
+		magazine->count++;
+	}
+	poolMagazine_unlock(pool);
+}
+
+/**
+ * Return the oldest elements of a magazine to their puddles. The caller holds the pool's
+ * magazine lock and updates the magazine's count.
+ *
+ * @param[in] pool     The pool.
+ * @param[in] magazine The magazine.
+ * @param[in] count    The number of elements to return.
+ *
+ * @return none
+ */
+static void
+poolMagazine_returnElements(J9Pool *pool, J9PoolMagazine *magazine, uintptr_t count)
+{
+	J9PoolPuddleList *puddleList = J9POOL_PUDDLELIST(pool);
+	uintptr_t i;
+
+	for (i = 0; i < count; i++) {
+		void *element = magazine->elements[i];
+		J9PoolPuddle *puddle = NNSRP_GET(*pool_getElementPuddleSRP(pool, element), J9PoolPuddle *);
+
+		puddle->reservedElements--;
+		puddleList->numElements--;
+		poolPuddle_returnFreeSlot(pool, puddleList, puddle, element, puddle->reservedElements);
+	}
+}
+
+/**
+ * Return the oldest elements of a magazine to their puddles.
+ *
+ * @param[in] pool     The pool.
+ * @param[in] magazine The magazine.
+ * @param[in] count    The maximum number of elements to return.
+ *
+ * @return none
+ */
+static void
+poolMagazine_flush(J9Pool *pool, J9PoolMagazine *magazine, uintptr_t count)
+{
+	if (count > magazine->count) {
+		count = magazine->count;
+	}
+
+	poolMagazine_lock(pool);
+	poolMagazine_returnElements(pool, magazine, count);
+	poolMagazine_unlock(pool);
+
+	magazine->count -= count;
+	memmove(magazine->elements, magazine->elements + count, magazine->count * sizeof(void *));
+}
+
+/**
+ * Give back everything cached by a terminating thread, leaving its magazines unowned so
+ * that they are reused by the next threads to need one. Called from the destructor of the
+ * thread exit key, which is set once the thread owns a magazine.
+ *
+ * @param[in] self The identity of the terminating thread.
+ *
+ * @return none
+ */
+static void
+poolMagazine_threadExit(uintptr_t self)
+{
+	J9Pool *pool;
+
+	poolMagazine_lockRegistry();
+	for (pool = poolMagazinePools; NULL != pool; pool = pool->nextMagazinePool) {
+		J9PoolMagazine *magazine;
+
+		poolMagazine_lockAs(pool, self);
+		for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+			if (self == magazine->owner) {
+				poolMagazine_returnElements(pool, magazine, magazine->count);
+				magazine->count = 0;
+				magazine->owner = 0;
+			}
+		}
+		poolMagazine_unlock(pool);
+	}
+	poolMagazine_unlockRegistry();
+
+	/* The magazines can now be claimed by other threads, so a pool operation from a later
+	 * thread-exit destructor must not find them in the cache; it claims a magazine again
+	 * and re-arms the exit key.
+	 */
+	if (self == POOL_MAGAZINE_SELF()) {
+		memset(poolMagazineCache, 0, sizeof(poolMagazineCache));
+		poolMagazineCacheVictim = 0;
+		poolMagazineExitArmed = FALSE;
+	}
+}
+
+#if defined(OMR_OS_WINDOWS)
+static VOID WINAPI
+poolMagazine_exitKeyDestructor(PVOID value)
+{
+	if (NULL != value) {
+		poolMagazine_threadExit((uintptr_t)value);
+	}
+}
+#else /* defined(OMR_OS_WINDOWS) */
+static void
+poolMagazine_exitKeyDestructor(void *value)
+{
+	poolMagazine_threadExit((uintptr_t)value);
+}
+#endif /* defined(OMR_OS_WINDOWS) */
+
+/**
+ * Make sure poolMagazine_threadExit runs when the calling thread terminates.
+ *
+ * @return none
+ */
+static void
+poolMagazine_armThreadExit(void)
+{
+	uintptr_t state;
+
+	if (poolMagazineExitArmed) {
+		return;
+	}
+
+	for (;;) {
+		state = poolMagazineExitKeyState;
+		if (POOL_MAGAZINE_EXIT_KEY_NONE == state) {
+			if (POOL_MAGAZINE_EXIT_KEY_NONE == compareAndSwapUDATA(&poolMagazineExitKeyState, POOL_MAGAZINE_EXIT_KEY_NONE, POOL_MAGAZINE_EXIT_KEY_CREATING)) {
+#if defined(OMR_OS_WINDOWS)
+				poolMagazineExitKey = FlsAlloc(poolMagazine_exitKeyDestructor);
+				state = (FLS_OUT_OF_INDEXES != poolMagazineExitKey) ? POOL_MAGAZINE_EXIT_KEY_READY : POOL_MAGAZINE_EXIT_KEY_FAILED;
+#else /* defined(OMR_OS_WINDOWS) */
+				state = (0 == pthread_key_create(&poolMagazineExitKey, poolMagazine_exitKeyDestructor)) ? POOL_MAGAZINE_EXIT_KEY_READY : POOL_MAGAZINE_EXIT_KEY_FAILED;
+#endif /* defined(OMR_OS_WINDOWS) */
+				issueWriteBarrier();
+				poolMagazineExitKeyState = state;
+				break;
+			}
+		} else if (POOL_MAGAZINE_EXIT_KEY_CREATING != state) {
+			break;
+		}
+		issueReadBarrier();
+	}
+
+	if (POOL_MAGAZINE_EXIT_KEY_READY == state) {
+		/* Without the key, magazines of terminated threads keep their elements until pool_flushMagazines. */
+#if defined(OMR_OS_WINDOWS)
+		FlsSetValue(poolMagazineExitKey, (PVOID)POOL_MAGAZINE_SELF());
+#else /* defined(OMR_OS_WINDOWS) */
+		pthread_setspecific(poolMagazineExitKey, (void *)POOL_MAGAZINE_SELF());
+#endif /* defined(OMR_OS_WINDOWS) */
+	}
+	poolMagazineExitArmed = TRUE;
+}
+
+/**
+ * Find the calling thread's magazine for a pool, creating it if needed.
+ *
+ * A magazine left unowned by a terminated thread is reused before a new one is allocated,
+ * so a pool has no more magazines than the number of threads using it at the same time.
+ *
+ * @param[in] pool The pool.
+ *
+ * @return the magazine, or NULL if one could not be allocated.
+ */
+static J9PoolMagazine *
+poolMagazine_forCurrentThread(J9Pool *pool)
+{
+	uintptr_t owner = POOL_MAGAZINE_SELF();
+	J9PoolMagazine *magazine = NULL;
+	J9PoolMagazine *unowned = NULL;
+	uintptr_t i;
+
+	for (i = 0; i < POOL_MAGAZINE_CACHE_ENTRIES; i++) {
+		if (poolMagazineCache[i].poolId == pool->magazineId) {
+			return poolMagazineCache[i].magazine;
+		}
+	}
+
+	poolMagazine_armThreadExit();
+
+	poolMagazine_lock(pool);
+	for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+		if (owner == magazine->owner) {
+			break;
+		}
+		if ((NULL == unowned) && (0 == magazine->owner)) {
+			unowned = magazine;
+		}
+	}
+	if ((NULL == magazine) && (NULL != unowned)) {
+		magazine = unowned;
+		magazine->owner = owner;
+	}
+	poolMagazine_unlock(pool);
+
+	if (NULL == magazine) {
+		uint32_t doInit = 1;
+
+		magazine = pool->memAlloc(pool->userData, sizeof(J9PoolMagazine), pool->poolCreatorCallsite, pool->memoryCategory, POOL_ALLOC_TYPE_MAGAZINE, &doInit);
+		if (NULL == magazine) {
+			return NULL;
+		}
+		magazine->owner = owner;
+		magazine->count = 0;
+
+		poolMagazine_lock(pool);
+		magazine->next = pool->magazines;
+		pool->magazines = magazine;
+		poolMagazine_unlock(pool);
+	}
+
+	i = poolMagazineCacheVictim;
+	poolMagazineCacheVictim = (i + 1) % POOL_MAGAZINE_CACHE_ENTRIES;
+	poolMagazineCache[i].poolId = pool->magazineId;
+	poolMagazineCache[i].magazine = magazine;
+
+	return magazine;
+}
+
+/**
+ * Allocate an element of a magazine pool from the calling thread's magazine.
+ *
+ * @param[in] pool The pool.
+ *
+ * @return pointer to a new element, or NULL if no memory is available.
+ */
+static void *
+poolMagazine_newElement(J9Pool *pool)
+{
+	J9PoolMagazine *magazine = poolMagazine_forCurrentThread(pool);
+	J9PoolPuddle *puddle;
+	J9SRP *puddleSRP;
+	void *newElement;
+
+	if (NULL == magazine) {
+		return NULL;
+	}
+
+	if (0 == magazine->count) {
+		poolMagazine_refill(pool, magazine);
+		if (0 == magazine->count) {
+			return NULL;
+		}
+	}
+
+	magazine->count--;
+	newElement = magazine->elements[magazine->count];
+	puddleSRP = pool_getElementPuddleSRP(pool, newElement);
+	puddle = NNSRP_GET(*puddleSRP, J9PoolPuddle *);
+
+	if (!(pool->flags & POOL_NO_ZERO)) {
+		memset(newElement, 0, pool->elementSize);
+		NNSRP_SET(*puddleSRP, puddle);
+	}
+	poolPuddle_atomicMarkSlot(puddle, pool_getElementPuddleSlot(pool, puddle, newElement), FALSE);
+	addAtomic(&puddle->usedElements, 1);
+
+	return newElement;
+}
+
+/**
+ * Free an element of a magazine pool into the calling thread's magazine.
+ *
+ * @param[in] pool      The pool.
+ * @param[in] puddle    The puddle containing the element.
+ * @param[in] slot      The element's slot in the puddle.
+ * @param[in] anElement The element.
+ *
+ * @return FALSE if the element was already free, TRUE otherwise.
+ */
+static uintptr_t
+poolMagazine_removeElement(J9Pool *pool, J9PoolPuddle *puddle, int32_t slot, void *anElement)
+{
+	J9PoolMagazine *magazine;
+
+	if (!poolPuddle_atomicMarkSlot(puddle, slot, TRUE)) {
+		return FALSE;
+	}
+	subtractAtomic(&puddle->usedElements, 1);
+
+	magazine = poolMagazine_forCurrentThread(pool);
+	if (NULL == magazine) {
+		/* Hand the element straight back to its puddle. */
+		J9PoolPuddleList *puddleList = J9POOL_PUDDLELIST(pool);
+
+		poolMagazine_lock(pool);
+		puddle->reservedElements--;
+		puddleList->numElements--;
+		poolPuddle_returnFreeSlot(pool, puddleList, puddle, anElement, puddle->reservedElements);
+		poolMagazine_unlock(pool);
+	} else {
+		if (POOL_MAGAZINE_SIZE == magazine->count) {
+			poolMagazine_flush(pool, magazine, POOL_MAGAZINE_BATCH);
+		}
+		magazine->elements[magazine->count] = anElement;
+		magazine->count++;
+	}
+
+	return TRUE;
+}
+#endif /* defined(POOL_THREAD_LOCAL) */
+
+/**
+ * Take the magazine lock of a pool created with POOL_THREAD_MAGAZINES, so that its puddle
+ * lists can be walked or changed while other threads allocate and free elements. Does
+ * nothing for other pools.
+ *
+ * @param[in] pool The pool
+ *
+ * @return none
+ */
+void
+pool_lockMagazines(J9Pool *pool)
+{
+#if defined(POOL_THREAD_LOCAL)
+	if (pool->flags & POOL_THREAD_MAGAZINES) {
+		poolMagazine_lock(pool);
+	}
+#endif /* defined(POOL_THREAD_LOCAL) */
+}
+
+/**
+ * Release the lock taken by pool_lockMagazines.
+ *
+ * @param[in] pool The pool
+ *
+ * @return none
+ */
+void
+pool_unlockMagazines(J9Pool *pool)
+{
+#if defined(POOL_THREAD_LOCAL)
+	if (pool->flags & POOL_THREAD_MAGAZINES) {
+		poolMagazine_unlock(pool);
+	}
+#endif /* defined(POOL_THREAD_LOCAL) */
+}
+
+/**
+ *	Asks for the address of a new pool element.
+ *
+ *	If it succeeds, the address returned will have space for
+ *	one element of the correct structure size.
+ *
+ *	The contents of the element will be set to 0's unless the
+ *  POOL_NO_ZERO flag is set on the pool, in which case the
+ *  contents are undefined.
+ *
+ *	If all puddles in the pool are full, a new puddle will be
+ *  grafted onto the end of the pool's puddle chain and the
+ *  element returned will come from this puddle.
+ *
+ *  For a pool created with POOL_THREAD_MAGAZINES, the element is
+ *  normally taken from the calling thread's magazine and this
+ *  function may be called concurrently with pool_newElement and
+ *  pool_removeElement on other threads without an external lock.
+ *
+ * @param[in] pool
+ *
+ * @return NULL on error
+ * @return pointer to a new element otherwise
+ *
+ */
+void *
+pool_newElement(J9Pool *pool)
+{
+	int32_t slot;
+	void *newElement;
+	J9SRP *puddleSRP;
+	J9PoolPuddle *puddle = NULL;
+	J9PoolPuddleList *puddleList;
+
+	Trc_pool_newElement_Entry(pool);
+
+	if (NULL == pool) {
+		Trc_pool_newElement_ExitNoop();
+		return NULL;
+	}
+
+#if defined(POOL_THREAD_LOCAL)
+	if (pool->flags & POOL_THREAD_MAGAZINES) {
+		newElement = poolMagazine_newElement(pool);
+		Trc_pool_newElement_Exit(newElement);
+		return newElement;
+	}
+#endif /* defined(POOL_THREAD_LOCAL) */
+
+	/* Check if there is a puddle with free slots - if so use it. */
+	puddleList = J9POOL_PUDDLELIST(pool);
+
+	newElement = poolPuddle_takeFreeSlot(pool, puddleList, &puddle);
+	if (NULL == newElement) {
+		Trc_pool_newElement_Exit(NULL);
+		return NULL;
+	}
+
+	slot = pool_getElementPuddleSlot(pool, puddle, newElement);
+	MARK_SLOT_USED(puddle, slot);
+	puddle->usedElements++;
+	puddleList->numElements++;
+	if (!(pool->flags & POOL_NO_ZERO)) {
+		memset(newElement, 0, pool->elementSize);
+	}
+	puddleSRP = pool_getElementPuddleSRP(pool, newElement);
+	NNSRP_SET(*puddleSRP, puddle);
+
 	Trc_pool_newElement_Exit(newElement);
 
 	return newElement;
@@ -559,6 +1227,10 @@ pool_newElement(J9Pool *pool)
  * pool with @ref pool_startDo / @ref pool_nextDo on the element
  * returned by those calls.
  *
+ * For a pool created with POOL_THREAD_MAGAZINES, the element is
+ * normally cached in the calling thread's magazine rather than
+ * returned to its puddle; see @ref pool_flushMagazines.
+ *
  * @param[in] pool
  * @param[in] anElement Pointer to the element to be removed
  *
@@ -572,7 +1244,6 @@ pool_removeElement(J9Pool *pool, void *anElement)
 	int32_t slot;
 	J9PoolPuddle *puddle;
 	J9PoolPuddleList *puddleList;
-	void *freeLocation;
 
 	Trc_pool_removeElement_Entry(pool, anElement);
 
@@ -591,6 +1262,16 @@ pool_removeElement(J9Pool *pool, void *anElement)
 		return;		/* this is an error...  we were passed a bogus data pointer. */
 	}
 
+#if defined(POOL_THREAD_LOCAL)
+	if (pool->flags & POOL_THREAD_MAGAZINES) {
+		if (!poolMagazine_removeElement(pool, puddle, slot, anElement)) {
+			Trc_pool_removeElement_NotFound(anElement, puddle);
+		}
+		Trc_pool_removeElement_Exit();
+		return;
+	}
+#endif /* defined(POOL_THREAD_LOCAL) */
+
 	if (PUDDLE_SLOT_FREE(puddle, slot)) {
 		Trc_pool_removeElement_NotFound(anElement, puddle);
 		Trc_pool_removeElement_Exit();
@@ -600,26 +1281,39 @@ pool_removeElement(J9Pool *pool, void *anElement)
 	MARK_SLOT_FREE(puddle, slot);
 	puddle->usedElements--;
 	puddleList->numElements--;
-	freeLocation = (void *) J9POOLPUDDLE_FIRSTFREESLOT(puddle);
-	SRP_SET(puddle->firstFreeSlot, anElement);
-	LINK_TO_FREE_LIST(anElement, freeLocation);
+	poolPuddle_returnFreeSlot(pool, puddleList, puddle, anElement, puddle->usedElements);
 
-	/* If the puddle's empty, and we're allowed to free it, then remove it. */
-	if ((puddle->usedElements == 0) && !(pool->flags & POOL_NEVER_FREE_PUDDLES)) {
-		poolPuddle_delete(pool, puddle);
-	} else if (NULL == freeLocation) {
-		/* It was full before - but not anymore - add it to the top of the available puddles list. */
-		J9PoolPuddle *next = J9POOLPUDDLELIST_NEXTAVAILABLEPUDDLE(puddleList);
+	Trc_pool_removeElement_Exit();
+}
 
-		WSRP_SET(puddleList->nextAvailablePuddle, puddle);
-		WSRP_SET(puddle->prevAvailablePuddle, NULL);
-		WSRP_SET(puddle->nextAvailablePuddle, next);
-		if (NULL != next) {
-			WSRP_SET(next->prevAvailablePuddle, puddle);
+/**
+ * Return the elements cached in all thread-local magazines of a pool to their puddles,
+ * releasing puddles that become empty. Does nothing for pools created without
+ * POOL_THREAD_MAGAZINES.
+ *
+ * This must not run concurrently with any other operation on the pool.
+ *
+ * @param[in] pool The pool
+ *
+ * @return none
+ *
+ */
+void
+pool_flushMagazines(J9Pool *pool)
+{
+	Trc_pool_flushMagazines_Entry(pool);
+
+#if defined(POOL_THREAD_LOCAL)
+	if ((NULL != pool) && (pool->flags & POOL_THREAD_MAGAZINES)) {
+		J9PoolMagazine *magazine;
+
+		for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+			poolMagazine_flush(pool, magazine, magazine->count);
 		}
 	}
+#endif /* defined(POOL_THREAD_LOCAL) */
 
-	Trc_pool_removeElement_Exit();
+	Trc_pool_flushMagazines_Exit();
 }
 
 /**
@@ -629,6 +1323,9 @@ pool_removeElement(J9Pool *pool, void *anElement)
  * @param[in] doFunction Pointer to function which will "do" things to the elements of pool
  * @param[in] userData Pointer to data to be passed to "do" function, along with each pool-element
  *
+ * For a pool created with POOL_THREAD_MAGAZINES, the pool's magazine lock is held while
+ * the elements are visited, so other threads wait to refill or flush their magazines.
+ *
  * @return none
  *
  * @see pool_startDo, pool_nextDo
@@ -642,6 +1339,8 @@ pool_do(J9Pool *pool, void (*doFunction)(void *anElement, void *userData), void
 
 	Trc_pool_do_Entry(pool, doFunction, userData);
 
+	pool_lockMagazines(pool);
+
 	anElement = pool_startDo(pool, &aState);
 
 	while (anElement) {
@@ -649,6 +1348,8 @@ pool_do(J9Pool *pool, void (*doFunction)(void *anElement, void *userData), void
 		anElement = pool_nextDo(&aState);
 	}
 
+	pool_unlockMagazines(pool);
+
 	Trc_pool_do_Exit();
 }
 
@@ -670,7 +1371,21 @@ pool_numElements(J9Pool *pool)
 	Trc_pool_numElements_Entry(pool);
 
 	puddleList = J9POOL_PUDDLELIST(pool);
-	numElements = puddleList->numElements;
+	if (pool->flags & POOL_THREAD_MAGAZINES) {
+		/* puddleList->numElements also counts the elements cached in magazines. */
+		J9PoolPuddle *walk;
+
+		pool_lockMagazines(pool);
+		walk = J9POOLPUDDLELIST_NEXTPUDDLE(puddleList);
+		numElements = 0;
+		while (NULL != walk) {
+			numElements += walk->usedElements;
+			walk = J9POOLPUDDLE_NEXTPUDDLE(walk);
+		}
+		pool_unlockMagazines(pool);
+	} else {
+		numElements = puddleList->numElements;
+	}
 
 	Trc_pool_numElements_Exit(numElements);
 
@@ -855,6 +1570,7 @@ pool_clear(J9Pool *pool)
 	if (pool) {
 		J9PoolPuddleList *puddleList = J9POOL_PUDDLELIST(pool);
 		J9PoolPuddle *walk = J9POOLPUDDLELIST_NEXTPUDDLE(puddleList);
+		J9PoolMagazine *magazine;
 
 		NNWSRP_SET(puddleList->nextAvailablePuddle, walk);
 		while (walk) {
@@ -868,6 +1584,11 @@ pool_clear(J9Pool *pool)
 		}
 
 		puddleList->numElements = 0;
+
+		/* Elements cached in magazines now belong to the rebuilt free lists. */
+		for (magazine = pool->magazines; NULL != magazine; magazine = magazine->next) {
+			magazine->count = 0;
+		}
 	}
 
 	Trc_pool_clear_Exit();
@@ -55,6 +55,9 @@ pool_ensureCapacity(J9Pool *aPool, uintptr_t newCapacity)
 
 	Trc_pool_ensureCapacity_Entry(aPool, newCapacity);
 
+	/* Threads using magazines take free slots and puddles under this lock. */
+	pool_lockMagazines(aPool);
+
 	numElements = pool_capacity(aPool);
 
 	/* mark each pool as POOL_NEVER_FREE_PUDDLES */
@@ -101,6 +104,8 @@ pool_ensureCapacity(J9Pool *aPool, uintptr_t newCapacity)
 		}
 	}
 
+	pool_unlockMagazines(aPool);
+
 	Trc_pool_ensureCapacity_Exit(result);
 	return result;
 }
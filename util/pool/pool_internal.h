@@ -39,6 +39,23 @@
 extern "C" {
 #endif
 
+/* ---------------- pool.c ---------------- */
+
+/**
+* @brief Take the magazine lock of a POOL_THREAD_MAGAZINES pool; does nothing for other pools.
+* @param[in] pool The pool
+* @return void
+*/
+void
+pool_lockMagazines(J9Pool *pool);
+
+/**
+* @brief Release the lock taken by pool_lockMagazines.
+* @param[in] pool The pool
+* @return void
+*/
+void
+pool_unlockMagazines(J9Pool *pool);
 
 #ifdef __cplusplus
 }